@@ -13,6 +13,7 @@
 #include "blender/util.h"
 
 #include "util/foreach.h"
+#include "util/hash.h"
 #include "util/task.h"
 
 CCL_NAMESPACE_BEGIN
@@ -37,6 +38,58 @@ static Geometry::Type determine_geom_type(BObjectInfo &b_ob_info, bool use_parti
   return Geometry::MESH;
 }
 
+/* Meshes which are realized separately, for example by geometry nodes, can still share all their
+ * arrays through implicit sharing. Build a key from the array pointers, so that such meshes are
+ * synced once and instanced like meshes which use the same data-block. The meshes of all objects
+ * are alive during the sync, so equal pointers mean equal data.
+ *
+ * Returns false when the mesh is not suitable for de-duplication, because its Cycles geometry
+ * also depends on the object. */
+static bool mesh_content_key(BObjectInfo &b_ob_info,
+                             const array<Node *> &used_shaders,
+                             const bool use_subdivision,
+                             vector<uintptr_t> &r_key)
+{
+  if (!b_ob_info.object_data.is_a(&RNA_Mesh) || use_subdivision) {
+    return false;
+  }
+
+  BL::Mesh b_mesh(b_ob_info.object_data);
+  if (b_mesh.is_editmode()) {
+    return false;
+  }
+
+  const ::Mesh &mesh = *static_cast<const ::Mesh *>(b_ob_info.object_data.ptr.data);
+  if (mesh.texcomesh || !(mesh.texspace_flag & ME_TEXSPACE_FLAG_AUTO)) {
+    return false;
+  }
+
+  r_key.push_back(mesh.verts_num);
+  r_key.push_back(mesh.edges_num);
+  r_key.push_back(mesh.faces_num);
+  r_key.push_back(mesh.corners_num);
+  r_key.push_back(uintptr_t(mesh.face_offset_indices));
+
+  for (const CustomData *data :
+       {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+  {
+    for (int i = 0; i < data->totlayer; i++) {
+      const CustomDataLayer &layer = data->layers[i];
+      r_key.push_back(uintptr_t(layer.data));
+      r_key.push_back(layer.type);
+      r_key.push_back(hash_string(layer.name));
+      r_key.push_back(layer.active);
+      r_key.push_back(layer.active_rnd);
+    }
+  }
+
+  for (const Node *shader : used_shaders) {
+    r_key.push_back(uintptr_t(shader));
+  }
+
+  return true;
+}
+
 array<Node *> BlenderSync::find_used_shaders(BL::Object &b_ob)
 {
   BL::Material material_override = view_layer.material_override;
@@ -84,10 +137,32 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   /* Find shader indices. */
   array<Node *> used_shaders = find_used_shaders(b_ob_info.iter_object);
 
+  /* Instance meshes with identical content. Geometry motion is synced per geometry and could
+   * differ between such meshes, so not done with motion. */
+  vector<uintptr_t> content_key;
+  const bool use_content_key = geom_type == Geometry::MESH &&
+                               scene->need_motion() == Scene::MOTION_NONE &&
+                               mesh_content_key(b_ob_info,
+                                                used_shaders,
+                                                object_subdivision_type(b_ob_info.real_object,
+                                                                        preview,
+                                                                        experimental) !=
+                                                    Mesh::SUBDIVISION_NONE,
+                                                content_key);
+  if (use_content_key) {
+    const auto it = geometry_synced_by_content.find(content_key);
+    if (it != geometry_synced_by_content.end()) {
+      return it->second;
+    }
+  }
+
   /* Ensure we only sync instanced geometry once. */
   Geometry *geom = geometry_map.find(key);
   if (geom) {
     if (geometry_synced.find(geom) != geometry_synced.end()) {
+      if (use_content_key) {
+        geometry_synced_by_content[content_key] = geom;
+      }
       return geom;
     }
   }
@@ -115,6 +190,10 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     sync = geometry_map.update(geom, b_key_id);
   }
 
+  if (use_content_key) {
+    geometry_synced_by_content[content_key] = geom;
+  }
+
   if (!sync) {
     /* If transform was applied to geometry, need full update. */
     if (object_updated && geom->transform_applied) {
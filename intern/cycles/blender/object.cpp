@@ -243,9 +243,12 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Use task pool only for non-instances, since sync_dupli_particle accesses
-   * geometry. This restriction should be removed for better performance. */
-  TaskPool *object_geom_task_pool = (is_instance) ? NULL : geom_task_pool;
+  /* Use task pool for everything except particle system instances, since
+   * sync_dupli_particle accesses geometry while it may still be synced. Other
+   * instances (collection and geometry nodes instances) only reference the
+   * geometry, so their data can be synced in parallel like regular objects. */
+  const bool is_particle_instance = is_instance && b_instance.particle_system();
+  TaskPool *object_geom_task_pool = (is_particle_instance) ? NULL : geom_task_pool;
 
   /* key to lookup object */
   ObjectKey key(b_parent, persistent_id, b_ob_info.real_object, use_particle_hair);
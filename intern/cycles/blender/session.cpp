@@ -291,16 +291,12 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
   b_rr.stamp_data_add_field((prefix + "samples").c_str(),
                             to_string(session->params.samples).c_str());
 
-  /* Store ranged samples information. */
-  /* TODO(sergey): Need to bring this information back. */
-#if 0
-  if (session->tile_manager.range_num_samples != -1) {
-    b_rr.stamp_data_add_field((prefix + "range_start_sample").c_str(),
-                              to_string(session->tile_manager.range_start_sample).c_str());
-    b_rr.stamp_data_add_field((prefix + "range_num_samples").c_str(),
-                              to_string(session->tile_manager.range_num_samples).c_str());
-  }
-#endif
+  /* Store the rendered sample range and seed, so that renders of the same frame on multiple
+   * machines with different sample offsets can be verified to be independent when merging. */
+  b_rr.stamp_data_add_field((prefix + "sample_offset").c_str(),
+                            to_string(session->params.sample_offset).c_str());
+  b_rr.stamp_data_add_field((prefix + "seed").c_str(),
+                            to_string(scene->integrator->get_seed()).c_str());
 
   /* Write cryptomatte metadata. */
   if (scene->film->get_cryptomatte_passes() & CRYPT_OBJECT) {
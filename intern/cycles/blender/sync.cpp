@@ -280,6 +280,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_images();
 
   geometry_synced.clear(); /* use for objects and motion sync */
+  geometry_synced_by_content.clear();
 
   if (scene->need_motion() == Scene::MOTION_PASS || scene->need_motion() == Scene::MOTION_NONE ||
       scene->camera->get_motion_position() == MOTION_POSITION_CENTER)
@@ -289,6 +290,7 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
 
   geometry_synced.clear();
+  geometry_synced_by_content.clear();
 
   /* Shader sync done at the end, since object sync uses it.
    * false = don't delete unused shaders, not supported. */
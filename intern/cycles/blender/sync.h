@@ -233,6 +233,8 @@ class BlenderSync {
   id_map<ObjectKey, Light> light_map;
   id_map<ParticleSystemKey, ParticleSystem> particle_system_map;
   set<Geometry *> geometry_synced;
+  /** Meshes of the current sync by their content key, see #mesh_content_key. */
+  map<vector<uintptr_t>, Geometry *> geometry_synced_by_content;
   set<Geometry *> geometry_motion_synced;
   set<Geometry *> geometry_motion_attribute_synced;
   /** Remember which geometries come from which objects to be able to sync them after changes. */
@@ -13,6 +13,8 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/foreach.h"
+#include "util/tbb.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -90,16 +92,19 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
     bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
   }
 
-  /* map geometry to bins, unrolled once */
-  {
+  /* map geometry in the given range to bins, unrolled once */
+  auto bin_prims = [&](const int64_t prim_begin,
+                       const int64_t prim_end,
+                       BoundBox (*bin_bounds)[4],
+                       int4 *bin_count) {
     int64_t i;
 
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
+    for (i = prim_begin; i < prim_end - 1; i += 2) {
+      prefetch_L2(&prims[i + 8]);
 
       /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
+      const BVHReference &prim0 = prims[i + 0];
+      const BVHReference &prim1 = prims[i + 1];
 
       BoundBox bounds0 = get_prim_bounds(prim0);
       BoundBox bounds1 = get_prim_bounds(prim1);
@@ -131,9 +136,9 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
     }
 
     /* for uneven number of primitives */
-    if (i < int64_t(size())) {
+    if (i < prim_end) {
       /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
+      const BVHReference &prim0 = prims[i];
       BoundBox bounds0 = get_prim_bounds(prim0);
       int4 bin0 = get_bin(bounds0);
 
@@ -148,6 +153,42 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
       bin_count[b02][2]++;
       bin_bounds[b02][2].grow(bounds0);
     }
+  };
+
+  if (size() < PARALLEL_BINNING_MIN_SIZE) {
+    bin_prims(start(), end(), bin_bounds, bin_count);
+  }
+  else {
+    /* Large ranges are only found at the top levels of the tree, where there are no sub-trees
+     * yet to keep the other threads busy. Bin them in parallel into per-thread bins, which are
+     * merged afterwards. */
+    struct ThreadBins {
+      BoundBox bounds[MAX_BINS][4];
+      int4 count[MAX_BINS];
+    };
+    enumerable_thread_specific<ThreadBins> thread_bins([&]() {
+      ThreadBins bins;
+      for (size_t i = 0; i < num_bins; i++) {
+        bins.count[i] = make_int4(0);
+        bins.bounds[i][0] = bins.bounds[i][1] = bins.bounds[i][2] = BoundBox::empty;
+      }
+      return bins;
+    });
+
+    parallel_for(blocked_range<int64_t>(start(), end(), PARALLEL_BINNING_GRAIN_SIZE),
+                 [&](const blocked_range<int64_t> &r) {
+                   ThreadBins &bins = thread_bins.local();
+                   bin_prims(r.begin(), r.end(), bins.bounds, bins.count);
+                 });
+
+    foreach (const ThreadBins &bins, thread_bins) {
+      for (size_t i = 0; i < num_bins; i++) {
+        bin_count[i] = bin_count[i] + bins.count[i];
+        bin_bounds[i][0].grow(bins.bounds[i][0]);
+        bin_bounds[i][1].grow(bins.bounds[i][1]);
+        bin_bounds[i][2].grow(bins.bounds[i][2]);
+      }
+    }
   }
 
   /* sweep from right to left and compute parallel prefix of merged bounds */
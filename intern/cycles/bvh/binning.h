@@ -17,12 +17,13 @@ CCL_NAMESPACE_BEGIN
 
 class BVHBuild;
 
-/* Single threaded object binner. Finds the split with the best SAH heuristic
+/* Object binner. Finds the split with the best SAH heuristic
  * by testing for each dimension multiple partitionings for regular spaced
  * partition locations. A partitioning for a partition location is computed,
  * by putting primitives whose centroid is on the left and right of the split
  * location to different sets. The SAH is evaluated by computing the number of
- * blocks occupied by the primitives in the partitions. */
+ * blocks occupied by the primitives in the partitions. Large ranges are binned
+ * in parallel. */
 
 class BVHObjectBinning : public BVHRange {
  public:
@@ -59,6 +60,10 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges with at least this number of primitives are binned in parallel. */
+  enum { PARALLEL_BINNING_MIN_SIZE = 1 << 16 };
+  enum { PARALLEL_BINNING_GRAIN_SIZE = 1 << 13 };
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
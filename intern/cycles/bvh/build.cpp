@@ -56,7 +56,8 @@ BVHBuild::~BVHBuild() {}
 
 /* Adding References */
 
-void BVHBuild::add_reference_triangles(BoundBox &root,
+void BVHBuild::add_reference_triangles(vector<BVHReference> &references,
+                                       BoundBox &root,
                                        BoundBox &center,
                                        Mesh *mesh,
                                        int object_index)
@@ -146,7 +147,11 @@ void BVHBuild::add_reference_triangles(BoundBox &root,
   }
 }
 
-void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int object_index)
+void BVHBuild::add_reference_curves(vector<BVHReference> &references,
+                                    BoundBox &root,
+                                    BoundBox &center,
+                                    Hair *hair,
+                                    int object_index)
 {
   const Attribute *curve_attr_mP = NULL;
   if (hair->has_motion_blur()) {
@@ -258,7 +263,8 @@ void BVHBuild::add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair
   }
 }
 
-void BVHBuild::add_reference_points(BoundBox &root,
+void BVHBuild::add_reference_points(vector<BVHReference> &references,
+                                    BoundBox &root,
                                     BoundBox &center,
                                     PointCloud *pointcloud,
                                     int i)
@@ -353,26 +359,28 @@ void BVHBuild::add_reference_points(BoundBox &root,
   }
 }
 
-void BVHBuild::add_reference_geometry(BoundBox &root,
+void BVHBuild::add_reference_geometry(vector<BVHReference> &references,
+                                      BoundBox &root,
                                       BoundBox &center,
                                       Geometry *geom,
                                       int object_index)
 {
   if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
     Mesh *mesh = static_cast<Mesh *>(geom);
-    add_reference_triangles(root, center, mesh, object_index);
+    add_reference_triangles(references, root, center, mesh, object_index);
   }
   else if (geom->geometry_type == Geometry::HAIR) {
     Hair *hair = static_cast<Hair *>(geom);
-    add_reference_curves(root, center, hair, object_index);
+    add_reference_curves(references, root, center, hair, object_index);
   }
   else if (geom->geometry_type == Geometry::POINTCLOUD) {
     PointCloud *pointcloud = static_cast<PointCloud *>(geom);
-    add_reference_points(root, center, pointcloud, object_index);
+    add_reference_points(references, root, center, pointcloud, object_index);
   }
 }
 
-void BVHBuild::add_reference_object(BoundBox &root, BoundBox &center, Object *ob, int i)
+void BVHBuild::add_reference_object(
+    vector<BVHReference> &references, BoundBox &root, BoundBox &center, Object *ob, int i)
 {
   references.push_back(BVHReference(ob->bounds, -1, i, 0));
   root.grow(ob->bounds);
@@ -410,54 +418,64 @@ static size_t count_primitives(Geometry *geom)
 
 void BVHBuild::add_references(BVHRange &root)
 {
-  /* reserve space for references */
-  size_t num_alloc_references = 0;
-
-  foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        continue;
+  /* References of every object are gathered in parallel into their own storage, and concatenated
+   * in the object order afterwards, so that the result does not depend on the scheduling. */
+  struct ObjectReferences {
+    vector<BVHReference> references;
+    BoundBox bounds = BoundBox::empty;
+    BoundBox center = BoundBox::empty;
+  };
+  vector<ObjectReferences> object_references(objects.size());
+
+  parallel_for(blocked_range<size_t>(0, objects.size(), 1), [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      if (progress.get_cancel()) {
+        return;
       }
-      if (!ob->get_geometry()->is_instanced()) {
-        num_alloc_references += count_primitives(ob->get_geometry());
+
+      Object *ob = objects[i];
+      ObjectReferences &refs = object_references[i];
+
+      if (params.top_level) {
+        if (!ob->is_traceable()) {
+          continue;
+        }
+        if (!ob->get_geometry()->is_instanced()) {
+          refs.references.reserve(count_primitives(ob->get_geometry()));
+          add_reference_geometry(refs.references, refs.bounds, refs.center, ob->get_geometry(), i);
+        }
+        else {
+          add_reference_object(refs.references, refs.bounds, refs.center, ob, i);
+        }
       }
       else {
-        num_alloc_references++;
+        refs.references.reserve(count_primitives(ob->get_geometry()));
+        add_reference_geometry(refs.references, refs.bounds, refs.center, ob->get_geometry(), i);
       }
     }
-    else {
-      num_alloc_references += count_primitives(ob->get_geometry());
-    }
+  });
+
+  if (progress.get_cancel()) {
+    return;
   }
 
-  references.reserve(num_alloc_references);
+  /* reserve space for references */
+  size_t num_references = 0;
+  foreach (const ObjectReferences &refs, object_references) {
+    num_references += refs.references.size();
+  }
+  references.reserve(num_references);
 
   /* add references from objects */
   BoundBox bounds = BoundBox::empty, center = BoundBox::empty;
-  int i = 0;
 
-  foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        ++i;
-        continue;
-      }
-      if (!ob->get_geometry()->is_instanced()) {
-        add_reference_geometry(bounds, center, ob->get_geometry(), i);
-      }
-      else {
-        add_reference_object(bounds, center, ob, i);
-      }
-    }
-    else {
-      add_reference_geometry(bounds, center, ob->get_geometry(), i);
-    }
+  foreach (ObjectReferences &refs, object_references) {
+    references.insert(references.end(), refs.references.begin(), refs.references.end());
+    bounds.grow(refs.bounds);
+    center.grow(refs.center);
 
-    i++;
-
-    if (progress.get_cancel()) {
-      return;
-    }
+    /* Free memory early, to keep the peak memory usage closer to the serial version. */
+    vector<BVHReference>().swap(refs.references);
   }
 
   /* happens mostly on empty meshes */
@@ -57,11 +57,25 @@ class BVHBuild {
   friend class BVHObjectBinning;
 
   /* Adding references. */
-  void add_reference_triangles(BoundBox &root, BoundBox &center, Mesh *mesh, int i);
-  void add_reference_curves(BoundBox &root, BoundBox &center, Hair *hair, int i);
-  void add_reference_points(BoundBox &root, BoundBox &center, PointCloud *pointcloud, int i);
-  void add_reference_geometry(BoundBox &root, BoundBox &center, Geometry *geom, int i);
-  void add_reference_object(BoundBox &root, BoundBox &center, Object *ob, int i);
+  void add_reference_triangles(vector<BVHReference> &references,
+                               BoundBox &root,
+                               BoundBox &center,
+                               Mesh *mesh,
+                               int i);
+  void add_reference_curves(
+      vector<BVHReference> &references, BoundBox &root, BoundBox &center, Hair *hair, int i);
+  void add_reference_points(vector<BVHReference> &references,
+                            BoundBox &root,
+                            BoundBox &center,
+                            PointCloud *pointcloud,
+                            int i);
+  void add_reference_geometry(vector<BVHReference> &references,
+                              BoundBox &root,
+                              BoundBox &center,
+                              Geometry *geom,
+                              int i);
+  void add_reference_object(
+      vector<BVHReference> &references, BoundBox &root, BoundBox &center, Object *ob, int i);
   void add_references(BVHRange &root);
 
   /* Building. */
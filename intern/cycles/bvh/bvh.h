@@ -69,6 +69,11 @@ class BVH {
   vector<Geometry *> geometry;
   vector<Object *> objects;
 
+  /* Set when refitting made the BVH considerably worse than a new build would be, or when the
+   * changes could not be handled by a refit at all, so it should be built from scratch instead of
+   * refitting it again. */
+  bool need_rebuild;
+
   static BVH *create(const BVHParams &params,
                      const vector<Geometry *> &geometry,
                      const vector<Object *> &objects,
@@ -31,10 +31,26 @@ int BVHStackEntry::encodeIdx() const
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
-    : BVH(params_, geometry_, objects_)
+    : BVH(params_, geometry_, objects_), build_area_ratio(0.0f)
 {
 }
 
+/* Refitting keeps the topology of the tree, which gets worse as primitives move away from each
+ * other. Rebuild once the nodes are this much larger than after building. */
+static const float BVH_REFIT_MAX_AREA_GROWTH = 1.5f;
+
+static float children_area_sum(const BVHNode *node)
+{
+  float area = 0.0f;
+  if (!node->is_leaf()) {
+    for (int i = 0; i < node->num_children(); i++) {
+      const BVHNode *child = node->get_child(i);
+      area += child->bounds.safe_area() + children_area_sum(child);
+    }
+  }
+  return area;
+}
+
 void BVH2::build(Progress &progress, Stats *)
 {
   progress.set_substatus("Building BVH");
@@ -83,6 +99,10 @@ void BVH2::build(Progress &progress, Stats *)
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
 
+  const float root_area = root->bounds.safe_area();
+  build_area_ratio = (root_area > 0.0f) ? children_area_sum(root) / root_area : 0.0f;
+  need_rebuild = false;
+
   /* free build nodes */
   root->deleteSubtree();
 }
@@ -100,6 +120,102 @@ void BVH2::refit(Progress &progress)
   refit_nodes();
 }
 
+/* Cache
+ *
+ * The packed arrays are stored in order, each prefixed by its number of elements. Bump the version
+ * whenever the packed layout changes. */
+
+static const uint32_t BVH_CACHE_MAGIC = 0x48564243; /* "CBVH" */
+static const uint32_t BVH_CACHE_VERSION = 1;
+
+template<typename T> static void bvh_cache_write_value(vector<uint8_t> &data, const T &value)
+{
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+  data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T> static void bvh_cache_write_array(vector<uint8_t> &data, const array<T> &a)
+{
+  bvh_cache_write_value(data, uint64_t(a.size()));
+  if (a.size()) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(a.data());
+    data.insert(data.end(), bytes, bytes + sizeof(T) * a.size());
+  }
+}
+
+template<typename T>
+static bool bvh_cache_read_value(const vector<uint8_t> &data, size_t &offset, T &value)
+{
+  if (data.size() - offset < sizeof(T)) {
+    return false;
+  }
+  memcpy(&value, data.data() + offset, sizeof(T));
+  offset += sizeof(T);
+  return true;
+}
+
+template<typename T>
+static bool bvh_cache_read_array(const vector<uint8_t> &data, size_t &offset, array<T> &a)
+{
+  uint64_t size;
+  if (!bvh_cache_read_value(data, offset, size) || (data.size() - offset) / sizeof(T) < size) {
+    return false;
+  }
+  a.resize(size);
+  if (size) {
+    memcpy(a.data(), data.data() + offset, sizeof(T) * size);
+  }
+  offset += sizeof(T) * size;
+  return true;
+}
+
+void BVH2::write_cache(vector<uint8_t> &data) const
+{
+  data.clear();
+  bvh_cache_write_value(data, BVH_CACHE_MAGIC);
+  bvh_cache_write_value(data, BVH_CACHE_VERSION);
+  bvh_cache_write_value(data, pack.root_index);
+  bvh_cache_write_value(data, build_area_ratio);
+  bvh_cache_write_array(data, pack.nodes);
+  bvh_cache_write_array(data, pack.leaf_nodes);
+  bvh_cache_write_array(data, pack.prim_type);
+  bvh_cache_write_array(data, pack.prim_visibility);
+  bvh_cache_write_array(data, pack.prim_index);
+  bvh_cache_write_array(data, pack.prim_object);
+  bvh_cache_write_array(data, pack.prim_time);
+}
+
+bool BVH2::read_cache(const vector<uint8_t> &data)
+{
+  size_t offset = 0;
+  uint32_t magic, version;
+  if (!bvh_cache_read_value(data, offset, magic) || magic != BVH_CACHE_MAGIC ||
+      !bvh_cache_read_value(data, offset, version) || version != BVH_CACHE_VERSION)
+  {
+    return false;
+  }
+
+  PackedBVH cache_pack;
+  float cache_build_area_ratio;
+  if (!bvh_cache_read_value(data, offset, cache_pack.root_index) ||
+      !bvh_cache_read_value(data, offset, cache_build_area_ratio) ||
+      !bvh_cache_read_array(data, offset, cache_pack.nodes) ||
+      !bvh_cache_read_array(data, offset, cache_pack.leaf_nodes) ||
+      !bvh_cache_read_array(data, offset, cache_pack.prim_type) ||
+      !bvh_cache_read_array(data, offset, cache_pack.prim_visibility) ||
+      !bvh_cache_read_array(data, offset, cache_pack.prim_index) ||
+      !bvh_cache_read_array(data, offset, cache_pack.prim_object) ||
+      !bvh_cache_read_array(data, offset, cache_pack.prim_time) || offset != data.size())
+  {
+    return false;
+  }
+
+  pack = std::move(cache_pack);
+  build_area_ratio = cache_build_area_ratio;
+  need_rebuild = false;
+  return true;
+}
+
 BVHNode *BVH2::widen_children_nodes(const BVHNode *root)
 {
   return const_cast<BVHNode *>(root);
@@ -309,10 +425,16 @@ void BVH2::refit_nodes()
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
-  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  float children_area = 0.0f;
+  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility, children_area);
+
+  const float root_area = bbox.safe_area();
+  if (build_area_ratio > 0.0f && root_area > 0.0f) {
+    need_rebuild = children_area / root_area > build_area_ratio * BVH_REFIT_MAX_AREA_GROWTH;
+  }
 }
 
-void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
+void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &children_area)
 {
   if (leaf) {
     /* refit leaf node */
@@ -342,8 +464,9 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     BoundBox bbox0 = BoundBox::empty, bbox1 = BoundBox::empty;
     uint visibility0 = 0, visibility1 = 0;
 
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
+    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, children_area);
+    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, children_area);
+    children_area += bbox0.safe_area() + bbox1.safe_area();
 
     if (is_unaligned) {
       Transform aligned_space = transform_identity();
@@ -38,9 +38,18 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Store the packed BVH of a single geometry in a binary blob and restore it again, for caching
+   * on disk. Reading fails when the data was written by a different cache version. */
+  void write_cache(vector<uint8_t> &data) const;
+  bool read_cache(const vector<uint8_t> &data);
+
   PackedBVH pack;
 
  protected:
+  /* Sum of the bounds areas of all child nodes relative to the root bounds after building. Used
+   * to detect how much refitting degrades the tree. */
+  float build_area_ratio;
+
   /* constructor */
   friend class BVH;
   BVH2(const BVHParams &params,
@@ -82,7 +91,7 @@ class BVH2 : public BVH {
 
   /* refit */
   void refit_nodes();
-  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &children_area);
 
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
@@ -100,7 +100,8 @@ BVHEmbree::BVHEmbree(const BVHParams &params_,
     : BVH(params_, geometry_, objects_),
       scene(NULL),
       rtc_device(NULL),
-      build_quality(RTC_BUILD_QUALITY_REFIT)
+      build_quality(RTC_BUILD_QUALITY_REFIT),
+      num_refits(0)
 {
   SIMD_SET_FLUSH_TO_ZERO;
 }
@@ -147,10 +148,14 @@ void BVHEmbree::build(Progress &progress,
                             (params.use_spatial_split ? RTC_BUILD_QUALITY_HIGH :
                                                         RTC_BUILD_QUALITY_MEDIUM);
   rtcSetSceneBuildQuality(scene, build_quality);
+  num_refits = 0;
+  need_rebuild = false;
+  object_traceable.clear();
 
   int i = 0;
   foreach (Object *ob, objects) {
     if (params.top_level) {
+      object_traceable.push_back(ob->is_traceable());
       if (!ob->is_traceable()) {
         ++i;
         continue;
@@ -252,12 +257,27 @@ void BVHEmbree::add_instance(Object *ob, int i)
   BVHEmbree *instance_bvh = (BVHEmbree *)(ob->get_geometry()->bvh);
   assert(instance_bvh != NULL);
 
+  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
+  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
+  set_instance_transform(geom_id, ob);
+
+  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
+  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
+#  if EMBREE_MAJOR_VERSION >= 4
+  rtcSetGeometryEnableFilterFunctionFromArguments(geom_id, true);
+#  endif
+
+  rtcCommitGeometry(geom_id);
+  rtcAttachGeometryByID(scene, geom_id, i * 2);
+  rtcReleaseGeometry(geom_id);
+}
+
+void BVHEmbree::set_instance_transform(RTCGeometry geom_id, const Object *ob)
+{
   const size_t num_object_motion_steps = ob->use_motion() ? ob->get_motion().size() : 1;
   const size_t num_motion_steps = min(num_object_motion_steps, (size_t)RTC_MAX_TIME_STEP_COUNT);
   assert(num_object_motion_steps <= RTC_MAX_TIME_STEP_COUNT);
 
-  RTCGeometry geom_id = rtcNewGeometry(rtc_device, RTC_GEOMETRY_TYPE_INSTANCE);
-  rtcSetGeometryInstancedScene(geom_id, instance_bvh->scene);
   rtcSetGeometryTimeStepCount(geom_id, num_motion_steps);
 
   if (ob->use_motion()) {
@@ -281,16 +301,6 @@ void BVHEmbree::add_instance(Object *ob, int i)
     rtcSetGeometryTransform(
         geom_id, 0, RTC_FORMAT_FLOAT3X4_ROW_MAJOR, (const float *)&ob->get_tfm());
   }
-
-  rtcSetGeometryUserData(geom_id, (void *)instance_bvh->scene);
-  rtcSetGeometryMask(geom_id, ob->visibility_for_tracing());
-#  if EMBREE_MAJOR_VERSION >= 4
-  rtcSetGeometryEnableFilterFunctionFromArguments(geom_id, true);
-#  endif
-
-  rtcCommitGeometry(geom_id);
-  rtcAttachGeometryByID(scene, geom_id, i * 2);
-  rtcReleaseGeometry(geom_id);
 }
 
 void BVHEmbree::add_triangles(const Object *ob, const Mesh *mesh, int i)
@@ -684,10 +694,43 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Objects can only be updated in place in the scene BVH, adding or removing them from it when
+   * their bounds became (in)valid requires a new build. */
+  if (params.top_level) {
+    for (size_t i = 0; i < objects.size(); i++) {
+      if (i >= object_traceable.size() || objects[i]->is_traceable() != object_traceable[i]) {
+        need_rebuild = true;
+        return;
+      }
+    }
+  }
+
+  /* For dynamic scenes Embree builds a BVH per geometry, which can be refitted instead of rebuilt
+   * for triangles when only the vertices changed. That degrades the BVH as the geometry deforms
+   * over many updates, so rebuild regularly. Other build qualities always rebuild the scene. */
+  const int max_refits = 16;
+  const bool use_refit = build_quality == RTC_BUILD_QUALITY_LOW && num_refits < max_refits;
+  num_refits = use_refit ? num_refits + 1 : 0;
+  const RTCBuildQuality tri_build_quality = use_refit ? RTC_BUILD_QUALITY_REFIT : build_quality;
+
+  /* Update all vertex buffers and instance transforms, then tell Embree to rebuild/-fit the BVHs.
+   * The scene BVH is only refit when no geometry was added or removed, so the geometry IDs still
+   * match the ones assigned in #build(). */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
-    if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
+    if (params.top_level && ob->is_traceable() && ob->get_geometry()->is_instanced()) {
+      BVHEmbree *instance_bvh = (BVHEmbree *)(ob->get_geometry()->bvh);
+      RTCGeometry geom = rtcGetGeometry(scene, geom_id);
+      rtcSetGeometryInstancedScene(geom, instance_bvh->scene);
+      set_instance_transform(geom, ob);
+      rtcSetGeometryUserData(geom, (void *)instance_bvh->scene);
+      rtcSetGeometryMask(geom, ob->visibility_for_tracing());
+      rtcCommitGeometry(geom);
+    }
+    else if (params.top_level && (!ob->is_traceable() || !ob->get_geometry()->is_modified())) {
+      /* Nothing to update for geometry with applied transform that did not change. */
+    }
+    else {
       Geometry *geom = ob->get_geometry();
 
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
@@ -696,6 +739,7 @@ void BVHEmbree::refit(Progress &progress)
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
           set_tri_vertex_buffer(geom, mesh, true);
           rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
+          rtcSetGeometryBuildQuality(geom, tri_build_quality);
           rtcCommitGeometry(geom);
         }
       }
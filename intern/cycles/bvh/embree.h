@@ -64,10 +64,15 @@ class BVHEmbree : public BVH {
   void set_point_vertex_buffer(RTCGeometry geom_id,
                                const PointCloud *pointcloud,
                                const bool update);
+  void set_instance_transform(RTCGeometry geom_id, const Object *ob);
 
   RTCDevice rtc_device;
   bool rtc_device_is_sycl;
   enum RTCBuildQuality build_quality;
+  /* Number of refits since the last build of the triangle geometry BVHs. */
+  int num_refits;
+  /* Traceable state of the objects in the last build of the scene BVH. */
+  vector<bool> object_traceable;
 };
 
 CCL_NAMESPACE_END
@@ -505,6 +505,38 @@ bool GPUDevice::load_texture_info()
   }
 }
 
+int GPUDevice::limit_num_concurrent_states(const int num_states,
+                                           const size_t state_size,
+                                           const int min_num_states)
+{
+  if (state_size == 0 || num_states <= min_num_states) {
+    return num_states;
+  }
+
+  size_t total = 0, free = 0;
+  get_device_memory_info(total, free);
+
+  /* Only use half of the free memory: the integrator queues, sorting and path split buffers are
+   * also sized by the number of states, and kernels need some working memory too. */
+  const size_t available = (free > device_working_headroom) ?
+                               (free - device_working_headroom) / 2 :
+                               0;
+  const size_t max_num_states = available / state_size;
+  if (max_num_states >= size_t(num_states)) {
+    return num_states;
+  }
+
+  /* Going below the minimum would hurt occupancy more than moving textures to host memory, which
+   * happens when the states do not fit into the device memory. */
+  const int limited_num_states = max(int(max_num_states), min_num_states);
+
+  VLOG_DEVICE_STATS << "Limiting GPU queue concurrent states from " << num_states << " to "
+                    << limited_num_states << ", " << string_human_readable_size(free)
+                    << " of device memory is free";
+
+  return limited_num_states;
+}
+
 void GPUDevice::init_host_memory(size_t preferred_texture_headroom,
                                  size_t preferred_working_headroom)
 {
@@ -357,6 +357,10 @@ class GPUDevice : public Device {
    * re-initialization might be needed). */
   virtual bool load_texture_info();
 
+  /* Limit the number of integrator states of the given size to what fits into the currently free
+   * device memory, but keep at least min_num_states. */
+  int limit_num_concurrent_states(int num_states, size_t state_size, int min_num_states);
+
  protected:
   /* Memory allocation, only accessed through device_memory. */
   friend class device_memory;
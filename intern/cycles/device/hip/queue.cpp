@@ -44,6 +44,11 @@ int HIPDeviceQueue::num_concurrent_states(const size_t state_size) const
     }
   }
 
+  /* Use fewer states on devices which are close to running out of memory, as long as there are
+   * still enough of them to keep the device busy. */
+  num_states = hip_device_->limit_num_concurrent_states(
+      num_states, state_size, 2 * num_concurrent_busy_states(state_size));
+
   VLOG_DEVICE_STATS << "GPU queue concurrent states: " << num_states << ", using up to "
                     << string_human_readable_size(num_states * state_size);
 
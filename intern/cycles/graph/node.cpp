@@ -608,7 +608,7 @@ void float3_array_hash(const Node *node, const SocketType &socket, MD5Hash &md5)
 
 }  // namespace
 
-void Node::hash(MD5Hash &md5)
+void Node::hash(MD5Hash &md5, const bool portable)
 {
   md5.append(type->name.string());
 
@@ -649,7 +649,12 @@ void Node::hash(MD5Hash &md5)
       case SocketType::CLOSURE:
         break;
       case SocketType::STRING:
-        value_hash<ustring>(this, socket, md5);
+        if (portable) {
+          md5.append(get_socket_value<ustring>(this, socket).string());
+        }
+        else {
+          value_hash<ustring>(this, socket, md5);
+        }
         break;
       case SocketType::ENUM:
         value_hash<int>(this, socket, md5);
@@ -658,7 +663,9 @@ void Node::hash(MD5Hash &md5)
         value_hash<Transform>(this, socket, md5);
         break;
       case SocketType::NODE:
-        value_hash<void *>(this, socket, md5);
+        if (!portable) {
+          value_hash<void *>(this, socket, md5);
+        }
         break;
 
       case SocketType::BOOLEAN_ARRAY:
@@ -686,13 +693,22 @@ void Node::hash(MD5Hash &md5)
         array_hash<float2>(this, socket, md5);
         break;
       case SocketType::STRING_ARRAY:
-        array_hash<ustring>(this, socket, md5);
+        if (portable) {
+          for (const ustring &str : get_socket_value<array<ustring>>(this, socket)) {
+            md5.append(str.string());
+          }
+        }
+        else {
+          array_hash<ustring>(this, socket, md5);
+        }
         break;
       case SocketType::TRANSFORM_ARRAY:
         array_hash<Transform>(this, socket, md5);
         break;
       case SocketType::NODE_ARRAY:
-        array_hash<void *>(this, socket, md5);
+        if (!portable) {
+          array_hash<void *>(this, socket, md5);
+        }
         break;
 
       case SocketType::UNDEFINED:
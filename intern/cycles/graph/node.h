@@ -157,8 +157,10 @@ struct Node {
   /* equals */
   bool equals(const Node &other) const;
 
-  /* compute hash of node and its socket values */
-  void hash(MD5Hash &md5);
+  /* compute hash of node and its socket values. A portable hash does not depend on any pointers
+   * and can be compared between processes: references to other nodes are skipped, and strings
+   * are hashed by their contents. */
+  void hash(MD5Hash &md5, const bool portable = false);
 
   /* Get total size of this node. */
   size_t get_total_size_in_bytes() const;
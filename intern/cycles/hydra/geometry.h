@@ -34,6 +34,10 @@ template<typename Base, typename CyclesBase> class HdCyclesGeometry : public Bas
 
   PXR_NS::HdDirtyBits _PropagateDirtyBits(PXR_NS::HdDirtyBits bits) const override;
 
+  // Read data from the scene delegate before the scene lock is acquired. Hydra syncs prims in
+  // parallel, so work done here is not serialized with the sync of other prims.
+  virtual void Prefetch(PXR_NS::HdSceneDelegate *sceneDelegate, PXR_NS::HdDirtyBits dirtyBits);
+
   virtual void Populate(PXR_NS::HdSceneDelegate *sceneDelegate,
                         PXR_NS::HdDirtyBits dirtyBits,
                         bool &rebuild) = 0;
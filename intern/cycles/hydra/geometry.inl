@@ -79,6 +79,32 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
 #endif
   Base::_UpdateVisibility(sceneDelegate, dirtyBits);
 
+  const SdfPath &id = Base::GetId();
+
+  // Query transforms outside of the scene lock, since instancers can be expensive to evaluate
+  const bool transformsDirty = HdChangeTracker::IsTransformDirty(*dirtyBits, id) ||
+                               HdChangeTracker::IsInstancerDirty(*dirtyBits, id);
+
+  if (HdChangeTracker::IsTransformDirty(*dirtyBits, id)) {
+    _geomTransform = sceneDelegate->GetTransform(id);
+  }
+
+  const auto instancer = static_cast<HdCyclesInstancer *>(
+      sceneDelegate->GetRenderIndex().GetInstancer(Base::GetInstancerId()));
+
+  VtMatrix4dArray transforms;
+  if (transformsDirty) {
+    if (instancer) {
+      transforms = instancer->ComputeInstanceTransforms(id);
+    }
+    else {
+      // Default to a single instance with an identity transform
+      transforms.push_back(GfMatrix4d(1.0));
+    }
+  }
+
+  Prefetch(sceneDelegate, *dirtyBits);
+
   const SceneLock lock(renderParam);
 
   if (*dirtyBits & HdChangeTracker::DirtyMaterialId) {
@@ -108,36 +134,18 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
     _geom->set_used_shaders(usedShaders);
   }
 
-  const SdfPath &id = Base::GetId();
-
   if (HdChangeTracker::IsPrimIdDirty(*dirtyBits, id)) {
     // This needs to be corrected in the AOV
     _instances[0]->set_pass_id(Base::GetPrimId() + 1);
   }
 
-  if (HdChangeTracker::IsTransformDirty(*dirtyBits, id)) {
-    _geomTransform = sceneDelegate->GetTransform(id);
-  }
-
-  if (HdChangeTracker::IsTransformDirty(*dirtyBits, id) ||
-      HdChangeTracker::IsInstancerDirty(*dirtyBits, id)) {
-    const auto instancer = static_cast<HdCyclesInstancer *>(
-        sceneDelegate->GetRenderIndex().GetInstancer(Base::GetInstancerId()));
-
+  if (transformsDirty) {
     // Make sure the first object attribute is the instanceId
     assert(_instances[0]->attributes.size() >= 1 &&
            _instances[0]->attributes.front().name() == HdAovTokens->instanceId.GetString());
 
-    VtMatrix4dArray transforms;
-    if (instancer) {
-      transforms = instancer->ComputeInstanceTransforms(id);
-      _instances[0]->attributes.front() = ParamValue(HdAovTokens->instanceId.GetString(), +0.0f);
-    }
-    else {
-      // Default to a single instance with an identity transform
-      transforms.push_back(GfMatrix4d(1.0));
-      _instances[0]->attributes.front() = ParamValue(HdAovTokens->instanceId.GetString(), -1.0f);
-    }
+    _instances[0]->attributes.front() = ParamValue(HdAovTokens->instanceId.GetString(),
+                                                   instancer ? +0.0f : -1.0f);
 
     const size_t oldSize = _instances.size();
     const size_t newSize = transforms.size();
@@ -178,13 +186,25 @@ void HdCyclesGeometry<Base, CyclesBase>::Sync(HdSceneDelegate *sceneDelegate,
     _geom->tag_update(lock.scene, rebuild);
   }
 
+  // Only tag instances that changed, so that e.g. a points-only update of an instanced mesh does
+  // not cause all of its objects to be updated as well
   for (Object *instance : _instances) {
-    instance->tag_update(lock.scene);
+    if (instance->is_modified()) {
+      instance->tag_update(lock.scene);
+    }
   }
 
   *dirtyBits = HdChangeTracker::Clean;
 }
 
+template<typename Base, typename CyclesBase>
+void HdCyclesGeometry<Base, CyclesBase>::Prefetch(HdSceneDelegate *sceneDelegate,
+                                                  HdDirtyBits dirtyBits)
+{
+  TF_UNUSED(sceneDelegate);
+  TF_UNUSED(dirtyBits);
+}
+
 template<typename Base, typename CyclesBase>
 void HdCyclesGeometry<Base, CyclesBase>::Finalize(HdRenderParam *renderParam)
 {
@@ -131,6 +131,13 @@ HdDirtyBits HdCyclesMesh::_PropagateDirtyBits(HdDirtyBits bits) const
   return bits;
 }
 
+void HdCyclesMesh::Prefetch(HdSceneDelegate *sceneDelegate, HdDirtyBits dirtyBits)
+{
+  if (dirtyBits & HdChangeTracker::DirtyPoints) {
+    PrefetchPoints(sceneDelegate);
+  }
+}
+
 void HdCyclesMesh::Populate(HdSceneDelegate *sceneDelegate, HdDirtyBits dirtyBits, bool &rebuild)
 {
   if (HdChangeTracker::IsTopologyDirty(dirtyBits, GetId())) {
@@ -138,7 +145,7 @@ void HdCyclesMesh::Populate(HdSceneDelegate *sceneDelegate, HdDirtyBits dirtyBit
   }
 
   if (dirtyBits & HdChangeTracker::DirtyPoints) {
-    PopulatePoints(sceneDelegate);
+    PopulatePoints();
   }
 
   // Must happen after topology update, so that normals attribute size can be calculated
@@ -157,8 +164,10 @@ void HdCyclesMesh::Populate(HdSceneDelegate *sceneDelegate, HdDirtyBits dirtyBit
             (_geom->subd_face_corners_is_modified());
 }
 
-void HdCyclesMesh::PopulatePoints(HdSceneDelegate *sceneDelegate)
+void HdCyclesMesh::PrefetchPoints(HdSceneDelegate *sceneDelegate)
 {
+  _hasPrefetchedPoints = false;
+
   VtValue value;
 
   for (const HdExtComputationPrimvarDescriptor &desc :
@@ -185,15 +194,26 @@ void HdCyclesMesh::PopulatePoints(HdSceneDelegate *sceneDelegate)
 
   const auto &points = value.UncheckedGet<VtVec3fArray>();
 
-  TF_VERIFY(points.size() >= static_cast<size_t>(_topology.GetNumPoints()));
-
-  array<float3> pointsDataCycles;
-  pointsDataCycles.reserve(points.size());
+  _prefetchedPoints.clear();
+  _prefetchedPoints.reserve(points.size());
   for (const GfVec3f &point : points) {
-    pointsDataCycles.push_back_reserved(make_float3(point[0], point[1], point[2]));
+    _prefetchedPoints.push_back_reserved(make_float3(point[0], point[1], point[2]));
   }
 
-  _geom->set_verts(pointsDataCycles);
+  _hasPrefetchedPoints = true;
+}
+
+void HdCyclesMesh::PopulatePoints()
+{
+  if (!_hasPrefetchedPoints) {
+    return;
+  }
+
+  TF_VERIFY(_prefetchedPoints.size() >= static_cast<size_t>(_topology.GetNumPoints()));
+
+  // Steals the prefetched data
+  _geom->set_verts(_prefetchedPoints);
+  _hasPrefetchedPoints = false;
 }
 
 void HdCyclesMesh::PopulateNormals(HdSceneDelegate *sceneDelegate)
@@ -524,6 +544,8 @@ void HdCyclesMesh::Finalize(PXR_NS::HdRenderParam *renderParam)
 {
   _topology = HdMeshTopology();
   _primitiveParams.clear();
+  _prefetchedPoints.clear();
+  _hasPrefetchedPoints = false;
 
   HdCyclesGeometry<PXR_NS::HdMesh, Mesh>::Finalize(renderParam);
 }
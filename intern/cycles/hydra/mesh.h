@@ -7,6 +7,8 @@
 
 #include "hydra/config.h"
 #include "hydra/geometry.h"
+#include "util/array.h"
+#include "util/types.h"
 
 #include <pxr/imaging/hd/mesh.h>
 #include <pxr/imaging/hd/meshUtil.h>
@@ -30,11 +32,14 @@ class HdCyclesMesh final : public HdCyclesGeometry<PXR_NS::HdMesh, CCL_NS::Mesh>
  private:
   PXR_NS::HdDirtyBits _PropagateDirtyBits(PXR_NS::HdDirtyBits bits) const override;
 
+  void Prefetch(PXR_NS::HdSceneDelegate *sceneDelegate, PXR_NS::HdDirtyBits dirtyBits) override;
+
   void Populate(PXR_NS::HdSceneDelegate *sceneDelegate,
                 PXR_NS::HdDirtyBits dirtyBits,
                 bool &rebuild) override;
 
-  void PopulatePoints(PXR_NS::HdSceneDelegate *sceneDelegate);
+  void PrefetchPoints(PXR_NS::HdSceneDelegate *sceneDelegate);
+  void PopulatePoints();
   void PopulateNormals(PXR_NS::HdSceneDelegate *sceneDelegate);
 
   void PopulatePrimvars(PXR_NS::HdSceneDelegate *sceneDelegate);
@@ -44,6 +49,10 @@ class HdCyclesMesh final : public HdCyclesGeometry<PXR_NS::HdMesh, CCL_NS::Mesh>
   PXR_NS::HdMeshUtil _util;
   PXR_NS::HdMeshTopology _topology;
   PXR_NS::VtIntArray _primitiveParams;
+
+  // Points read in Prefetch, moved to the Cycles mesh in Populate
+  CCL_NS::array<CCL_NS::float3> _prefetchedPoints;
+  bool _hasPrefetchedPoints = false;
 };
 
 HDCYCLES_NAMESPACE_CLOSE_SCOPE
@@ -57,6 +57,8 @@ PathTrace::PathTrace(Device *device,
   work_balance_infos_.resize(path_trace_works_.size());
   work_balance_do_initial(work_balance_infos_);
 
+  kernel_work_.resize(DEVICE_KERNEL_NUM, 0);
+
   render_scheduler.set_need_schedule_rebalance(path_trace_works_.size() > 1);
 }
 
@@ -390,6 +392,8 @@ void PathTrace::path_trace(RenderWork &render_work)
 
   thread_capture_fp_settings();
 
+  vector<PathTraceWork::RenderStatistics> work_statistics(num_works);
+
   parallel_for(0, num_works, [&](int i) {
     const double work_start_time = time_dt();
     const int num_samples = render_work.path_trace.num_samples;
@@ -399,7 +403,7 @@ void PathTrace::path_trace(RenderWork &render_work)
       return;
     }
 
-    PathTraceWork::RenderStatistics statistics;
+    PathTraceWork::RenderStatistics &statistics = work_statistics[i];
     path_trace_work->render_samples(statistics,
                                     render_work.path_trace.start_sample,
                                     num_samples,
@@ -414,6 +418,12 @@ void PathTrace::path_trace(RenderWork &render_work)
               << " seconds per sample), occupancy: " << statistics.occupancy;
   });
 
+  for (const PathTraceWork::RenderStatistics &statistics : work_statistics) {
+    for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+      kernel_work_[i] += statistics.kernel_work[i];
+    }
+  }
+
   float occupancy_accum = 0.0f;
   for (const WorkBalanceInfo &balance_info : work_balance_infos_) {
     occupancy_accum += balance_info.occupancy;
@@ -454,6 +464,7 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
 
     render_scheduler_.report_adaptive_filter_time(
         render_work, time_dt() - start_time, is_cancel_requested());
+    render_scheduler_.report_adaptive_filter_active_pixels(render_work, num_active_pixels);
 
     if (num_active_pixels == 0) {
       VLOG_WORK << "All pixels converged.";
@@ -757,6 +768,15 @@ void PathTrace::rebalance(const RenderWork &render_work)
 
   copy_to_render_buffers(&big_tile_cpu_buffers);
 
+  /* Stop rendering on devices which barely contribute, their part of the big tile is given to the
+   * other devices when copying the render buffers back. */
+  for (const int excluded_index : work_balance_do_exclude(work_balance_infos_)) {
+    VLOG_INFO << "Excluding " << path_trace_works_[excluded_index]->get_device()->info.description
+              << " from path tracing due to its low contribution to the render.";
+    path_trace_works_.erase(path_trace_works_.begin() + excluded_index);
+  }
+  render_scheduler_.set_need_schedule_rebalance(path_trace_works_.size() > 1);
+
   render_state_.need_reset_params = true;
   update_work_buffer_params_if_needed(render_work);
 
@@ -1042,8 +1062,7 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
      *    ensure proper denoiser is used. */
     set_denoiser_params(denoise_params);
 
-    /* Number of samples doesn't matter too much, since the samples count pass will be used. */
-    denoiser_->denoise_buffer(full_frame_buffers.params, &full_frame_buffers, 0, false);
+    denoise_full_frame_buffers(&full_frame_buffers);
 
     render_state_.has_denoised_result = true;
   }
@@ -1059,6 +1078,88 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   full_frame_state_.render_buffers = nullptr;
 }
 
+/* Full-frame buffers bigger than this are denoised in tiles, with an overlap which gives the
+ * denoiser enough context around the tile to avoid visible seams. */
+static constexpr int kDenoiseTileSize = 4096;
+static constexpr int kDenoiseTileOverlap = 128;
+
+void PathTrace::denoise_full_frame_buffers(RenderBuffers *buffers)
+{
+  const BufferParams &params = buffers->params;
+
+  /* Number of samples doesn't matter too much, since the samples count pass will be used. */
+  if (params.width <= kDenoiseTileSize && params.height <= kDenoiseTileSize) {
+    denoiser_->denoise_buffer(params, buffers, 0, false);
+    return;
+  }
+
+  /* Denoising the whole frame at once requires the denoiser to hold copies of the color and
+   * guiding passes of all pixels, which does not fit into memory for very large resolutions. */
+  VLOG_WORK << "Denoising " << params.width << "x" << params.height << " full frame buffer in "
+            << kDenoiseTileSize << "x" << kDenoiseTileSize << " tiles.";
+
+  const size_t pass_stride = params.pass_stride;
+  float *full_frame_data = buffers->buffer.data();
+
+  RenderBuffers tile_buffers(cpu_device_.get());
+
+  for (int tile_y = 0; tile_y < params.height; tile_y += kDenoiseTileSize) {
+    for (int tile_x = 0; tile_x < params.width; tile_x += kDenoiseTileSize) {
+      if (is_cancel_requested()) {
+        return;
+      }
+
+      const int tile_width = min(kDenoiseTileSize, params.width - tile_x);
+      const int tile_height = min(kDenoiseTileSize, params.height - tile_y);
+
+      /* Region which is denoised, including the overlap. */
+      const int x0 = max(tile_x - kDenoiseTileOverlap, 0);
+      const int y0 = max(tile_y - kDenoiseTileOverlap, 0);
+      const int x1 = min(tile_x + tile_width + kDenoiseTileOverlap, params.width);
+      const int y1 = min(tile_y + tile_height + kDenoiseTileOverlap, params.height);
+
+      BufferParams tile_params = params;
+      tile_params.width = x1 - x0;
+      tile_params.height = y1 - y0;
+      tile_params.window_x = 0;
+      tile_params.window_y = 0;
+      tile_params.window_width = tile_params.width;
+      tile_params.window_height = tile_params.height;
+      tile_params.full_x = params.full_x + x0;
+      tile_params.full_y = params.full_y + y0;
+      tile_params.update_offset_stride();
+
+      tile_buffers.reset(tile_params);
+      float *tile_data = tile_buffers.buffer.data();
+
+      for (int y = y0; y < y1; y++) {
+        memcpy(tile_data + (size_t(y - y0) * tile_params.width) * pass_stride,
+               full_frame_data + (size_t(y) * params.width + x0) * pass_stride,
+               sizeof(float) * tile_params.width * pass_stride);
+      }
+
+      denoiser_->denoise_buffer(tile_params, &tile_buffers, 0, false);
+
+      /* Only write back the tile itself, the overlap is denoised by the neighbor tiles. */
+      for (int y = tile_y; y < tile_y + tile_height; y++) {
+        memcpy(full_frame_data + (size_t(y) * params.width + tile_x) * pass_stride,
+               tile_data + (size_t(y - y0) * tile_params.width + (tile_x - x0)) * pass_stride,
+               sizeof(float) * tile_width * pass_stride);
+      }
+    }
+  }
+}
+
+const vector<uint64_t> &PathTrace::get_kernel_work() const
+{
+  return kernel_work_;
+}
+
+void PathTrace::clear_kernel_work()
+{
+  std::fill(kernel_work_.begin(), kernel_work_.end(), 0);
+}
+
 int PathTrace::get_num_render_tile_samples() const
 {
   if (full_frame_state_.render_buffers) {
@@ -142,6 +142,11 @@ class PathTrace {
   /* Get number of samples in the current big tile render buffers. */
   int get_num_render_tile_samples() const;
 
+  /* Number of paths processed by every integrator kernel since the last call to
+   * clear_kernel_work(), summed over all devices and indexed by DeviceKernel. */
+  const vector<uint64_t> &get_kernel_work() const;
+  void clear_kernel_work();
+
   /* Get pass data of the entire big tile.
    * This call puts pass render result from all devices into the final pixels storage.
    *
@@ -209,6 +214,7 @@ class PathTrace {
   void path_trace(RenderWork &render_work);
   void adaptive_sample(RenderWork &render_work);
   void denoise(const RenderWork &render_work);
+  void denoise_full_frame_buffers(RenderBuffers *buffers);
   void cryptomatte_postprocess(const RenderWork &render_work);
   void update_display(const RenderWork &render_work);
   void rebalance(const RenderWork &render_work);
@@ -278,6 +284,9 @@ class PathTrace {
   /* Per-path trace work information needed for multi-device balancing. */
   vector<WorkBalanceInfo> work_balance_infos_;
 
+  /* Accumulated RenderStatistics::kernel_work of all path trace works. */
+  vector<uint64_t> kernel_work_;
+
   /* Render buffer parameters of the full frame and current big tile. */
   BufferParams full_params_;
   BufferParams big_tile_params_;
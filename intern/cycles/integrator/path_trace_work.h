@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "device/kernel.h"
 #include "integrator/pass_accessor.h"
 #include "scene/pass.h"
 #include "session/buffers.h"
@@ -23,6 +24,11 @@ class PathTraceWork {
  public:
   struct RenderStatistics {
     float occupancy = 1.0f;
+
+    /* Number of paths processed by every integrator kernel, indexed by DeviceKernel. For the
+     * intersection kernels this is the number of rays traced, for the shading kernels the number
+     * of shader evaluations. */
+    uint64_t kernel_work[DEVICE_KERNEL_NUM] = {};
   };
 
   /* Create path trace work which fits best the device.
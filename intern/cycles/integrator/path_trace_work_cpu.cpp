@@ -16,6 +16,7 @@
 #include "scene/scene.h"
 #include "session/buffers.h"
 
+#include "util/algorithm.h"
 #include "util/atomic.h"
 #include "util/log.h"
 #include "util/tbb.h"
@@ -67,6 +68,10 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
   const int64_t image_height = effective_buffer_params_.height;
   const int64_t total_pixels_num = image_width * image_height;
 
+  for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
+    std::fill_n(kernel_globals.kernel_work, DEVICE_KERNEL_NUM, 0);
+  }
+
   if (device_->profiler.active()) {
     for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
       kernel_globals.start_profiling();
@@ -106,6 +111,12 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
   }
 
   statistics.occupancy = 1.0f;
+
+  for (const CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
+    for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+      statistics.kernel_work[i] += kernel_globals.kernel_work[i];
+    }
+  }
 }
 
 void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_globals,
@@ -146,6 +157,8 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobalsCPU *kernel_glo
         break;
       }
     }
+    kernel_globals->kernel_work[has_bake ? DEVICE_KERNEL_INTEGRATOR_INIT_FROM_BAKE :
+                                           DEVICE_KERNEL_INTEGRATOR_INIT_FROM_CAMERA]++;
 
     kernels_.integrator_megakernel(kernel_globals, state, render_buffer);
 
@@ -10,6 +10,7 @@
 #include "integrator/pass_accessor_gpu.h"
 #include "scene/scene.h"
 #include "session/buffers.h"
+#include "util/algorithm.h"
 #include "util/log.h"
 #include "util/string.h"
 #include "util/tbb.h"
@@ -87,6 +88,8 @@ PathTraceWorkGPU::PathTraceWorkGPU(Device *device,
           device, "integrator_shader_raytrace_sort_counter", MEM_READ_WRITE),
       integrator_shader_mnee_sort_counter_(
           device, "integrator_shader_mnee_sort_counter", MEM_READ_WRITE),
+      integrator_intersect_closest_sort_counter_(
+          device, "integrator_intersect_closest_sort_counter", MEM_READ_WRITE),
       integrator_shader_sort_prefix_sum_(
           device, "integrator_shader_sort_prefix_sum", MEM_READ_WRITE),
       integrator_shader_sort_partition_key_offsets_(
@@ -256,6 +259,12 @@ void PathTraceWorkGPU::alloc_integrator_sorting()
   integrator_state_gpu_.sort_partition_divisor = (int)divide_up(max_num_paths_,
                                                                 num_sort_partitions_);
 
+  /* Sorting of rays for the closest intersection kernel by their direction and origin. This helps
+   * scenes with incoherent secondary rays, but costs extra sorting passes, so it is opt-in. */
+  const char *sort_intersect_closest_str = getenv("CYCLES_SORT_INTERSECT_CLOSEST");
+  integrator_state_gpu_.sort_intersect_closest = (sort_intersect_closest_str &&
+                                                  atoi(sort_intersect_closest_str) != 0);
+
   if (num_sort_partitions_ > 1 && queue_->supports_local_atomic_sort()) {
     /* Allocate array for partitioned shader sorting using local atomics. */
     const int num_offsets = (device_scene_->data.max_shaders + 1) * num_sort_partitions_;
@@ -296,6 +305,15 @@ void PathTraceWorkGPU::alloc_integrator_sorting()
             (int *)integrator_shader_mnee_sort_counter_.device_pointer;
       }
     }
+
+    if (integrator_state_gpu_.sort_intersect_closest) {
+      if (integrator_intersect_closest_sort_counter_.size() < sort_buckets) {
+        integrator_intersect_closest_sort_counter_.alloc(sort_buckets);
+        integrator_intersect_closest_sort_counter_.zero_to_device();
+        integrator_state_gpu_.sort_key_counter[DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST] =
+            (int *)integrator_intersect_closest_sort_counter_.device_pointer;
+      }
+    }
   }
 }
 
@@ -356,6 +374,8 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
 
   enqueue_reset();
 
+  std::fill_n(kernel_work_, DEVICE_KERNEL_NUM, 0);
+
   int num_iterations = 0;
   uint64_t num_busy_accum = 0;
 
@@ -401,6 +421,7 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
   }
 
   statistics.occupancy = static_cast<float>(num_busy_accum) / num_iterations / max_num_paths_;
+  std::copy_n(kernel_work_, DEVICE_KERNEL_NUM, statistics.kernel_work);
 }
 
 DeviceKernel PathTraceWorkGPU::get_most_queued_kernel() const
@@ -439,6 +460,9 @@ void PathTraceWorkGPU::enqueue_reset()
   {
     queue_->zero_to_device(integrator_shader_mnee_sort_counter_);
   }
+  if (integrator_intersect_closest_sort_counter_.size() != 0) {
+    queue_->zero_to_device(integrator_intersect_closest_sort_counter_);
+  }
 
   /* Tiles enqueue need to know number of active paths, which is based on this counter. Zero the
    * counter on the host side because `zero_to_device()` is not doing it. */
@@ -538,6 +562,8 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
 
   DCHECK_LE(work_size, max_num_paths_);
 
+  kernel_work_[kernel] += min(num_queued, num_paths_limit);
+
   switch (kernel) {
     case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST: {
       /* Closest ray intersection kernels with integrator state and render buffer. */
@@ -893,6 +919,8 @@ void PathTraceWorkGPU::enqueue_work_tiles(DeviceKernel kernel,
     max_tile_work_size = max(max_tile_work_size, tile_work_size);
   }
 
+  kernel_work_[kernel] += path_index_offset - num_active_paths;
+
   queue_->copy_to_device(work_tiles_);
 
   device_ptr d_work_tiles = work_tiles_.device_pointer;
@@ -1216,6 +1244,9 @@ int PathTraceWorkGPU::shadow_catcher_count_possible_splits()
 
 bool PathTraceWorkGPU::kernel_uses_sorting(DeviceKernel kernel)
 {
+  if (kernel == DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST) {
+    return integrator_state_gpu_.sort_intersect_closest;
+  }
   return (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE ||
           kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE ||
           kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE);
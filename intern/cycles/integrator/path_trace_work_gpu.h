@@ -133,6 +133,7 @@ class PathTraceWorkGPU : public PathTraceWork {
   device_vector<int> integrator_shader_sort_counter_;
   device_vector<int> integrator_shader_raytrace_sort_counter_;
   device_vector<int> integrator_shader_mnee_sort_counter_;
+  device_vector<int> integrator_intersect_closest_sort_counter_;
   device_vector<int> integrator_shader_sort_prefix_sum_;
   device_vector<int> integrator_shader_sort_partition_key_offsets_;
   /* Path split. */
@@ -162,6 +163,9 @@ class PathTraceWorkGPU : public PathTraceWork {
   /* Maximum number of concurrent integrator states. */
   int max_num_paths_;
 
+  /* Number of paths processed by every kernel during the current render_samples() call. */
+  uint64_t kernel_work_[DEVICE_KERNEL_NUM] = {};
+
   /* Minimum number of paths which keeps the device bust. If the actual number of paths falls below
    * this value more work will be scheduled. */
   int min_num_active_main_paths_;
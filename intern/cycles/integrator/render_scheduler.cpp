@@ -176,6 +176,8 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
   adaptive_filter_time_.reset();
   display_update_time_.reset();
   rebalance_time_.reset();
+
+  adaptive_filter_active_pixels_.clear();
 }
 
 void RenderScheduler::reset_for_next_tile()
@@ -532,6 +534,17 @@ void RenderScheduler::report_adaptive_filter_time(const RenderWork &render_work,
             << " seconds.";
 }
 
+void RenderScheduler::report_adaptive_filter_active_pixels(const RenderWork &render_work,
+                                                           int num_active_pixels)
+{
+  /* Only the final resolution is of interest for the convergence report. */
+  if (render_work.resolution_divider != pixel_size_) {
+    return;
+  }
+
+  adaptive_filter_active_pixels_.emplace_back(get_num_rendered_samples(), num_active_pixels);
+}
+
 void RenderScheduler::report_denoise_time(const RenderWork &render_work, double time)
 {
   denoise_time_.add_wall(time);
@@ -627,6 +640,17 @@ string RenderScheduler::full_report() const
     result += "  Step: " + to_string(adaptive_sampling_.adaptive_step) + "\n";
     result += "  Min Samples: " + to_string(adaptive_sampling_.min_samples) + "\n";
     result += "  Threshold: " + to_string(adaptive_sampling_.threshold) + "\n";
+
+    if (!adaptive_filter_active_pixels_.empty()) {
+      const int num_pixels = buffer_params_.width * buffer_params_.height;
+      result += "  Active pixels after filter:\n";
+      for (const auto &[num_samples, num_active_pixels] : adaptive_filter_active_pixels_) {
+        result += string_printf("    %8d samples: %10d pixels (%.1f%%)\n",
+                                num_samples,
+                                num_active_pixels,
+                                100.0 * num_active_pixels / max(num_pixels, 1));
+      }
+    }
   }
 
   result += "\nDenoiser:\n";
@@ -181,6 +181,8 @@ class RenderScheduler {
   void report_path_trace_time(const RenderWork &render_work, double time, bool is_cancelled);
   void report_path_trace_occupancy(const RenderWork &render_work, float occupancy);
   void report_adaptive_filter_time(const RenderWork &render_work, double time, bool is_cancelled);
+  /* Report number of pixels which did not converge yet after the adaptive sampling filter. */
+  void report_adaptive_filter_active_pixels(const RenderWork &render_work, int num_active_pixels);
   void report_denoise_time(const RenderWork &render_work, double time);
   void report_display_update_time(const RenderWork &render_work, double time);
   void report_rebalance_time(const RenderWork &render_work, double time, bool balance_changed);
@@ -412,6 +414,10 @@ class RenderScheduler {
   TimeWithAverage display_update_time_;
   TimeWithAverage rebalance_time_;
 
+  /* Number of rendered samples and the number of pixels which were still active after the
+   * adaptive sampling filter of that sample, for reporting the convergence of the image. */
+  vector<std::pair<int, int>> adaptive_filter_active_pixels_;
+
   /* Whether cryptomatte-related work will be scheduled. */
   bool need_schedule_cryptomatte_ = false;
 
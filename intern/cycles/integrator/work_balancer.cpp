@@ -87,4 +87,35 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   return true;
 }
 
+vector<int> work_balance_do_exclude(vector<WorkBalanceInfo> &work_balance_infos)
+{
+  /* Works whose weight is below this are considered to not contribute to the render enough. */
+  static const double kMinWeight = 0.05;
+
+  vector<int> excluded_indices;
+
+  double total_weight = 0;
+  for (int i = work_balance_infos.size() - 1; i >= 0; --i) {
+    const double weight = work_balance_infos[i].weight;
+    if (weight < kMinWeight && work_balance_infos.size() > 1) {
+      work_balance_infos.erase(work_balance_infos.begin() + i);
+      excluded_indices.push_back(i);
+    }
+    else {
+      total_weight += weight;
+    }
+  }
+
+  if (excluded_indices.empty() || total_weight == 0) {
+    return excluded_indices;
+  }
+
+  const double total_weight_inv = 1.0 / total_weight;
+  for (WorkBalanceInfo &info : work_balance_infos) {
+    info.weight *= total_weight_inv;
+  }
+
+  return excluded_indices;
+}
+
 CCL_NAMESPACE_END
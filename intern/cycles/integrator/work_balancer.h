@@ -27,4 +27,11 @@ void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos);
  * Returns true if the balancing did change. */
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos);
 
+/* Exclude works which are only given a negligible fraction of the work after rebalancing. The
+ * overhead of synchronizing with such devices outweighs their contribution to the render, and
+ * they can slow down the other devices (like a CPU which is also driving GPUs).
+ * The weights of the remaining works are normalized, and at least one work is always kept.
+ * Returns indices of the excluded works in descending order. */
+vector<int> work_balance_do_exclude(vector<WorkBalanceInfo> &work_balance_infos);
+
 CCL_NAMESPACE_END
@@ -66,6 +66,9 @@ typedef struct KernelGlobalsCPU {
   /* **** Run-time data ****  */
 
   ProfilingState profiler;
+
+  /* Number of times every integrator kernel was executed by this thread. */
+  uint64_t kernel_work[DEVICE_KERNEL_NUM] = {};
 } KernelGlobalsCPU;
 
 typedef const KernelGlobalsCPU *ccl_restrict KernelGlobals;
@@ -101,7 +101,7 @@ ccl_device bool integrator_init_from_camera(KernelGlobals kg,
     integrator_path_init(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK);
   }
   else {
-    integrator_path_init(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    integrator_path_init_intersect_closest(kg, state);
   }
 
   return true;
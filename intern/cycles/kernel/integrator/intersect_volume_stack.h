@@ -235,10 +235,8 @@ ccl_device void integrator_intersect_volume_stack(KernelGlobals kg, IntegratorSt
 #  endif
   {
     /* Volume stack init for camera rays, continue with intersection of camera ray. */
-    integrator_path_next(kg,
-                         state,
-                         DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK,
-                         DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    integrator_path_next_intersect_closest(
+        kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK);
   }
 #endif
 }
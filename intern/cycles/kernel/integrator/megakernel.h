@@ -30,6 +30,7 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
     const uint32_t shadow_queued_kernel = INTEGRATOR_STATE(
         &state->shadow, shadow_path, queued_kernel);
     if (shadow_queued_kernel) {
+      PROFILING_KERNEL_WORK(kg, shadow_queued_kernel);
       switch (shadow_queued_kernel) {
         case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
           integrator_intersect_shadow(kg, &state->shadow);
@@ -47,6 +48,7 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
     /* Handle any AO paths before we potentially create more AO paths. */
     const uint32_t ao_queued_kernel = INTEGRATOR_STATE(&state->ao, shadow_path, queued_kernel);
     if (ao_queued_kernel) {
+      PROFILING_KERNEL_WORK(kg, ao_queued_kernel);
       switch (ao_queued_kernel) {
         case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
           integrator_intersect_shadow(kg, &state->ao);
@@ -64,6 +66,7 @@ ccl_device void integrator_megakernel(KernelGlobals kg,
     /* Then handle regular path kernels. */
     const uint32_t queued_kernel = INTEGRATOR_STATE(state, path, queued_kernel);
     if (queued_kernel) {
+      PROFILING_KERNEL_WORK(kg, queued_kernel);
       switch (queued_kernel) {
         case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
           integrator_intersect_closest(kg, state, render_buffer);
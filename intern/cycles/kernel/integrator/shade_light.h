@@ -84,10 +84,7 @@ ccl_device void integrator_shade_light(KernelGlobals kg,
     return;
   }
   else {
-    integrator_path_next(kg,
-                         state,
-                         DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT,
-                         DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    integrator_path_next_intersect_closest(kg, state, DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT);
     return;
   }
 
@@ -825,7 +825,7 @@ ccl_device_forceinline void integrator_shade_surface_next_kernel(KernelGlobals k
   }
   else {
     kernel_assert(INTEGRATOR_STATE(state, ray, tmax) != 0.0f);
-    integrator_path_next(kg, state, current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+    integrator_path_next_intersect_closest(kg, state, current_kernel);
   }
 }
 
@@ -1210,10 +1210,7 @@ ccl_device void integrator_shade_volume(KernelGlobals kg,
 #  endif /* __SHADOW_LINKING__ */
 
   /* Queue intersect_closest kernel. */
-  integrator_path_next(kg,
-                       state,
-                       DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME,
-                       DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+  integrator_path_next_intersect_closest(kg, state, DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME);
 #endif /* __VOLUME__ */
 }
 
@@ -211,6 +211,9 @@ typedef struct IntegratorStateGPU {
 
   /* Divisor used to partition active indices by locality when sorting by material. */
   uint sort_partition_divisor;
+
+  /* Sort paths queued for the closest intersection kernel by ray coherence. */
+  int sort_intersect_closest;
 } IntegratorStateGPU;
 
 /* Abstraction
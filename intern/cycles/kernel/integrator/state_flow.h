@@ -6,6 +6,7 @@
 
 #include "kernel/types.h"
 #include "util/atomic.h"
+#include "util/hash.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -26,6 +27,12 @@ CCL_NAMESPACE_BEGIN
  * integrator_path_next(kg, state, current_kernel, next_kernel)
  * integrator_path_terminate(kg, state, current_kernel)
  *
+ * Paths continuing with the closest intersection kernel use dedicated functions, which optionally
+ * sort the paths by ray coherence. The ray must be written to the state before calling them.
+ *
+ * integrator_path_init_intersect_closest(kg, state)
+ * integrator_path_next_intersect_closest(kg, state, current_kernel)
+ *
  * For the shadow path similar functions are used, and again each shadow kernel must call
  * one of them, and only once.
  */
@@ -148,6 +155,54 @@ ccl_device_forceinline void integrator_path_next_sorted(KernelGlobals kg,
   atomic_fetch_and_add_uint32(&kernel_integrator_state.sort_key_counter[next_kernel][key_], 1);
 }
 
+/* Sort key for the closest intersection kernel, grouping rays with the same direction octant and
+ * a similar origin for more coherent BVH traversal. The origin cell is found by truncating the
+ * mantissa of the coordinates, which makes cells scale with the distance to the world origin
+ * without knowing the scene bounds. The key is folded into the range of shader keys, so that the
+ * sorting buffers can be shared with the shading kernels. */
+ccl_device_forceinline uint32_t integrator_intersect_closest_sort_key(KernelGlobals kg,
+                                                                      ConstIntegratorState state)
+{
+  const float3 P = INTEGRATOR_STATE(state, ray, P);
+  const float3 D = INTEGRATOR_STATE(state, ray, D);
+
+  const uint32_t octant = ((D.x < 0.0f) ? 1 : 0) | ((D.y < 0.0f) ? 2 : 0) |
+                          ((D.z < 0.0f) ? 4 : 0);
+  const uint32_t cell = hash_uint3(
+      __float_as_uint(P.x) >> 20, __float_as_uint(P.y) >> 20, __float_as_uint(P.z) >> 20);
+
+  return ((cell << 3) | octant) % kernel_data.max_shaders;
+}
+
+ccl_device_forceinline void integrator_path_init_intersect_closest(KernelGlobals kg,
+                                                                   IntegratorState state)
+{
+  if (kernel_integrator_state.sort_intersect_closest) {
+    integrator_path_init_sorted(kg,
+                                state,
+                                DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST,
+                                integrator_intersect_closest_sort_key(kg, state));
+  }
+  else {
+    integrator_path_init(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+  }
+}
+
+ccl_device_forceinline void integrator_path_next_intersect_closest(
+    KernelGlobals kg, IntegratorState state, const DeviceKernel current_kernel)
+{
+  if (kernel_integrator_state.sort_intersect_closest) {
+    integrator_path_next_sorted(kg,
+                                state,
+                                current_kernel,
+                                DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST,
+                                integrator_intersect_closest_sort_key(kg, state));
+  }
+  else {
+    integrator_path_next(kg, state, current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+  }
+}
+
 #else
 
 ccl_device_forceinline void integrator_path_init(KernelGlobals kg,
@@ -194,6 +249,18 @@ ccl_device_forceinline void integrator_path_next_sorted(KernelGlobals kg,
   (void)current_kernel;
 }
 
+ccl_device_forceinline void integrator_path_init_intersect_closest(KernelGlobals kg,
+                                                                   IntegratorState state)
+{
+  integrator_path_init(kg, state, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+}
+
+ccl_device_forceinline void integrator_path_next_intersect_closest(
+    KernelGlobals kg, IntegratorState state, const DeviceKernel current_kernel)
+{
+  integrator_path_next(kg, state, current_kernel, DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST);
+}
+
 ccl_device_forceinline IntegratorShadowState integrator_shadow_path_init(
     KernelGlobals kg, IntegratorState state, const DeviceKernel next_kernel, const bool is_ao)
 {
@@ -933,6 +933,9 @@ void GeometryManager::device_update(Device *device,
    * change. */
   bool need_update_scene_bvh = (scene->bvh == nullptr ||
                                 (update_flags & (TRANSFORM_MODIFIED | VISIBILITY_MODIFIED)) != 0);
+  /* When only object transforms changed, the scene BVH contents stay the same and it can be
+   * refit instead of rebuilt on devices supporting that. */
+  bool only_transforms_modified = (update_flags & VISIBILITY_MODIFIED) == 0;
   {
     scoped_callback_timer timer([scene](double time) {
       if (scene->update_stats) {
@@ -945,6 +948,7 @@ void GeometryManager::device_update(Device *device,
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified() || geom->need_update_bvh_for_offset) {
         need_update_scene_bvh = true;
+        only_transforms_modified = false;
         pool.push(function_bind(
             &Geometry::compute_bvh, geom, device, dscene, &scene->params, &progress, i, num_bvh));
         if (geom->need_build_bvh(bvh_layout)) {
@@ -989,7 +993,7 @@ void GeometryManager::device_update(Device *device,
         scene->update_stats->geometry.times.add_entry({"device_update (build scene BVH)", time});
       }
     });
-    device_update_bvh(device, dscene, scene, progress);
+    device_update_bvh(device, dscene, scene, progress, only_transforms_modified);
     if (progress.get_cancel()) {
       return;
     }
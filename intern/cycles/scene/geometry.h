@@ -271,7 +271,11 @@ class GeometryManager {
                                 Scene *scene,
                                 Progress &progress);
 
-  void device_update_bvh(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
+  void device_update_bvh(Device *device,
+                         DeviceScene *dscene,
+                         Scene *scene,
+                         Progress &progress,
+                         const bool only_transforms_modified);
 
   void device_update_displacement_images(Device *device, Scene *scene, Progress &progress);
 
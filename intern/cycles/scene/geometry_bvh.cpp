@@ -26,13 +26,98 @@
 
 #include "kernel/osl/globals.h"
 
+#include <cstdio>
+#include <random>
+
 #include "util/foreach.h"
 #include "util/log.h"
+#include "util/md5.h"
+#include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
+#include "util/version.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* BVH Cache
+ *
+ * Opt-in cache of geometry level BVH2 builds on disk, enabled by setting the CYCLES_BVH_CACHE_DIR
+ * environment variable to a directory. Files are named after a hash of the geometry contents and
+ * BVH parameters, so identical static geometry in later renders loads its BVH instead of building
+ * it again. The directory is never cleaned up by Cycles. */
+
+static string bvh_cache_directory()
+{
+  static const char *cache_dir = getenv("CYCLES_BVH_CACHE_DIR");
+  return (cache_dir) ? cache_dir : "";
+}
+
+static string bvh_cache_filepath(const string &cache_dir, Geometry *geom, const BVHParams &params)
+{
+  MD5Hash md5;
+  md5.append(CYCLES_VERSION_STRING);
+
+  md5.append((const uint8_t *)&params.bvh_layout, sizeof(params.bvh_layout));
+  md5.append((const uint8_t *)&params.use_spatial_split, sizeof(params.use_spatial_split));
+  md5.append((const uint8_t *)&params.use_compact_structure,
+             sizeof(params.use_compact_structure));
+  md5.append((const uint8_t *)&params.use_unaligned_nodes, sizeof(params.use_unaligned_nodes));
+  md5.append((const uint8_t *)&params.num_motion_triangle_steps,
+             sizeof(params.num_motion_triangle_steps));
+  md5.append((const uint8_t *)&params.num_motion_curve_steps,
+             sizeof(params.num_motion_curve_steps));
+  md5.append((const uint8_t *)&params.num_motion_point_steps,
+             sizeof(params.num_motion_point_steps));
+  md5.append((const uint8_t *)&params.curve_subdivisions, sizeof(params.curve_subdivisions));
+
+  geom->hash(md5, true);
+
+  /* Motion positions are stored as attribute rather than socket. */
+  const Attribute *attr_mP = geom->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+  if (attr_mP) {
+    md5.append((const uint8_t *)attr_mP->buffer.data(), attr_mP->buffer.size());
+  }
+
+  return path_join(cache_dir, md5.get_hex() + ".bvh");
+}
+
+static bool bvh_cache_read(const string &filepath, BVH2 *bvh)
+{
+  vector<uint8_t> data;
+  if (!path_read_binary(filepath, data)) {
+    return false;
+  }
+
+  if (!bvh->read_cache(data)) {
+    VLOG_WARNING << "Ignoring invalid BVH cache file " << filepath;
+    return false;
+  }
+
+  VLOG_WORK << "Loaded BVH from cache file " << filepath;
+  return true;
+}
+
+static void bvh_cache_write(const string &filepath, const BVH2 *bvh)
+{
+  vector<uint8_t> data;
+  bvh->write_cache(data);
+
+  /* Write to a randomly named file first, and then move it into place, so that other renders
+   * reading the cache at the same time never see a partially written file. */
+  std::random_device random;
+  const string tmp_filepath = string_printf("%s.%08x.tmp", filepath.c_str(), uint(random()));
+
+  if (!path_write_binary(tmp_filepath, data) ||
+      std::rename(tmp_filepath.c_str(), filepath.c_str()) != 0)
+  {
+    path_remove(tmp_filepath);
+    VLOG_WARNING << "Failed to write BVH cache file " << filepath;
+    return;
+  }
+
+  VLOG_WORK << "Wrote BVH cache file " << filepath;
+}
+
 void Geometry::compute_bvh(Device *device,
                            DeviceScene *dscene,
                            SceneParams *params,
@@ -71,7 +156,7 @@ void Geometry::compute_bvh(Device *device,
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    if (bvh && !need_update_rebuild && !bvh->need_rebuild) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->replace_geometry(geometry, objects);
@@ -95,7 +180,19 @@ void Geometry::compute_bvh(Device *device,
 
       delete bvh;
       bvh = BVH::create(bparams, geometry, objects, device);
-      MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+
+      const string cache_dir = (bvh_layout == BVH_LAYOUT_BVH2) ? bvh_cache_directory() : "";
+      const string cache_filepath = (cache_dir.empty()) ?
+                                        "" :
+                                        bvh_cache_filepath(cache_dir, this, bparams);
+
+      if (cache_filepath.empty() || !bvh_cache_read(cache_filepath, static_cast<BVH2 *>(bvh))) {
+        MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+
+        if (!cache_filepath.empty() && !progress->get_cancel()) {
+          bvh_cache_write(cache_filepath, static_cast<BVH2 *>(bvh));
+        }
+      }
     }
   }
 
@@ -106,7 +203,8 @@ void Geometry::compute_bvh(Device *device,
 void GeometryManager::device_update_bvh(Device *device,
                                         DeviceScene *dscene,
                                         Scene *scene,
-                                        Progress &progress)
+                                        Progress &progress,
+                                        const bool only_transforms_modified)
 {
   /* bvh build */
   progress.set_status("Updating Scene BVH", "Building");
@@ -126,9 +224,13 @@ void GeometryManager::device_update_bvh(Device *device,
 
   VLOG_INFO << "Using " << bvh_layout_name(bparams.bvh_layout) << " layout.";
 
+  /* Embree can update instance transforms in place, as long as the objects in the scene and their
+   * geometry did not change. Adding or removing geometry frees the scene BVH. */
   const bool can_refit = scene->bvh != nullptr &&
                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_OPTIX ||
-                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL);
+                          bparams.bvh_layout == BVHLayout::BVH_LAYOUT_METAL ||
+                          (bparams.bvh_layout == BVHLayout::BVH_LAYOUT_EMBREE &&
+                           only_transforms_modified));
 
   BVH *bvh = scene->bvh;
   if (!scene->bvh) {
@@ -136,6 +238,9 @@ void GeometryManager::device_update_bvh(Device *device,
   }
 
   device->build_bvh(bvh, progress, can_refit);
+  if (can_refit && bvh->need_rebuild) {
+    device->build_bvh(bvh, progress, false);
+  }
 
   if (progress.get_cancel()) {
     return;
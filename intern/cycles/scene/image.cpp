@@ -243,7 +243,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
-      compress_as_srgb(false)
+      compress_as_srgb(false),
+      miplevel(0)
 {
 }
 
@@ -301,6 +302,11 @@ int ImageLoader::get_tile_number() const
   return 0;
 }
 
+bool ImageLoader::load_mip_level_metadata(const int /*max_size*/, ImageMetaData & /*metadata*/)
+{
+  return false;
+}
+
 bool ImageLoader::equals(const ImageLoader *a, const ImageLoader *b)
 {
   if (a == NULL && b == NULL) {
@@ -540,10 +546,23 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
+
+  /* Prefer a pre-filtered MIP level from the file that fits the texture limit, as in `.tx` files.
+   * That avoids reading the full resolution image only to scale it down afterwards. */
+  if (texture_limit > 0 && max(max(width, height), depth) > texture_limit &&
+      img->loader->load_mip_level_metadata(texture_limit, metadata))
+  {
+    VLOG_WORK << "Loading MIP level " << metadata.miplevel << " of image "
+              << img->loader->name() << ".";
+    width = metadata.width;
+    height = metadata.height;
+    depth = metadata.depth;
+  }
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
@@ -570,8 +589,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
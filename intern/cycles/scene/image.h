@@ -80,6 +80,9 @@ class ImageMetaData {
   /* Automatically set. */
   bool compress_as_srgb;
 
+  /* Optional MIP level to load pixels from, set by ImageLoader.load_mip_level_metadata(). */
+  int miplevel;
+
   ImageMetaData();
   bool operator==(const ImageMetaData &other) const;
   bool is_float() const;
@@ -117,6 +120,10 @@ class ImageLoader {
   /* Optional for tiled textures loaded externally. */
   virtual int get_tile_number() const;
 
+  /* Optional for images with pre-filtered MIP levels. Find the largest level that fits within
+   * max_size and change the metadata to load pixels from that level. */
+  virtual bool load_mip_level_metadata(const int max_size, ImageMetaData &metadata);
+
   /* Free any memory used for loading metadata and pixels. */
   virtual void cleanup(){};
 
@@ -89,6 +89,35 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
   return true;
 }
 
+bool OIIOImageLoader::load_mip_level_metadata(const int max_size, ImageMetaData &metadata)
+{
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Levels get smaller, so use the first one that fits. */
+  bool found = false;
+  for (int miplevel = 1; in->seek_subimage(0, miplevel, spec); miplevel++) {
+    if (max(max(spec.width, spec.height), spec.depth) <= max_size) {
+      metadata.width = spec.width;
+      metadata.height = spec.height;
+      metadata.depth = spec.depth;
+      metadata.miplevel = miplevel;
+      found = true;
+      break;
+    }
+  }
+
+  in->close();
+  return found;
+}
+
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 static void oiio_load_pixels(const ImageMetaData &metadata,
                              const unique_ptr<ImageInput> &in,
@@ -111,7 +140,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
   if (depth <= 1) {
     size_t scanlinesize = width * components * sizeof(StorageType);
     in->read_image(0,
-                   0,
+                   metadata.miplevel,
                    0,
                    components,
                    FileFormat,
@@ -121,7 +150,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
                    AutoStride);
   }
   else {
-    in->read_image(0, 0, 0, components, FileFormat, (uchar *)readpixels);
+    in->read_image(0, metadata.miplevel, 0, components, FileFormat, (uchar *)readpixels);
   }
 
   if (components > 4) {
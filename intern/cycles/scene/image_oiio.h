@@ -16,6 +16,8 @@ class OIIOImageLoader : public ImageLoader {
 
   bool load_metadata(const ImageDeviceFeatures &features, ImageMetaData &metadata) override;
 
+  bool load_mip_level_metadata(const int max_size, ImageMetaData &metadata) override;
+
   bool load_pixels(const ImageMetaData &metadata,
                    void *pixels,
                    const size_t pixels_size,
@@ -254,11 +254,33 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, int prim_id)
 
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, int object_id)
 {
-  size_t mesh_num_triangles = mesh->num_triangles();
-  for (size_t i = 0; i < mesh_num_triangles; i++) {
-    if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+  const size_t mesh_num_triangles = mesh->num_triangles();
+  const size_t num_chunks = divide_up(mesh_num_triangles, MIN_EMITTERS_PER_THREAD);
+  if (num_chunks <= 1) {
+    for (size_t i = 0; i < mesh_num_triangles; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        emitters_.emplace_back(scene, i, object_id);
+      }
+    }
+    return;
+  }
+
+  /* Computing the measure of every emissive triangle dominates the build time for large meshes,
+   * so create the emitters in parallel. Chunks are appended in order to keep the emitter order,
+   * and with that the resulting tree, independent of the number of threads. */
+  vector<vector<LightTreeEmitter>> chunk_emitters(num_chunks);
+  parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+    const size_t start = chunk * MIN_EMITTERS_PER_THREAD;
+    const size_t end = min(start + MIN_EMITTERS_PER_THREAD, mesh_num_triangles);
+    for (size_t i = start; i < end; i++) {
+      if (triangle_usable_as_light(mesh, i)) {
+        chunk_emitters[chunk].emplace_back(scene, i, object_id);
+      }
     }
+  });
+
+  for (vector<LightTreeEmitter> &emitters : chunk_emitters) {
+    std::move(emitters.begin(), emitters.end(), std::back_inserter(emitters_));
   }
 }
 
@@ -380,12 +402,22 @@ LightTreeNode *LightTree::build(Scene *scene, DeviceScene *dscene)
      * the angle is derived from the major axis of the resulted right elliptic cone's base, which
      * can be an overestimation. */
     if (!mesh->transform_applied && !emitter.measure.transform(object->get_tfm())) {
-      emitter.measure.reset();
-      size_t mesh_num_triangles = mesh->num_triangles();
-      for (size_t i = 0; i < mesh_num_triangles; i++) {
-        if (triangle_usable_as_light(mesh, i)) {
-          emitter.measure.add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
+      const size_t mesh_num_triangles = mesh->num_triangles();
+      const size_t num_chunks = divide_up(mesh_num_triangles, MIN_EMITTERS_PER_THREAD);
+      vector<LightTreeMeasure> chunk_measures(num_chunks, LightTreeMeasure::empty);
+      parallel_for(size_t(0), num_chunks, [&](const size_t chunk) {
+        const size_t start = chunk * MIN_EMITTERS_PER_THREAD;
+        const size_t end = min(start + MIN_EMITTERS_PER_THREAD, mesh_num_triangles);
+        for (size_t i = start; i < end; i++) {
+          if (triangle_usable_as_light(mesh, i)) {
+            chunk_measures[chunk].add(LightTreeEmitter(scene, i, emitter.object_id, true).measure);
+          }
         }
+      });
+
+      emitter.measure.reset();
+      for (const LightTreeMeasure &chunk_measure : chunk_measures) {
+        emitter.measure.add(chunk_measure);
       }
     }
   });
@@ -540,17 +572,40 @@ bool LightTree::should_split(LightTreeEmitter *emitters,
     const float inv_extent = 1 / (centroid_bbox.size()[dim]);
 
     /* Fill in buckets with emitters. */
-    std::array<LightTreeBucket, LightTreeBucket::num_buckets> buckets;
-    for (int i = start; i < end; i++) {
-      const LightTreeEmitter *emitter = emitters + i;
-
-      /* Place emitter into the appropriate bucket, where the centroid box is split into equal
-       * partitions. */
-      int bucket_idx = LightTreeBucket::num_buckets *
-                       (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
-      bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+    using Buckets = std::array<LightTreeBucket, LightTreeBucket::num_buckets>;
+    auto fill_buckets = [&](const int range_start, const int range_end, Buckets &buckets) {
+      for (int i = range_start; i < range_end; i++) {
+        const LightTreeEmitter *emitter = emitters + i;
+
+        /* Place emitter into the appropriate bucket, where the centroid box is split into equal
+         * partitions. */
+        int bucket_idx = LightTreeBucket::num_buckets *
+                         (emitter->centroid[dim] - centroid_bbox.min[dim]) * inv_extent;
+        bucket_idx = clamp(bucket_idx, 0, LightTreeBucket::num_buckets - 1);
+
+        buckets[bucket_idx].add(*emitter);
+      }
+    };
 
-      buckets[bucket_idx].add(*emitter);
+    Buckets buckets;
+    const int num_chunks = divide_up(num_emitters, MIN_EMITTERS_PER_THREAD);
+    if (num_chunks <= 1) {
+      fill_buckets(start, end, buckets);
+    }
+    else {
+      /* The nodes close to the root contain most emitters and are only split by a single thread,
+       * so fill the buckets of large nodes in parallel and combine them in a fixed order. */
+      vector<Buckets> chunk_buckets(num_chunks);
+      parallel_for(0, num_chunks, [&](const int chunk) {
+        const int chunk_start = start + chunk * MIN_EMITTERS_PER_THREAD;
+        const int chunk_end = min(chunk_start + MIN_EMITTERS_PER_THREAD, end);
+        fill_buckets(chunk_start, chunk_end, chunk_buckets[chunk]);
+      });
+      for (const Buckets &chunk : chunk_buckets) {
+        for (int i = 0; i < LightTreeBucket::num_buckets; i++) {
+          buckets[i] = buckets[i] + chunk[i];
+        }
+      }
     }
 
     /* Precompute the left bucket measure cumulatively. */
@@ -44,6 +44,11 @@ map<int, OSL::ShadingSystem *> OSLShaderManager::ss_shared;
 int OSLShaderManager::ss_shared_users = 0;
 thread_mutex OSLShaderManager::ss_shared_mutex;
 thread_mutex OSLShaderManager::ss_mutex;
+map<OSL::ShadingSystem *, map<string, OSL::ShaderGroupRef>> OSLShaderManager::ss_shared_groups;
+
+/* Groups which are no longer used by any shader are kept for reuse by later sessions sharing the
+ * same shading system, until this many groups are remembered. */
+static const size_t kMaxCachedShaderGroups = 4096;
 
 int OSLCompiler::texture_shared_unique_id = 0;
 
@@ -368,6 +373,7 @@ void OSLShaderManager::shading_system_free()
       for (const auto &[device_type, ss] : ss_shared) {
         OSLRenderServices *services = static_cast<OSLRenderServices *>(ss->renderer());
 
+        ss_shared_groups.erase(ss);
         delete ss;
 
         util_aligned_delete(services);
@@ -378,6 +384,40 @@ void OSLShaderManager::shading_system_free()
   });
 }
 
+OSL::ShaderGroupRef OSLShaderManager::shader_group_deduplicate(OSL::ShadingSystem *ss,
+                                                              const OSL::ShaderGroupRef &group)
+{
+  /* The serialized group contains all layers with their parameter values and connections, so
+   * groups with the same serialization are interchangeable. Groups referencing SVM images get a
+   * unique texture name per compilation and are never shared. */
+  ustring pickle;
+  if (!group || !ss->getattribute(group.get(), "pickle", TypeDesc::STRING, &pickle)) {
+    return group;
+  }
+
+  map<string, OSL::ShaderGroupRef> &groups = ss_shared_groups[ss];
+
+  auto it = groups.find(pickle.string());
+  if (it != groups.end()) {
+    return it->second;
+  }
+
+  if (groups.size() >= kMaxCachedShaderGroups) {
+    /* Forget groups that are only referenced by this cache. */
+    for (auto group_it = groups.begin(); group_it != groups.end();) {
+      if (group_it->second.use_count() == 1) {
+        group_it = groups.erase(group_it);
+      }
+      else {
+        ++group_it;
+      }
+    }
+  }
+
+  groups[pickle.string()] = group;
+  return group;
+}
+
 bool OSLShaderManager::osl_compile(const string &inputfile, const string &outputfile)
 {
   vector<string> options;
@@ -703,14 +743,15 @@ OSLCompiler::OSLCompiler(OSLShaderManager *manager, OSL::ShadingSystem *ss, Scen
 
 string OSLCompiler::id(ShaderNode *node)
 {
-  /* assign layer unique name based on pointer address + bump mode */
+  /* Assign layer unique name based on the node index in the graph. Unlike a pointer address,
+   * this is the same every time a graph is built, so identical groups can be reused. */
   std::stringstream stream;
 
   /* Ensure that no grouping characters (e.g. commas with en_US locale)
-   * are added to the pointer string. */
+   * are added to the index string. */
   stream.imbue(std::locale("C"));
 
-  stream << "node_" << node->type->name << "_" << node;
+  stream << "node_" << node->type->name << "_" << node->id;
 
   return stream.str();
 }
@@ -1243,7 +1284,7 @@ OSL::ShaderGroupRef OSLCompiler::compile_type(Shader *shader, ShaderGraph *graph
 
   ss->ShaderGroupEnd();
 
-  return group;
+  return OSLShaderManager::shader_group_deduplicate(ss, group);
 }
 
 void OSLCompiler::compile(OSLGlobals *og, Shader *shader)
@@ -96,6 +96,12 @@ class OSLShaderManager : public ShaderManager {
   /* Get image slots used by OSL services on device. */
   static void osl_image_slots(Device *device, ImageManager *image_manager, set<int> &image_slots);
 
+  /* Return a previously compiled group with the same serialized contents if there is one, so
+   * that it is not optimized and JIT compiled again. Otherwise the group is remembered and
+   * returned as is. */
+  static OSL::ShaderGroupRef shader_group_deduplicate(OSL::ShadingSystem *ss,
+                                                      const OSL::ShaderGroupRef &group);
+
  private:
   void texture_system_init();
   void texture_system_free();
@@ -115,6 +121,7 @@ class OSLShaderManager : public ShaderManager {
   static thread_mutex ss_shared_mutex;
   static thread_mutex ss_mutex;
   static int ss_shared_users;
+  static map<OSL::ShadingSystem *, map<string, OSL::ShaderGroupRef>> ss_shared_groups;
 };
 
 #endif
@@ -28,6 +28,12 @@ bool namedTimeEntryComparator(const NamedTimeEntry &a, const NamedTimeEntry &b)
   return a.time > b.time;
 }
 
+bool namedCountEntryComparator(const NamedCountEntry &a, const NamedCountEntry &b)
+{
+  /* We sort in descending order. */
+  return a.count > b.count;
+}
+
 bool namedTimeSampleEntryComparator(const NamedNestedSampleStats &a,
                                     const NamedNestedSampleStats &b)
 {
@@ -49,6 +55,10 @@ NamedTimeEntry::NamedTimeEntry() : name(""), time(0) {}
 
 NamedTimeEntry::NamedTimeEntry(const string &name, double time) : name(name), time(time) {}
 
+NamedCountEntry::NamedCountEntry() : name(""), count(0) {}
+
+NamedCountEntry::NamedCountEntry(const string &name, uint64_t count) : name(name), count(count) {}
+
 /* Named size statistics. */
 
 NamedSizeStats::NamedSizeStats() : total_size(0) {}
@@ -93,6 +103,27 @@ string NamedTimeStats::full_report(int indent_level)
   return result;
 }
 
+/* Named counter statistics. */
+
+NamedCountStats::NamedCountStats() : total_count(0) {}
+
+string NamedCountStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  const string double_indent = indent + indent;
+  string result = "";
+  result += string_printf(
+      "%sTotal: %s\n", indent.c_str(), string_human_readable_number(total_count).c_str());
+  sort(entries.begin(), entries.end(), namedCountEntryComparator);
+  foreach (const NamedCountEntry &entry, entries) {
+    result += string_printf("%s%-40s %s\n",
+                            double_indent.c_str(),
+                            entry.name.c_str(),
+                            string_human_readable_number(entry.count).c_str());
+  }
+  return result;
+}
+
 /* Named time sample statistics. */
 
 NamedNestedSampleStats::NamedNestedSampleStats() : name(""), self_samples(0), sum_samples(0) {}
@@ -287,6 +318,12 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  if (!tiles.entries.empty()) {
+    result += "Tile statistics:\n" + tiles.full_report(1);
+  }
+  if (!kernel_work.entries.empty()) {
+    result += "Kernel work statistics:\n" + kernel_work.full_report(1);
+  }
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
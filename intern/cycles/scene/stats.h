@@ -38,6 +38,15 @@ class NamedTimeEntry {
   double time;
 };
 
+class NamedCountEntry {
+ public:
+  NamedCountEntry();
+  NamedCountEntry(const string &name, uint64_t count);
+
+  string name;
+  uint64_t count;
+};
+
 /* Container of named size entries. Used, for example, to store per-mesh memory
  * usage statistics. But also keeps track of overall memory usage of the
  * container.
@@ -90,6 +99,32 @@ class NamedTimeStats {
   }
 };
 
+/* Container of named counters, for example the number of paths processed by every kernel. */
+class NamedCountStats {
+ public:
+  NamedCountStats();
+
+  void add_entry(const NamedCountEntry &entry)
+  {
+    total_count += entry.count;
+    entries.push_back(entry);
+  }
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  /* Sum of the counts of all entries. */
+  uint64_t total_count;
+
+  vector<NamedCountEntry> entries;
+
+  void clear()
+  {
+    total_count = 0;
+    entries.clear();
+  }
+};
+
 class NamedNestedSampleStats {
  public:
   NamedNestedSampleStats();
@@ -179,6 +214,12 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Wall time of every big tile, only filled in when rendering with multiple tiles. */
+  NamedTimeStats tiles;
+
+  /* Number of paths processed by every integrator kernel, on all devices. */
+  NamedCountStats kernel_work;
 };
 
 class UpdateTimeStats {
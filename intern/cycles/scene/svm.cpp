@@ -73,6 +73,11 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
+  /* All shaders are compiled again, so start with no node types used. The kernel can then be
+   * specialized for the nodes the current shaders use, instead of every node that was used by any
+   * shader since the scene was created. */
+  memset(&dscene->data.svm_usage, 0, sizeof(dscene->data.svm_usage));
+
   /* Build all shaders. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
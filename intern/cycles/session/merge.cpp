@@ -60,6 +60,9 @@ struct MergeImageLayer {
   bool has_sample_pass;
   /* Offset of the "Debug Sample Count" pass if it exists. */
   int sample_pass_offset;
+  /* First sample of the rendered range and the seed, if stored in the metadata. */
+  int sample_offset;
+  string seed;
 };
 
 /* Merge Image */
@@ -216,6 +219,16 @@ static bool parse_channels(const ImageSpec &in_spec,
       return false;
     }
 
+    /* Sample range, used to detect renders which would not reduce noise when merged. */
+    layer.sample_offset = -1;
+    layer.seed = in_spec.get_string_attribute("cycles." + name + ".seed", "");
+    const string offset_string = in_spec.get_string_attribute(
+        "cycles." + name + ".sample_offset", "");
+    if (offset_string != "" && !sscanf(offset_string.c_str(), "%d", &layer.sample_offset)) {
+      error = "Failed to parse sample offset metadata: " + offset_string;
+      return false;
+    }
+
     /* Check if the layer has "Debug Sample Count" pass. */
     auto sample_pass_it = find_if(
         layer.passes.begin(), layer.passes.end(), [](const MergeImagePass &pass) {
@@ -280,6 +293,40 @@ static bool open_images(const vector<string> &filepaths, vector<MergeImage> &ima
   return true;
 }
 
+/* Renders with the same seed and overlapping sample ranges contain the same samples, merging them
+ * would not reduce noise. This typically happens when the sample offset was forgotten when
+ * distributing a frame over multiple machines. */
+static bool check_sample_ranges(const vector<MergeImage> &images, string &error)
+{
+  for (size_t i = 0; i < images.size(); i++) {
+    for (size_t j = i + 1; j < images.size(); j++) {
+      for (const MergeImageLayer &layer : images[i].layers) {
+        for (const MergeImageLayer &other_layer : images[j].layers) {
+          if (layer.name != other_layer.name || layer.sample_offset < 0 ||
+              other_layer.sample_offset < 0 || layer.seed != other_layer.seed)
+          {
+            continue;
+          }
+
+          if (layer.sample_offset < other_layer.sample_offset + other_layer.samples &&
+              other_layer.sample_offset < layer.sample_offset + layer.samples)
+          {
+            error = string_printf(
+                "Images %s and %s contain overlapping samples of layer %s, use a different sample "
+                "offset or seed for each render",
+                images[i].filepath.c_str(),
+                images[j].filepath.c_str(),
+                layer.name.c_str());
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 static void merge_render_time(ImageSpec &spec,
                               const vector<MergeImage> &images,
                               const string &name,
@@ -376,6 +423,9 @@ static void merge_channels_metadata(vector<MergeImage> &images, ImageSpec &out_s
     string name = "cycles." + layer_name + ".samples";
     out_spec.attribute(name, TypeDesc::STRING, to_string(layer_samples));
 
+    /* The merged samples are not necessarily a contiguous range anymore. */
+    out_spec.erase_attribute("cycles." + layer_name + ".sample_offset");
+
     merge_layer_render_time(out_spec, images, layer_name, "total_time", false);
     merge_layer_render_time(out_spec, images, layer_name, "render_time", false);
     merge_layer_render_time(out_spec, images, layer_name, "synchronization_time", true);
@@ -589,6 +639,10 @@ bool ImageMerger::run()
     return false;
   }
 
+  if (!check_sample_ranges(images, error)) {
+    return false;
+  }
+
   /* Load and sum sample count for each render layer. */
   unordered_map<string, SampleCount> layer_samples;
   read_layer_samples(images, layer_samples);
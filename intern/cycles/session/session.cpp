@@ -366,6 +366,15 @@ RenderWork Session::run_update_for_next_iteration()
 
     progress.add_finished_tile(false);
 
+    if (tile_manager_.has_multiple_tiles()) {
+      const Tile &tile = tile_manager_.get_current_tile();
+      const double tile_time = time_dt() - tile_start_time_;
+      tile_times_.add_entry(NamedTimeEntry(
+          string_printf("%d, %d (%dx%d)", tile.x, tile.y, tile.width, tile.height), tile_time));
+      VLOG_INFO << "Big tile at " << tile.x << ", " << tile.y << " rendered in " << tile_time
+                << " seconds.";
+    }
+
     have_tiles = tile_manager_.next();
     if (have_tiles) {
       render_scheduler_.reset_for_next_tile();
@@ -397,6 +406,8 @@ RenderWork Session::run_update_for_next_iteration()
       tile_params.update_offset_stride();
 
       path_trace_->reset(buffer_params_, tile_params, did_reset);
+
+      tile_start_time_ = time_dt();
     }
 
     const int resolution = render_work.resolution_divider;
@@ -522,6 +533,9 @@ void Session::do_delayed_reset()
   }
   delayed_reset_.do_reset = false;
 
+  tile_times_.clear();
+  path_trace_->clear_kernel_work();
+
   params = delayed_reset_.session_params;
   buffer_params_ = delayed_reset_.buffer_params;
 
@@ -756,6 +770,16 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
+  render_stats->tiles = tile_times_;
+
+  render_stats->kernel_work.clear();
+  const vector<uint64_t> &kernel_work = path_trace_->get_kernel_work();
+  for (int i = 0; i < DEVICE_KERNEL_NUM; i++) {
+    if (kernel_work[i]) {
+      render_stats->kernel_work.add_entry(
+          NamedCountEntry(device_kernel_as_string(static_cast<DeviceKernel>(i)), kernel_work[i]));
+    }
+  }
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
@@ -234,6 +234,11 @@ class Session {
   /* Render scheduler is used to get work to be rendered with the current big tile. */
   RenderScheduler render_scheduler_;
 
+  /* Wall time at which rendering of the current big tile started, and the time it took to render
+   * every finished big tile. Only used for statistics. */
+  double tile_start_time_ = 0.0;
+  NamedTimeStats tile_times_;
+
   /* Path tracer object.
    *
    * Is a single full-frame path tracer for interactive viewport rendering.
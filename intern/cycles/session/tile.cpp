@@ -71,6 +71,40 @@ static std::vector<std::string> exr_channel_names_for_passes(const BufferParams
   return channel_names;
 }
 
+/* Denoising albedo and normal passes are accumulated from values which are bounded by one per
+ * sample, so as long as the number of samples is small enough they fit into a half float without
+ * the risk of overflowing, and the denoiser does not need more precision from them. Storing them
+ * as half reduces size and I/O of the tile file, which are significant at high resolutions. */
+static constexpr int kMaxHalfStorageSamples = 16384;
+
+static bool pass_use_half_storage(const BufferPass &pass, const int num_samples)
+{
+  if (num_samples <= 0 || num_samples > kMaxHalfStorageSamples) {
+    return false;
+  }
+
+  return pass.type == PASS_DENOISING_ALBEDO || pass.type == PASS_DENOISING_NORMAL;
+}
+
+/* Per-channel storage formats, in the same order as exr_channel_names_for_passes(). */
+static std::vector<TypeDesc> exr_channel_formats_for_passes(const BufferParams &buffer_params)
+{
+  std::vector<TypeDesc> channel_formats;
+  for (const BufferPass &pass : buffer_params.passes) {
+    if (pass.offset == PASS_UNUSED) {
+      continue;
+    }
+
+    const PassInfo pass_info = pass.get_info();
+    const TypeDesc format = pass_use_half_storage(pass, buffer_params.samples) ? TypeDesc::HALF :
+                                                                                 TypeDesc::FLOAT;
+
+    channel_formats.insert(channel_formats.end(), pass_info.num_components, format);
+  }
+
+  return channel_formats;
+}
+
 inline string node_socket_attribute_name(const SocketType &socket, const string &attr_name_prefix)
 {
   return attr_name_prefix + string(socket.name);
@@ -288,6 +322,13 @@ static bool configure_image_spec_from_buffer(ImageSpec *image_spec,
 
   image_spec->channelnames = std::move(channel_names);
 
+  std::vector<TypeDesc> channel_formats = exr_channel_formats_for_passes(buffer_params);
+  if (std::find(channel_formats.begin(), channel_formats.end(), TypeDesc::HALF) !=
+      channel_formats.end())
+  {
+    image_spec->channelformats = std::move(channel_formats);
+  }
+
   if (!buffer_params_to_image_spec_atttributes(image_spec, buffer_params)) {
     return false;
   }
@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+static vector<WorkBalanceInfo> work_balance_infos_from_weights(const vector<double> &weights)
+{
+  vector<WorkBalanceInfo> infos(weights.size());
+  for (int i = 0; i < weights.size(); ++i) {
+    infos[i].weight = weights[i];
+  }
+  return infos;
+}
+
+TEST(work_balance_do_exclude, nothing_excluded)
+{
+  vector<WorkBalanceInfo> infos = work_balance_infos_from_weights({0.4, 0.6});
+  EXPECT_TRUE(work_balance_do_exclude(infos).empty());
+  ASSERT_EQ(infos.size(), 2);
+  EXPECT_DOUBLE_EQ(infos[0].weight, 0.4);
+  EXPECT_DOUBLE_EQ(infos[1].weight, 0.6);
+}
+
+TEST(work_balance_do_exclude, negligible_works)
+{
+  vector<WorkBalanceInfo> infos = work_balance_infos_from_weights({0.01, 0.6, 0.02, 0.37});
+  const vector<int> excluded = work_balance_do_exclude(infos);
+  ASSERT_EQ(excluded.size(), 2);
+  EXPECT_EQ(excluded[0], 2);
+  EXPECT_EQ(excluded[1], 0);
+
+  ASSERT_EQ(infos.size(), 2);
+  EXPECT_NEAR(infos[0].weight, 0.6 / 0.97, 1e-12);
+  EXPECT_NEAR(infos[1].weight, 0.37 / 0.97, 1e-12);
+}
+
+TEST(work_balance_do_exclude, keep_last_work)
+{
+  vector<WorkBalanceInfo> infos = work_balance_infos_from_weights({0.01, 0.02});
+  const vector<int> excluded = work_balance_do_exclude(infos);
+  ASSERT_EQ(excluded.size(), 1);
+  EXPECT_EQ(excluded[0], 1);
+  ASSERT_EQ(infos.size(), 1);
+  EXPECT_DOUBLE_EQ(infos[0].weight, 1.0);
+}
+
+CCL_NAMESPACE_END
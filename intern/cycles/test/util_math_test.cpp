@@ -46,4 +46,23 @@ TEST(math, reverse_integer_bits)
   EXPECT_EQ(reverse_integer_bits(0xAAAAAAAA), 0x55555555);
 }
 
+TEST(math, oct_encode_unit_vector)
+{
+  const float3 vectors[] = {make_float3(0.0f, 0.0f, 1.0f),
+                            make_float3(0.0f, 0.0f, -1.0f),
+                            make_float3(1.0f, 0.0f, 0.0f),
+                            make_float3(0.0f, -1.0f, 0.0f),
+                            normalize(make_float3(1.0f, 2.0f, 3.0f)),
+                            normalize(make_float3(-3.0f, 0.5f, -2.0f)),
+                            normalize(make_float3(0.2f, -0.7f, -0.1f))};
+
+  for (const float3 v : vectors) {
+    const float3 decoded = oct_decode_unit_vector(oct_encode_unit_vector(v));
+    EXPECT_NEAR(len(decoded), 1.0f, 1e-6f);
+    EXPECT_NEAR(decoded.x, v.x, 1e-4f);
+    EXPECT_NEAR(decoded.y, v.y, 1e-4f);
+    EXPECT_NEAR(decoded.z, v.z, 1e-4f);
+  }
+}
+
 CCL_NAMESPACE_END
@@ -946,6 +946,40 @@ ccl_device_inline float2 map_to_sphere(const float3 co)
   return make_float2(u, v);
 }
 
+/* Octahedral encoding of unit vectors into 32 bits, with 16 bits per component. The maximum
+ * angular error of the quantization is well below what is visible in shading normals. */
+
+ccl_device_inline uint oct_encode_unit_vector(const float3 v)
+{
+  const float len = fabsf(v.x) + fabsf(v.y) + fabsf(v.z);
+  if (len == 0.0f) {
+    return 0;
+  }
+
+  float x = v.x / len;
+  float y = v.y / len;
+  if (v.z < 0.0f) {
+    const float fold_x = (1.0f - fabsf(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+    const float fold_y = (1.0f - fabsf(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+    x = fold_x;
+    y = fold_y;
+  }
+
+  const int ix = float_to_int(floorf(clamp(x, -1.0f, 1.0f) * 32767.0f + 0.5f));
+  const int iy = float_to_int(floorf(clamp(y, -1.0f, 1.0f) * 32767.0f + 0.5f));
+  return (uint(ix) & 0xFFFF) | (uint(iy) << 16);
+}
+
+ccl_device_inline float3 oct_decode_unit_vector(const uint code)
+{
+  /* Sign extend the 16 bit components. */
+  const float x = float(int(code << 16) >> 16) * (1.0f / 32767.0f);
+  const float y = float(int(code) >> 16) * (1.0f / 32767.0f);
+  const float z = 1.0f - fabsf(x) - fabsf(y);
+  const float t = max(-z, 0.0f);
+  return normalize(make_float3(x + ((x >= 0.0f) ? -t : t), y + ((y >= 0.0f) ? -t : t), z));
+}
+
 /* Compares two floats.
  * Returns true if their absolute difference is smaller than abs_diff (for numbers near zero)
  * or their relative difference is less than ulp_diff ULPs.
@@ -185,6 +185,15 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Get the total number of bytes and blocks that have been allocated on the calling thread so far.
+ * Freed memory is not subtracted, so the difference between two calls is the amount of memory that
+ * has been allocated on the thread in between. Allocations on other threads are not included.
+ *
+ * \note Only the lock-free allocator keeps track of these, the guarded allocator returns zero.
+ */
+void MEM_get_thread_allocation_totals(size_t *r_bytes, size_t *r_blocks);
+
 #ifdef __cplusplus
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -74,6 +74,116 @@ enum {
 #define MEMHEAD_IS_FROM_CPP_NEW(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_FROM_CPP_NEW))
 #define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_FLAG_MASK))
 
+#ifdef WITH_MEM_THREAD_CACHE
+
+/**
+ * Small blocks are always allocated with the full capacity of their size class. That way a freed
+ * block can be kept in a free list of the thread that freed it, and be handed out again by a later
+ * allocation of the same size class without going through the system allocator.
+ */
+static constexpr size_t thread_cache_class_granularity = 16;
+static constexpr size_t thread_cache_max_size = 512;
+static constexpr int thread_cache_classes_num = int(thread_cache_max_size /
+                                                    thread_cache_class_granularity);
+/** Maximum number of free blocks kept per size class and thread, others are freed right away. */
+static constexpr int thread_cache_max_blocks_per_class = 256;
+
+namespace {
+
+struct ThreadCacheBlock {
+  ThreadCacheBlock *next;
+};
+
+struct ThreadCache {
+  ThreadCacheBlock *free_blocks[thread_cache_classes_num] = {};
+  int free_blocks_num[thread_cache_classes_num] = {};
+  /** Blocks freed after the cache was destructed on thread exit go to the system allocator. */
+  bool destructed = false;
+
+  ~ThreadCache()
+  {
+    for (int i = 0; i < thread_cache_classes_num; i++) {
+      while (ThreadCacheBlock *block = free_blocks[i]) {
+        free_blocks[i] = block->next;
+        free(block);
+      }
+      free_blocks_num[i] = 0;
+    }
+    destructed = true;
+  }
+};
+
+}  // namespace
+
+static ThreadCache &thread_cache_get()
+{
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+/** Size class of a block of the given size including its head, or -1 if it is not cached. */
+static int thread_cache_size_class(const size_t size)
+{
+  if (size > thread_cache_max_size) {
+    return -1;
+  }
+  return int((size + thread_cache_class_granularity - 1) / thread_cache_class_granularity) - 1;
+}
+
+static void *mem_block_alloc(const size_t size, const bool zero)
+{
+  const int size_class = thread_cache_size_class(size);
+  if (size_class == -1) {
+    return zero ? calloc(1, size) : malloc(size);
+  }
+
+  ThreadCache &cache = thread_cache_get();
+  ThreadCacheBlock *block = cache.free_blocks[size_class];
+  if (block && !cache.destructed) {
+    cache.free_blocks[size_class] = block->next;
+    cache.free_blocks_num[size_class]--;
+    if (zero) {
+      memset(block, 0, size);
+    }
+    return block;
+  }
+
+  const size_t capacity = size_t(size_class + 1) * thread_cache_class_granularity;
+  return zero ? calloc(1, capacity) : malloc(capacity);
+}
+
+static void mem_block_free(void *ptr, const size_t size)
+{
+  const int size_class = thread_cache_size_class(size);
+  if (size_class != -1) {
+    ThreadCache &cache = thread_cache_get();
+    if (!cache.destructed &&
+        cache.free_blocks_num[size_class] < thread_cache_max_blocks_per_class)
+    {
+      ThreadCacheBlock *block = static_cast<ThreadCacheBlock *>(ptr);
+      block->next = cache.free_blocks[size_class];
+      cache.free_blocks[size_class] = block;
+      cache.free_blocks_num[size_class]++;
+      return;
+    }
+  }
+  free(ptr);
+}
+
+#else
+
+static void *mem_block_alloc(const size_t size, const bool zero)
+{
+  return zero ? calloc(1, size) : malloc(size);
+}
+
+static void mem_block_free(void *ptr, const size_t /*size*/)
+{
+  free(ptr);
+}
+
+#endif /* WITH_MEM_THREAD_CACHE */
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 0)))
 #endif
@@ -170,7 +280,7 @@ void MEM_lockfree_freeN(void *vmemh, AllocationType allocation_type)
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
   else {
-    free(memh);
+    mem_block_free(memh, len + sizeof(*memh));
   }
 }
 
@@ -297,7 +407,7 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = (MemHead *)mem_block_alloc(len + sizeof(MemHead), true);
 
   if (LIKELY(memh)) {
     memh->len = len;
@@ -339,7 +449,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = (MemHead *)mem_block_alloc(len + sizeof(MemHead), false);
 
   if (LIKELY(memh)) {
 
@@ -54,6 +54,12 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Total number of bytes and blocks that have been allocated on this thread. Freed memory is not
+   * subtracted. These are only accessed by the owning thread, so they don't have to be atomic.
+   */
+  int64_t allocated_bytes_total = 0;
+  int64_t allocated_blocks_total = 0;
 
   Local();
   ~Local();
@@ -195,6 +201,8 @@ void memory_usage_block_alloc(const size_t size)
      * time, which is very rare compared to doing allocations. */
     local.blocks_num.fetch_add(1, std::memory_order_relaxed);
     local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    local.allocated_blocks_total++;
+    local.allocated_bytes_total += int64_t(size);
 
     /* If a certain amount of new memory has been allocated, update the peak. */
     if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
@@ -273,3 +281,16 @@ void memory_usage_peak_reset()
   Global &global = get_global();
   global.peak = memory_usage_current();
 }
+
+void MEM_get_thread_allocation_totals(size_t *r_bytes, size_t *r_blocks)
+{
+  if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
+    const Local &local = get_local_data();
+    *r_bytes = size_t(local.allocated_bytes_total);
+    *r_blocks = size_t(local.allocated_blocks_total);
+  }
+  else {
+    *r_bytes = 0;
+    *r_blocks = 0;
+  }
+}
@@ -0,0 +1,37 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <thread>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, ThreadAllocationTotals)
+{
+  size_t bytes_before, blocks_before;
+  MEM_get_thread_allocation_totals(&bytes_before, &blocks_before);
+
+  void *a = MEM_mallocN(100, __func__);
+  void *b = MEM_callocN(1000, __func__);
+  MEM_freeN(a);
+
+  size_t bytes_after, blocks_after;
+  MEM_get_thread_allocation_totals(&bytes_after, &blocks_after);
+  /* Freed memory is not subtracted. */
+  EXPECT_EQ(bytes_after - bytes_before, 1100);
+  EXPECT_EQ(blocks_after - blocks_before, 2);
+
+  /* Allocations on other threads are not counted. */
+  std::thread thread([]() { MEM_freeN(MEM_mallocN(1000, __func__)); });
+  thread.join();
+  MEM_freeN(b);
+
+  size_t bytes_final, blocks_final;
+  MEM_get_thread_allocation_totals(&bytes_final, &blocks_final);
+  EXPECT_EQ(bytes_final, bytes_after);
+  EXPECT_EQ(blocks_final, blocks_after);
+}
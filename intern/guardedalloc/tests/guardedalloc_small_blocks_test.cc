@@ -0,0 +1,78 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+#include <thread>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, SmallBlocksReusedZeroed)
+{
+  /* Freed memory may be handed out again, calloc still has to return cleared memory. */
+  for (int i = 0; i < 100; i++) {
+    char *a = static_cast<char *>(MEM_mallocN(100, __func__));
+    memset(a, 0xff, 100);
+    MEM_freeN(a);
+
+    char *b = static_cast<char *>(MEM_callocN(100, __func__));
+    for (int j = 0; j < 100; j++) {
+      EXPECT_EQ(b[j], 0);
+    }
+    MEM_freeN(b);
+  }
+}
+
+TEST_F(LockFreeAllocatorTest, SmallBlocksMixedSizes)
+{
+  const size_t used_before = MEM_get_memory_in_use();
+
+  void *blocks[64];
+  for (int iter = 0; iter < 4; iter++) {
+    for (int i = 0; i < 64; i++) {
+      const size_t size = size_t(i) * 12 + size_t(iter) * 4;
+      blocks[i] = MEM_mallocN(size, __func__);
+      EXPECT_EQ(MEM_allocN_len(blocks[i]), size);
+      memset(blocks[i], i, size);
+    }
+    for (int i = 0; i < 64; i += 2) {
+      MEM_freeN(blocks[i]);
+    }
+    for (int i = 1; i < 64; i += 2) {
+      const size_t size = size_t(i) * 12 + size_t(iter) * 4;
+      for (size_t j = 0; j < size; j++) {
+        EXPECT_EQ(static_cast<unsigned char *>(blocks[i])[j], i);
+      }
+      MEM_freeN(blocks[i]);
+    }
+  }
+
+  EXPECT_EQ(MEM_get_memory_in_use(), used_before);
+}
+
+TEST_F(LockFreeAllocatorTest, SmallBlocksFreedOnOtherThread)
+{
+  const unsigned int blocks_before = MEM_get_memory_blocks_in_use();
+
+  void *blocks[1000];
+  for (int i = 0; i < 1000; i++) {
+    blocks[i] = MEM_mallocN(32, __func__);
+  }
+
+  std::thread thread([&]() {
+    for (int i = 0; i < 1000; i++) {
+      MEM_freeN(blocks[i]);
+    }
+    /* Blocks freed here can be reused by this thread. */
+    void *block = MEM_callocN(32, __func__);
+    EXPECT_EQ(static_cast<char *>(block)[31], 0);
+    MEM_freeN(block);
+  });
+  thread.join();
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_before);
+}
@@ -584,16 +584,12 @@ template<typename Mesh> class Mikktspace {
 
   struct NeighborShard {
     struct Entry {
+      Entry() = default;
       Entry(uint32_t key_, uint data_) : key(key_), data(data_) {}
       uint key, data;
     };
     std::vector<Entry> entries;
 
-    NeighborShard(size_t capacity)
-    {
-      entries.reserve(capacity);
-    }
-
     void buildNeighbors(Mikktspace<Mesh> *mikk)
     {
       /* Entries are added by iterating over t, so by using a stable sort,
@@ -646,7 +642,6 @@ template<typename Mesh> class Mikktspace {
      * key go into the same shard.
      * This is done by hashing the key to get the shard index of each vertex.
      */
-    // TODO: Two-step filling that first counts and then fills? Could be parallel then.
     uint targetNrShards = isParallel ? uint(4 * nrThreads) : 1;
     uint nrShards = 1, hashShift = 32;
     while (nrShards < targetNrShards) {
@@ -654,23 +649,56 @@ template<typename Mesh> class Mikktspace {
       hashShift -= 1;
     }
 
-    /* Reserve 25% extra to account for variation due to hashing. */
-    size_t reserveSize = size_t(double(3 * nrTriangles) * 1.25 / nrShards);
-    std::vector<NeighborShard> shards(nrShards, {reserveSize});
+    auto edgeHash = [&](const Triangle &triangle, const uint i) {
+      const uint i0 = triangle.vertices[i];
+      const uint i1 = triangle.vertices[(i != 2) ? (i + 1) : 0];
+      const uint high = std::max(i0, i1), low = std::min(i0, i1);
+      return hash_uint3(high, low, 0);
+    };
+    /* TODO: Reusing the hash here means less hash space inside each shard.
+     * Computing a second hash with a different seed it probably not worth it? */
+    auto shardOfHash = [&](const uint hash) { return isParallel ? (hash >> hashShift) : 0; };
+
+    /* The shards are filled in two steps, so that both can run in parallel: first the number of
+     * entries per shard is counted for contiguous chunks of triangles, then every chunk writes its
+     * entries starting at the offset given by the previous chunks. This keeps the entries of each
+     * shard ordered by triangle index, the same as when filling them sequentially. */
+    const uint nrChunks = isParallel ? uint(4 * nrThreads) : 1;
+    const uint chunkSize = (nrTriangles + nrChunks - 1) / nrChunks;
+    std::vector<uint> chunkOffsets(size_t(nrChunks) * nrShards, 0);
+
+    runParallel(0u, nrChunks, [&](uint c) {
+      uint *counts = &chunkOffsets[size_t(c) * nrShards];
+      const uint end = std::min(nrTriangles, (c + 1) * chunkSize);
+      for (uint t = c * chunkSize; t < end; t++) {
+        for (uint i = 0; i < 3; i++) {
+          counts[shardOfHash(edgeHash(triangles[t], i))]++;
+        }
+      }
+    });
 
-    for (uint t = 0; t < nrTriangles; t++) {
-      Triangle &triangle = triangles[t];
-      for (uint i = 0; i < 3; i++) {
-        const uint i0 = triangle.vertices[i];
-        const uint i1 = triangle.vertices[(i != 2) ? (i + 1) : 0];
-        const uint high = std::max(i0, i1), low = std::min(i0, i1);
-        const uint hash = hash_uint3(high, low, 0);
-        /* TODO: Reusing the hash here means less hash space inside each shard.
-         * Computing a second hash with a different seed it probably not worth it? */
-        const uint shard = isParallel ? (hash >> hashShift) : 0;
-        shards[shard].entries.emplace_back(hash, pack_index(t, i));
+    std::vector<NeighborShard> shards(nrShards);
+    for (uint s = 0; s < nrShards; s++) {
+      uint total = 0;
+      for (uint c = 0; c < nrChunks; c++) {
+        const uint count = chunkOffsets[size_t(c) * nrShards + s];
+        chunkOffsets[size_t(c) * nrShards + s] = total;
+        total += count;
+      }
+      shards[s].entries.resize(total);
+    }
+
+    runParallel(0u, nrChunks, [&](uint c) {
+      uint *offsets = &chunkOffsets[size_t(c) * nrShards];
+      const uint end = std::min(nrTriangles, (c + 1) * chunkSize);
+      for (uint t = c * chunkSize; t < end; t++) {
+        for (uint i = 0; i < 3; i++) {
+          const uint hash = edgeHash(triangles[t], i);
+          const uint shard = shardOfHash(hash);
+          shards[shard].entries[offsets[shard]++] = {hash, pack_index(t, i)};
+        }
       }
-    }
+    });
 
     runParallel(0u, nrShards, [&](uint s) { shards[s].buildNeighbors(this); });
   }
@@ -13,19 +13,76 @@
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/cpuVertexBuffer.h>
 
+#ifdef WITH_TBB
+#  include <tbb/blocked_range.h>
+#  include <tbb/parallel_for.h>
+#endif
+
 using OpenSubdiv::Far::StencilTable;
 using OpenSubdiv::Osd::CpuEvaluator;
 using OpenSubdiv::Osd::CpuVertexBuffer;
 
 namespace blender::opensubdiv {
 
+// CPU evaluator which evaluates stencils on multiple threads. Stencils only read from the coarse
+// vertices, so all of them can be evaluated independently. Patches are still evaluated by the
+// regular CPU evaluator: they are evaluated per point by the callers, which are multi-threaded
+// already.
+class ParallelCpuEvaluator : public CpuEvaluator {
+ public:
+  template<typename SRC_BUFFER, typename DST_BUFFER>
+  static bool EvalStencils(SRC_BUFFER *src_buffer,
+                           BufferDescriptor const &src_desc,
+                           DST_BUFFER *dst_buffer,
+                           BufferDescriptor const &dst_desc,
+                           StencilTable const *stencil_table,
+                           const ParallelCpuEvaluator * /*instance*/ = NULL,
+                           void * /*device_context*/ = NULL)
+  {
+    const int num_stencils = stencil_table->GetNumStencils();
+    if (num_stencils == 0) {
+      return false;
+    }
+    const float *src = src_buffer->BindCpuBuffer();
+    float *dst = dst_buffer->BindCpuBuffer();
+    const int *sizes = &stencil_table->GetSizes()[0];
+    const int *offsets = &stencil_table->GetOffsets()[0];
+    const int *indices = &stencil_table->GetControlIndices()[0];
+    const float *weights = &stencil_table->GetWeights()[0];
+#ifdef WITH_TBB
+    const int grain_size = 4096;
+    if (num_stencils > grain_size) {
+      if (src_desc.length != dst_desc.length) {
+        return false;
+      }
+      tbb::parallel_for(tbb::blocked_range<int>(0, num_stencils, grain_size),
+                        [&](const tbb::blocked_range<int> &range) {
+                          CpuEvaluator::EvalStencils(src,
+                                                     src_desc,
+                                                     dst,
+                                                     dst_desc,
+                                                     sizes,
+                                                     offsets,
+                                                     indices,
+                                                     weights,
+                                                     range.begin(),
+                                                     range.end());
+                        });
+      return true;
+    }
+#endif
+    return CpuEvaluator::EvalStencils(
+        src, src_desc, dst, dst_desc, sizes, offsets, indices, weights, 0, num_stencils);
+  }
+};
+
 // NOTE: Define as a class instead of typedef to make it possible
 // to have anonymous class in opensubdiv_evaluator_internal.h
 class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                                                 CpuVertexBuffer,
                                                 StencilTable,
                                                 CpuPatchTable,
-                                                CpuEvaluator> {
+                                                ParallelCpuEvaluator> {
  public:
   CpuEvalOutput(const StencilTable *vertex_stencils,
                 const StencilTable *varying_stencils,
@@ -37,7 +94,7 @@ class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                            CpuVertexBuffer,
                            StencilTable,
                            CpuPatchTable,
-                           CpuEvaluator>(vertex_stencils,
+                           ParallelCpuEvaluator>(vertex_stencils,
                                          varying_stencils,
                                          all_face_varying_stencils,
                                          face_varying_width,
@@ -777,6 +777,12 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col.prop(system, "vbo_time_out", text="VBO Time Out")
         col.prop(system, "vbo_collection_rate", text="Garbage Collection Rate")
 
+        layout.separator()
+
+        col = layout.column()
+        col.prop(system, "use_volume_delay_load")
+        col.prop(system, "volume_cache_limit")
+
         if sys.platform != "darwin":
             layout.separator()
             col = layout.column()
@@ -792,6 +798,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         # edit = prefs.edit
 
         layout.prop(system, "memory_cache_limit")
+        layout.prop(system, "use_sequencer_cache_compression")
 
         layout.separator()
 
@@ -805,6 +812,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         layout.separator()
 
         layout.prop(system, "sequencer_proxy_setup")
+        layout.prop(system, "use_hardware_video_decoding")
 
 
 # -----------------------------------------------------------------------------
@@ -37,6 +37,29 @@ struct FrameCache {
   BakeState state;
   /** Used when the baked data is loaded lazily. */
   std::optional<std::string> meta_path;
+  /**
+   * True when the state has been written to the #FramePagingStorage of the cache. Then the state
+   * may be freed and loaded again later on.
+   */
+  bool is_paged = false;
+  /** Approximate memory used by the state, computed when it's needed first. */
+  std::optional<int64_t> state_memory;
+};
+
+/**
+ * Temporary storage on disk for simulation states that are not baked. To limit the memory usage of
+ * long simulations, the states of frames far away from the current frame are written to it and
+ * freed. They are loaded again when they are needed.
+ */
+struct FramePagingStorage : NonCopyable, NonMovable {
+  BakePath path;
+  BlobWriteSharing blob_sharing;
+  /** Used to generate unique file names. */
+  int files_num = 0;
+
+  FramePagingStorage(BakePath path);
+  /** Deletes all data written to the storage. */
+  ~FramePagingStorage();
 };
 
 /**
@@ -61,10 +84,26 @@ struct NodeBakeCache {
   std::unique_ptr<BlobReadSharing> blob_sharing;
   /** Used to avoid checking if a bake exists many times. */
   bool failed_finding_bake = false;
+  /** Created when the first frame state is paged out of memory. */
+  std::unique_ptr<FramePagingStorage> paging;
 
   /** Range spanning from the first to the last baked frame. */
   IndexRange frame_range() const;
 
+  /**
+   * Write states of frames that are far away from the given frame to disk and free them, until the
+   * remaining states fit into the memory budget. The frames directly around the given frame are
+   * always kept in memory, because they may be referenced by the current evaluation.
+   */
+  void page_out_distant_frames(const SubFrame &frame);
+
+  /**
+   * Load the state of a frame that has been paged out before.
+   * 
+eturn True on success, otherwise false.
+   */
+  bool page_in(FrameCache &frame_cache);
+
   void reset();
 };
 
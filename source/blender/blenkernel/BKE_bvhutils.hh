@@ -161,12 +161,19 @@ float bvhtree_sphereray_tri_intersection(const BVHTreeRay *ray,
 
 struct BVHTreeFromPointCloud {
   BVHTree *tree;
+  /** True when the tree is owned by the point cloud's runtime data and must not be freed. */
+  bool cached;
 
   BVHTree_NearestPointCallback nearest_callback;
 
   const float (*coords)[3];
 };
 
+/**
+ * Build a BVH tree of the points in the mask. The tree of all points is cached on the point cloud
+ * and shared with its copies, the tree still has to be released with
+ * #free_bvhtree_from_pointcloud.
+ */
 void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
                                      const blender::IndexMask &points_mask,
                                      BVHTreeFromPointCloud &r_data);
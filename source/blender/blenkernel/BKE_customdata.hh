@@ -336,6 +336,15 @@ void CustomData_set_only_copy(const CustomData *data, eCustomDataMask mask);
  */
 void CustomData_copy_data(
     const CustomData *source, CustomData *dest, int source_index, int dest_index, int count);
+/**
+ * Like #CustomData_copy_data, but copies many elements at once, one layer at a time. This is much
+ * faster than calling #CustomData_copy_data for every element when there are many layers.
+ * \param dest_indices: The destination index for every source element, elements with a negative
+ * index are skipped.
+ */
+void CustomData_copy_data_map(const CustomData *source,
+                              CustomData *dest,
+                              blender::Span<int> dest_indices);
 void CustomData_copy_data_layer(const CustomData *source,
                                 CustomData *dest,
                                 int src_layer_index,
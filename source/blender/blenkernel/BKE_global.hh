@@ -167,6 +167,18 @@ struct Global {
    */
   char autoexec_fail[200];
 
+  /**
+   * When set (from the `--profile-load` command line argument), a JSON report with timings of
+   * the various stages of reading `.blend` files is written to this path after each file load.
+   */
+  char profile_load_filepath[/*FILE_MAX*/ 1024];
+
+  /**
+   * When set (from the `--debug-depsgraph-trace` command line argument), the timeline of every
+   * dependency graph evaluation is written to this path, in the Chrome trace event format.
+   */
+  char debug_depsgraph_trace_filepath[/*FILE_MAX*/ 1024];
+
   /**
    * Has there been an opengl deprecation call detected when running on a none OpenGL backend.
    */
@@ -258,6 +270,7 @@ enum {
 
   G_DEBUG_GHOST = (1 << 23),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 24), /* Debug Wintab. */
+  G_DEBUG_WM_TIME = (1 << 25), /* Window manager main loop timing statistics. */
 };
 
 #define G_DEBUG_ALL \
@@ -96,7 +96,17 @@ class Drawing : public ::GreasePencilDrawing {
   Span<float3> curve_plane_normals() const;
   void tag_texture_matrices_changed();
   void tag_positions_changed();
+  /**
+   * Like #tag_positions_changed, but only the normals and triangles of the changed curves are
+   * calculated again when they were cached before.
+   */
+  void tag_positions_changed(const IndexMask &changed_curves);
   void tag_topology_changed();
+  /**
+   * Like #tag_topology_changed, but keeps the cached normals and triangles of all curves before
+   * the first changed curve, which have to be unchanged. Used when drawing new strokes.
+   */
+  void tag_topology_changed(const IndexMask &changed_curves);
 
   /**
    * Returns the matrices that transform from a 3D point in layer-space to a 2D point in
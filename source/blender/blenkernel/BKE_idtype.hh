@@ -62,6 +62,11 @@ enum {
    * IDs have at least an 'extra user' (#LIB_TAG_EXTRAUSER).
    */
   IDTYPE_FLAGS_NEVER_UNUSED = 1 << 6,
+  /**
+   * Indicates that the `blend_write` callback of the given IDType only accesses data owned by the
+   * written ID, so that multiple IDs of this type can be written in parallel.
+   */
+  IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE = 1 << 7,
 };
 
 struct IDCacheKey {
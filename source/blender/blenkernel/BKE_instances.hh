@@ -103,6 +103,20 @@ class InstanceReference {
   friend bool operator==(const InstanceReference &a, const InstanceReference &b);
 };
 
+/**
+ * An instance found by #Instances::foreach_instance_recursive.
+ */
+struct NestedInstance {
+  const InstanceReference &reference;
+  /** Transform of the instance, including the transforms of all its parent instances. */
+  float4x4 transform;
+  /**
+   * Index of the instance in its #Instances for every nesting level, starting at the top level.
+   * This can be used to generate ids that are stable over time, e.g. for motion blur.
+   */
+  Span<int> path;
+};
+
 class Instances {
  private:
   /**
@@ -195,6 +209,18 @@ class Instances {
   void foreach_referenced_geometry(
       FunctionRef<void(const GeometrySet &geometry_set)> callback) const;
 
+  /**
+   * Call #fn for every instance, including the instances nested in instanced geometry sets. The
+   * instances are generated while iterating, so unlike building a flat list first, the memory
+   * usage only depends on the nesting depth. That allows renderers and exporters to consume very
+   * large numbers of nested instances.
+   *
+   * \param fn: Returns true if the instances nested in the reference of the given instance should
+   * be visited as well. Otherwise it is expected to handle the entire reference itself.
+   */
+  void foreach_instance_recursive(const float4x4 &base_transform,
+                                  FunctionRef<bool(const NestedInstance &instance)> fn) const;
+
   bool owns_direct_data() const;
   void ensure_owns_direct_data();
 
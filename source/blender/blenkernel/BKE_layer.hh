@@ -165,6 +165,12 @@ void BKE_layer_collection_local_sync(const Scene *scene, ViewLayer *view_layer,
 void BKE_layer_collection_local_sync_all(const Main *bmain);
 
 void BKE_main_collection_sync_remap(const Main *bmain);
+/**
+ * Update the view layers after \a ob has been added to \a collection. Unlike
+ * #BKE_main_collection_sync, view layers that are in sync are updated in place instead of being
+ * tagged for a full resync, which only needs to visit their layer collections.
+ */
+void BKE_main_collection_sync_object_add(const Main *bmain, Collection *collection, Object *ob);
 
 /**
  * Return the first matching #LayerCollection in the #ViewLayer for the Collection.
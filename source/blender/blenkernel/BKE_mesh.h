@@ -41,6 +41,8 @@ enum eMeshBatchDirtyMode {
   BKE_MESH_BATCH_DIRTY_SHADING,
   BKE_MESH_BATCH_DIRTY_UVEDIT_ALL,
   BKE_MESH_BATCH_DIRTY_UVEDIT_SELECT,
+  /** Only the vertex positions changed, the topology and all other attributes are the same. */
+  BKE_MESH_BATCH_DIRTY_DEFORM,
 };
 
 /* `mesh.cc` */
@@ -502,6 +504,12 @@ void BKE_mesh_eval_geometry(Depsgraph *depsgraph, Mesh *mesh);
 /* Draw Cache */
 void BKE_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode);
 void BKE_mesh_batch_cache_free(void *batch_cache);
+/**
+ * Move the draw cache of the previous evaluated mesh of an object to the new evaluated mesh, when
+ * the meshes only differ in their vertex positions (e.g. during playback of an armature
+ * deformation). Buffers that only depend on the topology don't have to be created again then.
+ */
+void BKE_mesh_batch_cache_reuse(Mesh *mesh, Mesh *mesh_prev);
 
 extern void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *mesh, eMeshBatchDirtyMode mode);
 extern void (*BKE_mesh_batch_cache_free_cb)(void *batch_cache);
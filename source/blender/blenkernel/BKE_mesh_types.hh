@@ -15,6 +15,7 @@
 #include "BLI_bit_vector.hh"
 #include "BLI_bounds_types.hh"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_kdopbvh.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_shared_cache.hh"
 #include "BLI_vector.hh"
@@ -94,6 +95,14 @@ struct LooseEdgeCache : public LooseGeomCache {};
  */
 struct LooseVertCache : public LooseGeomCache {};
 
+/**
+ * Cache of the edges using each vertex, accessed with #Mesh::vert_to_edge_map().
+ */
+struct VertToEdgeMapCache {
+  Array<int> offsets;
+  Array<int> indices;
+};
+
 struct TrianglesCache {
   SharedCache<Array<int3>> data;
   bool frozen = false;
@@ -160,6 +169,14 @@ struct MeshRuntime {
 
   /** Cache for BVH trees generated for the mesh. Defined in 'BKE_bvhutil.c' */
   BVHCache *bvh_cache = nullptr;
+  /**
+   * BVH trees that don't depend on the hidden state of elements are shared between meshes with
+   * unchanged positions and topology, so that e.g. a copy of a mesh doesn't have to build them
+   * again. The trees are "un-shared" whenever #bvh_cache is freed. See #SharedCache comments.
+   */
+  SharedCache<BVHTreePtr> bvh_cache_verts;
+  SharedCache<BVHTreePtr> bvh_cache_edges;
+  SharedCache<BVHTreePtr> bvh_cache_corner_tris;
 
   /** Needed in case we need to lazily initialize the mesh. */
   CustomData_MeshMasks cd_mask_extra = {};
@@ -210,6 +227,8 @@ struct MeshRuntime {
   SharedCache<Array<int>> vert_to_corner_map_cache;
   /** Cache of face indices for each face corner. */
   SharedCache<Array<int>> corner_to_face_map_cache;
+  /** Cache of edge indices for each vertex. See #Mesh::vert_to_edge_map(). */
+  SharedCache<VertToEdgeMapCache> vert_to_edge_map_cache;
   /** Cache of data about edges not used by faces. See #Mesh::loose_edges(). */
   SharedCache<LooseEdgeCache> loose_edges_cache;
   /** Cache of data about vertices not used by edges. See #Mesh::loose_verts(). */
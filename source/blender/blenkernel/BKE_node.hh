@@ -393,6 +393,12 @@ struct bNodeType {
 
   /** True when the node cannot be muted. */
   bool no_muting;
+  /**
+   * True when the outputs of the node only depend on its inputs and settings and are expensive
+   * enough to compute that it's worth to remember them between evaluations of the node tree. See
+   * #GeoNodesResultCache.
+   */
+  bool cache_results;
   /** True when the node still works but it's usage is discouraged. */
   const char *deprecation_notice;
 
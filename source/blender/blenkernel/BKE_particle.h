@@ -153,6 +153,10 @@ typedef struct ParticleThreadContext {
   int between, segments, extra_segments;
   int totchild, totparent, parent_pass;
 
+  /* Edit data and parent paths used for all children, looked up once. */
+  struct PTCacheEdit *edit;
+  struct ParticleCacheKey **parent_pathcache;
+
   float cfra;
 
   float *vg_length, *vg_clump, *vg_kink;
@@ -163,6 +167,10 @@ typedef struct ParticleThreadContext {
   struct CurveMapping *clumpcurve;
   struct CurveMapping *roughcurve;
   struct CurveMapping *twistcurve;
+
+  /* Integral of the twist curve at the start of every step along the path (see #do_twist). */
+  float *twist_curve_steps, *twist_curve_integral;
+  int twist_curve_steps_num;
 } ParticleThreadContext;
 
 typedef struct ParticleTask {
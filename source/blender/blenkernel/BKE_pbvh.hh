@@ -42,8 +42,17 @@ enum PBVHNodeFlags {
   PBVH_TexLeaf = 1 << 16,
   /** Used internally by `pbvh_bmesh.cc`. */
   PBVH_TopologyUpdated = 1 << 17,
+
+  /**
+   * Like #PBVH_UpdateDrawBuffers, but only the draw buffers that depend on the given data are
+   * updated. That avoids re-uploading e.g. colors and UV maps on every step of a sculpt stroke.
+   */
+  PBVH_UpdateDrawPositions = 1 << 18,
+  PBVH_UpdateDrawMask = 1 << 19,
+  PBVH_UpdateDrawColor = 1 << 20,
+  PBVH_UpdateDrawFaceSets = 1 << 21,
 };
-ENUM_OPERATORS(PBVHNodeFlags, PBVH_TopologyUpdated);
+ENUM_OPERATORS(PBVHNodeFlags, PBVH_UpdateDrawFaceSets);
 
 /* A few C++ methods to play nice with sets and maps. */
 #define PBVH_REF_CXX_METHODS(Class) \
@@ -376,6 +376,17 @@ namespace blender::bke::pbvh {
 IndexMask nodes_to_face_selection_grids(const SubdivCCG &subdiv_ccg,
                                         Span<const PBVHNode *> nodes,
                                         IndexMaskMemory &memory);
+
+/**
+ * Calculate vertex and face orders for the mesh that store the unique vertices and the faces of
+ * every leaf node contiguously, with nodes that are close in the tree close in memory as well.
+ * Reordering the mesh like this makes the indexed access in brush loops mostly sequential.
+ * Vertices that aren't used by any face are moved to the end. Only valid for #PBVH_FACES.
+ */
+void leaf_contiguous_orders_calc(const PBVH &pbvh,
+                                 const Mesh &mesh,
+                                 Array<int> &r_vert_order,
+                                 Array<int> &r_face_order);
 }
 void BKE_pbvh_subdiv_cgg_set(PBVH &pbvh, SubdivCCG *subdiv_ccg);
 
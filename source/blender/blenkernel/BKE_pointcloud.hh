@@ -12,6 +12,7 @@
 #include <mutex>
 
 #include "BLI_bounds_types.hh"
+#include "BLI_kdopbvh.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_shared_cache.hh"
 
@@ -40,6 +41,12 @@ struct PointCloudRuntime {
    */
   mutable SharedCache<Bounds<float3>> bounds_cache;
 
+  /**
+   * A BVH tree of all points, shared between data-blocks with unchanged positions.
+   * See #SharedCache comments.
+   */
+  mutable SharedCache<BVHTreePtr> bvh_cache;
+
   /** Stores weak references to material data blocks. */
   std::unique_ptr<bake::BakeMaterialsList> bake_materials;
 
@@ -32,6 +32,7 @@ struct BakeMaterialsList;
 /* Module */
 
 void BKE_volumes_init();
+void BKE_volumes_exit();
 
 /* Data-block Management */
 
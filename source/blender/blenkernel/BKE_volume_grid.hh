@@ -90,6 +90,8 @@ class VolumeGridData : public ImplicitSharingMixin {
   mutable bool transform_loaded_ = false;
   /** The meta-data stored in the grid is valid. */
   mutable bool meta_data_loaded_ = false;
+  /** Cached result of #tree_memory_usage for reloadable grids, negative when unknown. */
+  mutable int64_t tree_memory_ = -1;
 
   /**
    * A function that can load the full grid or also just the tree lazily.
@@ -223,6 +225,12 @@ class VolumeGridData : public ImplicitSharingMixin {
    */
   void unload_tree_if_possible() const;
 
+  /**
+   * Memory used by the tree in bytes, or zero when it is not loaded. This does not load the tree.
+   * For reloadable grids the value is only computed once after loading.
+   */
+  int64_t tree_memory_usage() const;
+
  private:
   void ensure_grid_loaded() const;
   void delete_self();
@@ -54,6 +54,17 @@ GridsFromFile get_all_grids_from_file(StringRef file_path, int simplify_level =
  */
 void unload_unused();
 
+/**
+ * Load all grids of the file including their trees on a background thread, so that they are
+ * already in the cache when they are requested later on, e.g. for the next frame of a sequence.
+ */
+void prefetch_grids_from_file(StringRef file_path);
+
+/**
+ * Stop all prefetching, called when Blender exits.
+ */
+void exit();
+
 }  // namespace blender::bke::volume_grid::file_cache
 
 #endif
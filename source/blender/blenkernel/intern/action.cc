@@ -378,9 +378,9 @@ static void action_blend_write(BlendWriter *writer, ID *id, const void *id_addre
 static void read_channelbag(BlendDataReader *reader, animrig::ChannelBag &channelbag)
 {
   BLO_read_pointer_array(reader, reinterpret_cast<void **>(&channelbag.fcurve_array));
+  BLO_read_struct_pointers(reader, FCurve, channelbag.fcurve_array_num, channelbag.fcurve_array);
 
   for (int i = 0; i < channelbag.fcurve_array_num; i++) {
-    BLO_read_struct(reader, FCurve, &channelbag.fcurve_array[i]);
     BKE_fcurve_blend_read_data(reader, channelbag.fcurve_array[i]);
   }
 }
@@ -388,9 +388,10 @@ static void read_channelbag(BlendDataReader *reader, animrig::ChannelBag &channe
 static void read_keyframe_strip(BlendDataReader *reader, animrig::KeyframeStrip &strip)
 {
   BLO_read_pointer_array(reader, reinterpret_cast<void **>(&strip.channelbag_array));
+  BLO_read_struct_pointers(
+      reader, ActionChannelBag, strip.channelbag_array_num, strip.channelbag_array);
 
   for (int i = 0; i < strip.channelbag_array_num; i++) {
-    BLO_read_struct(reader, ActionChannelBag, &strip.channelbag_array[i]);
     ActionChannelBag *channelbag = strip.channelbag_array[i];
     read_channelbag(reader, channelbag->wrap());
   }
@@ -422,9 +423,9 @@ static void read_layers(BlendDataReader *reader, animrig::Action &action)
 static void read_slots(BlendDataReader *reader, animrig::Action &action)
 {
   BLO_read_pointer_array(reader, reinterpret_cast<void **>(&action.slot_array));
+  BLO_read_struct_pointers(reader, ActionSlot, action.slot_array_num, action.slot_array);
 
   for (int i = 0; i < action.slot_array_num; i++) {
-    BLO_read_struct(reader, ActionSlot, &action.slot_array[i]);
     action.slot_array[i]->wrap().blend_read_post();
   }
 }
@@ -17,11 +17,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_armature_types.h"
@@ -235,6 +238,27 @@ static void pchan_bone_deform(const bPoseChannel *pchan,
  * #BKE_armature_deform_coords and related functions.
  * \{ */
 
+/** Influence of a deforming bone on a vertex, resolved from its vertex group. */
+struct ArmatureBoneWeight {
+  const bPoseChannel *pchan;
+  float weight;
+};
+
+/**
+ * The bone weights of all vertices, stored contiguously per vertex. Built once before the
+ * vertices are deformed, so that the vertex loop doesn't have to map vertex groups to pose
+ * channels and skip groups without a deforming bone for every vertex.
+ */
+struct ArmatureDeformPlan {
+  blender::Array<int> offsets;
+  blender::Array<ArmatureBoneWeight> bone_weights;
+
+  blender::Span<ArmatureBoneWeight> vert_bone_weights(const int vert) const
+  {
+    return bone_weights.as_span().slice(blender::OffsetIndices<int>(offsets)[vert]);
+  }
+};
+
 struct ArmatureUserdata {
   const Object *ob_arm;
   const Mesh *me_target;
@@ -255,6 +279,9 @@ struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /** Bone weights of the first #ArmatureDeformPlan::offsets vertices, may be null. */
+  const ArmatureDeformPlan *plan;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -264,6 +291,46 @@ struct ArmatureUserdata {
   } bmesh;
 };
 
+static ArmatureDeformPlan armature_deform_plan_build(const blender::Span<MDeformVert> dverts,
+                                                     bPoseChannel *const *pchan_from_defbase,
+                                                     const int defbase_len)
+{
+  using namespace blender;
+  auto bone_weights_foreach = [&](const MDeformVert &dvert, auto &&fn) {
+    for (const MDeformWeight &dw : Span(dvert.dw, dvert.totweight)) {
+      if (uint(dw.def_nr) < uint(defbase_len)) {
+        if (const bPoseChannel *pchan = pchan_from_defbase[dw.def_nr]) {
+          fn(ArmatureBoneWeight{pchan, dw.weight});
+        }
+      }
+    }
+  };
+
+  ArmatureDeformPlan plan;
+  plan.offsets.reinitialize(dverts.size() + 1);
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      int count = 0;
+      bone_weights_foreach(dverts[vert], [&](const ArmatureBoneWeight & /*bone_weight*/) {
+        count++;
+      });
+      plan.offsets[vert] = count;
+    }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(plan.offsets);
+
+  plan.bone_weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      int index = offsets[vert].start();
+      bone_weights_foreach(dverts[vert], [&](const ArmatureBoneWeight &bone_weight) {
+        plan.bone_weights[index++] = bone_weight;
+      });
+    }
+  });
+  return plan;
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -339,23 +406,34 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   mul_m4_v3(data->premat, co);
 
   if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
-    const MDeformWeight *dw = dvert->dw;
+    auto bone_weight_deform = [&](const bPoseChannel *pchan, float weight) {
+      const Bone *bone = pchan->bone;
+
+      if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        weight *= distfactor_to_bone(
+            co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+      }
+
+      pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
+    };
+
     int deformed = 0;
-    uint j;
-    for (j = dvert->totweight; j != 0; j--, dw++) {
-      const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
-        float weight = dw->weight;
-        const Bone *bone = pchan->bone;
-
-        deformed = 1;
-
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
-          weight *= distfactor_to_bone(
-              co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+    if (data->plan && i < data->plan->offsets.size() - 1) {
+      const blender::Span<ArmatureBoneWeight> bone_weights = data->plan->vert_bone_weights(i);
+      for (const ArmatureBoneWeight &bone_weight : bone_weights) {
+        bone_weight_deform(bone_weight.pchan, bone_weight.weight);
+      }
+      deformed = !bone_weights.is_empty();
+    }
+    else {
+      const MDeformWeight *dw = dvert->dw;
+      uint j;
+      for (j = dvert->totweight; j != 0; j--, dw++) {
+        const uint index = dw->def_nr;
+        if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+          deformed = 1;
+          bone_weight_deform(pchan, dw->weight);
         }
-
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
@@ -594,6 +672,16 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.defbase_len = defbase_len;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
+  /* The edit-mesh weights are stored per #BMVert, only build the plan for array weights. */
+  ArmatureDeformPlan plan;
+  if (use_dverts && em_target == nullptr && !dverts.is_empty()) {
+    plan = armature_deform_plan_build(
+        dverts.take_front(std::min<int64_t>(dverts.size(), vert_coords_len)),
+        pchan_from_defbase,
+        defbase_len);
+    data.plan = &plan;
+  }
+
   float obinv[4][4];
   invert_m4_m4(obinv, ob_target->object_to_world().ptr());
 
@@ -2,10 +2,13 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <fmt/format.h>
 #include <sstream>
 
+#include "BKE_appdir.hh"
 #include "BKE_bake_geometry_nodes_modifier.hh"
 #include "BKE_collection.hh"
+#include "BKE_instances.hh"
 #include "BKE_main.hh"
 
 #include "DNA_modifier_types.h"
@@ -48,6 +51,170 @@ IndexRange NodeBakeCache::frame_range() const
   return IndexRange::from_begin_end_inclusive(start_frame, end_frame);
 }
 
+/**
+ * Maximum memory used by the states of a single simulation that are kept in memory. The states of
+ * other frames are written to disk. This is large enough so that typical simulations are never
+ * written to disk.
+ */
+static constexpr int64_t max_resident_state_memory = int64_t(4) * 1024 * 1024 * 1024;
+
+static int64_t estimate_geometry_memory(const GeometrySet &geometry)
+{
+  int64_t memory = 0;
+  for (const GeometryComponent *component : geometry.get_components()) {
+    if (const std::optional<AttributeAccessor> attributes = component->attributes()) {
+      attributes->for_all(
+          [&](const AttributeIDRef & /*attribute_id*/, const AttributeMetaData &meta_data) {
+            const CPPType &type = *custom_data_type_to_cpp_type(meta_data.data_type);
+            memory += type.size() * attributes->domain_size(meta_data.domain);
+            return true;
+          });
+    }
+    if (const auto *instances_component = dynamic_cast<const InstancesComponent *>(component)) {
+      if (const Instances *instances = instances_component->get()) {
+        for (const InstanceReference &reference : instances->references()) {
+          if (reference.type() == InstanceReference::Type::GeometrySet) {
+            memory += estimate_geometry_memory(reference.geometry_set());
+          }
+        }
+      }
+    }
+  }
+  return memory;
+}
+
+/**
+ * Arrays shared between the states of different frames are counted for every frame, so the
+ * estimate may be larger than the actual memory usage.
+ */
+static int64_t estimate_state_memory(const BakeState &state)
+{
+  int64_t memory = 0;
+  for (const std::unique_ptr<BakeItem> &item : state.items_by_id.values()) {
+    if (const auto *geometry_item = dynamic_cast<const GeometryBakeItem *>(item.get())) {
+      memory += estimate_geometry_memory(geometry_item->geometry);
+    }
+  }
+  return memory;
+}
+
+FramePagingStorage::FramePagingStorage(BakePath path) : path(std::move(path)) {}
+
+FramePagingStorage::~FramePagingStorage()
+{
+  const std::string &root_dir = *this->path.bake_dir;
+  if (BLI_exists(root_dir.c_str())) {
+    BLI_delete(root_dir.c_str(), true, true);
+  }
+}
+
+static bool page_out_frame(NodeBakeCache &bake_cache, FrameCache &frame_cache)
+{
+  if (!bake_cache.paging) {
+    const std::string dir_name = fmt::format("simulation_cache_{}", fmt::ptr(&bake_cache));
+    char root_dir[FILE_MAX];
+    BLI_path_join(root_dir, sizeof(root_dir), BKE_tempdir_session(), dir_name.c_str());
+    bake_cache.paging = std::make_unique<FramePagingStorage>(
+        BakePath::from_single_root(root_dir));
+  }
+  FramePagingStorage &paging = *bake_cache.paging;
+
+  /* Use a unique name for every written state, because a frame may be simulated again, while its
+   * previously written blobs are still referenced by the deduplication in #blob_sharing. */
+  const std::string file_name = fmt::format(
+      "{}_{}", frame_to_file_name(frame_cache.frame), paging.files_num++);
+  char meta_path[FILE_MAX];
+  BLI_path_join(
+      meta_path, sizeof(meta_path), paging.path.meta_dir.c_str(), (file_name + ".json").c_str());
+  if (!BLI_file_ensure_parent_dir_exists(meta_path)) {
+    return false;
+  }
+  {
+    DiskBlobWriter blob_writer{paging.path.blobs_dir, file_name};
+    fstream meta_file{meta_path, std::ios::out};
+    serialize_bake(frame_cache.state, blob_writer, paging.blob_sharing, meta_file);
+    if (!meta_file) {
+      return false;
+    }
+  }
+  frame_cache.meta_path = meta_path;
+  frame_cache.is_paged = true;
+  return true;
+}
+
+void NodeBakeCache::page_out_distant_frames(const SubFrame &frame)
+{
+  const int64_t next_index = binary_search::find_predicate_begin(
+      this->frames,
+      [&](const std::unique_ptr<FrameCache> &value) { return value->frame > frame; });
+  /* The previous, current and next frame may be referenced by the current evaluation. */
+  const IndexRange kept_range = IndexRange::from_begin_end(
+      std::max<int64_t>(next_index - 2, 0),
+      std::min<int64_t>(next_index + 1, this->frames.size()));
+
+  int64_t resident_memory = 0;
+  Vector<int64_t> candidates;
+  for (const int64_t i : this->frames.index_range()) {
+    FrameCache &frame_cache = *this->frames[i];
+    if (frame_cache.state.items_by_id.is_empty()) {
+      continue;
+    }
+    if (frame_cache.meta_path && !frame_cache.is_paged) {
+      /* Baked data is loaded lazily already. */
+      continue;
+    }
+    if (!frame_cache.state_memory) {
+      frame_cache.state_memory = estimate_state_memory(frame_cache.state);
+    }
+    resident_memory += *frame_cache.state_memory;
+    if (!kept_range.contains(i)) {
+      candidates.append(i);
+    }
+  }
+  if (resident_memory <= max_resident_state_memory) {
+    return;
+  }
+
+  /* Free the states that are furthest away first, so that scrubbing around the current frame
+   * doesn't have to load anything. */
+  const float frame_f = float(frame);
+  std::sort(candidates.begin(), candidates.end(), [&](const int64_t a, const int64_t b) {
+    return std::abs(float(this->frames[a]->frame) - frame_f) >
+           std::abs(float(this->frames[b]->frame) - frame_f);
+  });
+  for (const int64_t i : candidates) {
+    if (resident_memory <= max_resident_state_memory) {
+      break;
+    }
+    FrameCache &frame_cache = *this->frames[i];
+    if (!frame_cache.is_paged) {
+      if (!page_out_frame(*this, frame_cache)) {
+        /* Keep the states in memory if they can't be written. */
+        return;
+      }
+    }
+    resident_memory -= *frame_cache.state_memory;
+    frame_cache.state = {};
+  }
+}
+
+bool NodeBakeCache::page_in(FrameCache &frame_cache)
+{
+  if (!frame_cache.is_paged || !this->paging) {
+    return false;
+  }
+  DiskBlobReader blob_reader{this->paging->path.blobs_dir};
+  /* Use separate read sharing, because #blob_sharing would keep all loaded data alive again. */
+  BlobReadSharing blob_sharing;
+  fstream meta_file{*frame_cache.meta_path};
+  std::optional<BakeState> state = deserialize_bake(meta_file, blob_reader, blob_sharing);
+  if (!state) {
+    return false;
+  }
+  frame_cache.state = std::move(*state);
+  return true;
+}
+
 SimulationNodeCache *ModifierCache::get_simulation_node_cache(const int id)
 {
   std::unique_ptr<SimulationNodeCache> *ptr = this->simulation_cache_by_id.lookup_ptr(id);
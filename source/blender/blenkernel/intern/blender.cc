@@ -36,6 +36,7 @@
 #include "BKE_report.hh"
 #include "BKE_screen.hh"
 #include "BKE_studiolight.h"
+#include "BKE_volume.hh"
 #include "BKE_writeffmpeg.hh"
 
 #include "DEG_depsgraph.hh"
@@ -68,6 +69,7 @@ void BKE_blender_free()
 
   IMB_exit();
   BKE_cachefiles_exit();
+  BKE_volumes_exit();
   DEG_free_node_types();
 
   BKE_brush_system_exit();
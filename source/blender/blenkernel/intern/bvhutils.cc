@@ -16,6 +16,7 @@
 #include "BKE_bvhutils.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_mesh.hh"
+#include "BKE_pointcloud.hh"
 
 using blender::BitSpan;
 using blender::BitVector;
@@ -896,117 +897,154 @@ static BitVector<> corner_tris_no_hidden_map_get(const blender::OffsetIndices<in
   return corner_tris_mask;
 }
 
-BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
-                                   const Mesh *mesh,
-                                   const BVHCacheType bvh_cache_type,
-                                   const int tree_type)
+static BVHTree *mesh_bvhtree_create(const Mesh &mesh,
+                                    const BVHCacheType bvh_cache_type,
+                                    const int tree_type,
+                                    const Span<float3> positions,
+                                    const Span<blender::int2> edges,
+                                    const Span<int> corner_verts,
+                                    const Span<int3> corner_tris)
 {
   using namespace blender;
   using namespace blender::bke;
-  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime->bvh_cache;
-
-  Span<int3> corner_tris;
-  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
-    corner_tris = mesh->corner_tris();
-  }
-
-  const Span<float3> positions = mesh->vert_positions();
-  const Span<int2> edges = mesh->edges();
-  const Span<int> corner_verts = mesh->corner_verts();
-
-  /* Setup BVHTreeFromMesh */
-  bvhtree_from_mesh_setup_data(nullptr,
-                               bvh_cache_type,
-                               positions,
-                               edges,
-                               corner_verts,
-                               corner_tris,
-                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-                               data);
-
-  bool lock_started = false;
-  data->cached = bvhcache_find(
-      bvh_cache_p, bvh_cache_type, &data->tree, &lock_started, &mesh->runtime->eval_mutex);
-
-  if (data->cached) {
-    BLI_assert(lock_started == false);
-
-    /* NOTE: #data->tree can be nullptr. */
-    return data->tree;
-  }
-
-  /* Create BVHTree. */
-
   switch (bvh_cache_type) {
     case BVHTREE_FROM_LOOSEVERTS: {
-      const LooseVertCache &loose_verts = mesh->loose_verts();
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const LooseVertCache &loose_verts = mesh.loose_verts();
+      return bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, loose_verts.is_loose_bits, loose_verts.count);
-      break;
     }
     case BVHTREE_FROM_LOOSEVERTS_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_verts_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_verts_create_tree(
+      const BitVector<> mask = loose_verts_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      return bvhtree_from_mesh_verts_create_tree(
           0.0f, tree_type, 6, positions, mask, mask_bits_act_len);
-      break;
     }
     case BVHTREE_FROM_VERTS: {
-      data->tree = bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
-      break;
+      return bvhtree_from_mesh_verts_create_tree(0.0f, tree_type, 6, positions, {}, -1);
     }
     case BVHTREE_FROM_LOOSEEDGES: {
-      const LooseEdgeCache &loose_edges = mesh->loose_edges();
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const LooseEdgeCache &loose_edges = mesh.loose_edges();
+      return bvhtree_from_mesh_edges_create_tree(
           positions, edges, loose_edges.is_loose_bits, loose_edges.count, 0.0f, tree_type, 6);
-      break;
     }
     case BVHTREE_FROM_LOOSEEDGES_NO_HIDDEN: {
       int mask_bits_act_len = -1;
-      const BitVector<> mask = loose_edges_no_hidden_mask_get(*mesh, &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_edges_create_tree(
+      const BitVector<> mask = loose_edges_no_hidden_mask_get(mesh, &mask_bits_act_len);
+      return bvhtree_from_mesh_edges_create_tree(
           positions, edges, mask, mask_bits_act_len, 0.0f, tree_type, 6);
-      break;
     }
     case BVHTREE_FROM_EDGES: {
-      data->tree = bvhtree_from_mesh_edges_create_tree(
-          positions, edges, {}, -1, 0.0f, tree_type, 6);
-      break;
+      return bvhtree_from_mesh_edges_create_tree(positions, edges, {}, -1, 0.0f, tree_type, 6);
     }
     case BVHTREE_FROM_FACES: {
-      BLI_assert(!(mesh->totface_legacy == 0 && mesh->faces_num != 0));
-      data->tree = bvhtree_from_mesh_faces_create_tree(
+      BLI_assert(!(mesh.totface_legacy == 0 && mesh.faces_num != 0));
+      return bvhtree_from_mesh_faces_create_tree(
           0.0f,
           tree_type,
           6,
           positions,
-          (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
-          mesh->totface_legacy,
+          (const MFace *)CustomData_get_layer(&mesh.fdata_legacy, CD_MFACE),
+          mesh.totface_legacy,
           {},
           -1);
-      break;
     }
     case BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN: {
-      AttributeAccessor attributes = mesh->attributes();
+      AttributeAccessor attributes = mesh.attributes();
       int mask_bits_act_len = -1;
       const BitVector<> mask = corner_tris_no_hidden_map_get(
-          mesh->faces(),
+          mesh.faces(),
           *attributes.lookup_or_default(".hide_poly", AttrDomain::Face, false),
           corner_tris.size(),
           &mask_bits_act_len);
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      return bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, mask, mask_bits_act_len);
-      break;
     }
     case BVHTREE_FROM_CORNER_TRIS: {
-      data->tree = bvhtree_from_mesh_corner_tris_create_tree(
+      return bvhtree_from_mesh_corner_tris_create_tree(
           0.0f, tree_type, 6, positions, corner_verts, corner_tris, {}, -1);
-      break;
     }
     case BVHTREE_MAX_ITEM:
       BLI_assert_unreachable();
       break;
   }
+  return nullptr;
+}
+
+/**
+ * Trees that don't depend on the hidden or loose state of elements are shared between copies of
+ * the mesh, see #MeshRuntime::bvh_cache_verts.
+ */
+static blender::SharedCache<blender::BVHTreePtr> *mesh_shared_bvh_cache_get(
+    blender::bke::MeshRuntime &runtime, const BVHCacheType bvh_cache_type)
+{
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      return &runtime.bvh_cache_verts;
+    case BVHTREE_FROM_EDGES:
+      return &runtime.bvh_cache_edges;
+    case BVHTREE_FROM_CORNER_TRIS:
+      return &runtime.bvh_cache_corner_tris;
+    default:
+      return nullptr;
+  }
+}
+
+BVHTree *BKE_bvhtree_from_mesh_get(BVHTreeFromMesh *data,
+                                   const Mesh *mesh,
+                                   const BVHCacheType bvh_cache_type,
+                                   const int tree_type)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime->bvh_cache;
+
+  Span<int3> corner_tris;
+  if (ELEM(bvh_cache_type, BVHTREE_FROM_CORNER_TRIS, BVHTREE_FROM_CORNER_TRIS_NO_HIDDEN)) {
+    corner_tris = mesh->corner_tris();
+  }
+
+  const Span<float3> positions = mesh->vert_positions();
+  const Span<int2> edges = mesh->edges();
+  const Span<int> corner_verts = mesh->corner_verts();
+
+  /* Setup BVHTreeFromMesh */
+  bvhtree_from_mesh_setup_data(nullptr,
+                               bvh_cache_type,
+                               positions,
+                               edges,
+                               corner_verts,
+                               corner_tris,
+                               (const MFace *)CustomData_get_layer(&mesh->fdata_legacy, CD_MFACE),
+                               data);
+
+  if (SharedCache<BVHTreePtr> *tree_cache = mesh_shared_bvh_cache_get(*mesh->runtime,
+                                                                      bvh_cache_type))
+  {
+    tree_cache->ensure([&](BVHTreePtr &r_tree) {
+      r_tree.reset(mesh_bvhtree_create(
+          *mesh, bvh_cache_type, tree_type, positions, edges, corner_verts, corner_tris));
+      bvhtree_balance(r_tree.get(), false);
+    });
+    /* NOTE: #data->tree can be nullptr. */
+    data->tree = tree_cache->data().get();
+    data->cached = true;
+    return data->tree;
+  }
+
+  bool lock_started = false;
+  data->cached = bvhcache_find(
+      bvh_cache_p, bvh_cache_type, &data->tree, &lock_started, &mesh->runtime->eval_mutex);
+
+  if (data->cached) {
+    BLI_assert(lock_started == false);
+
+    /* NOTE: #data->tree can be nullptr. */
+    return data->tree;
+  }
+
+  /* Create BVHTree. */
+  data->tree = mesh_bvhtree_create(
+      *mesh, bvh_cache_type, tree_type, positions, edges, corner_verts, corner_tris);
 
   bvhtree_balance(data->tree, lock_started);
 
@@ -1172,30 +1210,47 @@ void free_bvhtree_from_mesh(BVHTreeFromMesh *data)
 /** \name Point Cloud BVH Building
  * \{ */
 
-void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
-                                     const blender::IndexMask &points_mask,
-                                     BVHTreeFromPointCloud &r_data)
+static BVHTree *pointcloud_bvhtree_create(const Span<float3> positions,
+                                          const blender::IndexMask &points_mask)
 {
   int active_num = -1;
   BVHTree *tree = bvhtree_new_common(0.0f, 2, 6, points_mask.size(), active_num);
-  r_data.tree = tree;
   if (!tree) {
-    return;
+    return nullptr;
   }
-
-  const Span<float3> positions = pointcloud.positions();
   points_mask.foreach_index([&](const int i) { BLI_bvhtree_insert(tree, i, positions[i], 1); });
-
   BLI_bvhtree_balance(tree);
+  return tree;
+}
+
+void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
+                                     const blender::IndexMask &points_mask,
+                                     BVHTreeFromPointCloud &r_data)
+{
+  using namespace blender;
+  const Span<float3> positions = pointcloud.positions();
 
   r_data.coords = (const float(*)[3])positions.data();
-  r_data.tree = tree;
   r_data.nearest_callback = nullptr;
+
+  if (points_mask.size() == pointcloud.totpoint) {
+    /* The tree of all points is shared between copies of the point cloud. */
+    SharedCache<BVHTreePtr> &tree_cache = pointcloud.runtime->bvh_cache;
+    tree_cache.ensure([&](BVHTreePtr &r_tree) {
+      r_tree.reset(pointcloud_bvhtree_create(positions, points_mask));
+    });
+    r_data.tree = tree_cache.data().get();
+    r_data.cached = true;
+    return;
+  }
+
+  r_data.tree = pointcloud_bvhtree_create(positions, points_mask);
+  r_data.cached = false;
 }
 
 void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data)
 {
-  if (data->tree) {
+  if (data->tree && !data->cached) {
     BLI_bvhtree_free(data->tree);
   }
   memset(data, 0, sizeof(*data));
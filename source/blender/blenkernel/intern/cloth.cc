@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DEG_depsgraph.hh"
@@ -120,7 +121,6 @@ static BVHTree *bvhtree_build_from_cloth(ClothModifierData *clmd, float epsilon)
 
 void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
 {
-  uint i = 0;
   Cloth *cloth = clmd->clothObject;
   BVHTree *bvhtree;
   ClothVertex *verts = cloth->verts;
@@ -140,39 +140,40 @@ void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
 
   const blender::int3 *vert_tris = cloth->vert_tris;
 
+  /* The leaves are independent, so they are updated in parallel before the branches are joined.
+   * Primitives that don't fit into the tree are skipped. */
+  const blender::IndexRange primitives(
+      std::min(int(cloth->primitive_num), BLI_bvhtree_get_len(bvhtree)));
+
   /* update vertex position in bvh tree */
   if (clmd->hairdata == nullptr) {
     if (verts && vert_tris) {
-      for (i = 0; i < cloth->primitive_num; i++) {
-        float co[3][3], co_moving[3][3];
-        bool ret;
-
-        /* copy new locations into array */
-        if (moving) {
-          copy_v3_v3(co[0], verts[vert_tris[i][0]].txold);
-          copy_v3_v3(co[1], verts[vert_tris[i][1]].txold);
-          copy_v3_v3(co[2], verts[vert_tris[i][2]].txold);
-
-          /* update moving positions */
-          copy_v3_v3(co_moving[0], verts[vert_tris[i][0]].tx);
-          copy_v3_v3(co_moving[1], verts[vert_tris[i][1]].tx);
-          copy_v3_v3(co_moving[2], verts[vert_tris[i][2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], co_moving[0], 3);
-        }
-        else {
-          copy_v3_v3(co[0], verts[vert_tris[i][0]].tx);
-          copy_v3_v3(co[1], verts[vert_tris[i][1]].tx);
-          copy_v3_v3(co[2], verts[vert_tris[i][2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 3);
-        }
+      blender::threading::parallel_for(primitives, 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          float co[3][3], co_moving[3][3];
+
+          /* copy new locations into array */
+          if (moving) {
+            copy_v3_v3(co[0], verts[vert_tris[i][0]].txold);
+            copy_v3_v3(co[1], verts[vert_tris[i][1]].txold);
+            copy_v3_v3(co[2], verts[vert_tris[i][2]].txold);
+
+            /* update moving positions */
+            copy_v3_v3(co_moving[0], verts[vert_tris[i][0]].tx);
+            copy_v3_v3(co_moving[1], verts[vert_tris[i][1]].tx);
+            copy_v3_v3(co_moving[2], verts[vert_tris[i][2]].tx);
+
+            BLI_bvhtree_update_node(bvhtree, int(i), co[0], co_moving[0], 3);
+          }
+          else {
+            copy_v3_v3(co[0], verts[vert_tris[i][0]].tx);
+            copy_v3_v3(co[1], verts[vert_tris[i][1]].tx);
+            copy_v3_v3(co[2], verts[vert_tris[i][2]].tx);
 
-        /* check if tree is already full */
-        if (ret == false) {
-          break;
+            BLI_bvhtree_update_node(bvhtree, int(i), co[0], nullptr, 3);
+          }
         }
-      }
+      });
 
       BLI_bvhtree_update_tree(bvhtree);
     }
@@ -181,16 +182,16 @@ void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
     if (verts) {
       const blender::int2 *edges = reinterpret_cast<const blender::int2 *>(cloth->edges);
 
-      for (i = 0; i < cloth->primitive_num; i++) {
-        float co[2][3];
+      blender::threading::parallel_for(primitives, 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          float co[2][3];
 
-        copy_v3_v3(co[0], verts[edges[i][0]].tx);
-        copy_v3_v3(co[1], verts[edges[i][1]].tx);
+          copy_v3_v3(co[0], verts[edges[i][0]].tx);
+          copy_v3_v3(co[1], verts[edges[i][1]].tx);
 
-        if (!BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 2)) {
-          break;
+          BLI_bvhtree_update_node(bvhtree, int(i), co[0], nullptr, 2);
         }
-      }
+      });
 
       BLI_bvhtree_update_tree(bvhtree);
     }
@@ -1435,7 +1435,7 @@ bool BKE_collection_object_add_notest(Main *bmain, Collection *collection, Objec
   }
 
   if (BKE_collection_is_in_scene(collection)) {
-    BKE_main_collection_sync(bmain);
+    BKE_main_collection_sync_object_add(bmain, collection, ob);
   }
 
   return true;
@@ -18,6 +18,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -62,22 +63,20 @@ void collision_move_object(CollisionModifierData *collmd,
                            const float prevstep,
                            const bool moving_bvh)
 {
-  uint i = 0;
-
   /* the collider doesn't move this frame */
   if (collmd->is_static) {
-    for (i = 0; i < collmd->mvert_num; i++) {
-      zero_v3(collmd->current_v[i]);
-    }
-
+    memset(collmd->current_v, 0, sizeof(*collmd->current_v) * collmd->mvert_num);
     return;
   }
 
-  for (i = 0; i < collmd->mvert_num; i++) {
-    interp_v3_v3v3(collmd->current_x[i], collmd->x[i], collmd->xnew[i], prevstep);
-    interp_v3_v3v3(collmd->current_xnew[i], collmd->x[i], collmd->xnew[i], step);
-    sub_v3_v3v3(collmd->current_v[i], collmd->current_xnew[i], collmd->current_x[i]);
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(collmd->mvert_num), 4096, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          interp_v3_v3v3(collmd->current_x[i], collmd->x[i], collmd->xnew[i], prevstep);
+          interp_v3_v3v3(collmd->current_xnew[i], collmd->x[i], collmd->xnew[i], step);
+          sub_v3_v3v3(collmd->current_v[i], collmd->current_xnew[i], collmd->current_x[i]);
+        }
+      });
 
   bvhtree_update_from_mvert(collmd->bvhtree,
                             collmd->current_xnew,
@@ -127,33 +126,33 @@ void bvhtree_update_from_mvert(BVHTree *bvhtree,
     moving = false;
   }
 
-  for (int i = 0; i < tri_num; i++) {
-    float co[3][3];
-    bool ret;
-
-    copy_v3_v3(co[0], positions[vert_tris[i][0]]);
-    copy_v3_v3(co[1], positions[vert_tris[i][1]]);
-    copy_v3_v3(co[2], positions[vert_tris[i][2]]);
+  /* The leaves are independent, so they can be updated in parallel before the branches are
+   * joined. Triangles that don't fit into the tree are skipped. */
+  const int update_num = std::min(tri_num, BLI_bvhtree_get_len(bvhtree));
+  blender::threading::parallel_for(
+      blender::IndexRange(update_num), 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          float co[3][3];
 
-    /* copy new locations into array */
-    if (moving) {
-      float co_moving[3][3];
-      /* update moving positions */
-      copy_v3_v3(co_moving[0], positions_moving[vert_tris[i][0]]);
-      copy_v3_v3(co_moving[1], positions_moving[vert_tris[i][1]]);
-      copy_v3_v3(co_moving[2], positions_moving[vert_tris[i][2]]);
+          copy_v3_v3(co[0], positions[vert_tris[i][0]]);
+          copy_v3_v3(co[1], positions[vert_tris[i][1]]);
+          copy_v3_v3(co[2], positions[vert_tris[i][2]]);
 
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], &co_moving[0][0], 3);
-    }
-    else {
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], nullptr, 3);
-    }
+          /* copy new locations into array */
+          if (moving) {
+            float co_moving[3][3];
+            /* update moving positions */
+            copy_v3_v3(co_moving[0], positions_moving[vert_tris[i][0]]);
+            copy_v3_v3(co_moving[1], positions_moving[vert_tris[i][1]]);
+            copy_v3_v3(co_moving[2], positions_moving[vert_tris[i][2]]);
 
-    /* check if tree is already full */
-    if (ret == false) {
-      break;
-    }
-  }
+            BLI_bvhtree_update_node(bvhtree, int(i), &co[0][0], &co_moving[0][0], 3);
+          }
+          else {
+            BLI_bvhtree_update_node(bvhtree, int(i), &co[0][0], nullptr, 3);
+          }
+        }
+      });
 
   BLI_bvhtree_update_tree(bvhtree);
 }
@@ -742,10 +742,115 @@ Span<float3> CurvesGeometry::evaluated_positions() const
   return runtime.evaluated_position_cache.data();
 }
 
+/**
+ * Align the first and last tangents of a non-cyclic Bezier curve with the inner handles.
+ */
+static void align_bezier_end_tangents(const Span<float3> positions,
+                                      const Span<float3> handles_left,
+                                      const Span<float3> handles_right,
+                                      MutableSpan<float3> tangents)
+{
+  const float epsilon = 1e-6f;
+  if (!math::almost_equal_relative(handles_right.first(), positions.first(), epsilon)) {
+    tangents.first() = math::normalize(handles_right.first() - positions.first());
+  }
+  if (!math::almost_equal_relative(handles_left.last(), positions.last(), epsilon)) {
+    tangents.last() = math::normalize(positions.last() - handles_left.last());
+  }
+}
+
+/**
+ * Evaluate the positions and the tangents of all curves in a single pass over chunks of curves,
+ * so that the tangents are computed while the evaluated positions of a curve are still in the CPU
+ * cache. This gives the same result as computing the evaluated positions and tangents separately.
+ */
+static void evaluate_positions_and_tangents(const CurvesGeometry &curves,
+                                            MutableSpan<float3> evaluated_positions,
+                                            MutableSpan<float3> tangents)
+{
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const OffsetIndices<int> evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const VArray<int8_t> types = curves.curve_types();
+  const VArray<bool> cyclic = curves.cyclic();
+  const VArray<int> resolution = curves.resolution();
+  const Span<float3> positions = curves.positions();
+  const Span<float3> handles_left = curves.handle_positions_left();
+  const Span<float3> handles_right = curves.handle_positions_right();
+  const bool has_handles = !handles_left.is_empty() && !handles_right.is_empty();
+  const Span<int> all_bezier_offsets =
+      curves.runtime->evaluated_offsets_cache.data().all_bezier_offsets;
+  const Span<curves::nurbs::BasisCache> nurbs_basis_cache =
+      curves.runtime->nurbs_basis_cache.data();
+  const VArray<int8_t> nurbs_orders = curves.nurbs_orders();
+  const Span<float> nurbs_weights = curves.nurbs_weights();
+
+  threading::parallel_for(curves.curves_range(), 128, [&](const IndexRange curves_range) {
+    for (const int curve_index : curves_range) {
+      const IndexRange points = points_by_curve[curve_index];
+      const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
+      const bool is_cyclic = cyclic[curve_index];
+      MutableSpan<float3> curve_positions = evaluated_positions.slice(evaluated_points);
+      MutableSpan<float3> curve_tangents = tangents.slice(evaluated_points);
+
+      const CurveType type = CurveType(types[curve_index]);
+      switch (type) {
+        case CURVE_TYPE_CATMULL_ROM:
+          curves::catmull_rom::interpolate_to_evaluated(
+              positions.slice(points), is_cyclic, resolution[curve_index], curve_positions);
+          break;
+        case CURVE_TYPE_POLY:
+          curve_positions.copy_from(positions.slice(points));
+          break;
+        case CURVE_TYPE_BEZIER: {
+          if (!has_handles) {
+            curve_positions.fill(float3(0));
+            break;
+          }
+          const IndexRange offsets = curves::per_curve_point_offsets_range(points, curve_index);
+          curves::bezier::calculate_evaluated_positions(positions.slice(points),
+                                                        handles_left.slice(points),
+                                                        handles_right.slice(points),
+                                                        all_bezier_offsets.slice(offsets),
+                                                        curve_positions);
+          break;
+        }
+        case CURVE_TYPE_NURBS:
+          curves::nurbs::interpolate_to_evaluated(nurbs_basis_cache[curve_index],
+                                                  nurbs_orders[curve_index],
+                                                  nurbs_weights.slice_safe(points),
+                                                  positions.slice(points),
+                                                  curve_positions);
+          break;
+      }
+
+      curves::poly::calculate_tangents(curve_positions, is_cyclic, curve_tangents);
+      if (type == CURVE_TYPE_BEZIER && has_handles && !is_cyclic) {
+        align_bezier_end_tangents(positions.slice(points),
+                                  handles_left.slice(points),
+                                  handles_right.slice(points),
+                                  curve_tangents);
+      }
+    }
+  });
+}
+
 Span<float3> CurvesGeometry::evaluated_tangents() const
 {
   const CurvesGeometryRuntime &runtime = *this->runtime;
   runtime.evaluated_tangent_cache.ensure([&](Vector<float3> &r_data) {
+    if (runtime.evaluated_position_cache.is_dirty() && !this->is_single_type(CURVE_TYPE_POLY)) {
+      /* The evaluated positions are needed for the tangents anyway, so fill both caches at once
+       * instead of iterating over all evaluated points twice. */
+      this->ensure_nurbs_basis_cache();
+      Vector<float3> evaluated_positions(this->evaluated_points_num());
+      r_data.resize(this->evaluated_points_num());
+      evaluate_positions_and_tangents(*this, evaluated_positions, r_data);
+      /* Another thread may have computed the same positions in the mean time. */
+      runtime.evaluated_position_cache.ensure(
+          [&](Vector<float3> &r_positions) { r_positions = std::move(evaluated_positions); });
+      return;
+    }
+
     const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
     const Span<float3> evaluated_positions = this->evaluated_positions();
     const VArray<bool> cyclic = this->cyclic();
@@ -779,20 +884,10 @@ Span<float3> CurvesGeometry::evaluated_tangents() const
         }
         const IndexRange points = points_by_curve[curve_index];
         const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
-
-        const float epsilon = 1e-6f;
-        if (!math::almost_equal_relative(
-                handles_right[points.first()], positions[points.first()], epsilon))
-        {
-          tangents[evaluated_points.first()] = math::normalize(handles_right[points.first()] -
-                                                               positions[points.first()]);
-        }
-        if (!math::almost_equal_relative(
-                handles_left[points.last()], positions[points.last()], epsilon))
-        {
-          tangents[evaluated_points.last()] = math::normalize(positions[points.last()] -
-                                                              handles_left[points.last()]);
-        }
+        align_bezier_end_tangents(positions.slice(points),
+                                  handles_left.slice(points),
+                                  handles_right.slice(points),
+                                  tangents.slice(evaluated_points));
       });
     }
   });
@@ -1094,9 +1189,7 @@ static void translate_positions(MutableSpan<float3> positions, const float3 &tra
 static void transform_positions(MutableSpan<float3> positions, const float4x4 &matrix)
 {
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &position : positions.slice(range)) {
-      position = math::transform_point(matrix, position);
-    }
+    math::transform_points(matrix, positions.slice(range));
   });
 }
 
@@ -313,6 +313,50 @@ TEST(curves_geometry, BezierPositionEvaluation)
   }
 }
 
+static CurvesGeometry create_mixed_type_curves()
+{
+  CurvesGeometry curves = create_basic_curves(20, 5);
+  MutableSpan<int8_t> types = curves.curve_types_for_write();
+  types[0] = CURVE_TYPE_CATMULL_ROM;
+  types[1] = CURVE_TYPE_POLY;
+  types[2] = CURVE_TYPE_BEZIER;
+  types[3] = CURVE_TYPE_NURBS;
+  types[4] = CURVE_TYPE_BEZIER;
+  curves.update_curve_types();
+  curves.cyclic_for_write().fill(false);
+  curves.cyclic_for_write()[4] = true;
+  curves.resolution_for_write().fill(5);
+  curves.nurbs_orders_for_write().fill(3);
+  const Span<float3> positions = curves.positions();
+  MutableSpan<float3> handles_left = curves.handle_positions_left_for_write();
+  MutableSpan<float3> handles_right = curves.handle_positions_right_for_write();
+  for (const int i : curves.points_range()) {
+    handles_left[i] = positions[i] + float3(-0.3f, 0.2f, 0.1f);
+    handles_right[i] = positions[i] + float3(0.3f, -0.2f, 0.4f);
+  }
+  curves.tag_topology_changed();
+  return curves;
+}
+
+TEST(curves_geometry, PositionsAndTangentsEvaluatedTogether)
+{
+  /* Evaluating the tangents first computes the positions in the same pass. */
+  const CurvesGeometry curves_a = create_mixed_type_curves();
+  const Span<float3> tangents_a = curves_a.evaluated_tangents();
+  const Span<float3> positions_a = curves_a.evaluated_positions();
+
+  const CurvesGeometry curves_b = create_mixed_type_curves();
+  const Span<float3> positions_b = curves_b.evaluated_positions();
+  const Span<float3> tangents_b = curves_b.evaluated_tangents();
+
+  ASSERT_EQ(positions_a.size(), positions_b.size());
+  ASSERT_EQ(tangents_a.size(), tangents_b.size());
+  for (const int i : positions_a.index_range()) {
+    EXPECT_V3_NEAR(positions_a[i], positions_b[i], 1e-6f);
+    EXPECT_V3_NEAR(tangents_a[i], tangents_b[i], 1e-6f);
+  }
+}
+
 TEST(curves_geometry, NURBSEvaluation)
 {
   CurvesGeometry curves(4, 1);
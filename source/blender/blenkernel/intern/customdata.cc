@@ -35,6 +35,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -2478,6 +2479,8 @@ static bool customdata_merge_internal(const CustomData *source,
                                                                 sharing_info_to_assign,
                                                                 totelem,
                                                                 src_layer.name);
+    /* Keep the named layer lookup above valid. */
+    CustomData_update_typemap(dest);
 
     new_layer->uid = src_layer.uid;
     new_layer->flag |= src_layer_flag & (CD_FLAG_EXTERNAL | CD_FLAG_IN_MEMORY);
@@ -2831,11 +2834,14 @@ int CustomData_get_named_layer_index(const CustomData *data,
                                      const eCustomDataType type,
                                      const StringRef name)
 {
-  for (int i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].type == type) {
-      if (data->layers[i].name == name) {
-        return i;
-      }
+  /* Layers are ordered by type, so only the layers of the type have to be checked. */
+  const int type_start = CustomData_get_layer_index(data, type);
+  if (type_start == -1) {
+    return -1;
+  }
+  for (int i = type_start; i < data->totlayer && data->layers[i].type == type; i++) {
+    if (data->layers[i].name == name) {
+      return i;
     }
   }
 
@@ -3575,6 +3581,53 @@ void CustomData_copy_data(const CustomData *source,
   }
 }
 
+void CustomData_copy_data_map(const CustomData *source,
+                              CustomData *dest,
+                              const blender::Span<int> dest_indices)
+{
+  using namespace blender;
+  /* Match the layers the same way as #CustomData_copy_data. */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      return;
+    }
+    if (dest->layers[dest_i].type != source->layers[src_i].type) {
+      continue;
+    }
+
+    const CustomDataLayer &src_layer = source->layers[src_i];
+    CustomDataLayer &dst_layer = dest->layers[dest_i];
+    dest_i++;
+    BLI_assert(layer_is_mutable(dst_layer));
+    if (!src_layer.data || !dst_layer.data) {
+      continue;
+    }
+
+    const LayerTypeInfo *typeInfo = layerType_getInfo(eCustomDataType(src_layer.type));
+    const size_t size = typeInfo->size;
+    threading::parallel_for(dest_indices.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t src_index : range) {
+        const int dst_index = dest_indices[src_index];
+        if (dst_index < 0) {
+          continue;
+        }
+        const void *src_elem = POINTER_OFFSET(src_layer.data, size_t(src_index) * size);
+        void *dst_elem = POINTER_OFFSET(dst_layer.data, size_t(dst_index) * size);
+        if (typeInfo->copy) {
+          typeInfo->copy(src_elem, dst_elem, 1);
+        }
+        else {
+          memcpy(dst_elem, src_elem, size);
+        }
+      }
+    });
+  }
+}
+
 void CustomData_copy_layer_type_data(const CustomData *source,
                                      CustomData *destination,
                                      const eCustomDataType type,
@@ -11,15 +11,31 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bounds.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_editmesh.hh"
 #include "BKE_editmesh_cache.hh" /* own include */
 
 using blender::float3;
+using blender::IndexRange;
+using blender::MutableSpan;
 using blender::Span;
 
+/** Faces are processed in parallel with the face table, so the results can be written by index. */
+static void editmesh_faces_foreach_parallel(BMesh &bm,
+                                            const blender::FunctionRef<void(int, BMFace &)> fn)
+{
+  BM_mesh_elem_table_ensure(&bm, BM_FACE);
+  blender::threading::parallel_for(IndexRange(bm.totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      fn(i, *bm.ftable[i]);
+    }
+  });
+}
+
 /* -------------------------------------------------------------------- */
 /** \name Ensure Data (derived from coords)
  * \{ */
@@ -34,15 +50,12 @@ Span<float3> BKE_editmesh_cache_ensure_face_normals(BMEditMesh &em,
 
   emd.face_normals.reinitialize(bm->totface);
 
-  BM_mesh_elem_index_ensure(bm, BM_VERT);
-  BMFace *efa;
-  BMIter fiter;
-  int i;
-  BM_ITER_MESH_INDEX (efa, &fiter, bm, BM_FACES_OF_MESH, i) {
-    BM_elem_index_set(efa, i); /* set_inline */
-    BM_face_calc_normal_vcos(bm, efa, emd.face_normals[i], emd.vert_positions);
-  }
-  bm->elem_index_dirty &= ~BM_FACE;
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_FACE);
+  const Span<float3> vert_positions = emd.vert_positions;
+  MutableSpan<float3> face_normals = emd.face_normals;
+  editmesh_faces_foreach_parallel(*bm, [&](const int i, BMFace &efa) {
+    BM_face_calc_normal_vcos(bm, &efa, face_normals[i], vert_positions);
+  });
   return emd.face_normals;
 }
 
@@ -74,19 +87,18 @@ Span<float3> BKE_editmesh_cache_ensure_face_centers(BMEditMesh &em,
 
   emd.face_centers.reinitialize(bm->totface);
 
-  BMFace *efa;
-  BMIter fiter;
-  int i;
+  MutableSpan<float3> face_centers = emd.face_centers;
   if (emd.vert_positions.is_empty()) {
-    BM_ITER_MESH_INDEX (efa, &fiter, bm, BM_FACES_OF_MESH, i) {
-      BM_face_calc_center_median(efa, emd.face_centers[i]);
-    }
+    editmesh_faces_foreach_parallel(*bm, [&](const int i, BMFace &efa) {
+      BM_face_calc_center_median(&efa, face_centers[i]);
+    });
   }
   else {
     BM_mesh_elem_index_ensure(bm, BM_VERT);
-    BM_ITER_MESH_INDEX (efa, &fiter, bm, BM_FACES_OF_MESH, i) {
-      BM_face_calc_center_median_vcos(bm, efa, emd.face_centers[i], emd.vert_positions);
-    }
+    const Span<float3> vert_positions = emd.vert_positions;
+    editmesh_faces_foreach_parallel(*bm, [&](const int i, BMFace &efa) {
+      BM_face_calc_center_median_vcos(bm, &efa, face_centers[i], vert_positions);
+    });
   }
   return emd.face_centers;
 }
@@ -50,6 +50,8 @@
 #include "RNA_access.hh"
 #include "RNA_path.hh"
 
+#include "atomic_ops.h"
+
 #include "CLG_log.h"
 
 #define SMALL -1.0e-10
@@ -2076,6 +2078,35 @@ static float fcurve_eval_keyframes_extrapolate(const FCurve *fcu,
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Find the keyframe that the evaluation time occurs before, like
+ * #BKE_fcurve_bezt_binarysearch_index_ex. During playback the time mostly advances slowly, so the
+ * segment of the previous evaluation or the one after it are checked before searching.
+ */
+static int fcurve_bezt_segment_find(const FCurve *fcu,
+                                    const BezTriple *bezts,
+                                    const float evaltime,
+                                    const float threshold,
+                                    bool *r_exact)
+{
+  const int totvert = int(fcu->totvert);
+  const int hint = atomic_load_int32(&fcu->eval_segment_hint);
+  for (const int a : {hint, hint + 1}) {
+    if (a >= 1 && a < totvert && evaltime - bezts[a - 1].vec[1][0] > threshold &&
+        bezts[a].vec[1][0] - evaltime > threshold)
+    {
+      *r_exact = false;
+      return a;
+    }
+  }
+
+  const int a = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, totvert, threshold, r_exact);
+  /* The same curve may be evaluated from multiple threads, the hint is only an optimization. */
+  atomic_store_int32(&const_cast<FCurve *>(fcu)->eval_segment_hint, a);
+  return a;
+}
+
 static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
                                                const BezTriple *bezts,
                                                float evaltime)
@@ -2096,7 +2127,7 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_bezt_segment_find(fcu, bezts, evaltime, 0.0001, &exact);
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2668,6 +2699,7 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, FCurve *fcu)
      * (old pointer may still be set here). */
     driver->expr_comp = nullptr;
     driver->expr_simple = nullptr;
+    driver->targets_cache = nullptr;
 
     /* Give the driver a fresh chance - the operating environment may be different now
      * (addons, etc. may be different) so the driver namespace may be sane now #32155. */
@@ -16,6 +16,7 @@
 #include "BLI_alloca.h"
 #include "BLI_expr_pylike_eval.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_base_safe.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
@@ -43,6 +44,7 @@
 
 #include "CLG_log.h"
 
+#include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
 
 #ifdef WITH_PYTHON
@@ -146,6 +148,79 @@ bool driver_get_target_property(const DriverTargetContext *driver_target_context
   return true;
 }
 
+/** The RNA path of a driver target, resolved in a previous evaluation. */
+struct DriverTargetResolved {
+  const ID *owner_id;
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int index;
+};
+
+/**
+ * Resolved RNA paths of the targets of an evaluated driver, to avoid parsing the paths and looking
+ * up the properties every time the driver is evaluated.
+ */
+struct DriverTargetsCache {
+  const Depsgraph *depsgraph = nullptr;
+  /** The #DEG_get_copy_on_eval_count when the paths were resolved. */
+  uint64_t copy_on_eval_count = 0;
+  blender::Map<const DriverTarget *, DriverTargetResolved> targets;
+};
+
+static void driver_targets_cache_free(ChannelDriver *driver)
+{
+  MEM_delete(driver->targets_cache);
+  driver->targets_cache = nullptr;
+}
+
+/**
+ * Resolve the RNA path of the target, from the cache of the driver when possible. Only paths of
+ * evaluated data are cached, which the depsgraph doesn't free while its copy-on-eval count stays
+ * the same.
+ */
+static bool dtar_resolve_path_cached(const AnimationEvalContext *anim_eval_context,
+                                     ChannelDriver *driver,
+                                     const DriverTarget *dtar,
+                                     PointerRNA *property_ptr,
+                                     PointerRNA *r_ptr,
+                                     PropertyRNA **r_prop,
+                                     int *r_index)
+{
+  const Depsgraph *depsgraph = anim_eval_context->depsgraph;
+  if (depsgraph == nullptr || !DEG_is_evaluated_id(property_ptr->owner_id)) {
+    return RNA_path_resolve_property_full(property_ptr, dtar->rna_path, r_ptr, r_prop, r_index);
+  }
+
+  if (driver->targets_cache == nullptr) {
+    driver->targets_cache = MEM_new<DriverTargetsCache>(__func__);
+  }
+  DriverTargetsCache &cache = *driver->targets_cache;
+  const uint64_t copy_on_eval_count = DEG_get_copy_on_eval_count(depsgraph);
+  if (cache.depsgraph != depsgraph || cache.copy_on_eval_count != copy_on_eval_count) {
+    cache.depsgraph = depsgraph;
+    cache.copy_on_eval_count = copy_on_eval_count;
+    cache.targets.clear();
+  }
+
+  if (const DriverTargetResolved *resolved = cache.targets.lookup_ptr(dtar)) {
+    if (resolved->owner_id == property_ptr->owner_id) {
+      *r_ptr = resolved->ptr;
+      *r_prop = resolved->prop;
+      *r_index = resolved->index;
+      return true;
+    }
+  }
+
+  if (!RNA_path_resolve_property_full(property_ptr, dtar->rna_path, r_ptr, r_prop, r_index)) {
+    return false;
+  }
+  /* Data of other IDs may be replaced during evaluation, like the evaluated object data. */
+  if (r_ptr->owner_id == property_ptr->owner_id) {
+    cache.targets.add_overwrite(dtar, {property_ptr->owner_id, *r_ptr, *r_prop, *r_index});
+  }
+  return true;
+}
+
 /**
  * Checks if the fallback value can be used, and if so, sets dtar flags to signal its usage.
  * The caller is expected to immediately return the fallback value if this returns true.
@@ -198,8 +273,8 @@ static float dtar_get_prop_val(const AnimationEvalContext *anim_eval_context,
   PropertyRNA *value_prop;
   int index = -1;
   float value = 0.0f;
-  if (!RNA_path_resolve_property_full(
-          &property_ptr, dtar->rna_path, &value_ptr, &value_prop, &index))
+  if (!dtar_resolve_path_cached(
+          anim_eval_context, driver, dtar, &property_ptr, &value_ptr, &value_prop, &index))
   {
     if (dtar_try_use_fallback(dtar)) {
       return dtar->fallback_value;
@@ -886,6 +961,7 @@ void driver_free_variable_ex(ChannelDriver *driver, DriverVar *dvar)
 
   /* Since driver variables are cached, the expression needs re-compiling too. */
   BKE_driver_invalidate_expression(driver, false, true);
+  driver_targets_cache_free(driver);
 }
 
 void driver_variables_copy(ListBase *dst_vars, const ListBase *src_vars)
@@ -1066,6 +1142,7 @@ void fcurve_free_driver(FCurve *fcu)
 #endif
 
   BLI_expr_pylike_free(driver->expr_simple);
+  driver_targets_cache_free(driver);
 
   /* Free driver itself, then set F-Curve's point to this to nullptr
    * (as the curve may still be used). */
@@ -1086,6 +1163,7 @@ ChannelDriver *fcurve_copy_driver(const ChannelDriver *driver)
   ndriver = static_cast<ChannelDriver *>(MEM_dupallocN(driver));
   ndriver->expr_comp = nullptr;
   ndriver->expr_simple = nullptr;
+  ndriver->targets_cache = nullptr;
 
   /* Copy variables. */
 
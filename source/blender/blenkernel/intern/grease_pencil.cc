@@ -362,7 +362,68 @@ Drawing::~Drawing()
   this->runtime = nullptr;
 }
 
-Span<uint3> Drawing::triangles() const
+/**
+ * Fill the offsets of the triangles of every curve in the triangle buffer of a drawing and return
+ * the total number of triangles. Curves with less than three points have no triangles.
+ */
+static int calc_triangle_offsets(const OffsetIndices<int> points_by_curve,
+                                 MutableSpan<int> r_offsets)
+{
+  int total_triangles = 0;
+  for (const int curve_i : points_by_curve.index_range()) {
+    const IndexRange points = points_by_curve[curve_i];
+    r_offsets[curve_i] = total_triangles;
+    if (points.size() > 2) {
+      total_triangles += points.size() - 2;
+    }
+  }
+  return total_triangles;
+}
+
+static void calc_curve_plane_normals(const Span<float3> positions,
+                                     const OffsetIndices<int> points_by_curve,
+                                     const IndexMask &curve_mask,
+                                     MutableSpan<float3> r_normals)
+{
+  curve_mask.foreach_index(GrainSize(512), [&](const int curve_i) {
+    const IndexRange points = points_by_curve[curve_i];
+    if (points.size() < 2) {
+      r_normals[curve_i] = float3(1.0f, 0.0f, 0.0f);
+      return;
+    }
+
+    /* Calculate normal using Newell's method. */
+    float3 normal(0.0f);
+    float3 prev_point = positions[points.last()];
+    for (const int point_i : points) {
+      const float3 curr_point = positions[point_i];
+      add_newell_cross_v3_v3v3(normal, prev_point, curr_point);
+      prev_point = curr_point;
+    }
+
+    float length;
+    normal = math::normalize_and_get_length(normal, length);
+    /* Check for degenerate case where the points are on a line. */
+    if (math::is_zero(length)) {
+      for (const int point_i : points.drop_back(1)) {
+        float3 segment_vec = positions[point_i] - positions[point_i + 1];
+        if (math::length_squared(segment_vec) != 0.0f) {
+          normal = math::normalize(float3(segment_vec.y, -segment_vec.x, 0.0f));
+          break;
+        }
+      }
+    }
+
+    r_normals[curve_i] = normal;
+  });
+}
+
+static void triangulate_curves(const Span<float3> positions,
+                               const OffsetIndices<int> points_by_curve,
+                               const Span<float3> normals,
+                               const Span<int> tris_offsets,
+                               const IndexMask &curve_mask,
+                               MutableSpan<uint3> r_triangles)
 {
   struct LocalMemArena {
     MemArena *pf_arena = nullptr;
@@ -375,54 +436,52 @@ Span<uint3> Drawing::triangles() const
       }
     }
   };
-  this->runtime->triangles_cache.ensure([&](Vector<uint3> &r_data) {
-    const CurvesGeometry &curves = this->strokes();
-    const Span<float3> positions = curves.positions();
-    const Span<float3> normals = this->curve_plane_normals();
-    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
-
-    int total_triangles = 0;
-    Array<int> tris_offests(curves.curves_num());
-    for (int curve_i : curves.curves_range()) {
-      IndexRange points = points_by_curve[curve_i];
-      if (points.size() > 2) {
-        tris_offests[curve_i] = total_triangles;
-        total_triangles += points.size() - 2;
+  threading::EnumerableThreadSpecific<LocalMemArena> all_local_mem_arenas;
+  curve_mask.foreach_segment(GrainSize(32), [&](const IndexMaskSegment segment) {
+    MemArena *pf_arena = all_local_mem_arenas.local().pf_arena;
+    for (const int curve_i : segment) {
+      const IndexRange points = points_by_curve[curve_i];
+      if (points.size() < 3) {
+        continue;
       }
-    }
 
-    r_data.resize(total_triangles);
-    MutableSpan<uint3> triangles = r_data.as_mutable_span();
-    threading::EnumerableThreadSpecific<LocalMemArena> all_local_mem_arenas;
-    threading::parallel_for(curves.curves_range(), 32, [&](const IndexRange range) {
-      MemArena *pf_arena = all_local_mem_arenas.local().pf_arena;
-      for (const int curve_i : range) {
-        const IndexRange points = points_by_curve[curve_i];
-        if (points.size() < 3) {
-          continue;
-        }
+      const int num_triangles = points.size() - 2;
+      MutableSpan<uint3> r_tris = r_triangles.slice(tris_offsets[curve_i], num_triangles);
 
-        const int num_triangles = points.size() - 2;
-        MutableSpan<uint3> r_tris = triangles.slice(tris_offests[curve_i], num_triangles);
+      float(*projverts)[2] = static_cast<float(*)[2]>(
+          BLI_memarena_alloc(pf_arena, sizeof(*projverts) * size_t(points.size())));
 
-        float(*projverts)[2] = static_cast<float(*)[2]>(
-            BLI_memarena_alloc(pf_arena, sizeof(*projverts) * size_t(points.size())));
+      float3x3 axis_mat;
+      axis_dominant_v3_to_m3(axis_mat.ptr(), normals[curve_i]);
 
-        float3x3 axis_mat;
-        axis_dominant_v3_to_m3(axis_mat.ptr(), normals[curve_i]);
+      for (const int i : IndexRange(points.size())) {
+        mul_v2_m3v3(projverts[i], axis_mat.ptr(), positions[points[i]]);
+      }
 
-        for (const int i : IndexRange(points.size())) {
-          mul_v2_m3v3(projverts[i], axis_mat.ptr(), positions[points[i]]);
-        }
+      BLI_polyfill_calc_arena(projverts,
+                              points.size(),
+                              0,
+                              reinterpret_cast<uint32_t(*)[3]>(r_tris.data()),
+                              pf_arena);
+      BLI_memarena_clear(pf_arena);
+    }
+  });
+}
 
-        BLI_polyfill_calc_arena(projverts,
-                                points.size(),
-                                0,
-                                reinterpret_cast<uint32_t(*)[3]>(r_tris.data()),
-                                pf_arena);
-        BLI_memarena_clear(pf_arena);
-      }
-    });
+Span<uint3> Drawing::triangles() const
+{
+  this->runtime->triangles_cache.ensure([&](Vector<uint3> &r_data) {
+    const CurvesGeometry &curves = this->strokes();
+    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+
+    Array<int> tris_offsets(curves.curves_num());
+    r_data.resize(calc_triangle_offsets(points_by_curve, tris_offsets));
+    triangulate_curves(curves.positions(),
+                       points_by_curve,
+                       this->curve_plane_normals(),
+                       tris_offsets,
+                       curves.curves_range(),
+                       r_data);
   });
 
   return this->runtime->triangles_cache.data().as_span();
@@ -432,43 +491,9 @@ Span<float3> Drawing::curve_plane_normals() const
 {
   this->runtime->curve_plane_normals_cache.ensure([&](Vector<float3> &r_data) {
     const CurvesGeometry &curves = this->strokes();
-    const Span<float3> positions = curves.positions();
-    const OffsetIndices<int> points_by_curve = curves.points_by_curve();
-
     r_data.reinitialize(curves.curves_num());
-    threading::parallel_for(curves.curves_range(), 512, [&](const IndexRange range) {
-      for (const int curve_i : range) {
-        const IndexRange points = points_by_curve[curve_i];
-        if (points.size() < 2) {
-          r_data[curve_i] = float3(1.0f, 0.0f, 0.0f);
-          continue;
-        }
-
-        /* Calculate normal using Newell's method. */
-        float3 normal(0.0f);
-        float3 prev_point = positions[points.last()];
-        for (const int point_i : points) {
-          const float3 curr_point = positions[point_i];
-          add_newell_cross_v3_v3v3(normal, prev_point, curr_point);
-          prev_point = curr_point;
-        }
-
-        float length;
-        normal = math::normalize_and_get_length(normal, length);
-        /* Check for degenerate case where the points are on a line. */
-        if (math::is_zero(length)) {
-          for (const int point_i : points.drop_back(1)) {
-            float3 segment_vec = positions[point_i] - positions[point_i + 1];
-            if (math::length_squared(segment_vec) != 0.0f) {
-              normal = math::normalize(float3(segment_vec.y, -segment_vec.x, 0.0f));
-              break;
-            }
-          }
-        }
-
-        r_data[curve_i] = normal;
-      }
-    });
+    calc_curve_plane_normals(
+        curves.positions(), curves.points_by_curve(), curves.curves_range(), r_data);
   });
   return this->runtime->curve_plane_normals_cache.data().as_span();
 }
@@ -749,11 +774,83 @@ void Drawing::tag_positions_changed()
   this->tag_texture_matrices_changed();
 }
 
+void Drawing::tag_positions_changed(const IndexMask &changed_curves)
+{
+  if (changed_curves.is_empty()) {
+    return;
+  }
+  DrawingRuntime &runtime = *this->runtime;
+  if (!runtime.triangles_cache.is_cached() || !runtime.curve_plane_normals_cache.is_cached()) {
+    this->tag_positions_changed();
+    return;
+  }
+  this->strokes_for_write().tag_positions_changed();
+  this->tag_texture_matrices_changed();
+
+  /* The number of points is unchanged, so the triangles of every curve stay at the same place in
+   * the triangle buffer and only the changed curves have to be triangulated again. */
+  const CurvesGeometry &curves = this->strokes();
+  const Span<float3> positions = curves.positions();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  runtime.curve_plane_normals_cache.update([&](Vector<float3> &r_data) {
+    calc_curve_plane_normals(positions, points_by_curve, changed_curves, r_data);
+  });
+  runtime.triangles_cache.update([&](Vector<uint3> &r_data) {
+    Array<int> tris_offsets(curves.curves_num());
+    calc_triangle_offsets(points_by_curve, tris_offsets);
+    triangulate_curves(positions,
+                       points_by_curve,
+                       runtime.curve_plane_normals_cache.data(),
+                       tris_offsets,
+                       changed_curves,
+                       r_data);
+  });
+}
+
 void Drawing::tag_topology_changed()
 {
   this->tag_positions_changed();
 }
 
+void Drawing::tag_topology_changed(const IndexMask &changed_curves)
+{
+  if (changed_curves.is_empty()) {
+    return;
+  }
+  DrawingRuntime &runtime = *this->runtime;
+  const CurvesGeometry &curves = this->strokes();
+  const int first_changed = changed_curves.first();
+  if (!runtime.triangles_cache.is_cached() || !runtime.curve_plane_normals_cache.is_cached() ||
+      runtime.curve_plane_normals_cache.data().size() < first_changed)
+  {
+    this->tag_topology_changed();
+    return;
+  }
+  this->strokes_for_write().tag_positions_changed();
+  this->tag_texture_matrices_changed();
+
+  /* The curves before the first changed curve are unchanged, so their normals and triangles are
+   * still valid. Only the curves after it are processed again, which is cheap while drawing a new
+   * stroke on top of the existing ones. */
+  const Span<float3> positions = curves.positions();
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  const IndexRange curves_to_update = curves.curves_range().drop_front(first_changed);
+  runtime.curve_plane_normals_cache.update([&](Vector<float3> &r_data) {
+    r_data.resize(curves.curves_num());
+    calc_curve_plane_normals(positions, points_by_curve, curves_to_update, r_data);
+  });
+  runtime.triangles_cache.update([&](Vector<uint3> &r_data) {
+    Array<int> tris_offsets(curves.curves_num());
+    r_data.resize(calc_triangle_offsets(points_by_curve, tris_offsets));
+    triangulate_curves(positions,
+                       points_by_curve,
+                       runtime.curve_plane_normals_cache.data(),
+                       tris_offsets,
+                       curves_to_update,
+                       r_data);
+  });
+}
+
 DrawingReference::DrawingReference()
 {
   this->base.type = GP_DRAWING_REFERENCE;
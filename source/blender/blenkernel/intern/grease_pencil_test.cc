@@ -485,4 +485,59 @@ TEST(greasepencil, remove_drawings_with_no_users)
   BKE_id_free(nullptr, grease_pencil);
 }
 
+/* --------------------------------------------------------------------------------------------- */
+/* Drawing Tests. */
+
+static void fill_square_curves(bke::CurvesGeometry &curves, const IndexRange curves_to_fill)
+{
+  const OffsetIndices<int> points_by_curve = curves.points_by_curve();
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int curve_i : curves_to_fill) {
+    const IndexRange points = points_by_curve[curve_i];
+    const float offset = float(curve_i) * 2.0f;
+    positions[points[0]] = float3(offset, 0.0f, 0.0f);
+    positions[points[1]] = float3(offset + 1.0f, 0.0f, 0.0f);
+    positions[points[2]] = float3(offset + 1.0f, 1.0f, 0.0f);
+    positions[points[3]] = float3(offset, 1.0f, 0.0f);
+  }
+}
+
+static void expect_triangles_match_full_update(Drawing &drawing)
+{
+  const Array<uint3> triangles(drawing.triangles());
+  const Array<float3> normals(drawing.curve_plane_normals());
+  drawing.tag_positions_changed();
+  ASSERT_EQ(triangles.size(), drawing.triangles().size());
+  EXPECT_EQ_ARRAY(triangles.data(), drawing.triangles().data(), triangles.size());
+  ASSERT_EQ(normals.size(), drawing.curve_plane_normals().size());
+  EXPECT_EQ_ARRAY(normals.data(), drawing.curve_plane_normals().data(), normals.size());
+}
+
+TEST(greasepencil, drawing_partial_triangles_update)
+{
+  Drawing drawing;
+  bke::CurvesGeometry &curves = drawing.strokes_for_write();
+  curves.resize(12, 3);
+  offset_indices::fill_constant_group_size(4, 0, curves.offsets_for_write());
+  fill_square_curves(curves, curves.curves_range());
+  drawing.tag_topology_changed();
+  EXPECT_EQ(drawing.triangles().size(), 6);
+
+  /* Rotate the second curve into another plane. */
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int point_i : curves.points_by_curve()[1]) {
+    positions[point_i] = float3(positions[point_i].x, 0.0f, positions[point_i].y);
+  }
+  drawing.tag_positions_changed(IndexRange::from_single(1));
+  EXPECT_EQ(drawing.curve_plane_normals()[1].z, 0.0f);
+  expect_triangles_match_full_update(drawing);
+
+  /* Add a new curve at the end, like when drawing a stroke. */
+  curves.resize(16, 4);
+  fill_square_curves(curves, IndexRange::from_single(3));
+  drawing.tag_topology_changed(IndexRange::from_single(3));
+  EXPECT_EQ(drawing.triangles().size(), 8);
+  expect_triangles_match_full_update(drawing);
+}
+
 }  // namespace blender::bke::greasepencil::tests
@@ -252,6 +252,37 @@ Span<InstanceReference> Instances::references() const
   return references_;
 }
 
+static void foreach_instance_recursive_impl(
+    const Instances &instances,
+    const float4x4 &base_transform,
+    Vector<int, 8> &path,
+    const FunctionRef<bool(const NestedInstance &instance)> fn)
+{
+  const Span<InstanceReference> references = instances.references();
+  const Span<int> handles = instances.reference_handles();
+  const Span<float4x4> transforms = instances.transforms();
+  for (const int i : transforms.index_range()) {
+    const InstanceReference &reference = references[handles[i]];
+    const float4x4 transform = base_transform * transforms[i];
+    path.append(i);
+    const bool visit_nested = fn({reference, transform, path});
+    if (visit_nested && reference.type() == InstanceReference::Type::GeometrySet) {
+      if (const Instances *nested_instances = reference.geometry_set().get_instances()) {
+        foreach_instance_recursive_impl(*nested_instances, transform, path, fn);
+      }
+    }
+    path.remove_last();
+  }
+}
+
+void Instances::foreach_instance_recursive(
+    const float4x4 &base_transform,
+    const FunctionRef<bool(const NestedInstance &instance)> fn) const
+{
+  Vector<int, 8> path;
+  foreach_instance_recursive_impl(*this, base_transform, path, fn);
+}
+
 void Instances::remove(const IndexMask &mask,
                        const AnonymousAttributePropagationInfo &propagation_info)
 {
@@ -1025,6 +1025,38 @@ void BKE_main_view_layers_synced_ensure(const Main *bmain)
   BKE_layer_collection_local_sync_all(bmain);
 }
 
+/** Add the flags the base of an object gets from being in the given layer collection. */
+static void layer_collection_object_base_flags_add(LayerCollection *layer,
+                                                   Base *base,
+                                                   const short collection_restrict,
+                                                   const short layer_restrict)
+{
+  if ((collection_restrict & COLLECTION_HIDE_VIEWPORT) == 0) {
+    base->flag_from_collection |= (BASE_ENABLED_VIEWPORT |
+                                   BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT);
+    if ((layer_restrict & LAYER_COLLECTION_HIDE) == 0) {
+      base->flag_from_collection |= BASE_ENABLED_AND_VISIBLE_IN_DEFAULT_VIEWPORT;
+    }
+    if ((collection_restrict & COLLECTION_HIDE_SELECT) == 0) {
+      base->flag_from_collection |= BASE_SELECTABLE;
+    }
+  }
+
+  if ((collection_restrict & COLLECTION_HIDE_RENDER) == 0) {
+    base->flag_from_collection |= BASE_ENABLED_RENDER;
+  }
+
+  /* Holdout and indirect only */
+  if (layer->flag & LAYER_COLLECTION_HOLDOUT) {
+    base->flag_from_collection |= BASE_HOLDOUT;
+  }
+  if (layer->flag & LAYER_COLLECTION_INDIRECT_ONLY) {
+    base->flag_from_collection |= BASE_INDIRECT_ONLY;
+  }
+
+  layer->runtime_flag |= LAYER_COLLECTION_HAS_OBJECTS;
+}
+
 static void layer_collection_objects_sync(ViewLayer *view_layer,
                                           LayerCollection *layer,
                                           ListBase *r_lb_new_object_bases,
@@ -1066,30 +1098,7 @@ static void layer_collection_objects_sync(ViewLayer *view_layer,
       BLI_addtail(r_lb_new_object_bases, base);
     }
 
-    if ((collection_restrict & COLLECTION_HIDE_VIEWPORT) == 0) {
-      base->flag_from_collection |= (BASE_ENABLED_VIEWPORT |
-                                     BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT);
-      if ((layer_restrict & LAYER_COLLECTION_HIDE) == 0) {
-        base->flag_from_collection |= BASE_ENABLED_AND_VISIBLE_IN_DEFAULT_VIEWPORT;
-      }
-      if ((collection_restrict & COLLECTION_HIDE_SELECT) == 0) {
-        base->flag_from_collection |= BASE_SELECTABLE;
-      }
-    }
-
-    if ((collection_restrict & COLLECTION_HIDE_RENDER) == 0) {
-      base->flag_from_collection |= BASE_ENABLED_RENDER;
-    }
-
-    /* Holdout and indirect only */
-    if (layer->flag & LAYER_COLLECTION_HOLDOUT) {
-      base->flag_from_collection |= BASE_HOLDOUT;
-    }
-    if (layer->flag & LAYER_COLLECTION_INDIRECT_ONLY) {
-      base->flag_from_collection |= BASE_INDIRECT_ONLY;
-    }
-
-    layer->runtime_flag |= LAYER_COLLECTION_HAS_OBJECTS;
+    layer_collection_object_base_flags_add(layer, base, collection_restrict, layer_restrict);
   }
 }
 
@@ -1458,6 +1467,85 @@ void BKE_main_collection_sync(const Main *bmain)
   BKE_layer_collection_local_sync_all(bmain);
 }
 
+/**
+ * Add or update the base of \a ob for every layer collection of \a collection below \a layer,
+ * using the same inherited restrict flags as #layer_collection_sync.
+ */
+static void layer_collection_object_add_sync(ViewLayer *view_layer,
+                                             LayerCollection *layer,
+                                             const Collection *collection,
+                                             Object *ob,
+                                             const short collection_restrict,
+                                             const short layer_restrict,
+                                             const ushort local_collections_bits)
+{
+  if (layer->collection == collection && (layer->flag & LAYER_COLLECTION_EXCLUDE) == 0) {
+    void **base_p;
+    Base *base;
+    if (BLI_ghash_ensure_p(view_layer->object_bases_hash, ob, &base_p)) {
+      base = static_cast<Base *>(*base_p);
+    }
+    else {
+      base = object_base_new(ob);
+      base->local_collections_bits = local_collections_bits;
+      *base_p = base;
+      BLI_addtail(&view_layer->object_bases, base);
+      MEM_SAFE_FREE(view_layer->object_bases_array);
+    }
+    layer_collection_object_base_flags_add(layer, base, collection_restrict, layer_restrict);
+    BKE_base_eval_flags(base);
+  }
+
+  LISTBASE_FOREACH (LayerCollection *, child_layer, &layer->layer_collections) {
+    short child_collection_restrict = collection_restrict;
+    short child_layer_restrict = layer_restrict;
+    if (!(child_layer->collection->flag & COLLECTION_IS_MASTER)) {
+      child_collection_restrict |= child_layer->collection->flag;
+      child_layer_restrict |= child_layer->flag;
+    }
+    layer_collection_object_add_sync(view_layer,
+                                     child_layer,
+                                     collection,
+                                     ob,
+                                     child_collection_restrict,
+                                     child_layer_restrict,
+                                     local_collections_bits & child_layer->local_collections_bits);
+  }
+}
+
+void BKE_main_collection_sync_object_add(const Main *bmain, Collection *collection, Object *ob)
+{
+  if (no_resync > 0) {
+    return;
+  }
+
+  /* Tag linked object as a weak reference, like #layer_collection_objects_sync does. */
+  id_lib_indirect_weak_link(&ob->id);
+
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+      /* Out of sync view layers are fully resynced anyway. */
+      if (view_layer->flag & VIEW_LAYER_OUT_OF_SYNC) {
+        continue;
+      }
+      LayerCollection *master_layer = static_cast<LayerCollection *>(
+          view_layer->layer_collections.first);
+      if (master_layer == nullptr || master_layer->collection != scene->master_collection) {
+        BKE_view_layer_need_resync_tag(view_layer);
+        continue;
+      }
+      if (!view_layer->object_bases_hash) {
+        view_layer_bases_hash_create(view_layer, false);
+      }
+      /* The layer collections of a synced view layer match the collections hierarchy of the
+       * scene, when none uses the collection the view layer is not affected. */
+      layer_collection_object_add_sync(view_layer, master_layer, collection, ob, 0, 0, ~(0));
+    }
+  }
+
+  BKE_layer_collection_local_sync_all(bmain);
+}
+
 void BKE_main_collection_sync_remap(const Main *bmain)
 {
   if (no_resync > 0) {
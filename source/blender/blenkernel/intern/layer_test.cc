@@ -6,8 +6,12 @@
 #include "MEM_guardedalloc.h"
 
 #include "BKE_appdir.hh"
+#include "BKE_collection.hh"
 #include "BKE_idtype.hh"
 #include "BKE_layer.hh"
+#include "BKE_main.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
 
 #include "BLI_string.h"
 
@@ -17,6 +21,9 @@
 
 #include "CLG_log.h"
 
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+
 #include "RNA_access.hh"
 #include "RNA_prototypes.hh"
 
@@ -161,4 +168,40 @@ TEST(view_layer, aov_conflict)
   CLG_exit();
 }
 
+TEST(view_layer, object_add_sync)
+{
+  /* Set Up */
+  CLG_init();
+  BKE_idtype_init();
+
+  Main *bmain = BKE_main_new();
+  Scene *scene = BKE_scene_add(bmain, "Scene");
+  ViewLayer *view_layer = static_cast<ViewLayer *>(scene->view_layers.first);
+  Collection *collection = BKE_collection_add(bmain, scene->master_collection, "Collection");
+  collection->flag |= COLLECTION_HIDE_RENDER;
+  Object *ob = BKE_object_add_only_object(bmain, OB_EMPTY, "Object");
+  BKE_view_layer_synced_ensure(scene, view_layer);
+
+  /* Adding an object to a collection updates the synced view layer in place. */
+  BKE_collection_object_add(bmain, collection, ob);
+  EXPECT_EQ(view_layer->flag & VIEW_LAYER_OUT_OF_SYNC, 0);
+  Base *base = BKE_view_layer_base_find(view_layer, ob);
+  ASSERT_NE(base, nullptr);
+  const short base_flag = base->flag;
+  EXPECT_NE(base_flag & BASE_ENABLED_VIEWPORT, 0);
+  EXPECT_EQ(base_flag & BASE_ENABLED_RENDER, 0);
+
+  /* The result matches a full resync. */
+  BKE_view_layer_need_resync_tag(view_layer);
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  base = BKE_view_layer_base_find(view_layer, ob);
+  ASSERT_NE(base, nullptr);
+  EXPECT_EQ(base->flag, base_flag);
+  EXPECT_EQ(BLI_listbase_count(&view_layer->object_bases), 1);
+
+  /* Tear down */
+  BKE_main_free(bmain);
+  CLG_exit();
+}
+
 }  // namespace blender::bke::tests
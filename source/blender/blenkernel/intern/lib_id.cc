@@ -2166,21 +2166,26 @@ void BKE_library_make_local(Main *bmain,
   /* Step 4: We have to remap local usages of old (linked) ID to new (local)
    * ID in a separated loop,
    * as lbarray ordering is not enough to ensure us we did catch all dependencies
-   * (e.g. if making local a parent object before its child...). See #48907. */
-  /* TODO: This is now the biggest step by far (in term of processing time).
-   * We may be able to gain here by using again main->relations mapping, but...
-   * this implies BKE_libblock_remap & co to be able to update main->relations on the fly.
-   * Have to think about it a bit more, and see whether new code is OK first, anyway. */
+   * (e.g. if making local a parent object before its child...). See #48907.
+   *
+   * All remappings are done in a single pass over Main, this used to be the biggest step by far
+   * (in term of processing time) when remapping each copied ID separately. */
+  IDRemapper id_remapper;
   for (LinkNode *it = copied_ids; it; it = it->next) {
     ID *id = static_cast<ID *>(it->link);
 
     BLI_assert(id->newid != nullptr);
     BLI_assert(ID_IS_LINKED(id));
 
-    BKE_libblock_remap(bmain, id, id->newid, ID_REMAP_SKIP_INDIRECT_USAGE);
+    id_remapper.add(id, id->newid);
     if (old_to_new_ids) {
       BLI_ghash_insert(old_to_new_ids, id, id->newid);
     }
+  }
+  BKE_libblock_remap_multiple(bmain, id_remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
+
+  for (LinkNode *it = copied_ids; it; it = it->next) {
+    ID *id = static_cast<ID *>(it->link);
 
     /* Special hack for groups... Thing is, since we can't instantiate them here, we need to
      * ensure they remain 'alive' (only instantiation is a real group 'user'... *sigh* See
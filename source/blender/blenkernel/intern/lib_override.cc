@@ -2155,6 +2155,56 @@ static bool lib_override_library_resync(Main *bmain,
   GHash *linkedref_to_old_override = BLI_ghash_new(
       BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
 
+  /* Main is not modified while processing the resync sub-roots below, only tags are. So gather the
+   * liboverrides of the same library as the root, and the (reference, override) pairs of the
+   * current hierarchy, in a single pass over Main instead of one pass per sub-root. This matters a
+   * lot in production files, where most of Main is linked data unrelated to this hierarchy. */
+  blender::Vector<ID *> library_overrides;
+  blender::Vector<std::pair<ID *, ID *>> hierarchy_references_and_overrides;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    if ((id->lib != id_root->lib) || !ID_IS_OVERRIDE_LIBRARY(id)) {
+      continue;
+    }
+    library_overrides.append(id);
+
+    /* While this should not happen in typical cases (and won't be properly supported here),
+     * user is free to do all kind of very bad things, including having different local
+     * overrides of a same linked ID in a same hierarchy. */
+    IDOverrideLibrary *id_override_library = BKE_lib_override_library_get(
+        bmain, id, nullptr, nullptr);
+
+    if (id_override_library->hierarchy_root != id_root->override_library->hierarchy_root) {
+      continue;
+    }
+
+    ID *reference_id = id_override_library->reference;
+    if (GS(reference_id->name) != GS(id->name)) {
+      switch (GS(id->name)) {
+        case ID_KE:
+          reference_id = reinterpret_cast<ID *>(BKE_key_from_id(reference_id));
+          break;
+        case ID_GR:
+          BLI_assert(GS(reference_id->name) == ID_SCE);
+          reference_id = reinterpret_cast<ID *>(
+              reinterpret_cast<Scene *>(reference_id)->master_collection);
+          break;
+        case ID_NT:
+          reference_id = reinterpret_cast<ID *>(blender::bke::ntreeFromID(id));
+          break;
+        default:
+          break;
+      }
+    }
+    if (reference_id == nullptr) {
+      /* Can happen e.g. when there is a local override of a shape-key, but the matching linked
+       * obdata (mesh etc.) does not have any shape-key anymore. */
+      continue;
+    }
+    BLI_assert(GS(reference_id->name) == GS(id->name));
+    hierarchy_references_and_overrides.append({reference_id, id});
+  }
+  FOREACH_MAIN_ID_END;
+
   /* Only tag linked IDs from related linked reference hierarchy that are actually part of
    * the sub-trees of each detected sub-roots needing resync. */
   for (LinkNode *resync_root_link = id_resync_roots; resync_root_link != nullptr;
@@ -2210,76 +2260,38 @@ static bool lib_override_library_resync(Main *bmain,
     BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
     lib_override_hierarchy_dependencies_recursive_tag(&data);
 
-    FOREACH_MAIN_ID_BEGIN (bmain, id) {
-      if ((id->lib != id_root->lib) || !ID_IS_OVERRIDE_LIBRARY(id)) {
-        continue;
-      }
-
+    for (ID *id_override : library_overrides) {
       /* IDs that get fully removed from linked data remain as local overrides (using place-holder
        * linked IDs as reference), but they are often not reachable from any current valid local
        * override hierarchy anymore. This will ensure they get properly deleted at the end of this
        * function. */
-      if (!ID_IS_LINKED(id) && ID_IS_OVERRIDE_LIBRARY_REAL(id) &&
-          (id->override_library->reference->tag & LIB_TAG_MISSING) != 0 &&
+      if (!ID_IS_LINKED(id_override) && ID_IS_OVERRIDE_LIBRARY_REAL(id_override) &&
+          (id_override->override_library->reference->tag & LIB_TAG_MISSING) != 0 &&
           /* Unfortunately deleting obdata means deleting their objects too. Since there is no
            * guarantee that a valid override object using an obsolete override obdata gets properly
            * updated, we ignore those here for now. In practice this should not be a big issue. */
-          !OB_DATA_SUPPORT_ID(GS(id->name)))
+          !OB_DATA_SUPPORT_ID(GS(id_override->name)))
       {
-        id->tag |= LIB_TAG_MISSING;
-      }
-
-      /* While this should not happen in typical cases (and won't be properly supported here),
-       * user is free to do all kind of very bad things, including having different local
-       * overrides of a same linked ID in a same hierarchy. */
-      IDOverrideLibrary *id_override_library = BKE_lib_override_library_get(
-          bmain, id, nullptr, nullptr);
-
-      if (id_override_library->hierarchy_root != id_root->override_library->hierarchy_root) {
-        continue;
-      }
-
-      ID *reference_id = id_override_library->reference;
-      if (GS(reference_id->name) != GS(id->name)) {
-        switch (GS(id->name)) {
-          case ID_KE:
-            reference_id = reinterpret_cast<ID *>(BKE_key_from_id(reference_id));
-            break;
-          case ID_GR:
-            BLI_assert(GS(reference_id->name) == ID_SCE);
-            reference_id = reinterpret_cast<ID *>(
-                reinterpret_cast<Scene *>(reference_id)->master_collection);
-            break;
-          case ID_NT:
-            reference_id = reinterpret_cast<ID *>(blender::bke::ntreeFromID(id));
-            break;
-          default:
-            break;
-        }
-      }
-      if (reference_id == nullptr) {
-        /* Can happen e.g. when there is a local override of a shape-key, but the matching linked
-         * obdata (mesh etc.) does not have any shape-key anymore. */
-        continue;
+        id_override->tag |= LIB_TAG_MISSING;
       }
-      BLI_assert(GS(reference_id->name) == GS(id->name));
+    }
 
+    for (auto [reference_id, id_override] : hierarchy_references_and_overrides) {
       if (!BLI_ghash_haskey(linkedref_to_old_override, reference_id)) {
-        BLI_ghash_insert(linkedref_to_old_override, reference_id, id);
-        if (!ID_IS_OVERRIDE_LIBRARY_REAL(id) || (id->tag & LIB_TAG_DOIT) == 0) {
+        BLI_ghash_insert(linkedref_to_old_override, reference_id, id_override);
+        if (!ID_IS_OVERRIDE_LIBRARY_REAL(id_override) || (id_override->tag & LIB_TAG_DOIT) == 0) {
           continue;
         }
-        if ((id->override_library->reference->tag & LIB_TAG_DOIT) == 0) {
+        if ((id_override->override_library->reference->tag & LIB_TAG_DOIT) == 0) {
           /* We have an override, but now it does not seem to be necessary to override that ID
            * anymore. Check if there are some actual overrides from the user, otherwise assume
            * that we can get rid of this local override. */
-          if (BKE_lib_override_library_is_user_edited(id)) {
-            id->override_library->reference->tag |= LIB_TAG_DOIT;
+          if (BKE_lib_override_library_is_user_edited(id_override)) {
+            id_override->override_library->reference->tag |= LIB_TAG_DOIT;
           }
         }
       }
     }
-    FOREACH_MAIN_ID_END;
 
     /* Code above may have added some tags, we need to update this too. */
     BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
@@ -3793,18 +3805,18 @@ void BKE_lib_override_library_delete(Main *bmain, ID *id_root)
   BKE_main_relations_free(bmain);
   data.clear();
 
+  /* Remap the whole local IDs to use the linked data, in a single pass over Main. */
+  id::IDRemapper id_remapper;
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (id->tag & LIB_TAG_DOIT) {
       if (ID_IS_OVERRIDE_LIBRARY_REAL(id)) {
-        ID *id_override_reference = id->override_library->reference;
-
-        /* Remap the whole local IDs to use the linked data. */
-        BKE_libblock_remap(bmain, id, id_override_reference, ID_REMAP_SKIP_INDIRECT_USAGE);
+        id_remapper.add(id, id->override_library->reference);
       }
     }
   }
   FOREACH_MAIN_ID_END;
+  BKE_libblock_remap_multiple(bmain, id_remapper, ID_REMAP_SKIP_INDIRECT_USAGE);
 
   /* Delete the override IDs. */
   BKE_id_multi_tagged_delete(bmain);
@@ -94,7 +94,9 @@ struct UniqueName_Key {
  *
  * - Exactly track which of the lowest 1024 suffixes are in use,
  *   whenever there is a name collision we pick the lowest "unused"
- *   one. This is done with a bit map.
+ *   one. This is done with a bit map, and a lower bound of the lowest
+ *   unused suffix so that adding many names with the same base name
+ *   does not scan the used suffixes again each time.
  * - Above 1024, do not track them exactly, just track the maximum
  *   suffix value seen so far. Upon collision, assign number that is
  *   one larger.
@@ -103,6 +105,8 @@ struct UniqueName_Value {
   static constexpr uint max_exact_tracking = 1024;
   BLI_BITMAP_DECLARE(mask, max_exact_tracking);
   int max_value = 0;
+  /* All suffixes in `[1, first_unused_hint)` are known to be in use. */
+  int first_unused_hint = 1;
 
   void mark_used(int number)
   {
@@ -118,6 +122,9 @@ struct UniqueName_Value {
   {
     if (number >= 0 && number < max_exact_tracking) {
       BLI_BITMAP_DISABLE(mask, number);
+      if (number > 0) {
+        math::min_inplace(first_unused_hint, number);
+      }
     }
     if (number > 0 && number == max_value) {
       --max_value;
@@ -142,18 +149,18 @@ struct UniqueName_Value {
      * However we never want to pick zero ("none") suffix, even if it is
      * available, e.g. if Foo.001 was used and we want to create another
      * Foo.001, we should return Foo.002 and not Foo.
-     * So while searching, mark #0 as "used" to make sure we don't find it,
-     * and restore the value afterwards. */
-
-    BLI_bitmap prev_first = mask[0];
-    mask[0] |= 1;
-    int result = BLI_bitmap_find_first_unset(mask, max_exact_tracking);
-    if (result >= 0) {
-      BLI_BITMAP_ENABLE(mask, result);
-      math::max_inplace(max_value, result);
+     * Since the search starts at #first_unused_hint, which is never zero,
+     * it cannot find it. */
+    for (int number = first_unused_hint; number < max_exact_tracking; number++) {
+      if (!BLI_BITMAP_TEST_BOOL(mask, number)) {
+        BLI_BITMAP_ENABLE(mask, number);
+        math::max_inplace(max_value, number);
+        first_unused_hint = number + 1;
+        return number;
+      }
     }
-    mask[0] |= prev_first & 1; /* Restore previous value of #0 bit. */
-    return result;
+    first_unused_hint = max_exact_tracking;
+    return -1;
   }
 };
 
@@ -391,7 +398,7 @@ bool BKE_main_namemap_get_name(Main *bmain, ID *id, char *name, const bool do_un
       STRNCPY(key.name, name);
       type_map->full_names.add(key);
       if (name_map_other != nullptr) {
-        namemap_add_name(name_map_other, id, name, number);
+        namemap_add_name(name_map_other, id, name, number_to_use);
       }
       break;
     }
@@ -1150,6 +1150,20 @@ void mesh_data_update(Depsgraph &depsgraph,
    * they aren't cleaned up properly on mode switch, causing crashes, e.g #58150. */
   BLI_assert(ob.id.tag & LIB_TAG_COPIED_ON_EVAL);
 
+  /* Keep the previous evaluated mesh until the new one is evaluated, so that its draw cache can
+   * be reused when only the positions changed, see #BKE_mesh_batch_cache_reuse. */
+  Mesh *mesh_eval_prev = nullptr;
+  if (ob.mode == OB_MODE_OBJECT && ob.runtime->is_data_eval_owned &&
+      ob.runtime->data_eval != nullptr && GS(ob.runtime->data_eval->name) == ID_ME &&
+      ob.runtime->editmesh_eval_cage == nullptr)
+  {
+    Mesh *mesh_eval = reinterpret_cast<Mesh *>(ob.runtime->data_eval);
+    if (mesh_eval->runtime->batch_cache != nullptr && mesh_eval->runtime->subdiv_ccg == nullptr) {
+      mesh_eval_prev = mesh_eval;
+      ob.runtime->data_eval = nullptr;
+    }
+  }
+
   BKE_object_free_derived_caches(&ob);
   if (DEG_is_active(&depsgraph)) {
     BKE_sculpt_update_object_before_eval(&ob);
@@ -1171,6 +1185,13 @@ void mesh_data_update(Depsgraph &depsgraph,
   else {
     mesh_build_data(depsgraph, scene, ob, cddata_masks, need_mapping);
   }
+
+  if (mesh_eval_prev != nullptr) {
+    if (ob.runtime->is_data_eval_owned) {
+      BKE_mesh_batch_cache_reuse(reinterpret_cast<Mesh *>(ob.runtime->data_eval), mesh_eval_prev);
+    }
+    BKE_id_free(nullptr, mesh_eval_prev);
+  }
 }
 
 Mesh *mesh_get_eval_deform(Depsgraph *depsgraph,
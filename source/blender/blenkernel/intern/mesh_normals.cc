@@ -19,6 +19,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
@@ -78,6 +79,15 @@ namespace blender::bke::mesh {
 /** \name Mesh Normal Calculation (Polygons)
  * \{ */
 
+static float3 normalize_face_normal(float3 normal)
+{
+  if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
+    /* Other axis are already set to zero. */
+    normal[2] = 1.0f;
+  }
+  return normal;
+}
+
 /*
  * COMPUTE POLY NORMAL
  *
@@ -97,12 +107,7 @@ static float3 normal_calc_ngon(const Span<float3> vert_positions, const Span<int
     v_prev = v_curr;
   }
 
-  if (UNLIKELY(normalize_v3(normal) == 0.0f)) {
-    /* Other axis are already set to zero. */
-    normal[2] = 1.0f;
-  }
-
-  return normal;
+  return normalize_face_normal(normal);
 }
 
 float3 face_normal_calc(const Span<float3> vert_positions, const Span<int> face_verts)
@@ -142,6 +147,55 @@ float3 face_normal_calc(const Span<float3> vert_positions, const Span<int> face_
  * meshes can slow down high-poly meshes. For details on performance, see D11993.
  * \{ */
 
+/** Check whether all faces in the range have the given number of corners. */
+static bool faces_have_size(const OffsetIndices<int> faces, const IndexRange range, const int size)
+{
+  const Span<int> offsets = faces.data().slice(range.start(), range.size() + 1);
+  if (offsets.last() - offsets.first() != size * range.size()) {
+    return false;
+  }
+  if (size == 3) {
+    /* Faces can't have fewer than three corners, so the total size is enough. */
+    return true;
+  }
+  for (const int i : range.index_range()) {
+    if (offsets[i + 1] - offsets[i] != size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Specialized loops for chunks of triangles and quads. The corners of the faces are contiguous
+ * and the loop body has no branches on the face size, which is significantly faster than the
+ * generic Newell's method loop for the most common meshes.
+ */
+static void normals_calc_tris(const Span<float3> positions,
+                              const Span<int> corner_verts,
+                              const IndexRange range,
+                              MutableSpan<float3> face_normals)
+{
+  for (const int i : range.index_range()) {
+    const int *verts = &corner_verts[i * 3];
+    face_normals[range[i]] = normalize_face_normal(
+        math::cross_tri(positions[verts[0]], positions[verts[1]], positions[verts[2]]));
+  }
+}
+
+static void normals_calc_quads(const Span<float3> positions,
+                               const Span<int> corner_verts,
+                               const IndexRange range,
+                               MutableSpan<float3> face_normals)
+{
+  for (const int i : range.index_range()) {
+    const int *verts = &corner_verts[i * 4];
+    face_normals[range[i]] = normalize_face_normal(
+        math::cross(positions[verts[0]] - positions[verts[2]],
+                    positions[verts[1]] - positions[verts[3]]));
+  }
+}
+
 void normals_calc_faces(const Span<float3> positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -149,12 +203,57 @@ void normals_calc_faces(const Span<float3> positions,
 {
   BLI_assert(faces.size() == face_normals.size());
   threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    const Span<int> range_corner_verts = corner_verts.slice(faces[range]);
+    if (faces_have_size(faces, range, 3)) {
+      normals_calc_tris(positions, range_corner_verts, range, face_normals);
+      return;
+    }
+    if (faces_have_size(faces, range, 4)) {
+      normals_calc_quads(positions, range_corner_verts, range, face_normals);
+      return;
+    }
     for (const int i : range) {
       face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
     }
   });
 }
 
+void normals_calc_faces(const Span<float3> positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals)
+{
+  BLI_assert(faces.size() == face_normals.size());
+  face_mask.foreach_index(GrainSize(1024), [&](const int i) {
+    face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
+  });
+}
+
+static float3 vert_normal_calc(const Span<float3> positions,
+                               const OffsetIndices<int> faces,
+                               const Span<int> corner_verts,
+                               const Span<int> vert_faces,
+                               const Span<float3> face_normals,
+                               const int vert)
+{
+  if (vert_faces.is_empty()) {
+    return math::normalize(positions[vert]);
+  }
+
+  float3 vert_normal(0);
+  for (const int face : vert_faces) {
+    const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+    const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+    const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+    const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+
+    vert_normal += face_normals[face] * factor;
+  }
+
+  return math::normalize(vert_normal);
+}
+
 void normals_calc_verts(const Span<float3> vert_positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
@@ -165,27 +264,26 @@ void normals_calc_verts(const Span<float3> vert_positions,
   const Span<float3> positions = vert_positions;
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
     for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
-
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
-
-        vert_normal += face_normals[face] * factor;
-      }
-
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normals[vert] = vert_normal_calc(
+          positions, faces, corner_verts, vert_to_face_map[vert], face_normals, vert);
     }
   });
 }
 
+void normals_calc_verts(const Span<float3> vert_positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const GroupedSpan<int> vert_to_face_map,
+                        const Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals)
+{
+  vert_mask.foreach_index(GrainSize(1024), [&](const int vert) {
+    vert_normals[vert] = vert_normal_calc(
+        vert_positions, faces, corner_verts, vert_to_face_map[vert], face_normals, vert);
+  });
+}
+
 /** \} */
 
 }  // namespace blender::bke::mesh
@@ -9,6 +9,8 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 #include "BLI_task.hh"
 
@@ -47,6 +49,9 @@ static void free_bvh_cache(MeshRuntime &mesh_runtime)
     bvhcache_free(mesh_runtime.bvh_cache);
     mesh_runtime.bvh_cache = nullptr;
   }
+  mesh_runtime.bvh_cache_verts.tag_dirty();
+  mesh_runtime.bvh_cache_edges.tag_dirty();
+  mesh_runtime.bvh_cache_corner_tris.tag_dirty();
 }
 
 static void free_batch_cache(MeshRuntime &mesh_runtime)
@@ -152,6 +157,17 @@ blender::GroupedSpan<int> Mesh::vert_to_face_map() const
   return {offsets, this->runtime->vert_to_face_map_cache.data()};
 }
 
+blender::GroupedSpan<int> Mesh::vert_to_edge_map() const
+{
+  using namespace blender;
+  this->runtime->vert_to_edge_map_cache.ensure([&](bke::VertToEdgeMapCache &r_data) {
+    bke::mesh::build_vert_to_edge_map(
+        this->edges(), this->verts_num, r_data.offsets, r_data.indices);
+  });
+  const bke::VertToEdgeMapCache &cache = this->runtime->vert_to_edge_map_cache.data();
+  return {OffsetIndices<int>(cache.offsets), cache.indices};
+}
+
 blender::GroupedSpan<int> Mesh::vert_to_corner_map() const
 {
   using namespace blender;
@@ -319,6 +335,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->vert_to_face_map_cache.tag_dirty();
   mesh->runtime->vert_to_corner_map_cache.tag_dirty();
   mesh->runtime->corner_to_face_map_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
   mesh->runtime->vert_normals_cache.tag_dirty();
   mesh->runtime->face_normals_cache.tag_dirty();
   mesh->runtime->corner_normals_cache.tag_dirty();
@@ -342,6 +359,7 @@ void Mesh::tag_edges_split()
   this->runtime->vert_to_face_offset_cache.tag_dirty();
   this->runtime->vert_to_face_map_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->vert_to_edge_map_cache.tag_dirty();
   if (this->runtime->loose_edges_cache.is_cached() &&
       this->runtime->loose_edges_cache.data().count != 0)
   {
@@ -390,6 +408,59 @@ void Mesh::tag_positions_changed()
   this->tag_positions_changed_no_normals();
 }
 
+void Mesh::tag_positions_changed(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  bke::MeshRuntime &runtime = *this->runtime;
+  /* Updating normals partially only pays off when a small part of the mesh is affected. Otherwise
+   * the overhead of finding the affected elements is larger than recomputing everything. */
+  if (!runtime.face_normals_cache.is_cached() || changed_verts.size() > this->verts_num / 4) {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const OffsetIndices<int> faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face = this->vert_to_face_map();
+
+  bits::BitVector<> affected_faces(faces.size(), false);
+  changed_verts.foreach_index([&](const int vert) {
+    for (const int face : vert_to_face[vert]) {
+      affected_faces[face].set();
+    }
+  });
+  IndexMaskMemory memory;
+  const IndexMask face_mask = IndexMask::from_bits(affected_faces, memory);
+
+  const Span<float3> positions = this->vert_positions();
+  runtime.face_normals_cache.update([&](Vector<float3> &r_data) {
+    bke::mesh::normals_calc_faces(positions, faces, corner_verts, face_mask, r_data);
+  });
+
+  if (runtime.vert_normals_cache.is_cached()) {
+    /* Vertex normals depend on the normals of all faces around them. */
+    bits::BitVector<> affected_verts(this->verts_num, false);
+    changed_verts.foreach_index([&](const int vert) { affected_verts[vert].set(); });
+    face_mask.foreach_index([&](const int face) {
+      for (const int vert : corner_verts.slice(faces[face])) {
+        affected_verts[vert].set();
+      }
+    });
+    const IndexMask vert_mask = IndexMask::from_bits(affected_verts, memory);
+    const Span<float3> face_normals = runtime.face_normals_cache.data();
+    runtime.vert_normals_cache.update([&](Vector<float3> &r_data) {
+      bke::mesh::normals_calc_verts(
+          positions, faces, corner_verts, vert_to_face, face_normals, vert_mask, r_data);
+    });
+  }
+  else {
+    runtime.vert_normals_cache.tag_dirty();
+  }
+
+  runtime.corner_normals_cache.tag_dirty();
+  this->tag_positions_changed_no_normals();
+}
+
 void Mesh::tag_positions_changed_no_normals()
 {
   free_bvh_cache(*this->runtime);
@@ -432,6 +503,79 @@ void BKE_mesh_batch_cache_free(void *batch_cache)
   BKE_mesh_batch_cache_free_cb(batch_cache);
 }
 
+/**
+ * Check whether all layers except the positions are the same. Because the previous mesh is
+ * still alive, arrays with the same address are shared and can't have been modified.
+ */
+static bool mesh_customdata_equal_except_positions(const CustomData &a, const CustomData &b)
+{
+  if (a.totlayer != b.totlayer) {
+    return false;
+  }
+  for (const int i : blender::IndexRange(a.totlayer)) {
+    const CustomDataLayer &layer_a = a.layers[i];
+    const CustomDataLayer &layer_b = b.layers[i];
+    if (layer_a.type != layer_b.type || layer_a.flag != layer_b.flag ||
+        layer_a.active != layer_b.active || layer_a.active_rnd != layer_b.active_rnd ||
+        !STREQ(layer_a.name, layer_b.name))
+    {
+      return false;
+    }
+    /* Positions are deformed, and original coordinates are allocated for every evaluation. */
+    if (layer_a.type == CD_ORCO ||
+        (layer_a.type == CD_PROP_FLOAT3 && STREQ(layer_a.name, "position")))
+    {
+      continue;
+    }
+    if (layer_a.data != layer_b.data) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BKE_mesh_batch_cache_reuse(Mesh *mesh, Mesh *mesh_prev)
+{
+  using namespace blender::bke;
+  const MeshRuntime &runtime = *mesh->runtime;
+  const MeshRuntime &runtime_prev = *mesh_prev->runtime;
+  if (runtime.batch_cache != nullptr || runtime_prev.batch_cache == nullptr) {
+    return;
+  }
+  /* Edit-mode and GPU subdivision drawing depend on more than the mesh arrays. */
+  if (runtime.edit_mesh || runtime_prev.edit_mesh ||
+      runtime.wrapper_type != ME_WRAPPER_TYPE_MDATA ||
+      runtime_prev.wrapper_type != ME_WRAPPER_TYPE_MDATA || runtime.subsurf_runtime_data ||
+      runtime_prev.subsurf_runtime_data)
+  {
+    return;
+  }
+  if (mesh->verts_num != mesh_prev->verts_num || mesh->edges_num != mesh_prev->edges_num ||
+      mesh->faces_num != mesh_prev->faces_num || mesh->corners_num != mesh_prev->corners_num ||
+      mesh->face_offset_indices != mesh_prev->face_offset_indices ||
+      mesh->totcol != mesh_prev->totcol)
+  {
+    return;
+  }
+  if (blender::StringRef(mesh->active_color_attribute) !=
+          blender::StringRef(mesh_prev->active_color_attribute) ||
+      blender::StringRef(mesh->default_color_attribute) !=
+          blender::StringRef(mesh_prev->default_color_attribute))
+  {
+    return;
+  }
+  if (!mesh_customdata_equal_except_positions(mesh->vert_data, mesh_prev->vert_data) ||
+      !mesh_customdata_equal_except_positions(mesh->edge_data, mesh_prev->edge_data) ||
+      !mesh_customdata_equal_except_positions(mesh->face_data, mesh_prev->face_data) ||
+      !mesh_customdata_equal_except_positions(mesh->corner_data, mesh_prev->corner_data))
+  {
+    return;
+  }
+  mesh->runtime->batch_cache = mesh_prev->runtime->batch_cache;
+  mesh_prev->runtime->batch_cache = nullptr;
+  BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_DEFORM);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
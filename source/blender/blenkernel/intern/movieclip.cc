@@ -235,9 +235,8 @@ static void direct_link_moviePlaneTracks(BlendDataReader *reader, ListBase *plan
 
   LISTBASE_FOREACH (MovieTrackingPlaneTrack *, plane_track, plane_tracks_base) {
     BLO_read_pointer_array(reader, (void **)&plane_track->point_tracks);
-    for (int i = 0; i < plane_track->point_tracksnr; i++) {
-      BLO_read_struct(reader, MovieTrackingTrack, &plane_track->point_tracks[i]);
-    }
+    BLO_read_struct_pointers(
+        reader, MovieTrackingTrack, plane_track->point_tracksnr, plane_track->point_tracks);
 
     BLO_read_struct_array(
         reader, MovieTrackingPlaneMarker, plane_track->markersnr, &plane_track->markers);
@@ -2772,11 +2772,17 @@ static bool psys_thread_context_init_path(ParticleThreadContext *ctx,
   if ((part->child_flag & PART_CHILD_USE_TWIST_CURVE) && part->twistcurve) {
     ctx->twistcurve = BKE_curvemapping_copy(part->twistcurve);
     BKE_curvemapping_changed_all(ctx->twistcurve);
+    psys_twist_curve_integral_init(ctx);
   }
   else {
     ctx->twistcurve = nullptr;
   }
 
+  ctx->edit = psys_orig_edit_get(psys);
+  ctx->parent_pathcache = psys_in_edit_mode(sim->depsgraph, psys) && ctx->edit ?
+                              ctx->edit->pathcache :
+                              psys->pathcache;
+
   return true;
 }
 
@@ -2799,10 +2805,8 @@ static void psys_thread_create_path(ParticleTask *task,
   ParticleSystem *psys = ctx->sim.psys;
   ParticleSettings *part = psys->part;
   ParticleCacheKey **cache = psys->childcache;
-  PTCacheEdit *edit = psys_orig_edit_get(psys);
-  ParticleCacheKey **pcache = psys_in_edit_mode(ctx->sim.depsgraph, psys) && edit ?
-                                  edit->pathcache :
-                                  psys->pathcache;
+  PTCacheEdit *edit = ctx->edit;
+  ParticleCacheKey **pcache = ctx->parent_pathcache;
   ParticleCacheKey *child, *key[4];
   ParticleTexture ptex;
   float *cpa_fuv = nullptr, *par_rot = nullptr, rot[4];
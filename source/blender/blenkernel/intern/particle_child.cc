@@ -6,6 +6,10 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
@@ -743,6 +747,52 @@ static float BKE_curvemapping_integrate_clamped(const CurveMapping *curve,
   return integral;
 }
 
+void psys_twist_curve_integral_init(ParticleThreadContext *ctx)
+{
+  /* Use the same steps as #BKE_curvemapping_integrate_clamped, so the result is identical. */
+  const float step = 1.0f / ctx->segments;
+  const int steps_max = ctx->segments + 3;
+  ctx->twist_curve_steps = static_cast<float *>(
+      MEM_malloc_arrayN(steps_max, sizeof(float), __func__));
+  ctx->twist_curve_integral = static_cast<float *>(
+      MEM_malloc_arrayN(steps_max, sizeof(float), __func__));
+  ctx->twist_curve_steps_num = 0;
+
+  float integral = 0.0f;
+  float x = 0.0f;
+  while (x <= 1.0f && ctx->twist_curve_steps_num < steps_max) {
+    ctx->twist_curve_steps[ctx->twist_curve_steps_num] = x;
+    ctx->twist_curve_integral[ctx->twist_curve_steps_num] = integral;
+    ctx->twist_curve_steps_num++;
+
+    float y = BKE_curvemapping_evaluateF(ctx->twistcurve, 0, x);
+    y = clamp_f(y, 0.0f, 1.0f);
+    integral += y * step;
+    x += step;
+  }
+}
+
+/**
+ * Look up the integral of the twist curve up to the time in the table of the thread context.
+ * Returns false when the time is outside of the table.
+ */
+static bool twist_curve_integral_lookup(const ParticleThreadContext *ctx,
+                                        const float time,
+                                        float *r_integral)
+{
+  if (ctx->twist_curve_steps_num == 0 ||
+      time > ctx->twist_curve_steps[ctx->twist_curve_steps_num - 1])
+  {
+    return false;
+  }
+  /* The integration adds all steps that start before the time. */
+  const float *steps = ctx->twist_curve_steps;
+  const int steps_before = std::lower_bound(steps, steps + ctx->twist_curve_steps_num, time) -
+                           steps;
+  *r_integral = ctx->twist_curve_integral[steps_before];
+  return true;
+}
+
 static void do_twist(const ParticleChildModifierContext *modifier_ctx,
                      ParticleKey *state,
                      const float time)
@@ -780,8 +830,12 @@ static void do_twist(const ParticleChildModifierContext *modifier_ctx,
     angle *= (ptex->twist - 0.5f) * 2.0f;
   }
   if (twist_curve != nullptr) {
-    const int num_segments = twist_num_segments(modifier_ctx);
-    angle *= BKE_curvemapping_integrate_clamped(twist_curve, 0.0f, time, 1.0f / num_segments);
+    float integral;
+    if (thread_ctx == nullptr || !twist_curve_integral_lookup(thread_ctx, time, &integral)) {
+      const int num_segments = twist_num_segments(modifier_ctx);
+      integral = BKE_curvemapping_integrate_clamped(twist_curve, 0.0f, time, 1.0f / num_segments);
+    }
+    angle *= integral;
   }
   else {
     angle *= time;
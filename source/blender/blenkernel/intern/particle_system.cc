@@ -547,6 +547,8 @@ void psys_thread_context_free(ParticleThreadContext *ctx)
   if (ctx->twistcurve != nullptr) {
     BKE_curvemapping_free(ctx->twistcurve);
   }
+  MEM_SAFE_FREE(ctx->twist_curve_steps);
+  MEM_SAFE_FREE(ctx->twist_curve_integral);
 }
 
 static void init_particle_texture(ParticleSimulationData *sim, ParticleData *pa, int p)
@@ -3837,6 +3839,51 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict /*tls*/)
+{
+  DynamicStepSolverTaskData *data = static_cast<DynamicStepSolverTaskData *>(userdata);
+  ParticleSimulationData *sim = data->sim;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  /* do global forces & effectors */
+  basic_integrate(sim, p, pa->state.time, data->cfra);
+
+  /* deflection */
+  if (sim->colliders) {
+    collision_check(sim, p, pa->state.time, data->cfra);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+/**
+ * Particles can be integrated in parallel unless an effector depends on the order in which they
+ * are evaluated: noise uses a random number generator shared by all particles, and a particle
+ * system affecting itself reads the states that are being written.
+ */
+static bool dynamics_step_newton_use_threading(ParticleSimulationData *sim)
+{
+  ParticleSystem *psys = sim->psys;
+  if (psys->effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, psys->effectors) {
+      if (eff->psys == psys || (eff->pd && eff->pd->f_noise > 0.0f)) {
+        return false;
+      }
+    }
+  }
+  return psys->totpart > 100;
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3968,19 +4015,17 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
-      LOOP_DYNAMIC_PARTICLES
-      {
-        /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
-
-        /* deflection */
-        if (sim->colliders) {
-          collision_check(sim, p, pa->state.time, cfra);
-        }
+      DynamicStepSolverTaskData task_data{};
+      task_data.sim = sim;
+      task_data.cfra = cfra;
+      task_data.timestep = timestep;
+      task_data.dtime = dtime;
 
-        /* rotations */
-        basic_rotate(part, pa, pa->state.time, timestep);
-      }
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.use_threading = dynamics_step_newton_use_threading(sim);
+      BLI_task_parallel_range(
+          0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
       break;
     }
     case PART_PHYS_BOIDS: {
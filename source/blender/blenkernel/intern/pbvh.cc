@@ -8,7 +8,9 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <array>
 #include <climits>
+#include <numeric>
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_span_ops.hh"
@@ -54,6 +56,15 @@ using blender::bke::AttrDomain;
 
 #define LEAF_LIMIT 10000
 
+/* Number of bins used to find split positions with the surface area heuristic. */
+#define SPLIT_BINS_NUM 16
+/* Use binned splits for nodes that will have at least this many leaves below them. */
+#define SPLIT_BINNED_LEAVES_MIN 8
+/* Build sub-trees in parallel when they contain more primitives than this. */
+#define PARALLEL_BUILD_PRIMS_MIN 50000
+/* Size of the primitive chunks processed by a single task when partitioning. */
+#define PARTITION_CHUNK_SIZE 16384
+
 /* Uncomment to test if triangles of the same face are
  * properly clustered into single nodes.
  */
@@ -106,37 +117,83 @@ static bool face_materials_match(const Span<int> material_indices,
   return true;
 }
 
-/* Adapted from BLI_kdopbvh.c */
-/* Returns the index of the first element on the right of the partition */
+/**
+ * Move the primitives with centroids below #split to the front of #prim_indices. All primitives of
+ * a face are moved to the side of the face's first primitive, and the partition is stable, so the
+ * primitives of every face stay contiguous. Large ranges are partitioned in parallel.
+ * Returns the number of primitives on the left side.
+ */
 static int partition_prim_indices(MutableSpan<int> prim_indices,
-                                  int *prim_scratch,
-                                  int lo,
-                                  int hi,
-                                  int axis,
-                                  float mid,
+                                  MutableSpan<int> prim_scratch,
+                                  const int axis,
+                                  const float split,
                                   const Span<Bounds<float3>> prim_bounds,
                                   const Span<int> prim_to_face_map)
 {
-  for (int i = lo; i < hi; i++) {
-    prim_scratch[i - lo] = prim_indices[i];
-  }
-
-  int lo2 = lo, hi2 = hi - 1;
-  int i1 = lo, i2 = 0;
-
-  while (i1 < hi) {
-    const int face_i = prim_to_face_map[prim_scratch[i2]];
-    const Bounds<float3> &bounds = prim_bounds[prim_scratch[i2]];
-    const bool side = math::midpoint(bounds.min[axis], bounds.max[axis]) >= mid;
+  const int size = prim_indices.size();
+  const int chunk_size = std::max(PARTITION_CHUNK_SIZE, size / 256);
+  const int chunks_num = (size + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int chunk) {
+    return IndexRange::from_begin_end(chunk * chunk_size,
+                                      std::min(size, (chunk + 1) * chunk_size));
+  };
+  const auto prim_is_left = [&](const int prim) {
+    const Bounds<float3> &bounds = prim_bounds[prim];
+    return math::midpoint(bounds.min[axis], bounds.max[axis]) < split;
+  };
+
+  Array<bool> is_left(size);
+  Array<int> chunk_left_counts(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      const IndexRange prims = chunk_range(chunk);
+      /* A face may start in the previous chunk, find its first primitive. */
+      int first = prims.start();
+      while (first > 0 &&
+             prim_to_face_map[prim_indices[first - 1]] == prim_to_face_map[prim_indices[first]])
+      {
+        first--;
+      }
+      bool face_is_left = prim_is_left(prim_indices[first]);
+      int left_count = 0;
+      for (const int i : prims) {
+        if (i > prims.start() &&
+            prim_to_face_map[prim_indices[i]] != prim_to_face_map[prim_indices[i - 1]])
+        {
+          face_is_left = prim_is_left(prim_indices[i]);
+        }
+        is_left[i] = face_is_left;
+        left_count += int(face_is_left);
+      }
+      chunk_left_counts[chunk] = left_count;
+    }
+  });
 
-    while (i1 < hi && prim_to_face_map[prim_scratch[i2]] == face_i) {
-      prim_indices[side ? hi2-- : lo2++] = prim_scratch[i2];
-      i1++;
-      i2++;
+  /* Turn the counts into the start offsets of every chunk on both sides. */
+  const int left_size = std::accumulate(chunk_left_counts.begin(), chunk_left_counts.end(), 0);
+  Array<int> chunk_left_offsets(chunks_num);
+  Array<int> chunk_right_offsets(chunks_num);
+  int left_offset = 0;
+  int right_offset = left_size;
+  for (const int chunk : IndexRange(chunks_num)) {
+    chunk_left_offsets[chunk] = left_offset;
+    chunk_right_offsets[chunk] = right_offset;
+    left_offset += chunk_left_counts[chunk];
+    right_offset += chunk_range(chunk).size() - chunk_left_counts[chunk];
+  }
+
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int chunk : range) {
+      int left = chunk_left_offsets[chunk];
+      int right = chunk_right_offsets[chunk];
+      for (const int i : chunk_range(chunk)) {
+        prim_scratch[is_left[i] ? left++ : right++] = prim_indices[i];
+      }
     }
-  }
+  });
+  array_utils::copy(prim_scratch.as_span(), prim_indices);
 
-  return lo2;
+  return left_size;
 }
 
 /* Returns the index of the first element on the right of the partition */
@@ -170,94 +227,226 @@ static int partition_indices_material_faces(MutableSpan<int> indices,
   }
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(Map<int, int> &map,
-                           MutableSpan<bool> vert_bitmap,
-                           int *face_verts,
-                           int *uniq_verts,
-                           int vertex)
+/** Find the bounds of all primitives in #prim_indices. */
+static Bounds<float3> calc_prims_bounds(const Span<int> prim_indices,
+                                        const Span<Bounds<float3>> prim_bounds)
 {
-  return map.lookup_or_add_cb(vertex, [&]() {
-    int value;
-    if (!vert_bitmap[vertex]) {
-      vert_bitmap[vertex] = true;
-      value = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value = ~(*face_verts);
-      (*face_verts)++;
-    }
-    return value;
-  });
+  return threading::parallel_reduce(
+      prim_indices.index_range(),
+      PARTITION_CHUNK_SIZE,
+      negative_bounds(),
+      [&](const IndexRange range, const Bounds<float3> &init) {
+        Bounds<float3> current = init;
+        for (const int prim : prim_indices.slice(range)) {
+          current = bounds::merge(current, prim_bounds[prim]);
+        }
+        return current;
+      },
+      [](const Bounds<float3> &a, const Bounds<float3> &b) { return bounds::merge(a, b); });
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(const Span<int> corner_verts,
-                                 const Span<int3> corner_tris,
-                                 const Span<int> tri_faces,
-                                 const Span<bool> hide_poly,
-                                 MutableSpan<bool> vert_bitmap,
-                                 PBVHNode *node)
+/** Find the bounds of the centroids of all primitives in #prim_indices. */
+static Bounds<float3> calc_prims_center_bounds(const Span<int> prim_indices,
+                                               const Span<Bounds<float3>> prim_bounds)
 {
-  node->uniq_verts = 0;
-  int shared_verts = 0;
-  const Span<int> prim_indices = node->prim_indices;
+  return threading::parallel_reduce(
+      prim_indices.index_range(),
+      PARTITION_CHUNK_SIZE,
+      negative_bounds(),
+      [&](const IndexRange range, const Bounds<float3> &init) {
+        Bounds<float3> current = init;
+        for (const int prim : prim_indices.slice(range)) {
+          const float3 center = math::midpoint(prim_bounds[prim].min, prim_bounds[prim].max);
+          math::min_max(center, current.min, current.max);
+        }
+        return current;
+      },
+      [](const Bounds<float3> &a, const Bounds<float3> &b) { return bounds::merge(a, b); });
+}
 
-  /* reserve size is rough guess */
-  Map<int, int> map;
-  map.reserve(prim_indices.size());
+struct SplitBin {
+  Bounds<float3> bounds = negative_bounds();
+  int count = 0;
+};
+using SplitBins = std::array<SplitBin, SPLIT_BINS_NUM>;
+
+static float bounds_half_area(const Bounds<float3> &bounds)
+{
+  const float3 size = math::max(bounds.max - bounds.min, float3(0.0f));
+  return size.x * size.y + size.y * size.z + size.z * size.x;
+}
 
-  node->face_vert_indices.reinitialize(prim_indices.size());
+/**
+ * Find the split position along #axis with the lowest surface area heuristic cost by sorting the
+ * primitive centroids into bins. Falls back to the middle of the centroid bounds when no bin
+ * boundary separates the primitives.
+ */
+static float find_split_position(const Span<int> prim_indices,
+                                 const Span<Bounds<float3>> prim_bounds,
+                                 const Bounds<float3> &cb,
+                                 const int axis)
+{
+  const float midpoint = math::midpoint(cb.min[axis], cb.max[axis]);
+  const float extent = cb.max[axis] - cb.min[axis];
+  if (!(extent > 0.0f)) {
+    return midpoint;
+  }
+  const float scale = SPLIT_BINS_NUM / extent;
+
+  const SplitBins bins = threading::parallel_reduce(
+      prim_indices.index_range(),
+      PARTITION_CHUNK_SIZE,
+      SplitBins(),
+      [&](const IndexRange range, const SplitBins &init) {
+        SplitBins current = init;
+        for (const int prim : prim_indices.slice(range)) {
+          const Bounds<float3> &bounds = prim_bounds[prim];
+          const float center = math::midpoint(bounds.min[axis], bounds.max[axis]);
+          const int bin = std::clamp(int((center - cb.min[axis]) * scale), 0, SPLIT_BINS_NUM - 1);
+          current[bin].bounds = bounds::merge(current[bin].bounds, bounds);
+          current[bin].count++;
+        }
+        return current;
+      },
+      [](const SplitBins &a, const SplitBins &b) {
+        SplitBins result;
+        for (const int i : IndexRange(SPLIT_BINS_NUM)) {
+          result[i].bounds = bounds::merge(a[i].bounds, b[i].bounds);
+          result[i].count = a[i].count + b[i].count;
+        }
+        return result;
+      });
 
-  for (const int i : prim_indices.index_range()) {
-    const int3 &tri = corner_tris[prim_indices[i]];
-    for (int j = 0; j < 3; j++) {
-      node->face_vert_indices[i][j] = map_insert_vert(
-          map, vert_bitmap, &shared_verts, &node->uniq_verts, corner_verts[tri[j]]);
+  /* The cost of the right side for a split before each bin. */
+  std::array<float, SPLIT_BINS_NUM> right_costs{};
+  Bounds<float3> right_bounds = negative_bounds();
+  int right_count = 0;
+  for (int i = SPLIT_BINS_NUM - 1; i > 0; i--) {
+    right_bounds = bounds::merge(right_bounds, bins[i].bounds);
+    right_count += bins[i].count;
+    right_costs[i] = right_count * bounds_half_area(right_bounds);
+  }
+
+  float best_cost = std::numeric_limits<float>::max();
+  int best_split = -1;
+  Bounds<float3> left_bounds = negative_bounds();
+  int left_count = 0;
+  for (int i = 1; i < SPLIT_BINS_NUM; i++) {
+    left_bounds = bounds::merge(left_bounds, bins[i - 1].bounds);
+    left_count += bins[i - 1].count;
+    if (left_count == 0 || left_count == prim_indices.size()) {
+      continue;
+    }
+    const float cost = left_count * bounds_half_area(left_bounds) + right_costs[i];
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_split = i;
     }
   }
 
-  node->vert_indices.reinitialize(node->uniq_verts + shared_verts);
+  if (best_split == -1) {
+    return midpoint;
+  }
+  return cb.min[axis] + best_split / scale;
+}
 
-  /* Build the vertex list, unique verts first */
-  for (const MapItem<int, int> item : map.items()) {
-    int value = item.value;
-    if (value < 0) {
-      value = -value + node->uniq_verts - 1;
+/** Set #value to the minimum of its current value and #new_value. */
+static void atomic_min_int32(int32_t *value, const int32_t new_value)
+{
+  int32_t old_value = *value;
+  while (new_value < old_value) {
+    const int32_t prev_value = atomic_cas_int32(value, old_value, new_value);
+    if (prev_value == old_value) {
+      break;
     }
-
-    node->vert_indices[value] = item.key;
+    old_value = prev_value;
   }
+}
+
+/**
+ * Find the vertices used by the faces in the mesh leaf nodes. A vertex is "unique" in the leaf
+ * with the lowest primitive offset that uses it, which is the order the leaves were built in.
+ * The vertices of every node are found by sorting the corner vertices instead of with a hash map.
+ */
+static void build_mesh_leaf_nodes(const int verts_num,
+                                  const Span<int> corner_verts,
+                                  const Span<int3> corner_tris,
+                                  const Span<int> tri_faces,
+                                  const Span<bool> hide_poly,
+                                  const Span<int> prim_indices,
+                                  const Span<int> leaf_indices,
+                                  MutableSpan<PBVHNode> nodes)
+{
+  const auto node_owner = [&](const PBVHNode &node) {
+    return int(node.prim_indices.data() - prim_indices.data());
+  };
+
+  /* Store the sorted vertices of every node temporarily and find the owner of every vertex. */
+  Array<int> vert_owners(verts_num, std::numeric_limits<int>::max());
+  threading::parallel_for(leaf_indices.index_range(), 1, [&](const IndexRange range) {
+    Vector<int> verts;
+    for (const int i : leaf_indices.slice(range)) {
+      PBVHNode &node = nodes[i];
+      verts.clear();
+      for (const int tri : node.prim_indices) {
+        for (int j = 0; j < 3; j++) {
+          verts.append(corner_verts[corner_tris[tri][j]]);
+        }
+      }
+      std::sort(verts.begin(), verts.end());
+      verts.resize(std::unique(verts.begin(), verts.end()) - verts.begin());
+      node.vert_indices = verts.as_span();
 
-  for (const int i : prim_indices.index_range()) {
-    for (int j = 0; j < 3; j++) {
-      if (node->face_vert_indices[i][j] < 0) {
-        node->face_vert_indices[i][j] = -node->face_vert_indices[i][j] + node->uniq_verts - 1;
+      const int owner = node_owner(node);
+      for (const int vert : verts) {
+        atomic_min_int32(&vert_owners[vert], owner);
       }
     }
-  }
+  });
 
-  const bool fully_hidden = !hide_poly.is_empty() &&
-                            std::all_of(prim_indices.begin(),
-                                        prim_indices.end(),
-                                        [&](const int tri) { return hide_poly[tri_faces[tri]]; });
-  BKE_pbvh_node_fully_hidden_set(node, fully_hidden);
-  BKE_pbvh_node_mark_rebuild_draw(node);
-}
+  threading::parallel_for(leaf_indices.index_range(), 1, [&](const IndexRange range) {
+    Array<int> sorted_verts;
+    Vector<int> new_indices;
+    for (const int i : leaf_indices.slice(range)) {
+      PBVHNode &node = nodes[i];
+      const Span<int> node_prims = node.prim_indices;
+      const int owner = node_owner(node);
+      sorted_verts = node.vert_indices.as_span();
+
+      /* Build the vertex list, unique verts first. */
+      node.uniq_verts = std::count_if(sorted_verts.begin(),
+                                      sorted_verts.end(),
+                                      [&](const int vert) { return vert_owners[vert] == owner; });
+      new_indices.resize(sorted_verts.size());
+      int unique_index = 0;
+      int shared_index = node.uniq_verts;
+      for (const int j : sorted_verts.index_range()) {
+        const int vert = sorted_verts[j];
+        new_indices[j] = vert_owners[vert] == owner ? unique_index++ : shared_index++;
+        node.vert_indices[new_indices[j]] = vert;
+      }
 
-static void update_vb(const Span<int> prim_indices,
-                      PBVHNode *node,
-                      const Span<Bounds<float3>> prim_bounds,
-                      int offset,
-                      int count)
-{
-  node->bounds = prim_bounds[prim_indices[offset]];
-  for (const int i : IndexRange(offset, count).drop_front(1)) {
-    node->bounds = bounds::merge(node->bounds, prim_bounds[prim_indices[i]]);
-  }
-  node->bounds_orig = node->bounds;
+      node.face_vert_indices.reinitialize(node_prims.size());
+      for (const int j : node_prims.index_range()) {
+        const int3 &tri = corner_tris[node_prims[j]];
+        for (int k = 0; k < 3; k++) {
+          const int vert = corner_verts[tri[k]];
+          const int sorted_index = std::lower_bound(
+                                       sorted_verts.begin(), sorted_verts.end(), vert) -
+                                   sorted_verts.begin();
+          node.face_vert_indices[j][k] = new_indices[sorted_index];
+        }
+      }
+
+      const bool fully_hidden = !hide_poly.is_empty() &&
+                                std::all_of(
+                                    node_prims.begin(), node_prims.end(), [&](const int tri) {
+                                      return hide_poly[tri_faces[tri]];
+                                    });
+      BKE_pbvh_node_fully_hidden_set(&node, fully_hidden);
+      BKE_pbvh_node_mark_rebuild_draw(&node);
+    }
+  });
 }
 
 int count_grid_quads(const BitGroupVector<> &grid_hidden,
@@ -304,36 +493,9 @@ static void build_grid_leaf_node(PBVH &pbvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
-static void build_leaf(PBVH &pbvh,
-                       const Span<int> corner_verts,
-                       const Span<int3> corner_tris,
-                       const Span<int> tri_faces,
-                       const Span<bool> hide_poly,
-                       MutableSpan<bool> vert_bitmap,
-                       int node_index,
-                       const Span<Bounds<float3>> prim_bounds,
-                       int offset,
-                       int count)
-{
-  PBVHNode &node = pbvh.nodes[node_index];
-  node.flag |= PBVH_Leaf;
-
-  node.prim_indices = pbvh.prim_indices.as_span().slice(offset, count);
-
-  /* Still need vb for searches */
-  update_vb(pbvh.prim_indices, &node, prim_bounds, offset, count);
-
-  if (!corner_tris.is_empty()) {
-    build_mesh_leaf_node(corner_verts, corner_tris, tri_faces, hide_poly, vert_bitmap, &node);
-  }
-  else {
-    build_grid_leaf_node(pbvh, &node);
-  }
-}
-
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
-static bool leaf_needs_material_split(PBVH &pbvh,
+static bool leaf_needs_material_split(const Span<int> prim_indices,
                                       const Span<int> prim_to_face_map,
                                       const Span<int> material_indices,
                                       const Span<bool> sharp_faces,
@@ -344,9 +506,9 @@ static bool leaf_needs_material_split(PBVH &pbvh,
     return false;
   }
 
-  const int first = prim_to_face_map[pbvh.prim_indices[offset]];
+  const int first = prim_to_face_map[prim_indices[offset]];
   for (int i = offset + count - 1; i > offset; i--) {
-    int prim = pbvh.prim_indices[i];
+    int prim = prim_indices[i];
     if (!face_materials_match(material_indices, sharp_faces, first, prim_to_face_map[prim])) {
       return true;
     }
@@ -389,147 +551,130 @@ static void test_face_boundaries(PBVH &pbvh, const Mesh &mesh)
 }
 #endif
 
-/* Recursively build a node in the tree
- *
- * vb is the voxel box around all of the primitives contained in
- * this node.
- *
- * cb is the bounding box around all the centroids of the primitives
- * contained in this node
- *
- * offset and start indicate a range in the array of primitive indices
- */
-
-static void build_sub(PBVH &pbvh,
-                      const Span<int> corner_verts,
-                      const Span<int3> corner_tris,
-                      const Span<int> tri_faces,
-                      const Span<bool> hide_poly,
-                      const Span<int> material_indices,
-                      const Span<bool> sharp_faces,
-                      const int leaf_limit,
-                      MutableSpan<bool> vert_bitmap,
-                      int node_index,
-                      const Bounds<float3> *cb,
-                      const Span<Bounds<float3>> prim_bounds,
-                      int offset,
-                      int count,
-                      int *prim_scratch,
-                      int depth)
-{
-  const Span<int> prim_to_face_map = pbvh.header.type == PBVH_FACES ?
-                                         tri_faces :
-                                         pbvh.subdiv_ccg->grid_to_face_map;
-  int end;
+/** A node of the tree, before the final #PBVHNode array is created. */
+struct BuildNode {
+  /** The range in #PBVH::prim_indices. */
+  IndexRange prims;
+  /** Index of the first child in the node array, or zero for leaf nodes. */
+  int children_offset = 0;
+};
 
-  if (!prim_scratch) {
-    prim_scratch = static_cast<int *>(
-        MEM_malloc_arrayN(pbvh.prim_indices.size(), sizeof(int), __func__));
-  }
+struct BuildContext {
+  MutableSpan<int> prim_indices;
+  MutableSpan<int> prim_scratch;
+  Span<Bounds<float3>> prim_bounds;
+  Span<int> prim_to_face_map;
+  Span<int> material_indices;
+  Span<bool> sharp_faces;
+  int leaf_limit;
+};
 
+/**
+ * Recursively partition a range of primitives and return the nodes of the sub-tree. As in the
+ * final tree, the two children of a node are stored next to each other and the sub-tree of the
+ * first child comes before the sub-tree of the second. Large sub-trees are built in parallel.
+ *
+ * cb is the bounding box around all the centroids of the primitives contained in this node
+ */
+static Vector<BuildNode> build_nodes_recursive(const BuildContext &ctx,
+                                               const IndexRange prims,
+                                               const Bounds<float3> *cb,
+                                               const int depth)
+{
   /* Decide whether this is a leaf or not */
-  const bool below_leaf_limit = count <= leaf_limit || depth >= STACK_FIXED_DEPTH - 1;
+  const bool below_leaf_limit = prims.size() <= ctx.leaf_limit || depth >= STACK_FIXED_DEPTH - 1;
   if (below_leaf_limit) {
-    if (!leaf_needs_material_split(
-            pbvh, prim_to_face_map, material_indices, sharp_faces, offset, count))
+    if (!leaf_needs_material_split(ctx.prim_indices,
+                                   ctx.prim_to_face_map,
+                                   ctx.material_indices,
+                                   ctx.sharp_faces,
+                                   prims.start(),
+                                   prims.size()))
     {
-      build_leaf(pbvh,
-                 corner_verts,
-                 corner_tris,
-                 tri_faces,
-                 hide_poly,
-                 vert_bitmap,
-                 node_index,
-                 prim_bounds,
-                 offset,
-                 count);
-
-      if (node_index == 0) {
-        MEM_SAFE_FREE(prim_scratch);
-      }
-
-      return;
+      return {{prims}};
     }
   }
 
-  /* Add two child nodes */
-  pbvh.nodes[node_index].children_offset = pbvh.nodes.size();
-  pbvh.nodes.resize(pbvh.nodes.size() + 2);
-
-  /* Update parent node bounding box */
-  update_vb(pbvh.prim_indices, &pbvh.nodes[node_index], prim_bounds, offset, count);
-
-  Bounds<float3> cb_backing;
+  int end;
   if (!below_leaf_limit) {
     /* Find axis with widest range of primitive centroids */
+    const Span<int> prim_indices = ctx.prim_indices.slice(prims);
+    Bounds<float3> cb_backing;
     if (!cb) {
-      cb_backing = negative_bounds();
-      for (int i = offset + count - 1; i >= offset; i--) {
-        const int prim = pbvh.prim_indices[i];
-        const float3 center = math::midpoint(prim_bounds[prim].min, prim_bounds[prim].max);
-        math::min_max(center, cb_backing.min, cb_backing.max);
-      }
+      cb_backing = calc_prims_center_bounds(prim_indices, ctx.prim_bounds);
       cb = &cb_backing;
     }
     const int axis = math::dominant_axis(cb->max - cb->min);
 
-    /* Partition primitives along that axis */
-    end = partition_prim_indices(pbvh.prim_indices,
-                                 prim_scratch,
-                                 offset,
-                                 offset + count,
-                                 axis,
-                                 math::midpoint(cb->min[axis], cb->max[axis]),
-                                 prim_bounds,
-                                 prim_to_face_map);
+    /* Partition primitives along that axis. At the top levels, the split position is chosen
+     * with binned surface area heuristic, below the middle of the centroids is good enough. */
+    const float split = prims.size() > int64_t(ctx.leaf_limit) * SPLIT_BINNED_LEAVES_MIN ?
+                            find_split_position(prim_indices, ctx.prim_bounds, *cb, axis) :
+                            math::midpoint(cb->min[axis], cb->max[axis]);
+    end = prims.start() + partition_prim_indices(ctx.prim_indices.slice(prims),
+                                                 ctx.prim_scratch.slice(prims),
+                                                 axis,
+                                                 split,
+                                                 ctx.prim_bounds,
+                                                 ctx.prim_to_face_map);
+    if (end == prims.start() || end == prims.one_after_last()) {
+      /* All centroids are on one side, split in the middle at a face boundary instead. */
+      end = prims.start() + prims.size() / 2;
+      while (end < prims.one_after_last() &&
+             ctx.prim_to_face_map[ctx.prim_indices[end]] ==
+                 ctx.prim_to_face_map[ctx.prim_indices[end - 1]])
+      {
+        end++;
+      }
+      if (end == prims.one_after_last()) {
+        return {{prims}};
+      }
+    }
   }
   else {
     /* Partition primitives by material */
-    end = partition_indices_material_faces(pbvh.prim_indices,
-                                           prim_to_face_map,
-                                           material_indices,
-                                           sharp_faces,
-                                           offset,
-                                           offset + count - 1);
+    end = partition_indices_material_faces(ctx.prim_indices,
+                                           ctx.prim_to_face_map,
+                                           ctx.material_indices,
+                                           ctx.sharp_faces,
+                                           prims.start(),
+                                           prims.last());
   }
 
   /* Build children */
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            pbvh.nodes[node_index].children_offset,
-            nullptr,
-            prim_bounds,
-            offset,
-            end - offset,
-            prim_scratch,
-            depth + 1);
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            pbvh.nodes[node_index].children_offset + 1,
-            nullptr,
-            prim_bounds,
-            end,
-            offset + count - end,
-            prim_scratch,
-            depth + 1);
-
-  if (node_index == 0) {
-    MEM_SAFE_FREE(prim_scratch);
+  Vector<BuildNode> left;
+  Vector<BuildNode> right;
+  threading::parallel_invoke(
+      prims.size() > PARALLEL_BUILD_PRIMS_MIN,
+      [&]() {
+        left = build_nodes_recursive(
+            ctx, IndexRange::from_begin_end(prims.start(), end), nullptr, depth + 1);
+      },
+      [&]() {
+        right = build_nodes_recursive(
+            ctx, IndexRange::from_begin_end(end, prims.one_after_last()), nullptr, depth + 1);
+      });
+
+  const auto shifted = [](BuildNode node, const int shift) {
+    if (node.children_offset != 0) {
+      node.children_offset += shift;
+    }
+    return node;
+  };
+  const int left_shift = 2;
+  const int right_shift = left.size() + 1;
+  Vector<BuildNode> nodes;
+  nodes.reserve(left.size() + right.size() + 1);
+  nodes.append({prims, 1});
+  nodes.append(shifted(left.first(), left_shift));
+  nodes.append(shifted(right.first(), right_shift));
+  for (const BuildNode &node : left.as_span().drop_front(1)) {
+    nodes.append(shifted(node, left_shift));
+  }
+  for (const BuildNode &node : right.as_span().drop_front(1)) {
+    nodes.append(shifted(node, right_shift));
   }
+  return nodes;
 }
 
 static void pbvh_build(PBVH &pbvh,
@@ -540,7 +685,7 @@ static void pbvh_build(PBVH &pbvh,
                        const Span<int> material_indices,
                        const Span<bool> sharp_faces,
                        const int leaf_limit,
-                       MutableSpan<bool> vert_bitmap,
+                       const int verts_num,
                        const Bounds<float3> *cb,
                        const Span<Bounds<float3>> prim_bounds,
                        int totprim)
@@ -550,24 +695,66 @@ static void pbvh_build(PBVH &pbvh,
   pbvh.prim_indices.reinitialize(totprim);
   array_utils::fill_index_range<int>(pbvh.prim_indices);
 
-  pbvh.nodes.resize(1);
-
-  build_sub(pbvh,
-            corner_verts,
-            corner_tris,
-            tri_faces,
-            hide_poly,
-            material_indices,
-            sharp_faces,
-            leaf_limit,
-            vert_bitmap,
-            0,
-            cb,
-            prim_bounds,
-            0,
-            totprim,
-            nullptr,
-            0);
+  Array<int> prim_scratch(totprim);
+  BuildContext ctx;
+  ctx.prim_indices = pbvh.prim_indices;
+  ctx.prim_scratch = prim_scratch;
+  ctx.prim_bounds = prim_bounds;
+  ctx.prim_to_face_map = pbvh.header.type == PBVH_FACES ? tri_faces :
+                                                          pbvh.subdiv_ccg->grid_to_face_map;
+  ctx.material_indices = material_indices;
+  ctx.sharp_faces = sharp_faces;
+  ctx.leaf_limit = leaf_limit;
+  const Vector<BuildNode> build_nodes = build_nodes_recursive(
+      ctx, pbvh.prim_indices.index_range(), cb, 0);
+
+  pbvh.nodes.resize(build_nodes.size());
+  Vector<int> leaf_indices;
+  for (const int i : build_nodes.index_range()) {
+    PBVHNode &node = pbvh.nodes[i];
+    node.children_offset = build_nodes[i].children_offset;
+    if (node.children_offset == 0) {
+      node.flag |= PBVH_Leaf;
+      node.prim_indices = pbvh.prim_indices.as_span().slice(build_nodes[i].prims);
+      leaf_indices.append(i);
+    }
+  }
+
+  /* Still need vb for searches */
+  threading::parallel_for(leaf_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : leaf_indices.as_span().slice(range)) {
+      PBVHNode &node = pbvh.nodes[i];
+      node.bounds = calc_prims_bounds(node.prim_indices, prim_bounds);
+      node.bounds_orig = node.bounds;
+    }
+  });
+  /* Children are always stored after their parent. */
+  for (int i = pbvh.nodes.size() - 1; i >= 0; i--) {
+    PBVHNode &node = pbvh.nodes[i];
+    if (node.children_offset != 0) {
+      node.bounds = bounds::merge(pbvh.nodes[node.children_offset].bounds,
+                                  pbvh.nodes[node.children_offset + 1].bounds);
+      node.bounds_orig = node.bounds;
+    }
+  }
+
+  if (!corner_tris.is_empty()) {
+    build_mesh_leaf_nodes(verts_num,
+                          corner_verts,
+                          corner_tris,
+                          tri_faces,
+                          hide_poly,
+                          pbvh.prim_indices,
+                          leaf_indices,
+                          pbvh.nodes);
+  }
+  else {
+    threading::parallel_for(leaf_indices.index_range(), 8, [&](const IndexRange range) {
+      for (const int i : leaf_indices.as_span().slice(range)) {
+        build_grid_leaf_node(pbvh, &pbvh.nodes[i]);
+      }
+    });
+  }
 }
 
 #ifdef VALIDATE_UNIQUE_NODE_FACES
@@ -663,8 +850,6 @@ std::unique_ptr<PBVH> build_mesh(Mesh *mesh)
   update_mesh_pointers(*pbvh, mesh);
   const Span<int> tri_faces = mesh->corner_tri_faces();
 
-  Array<bool> vert_bitmap(mesh->verts_num, false);
-
 #ifdef TEST_PBVH_FACE_SPLIT
   /* Use lower limit to increase probability of
    * edge cases.
@@ -708,7 +893,7 @@ std::unique_ptr<PBVH> build_mesh(Mesh *mesh)
                material_index,
                sharp_face,
                leaf_limit,
-               vert_bitmap,
+               mesh->verts_num,
                &cb,
                prim_bounds,
                corner_tris.size());
@@ -785,7 +970,7 @@ std::unique_ptr<PBVH> build_grids(Mesh *mesh, SubdivCCG *subdiv_ccg)
                material_index,
                sharp_face,
                leaf_limit,
-               {},
+               0,
                &cb,
                prim_bounds,
                grids.size());
@@ -1615,6 +1800,81 @@ IndexMask nodes_to_face_selection_grids(const SubdivCCG &subdiv_ccg,
   return IndexMask::from_bools(faces_to_update, memory);
 }
 
+void leaf_contiguous_orders_calc(const PBVH &pbvh,
+                                 const Mesh &mesh,
+                                 Array<int> &r_vert_order,
+                                 Array<int> &r_face_order)
+{
+  BLI_assert(pbvh.header.type == PBVH_FACES);
+  const Span<int> tri_faces = mesh.corner_tri_faces();
+
+  /* The primitive order of the leaves corresponds to a depth first traversal of the tree. */
+  Vector<const PBVHNode *> leaves;
+  for (const PBVHNode &node : pbvh.nodes) {
+    if (node.flag & PBVH_Leaf && !node.prim_indices.is_empty()) {
+      leaves.append(&node);
+    }
+  }
+  std::sort(leaves.begin(), leaves.end(), [](const PBVHNode *a, const PBVHNode *b) {
+    return a->prim_indices.data() < b->prim_indices.data();
+  });
+
+  /* The triangles of every face are stored next to each other in the leaves. */
+  const auto for_each_face = [&](const PBVHNode &node, const FunctionRef<void(int)> fn) {
+    const Span<int> tris = node.prim_indices;
+    for (const int i : tris.index_range()) {
+      if (i == 0 || tri_faces[tris[i]] != tri_faces[tris[i - 1]]) {
+        fn(tri_faces[tris[i]]);
+      }
+    }
+  };
+
+  Array<int> vert_offsets_data(leaves.size() + 1);
+  Array<int> face_offsets_data(leaves.size() + 1);
+  threading::parallel_for(leaves.index_range(), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      vert_offsets_data[i] = leaves[i]->uniq_verts;
+      int faces_num = 0;
+      for_each_face(*leaves[i], [&](const int /*face*/) { faces_num++; });
+      face_offsets_data[i] = faces_num;
+    }
+  });
+  const OffsetIndices vert_offsets = offset_indices::accumulate_counts_to_offsets(
+      vert_offsets_data);
+  const OffsetIndices face_offsets = offset_indices::accumulate_counts_to_offsets(
+      face_offsets_data);
+  BLI_assert(face_offsets.total_size() == mesh.faces_num);
+
+  r_vert_order.reinitialize(mesh.verts_num);
+  r_face_order.reinitialize(mesh.faces_num);
+  threading::parallel_for(leaves.index_range(), 64, [&](const IndexRange range) {
+    for (const int i : range) {
+      r_vert_order.as_mutable_span()
+          .slice(vert_offsets[i])
+          .copy_from(node_unique_verts(*leaves[i]));
+      int face_index = face_offsets[i].start();
+      for_each_face(*leaves[i], [&](const int face) { r_face_order[face_index++] = face; });
+    }
+  });
+
+  /* Append the loose vertices that aren't part of any node. */
+  if (vert_offsets.total_size() < mesh.verts_num) {
+    Array<bool> vert_used(mesh.verts_num, false);
+    const Span<int> used_verts = r_vert_order.as_span().take_front(vert_offsets.total_size());
+    threading::parallel_for(used_verts.index_range(), 4096, [&](const IndexRange range) {
+      for (const int vert : used_verts.slice(range)) {
+        vert_used[vert] = true;
+      }
+    });
+    int vert_index = vert_offsets.total_size();
+    for (const int vert : vert_used.index_range()) {
+      if (!vert_used[vert]) {
+        r_vert_order[vert_index++] = vert;
+      }
+    }
+  }
+}
+
 Bounds<float3> bounds_get(const PBVH &pbvh)
 {
   if (pbvh.nodes.is_empty()) {
@@ -1649,17 +1909,17 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawMask | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawColor | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_face_sets(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawFaceSets | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_mark_rebuild_pixels(PBVH &pbvh)
@@ -1689,7 +1949,7 @@ void BKE_pbvh_node_mark_redraw(PBVHNode *node)
 
 void BKE_pbvh_node_mark_positions_update(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateNormals | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw | PBVH_UpdateBB;
+  node->flag |= PBVH_UpdateNormals | PBVH_UpdateDrawPositions | PBVH_UpdateRedraw | PBVH_UpdateBB;
 }
 
 void BKE_pbvh_node_fully_hidden_set(PBVHNode *node, int fully_hidden)
@@ -2616,6 +2876,11 @@ static blender::draw::pbvh::PBVH_GPU_Args pbvh_draw_args_init(const Mesh &mesh,
 
 namespace blender::bke::pbvh {
 
+/** All flags that require updating some or all of the draw buffers of a node. */
+static constexpr PBVHNodeFlags UPDATE_DRAW_FLAGS = PBVH_UpdateDrawBuffers |
+                                                   PBVH_UpdateDrawPositions | PBVH_UpdateDrawMask |
+                                                   PBVH_UpdateDrawColor | PBVH_UpdateDrawFaceSets;
+
 static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &node)
 {
   /* Create and update draw buffers. The functions called here must not
@@ -2626,12 +2891,12 @@ static void node_update_draw_buffers(const Mesh &mesh, PBVH &pbvh, PBVHNode &nod
     node.draw_batches = blender::draw::pbvh::node_create(args);
   }
 
-  if (node.flag & PBVH_UpdateDrawBuffers) {
+  if (node.flag & UPDATE_DRAW_FLAGS) {
     node.debug_draw_gen++;
 
     if (node.draw_batches) {
       const blender::draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, node);
-      blender::draw::pbvh::node_update(node.draw_batches, args);
+      blender::draw::pbvh::node_update(node.draw_batches, args, node.flag);
     }
   }
 }
@@ -2660,7 +2925,7 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
       if (node->flag & PBVH_RebuildDrawBuffers) {
         free_draw_buffers(pbvh, node);
       }
-      else if ((node->flag & PBVH_UpdateDrawBuffers) && node->draw_batches) {
+      else if ((node->flag & UPDATE_DRAW_FLAGS) && node->draw_batches) {
         const draw::pbvh::PBVH_GPU_Args args = pbvh_draw_args_init(mesh, pbvh, *node);
         draw::pbvh::update_pre(node->draw_batches, args);
       }
@@ -2676,14 +2941,14 @@ static void pbvh_update_draw_buffers(const Mesh &mesh,
 
   /* Flush buffers uses OpenGL, so not in parallel. */
   for (PBVHNode *node : nodes) {
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if (node->flag & UPDATE_DRAW_FLAGS) {
 
       if (node->draw_batches) {
         draw::pbvh::node_gpu_flush(node->draw_batches);
       }
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | UPDATE_DRAW_FLAGS);
   }
 }
 
@@ -2704,16 +2969,16 @@ void draw_cb(const Mesh &mesh,
       update_flag |= node.flag;
       return true;
     });
-    if (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers)) {
+    if (update_flag & (PBVH_RebuildDrawBuffers | UPDATE_DRAW_FLAGS)) {
       pbvh_update_draw_buffers(mesh, pbvh, nodes, update_flag);
     }
   }
   else {
     /* Get all nodes with draw updates, also those outside the view. */
     Vector<PBVHNode *> nodes = search_gather(pbvh, [&](PBVHNode &node) {
-      return update_search(&node, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+      return update_search(&node, PBVH_RebuildDrawBuffers | UPDATE_DRAW_FLAGS);
     });
-    pbvh_update_draw_buffers(mesh, pbvh, nodes, PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    pbvh_update_draw_buffers(mesh, pbvh, nodes, PBVH_RebuildDrawBuffers | UPDATE_DRAW_FLAGS);
   }
 
   /* Draw visible nodes. */
@@ -8,6 +8,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_bounds.hh"
 #include "BLI_ghash.h"
 #include "BLI_heap_simple.h"
@@ -16,8 +17,10 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_ccg.hh"
 #include "BKE_pbvh_api.hh"
@@ -931,54 +934,85 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face. */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
-#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+  return q->edge_queue_tri_in_range(q, f);
+}
+
+/**
+ * Find the faces of the leaf nodes marked for topology update that are in range of the brush.
+ * The geometric tests are the most expensive part of creating the edge queues on large meshes.
+ * They only read the mesh, so unlike the queue insertion they are done for all nodes in parallel.
+ * The faces are returned in the same order as when iterating over the nodes serially.
+ */
+static Vector<BMFace *> edge_queue_faces_in_range(const EdgeQueue *q, PBVH &pbvh)
+{
+  Vector<PBVHNode *> nodes;
+  for (PBVHNode &node : pbvh.nodes) {
+    /* Check leaf nodes marked for topology update. */
+    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
+        !(node.flag & PBVH_FullyHidden))
+    {
+      nodes.append(&node);
+    }
+  }
+
+  Array<Vector<BMFace *>> faces_by_node(nodes.size());
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : nodes[i]->bm_faces) {
+        if (edge_queue_face_in_range(q, f)) {
+          faces_by_node[i].append(f);
+        }
       }
-#else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
-#endif
-    } while ((l_iter = l_iter->next) != l_first);
+    }
+  });
+
+  Vector<BMFace *> faces;
+  for (const Vector<BMFace *> &node_faces : faces_by_node) {
+    faces.extend(node_faces);
   }
+  return faces;
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/** Add the long edges of a face that is in range to the queue. */
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  /* Check each edge of the face. */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
+#ifdef USE_EDGEQUEUE_EVEN_SUBDIV
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
     }
-  }
+#else
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
+  } while ((l_iter = l_iter->next) != l_first);
+}
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+/** Add the short edges of a face that is in range to the queue. */
+static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  BMLoop *l_iter;
+  BMLoop *l_first;
 
-    /* Check each edge of the face. */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  /* Check each edge of the face. */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
 }
 
 /**
@@ -1027,15 +1061,8 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (PBVHNode &node : pbvh.nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  for (BMFace *f : edge_queue_faces_in_range(eq_ctx->q, pbvh)) {
+    long_edge_queue_face_add(eq_ctx, f);
   }
 }
 
@@ -1081,15 +1108,8 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (PBVHNode &node : pbvh.nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag & PBVH_Leaf) && (node.flag & PBVH_UpdateTopology) &&
-        !(node.flag & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
+  for (BMFace *f : edge_queue_faces_in_range(eq_ctx->q, pbvh)) {
+    short_edge_queue_face_add(eq_ctx, f);
   }
 }
 
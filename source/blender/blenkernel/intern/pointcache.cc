@@ -12,6 +12,7 @@
 #include <cstring>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <zstd.h>
 
 /* needed for directory lookup */
 #ifndef WIN32
@@ -40,8 +41,10 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -82,6 +85,9 @@
 
 #define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
 
+/* Low levels of zstd compress quickly and still reduce the size of point caches well. */
+#define PTCACHE_ZSTD_COMPRESSION_LEVEL 3
+
 #ifdef WITH_LZMA
 #  include "LzmaLib.h"
 #endif
@@ -1501,54 +1507,80 @@ static void ptcache_file_close(PTCacheFile *pf)
   }
 }
 
-static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
-{
-  int r = 0;
+/** Data written by #ptcache_file_compressed_write, read from the file but not decompressed. */
+struct PTCacheCompressedBlock {
   uchar compressed = 0;
-  size_t in_len;
-#ifdef WITH_LZO
-  size_t out_len = len;
-#endif
-  uchar *in;
-  uchar *props = static_cast<uchar *>(MEM_callocN(sizeof(char[16]), "tmp"));
+  blender::Vector<uchar> in;
+  blender::Vector<uchar> props;
+};
 
-  ptcache_file_read(pf, &compressed, 1, sizeof(uchar));
-  if (compressed) {
-    uint size;
+/**
+ * Read the compressed data of an array from the file. When the array was not compressed, it is
+ * read into the result directly.
+ */
+static void ptcache_file_compressed_block_read(PTCacheFile *pf,
+                                               PTCacheCompressedBlock &block,
+                                               uchar *result,
+                                               uint len)
+{
+  ptcache_file_read(pf, &block.compressed, 1, sizeof(uchar));
+  if (block.compressed) {
+    uint size = 0;
     ptcache_file_read(pf, &size, 1, sizeof(uint));
-    in_len = size_t(size);
-    if (in_len == 0) {
+    if (size == 0) {
       /* do nothing */
     }
     else {
-      in = (uchar *)MEM_callocN(sizeof(uchar) * in_len, "pointcache_compressed_buffer");
-      ptcache_file_read(pf, in, in_len, sizeof(uchar));
-#ifdef WITH_LZO
-      if (compressed == 1) {
-        r = lzo1x_decompress_safe(in, (lzo_uint)in_len, result, (lzo_uint *)&out_len, nullptr);
-      }
-#endif
-#ifdef WITH_LZMA
-      if (compressed == 2) {
-        size_t sizeOfIt;
-        size_t leni = in_len, leno = len;
+      block.in.resize(size);
+      ptcache_file_read(pf, block.in.data(), size, sizeof(uchar));
+      if (block.compressed == PTCACHE_COMPRESS_LZMA) {
         ptcache_file_read(pf, &size, 1, sizeof(uint));
-        sizeOfIt = size_t(size);
-        ptcache_file_read(pf, props, sizeOfIt, sizeof(uchar));
-        r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
+        block.props.resize(size);
+        ptcache_file_read(pf, block.props.data(), size, sizeof(uchar));
       }
-#endif
-      MEM_freeN(in);
     }
   }
   else {
     ptcache_file_read(pf, result, len, sizeof(uchar));
   }
+}
 
-  MEM_freeN(props);
-
+/** Decompress the data of a block, this doesn't access the file and can run in parallel. */
+static int ptcache_compressed_block_decode(const PTCacheCompressedBlock &block,
+                                           uchar *result,
+                                           uint len)
+{
+  int r = 0;
+  if (block.in.is_empty()) {
+    return r;
+  }
+#ifdef WITH_LZO
+  if (block.compressed == PTCACHE_COMPRESS_LZO) {
+    size_t out_len = len;
+    r = lzo1x_decompress_safe(
+        block.in.data(), (lzo_uint)block.in.size(), result, (lzo_uint *)&out_len, nullptr);
+  }
+#endif
+#ifdef WITH_LZMA
+  if (block.compressed == PTCACHE_COMPRESS_LZMA) {
+    size_t leni = block.in.size(), leno = len;
+    r = LzmaUncompress(
+        result, &leno, block.in.data(), &leni, block.props.data(), size_t(block.props.size()));
+  }
+#endif
+  if (block.compressed == PTCACHE_COMPRESS_ZSTD) {
+    const size_t out_len = ZSTD_decompress(result, len, block.in.data(), block.in.size());
+    r = ZSTD_isError(out_len) ? -1 : 0;
+  }
   return r;
 }
+
+static int ptcache_file_compressed_read(PTCacheFile *pf, uchar *result, uint len)
+{
+  PTCacheCompressedBlock block;
+  ptcache_file_compressed_block_read(pf, block, result, len);
+  return ptcache_compressed_block_decode(block, result, len);
+}
 static int ptcache_file_compressed_write(
     PTCacheFile *pf, uchar *in, uint in_len, uchar *out, int mode)
 {
@@ -1599,6 +1631,18 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == PTCACHE_COMPRESS_ZSTD) {
+    /* The output buffers are allocated for LZO, which needs more space than the bound of zstd. */
+    BLI_assert(ZSTD_compressBound(in_len) <= LZO_OUT_LEN(in_len) * 4);
+    out_len = ZSTD_compress(
+        out, ZSTD_compressBound(in_len), in, in_len, PTCACHE_ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = PTCACHE_COMPRESS_ZSTD;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(uchar));
   if (compressed) {
@@ -1959,12 +2003,24 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
     ptcache_data_alloc(pm);
 
     if (pf->flag & PTCACHE_TYPEFLAG_COMPRESS) {
+      /* Read the data of all types first, so that they can be decompressed in parallel. */
+      PTCacheCompressedBlock blocks[BPHYS_TOT_DATA];
       for (i = 0; i < BPHYS_TOT_DATA; i++) {
         uint out_len = pm->totpoint * ptcache_data_size[i];
         if (pf->data_types & (1 << i)) {
-          ptcache_file_compressed_read(pf, (uchar *)(pm->data[i]), out_len);
+          ptcache_file_compressed_block_read(pf, blocks[i], (uchar *)(pm->data[i]), out_len);
         }
       }
+      blender::threading::parallel_for(
+          blender::IndexRange(BPHYS_TOT_DATA), 1, [&](const blender::IndexRange range) {
+            for (const int64_t type : range) {
+              if (pf->data_types & (1 << type)) {
+                ptcache_compressed_block_decode(blocks[type],
+                                                (uchar *)(pm->data[type]),
+                                                pm->totpoint * ptcache_data_size[type]);
+              }
+            }
+          });
     }
     else {
       void *cur[BPHYS_TOT_DATA];
@@ -23,6 +23,8 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1748,6 +1750,34 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
+static bool rigidbody_sim_ob_uses_deform_shape(const RigidBodyOb *rbo)
+{
+  return rbo->shared->physics_object != nullptr && rbo->shape == RB_SHAPE_TRIMESH &&
+         rbo->flag & RBO_FLAG_USE_DEFORM;
+}
+
+/**
+ * Update the collision shape of a deforming mesh. This only changes data of the shape itself,
+ * so different objects can be updated in parallel.
+ */
+static void rigidbody_update_sim_ob_deform_shape(Object *ob, RigidBodyOb *rbo)
+{
+  const Mesh *mesh = BKE_object_get_mesh_deform_eval(ob);
+  if (mesh) {
+    const float(*positions)[3] = reinterpret_cast<const float(*)[3]>(
+        mesh->vert_positions().data());
+    int totvert = mesh->verts_num;
+    const std::optional<blender::Bounds<blender::float3>> bounds = BKE_object_boundbox_get(ob);
+
+    RB_shape_trimesh_update(static_cast<rbCollisionShape *>(rbo->shared->physics_shape),
+                            (float *)positions,
+                            totvert,
+                            sizeof(float[3]),
+                            bounds->min,
+                            bounds->max);
+  }
+}
+
 static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
@@ -1755,29 +1785,6 @@ static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyO
     return;
   }
 
-  const Scene *scene = DEG_get_input_scene(depsgraph);
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  BKE_view_layer_synced_ensure(scene, view_layer);
-  Base *base = BKE_view_layer_base_find(view_layer, ob);
-  const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
-
-  if (rbo->shape == RB_SHAPE_TRIMESH && rbo->flag & RBO_FLAG_USE_DEFORM) {
-    const Mesh *mesh = BKE_object_get_mesh_deform_eval(ob);
-    if (mesh) {
-      const float(*positions)[3] = reinterpret_cast<const float(*)[3]>(
-          mesh->vert_positions().data());
-      int totvert = mesh->verts_num;
-      const std::optional<blender::Bounds<blender::float3>> bounds = BKE_object_boundbox_get(ob);
-
-      RB_shape_trimesh_update(static_cast<rbCollisionShape *>(rbo->shared->physics_shape),
-                              (float *)positions,
-                              totvert,
-                              sizeof(float[3]),
-                              bounds->min,
-                              bounds->max);
-    }
-  }
-
   if (!(rbo->flag & RBO_FLAG_KINEMATIC)) {
     /* update scale for all non kinematic objects */
     float new_scale[3], old_scale[3];
@@ -1798,9 +1805,16 @@ static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyO
 
   /* Make transformed objects temporarily kinematic
    * so that they can be moved by the user during simulation. */
-  if (is_selected && (G.moving & G_TRANSFORM_OBJ)) {
-    RB_body_set_kinematic_state(static_cast<rbRigidBody *>(rbo->shared->physics_object), true);
-    RB_body_set_mass(static_cast<rbRigidBody *>(rbo->shared->physics_object), 0.0f);
+  if (G.moving & G_TRANSFORM_OBJ) {
+    /* Only look up the selection while transforming, this is not free with many objects. */
+    const Scene *scene = DEG_get_input_scene(depsgraph);
+    ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    Base *base = BKE_view_layer_base_find(view_layer, ob);
+    if (base && (base->flag & BASE_SELECTED)) {
+      RB_body_set_kinematic_state(static_cast<rbRigidBody *>(rbo->shared->physics_object), true);
+      RB_body_set_mass(static_cast<rbRigidBody *>(rbo->shared->physics_object), 0.0f);
+    }
   }
 
   /* NOTE: no other settings need to be explicitly updated here,
@@ -1848,6 +1862,9 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Objects are validated in order, because that adds them to the Bullet world. */
+  blender::Vector<Object *> sim_objects;
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1899,12 +1916,26 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       }
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
-      /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, ob, rbo);
+      sim_objects.append(ob);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  /* Deforming collision shapes are independent, update them in parallel. */
+  blender::threading::parallel_for(
+      sim_objects.index_range(), 16, [&](const blender::IndexRange range) {
+        for (Object *ob : sim_objects.as_span().slice(range)) {
+          if (rigidbody_sim_ob_uses_deform_shape(ob->rigidbody_object)) {
+            rigidbody_update_sim_ob_deform_shape(ob, ob->rigidbody_object);
+          }
+        }
+      });
+
+  /* update simulation objects... */
+  for (Object *ob : sim_objects) {
+    rigidbody_update_sim_ob(depsgraph, ob, ob->rigidbody_object);
+  }
+
   /* update constraints */
   if (rbw->constraints == nullptr) { /* no constraints, move on */
     return;
@@ -2111,6 +2142,11 @@ static void rigidbody_free_substep_data(ListBase *substep_targets)
 }
 static void rigidbody_update_simulation_post_step(Depsgraph *depsgraph, RigidBodyWorld *rbw)
 {
+  /* Only objects that are transformed were made temporarily kinematic. */
+  if (!(G.moving & G_TRANSFORM_OBJ)) {
+    return;
+  }
+
   const Scene *scene = DEG_get_input_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
   BKE_view_layer_synced_ensure(scene, view_layer);
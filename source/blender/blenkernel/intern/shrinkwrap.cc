@@ -18,11 +18,16 @@
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_bounds.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_solvers.h"
 #include "BLI_math_vector.h"
+#include "BLI_sort.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_attribute.hh"
@@ -84,8 +89,14 @@ struct ShrinkwrapCalcCBData {
 
   float *proj_axis;
   SpaceTransform *local2aux;
+
+  /** Order in which the vertices are queried, when null they are queried in index order. */
+  const int *query_order;
 };
 
+/** Number of vertices from which the nearest point queries are multi-threaded and sorted. */
+#define SHRINKWRAP_NEAREST_THREADING_THRESHOLD 10000
+
 bool BKE_shrinkwrap_needs_normals(int shrinkType, int shrinkMode)
 {
   return (shrinkType == MOD_SHRINKWRAP_TARGET_PROJECT) ||
@@ -299,6 +310,48 @@ const ShrinkwrapBoundaryData &boundary_cache_ensure(const Mesh &mesh)
 
 }  // namespace blender::bke::shrinkwrap
 
+/** Spread the lowest 10 bits of the value so that there are two zero bits between them. */
+static uint32_t morton_expand_bits(uint32_t v)
+{
+  v &= 0x3ffu;
+  v = (v | (v << 16)) & 0x030000ffu;
+  v = (v | (v << 8)) & 0x0300f00fu;
+  v = (v | (v << 4)) & 0x030c30c3u;
+  v = (v | (v << 2)) & 0x09249249u;
+  return v;
+}
+
+/**
+ * Sort the vertices along a Morton curve, so that consecutive nearest point queries are close
+ * to each other. The hit of the previous vertex is then a tight initial search distance, and the
+ * visited BVH nodes are likely to still be in the CPU cache.
+ */
+static blender::Array<int> shrinkwrap_coherent_query_order(const ShrinkwrapCalcData *calc)
+{
+  using namespace blender;
+  const Span<float3> positions(reinterpret_cast<const float3 *>(
+                                   calc->vert_positions ? calc->vert_positions : calc->vertexCos),
+                               calc->numVerts);
+  const Bounds<float3> bounds = *bounds::min_max(positions);
+  const float3 scale = math::safe_divide(float3(1023.0f), bounds.max - bounds.min);
+
+  Array<uint32_t> codes(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const float3 p = math::clamp((positions[i] - bounds.min) * scale, 0.0f, 1023.0f);
+      codes[i] = (morton_expand_bits(uint32_t(p.x)) << 2) |
+                 (morton_expand_bits(uint32_t(p.y)) << 1) | morton_expand_bits(uint32_t(p.z));
+    }
+  });
+
+  Array<int> order(positions.size());
+  array_utils::fill_index_range<int>(order);
+  parallel_sort(order.begin(), order.end(), [&](const int a, const int b) {
+    return codes[a] != codes[b] ? codes[a] < codes[b] : a < b;
+  });
+  return order;
+}
+
 /**
  * Shrink-wrap to the nearest vertex
  *
@@ -306,10 +359,11 @@ const ShrinkwrapBoundaryData &boundary_cache_ensure(const Mesh &mesh)
  * for each vertex performs a nearest vertex search on the tree.
  */
 static void shrinkwrap_calc_nearest_vertex_cb_ex(void *__restrict userdata,
-                                                 const int i,
+                                                 const int iter,
                                                  const TaskParallelTLS *__restrict tls)
 {
   ShrinkwrapCalcCBData *data = static_cast<ShrinkwrapCalcCBData *>(userdata);
+  const int i = data->query_order ? data->query_order[iter] : iter;
 
   ShrinkwrapCalcData *calc = data->calc;
   BVHTreeFromMesh *treeData = &data->tree->treeData;
@@ -378,9 +432,14 @@ static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
   ShrinkwrapCalcCBData data{};
   data.calc = calc;
   data.tree = calc->tree;
+  blender::Array<int> query_order;
+  if (calc->numVerts > SHRINKWRAP_NEAREST_THREADING_THRESHOLD) {
+    query_order = shrinkwrap_coherent_query_order(calc);
+    data.query_order = query_order.data();
+  }
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > 10000);
+  settings.use_threading = (calc->numVerts > SHRINKWRAP_NEAREST_THREADING_THRESHOLD);
   settings.userdata_chunk = &nearest;
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
@@ -1082,10 +1141,11 @@ void BKE_shrinkwrap_find_nearest_surface(ShrinkwrapTreeData *tree,
  * NN matches for each vertex
  */
 static void shrinkwrap_calc_nearest_surface_point_cb_ex(void *__restrict userdata,
-                                                        const int i,
+                                                        const int iter,
                                                         const TaskParallelTLS *__restrict tls)
 {
   ShrinkwrapCalcCBData *data = static_cast<ShrinkwrapCalcCBData *>(userdata);
+  const int i = data->query_order ? data->query_order[iter] : iter;
 
   ShrinkwrapCalcData *calc = data->calc;
   BVHTreeNearest *nearest = static_cast<BVHTreeNearest *>(tls->userdata_chunk);
@@ -1341,9 +1401,14 @@ static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
   ShrinkwrapCalcCBData data{};
   data.calc = calc;
   data.tree = calc->tree;
+  blender::Array<int> query_order;
+  if (calc->numVerts > SHRINKWRAP_NEAREST_THREADING_THRESHOLD) {
+    query_order = shrinkwrap_coherent_query_order(calc);
+    data.query_order = query_order.data();
+  }
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
-  settings.use_threading = (calc->numVerts > 10000);
+  settings.use_threading = (calc->numVerts > SHRINKWRAP_NEAREST_THREADING_THRESHOLD);
   settings.userdata_chunk = &nearest;
   settings.userdata_chunk_size = sizeof(nearest);
   BLI_task_parallel_range(
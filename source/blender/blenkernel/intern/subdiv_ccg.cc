@@ -49,6 +49,11 @@ static void subdiv_ccg_average_inner_face_grids(SubdivCCG &subdiv_ccg,
                                                 const CCGKey &key,
                                                 const IndexRange face);
 
+static void subdiv_ccg_recalc_inner_face_grid_normals(SubdivCCG &subdiv_ccg,
+                                                      const CCGKey &key,
+                                                      MutableSpan<float3> face_normals,
+                                                      const IndexRange face);
+
 void subdiv_ccg_average_faces_boundaries_and_corners(SubdivCCG &subdiv_ccg,
                                                      const CCGKey &key,
                                                      const IndexMask &face_mask);
@@ -270,6 +275,14 @@ static bool subdiv_ccg_evaluate_grids(SubdivCCG &subdiv_ccg,
   const OpenSubdiv_TopologyRefiner *topology_refiner = subdiv.topology_refiner;
   const int num_faces = topology_refiner->getNumFaces();
   const Span<int> face_ptex_offset(face_ptex_offset_get(&subdiv), subdiv_ccg.faces.size());
+  /* If displacement is used, normals have to be calculated from the final coordinates. The
+   * normals inside of each face only depend on its own grids, so they are calculated right after
+   * evaluating them, while the data is still in CPU caches. */
+  const bool recalc_normals = subdiv.displacement_evaluator != nullptr && subdiv_ccg.has_normal;
+  const CCGKey key = BKE_subdiv_ccg_key_top_level(subdiv_ccg);
+  const int grid_size_1 = subdiv_ccg.grid_size - 1;
+  threading::EnumerableThreadSpecific<Array<float3>> face_normals_tls(
+      [&]() { return Array<float3>(grid_size_1 * grid_size_1); });
   threading::parallel_for(IndexRange(num_faces), 1024, [&](const IndexRange range) {
     for (const int face_index : range) {
       if (subdiv_ccg.faces[face_index].size() == 4) {
@@ -280,12 +293,16 @@ static bool subdiv_ccg_evaluate_grids(SubdivCCG &subdiv_ccg,
         subdiv_ccg_eval_special_grid(
             subdiv, subdiv_ccg, face_ptex_offset, mask_evaluator, face_index);
       }
+      if (recalc_normals) {
+        subdiv_ccg_recalc_inner_face_grid_normals(
+            subdiv_ccg, key, face_normals_tls.local(), subdiv_ccg.faces[face_index]);
+      }
     }
   });
-  /* If displacement is used, need to calculate normals after all final
-   * coordinates are known. */
-  if (subdiv.displacement_evaluator != nullptr) {
-    BKE_subdiv_ccg_recalc_normals(subdiv_ccg);
+  /* Boundaries and corners depend on adjacent faces, so they can only be averaged once all grids
+   * are evaluated. */
+  if (recalc_normals) {
+    BKE_subdiv_ccg_average_grids(subdiv_ccg);
   }
   return true;
 }
@@ -638,6 +655,19 @@ static void subdiv_ccg_average_inner_face_normals(const SubdivCCG &subdiv_ccg,
   }
 }
 
+/* Recalculate normals which corresponds to non-boundaries elements of the grids of one face. */
+static void subdiv_ccg_recalc_inner_face_grid_normals(SubdivCCG &subdiv_ccg,
+                                                      const CCGKey &key,
+                                                      MutableSpan<float3> face_normals,
+                                                      const IndexRange face)
+{
+  for (const int grid_index : face) {
+    subdiv_ccg_recalc_inner_face_normals(subdiv_ccg, key, face_normals, grid_index);
+    subdiv_ccg_average_inner_face_normals(subdiv_ccg, key, face_normals, grid_index);
+  }
+  subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, face);
+}
+
 /* Recalculate normals which corresponds to non-boundaries elements of grids. */
 static void subdiv_ccg_recalc_inner_grid_normals(SubdivCCG &subdiv_ccg, const IndexMask &face_mask)
 {
@@ -652,12 +682,7 @@ static void subdiv_ccg_recalc_inner_grid_normals(SubdivCCG &subdiv_ccg, const In
   face_mask.foreach_segment(GrainSize(512), [&](const IndexMaskSegment segment) {
     MutableSpan<float3> face_normals = face_normals_tls.local();
     for (const int face_index : segment) {
-      const IndexRange face = faces[face_index];
-      for (const int grid_index : face) {
-        subdiv_ccg_recalc_inner_face_normals(subdiv_ccg, key, face_normals, grid_index);
-        subdiv_ccg_average_inner_face_normals(subdiv_ccg, key, face_normals, grid_index);
-      }
-      subdiv_ccg_average_inner_face_grids(subdiv_ccg, key, face);
+      subdiv_ccg_recalc_inner_face_grid_normals(subdiv_ccg, key, face_normals, faces[face_index]);
     }
   });
 }
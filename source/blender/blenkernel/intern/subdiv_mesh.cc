@@ -84,8 +84,6 @@ struct SubdivMeshContext {
   Array<bool> subdiv_display_edges;
 
   /* Lazily initialize a map from vertices to connected edges. */
-  Array<int> vert_to_edge_offsets;
-  Array<int> vert_to_edge_indices;
   GroupedSpan<int> vert_to_edge_map;
 };
 
@@ -1183,11 +1181,7 @@ Mesh *subdiv_to_mesh(Subdiv *subdiv, const ToMeshSettings *settings, const Mesh
   subdiv_context.coarse_faces = coarse_mesh->faces();
   subdiv_context.coarse_corner_verts = coarse_mesh->corner_verts();
   if (coarse_mesh->loose_edges().count > 0) {
-    subdiv_context.vert_to_edge_map = mesh::build_vert_to_edge_map(
-        subdiv_context.coarse_edges,
-        coarse_mesh->verts_num,
-        subdiv_context.vert_to_edge_offsets,
-        subdiv_context.vert_to_edge_indices);
+    subdiv_context.vert_to_edge_map = coarse_mesh->vert_to_edge_map();
   }
 
   subdiv_context.subdiv = subdiv;
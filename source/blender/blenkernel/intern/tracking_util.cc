@@ -592,6 +592,46 @@ MovieTrackingMarker *tracking_get_keyframed_marker(MovieTrackingTrack *track,
 /** \name Frame Accessor
  * \{ */
 
+static ImBuf *accessor_lookup_cached_frame(TrackingImageAccessor *accessor,
+                                           int clip_index,
+                                           int frame)
+{
+  ImBuf *ibuf = nullptr;
+  BLI_spin_lock(&accessor->cache_lock);
+  for (const TrackingImageAccessorFrame &cached_frame : accessor->cached_frames) {
+    if (cached_frame.ibuf && cached_frame.clip_index == clip_index && cached_frame.frame == frame)
+    {
+      ibuf = cached_frame.ibuf;
+      IMB_refImBuf(ibuf);
+      break;
+    }
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+  return ibuf;
+}
+
+static void accessor_add_cached_frame(TrackingImageAccessor *accessor,
+                                      int clip_index,
+                                      int frame,
+                                      ImBuf *ibuf)
+{
+  ImBuf *evicted_ibuf = nullptr;
+  IMB_refImBuf(ibuf);
+  BLI_spin_lock(&accessor->cache_lock);
+  TrackingImageAccessorFrame &cached_frame = accessor->cached_frames[accessor->next_cached_frame];
+  evicted_ibuf = cached_frame.ibuf;
+  cached_frame.clip_index = clip_index;
+  cached_frame.frame = frame;
+  cached_frame.ibuf = ibuf;
+  accessor->next_cached_frame = (accessor->next_cached_frame + 1) % MAX_ACCESSOR_CACHED_FRAMES;
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  /* Freeing might release the last reference, don't do it while holding the spin lock. */
+  if (evicted_ibuf != nullptr) {
+    IMB_freeImBuf(evicted_ibuf);
+  }
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
@@ -603,6 +643,11 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  ibuf = accessor_lookup_cached_frame(accessor, clip_index, frame);
+  if (ibuf != nullptr) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -610,6 +655,12 @@ static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
   user.render_flag = 0;
   ibuf = BKE_movieclip_get_ibuf(clip, &user);
 
+  /* Another thread might have added the same frame in the meantime, which only means that it
+   * takes one more slot until it is evicted. */
+  if (ibuf != nullptr) {
+    accessor_add_cached_frame(accessor, clip_index, frame, ibuf);
+  }
+
   return ibuf;
 }
 
@@ -907,6 +958,11 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
+  for (TrackingImageAccessorFrame &cached_frame : accessor->cached_frames) {
+    if (cached_frame.ibuf != nullptr) {
+      IMB_freeImBuf(cached_frame.ibuf);
+    }
+  }
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor->tracks);
   MEM_freeN(accessor);
@@ -134,6 +134,13 @@ void BKE_volumes_init()
 #endif
 }
 
+void BKE_volumes_exit()
+{
+#ifdef WITH_OPENVDB
+  blender::bke::volume_grid::file_cache::exit();
+#endif
+}
+
 /* Volume datablock */
 
 static void volume_init_data(ID *id)
@@ -330,7 +337,7 @@ void *BKE_volume_add(Main *bmain, const char *name)
 
 /* Sequence */
 
-static int volume_sequence_frame(const Depsgraph *depsgraph, const Volume *volume)
+static int volume_sequence_frame(const Volume *volume, const int scene_frame)
 {
   if (!volume->is_sequence) {
     return 0;
@@ -341,7 +348,6 @@ static int volume_sequence_frame(const Depsgraph *depsgraph, const Volume *volum
     return 0;
   }
 
-  const int scene_frame = DEG_get_ctime(depsgraph);
   const VolumeSequenceMode mode = (VolumeSequenceMode)volume->sequence_mode;
   const int frame_duration = volume->frame_duration;
   const int frame_start = volume->frame_start;
@@ -397,7 +403,10 @@ static int volume_sequence_frame(const Depsgraph *depsgraph, const Volume *volum
 }
 
 #ifdef WITH_OPENVDB
-static void volume_filepath_get(const Main *bmain, const Volume *volume, char r_filepath[FILE_MAX])
+static void volume_filepath_get_for_frame(const Main *bmain,
+                                          const Volume *volume,
+                                          const int frame,
+                                          char r_filepath[FILE_MAX])
 {
   BLI_strncpy(r_filepath, volume->filepath, FILE_MAX);
   BLI_path_abs(r_filepath, ID_BLEND_PATH(bmain, &volume->id));
@@ -406,10 +415,32 @@ static void volume_filepath_get(const Main *bmain, const Volume *volume, char r_
   if (volume->is_sequence && BLI_path_frame_get(r_filepath, &path_frame, &path_digits)) {
     char ext[32];
     BLI_path_frame_strip(r_filepath, ext, sizeof(ext));
-    BLI_path_frame(r_filepath, FILE_MAX, volume->runtime->frame, path_digits);
+    BLI_path_frame(r_filepath, FILE_MAX, frame, path_digits);
     BLI_path_extension_ensure(r_filepath, FILE_MAX, ext);
   }
 }
+
+static void volume_filepath_get(const Main *bmain, const Volume *volume, char r_filepath[FILE_MAX])
+{
+  volume_filepath_get_for_frame(bmain, volume, volume->runtime->frame, r_filepath);
+}
+
+/**
+ * Start loading the file of the given sequence frame in the background, so that it is already
+ * cached when playback reaches it.
+ */
+static void volume_sequence_prefetch(const Main *bmain, const Volume *volume, const int frame)
+{
+  if (frame == VOLUME_FRAME_NONE) {
+    return;
+  }
+  char filepath[FILE_MAX];
+  volume_filepath_get_for_frame(bmain, volume, frame, filepath);
+  if (!BLI_exists(filepath)) {
+    return;
+  }
+  blender::bke::volume_grid::file_cache::prefetch_grids_from_file(filepath);
+}
 #endif
 
 /* File Load */
@@ -724,8 +755,20 @@ void BKE_volume_eval_geometry(Depsgraph *depsgraph, Volume *volume)
   volume_update_simplify_level(bmain, volume, depsgraph);
 
   /* TODO: can we avoid modifier re-evaluation when frame did not change? */
-  int frame = volume_sequence_frame(depsgraph, volume);
+  const int scene_frame = DEG_get_ctime(depsgraph);
+  int frame = volume_sequence_frame(volume, scene_frame);
   if (frame != volume->runtime->frame) {
+#ifdef WITH_OPENVDB
+    /* When the previous evaluation was at the previous scene frame, assume that the animation is
+     * playing and read the file of the next frame in advance. */
+    const int next_frame = volume_sequence_frame(volume, scene_frame + 1);
+    if (DEG_is_active(depsgraph) && volume->runtime->frame != VOLUME_FRAME_NONE &&
+        volume->runtime->frame == volume_sequence_frame(volume, scene_frame - 1) &&
+        next_frame != frame)
+    {
+      volume_sequence_prefetch(bmain, volume, next_frame);
+    }
+#endif
     BKE_volume_unload(volume);
     volume->runtime->frame = frame;
   }
@@ -230,10 +230,24 @@ void VolumeGridData::unload_tree_if_possible() const
   }
   grid_->newTree();
   tree_loaded_ = false;
+  tree_memory_ = -1;
   tree_sharing_info_->remove_user_and_delete_if_last();
   tree_sharing_info_ = nullptr;
 }
 
+int64_t VolumeGridData::tree_memory_usage() const
+{
+  std::lock_guard lock{mutex_};
+  if (!grid_ || !tree_loaded_) {
+    return 0;
+  }
+  /* Reloadable grids are not modified, otherwise they would not be reloadable anymore. */
+  if (tree_memory_ < 0 || !this->is_reloadable()) {
+    tree_memory_ = int64_t(grid_->memUsage());
+  }
+  return tree_memory_;
+}
+
 GVolumeGrid VolumeGridData::copy() const
 {
   std::lock_guard lock{mutex_};
@@ -8,11 +8,35 @@
 #  include "BKE_volume_openvdb.hh"
 
 #  include "BLI_map.hh"
+#  include "BLI_set.hh"
+#  include "BLI_string.h"
+#  include "BLI_task.h"
+
+#  include "DNA_userdef_types.h"
+
+#  include "MEM_guardedalloc.h"
 
 #  include <openvdb/openvdb.h>
 
 namespace blender::bke::volume_grid::file_cache {
 
+/**
+ * A grid at a specific simplify level.
+ */
+struct CachedGrid {
+  GVolumeGrid grid;
+  /**
+   * Value of #GlobalCache::use_clock when the grid was requested the last time. Used to unload
+   * the least recently used trees first when the cache exceeds its memory limit.
+   */
+  uint64_t last_use = 0;
+  /**
+   * The grid was loaded by #prefetch_grids_from_file and was not requested since, so it must not
+   * be removed by #unload_unused even though it is not used outside of the cache yet.
+   */
+  bool is_prefetched = false;
+};
+
 /**
  * Cache for a single grid stored in a file.
  */
@@ -25,7 +49,7 @@ struct GridCache {
   /**
    * Cached simplify levels.
    */
-  Map<int, GVolumeGrid> grid_by_simplify_level;
+  Map<int, CachedGrid> grid_by_simplify_level;
 };
 
 /**
@@ -62,6 +86,12 @@ struct FileCache {
 struct GlobalCache {
   std::mutex mutex;
   Map<std::string, FileCache> file_map;
+  /** Incremented whenever grids are requested, see #CachedGrid::last_use. */
+  uint64_t use_clock = 0;
+  /** Background tasks loading grids of files that will be needed soon. */
+  TaskPool *prefetch_pool = nullptr;
+  /** Files that are currently being prefetched, to avoid reading them twice. */
+  Set<std::string> prefetching_files;
 };
 
 /**
@@ -126,13 +156,18 @@ static FileCache &get_file_cache(const StringRef file_path)
 /**
  * Load a single grid by name from a file. This loads the full grid including meta-data, transforms
  * and the tree.
+ *
+ * With delay loading, only the topology of the tree is read here. The file is memory mapped and
+ * the voxel buffers of the leaf nodes are read by OpenVDB when they are accessed for the first
+ * time, which keeps the memory usage low when only parts of a large grid are used.
  */
 static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_path,
                                                          const StringRef grid_name)
 {
-  /* Disable delay loading and file copying, this has poor performance
-   * on network drivers. */
-  const bool delay_load = false;
+  /* Delay loading is disabled by default, because it has poor performance on network drives.
+   * File copying is always disabled, to use the memory mapped file directly instead of copying
+   * the whole file to a temporary location first. */
+  const bool delay_load = (U.flag & USER_VOLUME_DELAY_LOAD) != 0;
 
   openvdb::io::File file(file_path);
   file.setCopyMaxBytes(0);
@@ -148,8 +183,11 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
                                    GridCache &grid_cache,
                                    const int simplify_level)
 {
-  if (GVolumeGrid *grid = grid_cache.grid_by_simplify_level.lookup_ptr(simplify_level)) {
-    return *grid;
+  const uint64_t use_clock = get_global_cache().use_clock;
+  if (CachedGrid *cached_grid = grid_cache.grid_by_simplify_level.lookup_ptr(simplify_level)) {
+    cached_grid->last_use = use_clock;
+    cached_grid->is_prefetched = false;
+    return cached_grid->grid;
   }
   /* A callback that actually loads the full grid including the tree when it's accessed. */
   auto load_grid_fn = [file_path = std::string(file_path),
@@ -177,16 +215,70 @@ static GVolumeGrid get_cached_grid(const StringRef file_path,
   VolumeGridData *grid_data = MEM_new<VolumeGridData>(
       __func__, load_grid_fn, meta_data_and_transform_grid);
   GVolumeGrid grid{grid_data};
-  grid_cache.grid_by_simplify_level.add(simplify_level, grid);
+  grid_cache.grid_by_simplify_level.add(simplify_level, {grid, use_clock});
   return grid;
 }
 
+/**
+ * Unload the trees of the least recently used grids until the trees of all cached grids fit into
+ * the memory limit from the preferences. Trees that are used right now can't be unloaded, and
+ * unloaded trees are loaded again when they are accessed later on.
+ */
+static void unload_least_recently_used()
+{
+  const int64_t memory_limit = int64_t(U.volume_cache_limit) * 1024 * 1024;
+  if (memory_limit <= 0) {
+    return;
+  }
+
+  /* Loading a grid can request other grids from the cache while the grid is locked, so the grids
+   * must not be accessed while the cache is locked. */
+  Vector<std::pair<uint64_t, GVolumeGrid>> grids;
+  {
+    GlobalCache &global_cache = get_global_cache();
+    std::lock_guard lock{global_cache.mutex};
+    for (FileCache &file_cache : global_cache.file_map.values()) {
+      for (GridCache &grid_cache : file_cache.grids) {
+        for (CachedGrid &cached_grid : grid_cache.grid_by_simplify_level.values()) {
+          grids.append({cached_grid.last_use, cached_grid.grid});
+        }
+      }
+    }
+  }
+
+  int64_t memory = 0;
+  for (const auto &[last_use, grid] : grids) {
+    memory += grid->tree_memory_usage();
+  }
+  if (memory <= memory_limit) {
+    return;
+  }
+
+  std::sort(grids.begin(), grids.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  for (const auto &[last_use, grid] : grids) {
+    if (memory <= memory_limit) {
+      break;
+    }
+    const int64_t grid_memory = grid->tree_memory_usage();
+    if (grid_memory == 0) {
+      continue;
+    }
+    grid->unload_tree_if_possible();
+    if (!grid->is_loaded()) {
+      memory -= grid_memory;
+    }
+  }
+}
+
 GVolumeGrid get_grid_from_file(const StringRef file_path,
                                const StringRef grid_name,
                                const int simplify_level)
 {
   GlobalCache &global_cache = get_global_cache();
   std::lock_guard lock{global_cache.mutex};
+  global_cache.use_clock++;
   FileCache &file_cache = get_file_cache(file_path);
   if (GridCache *grid_cache = file_cache.grid_cache_by_name(grid_name)) {
     return get_cached_grid(file_path, *grid_cache, simplify_level);
@@ -196,9 +288,12 @@ GVolumeGrid get_grid_from_file(const StringRef file_path,
 
 GridsFromFile get_all_grids_from_file(const StringRef file_path, const int simplify_level)
 {
+  unload_least_recently_used();
+
   GridsFromFile result;
   GlobalCache &global_cache = get_global_cache();
   std::lock_guard lock{global_cache.mutex};
+  global_cache.use_clock++;
   FileCache &file_cache = get_file_cache(file_path);
 
   if (!file_cache.error_message.empty()) {
@@ -219,11 +314,69 @@ void unload_unused()
   for (FileCache &file_cache : global_cache.file_map.values()) {
     for (GridCache &grid_cache : file_cache.grids) {
       grid_cache.grid_by_simplify_level.remove_if(
-          [&](const auto &item) { return item.value->is_mutable(); });
+          [&](const auto &item) {
+            return item.value.grid->is_mutable() && !item.value.is_prefetched;
+          });
+    }
+  }
+}
+
+static void prefetch_task(TaskPool *__restrict pool, void *taskdata)
+{
+  const char *file_path = static_cast<const char *>(taskdata);
+  const GridsFromFile grids_from_file = get_all_grids_from_file(file_path, 0);
+  /* Loading the trees happens without locking the cache, grids are loaded independently. */
+  for (const GVolumeGrid &grid : grids_from_file.grids) {
+    if (BLI_task_pool_current_canceled(pool)) {
+      break;
+    }
+    VolumeTreeAccessToken tree_token;
+    grid->grid(tree_token);
+  }
+
+  GlobalCache &global_cache = get_global_cache();
+  std::lock_guard lock{global_cache.mutex};
+  global_cache.prefetching_files.remove(file_path);
+  for (GridCache &grid_cache : get_file_cache(file_path).grids) {
+    if (CachedGrid *cached_grid = grid_cache.grid_by_simplify_level.lookup_ptr(0)) {
+      cached_grid->is_prefetched = true;
     }
   }
 }
 
+void prefetch_grids_from_file(const StringRef file_path)
+{
+  GlobalCache &global_cache = get_global_cache();
+  std::lock_guard lock{global_cache.mutex};
+  if (!global_cache.prefetching_files.add(file_path)) {
+    return;
+  }
+  if (global_cache.prefetch_pool == nullptr) {
+    global_cache.prefetch_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_push(global_cache.prefetch_pool,
+                     prefetch_task,
+                     BLI_strdupn(file_path.data(), file_path.size()),
+                     true,
+                     nullptr);
+}
+
+void exit()
+{
+  GlobalCache &global_cache = get_global_cache();
+  TaskPool *prefetch_pool;
+  {
+    std::lock_guard lock{global_cache.mutex};
+    prefetch_pool = global_cache.prefetch_pool;
+    global_cache.prefetch_pool = nullptr;
+  }
+  if (prefetch_pool) {
+    /* Canceling waits for running tasks, which lock the mutex when they are done. */
+    BLI_task_pool_cancel(prefetch_pool);
+    BLI_task_pool_free(prefetch_pool);
+  }
+}
+
 }  // namespace blender::bke::volume_grid::file_cache
 
 #endif /* WITH_OPENVDB */
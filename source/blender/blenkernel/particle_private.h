@@ -54,6 +54,11 @@ void do_child_modifiers(const ParticleChildModifierContext *modifier_ctx,
                         float mat[4][4],
                         ParticleKey *state,
                         float t);
+/**
+ * Integrate the twist curve of the context once for all steps along the path, instead of once
+ * for every key of every child.
+ */
+void psys_twist_curve_integral_init(ParticleThreadContext *ctx);
 
 #ifdef __cplusplus
 }
@@ -155,6 +155,15 @@ float *tracking_track_get_mask_for_region(const int frame_width,
 struct libmv_FrameAccessor;
 
 #define MAX_ACCESSOR_CLIP 64
+#define MAX_ACCESSOR_CACHED_FRAMES 4
+
+/* Frame of a clip which is referenced by the accessor. */
+typedef struct TrackingImageAccessorFrame {
+  int clip_index;
+  int frame;
+  struct ImBuf *ibuf;
+} TrackingImageAccessorFrame;
+
 typedef struct TrackingImageAccessor {
   struct MovieClip *clips[MAX_ACCESSOR_CLIP];
   int num_clips;
@@ -166,6 +175,13 @@ typedef struct TrackingImageAccessor {
   int num_tracks;
 
   struct libmv_FrameAccessor *libmv_accessor;
+
+  /* The most recently requested frames. All tracking threads request the same few frames while
+   * tracking a step, keeping them referenced here avoids waiting on the movie clip lock for every
+   * marker and the frames from being removed from the movie cache, and decoded again, in the
+   * middle of a step. Protected by the `cache_lock`. */
+  TrackingImageAccessorFrame cached_frames[MAX_ACCESSOR_CACHED_FRAMES];
+  int next_cached_frame;
   SpinLock cache_lock;
 } TrackingImageAccessor;
 
@@ -0,0 +1,87 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * An #ArenaScope owns the memory of temporary containers that are used during a larger
+ * evaluation, e.g. of a modifier. Containers opt into it by using #ArenaAllocator as their
+ * allocator. Individual deallocations are free, all memory is released at once when the scope is
+ * destructed. That avoids many small allocations and deallocations in hot code paths.
+ *
+ * A scope has to be activated on the threads that should use it with #ArenaScope::Activation.
+ * An #ArenaAllocator that is constructed while no scope is active falls back to the guarded
+ * allocator, so code using it works the same when it is called outside of such an evaluation.
+ *
+ * Containers using an #ArenaAllocator must not outlive the scope that was active when they were
+ * constructed. Since memory is only reclaimed at the end of the scope, it should be used for many
+ * small and short lived allocations, not for containers that are resized very often.
+ */
+
+#include "BLI_allocator.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
+
+namespace blender {
+
+class ArenaScope : NonCopyable, NonMovable {
+ private:
+  /** Every thread allocates from its own buffers, so that no synchronization is necessary. */
+  threading::EnumerableThreadSpecific<LinearAllocator<>> allocators_;
+
+ public:
+  /**
+   * Makes a scope active on the current thread for as long as the activation exists. Activations
+   * can be nested, a null scope deactivates the currently active scope.
+   */
+  class Activation : NonCopyable, NonMovable {
+   private:
+    ArenaScope *previous_;
+
+   public:
+    Activation(ArenaScope *scope);
+    ~Activation();
+  };
+
+  /** The scope that is active on the current thread, or null. */
+  static ArenaScope *active();
+
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    return allocators_.local().allocate(size, alignment);
+  }
+};
+
+/**
+ * Allocator for containers such as #Vector and #Array that allocates from the #ArenaScope that is
+ * active when the allocator is constructed.
+ */
+class ArenaAllocator {
+ private:
+  ArenaScope *scope_;
+
+ public:
+  ArenaAllocator() : scope_(ArenaScope::active()) {}
+  ArenaAllocator(ArenaScope *scope) : scope_(scope) {}
+
+  void *allocate(const size_t size, const size_t alignment, const char *name)
+  {
+    if (scope_) {
+      return scope_->allocate(int64_t(size), int64_t(alignment));
+    }
+    return MEM_mallocN_aligned(size, alignment, name);
+  }
+
+  void deallocate(void *ptr)
+  {
+    /* Memory from a scope is freed when the scope is destructed. */
+    if (!scope_) {
+      MEM_freeN(ptr);
+    }
+  }
+};
+
+}  // namespace blender
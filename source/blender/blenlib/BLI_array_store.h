@@ -37,6 +37,20 @@ typedef struct BArrayStore BArrayStore;
  * \return A new array store, to be freed with #BLI_array_store_destroy.
  */
 BArrayStore *BLI_array_store_create(unsigned int stride, unsigned int chunk_count);
+
+typedef enum eArrayStoreFlag {
+  /**
+   * Split new data into chunks at boundaries that depend on the content, instead of at a fixed
+   * size. This is slower when adding states, but preserves more sharing when elements are inserted
+   * or removed, since the chunks after the change stay the same.
+   */
+  BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS = (1 << 0),
+} eArrayStoreFlag;
+
+/**
+ * Same as #BLI_array_store_create, with additional \a flag options (#eArrayStoreFlag).
+ */
+BArrayStore *BLI_array_store_create_ex(unsigned int stride, unsigned int chunk_count, int flag);
 /**
  * Free the #BArrayStore, including all states and chunks.
  */
@@ -22,6 +22,14 @@ struct BArrayStore_AtSize {
 BArrayStore *BLI_array_store_at_size_ensure(struct BArrayStore_AtSize *bs_stride,
                                             int stride,
                                             int chunk_size);
+/**
+ * Same as #BLI_array_store_at_size_ensure, \a flag is passed to #BLI_array_store_create_ex
+ * when the store is created.
+ */
+BArrayStore *BLI_array_store_at_size_ensure_ex(struct BArrayStore_AtSize *bs_stride,
+                                               int stride,
+                                               int chunk_size,
+                                               int flag);
 
 BArrayStore *BLI_array_store_at_size_get(struct BArrayStore_AtSize *bs_stride, int stride);
 
@@ -17,14 +17,15 @@ namespace blender::array_utils {
 
 /**
  * Fill the destination span by copying all values from the `src` array. Threaded based on
- * grain-size.
+ * grain-size. The copies use #threading::parallel_for_numa, so that newly allocated destination
+ * arrays are distributed over the NUMA nodes consistently with other passes over the data.
  */
 void copy(const GVArray &src, GMutableSpan dst, int64_t grain_size = 4096);
 template<typename T>
 inline void copy(const VArray<T> &src, MutableSpan<T> dst, const int64_t grain_size = 4096)
 {
   BLI_assert(src.size() == dst.size());
-  threading::parallel_for(src.index_range(), grain_size, [&](const IndexRange range) {
+  threading::parallel_for_numa(src.index_range(), grain_size, [&](const IndexRange range) {
     src.materialize_to_uninitialized(range, dst);
   });
 }
@@ -37,7 +38,7 @@ template<typename T>
 inline void copy(const Span<T> src, MutableSpan<T> dst, const int64_t grain_size = 4096)
 {
   BLI_assert(src.size() == dst.size());
-  threading::parallel_for(src.index_range(), grain_size, [&](const IndexRange range) {
+  threading::parallel_for_numa(src.index_range(), grain_size, [&](const IndexRange range) {
     dst.slice(range).copy_from(src.slice(range));
   });
 }
@@ -11,6 +11,7 @@
  */
 
 #include <optional>
+#include <type_traits>
 
 #include "BLI_bounds_types.hh"
 #include "BLI_index_mask.hh"
@@ -21,6 +22,11 @@ namespace blender {
 
 namespace bounds {
 
+namespace detail {
+/** Vectorized version of #min_max for 3D vectors, the span must not be empty. */
+[[nodiscard]] Bounds<float3> min_max(Span<float3> values);
+}  // namespace detail
+
 template<typename T> [[nodiscard]] inline Bounds<T> merge(const Bounds<T> &a, const Bounds<T> &b)
 {
   return {math::min(a.min, b.min), math::max(a.max, b.max)};
@@ -60,6 +66,9 @@ template<typename T> [[nodiscard]] inline std::optional<Bounds<T>> min_max(const
   if (values.is_empty()) {
     return std::nullopt;
   }
+  if constexpr (std::is_same_v<T, float3>) {
+    return detail::min_max(values);
+  }
   const Bounds<T> init{values.first(), values.first()};
   return threading::parallel_reduce(
       values.index_range(),
@@ -0,0 +1,215 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #blender::ConcurrentMap is a hash map that can be modified from multiple threads at the same
+ * time. It is meant for parallel algorithms that deduplicate or accumulate data, which otherwise
+ * have to build a map per thread and merge them afterwards.
+ *
+ * The map is split into shards. Every shard is a #blender::Map with its own mutex, so threads
+ * only wait for each other when they access the same shard at the same time. The shard of a key
+ * is determined from the high bits of its mixed hash, while the probing within a shard uses the
+ * normal hash and probing strategy of #blender::Map.
+ *
+ * Accessing the values stored in the map is only thread-safe from within the callbacks of
+ * #add_or_modify, or when there are no concurrent modifications.
+ */
+
+#include <array>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<typename Key,
+         typename Value,
+         /**
+          * Log2 of the number of shards. More shards reduce contention but make iteration and
+          * small maps more expensive.
+          */
+         int ShardBits = 6,
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality<Key>>
+class ConcurrentMap : NonCopyable, NonMovable {
+ public:
+  using ShardMap = Map<Key, Value, 0, ProbingStrategy, Hash, IsEqual>;
+
+ private:
+  static constexpr int64_t shards_num = int64_t(1) << ShardBits;
+
+  /** Aligned to avoid false sharing between the mutexes of different shards. */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    ShardMap map;
+  };
+
+  Array<Shard, 0> shards_;
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+
+ public:
+  ConcurrentMap() : shards_(shards_num) {}
+
+  /**
+   * Add a key-value pair. If the key exists in the map already, nothing is changed.
+   * Returns true when the key was newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add(key, value);
+  }
+
+  /**
+   * Call #create_value when the key does not exist yet and #modify_value otherwise, see
+   * #Map::add_or_modify. The callbacks are called while the shard is locked, so they can access
+   * the value without further synchronization, but must not access the map.
+   */
+  template<typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify(const Key &key,
+                     const CreateValueF &create_value,
+                     const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_or_modify(key, create_value, modify_value);
+  }
+
+  /**
+   * Add many key-value pairs at once. Keys that exist already are ignored. The keys are grouped
+   * by shard first, so that every shard is only locked once per call.
+   */
+  void add_multiple(const Span<Key> keys, const Span<Value> values)
+  {
+    BLI_assert(keys.size() == values.size());
+    this->foreach_shard_group(keys, [&](Shard &shard, const Span<int64_t> indices) {
+      for (const int64_t i : indices) {
+        shard.map.add(keys[i], values[i]);
+      }
+    });
+  }
+
+  /** Return the value for the key or the default value if it does not exist. */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.lookup_default(key, default_value);
+  }
+
+  bool contains(const Key &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.contains(key);
+  }
+
+  /** Reserve memory for the given number of keys, assuming that they are evenly distributed. */
+  void reserve(const int64_t n)
+  {
+    for (Shard &shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      shard.map.reserve(n / shards_num + 1);
+    }
+  }
+
+  /** Number of keys in the map. Not thread-safe when the map is modified concurrently. */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Access the maps of the individual shards, e.g. to iterate over all items in parallel once
+   * the map is not modified anymore.
+   */
+  int64_t shards_size() const
+  {
+    return shards_num;
+  }
+  ShardMap &shard(const int64_t index)
+  {
+    return shards_[index].map;
+  }
+  const ShardMap &shard(const int64_t index) const
+  {
+    return shards_[index].map;
+  }
+
+  /** Call the function for every item. Not thread-safe when the map is modified concurrently. */
+  template<typename Fn> void foreach_item(const Fn &fn) const
+  {
+    for (const Shard &shard : shards_) {
+      for (const auto item : shard.map.items()) {
+        fn(item.key, item.value);
+      }
+    }
+  }
+
+ private:
+  int64_t shard_index(const Key &key) const
+  {
+    /* Mix the hash, because many hash functions (e.g. of integers) don't set the high bits. */
+    const uint64_t hash = uint64_t(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return int64_t(hash >> (64 - ShardBits));
+  }
+
+  Shard &shard_for_key(const Key &key)
+  {
+    return shards_[this->shard_index(key)];
+  }
+  const Shard &shard_for_key(const Key &key) const
+  {
+    return shards_[this->shard_index(key)];
+  }
+
+  template<typename Fn> void foreach_shard_group(const Span<Key> keys, const Fn &fn)
+  {
+    Array<int64_t, 0> key_shards(keys.size());
+    std::array<int64_t, shards_num + 1> offsets{};
+    for (const int64_t i : keys.index_range()) {
+      key_shards[i] = this->shard_index(keys[i]);
+      offsets[key_shards[i] + 1]++;
+    }
+    for (const int64_t i : IndexRange(shards_num)) {
+      offsets[i + 1] += offsets[i];
+    }
+    Array<int64_t, 0> sorted_indices(keys.size());
+    std::array<int64_t, shards_num> fill = {};
+    for (const int64_t i : keys.index_range()) {
+      const int64_t shard = key_shards[i];
+      sorted_indices[offsets[shard] + fill[shard]++] = i;
+    }
+    for (const int64_t shard_index : IndexRange(shards_num)) {
+      const IndexRange range = IndexRange::from_begin_end(offsets[shard_index],
+                                                          offsets[shard_index + 1]);
+      if (range.is_empty()) {
+        continue;
+      }
+      Shard &shard = shards_[shard_index];
+      std::lock_guard lock{shard.mutex};
+      fn(shard, sorted_indices.as_span().slice(range));
+    }
+  }
+};
+
+}  // namespace blender
@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #blender::ConcurrentSet is a hash set that can be modified from multiple threads at the same
+ * time, e.g. to deduplicate data in a parallel loop. Like #blender::ConcurrentMap, it is split
+ * into shards that are a #blender::Set with their own mutex each.
+ */
+
+#include <array>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_set.hh"
+#include "BLI_span.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<typename Key,
+         /** Log2 of the number of shards, see #ConcurrentMap. */
+         int ShardBits = 6,
+         typename ProbingStrategy = DefaultProbingStrategy,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality<Key>>
+class ConcurrentSet : NonCopyable, NonMovable {
+ public:
+  using ShardSet = Set<Key, 0, ProbingStrategy, Hash, IsEqual>;
+
+ private:
+  static constexpr int64_t shards_num = int64_t(1) << ShardBits;
+
+  /** Aligned to avoid false sharing between the mutexes of different shards. */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    ShardSet set;
+  };
+
+  Array<Shard, 0> shards_;
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+
+ public:
+  ConcurrentSet() : shards_(shards_num) {}
+
+  /** Add the key if it does not exist yet. Returns true when the key was newly added. */
+  bool add(const Key &key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.set.add(key);
+  }
+
+  /**
+   * Add many keys at once. The keys are grouped by shard first, so that every shard is only
+   * locked once per call.
+   */
+  void add_multiple(const Span<Key> keys)
+  {
+    Array<int64_t, 0> key_shards(keys.size());
+    std::array<int64_t, shards_num + 1> offsets{};
+    for (const int64_t i : keys.index_range()) {
+      key_shards[i] = this->shard_index(keys[i]);
+      offsets[key_shards[i] + 1]++;
+    }
+    for (const int64_t i : IndexRange(shards_num)) {
+      offsets[i + 1] += offsets[i];
+    }
+    Array<int64_t, 0> sorted_indices(keys.size());
+    std::array<int64_t, shards_num> fill = {};
+    for (const int64_t i : keys.index_range()) {
+      const int64_t shard = key_shards[i];
+      sorted_indices[offsets[shard] + fill[shard]++] = i;
+    }
+    for (const int64_t shard_index : IndexRange(shards_num)) {
+      const IndexRange range = IndexRange::from_begin_end(offsets[shard_index],
+                                                          offsets[shard_index + 1]);
+      if (range.is_empty()) {
+        continue;
+      }
+      Shard &shard = shards_[shard_index];
+      std::lock_guard lock{shard.mutex};
+      for (const int64_t i : sorted_indices.as_span().slice(range)) {
+        shard.set.add(keys[i]);
+      }
+    }
+  }
+
+  bool contains(const Key &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.set.contains(key);
+  }
+
+  /** Reserve memory for the given number of keys, assuming that they are evenly distributed. */
+  void reserve(const int64_t n)
+  {
+    for (Shard &shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      shard.set.reserve(n / shards_num + 1);
+    }
+  }
+
+  /** Number of keys in the set. Not thread-safe when the set is modified concurrently. */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      size += shard.set.size();
+    }
+    return size;
+  }
+
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /** Access the sets of the individual shards once the set is not modified anymore. */
+  int64_t shards_size() const
+  {
+    return shards_num;
+  }
+  const ShardSet &shard(const int64_t index) const
+  {
+    return shards_[index].set;
+  }
+
+  /** Call the function for every key. Not thread-safe when the set is modified concurrently. */
+  template<typename Fn> void foreach_key(const Fn &fn) const
+  {
+    for (const Shard &shard : shards_) {
+      for (const Key &key : shard.set) {
+        fn(key);
+      }
+    }
+  }
+
+ private:
+  int64_t shard_index(const Key &key) const
+  {
+    /* Mix the hash, because many hash functions (e.g. of integers) don't set the high bits. */
+    const uint64_t hash = uint64_t(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return int64_t(hash >> (64 - ShardBits));
+  }
+
+  Shard &shard_for_key(const Key &key)
+  {
+    return shards_[this->shard_index(key)];
+  }
+  const Shard &shard_for_key(const Key &key) const
+  {
+    return shards_[this->shard_index(key)];
+  }
+};
+
+}  // namespace blender
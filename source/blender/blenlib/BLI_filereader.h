@@ -62,6 +62,20 @@ FileReader *BLI_filereader_new_zstd(FileReader *base) ATTR_WARN_UNUSED_RESULT AT
 /** Create #FileReader from applying `Gzip` decompression on an underlying file. */
 FileReader *BLI_filereader_new_gzip(FileReader *base) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
 
+/**
+ * Get the memory backing a #FileReader created by #BLI_filereader_new_memory or
+ * #BLI_filereader_new_mmap, so its content can be accessed in-place without copying.
+ * Returns NULL for any other kind of #FileReader, and for memory-mapped files on platforms
+ * where IO errors can't be handled when accessing the mapped memory directly.
+ *
+ * \note Check #BLI_filereader_memory_has_io_error after accessing the returned memory.
+ */
+const void *BLI_filereader_memory_data_get(FileReader *reader, size_t *r_length)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL();
+/** Whether accessing the memory of a memory-mapped #FileReader failed due to IO errors. */
+bool BLI_filereader_memory_has_io_error(FileReader *reader) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL();
+
 #ifdef __cplusplus
 }
 #endif
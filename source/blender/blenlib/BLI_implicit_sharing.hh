@@ -286,6 +286,17 @@ template<typename T> void free_shared_data(T **data, const ImplicitSharingInfo *
  */
 const ImplicitSharingInfo *info_for_mem_free(void *data);
 
+/**
+ * Copy trivial data into a memory mapped temporary file. This can be used for large arrays that
+ * are rarely accessed, since the operating system can write their pages to disk instead of keeping
+ * them in memory. The data stays mutable in place, and like any other shared data it is copied to
+ * regular memory when it is shared and has to be modified.
+ *
+ * \return Empty data when the size is zero or when creating the file failed, in which case the
+ * caller should keep the data in memory.
+ */
+ImplicitSharingInfoAndData copy_to_mapped_temp_file(const void *data, int64_t size);
+
 /**
  * Make data mutable (single-user) if it is shared. For trivially-copyable data only.
  */
@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Conversion between 32 bit floats and 16 bit half floats (IEEE 754 binary16).
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace blender::math {
+
+/**
+ * Convert a float to a half float, rounding to the nearest even value. Values that are too large
+ * become infinity, NaN stays NaN.
+ */
+uint16_t float_to_half(float v);
+
+/** Convert a half float to a float, which is exact for all values including sub-normals. */
+float half_to_float(uint16_t v);
+
+void float_to_half_array(const float *src, uint16_t *dst, size_t length);
+void half_to_float_array(const uint16_t *src, float *dst, size_t length);
+
+}  // namespace blender::math
@@ -12,6 +12,7 @@
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_rotation_types.hh"
 #include "BLI_math_vector.hh"
+#include "BLI_span.hh"
 
 namespace blender::math {
 
@@ -368,6 +369,13 @@ template<typename T>
 [[nodiscard]] VecBase<T, 3> transform_point(const MatBase<T, 4, 4> &mat,
                                             const VecBase<T, 3> &point);
 
+/**
+ * Transform many 3d points with a 4x4 matrix, like #transform_point. Multiple points are
+ * processed at once with SIMD instructions. The source and destination may be the same span.
+ */
+void transform_points(const float4x4 &mat, Span<float3> src, MutableSpan<float3> dst);
+void transform_points(const float4x4 &mat, MutableSpan<float3> points);
+
 /**
  * Transform a 3d direction vector using a 3x3 matrix (rotation & scale).
  */
@@ -27,6 +27,13 @@ BLI_mempool *BLI_mempool_create(unsigned int esize,
     ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL;
 void *BLI_mempool_alloc(BLI_mempool *pool) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL
     ATTR_NONNULL(1);
+/**
+ * Allocate \a elems_num elements at once and write them to \a r_elems, in the same order as
+ * repeated calls to #BLI_mempool_alloc would return them. Whole chunks are handed out without
+ * building their free lists first, and the returned elements can then be initialized in parallel.
+ */
+void BLI_mempool_alloc_n(BLI_mempool *pool, void **r_elems, unsigned int elems_num)
+    ATTR_NONNULL(1);
 void *BLI_mempool_calloc(BLI_mempool *pool)
     ATTR_MALLOC ATTR_WARN_UNUSED_RESULT ATTR_RETURNS_NONNULL ATTR_NONNULL(1);
 /**
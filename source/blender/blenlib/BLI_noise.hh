@@ -5,6 +5,7 @@
 #pragma once
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -129,6 +130,43 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        int type,
                                        bool normalize);
 
+/* Batched versions of the 3D functions above, evaluating many positions with the same parameters.
+ * The results are identical to calling the single position functions for every element, but
+ * positions are processed in small groups with branch-free inner loops and octaves are
+ * accumulated for the whole group at once, so the compiler can evaluate several positions with
+ * SIMD instructions. */
+
+void perlin_signed(Span<float3> positions, MutableSpan<float> r_values);
+
+void perlin_fbm(Span<float3> positions,
+                float detail,
+                float roughness,
+                float lacunarity,
+                bool normalize,
+                MutableSpan<float> r_values);
+
+void perlin_fractal_distorted(Span<float3> positions,
+                              float detail,
+                              float roughness,
+                              float lacunarity,
+                              float offset,
+                              float gain,
+                              float distortion,
+                              int type,
+                              bool normalize,
+                              MutableSpan<float> r_values);
+
+void perlin_float3_fractal_distorted(Span<float3> positions,
+                                     float detail,
+                                     float roughness,
+                                     float lacunarity,
+                                     float offset,
+                                     float gain,
+                                     float distortion,
+                                     int type,
+                                     bool normalize,
+                                     MutableSpan<float3> r_values);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
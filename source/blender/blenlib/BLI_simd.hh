@@ -8,6 +8,10 @@
  * \ingroup bli
  *
  * SIMD instruction support.
+ *
+ * Besides the intrinsics, this provides #simd::vfloat4, a small portable batch type for simple
+ * kernels that process four values at once. It uses SSE2 (which is emulated with Neon on Arm) when
+ * available and falls back to scalar code otherwise.
  */
 
 /* sse2neon.h uses a newer pre-processor which is no available for C language when using MSVC.
@@ -49,3 +53,171 @@
 #else
 #  define BLI_HAVE_SSE4 0
 #endif
+
+#include <algorithm>
+
+namespace blender::simd {
+
+struct vfloat4 {
+#if BLI_HAVE_SSE2
+  __m128 m;
+#else
+  float m[4];
+#endif
+};
+
+/** Load four values from memory that does not have to be aligned. */
+inline vfloat4 load(const float *ptr)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_loadu_ps(ptr)};
+#else
+  return {{ptr[0], ptr[1], ptr[2], ptr[3]}};
+#endif
+}
+
+inline void store(float *ptr, const vfloat4 a)
+{
+#if BLI_HAVE_SSE2
+  _mm_storeu_ps(ptr, a.m);
+#else
+  std::copy(a.m, a.m + 4, ptr);
+#endif
+}
+
+inline vfloat4 broadcast(const float value)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_set1_ps(value)};
+#else
+  return {{value, value, value, value}};
+#endif
+}
+
+inline vfloat4 operator+(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_add_ps(a.m, b.m)};
+#else
+  return {{a.m[0] + b.m[0], a.m[1] + b.m[1], a.m[2] + b.m[2], a.m[3] + b.m[3]}};
+#endif
+}
+
+inline vfloat4 operator-(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_sub_ps(a.m, b.m)};
+#else
+  return {{a.m[0] - b.m[0], a.m[1] - b.m[1], a.m[2] - b.m[2], a.m[3] - b.m[3]}};
+#endif
+}
+
+inline vfloat4 operator*(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_mul_ps(a.m, b.m)};
+#else
+  return {{a.m[0] * b.m[0], a.m[1] * b.m[1], a.m[2] * b.m[2], a.m[3] * b.m[3]}};
+#endif
+}
+
+inline vfloat4 operator/(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_div_ps(a.m, b.m)};
+#else
+  return {{a.m[0] / b.m[0], a.m[1] / b.m[1], a.m[2] / b.m[2], a.m[3] / b.m[3]}};
+#endif
+}
+
+inline vfloat4 min(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_min_ps(a.m, b.m)};
+#else
+  return {{std::min(a.m[0], b.m[0]),
+           std::min(a.m[1], b.m[1]),
+           std::min(a.m[2], b.m[2]),
+           std::min(a.m[3], b.m[3])}};
+#endif
+}
+
+inline vfloat4 max(const vfloat4 a, const vfloat4 b)
+{
+#if BLI_HAVE_SSE2
+  return {_mm_max_ps(a.m, b.m)};
+#else
+  return {{std::max(a.m[0], b.m[0]),
+           std::max(a.m[1], b.m[1]),
+           std::max(a.m[2], b.m[2]),
+           std::max(a.m[3], b.m[3])}};
+#endif
+}
+
+/** Smallest of the four values. */
+inline float reduce_min(const vfloat4 a)
+{
+  float values[4];
+  store(values, a);
+  return std::min(std::min(values[0], values[1]), std::min(values[2], values[3]));
+}
+
+/** Largest of the four values. */
+inline float reduce_max(const vfloat4 a)
+{
+  float values[4];
+  store(values, a);
+  return std::max(std::max(values[0], values[1]), std::max(values[2], values[3]));
+}
+
+/**
+ * Load four consecutive 3D vectors (12 floats) and split them into one batch per component
+ * (array of structures to structure of arrays).
+ */
+inline void load_float3_soa(const float *ptr, vfloat4 &r_x, vfloat4 &r_y, vfloat4 &r_z)
+{
+#if BLI_HAVE_SSE2
+  /* a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3). */
+  const __m128 a = _mm_loadu_ps(ptr);
+  const __m128 b = _mm_loadu_ps(ptr + 4);
+  const __m128 c = _mm_loadu_ps(ptr + 8);
+  const __m128 x_hi = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+  const __m128 y_lo = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+  const __m128 y_hi = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+  const __m128 z_lo = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+  const __m128 z_hi = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+  r_x.m = _mm_shuffle_ps(a, x_hi, _MM_SHUFFLE(2, 0, 3, 0));
+  r_y.m = _mm_shuffle_ps(y_lo, y_hi, _MM_SHUFFLE(2, 0, 2, 0));
+  r_z.m = _mm_shuffle_ps(z_lo, z_hi, _MM_SHUFFLE(2, 0, 2, 0));
+#else
+  for (int i = 0; i < 4; i++) {
+    r_x.m[i] = ptr[i * 3 + 0];
+    r_y.m[i] = ptr[i * 3 + 1];
+    r_z.m[i] = ptr[i * 3 + 2];
+  }
+#endif
+}
+
+/** Inverse of #load_float3_soa, interleave the components and store four 3D vectors. */
+inline void store_float3_soa(float *ptr, const vfloat4 x, const vfloat4 y, const vfloat4 z)
+{
+#if BLI_HAVE_SSE2
+  const __m128 a_lo = _mm_shuffle_ps(x.m, y.m, _MM_SHUFFLE(0, 0, 0, 0));
+  const __m128 a_hi = _mm_shuffle_ps(z.m, x.m, _MM_SHUFFLE(1, 1, 0, 0));
+  const __m128 b_lo = _mm_shuffle_ps(y.m, z.m, _MM_SHUFFLE(1, 1, 1, 1));
+  const __m128 b_hi = _mm_shuffle_ps(x.m, y.m, _MM_SHUFFLE(2, 2, 2, 2));
+  const __m128 c_lo = _mm_shuffle_ps(z.m, x.m, _MM_SHUFFLE(3, 3, 2, 2));
+  const __m128 c_hi = _mm_shuffle_ps(y.m, z.m, _MM_SHUFFLE(3, 3, 3, 3));
+  _mm_storeu_ps(ptr, _mm_shuffle_ps(a_lo, a_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+  _mm_storeu_ps(ptr + 4, _mm_shuffle_ps(b_lo, b_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+  _mm_storeu_ps(ptr + 8, _mm_shuffle_ps(c_lo, c_hi, _MM_SHUFFLE(2, 0, 2, 0)));
+#else
+  for (int i = 0; i < 4; i++) {
+    ptr[i * 3 + 0] = x.m[i];
+    ptr[i * 3 + 1] = y.m[i];
+    ptr[i * 3 + 2] = z.m[i];
+  }
+#endif
+}
+
+}  // namespace blender::simd
@@ -10,10 +10,19 @@
 
 #ifdef WITH_TBB
 #  include <tbb/parallel_sort.h>
-#else
-#  include <algorithm>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+#include "BLI_array.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -31,4 +40,283 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+namespace sort_detail {
+
+/** Below this size, the parallel sorts use the standard library sorts directly. */
+inline constexpr int64_t serial_sort_threshold = 4096;
+
+/**
+ * Merge two sorted ranges into #dst. Elements from #a come before equal elements from #b to keep
+ * the sort stable. Large merges are split at the median of the larger range.
+ */
+template<typename T, typename Compare>
+void parallel_merge(
+    T *a, const int64_t a_size, T *b, const int64_t b_size, T *dst, const Compare &comp)
+{
+  if (a_size + b_size <= serial_sort_threshold) {
+    std::merge(std::make_move_iterator(a),
+               std::make_move_iterator(a + a_size),
+               std::make_move_iterator(b),
+               std::make_move_iterator(b + b_size),
+               dst,
+               comp);
+    return;
+  }
+  int64_t a_mid, b_mid;
+  if (a_size >= b_size) {
+    a_mid = a_size / 2;
+    b_mid = std::lower_bound(b, b + b_size, a[a_mid], comp) - b;
+  }
+  else {
+    b_mid = b_size / 2;
+    a_mid = std::upper_bound(a, a + a_size, b[b_mid], comp) - a;
+  }
+  threading::parallel_invoke(
+      [&]() { parallel_merge(a, a_mid, b, b_mid, dst, comp); },
+      [&]() {
+        parallel_merge(
+            a + a_mid, a_size - a_mid, b + b_mid, b_size - b_mid, dst + a_mid + b_mid, comp);
+      });
+}
+
+/**
+ * Sort #data and write the result into #data or #buffer. Both halves are sorted into the other
+ * array first, so that every merge moves the elements exactly once.
+ */
+template<typename T, typename Compare>
+void stable_sort_recursive(T *data,
+                           T *buffer,
+                           const int64_t size,
+                           const bool result_in_buffer,
+                           const Compare &comp)
+{
+  if (size <= serial_sort_threshold) {
+    std::stable_sort(data, data + size, comp);
+    if (result_in_buffer) {
+      std::move(data, data + size, buffer);
+    }
+    return;
+  }
+  const int64_t mid = size / 2;
+  threading::parallel_invoke(
+      [&]() { stable_sort_recursive(data, buffer, mid, !result_in_buffer, comp); },
+      [&]() {
+        stable_sort_recursive(data + mid, buffer + mid, size - mid, !result_in_buffer, comp);
+      });
+  if (result_in_buffer) {
+    parallel_merge(data, mid, data + mid, size - mid, buffer, comp);
+  }
+  else {
+    parallel_merge(buffer, mid, buffer + mid, size - mid, data, comp);
+  }
+}
+
+/** Maps keys to unsigned integers that have the same order. */
+template<typename T> struct RadixKey;
+
+template<typename T> struct RadixKeyUnsigned {
+  using Bits = T;
+  static Bits encode(const T value)
+  {
+    return value;
+  }
+  static T decode(const Bits bits)
+  {
+    return bits;
+  }
+};
+
+template<typename T, typename BitsT> struct RadixKeySigned {
+  using Bits = BitsT;
+  static constexpr Bits sign_bit = Bits(1) << (sizeof(Bits) * 8 - 1);
+  static Bits encode(const T value)
+  {
+    return Bits(value) ^ sign_bit;
+  }
+  static T decode(const Bits bits)
+  {
+    return T(bits ^ sign_bit);
+  }
+};
+
+template<> struct RadixKey<uint32_t> : RadixKeyUnsigned<uint32_t> {};
+template<> struct RadixKey<uint64_t> : RadixKeyUnsigned<uint64_t> {};
+template<> struct RadixKey<int32_t> : RadixKeySigned<int32_t, uint32_t> {};
+template<> struct RadixKey<int64_t> : RadixKeySigned<int64_t, uint64_t> {};
+
+template<> struct RadixKey<float> {
+  using Bits = uint32_t;
+  static constexpr Bits sign_bit = Bits(1) << 31;
+  /** Flip all bits of negative values and only the sign bit of positive values. */
+  static Bits encode(const float value)
+  {
+    /* Negative zero is considered equal to zero, like with a comparison sort. */
+    const float value_no_negative_zero = (value == 0.0f) ? 0.0f : value;
+    Bits bits;
+    memcpy(&bits, &value_no_negative_zero, sizeof(bits));
+    return (bits & sign_bit) ? ~bits : bits | sign_bit;
+  }
+  static float decode(const Bits bits)
+  {
+    const Bits value_bits = (bits & sign_bit) ? bits ^ sign_bit : ~bits;
+    float value;
+    memcpy(&value, &value_bits, sizeof(value));
+    return value;
+  }
+};
+
+/**
+ * Least significant digit first radix sort of #keys, moving #values along with them (#values may
+ * be empty). Every pass counts the digits in chunks of the input in parallel and then scatters the
+ * chunks in parallel, which keeps the sort stable. Passes where all keys have the same digit are
+ * skipped.
+ */
+template<typename Bits, typename Value>
+void radix_sort_bits(MutableSpan<Bits> keys, MutableSpan<Value> values)
+{
+  constexpr int digit_bits = 8;
+  constexpr int buckets_num = 1 << digit_bits;
+  using Histogram = std::array<int64_t, buckets_num>;
+
+  const int64_t size = keys.size();
+  const bool has_values = !values.is_empty();
+  const int64_t chunk_size = std::max<int64_t>(16384, (size + 255) / 256);
+  const int64_t chunks_num = (size + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    return IndexRange(chunk * chunk_size, std::min(chunk_size, size - chunk * chunk_size));
+  };
+
+  Array<Bits> keys_buffer(size, NoInitialization());
+  Array<Value> values_buffer(has_values ? size : 0, NoInitialization());
+  Bits *src_keys = keys.data();
+  Bits *dst_keys = keys_buffer.data();
+  Value *src_values = values.data();
+  Value *dst_values = values_buffer.data();
+
+  Array<Histogram> histograms(chunks_num);
+  for (int shift = 0; shift < int(sizeof(Bits) * 8); shift += digit_bits) {
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        Histogram &histogram = histograms[chunk];
+        histogram.fill(0);
+        for (const int64_t i : chunk_range(chunk)) {
+          histogram[(src_keys[i] >> shift) & (buckets_num - 1)]++;
+        }
+      }
+    });
+
+    /* Turn the counts into the start offsets of each chunk and digit. */
+    bool single_digit = false;
+    int64_t offset = 0;
+    for (int digit = 0; digit < buckets_num; digit++) {
+      const int64_t digit_start = offset;
+      for (Histogram &histogram : histograms) {
+        const int64_t count = histogram[digit];
+        histogram[digit] = offset;
+        offset += count;
+      }
+      if (offset - digit_start == size) {
+        single_digit = true;
+        break;
+      }
+    }
+    if (single_digit) {
+      continue;
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        Histogram &histogram = histograms[chunk];
+        for (const int64_t i : chunk_range(chunk)) {
+          const int64_t dst = histogram[(src_keys[i] >> shift) & (buckets_num - 1)]++;
+          dst_keys[dst] = src_keys[i];
+          if (has_values) {
+            dst_values[dst] = src_values[i];
+          }
+        }
+      }
+    });
+    std::swap(src_keys, dst_keys);
+    std::swap(src_values, dst_values);
+  }
+
+  if (src_keys != keys.data()) {
+    threading::parallel_for(IndexRange(size), 8192, [&](const IndexRange range) {
+      std::copy_n(src_keys + range.start(), range.size(), keys.data() + range.start());
+      if (has_values) {
+        std::copy_n(src_values + range.start(), range.size(), values.data() + range.start());
+      }
+    });
+  }
+}
+
+}  // namespace sort_detail
+
+/**
+ * Stable parallel merge sort. The elements have to be default constructible and movable, because
+ * a buffer with the size of the input is used for merging.
+ */
+template<typename RandomAccessIterator, typename Compare>
+void parallel_stable_sort(RandomAccessIterator begin,
+                          RandomAccessIterator end,
+                          const Compare &comp)
+{
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  const int64_t size = int64_t(end - begin);
+  if (size <= sort_detail::serial_sort_threshold) {
+    std::stable_sort(begin, end, comp);
+    return;
+  }
+  T *data = std::addressof(*begin);
+  Array<T> buffer(size);
+  sort_detail::stable_sort_recursive(data, buffer.data(), size, false, comp);
+}
+
+template<typename RandomAccessIterator>
+void parallel_stable_sort(RandomAccessIterator begin, RandomAccessIterator end)
+{
+  parallel_stable_sort(begin, end, std::less<>());
+}
+
+/**
+ * Sort integer or float keys in ascending order with a parallel radix sort and reorder #values
+ * in the same way (#values may be empty). The sort is stable, so values with equal keys keep their
+ * order. This is much faster than comparison sorts for large arrays, but uses additional memory
+ * for a copy of the keys and values.
+ *
+ * Supported key types are 32 and 64 bit integers and floats, values have to be trivially
+ * copyable. NaN keys are not supported and negative zero becomes zero.
+ */
+template<typename Key, typename Value>
+void parallel_radix_sort_by_key(MutableSpan<Key> keys, MutableSpan<Value> values)
+{
+  using RadixKey = sort_detail::RadixKey<Key>;
+  using Bits = typename RadixKey::Bits;
+  static_assert(sizeof(Bits) == sizeof(Key));
+  static_assert(std::is_trivially_copyable_v<Value>);
+  BLI_assert(values.is_empty() || values.size() == keys.size());
+
+  /* Sort the keys in place as unsigned integers with the same order. */
+  MutableSpan<Bits> bits(reinterpret_cast<Bits *>(keys.data()), keys.size());
+  threading::parallel_for(keys.index_range(), 8192, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const Bits key_bits = RadixKey::encode(keys[i]);
+      memcpy(&bits[i], &key_bits, sizeof(Bits));
+    }
+  });
+  sort_detail::radix_sort_bits(bits, values);
+  threading::parallel_for(keys.index_range(), 8192, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const Key key = RadixKey::decode(bits[i]);
+      memcpy(&keys[i], &key, sizeof(Key));
+    }
+  });
+}
+
+/** Sort integer or float keys in ascending order with a parallel radix sort. */
+template<typename Key> void parallel_radix_sort(MutableSpan<Key> keys)
+{
+  parallel_radix_sort_by_key<Key, int>(keys, {});
+}
+
 }  // namespace blender
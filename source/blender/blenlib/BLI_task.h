@@ -318,6 +318,21 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
  * TaskNode *node_3 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  * TaskNode *node_4 = BLI_task_graph_node_create(task_graph, node_exec, task_data, NULL);
  * \endcode
+ *
+ * Priorities, Cancellation and Timing
+ * -----------------------------------
+ *
+ * Nodes created with #TASK_PRIORITY_HIGH are executed before other nodes that are ready at the
+ * same time, which is useful for nodes that many other nodes depend on.
+ *
+ * #BLI_task_graph_cancel can be called from any thread, including from within a node. Nodes that
+ * did not start yet are skipped. The graph still has to be waited for, after which it can be
+ * reused. Long running nodes can poll #BLI_task_graph_is_cancelled to stop early.
+ *
+ * A timing callback can be set, which is called after every node with its name and its start and
+ * end time from #BLI_time_now_seconds. It's called on the thread that executed the node, so that
+ * it can be used to record the individual threads in a trace, e.g. in the Chrome trace event
+ * format that is also used for `--debug-depsgraph-trace`.
  * \{ */
 
 struct TaskGraph;
@@ -325,14 +340,41 @@ struct TaskNode;
 
 typedef void (*TaskGraphNodeRunFunction)(void *__restrict task_data);
 typedef void (*TaskGraphNodeFreeFunction)(void *task_data);
+typedef void (*TaskGraphNodeTimingFunction)(void *userdata,
+                                            const char *node_name,
+                                            double start_time,
+                                            double end_time);
 
 struct TaskGraph *BLI_task_graph_create(void);
 void BLI_task_graph_work_and_wait(struct TaskGraph *task_graph);
 void BLI_task_graph_free(struct TaskGraph *task_graph);
+/**
+ * Skip all nodes that did not start yet, until the graph has been waited for.
+ * Can be called from any thread.
+ */
+void BLI_task_graph_cancel(struct TaskGraph *task_graph);
+bool BLI_task_graph_is_cancelled(const struct TaskGraph *task_graph);
+/**
+ * Set a callback that is called after every executed node, or clear it by passing NULL.
+ * Must not be changed while the graph is working.
+ */
+void BLI_task_graph_timing_callback_set(struct TaskGraph *task_graph,
+                                        TaskGraphNodeTimingFunction timing_func,
+                                        void *userdata);
 struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             TaskGraphNodeRunFunction run,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func);
+struct TaskNode *BLI_task_graph_node_create_ex(struct TaskGraph *task_graph,
+                                               TaskGraphNodeRunFunction run,
+                                               void *user_data,
+                                               TaskGraphNodeFreeFunction free_func,
+                                               eTaskPriority priority);
+/**
+ * Name of the node passed to the timing callback. The string is not copied, so it has to
+ * outlive the graph, typically it's a string literal.
+ */
+void BLI_task_graph_node_set_name(struct TaskNode *task_node, const char *name);
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
 
@@ -32,6 +32,9 @@
 #  endif
 #endif
 
+#include <cstring>
+#include <type_traits>
+
 #include "BLI_function_ref.hh"
 #include "BLI_index_range.hh"
 #include "BLI_lazy_threading.hh"
@@ -71,6 +74,9 @@ void parallel_for_impl(IndexRange range,
                        int64_t grain_size,
                        FunctionRef<void(IndexRange)> function,
                        const TaskSizeHints &size_hints);
+void parallel_for_numa_impl(IndexRange range,
+                            int64_t grain_size,
+                            FunctionRef<void(IndexRange)> function);
 void memory_bandwidth_bound_task_impl(FunctionRef<void()> function);
 }  // namespace detail
 
@@ -222,6 +228,56 @@ inline void parallel_invoke(const bool use_threading, Functions &&...functions)
   }
 }
 
+/**
+ * Number of NUMA nodes that #parallel_for_numa distributes work on. This is 1 when the system has
+ * only one node or when TBB can't detect the topology, which requires the optional `tbbbind`
+ * library.
+ */
+int numa_nodes_num();
+
+/**
+ * Same as #parallel_for, but on systems with multiple NUMA nodes, the range is split into one
+ * contiguous part per node and each part is only processed by threads running on that node.
+ *
+ * The split only depends on the size of the range. So when multiple passes iterate over arrays of
+ * the same size with this function, every element is always processed on the same node. Memory
+ * that was first written in such a loop is placed on that node by the operating system, so later
+ * passes access local memory instead of going through the inter-socket link.
+ *
+ * Without multiple NUMA nodes, this behaves exactly like #parallel_for.
+ */
+template<typename Function>
+inline void parallel_for_numa(const IndexRange range,
+                              const int64_t grain_size,
+                              const Function &function)
+{
+  if (range.is_empty()) {
+    return;
+  }
+  if (range.size() <= grain_size) {
+    function(range);
+    return;
+  }
+  detail::parallel_for_numa_impl(range, grain_size, function);
+}
+
+/**
+ * Zero-initialize a newly allocated array with the same split as #parallel_for_numa. Operating
+ * systems allocate physical pages on the node of the thread that touches them first, so this
+ * distributes the array over the nodes that process it later, instead of placing all of it on the
+ * node of the allocating thread. Does nothing when there is only one NUMA node.
+ */
+template<typename T> inline void numa_first_touch(MutableSpan<T> data)
+{
+  static_assert(std::is_trivial_v<T>);
+  if (numa_nodes_num() <= 1) {
+    return;
+  }
+  parallel_for_numa(data.index_range(), 16384, [&](const IndexRange range) {
+    memset(static_cast<void *>(data.slice(range).data()), 0, size_t(range.size()) * sizeof(T));
+  });
+}
+
 /** See #BLI_task_isolate for a description of what isolating a task means. */
 template<typename Function> inline void isolate_task(const Function &function)
 {
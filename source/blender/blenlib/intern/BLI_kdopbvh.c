@@ -1569,6 +1569,36 @@ static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
       data->nearest.dist_sq = calc_nearest_point_squared(data->proj, node, data->nearest.co);
     }
   }
+  else if (node->node_num > 2) {
+    /* For wide nodes, dive into the children from the closest to the furthest, so the nearest
+     * distance shrinks as early as possible and more of the remaining children are skipped. */
+    float nearest[3];
+    float children_dist_sq[MAX_TREETYPE];
+    BVHNode *children[MAX_TREETYPE];
+    int children_num = 0;
+
+    for (int i = 0; i != node->node_num; i++) {
+      const float dist_sq = calc_nearest_point_squared(data->proj, node->children[i], nearest);
+      if (dist_sq >= data->nearest.dist_sq) {
+        continue;
+      }
+      /* Insertion sort, there are only a few children. */
+      int j = children_num++;
+      for (; j > 0 && children_dist_sq[j - 1] > dist_sq; j--) {
+        children_dist_sq[j] = children_dist_sq[j - 1];
+        children[j] = children[j - 1];
+      }
+      children_dist_sq[j] = dist_sq;
+      children[j] = node->children[i];
+    }
+
+    for (int i = 0; i != children_num; i++) {
+      if (children_dist_sq[i] >= data->nearest.dist_sq) {
+        break;
+      }
+      dfs_find_nearest_dfs(data, children[i]);
+    }
+  }
   else {
     /* Better heuristic to pick the closest node to dive on */
     int i;
@@ -202,6 +202,23 @@ static BLI_mempool_chunk *mempool_chunk_alloc(const BLI_mempool *pool)
   return MEM_mallocN(sizeof(BLI_mempool_chunk) + (size_t)pool->csize, "mempool chunk");
 }
 
+/**
+ * Append an uninitialized chunk to \a pool->chunks.
+ */
+static void mempool_chunk_append(BLI_mempool *pool, BLI_mempool_chunk *mpchunk)
+{
+  if (pool->chunk_tail) {
+    pool->chunk_tail->next = mpchunk;
+  }
+  else {
+    BLI_assert(pool->chunks == NULL);
+    pool->chunks = mpchunk;
+  }
+
+  mpchunk->next = NULL;
+  pool->chunk_tail = mpchunk;
+}
+
 /**
  * Initialize a chunk and add into \a pool->chunks
  *
@@ -219,17 +236,7 @@ static BLI_freenode *mempool_chunk_add(BLI_mempool *pool,
   BLI_freenode *curnode = CHUNK_DATA(mpchunk);
   uint j;
 
-  /* append */
-  if (pool->chunk_tail) {
-    pool->chunk_tail->next = mpchunk;
-  }
-  else {
-    BLI_assert(pool->chunks == NULL);
-    pool->chunks = mpchunk;
-  }
-
-  mpchunk->next = NULL;
-  pool->chunk_tail = mpchunk;
+  mempool_chunk_append(pool, mpchunk);
 
   if (UNLIKELY(pool->free == NULL)) {
     pool->free = curnode;
@@ -454,6 +461,44 @@ void *BLI_mempool_alloc(BLI_mempool *pool)
   return (void *)free_pop;
 }
 
+void BLI_mempool_alloc_n(BLI_mempool *pool, void **r_elems, const uint elems_num)
+{
+  const uint esize = pool->esize;
+  uint i = 0;
+
+  while (i < elems_num) {
+    if (pool->free != NULL || elems_num - i < pool->pchunk) {
+      r_elems[i++] = BLI_mempool_alloc(pool);
+      continue;
+    }
+
+    /* Hand out all elements of a new chunk directly, without building its free list first. */
+    BLI_mempool_chunk *mpchunk = mempool_chunk_alloc(pool);
+    mempool_chunk_append(pool, mpchunk);
+
+    char *elem = CHUNK_DATA(mpchunk);
+    for (uint j = 0; j < pool->pchunk; j++, elem += esize) {
+      BLI_asan_poison(elem, esize);
+      BLI_asan_unpoison(elem, esize - POISON_REDZONE_SIZE);
+#ifdef WITH_MEM_VALGRIND
+      VALGRIND_MEMPOOL_ALLOC(pool, elem, esize - POISON_REDZONE_SIZE);
+#endif
+      if (pool->flag & BLI_MEMPOOL_ALLOW_ITER) {
+        ((BLI_freenode *)elem)->freeword = USEDWORD;
+      }
+#ifdef WITH_MEM_VALGRIND
+      VALGRIND_MAKE_MEM_UNDEFINED(elem, esize - POISON_REDZONE_SIZE);
+#endif
+      r_elems[i++] = elem;
+    }
+
+    pool->totused += pool->pchunk;
+#ifdef USE_TOTALLOC
+    pool->totalloc += pool->pchunk;
+#endif
+  }
+}
+
 void *BLI_mempool_calloc(BLI_mempool *pool)
 {
   void *retval = BLI_mempool_alloc(pool);
@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_arena_allocator.hh"
+
+namespace blender {
+
+static thread_local ArenaScope *active_scope = nullptr;
+
+ArenaScope::Activation::Activation(ArenaScope *scope) : previous_(active_scope)
+{
+  active_scope = scope;
+}
+
+ArenaScope::Activation::~Activation()
+{
+  active_scope = previous_;
+}
+
+ArenaScope *ArenaScope::active()
+{
+  return active_scope;
+}
+
+}  // namespace blender
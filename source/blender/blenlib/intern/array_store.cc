@@ -85,6 +85,17 @@
  * Once a match is found, there is a high chance next chunks match too,
  * so this is checked to avoid performing so many hash-lookups.
  * Otherwise new chunks are created.
+ *
+ * Content Defined Chunks
+ * ----------------------
+ *
+ * By default new data is split into chunks of a fixed size, counted from the start of each range
+ * of data that didn't match the reference. With #BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS, chunk
+ * boundaries are instead placed where a rolling hash of the last few elements matches a pattern
+ * (within the min/max chunk size limits). The boundaries then only depend on the nearby content,
+ * so inserting or removing elements only changes the chunks around the edit, and identical runs of
+ * data in different states are split into identical chunks, even when they are at different
+ * offsets or were added without the other state as a reference.
  */
 
 #include <algorithm>
@@ -257,6 +268,11 @@ struct BArrayInfo {
   size_t accum_steps;
   size_t accum_read_ahead_len;
 #endif
+
+  /** See #BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS. */
+  bool use_content_defined_chunks;
+  /** A chunk boundary is placed after an element when these bits of the rolling hash are zero. */
+  uint32_t content_defined_mask;
 };
 
 struct BArrayMemory {
@@ -346,6 +362,7 @@ struct BTableRef {
 /** \} */
 
 static size_t bchunk_list_size(const BChunkList *chunk_list);
+static hash_key hash_data(const uchar *key, size_t n);
 
 /* -------------------------------------------------------------------- */
 /** \name Internal BChunk API
@@ -600,6 +617,52 @@ static void bchunk_list_calc_trim_len(const BArrayInfo *info,
   *r_data_last_chunk_len = data_last_chunk_len;
 }
 
+/**
+ * Number of elements that the rolling hash depends on, since the hash is shifted once per element.
+ */
+#define BCHUNK_CONTENT_DEFINED_WINDOW 32
+
+/**
+ * Find the length of the next content defined chunk at the start of \a data.
+ *
+ * The result is a multiple of the stride within the min/max chunk size, except for the last
+ * chunk. It never leaves a remainder smaller than the minimum chunk size.
+ */
+static size_t bchunk_content_defined_len(const BArrayInfo *info,
+                                         const uchar *data,
+                                         const size_t data_len)
+{
+  const size_t stride = info->chunk_stride;
+  const size_t len_min = info->chunk_byte_size_min;
+  if (data_len < len_min * 2) {
+    return data_len;
+  }
+  /* Don't leave a remainder that is too small to be a chunk. */
+  const size_t len_max = std::min(info->chunk_byte_size_max, data_len - len_min);
+
+  /* Start early enough to have a full window of elements when the minimum size is reached. */
+  const size_t window_bytes = BCHUNK_CONTENT_DEFINED_WINDOW * stride;
+  size_t i = (len_min > window_bytes) ? (len_min - window_bytes) : 0;
+
+  uint32_t hash = 0;
+  for (; i + stride <= len_max; i += stride) {
+    /* Gear hash, the high bits depend on the last #BCHUNK_CONTENT_DEFINED_WINDOW elements. */
+    uint32_t elem_hash = hash_data(&data[i], stride);
+    elem_hash ^= elem_hash >> 16;
+    elem_hash *= 0x85ebca6bu;
+    elem_hash ^= elem_hash >> 13;
+    hash = (hash << 1) + elem_hash;
+    if (i + stride >= len_min && (hash & info->content_defined_mask) == 0) {
+      return i + stride;
+    }
+  }
+  if (data_len <= info->chunk_byte_size_max) {
+    return data_len;
+  }
+  /* No boundary found, split at the largest size that is still a multiple of the stride. */
+  return len_max - (len_max % stride);
+}
+
 /**
  * Append and don't manage merging small chunks.
  */
@@ -680,6 +743,19 @@ static void bchunk_list_append_data_n(const BArrayInfo *info,
                                       const uchar *data,
                                       size_t data_len)
 {
+  if (info->use_content_defined_chunks) {
+    /* The first chunk may be merged with the previous one. */
+    size_t i_prev = bchunk_content_defined_len(info, data, data_len);
+    bchunk_list_append_data(info, bs_mem, chunk_list, data, i_prev);
+    while (i_prev != data_len) {
+      const size_t len = bchunk_content_defined_len(info, &data[i_prev], data_len - i_prev);
+      BChunk *chunk = bchunk_new_copydata(bs_mem, &data[i_prev], len);
+      bchunk_list_append_only(bs_mem, chunk_list, chunk);
+      i_prev += len;
+    }
+    return;
+  }
+
   size_t data_trim_len, data_last_chunk_len;
   bchunk_list_calc_trim_len(info, data_len, &data_trim_len, &data_last_chunk_len);
 
@@ -743,6 +819,19 @@ static void bchunk_list_fill_from_array(const BArrayInfo *info,
 {
   BLI_assert(BLI_listbase_is_empty(&chunk_list->chunk_refs));
 
+  if (info->use_content_defined_chunks) {
+    size_t i_prev = 0;
+    while (i_prev != data_len) {
+      const size_t len = bchunk_content_defined_len(info, &data[i_prev], data_len - i_prev);
+      BChunk *chunk = bchunk_new_copydata(bs_mem, &data[i_prev], len);
+      bchunk_list_append_only(bs_mem, chunk_list, chunk);
+      i_prev += len;
+    }
+    ASSERT_CHUNKLIST_SIZE(chunk_list, data_len);
+    ASSERT_CHUNKLIST_DATA(chunk_list, data);
+    return;
+  }
+
   size_t data_trim_len, data_last_chunk_len;
   bchunk_list_calc_trim_len(info, data_len, &data_trim_len, &data_last_chunk_len);
 
@@ -1490,6 +1579,11 @@ static BChunkList *bchunk_list_from_data_merge(const BArrayInfo *info,
  * \{ */
 
 BArrayStore *BLI_array_store_create(uint stride, uint chunk_count)
+{
+  return BLI_array_store_create_ex(stride, chunk_count, 0);
+}
+
+BArrayStore *BLI_array_store_create_ex(uint stride, uint chunk_count, const int flag)
 {
   BLI_assert(stride > 0 && chunk_count > 0);
 
@@ -1533,6 +1627,25 @@ BArrayStore *BLI_array_store_create(uint stride, uint chunk_count)
   bs->info.accum_read_ahead_bytes = std::min(size_t(BCHUNK_HASH_LEN), chunk_count) * stride;
 #endif
 
+#ifdef USE_MERGE_CHUNKS
+  bs->info.use_content_defined_chunks = (flag & BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS) != 0;
+#else
+  /* The boundaries rely on the min/max chunk sizes. */
+  bs->info.use_content_defined_chunks = false;
+#endif
+  if (bs->info.use_content_defined_chunks) {
+    /* Boundaries are searched after the minimum size has been reached, so the chunk size is on
+     * average the minimum size plus the expected distance between pattern matches. */
+    const uint chunk_count_min = std::max(1u, chunk_count / BCHUNK_SIZE_MIN_DIV);
+    const uint pattern_distance = std::max(1u, chunk_count - chunk_count_min);
+    int mask_bits = 0;
+    while (mask_bits < BCHUNK_CONTENT_DEFINED_WINDOW - 1 && (2u << mask_bits) <= pattern_distance)
+    {
+      mask_bits++;
+    }
+    bs->info.content_defined_mask = mask_bits ? (~0u << (32 - mask_bits)) : 0u;
+  }
+
   bs->memory.chunk_list = BLI_mempool_create(sizeof(BChunkList), 0, 512, BLI_MEMPOOL_NOP);
   bs->memory.chunk_ref = BLI_mempool_create(sizeof(BChunkRef), 0, 512, BLI_MEMPOOL_NOP);
   /* Allow iteration to simplify freeing, otherwise its not needed
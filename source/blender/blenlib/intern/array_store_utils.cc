@@ -17,6 +17,14 @@
 BArrayStore *BLI_array_store_at_size_ensure(BArrayStore_AtSize *bs_stride,
                                             const int stride,
                                             const int chunk_size)
+{
+  return BLI_array_store_at_size_ensure_ex(bs_stride, stride, chunk_size, 0);
+}
+
+BArrayStore *BLI_array_store_at_size_ensure_ex(BArrayStore_AtSize *bs_stride,
+                                               const int stride,
+                                               const int chunk_size,
+                                               const int flag)
 {
   if (bs_stride->stride_table_len < stride) {
     bs_stride->stride_table_len = stride;
@@ -35,7 +43,7 @@ BArrayStore *BLI_array_store_at_size_ensure(BArrayStore_AtSize *bs_stride,
       chunk_count = size / stride;
     }
 
-    (*bs_p) = BLI_array_store_create(stride, chunk_count);
+    (*bs_p) = BLI_array_store_create_ex(stride, chunk_count, flag);
   }
   return *bs_p;
 }
@@ -15,7 +15,7 @@ void copy(const GVArray &src, GMutableSpan dst, const int64_t grain_size)
 {
   BLI_assert(src.type() == dst.type());
   BLI_assert(src.size() == dst.size());
-  threading::parallel_for(src.index_range(), grain_size, [&](const IndexRange range) {
+  threading::parallel_for_numa(src.index_range(), grain_size, [&](const IndexRange range) {
     src.materialize_to_uninitialized(range, dst.data());
   });
 }
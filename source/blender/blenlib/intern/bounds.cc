@@ -0,0 +1,57 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_bounds.hh"
+#include "BLI_simd.hh"
+
+namespace blender::bounds::detail {
+
+static Bounds<float3> min_max_serial(const Span<float3> values)
+{
+  Bounds<float3> result{values.first(), values.first()};
+  int64_t i = 0;
+  if (values.size() >= 4) {
+    /* Process four vectors at once, with a batch per component. */
+    const float *data = reinterpret_cast<const float *>(values.data());
+    simd::vfloat4 min_x, min_y, min_z;
+    simd::load_float3_soa(data, min_x, min_y, min_z);
+    simd::vfloat4 max_x = min_x, max_y = min_y, max_z = min_z;
+    for (i = 4; i + 4 <= values.size(); i += 4) {
+      simd::vfloat4 x, y, z;
+      simd::load_float3_soa(data + i * 3, x, y, z);
+      min_x = simd::min(min_x, x);
+      min_y = simd::min(min_y, y);
+      min_z = simd::min(min_z, z);
+      max_x = simd::max(max_x, x);
+      max_y = simd::max(max_y, y);
+      max_z = simd::max(max_z, z);
+    }
+    result.min = float3(simd::reduce_min(min_x), simd::reduce_min(min_y), simd::reduce_min(min_z));
+    result.max = float3(simd::reduce_max(max_x), simd::reduce_max(max_y), simd::reduce_max(max_z));
+  }
+  for (; i < values.size(); i++) {
+    math::min_max(values[i], result.min, result.max);
+  }
+  return result;
+}
+
+Bounds<float3> min_max(const Span<float3> values)
+{
+  BLI_assert(!values.is_empty());
+  const Bounds<float3> init{values.first(), values.first()};
+  return threading::parallel_reduce(
+      values.index_range(),
+      1024,
+      init,
+      [&](const IndexRange range, const Bounds<float3> &init) {
+        return merge(init, min_max_serial(values.slice(range)));
+      },
+      [](const Bounds<float3> &a, const Bounds<float3> &b) { return merge(a, b); });
+}
+
+}  // namespace blender::bounds::detail
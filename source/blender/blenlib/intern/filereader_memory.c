@@ -128,3 +128,31 @@ FileReader *BLI_filereader_new_mmap(int filedes)
 
   return (FileReader *)mem;
 }
+
+const void *BLI_filereader_memory_data_get(FileReader *reader, size_t *r_length)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+  if (reader->close == memory_close_raw) {
+    *r_length = mem->length;
+    return mem->data;
+  }
+#ifndef WIN32
+  /* On Windows, IO errors in mapped memory raise exceptions that are only handled in
+   * #BLI_mmap_read, elsewhere a SIGBUS handler resets the mapping to zeroes. */
+  if (reader->close == memory_close_mmap) {
+    *r_length = mem->length;
+    return BLI_mmap_get_pointer(mem->mmap);
+  }
+#endif
+  *r_length = 0;
+  return NULL;
+}
+
+bool BLI_filereader_memory_has_io_error(FileReader *reader)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+  if (reader->close == memory_close_mmap) {
+    return BLI_mmap_has_io_error(mem->mmap);
+  }
+  return false;
+}
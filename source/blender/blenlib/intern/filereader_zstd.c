@@ -11,9 +11,47 @@
 
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Maximum number of frames of a seekable file that are decompressed ahead of the current read
+ * position by worker threads. Frames written by Blender are 1MB each, see `writefile.cc`.
+ */
+#define ZSTD_READ_AHEAD_FRAMES_MAX 16
+
+typedef enum eZstdFrameState {
+  /** The slot does not contain a valid frame. */
+  ZSTD_FRAME_EMPTY = 0,
+  /** The compressed data is being read by the thread owning the reader. */
+  ZSTD_FRAME_READING,
+  /** The compressed data is read, waiting for a worker thread to decompress it. */
+  ZSTD_FRAME_SCHEDULED,
+  ZSTD_FRAME_DECOMPRESSING,
+  ZSTD_FRAME_DONE,
+  ZSTD_FRAME_FAILED,
+} eZstdFrameState;
+
+/** A decompressed frame of a seekable file, part of a bounded cache. */
+typedef struct ZstdFrameSlot {
+  int frame;
+  eZstdFrameState state;
+  /** Used to evict the least recently used frame when the cache is full. */
+  uint64_t last_used;
+
+  ZSTD_DCtx *ctx;
+
+  char *compressed_data;
+  size_t compressed_size;
+  size_t compressed_alloc_size;
+
+  char *uncompressed_data;
+  size_t uncompressed_size;
+  size_t uncompressed_alloc_size;
+} ZstdFrameSlot;
+
 typedef struct {
   FileReader reader;
 
@@ -28,8 +66,17 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    /** Frame cache, frames following the one being read are decompressed in the background. */
+    ZstdFrameSlot *slots;
+    int slots_num;
+    int read_ahead_num;
+    uint64_t use_counter;
+
+    /** Only set when there are multiple threads to decompress frames with. */
+    TaskPool *task_pool;
+    /** Protects the state of the slots, signaled whenever a frame is done decompressing. */
+    ThreadMutex mutex;
+    ThreadCondition cond;
   } seek;
 } ZstdReader;
 
@@ -125,11 +172,50 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
-
   return true;
 }
 
+static void zstd_frame_cache_init(ZstdReader *zstd)
+{
+  const int threads_num = BLI_task_scheduler_num_threads();
+  /* Keep one extra slot for the current frame and one for the previous frame,
+   * since delayed reading of #BHead data tends to seek back a little. */
+  zstd->seek.read_ahead_num = (threads_num > 1) ? min_ii(threads_num, ZSTD_READ_AHEAD_FRAMES_MAX) :
+                                                  0;
+  zstd->seek.slots_num = zstd->seek.read_ahead_num + 2;
+  zstd->seek.slots = MEM_calloc_arrayN(zstd->seek.slots_num, sizeof(ZstdFrameSlot), __func__);
+  for (int i = 0; i < zstd->seek.slots_num; i++) {
+    zstd->seek.slots[i].frame = -1;
+  }
+  zstd->seek.use_counter = 0;
+
+  BLI_mutex_init(&zstd->seek.mutex);
+  BLI_condition_init(&zstd->seek.cond);
+  zstd->seek.task_pool = (zstd->seek.read_ahead_num > 0) ?
+                             BLI_task_pool_create(zstd, TASK_PRIORITY_HIGH) :
+                             NULL;
+}
+
+static void zstd_frame_cache_free(ZstdReader *zstd)
+{
+  if (zstd->seek.task_pool) {
+    /* Wait for pending tasks, they may still access the slots. */
+    BLI_task_pool_work_and_wait(zstd->seek.task_pool);
+    BLI_task_pool_free(zstd->seek.task_pool);
+  }
+  for (int i = 0; i < zstd->seek.slots_num; i++) {
+    ZstdFrameSlot *slot = &zstd->seek.slots[i];
+    if (slot->ctx) {
+      ZSTD_freeDCtx(slot->ctx);
+    }
+    MEM_SAFE_FREE(slot->compressed_data);
+    MEM_SAFE_FREE(slot->uncompressed_data);
+  }
+  MEM_freeN(zstd->seek.slots);
+  BLI_mutex_end(&zstd->seek.mutex);
+  BLI_condition_end(&zstd->seek.cond);
+}
+
 /* Find out which frame contains the given position in the uncompressed stream.
  * Basically just bisection. */
 static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
@@ -153,42 +239,186 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+/* Read the compressed data of a frame into a slot, only done by the thread owning the reader
+ * since the base #FileReader is not thread-safe. */
+static bool zstd_frame_read_compressed(ZstdReader *zstd, ZstdFrameSlot *slot, int frame)
+{
+  slot->compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
+  slot->uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                            zstd->seek.uncompressed_ofs[frame];
+
+  if (slot->compressed_alloc_size < slot->compressed_size) {
+    MEM_SAFE_FREE(slot->compressed_data);
+    slot->compressed_data = MEM_mallocN(slot->compressed_size, __func__);
+    slot->compressed_alloc_size = slot->compressed_size;
+  }
+  if (slot->uncompressed_alloc_size < slot->uncompressed_size) {
+    MEM_SAFE_FREE(slot->uncompressed_data);
+    slot->uncompressed_data = MEM_mallocN(slot->uncompressed_size, __func__);
+    slot->uncompressed_alloc_size = slot->uncompressed_size;
+  }
+
+  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
+      zstd->base->read(zstd->base, slot->compressed_data, slot->compressed_size) <
+          slot->compressed_size)
+  {
+    return false;
+  }
+  return true;
+}
+
+/* Decompress the frame data of a slot, can be called from any thread. */
+static bool zstd_frame_decompress(ZstdFrameSlot *slot)
+{
+  if (slot->ctx == NULL) {
+    slot->ctx = ZSTD_createDCtx();
+  }
+  size_t res = ZSTD_decompressDCtx(slot->ctx,
+                                   slot->uncompressed_data,
+                                   slot->uncompressed_size,
+                                   slot->compressed_data,
+                                   slot->compressed_size);
+  return !ZSTD_isError(res) && res >= slot->uncompressed_size;
+}
+
+static void zstd_frame_decompress_task(TaskPool *__restrict pool, void *taskdata)
+{
+  ZstdReader *zstd = BLI_task_pool_user_data(pool);
+  ZstdFrameSlot *slot = taskdata;
+
+  BLI_mutex_lock(&zstd->seek.mutex);
+  if (slot->state != ZSTD_FRAME_SCHEDULED) {
+    /* Frame was evicted or already decompressed by the reading thread itself. */
+    BLI_mutex_unlock(&zstd->seek.mutex);
+    return;
+  }
+  slot->state = ZSTD_FRAME_DECOMPRESSING;
+  BLI_mutex_unlock(&zstd->seek.mutex);
+
+  const bool success = zstd_frame_decompress(slot);
+
+  BLI_mutex_lock(&zstd->seek.mutex);
+  slot->state = success ? ZSTD_FRAME_DONE : ZSTD_FRAME_FAILED;
+  BLI_condition_notify_all(&zstd->seek.cond);
+  BLI_mutex_unlock(&zstd->seek.mutex);
+}
+
+static ZstdFrameSlot *zstd_frame_cache_find(ZstdReader *zstd, int frame)
+{
+  for (int i = 0; i < zstd->seek.slots_num; i++) {
+    ZstdFrameSlot *slot = &zstd->seek.slots[i];
+    if (slot->frame == frame && !ELEM(slot->state, ZSTD_FRAME_EMPTY, ZSTD_FRAME_FAILED)) {
+      return slot;
+    }
+  }
+  return NULL;
+}
+
+/* Find the least recently used slot that may be reused for another frame, keeping the frames
+ * in the `[window_start, window_end]` range which are about to be read. */
+static ZstdFrameSlot *zstd_frame_cache_evict(ZstdReader *zstd, int window_start, int window_end)
+{
+  ZstdFrameSlot *best_slot = NULL;
+  for (int i = 0; i < zstd->seek.slots_num; i++) {
+    ZstdFrameSlot *slot = &zstd->seek.slots[i];
+    if (slot->state == ZSTD_FRAME_DECOMPRESSING) {
+      continue;
+    }
+    if (slot->frame >= window_start && slot->frame <= window_end &&
+        !ELEM(slot->state, ZSTD_FRAME_EMPTY, ZSTD_FRAME_FAILED))
+    {
+      continue;
+    }
+    if (best_slot == NULL || slot->last_used < best_slot->last_used) {
+      best_slot = slot;
+    }
+  }
+  if (best_slot) {
+    /* A pending task for this slot will notice the state change and skip it. */
+    best_slot->state = ZSTD_FRAME_EMPTY;
+    best_slot->frame = -1;
+  }
+  return best_slot;
+}
+
+/* Ensure that the given frame is decompressed, and schedule decompression of the frames
+ * after it in the background. The returned data is valid until the next call. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  const int window_end = min_ii(frame + zstd->seek.read_ahead_num, zstd->seek.frames_num - 1);
+
+  BLI_mutex_lock(&zstd->seek.mutex);
+
+  ZstdFrameSlot *slot = zstd_frame_cache_find(zstd, frame);
+  if (slot == NULL) {
+    /* All slots outside the window may be busy in case of a large seek, wait for them. */
+    while ((slot = zstd_frame_cache_evict(zstd, frame, window_end)) == NULL) {
+      BLI_condition_wait(&zstd->seek.cond, &zstd->seek.mutex);
+    }
+    slot->frame = frame;
+    slot->state = ZSTD_FRAME_READING;
+    BLI_mutex_unlock(&zstd->seek.mutex);
+
+    bool success = zstd_frame_read_compressed(zstd, slot, frame);
+    success = success && zstd_frame_decompress(slot);
+
+    BLI_mutex_lock(&zstd->seek.mutex);
+    slot->state = success ? ZSTD_FRAME_DONE : ZSTD_FRAME_FAILED;
   }
+  else if (slot->state == ZSTD_FRAME_SCHEDULED) {
+    /* Don't wait for a worker thread to pick up the frame that is needed right now. */
+    slot->state = ZSTD_FRAME_DECOMPRESSING;
+    BLI_mutex_unlock(&zstd->seek.mutex);
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+    const bool success = zstd_frame_decompress(slot);
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+    BLI_mutex_lock(&zstd->seek.mutex);
+    slot->state = success ? ZSTD_FRAME_DONE : ZSTD_FRAME_FAILED;
+  }
+  else {
+    while (slot->state == ZSTD_FRAME_DECOMPRESSING) {
+      BLI_condition_wait(&zstd->seek.cond, &zstd->seek.mutex);
+    }
+  }
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
-  char *compressed_data = MEM_mallocN(compressed_size, __func__);
-  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
-      zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
-  {
-    MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
-    return NULL;
+  slot->last_used = ++zstd->seek.use_counter;
+  const char *result = (slot->state == ZSTD_FRAME_DONE) ? slot->uncompressed_data : NULL;
+
+  /* Read ahead into the slots that are not needed anymore. */
+  ZstdFrameSlot *scheduled_slots[ZSTD_READ_AHEAD_FRAMES_MAX];
+  int scheduled_slots_num = 0;
+  for (int read_ahead_frame = frame + 1; read_ahead_frame <= window_end; read_ahead_frame++) {
+    if (zstd_frame_cache_find(zstd, read_ahead_frame)) {
+      continue;
+    }
+    ZstdFrameSlot *read_ahead_slot = zstd_frame_cache_evict(zstd, frame, window_end);
+    if (read_ahead_slot == NULL) {
+      break;
+    }
+    read_ahead_slot->frame = read_ahead_frame;
+    read_ahead_slot->state = ZSTD_FRAME_READING;
+    BLI_mutex_unlock(&zstd->seek.mutex);
+
+    const bool success = zstd_frame_read_compressed(zstd, read_ahead_slot, read_ahead_frame);
+
+    BLI_mutex_lock(&zstd->seek.mutex);
+    if (!success) {
+      read_ahead_slot->state = ZSTD_FRAME_FAILED;
+      break;
+    }
+    read_ahead_slot->state = ZSTD_FRAME_SCHEDULED;
+    scheduled_slots[scheduled_slots_num++] = read_ahead_slot;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
-  MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
-    return NULL;
+  BLI_mutex_unlock(&zstd->seek.mutex);
+
+  /* Push outside of the lock, tasks may be executed immediately. */
+  for (int i = 0; i < scheduled_slots_num; i++) {
+    BLI_task_pool_push(
+        zstd->seek.task_pool, zstd_frame_decompress_task, scheduled_slots[i], false, NULL);
   }
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  return result;
 }
 
 static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -279,12 +509,9 @@ static void zstd_close(FileReader *reader)
 
   ZSTD_freeDCtx(zstd->ctx);
   if (zstd->reader.seek) {
+    zstd_frame_cache_free(zstd);
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -304,6 +531,7 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
   if (zstd_read_seek_table(zstd)) {
     zstd->reader.read = zstd_read_seekable;
     zstd->reader.seek = zstd_seek;
+    zstd_frame_cache_init(zstd);
   }
   else {
     zstd->reader.read = zstd_read;
@@ -3,11 +3,28 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <cstring>
+#include <fcntl.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_system.h"
+#include "BLI_tempfile.h"
+
+#include BLI_SYSTEM_PID_H
 
 namespace blender::implicit_sharing {
 
@@ -33,6 +50,88 @@ const ImplicitSharingInfo *info_for_mem_free(void *data)
   return MEM_new<MEMFreeImplicitSharing>(__func__, data);
 }
 
+/**
+ * Owns a writable mapping of a temporary file. On Unix the file is unlinked right after it has
+ * been mapped, so it does not outlive the process even if it crashes. Windows does not allow
+ * deleting mapped files, so there it is deleted when the data is freed.
+ */
+class MappedFileImplicitSharing : public ImplicitSharingInfo {
+ public:
+  BLI_mmap_file *file;
+  int fd;
+  char filepath[FILE_MAX];
+
+  MappedFileImplicitSharing(BLI_mmap_file *file, const int fd, const char *filepath)
+      : file(file), fd(fd)
+  {
+    STRNCPY(this->filepath, filepath);
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    BLI_mmap_free(file);
+    close(fd);
+    if (filepath[0] != '\0') {
+      BLI_delete(filepath, false, false);
+    }
+    MEM_delete(this);
+  }
+};
+
+static bool write_all(const int fd, const void *data, const int64_t size)
+{
+  /* Write in chunks because a single call may not write everything for large sizes. */
+  constexpr int64_t chunk_size = 1 << 30;
+  const char *src = static_cast<const char *>(data);
+  int64_t written = 0;
+  while (written < size) {
+    const int64_t result = write(fd, src + written, std::min(chunk_size, size - written));
+    if (result <= 0) {
+      return false;
+    }
+    written += result;
+  }
+  return true;
+}
+
+ImplicitSharingInfoAndData copy_to_mapped_temp_file(const void *data, const int64_t size)
+{
+  if (size == 0) {
+    return {};
+  }
+  static std::atomic<int> file_counter = 0;
+
+  char tempdir[FILE_MAX];
+  BLI_temp_directory_path_get(tempdir, sizeof(tempdir));
+  char filename[64];
+  SNPRINTF(filename, "blender_mapped_%d_%d.bin", int(getpid()), file_counter++);
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), tempdir, filename);
+
+  const int fd = BLI_open(filepath, O_BINARY | O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1) {
+    return {};
+  }
+  BLI_mmap_file *file = nullptr;
+  if (write_all(fd, data, size)) {
+    file = BLI_mmap_open_writable(fd);
+  }
+  if (file == nullptr) {
+    close(fd);
+    BLI_delete(filepath, false, false);
+    return {};
+  }
+#ifndef WIN32
+  BLI_delete(filepath, false, false);
+  filepath[0] = '\0';
+#endif
+
+  const ImplicitSharingInfo *sharing_info = MEM_new<MappedFileImplicitSharing>(
+      __func__, file, fd, filepath);
+  return {sharing_info, BLI_mmap_get_pointer(file)};
+}
+
 namespace detail {
 
 void *make_trivial_data_mutable_impl(void *old_data,
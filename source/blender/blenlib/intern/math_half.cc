@@ -0,0 +1,96 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <cstring>
+
+#include "BLI_math_half.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::math {
+
+static uint32_t float_as_bits(const float v)
+{
+  uint32_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+static float bits_as_float(const uint32_t bits)
+{
+  float v;
+  memcpy(&v, &bits, sizeof(v));
+  return v;
+}
+
+uint16_t float_to_half(const float v)
+{
+  /* Based on the branch-light conversion of Fabian Giesen (public domain). */
+  const uint32_t f_inf = 255u << 23;
+  const uint32_t f16_max = (127u + 16u) << 23;
+  const uint32_t denorm_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  uint32_t bits = float_as_bits(v);
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint16_t result;
+  if (bits >= f16_max) {
+    /* Infinity or NaN, all exponent bits set. */
+    result = bits > f_inf ? 0x7e00 : 0x7c00;
+  }
+  else if (bits < (113u << 23)) {
+    /* Sub-normal or zero, let the float addition do the rounding. */
+    const uint32_t rounded = float_as_bits(bits_as_float(bits) + bits_as_float(denorm_magic));
+    result = uint16_t(rounded - denorm_magic);
+  }
+  else {
+    const uint32_t mantissa_odd = (bits >> 13) & 1u;
+    /* Adjust the exponent and round to nearest even. */
+    bits += (uint32_t(15 - 127) << 23) + 0xfffu;
+    bits += mantissa_odd;
+    result = uint16_t(bits >> 13);
+  }
+  return uint16_t(result | (sign >> 16));
+}
+
+float half_to_float(const uint16_t v)
+{
+  const uint32_t shifted_exponent = 0x7c00u << 13;
+  uint32_t bits = (uint32_t(v) & 0x7fffu) << 13;
+  const uint32_t exponent = shifted_exponent & bits;
+  bits += (127u - 15u) << 23;
+
+  if (exponent == shifted_exponent) {
+    /* Infinity or NaN. */
+    bits += (128u - 16u) << 23;
+  }
+  else if (exponent == 0) {
+    /* Sub-normal or zero, renormalize. */
+    bits += 1u << 23;
+    bits = float_as_bits(bits_as_float(bits) - bits_as_float(113u << 23));
+  }
+  bits |= (uint32_t(v) & 0x8000u) << 16;
+  return bits_as_float(bits);
+}
+
+void float_to_half_array(const float *src, uint16_t *dst, const size_t length)
+{
+  for (size_t i = 0; i < length; i++) {
+    dst[i] = float_to_half(src[i]);
+  }
+}
+
+void half_to_float_array(const uint16_t *src, float *dst, const size_t length)
+{
+  for (size_t i = 0; i < length; i++) {
+    dst[i] = half_to_float(src[i]);
+  }
+}
+
+}  // namespace blender::math
@@ -427,6 +427,46 @@ template double4x4 interpolate_fast(const double4x4 &a, const double4x4 &b, doub
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Transform
+ * \{ */
+
+void transform_points(const float4x4 &mat, const Span<float3> src, MutableSpan<float3> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  const float *src_data = reinterpret_cast<const float *>(src.data());
+  float *dst_data = reinterpret_cast<float *>(dst.data());
+
+  simd::vfloat4 columns[4][3];
+  for (int col = 0; col < 4; col++) {
+    for (int axis = 0; axis < 3; axis++) {
+      columns[col][axis] = simd::broadcast(mat[col][axis]);
+    }
+  }
+
+  int64_t i = 0;
+  for (; i + 4 <= src.size(); i += 4) {
+    simd::vfloat4 x, y, z;
+    simd::load_float3_soa(src_data + i * 3, x, y, z);
+    simd::vfloat4 result[3];
+    for (int axis = 0; axis < 3; axis++) {
+      result[axis] = columns[0][axis] * x + columns[1][axis] * y + columns[2][axis] * z +
+                     columns[3][axis];
+    }
+    simd::store_float3_soa(dst_data + i * 3, result[0], result[1], result[2]);
+  }
+  for (; i < src.size(); i++) {
+    dst[i] = transform_point(mat, src[i]);
+  }
+}
+
+void transform_points(const float4x4 &mat, MutableSpan<float3> points)
+{
+  transform_points(mat, points, points);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Legacy
  * \{ */
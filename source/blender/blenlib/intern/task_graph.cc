@@ -13,7 +13,9 @@
 #endif
 
 #include "BLI_task.h"
+#include "BLI_time.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -28,6 +30,13 @@ struct TaskGraph {
 #endif
   std::vector<std::unique_ptr<TaskNode>> nodes;
 
+  /* Set when the remaining work should be skipped, reset after waiting. */
+  std::atomic<bool> is_cancelled = false;
+
+  /* Optional callback that receives the execution time of every node. */
+  TaskGraphNodeTimingFunction timing_func = nullptr;
+  void *timing_userdata = nullptr;
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskGraph")
 #endif
@@ -49,22 +58,30 @@ struct TaskNode {
    * is shared between nodes, only a single task node should free the data. */
   TaskGraphNodeFreeFunction free_func;
 
+  TaskGraph *task_graph;
+  /* Name passed to the timing callback. */
+  const char *name = "Task";
+
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
            void *task_data,
-           TaskGraphNodeFreeFunction free_func)
+           TaskGraphNodeFreeFunction free_func,
+           const eTaskPriority priority)
       :
 #ifdef WITH_TBB
         tbb_node(task_graph->tbb_graph,
                  tbb::flow::unlimited,
-                 [&](const tbb::flow::continue_msg input) { run(input); }),
+                 [&](const tbb::flow::continue_msg input) { run(input); },
+                 priority == TASK_PRIORITY_HIGH ? tbb::flow::node_priority_t(1) :
+                                                  tbb::flow::no_priority),
 #endif
         run_func(run_func),
         task_data(task_data),
-        free_func(free_func)
+        free_func(free_func),
+        task_graph(task_graph)
   {
 #ifndef WITH_TBB
-    UNUSED_VARS(task_graph);
+    UNUSED_VARS(priority);
 #endif
   }
 
@@ -78,17 +95,34 @@ struct TaskNode {
     }
   }
 
+  /* Execute the user function, unless the graph has been cancelled. Successors are still
+   * triggered when the node is skipped, so that they are skipped as well. */
+  void run_checked()
+  {
+    if (task_graph->is_cancelled.load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (task_graph->timing_func == nullptr) {
+      run_func(task_data);
+      return;
+    }
+    const double start_time = BLI_time_now_seconds();
+    run_func(task_data);
+    const double end_time = BLI_time_now_seconds();
+    task_graph->timing_func(task_graph->timing_userdata, name, start_time, end_time);
+  }
+
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg /*input*/)
   {
-    run_func(task_data);
+    run_checked();
     return tbb::flow::continue_msg();
   }
 #endif
 
   void run_serial()
   {
-    run_func(task_data);
+    run_checked();
     for (TaskNode *successor : successors) {
       successor->run_serial();
     }
@@ -113,9 +147,26 @@ void BLI_task_graph_work_and_wait(TaskGraph *task_graph)
 {
 #ifdef WITH_TBB
   task_graph->tbb_graph.wait_for_all();
-#else
-  UNUSED_VARS(task_graph);
 #endif
+  task_graph->is_cancelled = false;
+}
+
+void BLI_task_graph_cancel(TaskGraph *task_graph)
+{
+  task_graph->is_cancelled = true;
+}
+
+bool BLI_task_graph_is_cancelled(const TaskGraph *task_graph)
+{
+  return task_graph->is_cancelled.load(std::memory_order_relaxed);
+}
+
+void BLI_task_graph_timing_callback_set(TaskGraph *task_graph,
+                                        TaskGraphNodeTimingFunction timing_func,
+                                        void *userdata)
+{
+  task_graph->timing_func = timing_func;
+  task_graph->timing_userdata = userdata;
 }
 
 TaskNode *BLI_task_graph_node_create(TaskGraph *task_graph,
@@ -123,11 +174,25 @@ TaskNode *BLI_task_graph_node_create(TaskGraph *task_graph,
                                      void *user_data,
                                      TaskGraphNodeFreeFunction free_func)
 {
-  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func);
+  return BLI_task_graph_node_create_ex(task_graph, run, user_data, free_func, TASK_PRIORITY_LOW);
+}
+
+TaskNode *BLI_task_graph_node_create_ex(TaskGraph *task_graph,
+                                        TaskGraphNodeRunFunction run,
+                                        void *user_data,
+                                        TaskGraphNodeFreeFunction free_func,
+                                        const eTaskPriority priority)
+{
+  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func, priority);
   task_graph->nodes.push_back(std::unique_ptr<TaskNode>(task_node));
   return task_node;
 }
 
+void BLI_task_graph_node_set_name(TaskNode *task_node, const char *name)
+{
+  task_node->name = name;
+}
+
 bool BLI_task_graph_node_push_work(TaskNode *task_node)
 {
 #ifdef WITH_TBB
@@ -8,7 +8,10 @@
  * Task parallel range functions.
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 #include "MEM_guardedalloc.h"
 
@@ -27,6 +30,12 @@
 #  include <tbb/enumerable_thread_specific.h>
 #  include <tbb/parallel_for.h>
 #  include <tbb/parallel_reduce.h>
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    include <tbb/info.h>
+#    include <tbb/task_arena.h>
+#    include <tbb/task_group.h>
+#    define WITH_TBB_NUMA
+#  endif
 #endif
 
 #ifdef WITH_TBB
@@ -286,6 +295,67 @@ void parallel_for_impl(const IndexRange range,
 #endif
 }
 
+#ifdef WITH_TBB_NUMA
+/**
+ * One task arena per NUMA node, whose threads are bound to that node. This is empty when there is
+ * only one node, or when the topology is unknown because TBB was built without `tbbbind`.
+ */
+static const std::vector<std::unique_ptr<tbb::task_arena>> &get_numa_arenas()
+{
+  static const std::vector<std::unique_ptr<tbb::task_arena>> arenas = []() {
+    std::vector<std::unique_ptr<tbb::task_arena>> arenas;
+    const std::vector<tbb::numa_node_id> nodes = tbb::info::numa_nodes();
+    if (nodes.size() <= 1) {
+      return arenas;
+    }
+    for (const tbb::numa_node_id node : nodes) {
+      arenas.push_back(std::make_unique<tbb::task_arena>(tbb::task_arena::constraints(node)));
+    }
+    return arenas;
+  }();
+  return arenas;
+}
+#endif /* WITH_TBB_NUMA */
+
+void parallel_for_numa_impl(const IndexRange range,
+                            const int64_t grain_size,
+                            const FunctionRef<void(IndexRange)> function)
+{
+#ifdef WITH_TBB_NUMA
+  const std::vector<std::unique_ptr<tbb::task_arena>> &arenas = get_numa_arenas();
+  const int64_t nodes_num = int64_t(arenas.size());
+  if (nodes_num <= 1 || range.size() < nodes_num * grain_size) {
+    parallel_for_impl(range, grain_size, function, TaskSizeHints_Static(1));
+    return;
+  }
+
+  /* Make sure the lazy threading hints are send now, because they shouldn't be send out of an
+   * isolated region. */
+  lazy_threading::send_hint();
+  lazy_threading::ReceiverIsolation isolation;
+
+  /* Start the work of all nodes before waiting for any of them. The split only depends on the
+   * range size, so that repeated passes over the same data use the same node for every part. */
+  Array<tbb::task_group> task_groups(nodes_num);
+  for (const int64_t node : IndexRange(nodes_num)) {
+    const IndexRange part = IndexRange::from_begin_end(
+        range.start() + range.size() * node / nodes_num,
+        range.start() + range.size() * (node + 1) / nodes_num);
+    tbb::task_group &task_group = task_groups[node];
+    arenas[node]->execute([&task_group, part, grain_size, function]() {
+      task_group.run([part, grain_size, function]() {
+        parallel_for_impl(part, grain_size, function, TaskSizeHints_Static(1));
+      });
+    });
+  }
+  for (const int64_t node : IndexRange(nodes_num)) {
+    arenas[node]->execute([&]() { task_groups[node].wait(); });
+  }
+#else
+  parallel_for_impl(range, grain_size, function, TaskSizeHints_Static(1));
+#endif
+}
+
 void memory_bandwidth_bound_task_impl(const FunctionRef<void()> function)
 {
 #ifdef WITH_TBB
@@ -294,8 +364,10 @@ void memory_bandwidth_bound_task_impl(const FunctionRef<void()> function)
    * Additional threads usually have a negligible benefit and can even make performance worse.
    *
    * It's better to use fewer threads here so that the CPU cores can do other tasks at the same
-   * time which may be more compute intensive. */
-  const int num_threads = 8;
+   * time which may be more compute intensive.
+   *
+   * Every NUMA node has its own memory controllers, so the limit applies per node. */
+  const int num_threads = 8 * numa_nodes_num();
   if (num_threads >= BLI_task_scheduler_num_threads()) {
     /* Avoid overhead of using a task arena when it would not have any effect anyway. */
     function();
@@ -315,3 +387,16 @@ void memory_bandwidth_bound_task_impl(const FunctionRef<void()> function)
 }
 
 }  // namespace blender::threading::detail
+
+namespace blender::threading {
+
+int numa_nodes_num()
+{
+#ifdef WITH_TBB_NUMA
+  return std::max<int>(1, int(detail::get_numa_arenas().size()));
+#else
+  return 1;
+#endif
+}
+
+}  // namespace blender::threading
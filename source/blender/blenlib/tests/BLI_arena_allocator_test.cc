@@ -0,0 +1,90 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_arena_allocator.hh"
+#include "BLI_array.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+TEST(arena_allocator, NoActiveScope)
+{
+  EXPECT_EQ(ArenaScope::active(), nullptr);
+  Vector<int64_t, 0, ArenaAllocator> vec;
+  for (const int64_t i : IndexRange(100)) {
+    vec.append(i);
+  }
+  EXPECT_EQ(vec.size(), 100);
+  EXPECT_EQ(vec[42], 42);
+}
+
+TEST(arena_allocator, NestedActivation)
+{
+  ArenaScope scope_a;
+  ArenaScope scope_b;
+  {
+    ArenaScope::Activation activation_a(&scope_a);
+    EXPECT_EQ(ArenaScope::active(), &scope_a);
+    {
+      ArenaScope::Activation activation_b(&scope_b);
+      EXPECT_EQ(ArenaScope::active(), &scope_b);
+      {
+        ArenaScope::Activation deactivation(nullptr);
+        EXPECT_EQ(ArenaScope::active(), nullptr);
+      }
+      EXPECT_EQ(ArenaScope::active(), &scope_b);
+    }
+    EXPECT_EQ(ArenaScope::active(), &scope_a);
+  }
+  EXPECT_EQ(ArenaScope::active(), nullptr);
+}
+
+TEST(arena_allocator, Containers)
+{
+  ArenaScope scope;
+  ArenaScope::Activation activation(&scope);
+
+  Vector<Array<int64_t, 0, ArenaAllocator>, 0, ArenaAllocator> arrays;
+  for (const int64_t i : IndexRange(1000)) {
+    arrays.append(Array<int64_t, 0, ArenaAllocator>(i % 10, i));
+  }
+  Vector<Array<int64_t, 0, ArenaAllocator>, 0, ArenaAllocator> copy = arrays;
+  arrays.clear();
+  EXPECT_EQ(copy.size(), 1000);
+  for (const int64_t i : copy.index_range()) {
+    EXPECT_EQ(copy[i].size(), i % 10);
+    for (const int64_t value : copy[i]) {
+      EXPECT_EQ(value, i);
+    }
+  }
+}
+
+TEST(arena_allocator, MultipleThreads)
+{
+  ArenaScope scope;
+  Array<int64_t> sums(100);
+  threading::parallel_for(sums.index_range(), 1, [&](const IndexRange range) {
+    ArenaScope::Activation activation(&scope);
+    for (const int64_t i : range) {
+      Vector<int64_t, 0, ArenaAllocator> vec;
+      for (const int64_t j : IndexRange(i)) {
+        vec.append(j);
+      }
+      sums[i] = 0;
+      for (const int64_t value : vec) {
+        sums[i] += value;
+      }
+    }
+  });
+  for (const int64_t i : sums.index_range()) {
+    EXPECT_EQ(sums[i], i * (i - 1) / 2);
+  }
+}
+
+}  // namespace blender::tests
@@ -285,9 +285,12 @@ static void testbuffer_run_tests(BArrayStore *bs, ListBase *lb)
   testbuffer_list_store_clear(bs, lb);
 }
 
-static void testbuffer_run_tests_simple(ListBase *lb, const int stride, const int chunk_count)
+static void testbuffer_run_tests_simple(ListBase *lb,
+                                        const int stride,
+                                        const int chunk_count,
+                                        const int flag = 0)
 {
-  BArrayStore *bs = BLI_array_store_create(stride, chunk_count);
+  BArrayStore *bs = BLI_array_store_create_ex(stride, chunk_count, flag);
   testbuffer_run_tests(bs, lb);
   BLI_array_store_destroy(bs);
 }
@@ -658,7 +661,8 @@ static void random_data_mutate_helper(const int items_size_min,
                                       const int stride,
                                       const int chunk_count,
                                       const int random_seed,
-                                      const int mutate)
+                                      const int mutate,
+                                      const int flag = 0)
 {
 
   ListBase lb;
@@ -675,7 +679,7 @@ static void random_data_mutate_helper(const int items_size_min,
     BLI_rng_free(rng);
   }
 
-  testbuffer_run_tests_simple(&lb, stride, chunk_count);
+  testbuffer_run_tests_simple(&lb, stride, chunk_count, flag);
 
   testbuffer_list_free(&lb);
 }
@@ -701,6 +705,72 @@ TEST(array_store, TestData_Stride32_Chunk64_Mutate8)
   random_data_mutate_helper(0, 256, 200, 32, 64, 7117, 8);
 }
 
+/* Same as above, using content defined chunks. */
+TEST(array_store, TestDataContentDefined_Stride1_Chunk32_Mutate2)
+{
+  random_data_mutate_helper(0, 100, 400, 1, 32, 9779, 2, BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS);
+}
+TEST(array_store, TestDataContentDefined_Stride8_Chunk512_Mutate2)
+{
+  random_data_mutate_helper(0, 128, 400, 8, 512, 1001, 2, BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS);
+}
+TEST(array_store, TestDataContentDefined_Stride12_Chunk48_Mutate2)
+{
+  random_data_mutate_helper(
+      200, 256, 400, 12, 48, 1331, 2, BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS);
+}
+TEST(array_store, TestDataContentDefined_Stride32_Chunk64_Mutate8)
+{
+  random_data_mutate_helper(0, 256, 200, 32, 64, 7117, 8, BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS);
+}
+
+/**
+ * Insert data at the start of a large array many times. With content defined chunks, the chunks
+ * after the insertion are the same as in the previous state, so only few chunks are added.
+ */
+TEST(array_store, ContentDefinedInsert)
+{
+  const int stride = 4;
+  const int chunk_count = 64;
+  const size_t data_len = 4096 * stride;
+  const size_t insert_len = 3 * stride;
+  const int states_num = 16;
+
+  BArrayStore *bs = BLI_array_store_create_ex(
+      stride, chunk_count, BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS);
+
+  RNG *rng = BLI_rng_new(4321);
+  const size_t data_len_max = data_len + insert_len * states_num;
+  char *data = (char *)MEM_mallocN(data_len_max, __func__);
+  BLI_rng_get_char_n(rng, data, data_len);
+
+  size_t len = data_len;
+  BArrayState *state_prev = nullptr;
+  BArrayState *states[states_num];
+  for (int i = 0; i < states_num; i++) {
+    memmove(&data[insert_len], data, len);
+    BLI_rng_get_char_n(rng, data, insert_len);
+    len += insert_len;
+    states[i] = BLI_array_store_state_add(bs, data, len, state_prev);
+    state_prev = states[i];
+
+    size_t state_len;
+    char *state_data = (char *)BLI_array_store_state_data_get_alloc(states[i], &state_len);
+    EXPECT_EQ(state_len, len);
+    EXPECT_EQ(memcmp(state_data, data, len), 0);
+    MEM_freeN(state_data);
+  }
+  EXPECT_TRUE(BLI_array_store_is_valid(bs));
+
+  /* Every insertion should only add a few chunks, far less than copying the whole array. */
+  const size_t compacted_len = BLI_array_store_calc_size_compacted_get(bs);
+  EXPECT_LT(compacted_len, data_len + states_num * 4 * chunk_count * stride);
+
+  MEM_freeN(data);
+  BLI_rng_free(rng);
+  BLI_array_store_destroy(bs);
+}
+
 /* -------------------------------------------------------------------- */
 /* Randomized Chunks Test */
 
@@ -132,6 +132,23 @@ TEST(bounds, MinMax)
   EXPECT_EQ(result->max, float2(3, 1));
 }
 
+TEST(bounds, MinMaxFloat3)
+{
+  /* Use a size that is not a multiple of the SIMD width. */
+  Array<float3> data(4099);
+  for (const int64_t i : data.index_range()) {
+    data[i] = float3(float(i % 17), -float(i), float(i % 5) - 2.0f);
+  }
+  data[1000] = float3(-3.0f, 5.0f, 7.0f);
+  auto result = bounds::min_max(data.as_span());
+  EXPECT_EQ(result->min, float3(-3.0f, -4098.0f, -2.0f));
+  EXPECT_EQ(result->max, float3(16.0f, 5.0f, 7.0f));
+
+  auto result_small = bounds::min_max(data.as_span().take_front(3));
+  EXPECT_EQ(result_small->min, float3(0.0f, -2.0f, -2.0f));
+  EXPECT_EQ(result_small->max, float3(2.0f, 0.0f, 0.0f));
+}
+
 TEST(bounds, MinMaxFloat)
 {
   Array<float> data = {1.0f, 3.0f, 0.0f, -1.0f};
@@ -0,0 +1,133 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_concurrent_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+TEST(concurrent_map, DefaultConstructor)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_FALSE(map.contains(3));
+}
+
+TEST(concurrent_map, AddLookup)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.add(3, 5.0f));
+  EXPECT_FALSE(map.add(3, 6.0f));
+  EXPECT_TRUE(map.add(4, 1.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_EQ(map.lookup_default(3, 0.0f), 5.0f);
+  EXPECT_EQ(map.lookup_default(4, 0.0f), 1.0f);
+  EXPECT_EQ(map.lookup_default(5, -1.0f), -1.0f);
+}
+
+TEST(concurrent_map, ParallelAdd)
+{
+  ConcurrentMap<int, int> map;
+  threading::parallel_for(IndexRange(10000), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      map.add(int(i), int(i) * 2);
+    }
+  });
+  EXPECT_EQ(map.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(map.lookup_default(i, -1), i * 2);
+  }
+}
+
+TEST(concurrent_map, ParallelAddOrModify)
+{
+  ConcurrentMap<int, int> map;
+  threading::parallel_for(IndexRange(10000), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      map.add_or_modify(
+          int(i % 10), [](int *value) { *value = 1; }, [](int *value) { (*value)++; });
+    }
+  });
+  EXPECT_EQ(map.size(), 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(map.lookup_default(i, 0), 1000);
+  }
+}
+
+TEST(concurrent_map, AddMultiple)
+{
+  ConcurrentMap<int, int> map;
+  Vector<int> keys;
+  Vector<int> values;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i % 300);
+    values.append(i);
+  }
+  map.add_multiple(keys, values);
+  EXPECT_EQ(map.size(), 300);
+  /* The first value for each key is kept. */
+  for (int i = 0; i < 300; i++) {
+    EXPECT_EQ(map.lookup_default(i, -1), i);
+  }
+}
+
+TEST(concurrent_map, ForeachItem)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i + 1);
+  }
+  int64_t key_sum = 0;
+  int64_t value_sum = 0;
+  map.foreach_item([&](const int key, const int value) {
+    key_sum += key;
+    value_sum += value;
+  });
+  EXPECT_EQ(key_sum, 4950);
+  EXPECT_EQ(value_sum, 5050);
+
+  int64_t shards_size = 0;
+  for (const int64_t i : IndexRange(map.shards_size())) {
+    shards_size += map.shard(i).size();
+  }
+  EXPECT_EQ(shards_size, 100);
+}
+
+TEST(concurrent_set, ParallelAdd)
+{
+  ConcurrentSet<int> set;
+  threading::parallel_for(IndexRange(10000), 64, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      set.add(int(i % 1234));
+    }
+  });
+  EXPECT_EQ(set.size(), 1234);
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_TRUE(set.contains(1233));
+  EXPECT_FALSE(set.contains(1234));
+}
+
+TEST(concurrent_set, AddMultiple)
+{
+  ConcurrentSet<int> set;
+  Vector<int> keys;
+  for (int i = 0; i < 1000; i++) {
+    keys.append(i % 77);
+  }
+  set.add_multiple(keys);
+  EXPECT_EQ(set.size(), 77);
+  int64_t key_sum = 0;
+  set.foreach_key([&](const int key) { key_sum += key; });
+  EXPECT_EQ(key_sum, 76 * 77 / 2);
+}
+
+}  // namespace blender::tests
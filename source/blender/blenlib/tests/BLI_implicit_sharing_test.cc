@@ -4,6 +4,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_implicit_sharing_ptr.hh"
 
 #include "testing/testing.h"
@@ -114,4 +115,39 @@ TEST(implicit_sharing, Version)
   EXPECT_LT(old_version, sharing_info->version());
 }
 
+TEST(implicit_sharing, MappedTempFile)
+{
+  Array<int> values(100000);
+  for (const int i : values.index_range()) {
+    values[i] = i * 3;
+  }
+  ImplicitSharingInfoAndData mapped = implicit_sharing::copy_to_mapped_temp_file(
+      values.data(), values.as_span().size_in_bytes());
+  if (!mapped.sharing_info) {
+    /* Creating temporary files may not be possible in the test environment. */
+    GTEST_SKIP();
+  }
+  const int *mapped_values = static_cast<const int *>(mapped.data);
+  EXPECT_EQ(Span(mapped_values, values.size()), values.as_span());
+
+  int *data = const_cast<int *>(mapped_values);
+  implicit_sharing::make_trivial_data_mutable(&data, &mapped.sharing_info, values.size());
+  EXPECT_EQ(data, mapped_values);
+  data[5] = -1;
+  EXPECT_EQ(mapped_values[5], -1);
+
+  mapped.sharing_info->add_user();
+  int *data_copy = data;
+  const ImplicitSharingInfo *copy_sharing_info = mapped.sharing_info;
+  implicit_sharing::make_trivial_data_mutable(&data_copy, &copy_sharing_info, values.size());
+  EXPECT_NE(data_copy, data);
+  EXPECT_EQ(data_copy[5], -1);
+  EXPECT_EQ(data_copy[6], 18);
+
+  implicit_sharing::free_shared_data(&data_copy, &copy_sharing_info);
+  implicit_sharing::free_shared_data(&data, &mapped.sharing_info);
+
+  EXPECT_TRUE(implicit_sharing::copy_to_mapped_temp_file(nullptr, 0).sharing_info == nullptr);
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,71 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <limits>
+
+#include "BLI_math_half.hh"
+
+namespace blender::math::tests {
+
+TEST(math_half, FloatToHalf)
+{
+  EXPECT_EQ(float_to_half(0.0f), 0x0000);
+  EXPECT_EQ(float_to_half(-0.0f), 0x8000);
+  EXPECT_EQ(float_to_half(1.0f), 0x3c00);
+  EXPECT_EQ(float_to_half(-2.0f), 0xc000);
+  EXPECT_EQ(float_to_half(0.5f), 0x3800);
+  EXPECT_EQ(float_to_half(65504.0f), 0x7bff);
+  /* Too large values become infinity. */
+  EXPECT_EQ(float_to_half(65536.0f), 0x7c00);
+  EXPECT_EQ(float_to_half(-1e10f), 0xfc00);
+  EXPECT_EQ(float_to_half(std::numeric_limits<float>::infinity()), 0x7c00);
+  EXPECT_EQ(float_to_half(std::numeric_limits<float>::quiet_NaN()) & 0x7e00, 0x7e00);
+  /* Smallest sub-normal, and values that are too small become zero. */
+  EXPECT_EQ(float_to_half(5.9604645e-8f), 0x0001);
+  EXPECT_EQ(float_to_half(1e-9f), 0x0000);
+  /* Round to nearest even, 1 + 2^-11 is halfway between 1 and the next half float. */
+  EXPECT_EQ(float_to_half(1.0f + 1.0f / 2048.0f), 0x3c00);
+  EXPECT_EQ(float_to_half(1.0f + 3.0f / 2048.0f), 0x3c02);
+}
+
+TEST(math_half, HalfToFloat)
+{
+  EXPECT_EQ(half_to_float(0x0000), 0.0f);
+  EXPECT_TRUE(std::signbit(half_to_float(0x8000)));
+  EXPECT_EQ(half_to_float(0x3c00), 1.0f);
+  EXPECT_EQ(half_to_float(0xc000), -2.0f);
+  EXPECT_EQ(half_to_float(0x7bff), 65504.0f);
+  EXPECT_EQ(half_to_float(0x0001), 5.9604645e-8f);
+  EXPECT_EQ(half_to_float(0x7c00), std::numeric_limits<float>::infinity());
+  EXPECT_TRUE(std::isnan(half_to_float(0x7e00)));
+}
+
+TEST(math_half, RoundTrip)
+{
+  /* Every half float except NaN converts to a float and back without change. */
+  for (uint32_t i = 0; i <= 0xffff; i++) {
+    const uint16_t h = uint16_t(i);
+    if ((h & 0x7c00) == 0x7c00 && (h & 0x03ff) != 0) {
+      continue;
+    }
+    EXPECT_EQ(float_to_half(half_to_float(h)), h);
+  }
+}
+
+TEST(math_half, Array)
+{
+  const float src[4] = {0.25f, -1.5f, 3.0f, 1000.0f};
+  uint16_t half[4];
+  float dst[4];
+  float_to_half_array(src, half, 4);
+  half_to_float_array(half, dst, 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(src[i], dst[i]);
+  }
+}
+
+}  // namespace blender::math::tests
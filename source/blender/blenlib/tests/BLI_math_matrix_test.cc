@@ -4,6 +4,7 @@
 
 #include "testing/testing.h"
 
+#include "BLI_array.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
@@ -569,6 +570,27 @@ TEST(math_matrix, MatrixTransform)
   EXPECT_V2_NEAR(result2, expect2, 1e-5);
 }
 
+TEST(math_matrix, TransformPoints)
+{
+  const float4x4 mat = from_loc_rot_scale<float4x4>(
+      float3(1.0f, -2.0f, 3.0f), EulerXYZ(0.5f, 1.0f, 1.5f), float3(2.0f, 0.5f, 1.0f));
+  /* Use a size that is not a multiple of the SIMD width. */
+  Array<float3> src(7);
+  for (const int64_t i : src.index_range()) {
+    src[i] = float3(float(i), float(i) * 0.5f - 1.0f, 3.0f - float(i));
+  }
+  Array<float3> dst(src.size());
+  transform_points(mat, src, dst);
+  for (const int64_t i : src.index_range()) {
+    EXPECT_V3_NEAR(dst[i], transform_point(mat, src[i]), 1e-5f);
+  }
+
+  transform_points(mat, src);
+  for (const int64_t i : src.index_range()) {
+    EXPECT_V3_NEAR(src[i], dst[i], 1e-5f);
+  }
+}
+
 TEST(math_matrix, MatrixProjection)
 {
   using namespace math::projection;
@@ -0,0 +1,50 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_mempool.h"
+#include "BLI_set.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+TEST(mempool, AllocN)
+{
+  BLI_mempool *pool = BLI_mempool_create(sizeof(int64_t), 0, 32, BLI_MEMPOOL_ALLOW_ITER);
+
+  void *first = BLI_mempool_alloc(pool);
+  Array<void *> elems(1000);
+  BLI_mempool_alloc_n(pool, elems.data(), uint(elems.size()));
+  EXPECT_EQ(BLI_mempool_len(pool), 1001);
+
+  Set<void *> unique_elems;
+  unique_elems.add_new(first);
+  for (void *elem : elems) {
+    EXPECT_TRUE(unique_elems.add(elem));
+    *static_cast<int64_t *>(elem) = 42;
+  }
+
+  int iter_num = 0;
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(pool, &iter);
+  while (BLI_mempool_iterstep(&iter)) {
+    iter_num++;
+  }
+  EXPECT_EQ(iter_num, 1001);
+
+  /* Freed elements are reused first. */
+  BLI_mempool_free(pool, elems[10]);
+  BLI_mempool_free(pool, elems[20]);
+  Array<void *> reused(2);
+  BLI_mempool_alloc_n(pool, reused.data(), uint(reused.size()));
+  EXPECT_EQ(Set<void *>({reused[0], reused[1]}), Set<void *>({elems[10], elems[20]}));
+  EXPECT_EQ(BLI_mempool_len(pool), 1001);
+
+  BLI_mempool_destroy(pool);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,50 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+
+namespace blender::noise::tests {
+
+static Array<float3> test_positions()
+{
+  Array<float3> positions(1000);
+  for (const int i : positions.index_range()) {
+    /* Include negative and integer coordinates, and values past the wrapping threshold. */
+    positions[i] = float3(std::sin(i * 0.37f) * 50.0f,
+                          (i % 7 == 0) ? 2000000.5f : float(i % 13) - 6.0f,
+                          i * 0.013f - 3.0f);
+  }
+  positions[0] = float3(-0.0f, 0.0f, -1.0f);
+  return positions;
+}
+
+TEST(noise, PerlinBatchMatchesSingle)
+{
+  const Array<float3> positions = test_positions();
+  for (const int type : IndexRange(5)) {
+    for (const float distortion : {0.0f, 0.7f}) {
+      for (const float detail : {0.0f, 2.0f, 3.5f}) {
+        Array<float> values(positions.size());
+        perlin_fractal_distorted(
+            positions, detail, 0.5f, 2.0f, 0.3f, 1.1f, distortion, type, true, values);
+        Array<float3> colors(positions.size());
+        perlin_float3_fractal_distorted(
+            positions, detail, 0.5f, 2.0f, 0.3f, 1.1f, distortion, type, false, colors);
+        for (const int i : positions.index_range()) {
+          EXPECT_EQ(values[i],
+                    perlin_fractal_distorted(
+                        positions[i], detail, 0.5f, 2.0f, 0.3f, 1.1f, distortion, type, true));
+          EXPECT_EQ(colors[i],
+                    perlin_float3_fractal_distorted(
+                        positions[i], detail, 0.5f, 2.0f, 0.3f, 1.1f, distortion, type, false));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace blender::noise::tests
@@ -0,0 +1,86 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+
+#include "BLI_strict_flags.h" /* Keep last. */
+
+namespace blender::tests {
+
+TEST(sort, RadixSortInt)
+{
+  RandomNumberGenerator rng(42);
+  Array<int> values(100000);
+  for (int &value : values) {
+    value = rng.get_int32() - (1 << 30);
+  }
+  values[10] = std::numeric_limits<int>::min();
+  values[20] = std::numeric_limits<int>::max();
+
+  Array<int> expected = values;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort(values.as_mutable_span());
+  EXPECT_EQ(values.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortSmallRange)
+{
+  /* Only the lowest byte differs, the other passes are skipped. */
+  Array<uint64_t> values(50000);
+  for (const int64_t i : values.index_range()) {
+    values[i] = uint64_t((i * 37) % 201);
+  }
+  Array<uint64_t> expected = values;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort(values.as_mutable_span());
+  EXPECT_EQ(values.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortFloat)
+{
+  Array<float> values = {3.0f, -1.5f, 0.0f, -0.0f, 1e-20f, -1e20f, 2.0f, -1e-20f};
+  parallel_radix_sort(values.as_mutable_span());
+  const Array<float> expected = {-1e20f, -1.5f, -1e-20f, 0.0f, 0.0f, 1e-20f, 2.0f, 3.0f};
+  EXPECT_EQ(values.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortByKeyStable)
+{
+  Array<float> keys(30000);
+  Array<int> values(keys.size());
+  for (const int64_t i : keys.index_range()) {
+    keys[i] = float(i % 7) - 3.0f;
+    values[i] = int(i);
+  }
+  parallel_radix_sort_by_key(keys.as_mutable_span(), values.as_mutable_span());
+  for (const int64_t i : keys.index_range().drop_front(1)) {
+    EXPECT_LE(keys[i - 1], keys[i]);
+    if (keys[i - 1] == keys[i]) {
+      EXPECT_LT(values[i - 1], values[i]);
+    }
+    EXPECT_EQ(keys[i], float(values[i] % 7) - 3.0f);
+  }
+}
+
+TEST(sort, StableSort)
+{
+  RandomNumberGenerator rng(3);
+  Array<std::pair<int, int>> values(100000);
+  for (const int64_t i : values.index_range()) {
+    values[i] = {rng.get_int32(100), int(i)};
+  }
+  const auto compare_first = [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+    return a.first < b.first;
+  };
+  Array<std::pair<int, int>> expected = values;
+  std::stable_sort(expected.begin(), expected.end(), compare_first);
+  parallel_stable_sort(values.begin(), values.end(), compare_first);
+  EXPECT_EQ(values.as_span(), expected.as_span());
+}
+
+}  // namespace blender::tests
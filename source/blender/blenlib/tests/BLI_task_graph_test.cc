@@ -7,6 +7,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_utildefines.h"
 
 struct TaskData {
   int value;
@@ -190,3 +191,86 @@ TEST(task, GraphTaskData)
   EXPECT_EQ(1, data.value);
   EXPECT_EQ(0, data.store);
 }
+
+struct CancelTaskData {
+  TaskGraph *graph;
+  int value;
+};
+
+static void CancelTaskData_increase_and_cancel(void *taskdata)
+{
+  CancelTaskData *data = (CancelTaskData *)taskdata;
+  data->value += 1;
+  BLI_task_graph_cancel(data->graph);
+}
+
+static void CancelTaskData_increase(void *taskdata)
+{
+  CancelTaskData *data = (CancelTaskData *)taskdata;
+  data->value += 1;
+}
+
+TEST(task, GraphCancel)
+{
+  TaskGraph *graph = BLI_task_graph_create();
+  CancelTaskData data = {graph, 0};
+  TaskNode *node_a = BLI_task_graph_node_create(
+      graph, CancelTaskData_increase_and_cancel, &data, nullptr);
+  TaskNode *node_b = BLI_task_graph_node_create(graph, CancelTaskData_increase, &data, nullptr);
+  TaskNode *node_c = BLI_task_graph_node_create(graph, CancelTaskData_increase, &data, nullptr);
+  BLI_task_graph_edge_create(node_a, node_b);
+  BLI_task_graph_edge_create(node_b, node_c);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  BLI_task_graph_work_and_wait(graph);
+  /* Only the first node is executed. */
+  EXPECT_EQ(1, data.value);
+
+  /* The cancellation is reset after waiting, so the graph can be reused. */
+  EXPECT_FALSE(BLI_task_graph_is_cancelled(graph));
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_b));
+  BLI_task_graph_work_and_wait(graph);
+  EXPECT_EQ(3, data.value);
+  BLI_task_graph_free(graph);
+}
+
+struct TimingData {
+  int calls;
+  bool names_match;
+  bool times_valid;
+};
+
+static void TimingData_record(void *userdata,
+                              const char *node_name,
+                              const double start_time,
+                              const double end_time)
+{
+  TimingData *data = (TimingData *)userdata;
+  data->calls += 1;
+  data->names_match &= STREQ(node_name, "Node A") || STREQ(node_name, "Task");
+  data->times_valid &= start_time <= end_time;
+}
+
+TEST(task, GraphPriorityAndTiming)
+{
+  TaskData data = {0};
+  TimingData timing = {0, true, true};
+  TaskGraph *graph = BLI_task_graph_create();
+  BLI_task_graph_timing_callback_set(graph, TimingData_record, &timing);
+
+  /* 0 => 1 */
+  TaskNode *node_a = BLI_task_graph_node_create_ex(
+      graph, TaskData_increase_value, &data, nullptr, TASK_PRIORITY_HIGH);
+  BLI_task_graph_node_set_name(node_a, "Node A");
+  /* 1 => 2 */
+  TaskNode *node_b = BLI_task_graph_node_create(
+      graph, TaskData_multiply_by_two_value, &data, nullptr);
+  BLI_task_graph_edge_create(node_a, node_b);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  BLI_task_graph_work_and_wait(graph);
+
+  EXPECT_EQ(2, data.value);
+  EXPECT_EQ(2, timing.calls);
+  EXPECT_TRUE(timing.names_match);
+  EXPECT_TRUE(timing.times_valid);
+  BLI_task_graph_free(graph);
+}
@@ -12,6 +12,7 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
@@ -245,3 +246,27 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, ParallelForNuma)
+{
+  const int64_t size = 100000;
+  std::atomic<int64_t> sum = 0;
+  std::atomic<int> calls = 0;
+  blender::Array<int> visits(size, 0);
+  blender::threading::parallel_for_numa(
+      blender::IndexRange(size), 1000, [&](const blender::IndexRange range) {
+        int64_t local_sum = 0;
+        for (const int64_t i : range) {
+          visits[i]++;
+          local_sum += i;
+        }
+        sum += local_sum;
+        calls++;
+      });
+  EXPECT_EQ(sum, size * (size - 1) / 2);
+  EXPECT_GE(calls, 1);
+  for (const int64_t i : visits.index_range()) {
+    EXPECT_EQ(visits[i], 1);
+  }
+  EXPECT_GE(blender::threading::numa_nodes_num(), 1);
+}
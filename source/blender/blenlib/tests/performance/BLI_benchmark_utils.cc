@@ -0,0 +1,142 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include "testing/testing.h"
+
+#include "BLI_benchmark_utils.hh"
+#include "BLI_timeit.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+/** Stop sampling once this much time is spent in a single benchmark. */
+static constexpr timeit::Nanoseconds MAX_TOTAL_TIME = std::chrono::milliseconds(500);
+static constexpr int MIN_SAMPLES = 3;
+static constexpr int MAX_SAMPLES = 1000;
+
+struct BenchmarkResult {
+  std::string category;
+  std::string name;
+  int samples;
+  double time_min;
+  double time_median;
+};
+
+static Vector<BenchmarkResult> &benchmark_results()
+{
+  static Vector<BenchmarkResult> results;
+  return results;
+}
+
+void run_benchmark(const StringRef category, const StringRef name, const FunctionRef<void()> fn)
+{
+  /* Warm up caches and lazily initialized data. */
+  fn();
+
+  Vector<double> samples;
+  timeit::Nanoseconds total_time(0);
+  while (samples.size() < MIN_SAMPLES ||
+         (samples.size() < MAX_SAMPLES && total_time < MAX_TOTAL_TIME))
+  {
+    const timeit::TimePoint start = timeit::Clock::now();
+    fn();
+    const timeit::Nanoseconds duration = timeit::Clock::now() - start;
+    total_time += duration;
+    samples.append(std::chrono::duration<double>(duration).count());
+  }
+
+  std::sort(samples.begin(), samples.end());
+  BenchmarkResult result;
+  result.category = category;
+  result.name = name;
+  result.samples = int(samples.size());
+  result.time_min = samples.first();
+  result.time_median = samples[samples.size() / 2];
+
+  printf("%s / %s: min %.4f ms, median %.4f ms (%d samples)\n",
+         result.category.c_str(),
+         result.name.c_str(),
+         result.time_min * 1000.0,
+         result.time_median * 1000.0,
+         result.samples);
+
+  benchmark_results().append(std::move(result));
+}
+
+static std::string json_escape(const StringRef str)
+{
+  std::string escaped;
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+/**
+ * Writes all recorded results once every test has run. The entries use the fields of
+ * `TestEntry` in `tests/performance/api/config.py`.
+ */
+class BenchmarkJSONWriter : public ::testing::Environment {
+ public:
+  void TearDown() override
+  {
+    const char *filepath = getenv("BLENDER_BENCHMARK_JSON");
+    if (filepath == nullptr || benchmark_results().is_empty()) {
+      return;
+    }
+    const char *revision = getenv("BLENDER_BENCHMARK_REVISION");
+    if (revision == nullptr) {
+      revision = "current";
+    }
+
+    FILE *file = fopen(filepath, "w");
+    if (file == nullptr) {
+      fprintf(stderr, "Unable to write benchmark results to \"%s\"\n", filepath);
+      return;
+    }
+    const long long date = (long long)time(nullptr);
+
+    fprintf(file, "[\n");
+    for (const int i : benchmark_results().index_range()) {
+      const BenchmarkResult &result = benchmark_results()[i];
+      fprintf(file,
+              "  {\n"
+              "    \"test\": \"%s\",\n"
+              "    \"category\": \"%s\",\n"
+              "    \"revision\": \"%s\",\n"
+              "    \"date\": %lld,\n"
+              "    \"device_type\": \"CPU\",\n"
+              "    \"device_id\": \"CPU\",\n"
+              "    \"device_name\": \"CPU\",\n"
+              "    \"status\": \"done\",\n"
+              "    \"output\": {\"time\": %.9f, \"time_min\": %.9f},\n"
+              "    \"benchmark_type\": \"comparison\"\n"
+              "  }%s\n",
+              json_escape(result.name).c_str(),
+              json_escape(result.category).c_str(),
+              json_escape(revision).c_str(),
+              date,
+              result.time_median,
+              result.time_min,
+              (i + 1 < benchmark_results().size()) ? "," : "");
+    }
+    fprintf(file, "]\n");
+    fclose(file);
+  }
+};
+
+static ::testing::Environment *const benchmark_json_writer =
+    ::testing::AddGlobalTestEnvironment(new BenchmarkJSONWriter());
+
+}  // namespace blender::tests
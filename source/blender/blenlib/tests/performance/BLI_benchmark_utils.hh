@@ -0,0 +1,29 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Minimal micro-benchmark helpers for the performance test executables.
+ *
+ * Each benchmark runs a callback repeatedly and records the fastest and the median run time.
+ * Results are printed, and when the `BLENDER_BENCHMARK_JSON` environment variable is set, also
+ * written to that file as a list of entries in the format of `tests/performance` result files.
+ * Such files can be charted with `tests/performance/benchmark.py graph`.
+ */
+
+#include "BLI_function_ref.hh"
+#include "BLI_string_ref.hh"
+
+namespace blender::tests {
+
+/**
+ * Run \a fn until enough samples for a stable measurement are collected and record the timings
+ * under \a category and \a name.
+ */
+void run_benchmark(StringRef category, StringRef name, FunctionRef<void()> fn);
+
+}  // namespace blender::tests
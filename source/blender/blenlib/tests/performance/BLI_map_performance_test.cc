@@ -9,12 +9,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_concurrent_map.hh"
 #include "BLI_fileops.h"
 #include "BLI_ghash.h"
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_rand.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 
@@ -756,3 +758,37 @@ TEST(ghash, MultiRandIntMurmur2a200000)
 
   multi_small_ghash_tests(ghash, "MultiSmall RandIntGHash - Murmur2a - 200000", 200000);
 }
+
+/* Concurrent map: parallel insertion into a #ConcurrentMap compared to a single threaded #Map. */
+
+static void concurrent_map_tests(const char *id, const int count)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  {
+    Map<int, int> map;
+    SCOPED_TIMER("serial_map_insert");
+    for (int i = 0; i < count; i++) {
+      map.add(i, i);
+    }
+    EXPECT_EQ(map.size(), count);
+  }
+
+  {
+    ConcurrentMap<int, int> map;
+    SCOPED_TIMER("concurrent_map_insert");
+    threading::parallel_for(IndexRange(count), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        map.add(int(i), int(i));
+      }
+    });
+    EXPECT_EQ(map.size(), count);
+  }
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(ghash, ConcurrentMap2000000)
+{
+  concurrent_map_tests("ConcurrentMap - 2000000", 2000000);
+}
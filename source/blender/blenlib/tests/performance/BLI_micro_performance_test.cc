@@ -0,0 +1,225 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cfloat>
+#include <cstdio>
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_index_mask.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_noise.hh"
+#include "BLI_path_util.h"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_tempfile.h"
+#include "BLI_vector.hh"
+
+#include "BLI_benchmark_utils.hh"
+
+namespace blender::tests {
+
+/* Keep results alive so that the compiler cannot optimize the benchmarked code away. */
+static volatile int64_t benchmark_sink = 0;
+
+static Array<int> random_ints(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<int> values(size);
+  for (int &value : values) {
+    value = rng.get_int32();
+  }
+  return values;
+}
+
+static Array<float3> random_positions(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 100.0f;
+  }
+  return positions;
+}
+
+TEST(micro_performance, Containers)
+{
+  const Array<int> values = random_ints(1'000'000, 0);
+
+  run_benchmark("Containers", "Vector append 1M", [&]() {
+    Vector<int> vector;
+    for (const int value : values) {
+      vector.append(value);
+    }
+    benchmark_sink = vector.size();
+  });
+
+  run_benchmark("Containers", "Set add 1M", [&]() {
+    Set<int> set;
+    for (const int value : values) {
+      set.add(value);
+    }
+    benchmark_sink = set.size();
+  });
+
+  Map<int, int> map;
+  for (const int i : values.index_range()) {
+    map.add(values[i], i);
+  }
+  run_benchmark("Containers", "Map add 1M", [&]() {
+    Map<int, int> new_map;
+    for (const int i : values.index_range()) {
+      new_map.add(values[i], i);
+    }
+    benchmark_sink = new_map.size();
+  });
+  run_benchmark("Containers", "Map lookup 1M", [&]() {
+    int64_t sum = 0;
+    for (const int value : values) {
+      sum += map.lookup_default(value, 0);
+    }
+    benchmark_sink = sum;
+  });
+}
+
+TEST(micro_performance, IndexMask)
+{
+  const int64_t size = 10'000'000;
+  const Array<int> values = random_ints(size, 1);
+  IndexMaskMemory memory;
+  const IndexMask every_other = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(4096), memory, [&](const int64_t i) { return i % 2 == 0; });
+  const IndexMask random = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(4096), memory, [&](const int64_t i) { return values[i] % 2; });
+
+  run_benchmark("IndexMask", "from_predicate random 10M", [&]() {
+    IndexMaskMemory local_memory;
+    const IndexMask mask = IndexMask::from_predicate(
+        IndexRange(size), GrainSize(4096), local_memory, [&](const int64_t i) {
+          return values[i] % 2;
+        });
+    benchmark_sink = mask.size();
+  });
+  run_benchmark("IndexMask", "foreach_index range 10M", [&]() {
+    int64_t sum = 0;
+    IndexMask(size).foreach_index([&](const int64_t i) { sum += values[i]; });
+    benchmark_sink = sum;
+  });
+  run_benchmark("IndexMask", "foreach_index every other 10M", [&]() {
+    int64_t sum = 0;
+    every_other.foreach_index([&](const int64_t i) { sum += values[i]; });
+    benchmark_sink = sum;
+  });
+  run_benchmark("IndexMask", "foreach_index random 10M", [&]() {
+    int64_t sum = 0;
+    random.foreach_index([&](const int64_t i) { sum += values[i]; });
+    benchmark_sink = sum;
+  });
+}
+
+TEST(micro_performance, ParallelFor)
+{
+  Array<float> values(1'000'000, 1.0f);
+
+  /* Measures the scheduling overhead, the work per element is negligible. */
+  for (const int64_t grain_size : {64, 1024, 16384}) {
+    run_benchmark("parallel_for",
+                  "grain size " + std::to_string(grain_size) + " 1M",
+                  [&]() {
+                    threading::parallel_for(
+                        values.index_range(), grain_size, [&](const IndexRange range) {
+                          for (const int64_t i : range) {
+                            values[i] *= 1.0001f;
+                          }
+                        });
+                  });
+  }
+
+  run_benchmark("parallel_for", "empty tasks 10k", [&]() {
+    threading::parallel_for(IndexRange(10'000), 1, [&](const IndexRange /*range*/) {});
+  });
+}
+
+TEST(micro_performance, BVHTree)
+{
+  const Array<float3> positions = random_positions(1'000'000, 2);
+  const Array<float3> queries = random_positions(100'000, 3);
+
+  auto build_tree = [&]() {
+    BVHTree *tree = BLI_bvhtree_new(int(positions.size()), 0.0f, 2, 6);
+    for (const int i : positions.index_range()) {
+      BLI_bvhtree_insert(tree, i, positions[i], 1);
+    }
+    BLI_bvhtree_balance(tree);
+    return tree;
+  };
+
+  run_benchmark("BVHTree", "build 1M points", [&]() { BLI_bvhtree_free(build_tree()); });
+
+  BVHTree *tree = build_tree();
+  run_benchmark("BVHTree", "find nearest 100k", [&]() {
+    threading::parallel_for(queries.index_range(), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        BVHTreeNearest nearest;
+        nearest.index = -1;
+        nearest.dist_sq = FLT_MAX;
+        BLI_bvhtree_find_nearest(tree, queries[i], &nearest, nullptr, nullptr);
+      }
+    });
+  });
+  BLI_bvhtree_free(tree);
+}
+
+TEST(micro_performance, Noise)
+{
+  const Array<float3> positions = random_positions(100'000, 5);
+  Array<float> values(positions.size());
+
+  run_benchmark("Noise", "perlin fBM single 100k", [&]() {
+    for (const int64_t i : positions.index_range()) {
+      values[i] = noise::perlin_fractal_distorted(
+          positions[i], 4.0f, 0.5f, 2.0f, 0.0f, 0.0f, 0.0f, 1, true);
+    }
+  });
+  run_benchmark("Noise", "perlin fBM batched 100k", [&]() {
+    noise::perlin_fractal_distorted(
+        positions, 4.0f, 0.5f, 2.0f, 0.0f, 0.0f, 0.0f, 1, true, values);
+  });
+}
+
+TEST(micro_performance, FileReadWrite)
+{
+  char tempdir[FILE_MAX];
+  BLI_temp_directory_path_get(tempdir, sizeof(tempdir));
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), tempdir, "blender_micro_performance.bin");
+
+  const Array<int> values = random_ints(16 * 1024 * 1024, 4);
+  const size_t data_size = values.as_span().size_in_bytes();
+
+  run_benchmark("File", "write 64 MB", [&]() {
+    FILE *file = BLI_fopen(filepath, "wb");
+    ASSERT_NE(file, nullptr);
+    fwrite(values.data(), 1, data_size, file);
+    fclose(file);
+  });
+  run_benchmark("File", "read 64 MB", [&]() {
+    size_t size = 0;
+    void *data = BLI_file_read_binary_as_mem(filepath, 0, &size);
+    EXPECT_EQ(size, data_size);
+    MEM_freeN(data);
+  });
+
+  BLI_delete(filepath, false, false);
+}
+
+}  // namespace blender::tests
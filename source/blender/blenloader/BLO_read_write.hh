@@ -259,6 +259,20 @@ void *BLO_read_struct_array_with_size(BlendDataReader *reader,
   *((void **)ptr_p) = BLO_read_struct_array_with_size( \
       reader, *((void **)ptr_p), sizeof(struct_name) * (array_size))
 
+/**
+ * Update all \a array_size pointers of \a array to the new address of the struct they point to,
+ * like calling #BLO_read_struct on each of them but with a single map access per element.
+ * Typically used after #BLO_read_pointer_array.
+ */
+void BLO_read_struct_pointers_with_size(BlendDataReader *reader,
+                                        int array_size,
+                                        void **array,
+                                        size_t expected_size);
+
+#define BLO_read_struct_pointers(reader, struct_name, array_size, array) \
+  BLO_read_struct_pointers_with_size( \
+      reader, array_size, reinterpret_cast<void **>(array), sizeof(struct_name))
+
 /* Read all elements in list
  *
  * Updates all `->prev` and `->next` pointers of the list elements.
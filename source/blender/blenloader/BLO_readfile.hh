@@ -95,6 +95,16 @@ struct BlendFileReadParams {
   int undo_direction; /* #eUndoStepDir */
 };
 
+/** Per ID type statistics of a file read, see #BlendFileReadReport::id_type_stats. */
+struct BlendFileReadIDTypeStats {
+  /** Time spent reading the ID blocks (and their data) of this type, in seconds. */
+  double duration;
+  /** Size of all file blocks read for IDs of this type, in bytes. */
+  uint64_t size;
+  /** Number of IDs of this type read. */
+  int count;
+};
+
 struct BlendFileReadReport {
   /** General reports handling. */
   ReportList *reports;
@@ -102,6 +112,16 @@ struct BlendFileReadReport {
   /** Timing information. */
   struct {
     double whole;
+    /** Reading the local data-blocks and their data from the file. */
+    double read_data;
+    /** Versioning done before linking (`do_versions`). */
+    double versioning;
+    /** Remapping of ID pointers after all data has been read. */
+    double lib_link;
+    /** Versioning done after linking (`do_versions_after_linking`). */
+    double versioning_after_linking;
+    /** Post-processing done after reading, by the caller (e.g. depsgraph creation). */
+    double post_read;
     double libraries;
     double lib_overrides;
     double lib_overrides_resync;
@@ -138,6 +158,13 @@ struct BlendFileReadReport {
   int resynced_lib_overrides_libraries_count;
   bool do_resynced_lib_overrides_libraries_list;
   LinkNode *resynced_lib_overrides_libraries;
+
+  /**
+   * Optional array of #INDEX_ID_MAX items (indexed by #BKE_idtype_idcode_to_index), owned by the
+   * caller. Statistics are only gathered when it is set, since they are mainly useful for
+   * profiling.
+   */
+  BlendFileReadIDTypeStats *id_type_stats;
 };
 
 /** Skip reading some data-block types (may want to skip screen data too). */
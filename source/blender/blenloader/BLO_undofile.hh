@@ -34,6 +34,13 @@ struct MemFileChunk {
   const char *buf;
   /** Size in bytes. */
   size_t size;
+  /** Size of #buf in bytes when it is compressed with #BLO_memfile_compress, otherwise zero. */
+  size_t compressed_size;
+  /**
+   * 128 bit hash of the chunk content, compared against the hash of the chunk in the previous
+   * undo step to detect identical chunks, instead of comparing their memory.
+   */
+  uint64_t hash[2];
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
@@ -53,6 +60,8 @@ struct MemFile {
    * without making a copy. This is faster and requires less memory.
    */
   MemFileSharedStorage *shared_storage;
+  /** True when all chunks that can be compressed have been compressed. */
+  bool is_compressed;
 };
 
 struct MemFileWriteData {
@@ -108,6 +117,18 @@ void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Compress the chunk buffers owned by \a memfile that are not shared with \a next_memfile (the
+ * #MemFile of the next undo step, may be null). Shared buffers are read by the next step, and the
+ * newest version of data is always shared, so this mostly compresses data that has been changed
+ * since. The #MemFile must be decompressed before it can be read or used as reference for writing
+ * a new #MemFile.
+ */
+void BLO_memfile_compress(MemFile *memfile, const MemFile *next_memfile);
+/**
+ * Decompress the chunks compressed by #BLO_memfile_compress.
+ */
+void BLO_memfile_decompress(MemFile *memfile);
 
 /* Utilities. */
 
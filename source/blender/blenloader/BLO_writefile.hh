@@ -9,6 +9,8 @@
  * \brief external `writefile.cc` function prototypes.
  */
 
+struct BlendFileWriteDiffState;
+struct BlendFileWriteSnapshot;
 struct BlendThumbnail;
 struct Main;
 struct MemFile;
@@ -43,6 +45,12 @@ struct BlendFileWriteParams {
   uint use_save_as_copy : 1;
   uint use_userdef : 1;
   const BlendThumbnail *thumb;
+  /**
+   * When set, the file is updated in-place, only re-writing the parts of it that changed since
+   * the previous write done with the same state (see #BLO_write_diff_state_new).
+   * Ignored when compressing or saving versions.
+   */
+  BlendFileWriteDiffState *diff_state;
 };
 
 /**
@@ -59,4 +67,31 @@ extern bool BLO_write_file(Main *mainvar,
  */
 extern bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int write_flags);
 
+/**
+ * Write the file into memory, so it can be written to disk later with
+ * #BLO_write_file_snapshot_write, e.g. from a background thread while #Main is being edited.
+ *
+ * \note This holds a full copy of the file in memory until freed.
+ * \return The snapshot or null on failure.
+ */
+extern BlendFileWriteSnapshot *BLO_write_file_snapshot(Main *mainvar,
+                                                       const char *filepath,
+                                                       int write_flags,
+                                                       const BlendFileWriteParams *params,
+                                                       ReportList *reports);
+/**
+ * Write the snapshot to the file it was created for. Doesn't access #Main.
+ * \return Success.
+ */
+extern bool BLO_write_file_snapshot_write(const BlendFileWriteSnapshot *snapshot,
+                                          ReportList *reports);
+extern void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot);
+
+/**
+ * State kept between differential writes of the same file, used for auto-save where
+ * most of the file is unchanged between two writes.
+ */
+extern BlendFileWriteDiffState *BLO_write_diff_state_new();
+extern void BLO_write_diff_state_free(BlendFileWriteDiffState *diff_state);
+
 /** \} */
@@ -47,6 +47,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
@@ -55,8 +56,10 @@
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -171,6 +174,12 @@
 /** Use #GHash for #BHead name-based lookups (speeds up linking). */
 #define USE_GHASH_BHEAD
 
+/**
+ * Read and reconstruct the data blocks of an ID on multiple threads, when the file content can
+ * be accessed in-place (see #blo_bhead_data_in_place). Depends on #USE_BHEAD_READ_ON_DEMAND.
+ */
+#define USE_PARALLEL_READ_STRUCT
+
 /** Use #GHash for restoring pointers by name. */
 #define USE_GHASH_RESTORE_POINTER
 
@@ -285,6 +294,39 @@ static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, bool inc
   return entry->newp;
 }
 
+/**
+ * Look up the new address of all \a num pointers in \a addrs, storing them in \a r_newaddrs
+ * (which may be the same array).
+ */
+static void oldnewmap_lookup_array_and_inc(OldNewMap *onm,
+                                           const void *const *addrs,
+                                           void **r_newaddrs,
+                                           const int64_t num,
+                                           const bool increase_users)
+{
+  blender::Map<const void *, NewAddress> &map = onm->map;
+  for (int64_t i = 0; i < num; i++) {
+    NewAddress *entry = map.lookup_ptr(addrs[i]);
+    if (entry == nullptr) {
+      r_newaddrs[i] = nullptr;
+      continue;
+    }
+    if (increase_users) {
+      entry->nr++;
+    }
+    r_newaddrs[i] = entry->newp;
+  }
+}
+
+/**
+ * Make room for \a num more insertions, growing the map while inserting is much slower than
+ * allocating it with the right size.
+ */
+static void oldnewmap_reserve(OldNewMap *onm, const int64_t num)
+{
+  onm->map.reserve(onm->map.size() + num);
+}
+
 /* for libdata, NewAddress.nr has ID code, no increment */
 static void *oldnewmap_liblookup(OldNewMap *onm, const void *addr, const bool is_linked_only)
 {
@@ -310,7 +352,14 @@ static void oldnewmap_clear(OldNewMap *onm)
       MEM_freeN(new_addr.newp);
     }
   }
-  onm->map.clear_and_shrink();
+  /* The data map is cleared after reading each ID, keep its memory for the next one, unless it
+   * is much larger than needed (clearing is linear in the capacity). */
+  if (onm->map.capacity() > 4 * std::max<int64_t>(onm->map.size(), 1024)) {
+    onm->map.clear_and_shrink();
+  }
+  else {
+    onm->map.clear();
+  }
 }
 
 static void oldnewmap_free(OldNewMap *onm)
@@ -906,6 +955,30 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   return success;
 }
 
+/**
+ * Access the data of a block that was not read yet directly in the memory backing the file,
+ * without reading it into a temporary allocation first.
+ * Returns null when the file can't be accessed in-place (e.g. compressed files).
+ *
+ * \note #blo_bhead_data_in_place_failed must be checked once the data has been accessed.
+ */
+static const void *blo_bhead_data_in_place(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->file_memory == nullptr ||
+      size_t(new_bhead->file_offset) + size_t(thisblock->len) > fd->file_memory_len)
+  {
+    return nullptr;
+  }
+  return fd->file_memory + new_bhead->file_offset;
+}
+
+static bool blo_bhead_data_in_place_failed(FileData *fd)
+{
+  return BLI_filereader_memory_has_io_error(fd->file);
+}
+
 static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 {
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
@@ -1237,6 +1310,8 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
 
   FileData *fd = filedata_new(reports);
   fd->file = file;
+  fd->file_memory = static_cast<const char *>(
+      BLI_filereader_memory_data_get(file, &fd->file_memory_len));
 
   return fd;
 }
@@ -1312,6 +1387,8 @@ FileData *blo_filedata_from_memory(const void *mem, int memsize, BlendFileReadRe
 
   FileData *fd = filedata_new(reports);
   fd->file = file;
+  fd->file_memory = static_cast<const char *>(
+      BLI_filereader_memory_data_get(file, &fd->file_memory_len));
 
   return blo_decode_and_check(fd, reports->reports);
 }
@@ -1725,6 +1802,17 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
+          /* Reconstruct directly from the memory-mapped file when possible,
+           * only the reconstructed struct needs to be allocated then. */
+          if (const void *data = blo_bhead_data_in_place(fd, bh)) {
+            temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
+            if (UNLIKELY(blo_bhead_data_in_place_failed(fd))) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              MEM_freeN(temp);
+              return nullptr;
+            }
+            return temp;
+          }
           bh = blo_bhead_read_full(fd, bh);
           if (UNLIKELY(bh == nullptr)) {
             fd->flags &= ~FD_FLAGS_FILE_OK;
@@ -1769,6 +1857,31 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 
 /* Like read_struct, but gets a pointer without allocating. Only works for
  * undo since DNA must match. */
+#ifdef USE_PARALLEL_READ_STRUCT
+/**
+ * Thread-safe variant of #read_struct, for data that can be accessed in-place and doesn't need
+ * endian switching. IO errors are checked for afterwards, see #blo_bhead_data_in_place_failed.
+ */
+static void *read_struct_in_place(FileData *fd, BHead *bh, const char *blockname)
+{
+  BLI_assert((fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0);
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return nullptr;
+  }
+  const void *data = BHEADN_FROM_BHEAD(bh)->has_data ? bh + 1 : blo_bhead_data_in_place(fd, bh);
+  if (UNLIKELY(data == nullptr)) {
+    return nullptr;
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
+  }
+  const int alignment = DNA_struct_alignment(fd->filesdna, bh->SDNAnr);
+  void *temp = MEM_mallocN_aligned(bh->len, alignment, blockname);
+  memcpy(temp, data, bh->len);
+  return temp;
+}
+#endif
+
 static const void *peek_struct_undo(FileData *fd, BHead *bhead)
 {
   BLI_assert(fd->flags & FD_FLAGS_IS_MEMFILE);
@@ -2389,6 +2502,47 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_PARALLEL_READ_STRUCT
+/**
+ * Same as #read_data_into_datamap, but reads and reconstructs the data blocks in parallel.
+ * Only the headers are read sequentially, the datamap is filled in file order afterwards.
+ */
+static BHead *read_data_into_datamap_parallel(FileData *fd, BHead *bhead, const char *allocname)
+{
+  using namespace blender;
+
+  Vector<BHead *> data_bheads;
+  int64_t data_size = 0;
+  for (; bhead && bhead->code == BLO_CODE_DATA; bhead = blo_bhead_next(fd, bhead)) {
+    data_bheads.append(bhead);
+    data_size += bhead->len;
+  }
+
+  Array<void *> data(data_bheads.size());
+  /* Avoid threading overhead for the many IDs that only have a little data. */
+  const int64_t grain_size = std::max<int64_t>(
+      1, data_bheads.size() * (int64_t(1) << 16) / std::max<int64_t>(1, data_size));
+  threading::parallel_for(data_bheads.index_range(), grain_size, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      data[i] = read_struct_in_place(fd, data_bheads[i], allocname);
+    }
+  });
+
+  if (UNLIKELY(blo_bhead_data_in_place_failed(fd))) {
+    fd->flags &= ~FD_FLAGS_FILE_OK;
+  }
+
+  oldnewmap_reserve(fd->datamap, data_bheads.size());
+  for (const int64_t i : data_bheads.index_range()) {
+    if (data[i]) {
+      oldnewmap_insert(fd->datamap, data_bheads[i]->old, data[i], 0);
+    }
+  }
+
+  return bhead;
+}
+#endif
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
@@ -2415,6 +2569,12 @@ static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *all
     }
 #endif
 
+#ifdef USE_PARALLEL_READ_STRUCT
+    if (fd->file_memory != nullptr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0) {
+      return read_data_into_datamap_parallel(fd, bhead, allocname);
+    }
+#endif
+
     void *data = read_struct(fd, bhead, allocname);
     if (data) {
       oldnewmap_insert(fd->datamap, bhead->old, data, 0);
@@ -2800,12 +2960,12 @@ static bool read_libblock_undo_restore(
  * When reading for undo, libraries, linked datablocks and unchanged datablocks
  * will be restored from the old database. Only new or changed datablocks will
  * actually be read. */
-static BHead *read_libblock(FileData *fd,
-                            Main *main,
-                            BHead *bhead,
-                            int id_tag,
-                            const bool placeholder_set_indirect_extern,
-                            ID **r_id)
+static BHead *read_libblock_ex(FileData *fd,
+                               Main *main,
+                               BHead *bhead,
+                               int id_tag,
+                               const bool placeholder_set_indirect_extern,
+                               ID **r_id)
 {
   const bool do_partial_undo = (fd->skip_flags & BLO_READ_SKIP_UNDO_OLD_MAIN) == 0;
 
@@ -2921,6 +3081,33 @@ static BHead *read_libblock(FileData *fd,
   return bhead;
 }
 
+/* Same as #read_libblock_ex, also gathering per ID type statistics when requested. */
+static BHead *read_libblock(FileData *fd,
+                            Main *main,
+                            BHead *bhead,
+                            int id_tag,
+                            const bool placeholder_set_indirect_extern,
+                            ID **r_id)
+{
+  BlendFileReadIDTypeStats *id_type_stats = fd->reports ? fd->reports->id_type_stats : nullptr;
+  if (id_type_stats == nullptr || !BKE_idtype_idcode_is_valid(bhead->code)) {
+    return read_libblock_ex(fd, main, bhead, id_tag, placeholder_set_indirect_extern, r_id);
+  }
+
+  BlendFileReadIDTypeStats &stats = id_type_stats[BKE_idtype_idcode_to_index(bhead->code)];
+  const double time_start = BLI_time_now_seconds();
+  BHead *bhead_next = read_libblock_ex(
+      fd, main, bhead, id_tag, placeholder_set_indirect_extern, r_id);
+  stats.duration += BLI_time_now_seconds() - time_start;
+  stats.count++;
+
+  for (BHead *bh = bhead; bh && bh != bhead_next; bh = blo_bhead_next(fd, bh)) {
+    stats.size += uint64_t(bh->len);
+  }
+
+  return bhead_next;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -3509,6 +3696,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+  fd->reports->duration.read_data = BLI_time_now_seconds();
   while (bhead) {
     switch (bhead->code) {
       case BLO_CODE_DATA:
@@ -3563,6 +3751,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       return bfd;
     }
   }
+  fd->reports->duration.read_data = BLI_time_now_seconds() - fd->reports->duration.read_data;
 
   if (is_undo) {
     /* Move the remaining Library IDs and their linked data to the new main.
@@ -3589,6 +3778,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   /* Do versioning before read_libraries, but skip in undo case. */
   if (!is_undo) {
+    fd->reports->duration.versioning = BLI_time_now_seconds();
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
       do_versions(fd, nullptr, bfd->main);
     }
@@ -3596,6 +3786,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     if ((fd->skip_flags & BLO_READ_SKIP_USERDEF) == 0) {
       do_versions_userdef(fd, bfd);
     }
+    fd->reports->duration.versioning = BLI_time_now_seconds() -
+                                       fd->reports->duration.versioning;
   }
 
   if (bfd->main->is_read_invalid) {
@@ -3608,8 +3800,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
     blo_join_main(&mainlist);
 
+    fd->reports->duration.lib_link = BLI_time_now_seconds();
     lib_link_all(fd, bfd->main);
     after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    fd->reports->duration.lib_link = BLI_time_now_seconds() - fd->reports->duration.lib_link;
 
     if (is_undo) {
       /* Ensure ID usages of reused 'no undo' IDs remain valid. */
@@ -3636,6 +3830,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
       blo_split_main(&mainlist, bfd->main);
+      fd->reports->duration.versioning_after_linking = BLI_time_now_seconds();
       LISTBASE_FOREACH (Main *, mainvar, &mainlist) {
         BLI_assert(mainvar->versionfile != 0);
         do_versions_after_linking((mainvar->curlib && mainvar->curlib->runtime.filedata) ?
@@ -3643,6 +3838,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
                                       fd,
                                   mainvar);
       }
+      fd->reports->duration.versioning_after_linking =
+          BLI_time_now_seconds() - fd->reports->duration.versioning_after_linking;
       blo_join_main(&mainlist);
 
       BKE_layer_collection_resync_forbid();
@@ -4755,6 +4952,20 @@ void *BLO_read_struct_array_with_size(BlendDataReader *reader,
   return blo_verify_data_address(new_address, old_address, expected_size);
 }
 
+void BLO_read_struct_pointers_with_size(BlendDataReader *reader,
+                                        const int array_size,
+                                        void **array,
+                                        const size_t expected_size)
+{
+  if (array == nullptr || array_size <= 0) {
+    return;
+  }
+  oldnewmap_lookup_array_and_inc(reader->fd->datamap, array, array, array_size, true);
+  for (int i = 0; i < array_size; i++) {
+    array[i] = blo_verify_data_address(array[i], nullptr, expected_size);
+  }
+}
+
 ID *BLO_read_get_new_id_address(BlendLibReader *reader,
                                 ID *self_id,
                                 const bool is_linked_only,
@@ -58,6 +58,12 @@ struct FileData {
   bool is_eof;
 
   FileReader *file;
+  /**
+   * Memory backing #file when it can be accessed in-place (e.g. memory-mapped files),
+   * see #BLI_filereader_memory_data_get. Allows reading delayed data without copying it first.
+   */
+  const char *file_memory;
+  size_t file_memory_len;
 
   /** Whether we are undoing (< 0) or redoing (> 0), used to choose which 'unchanged' flag to use
    * to detect unchanged data from memfile. */
@@ -6,6 +6,7 @@
  * \ingroup blenloader
  */
 
+#include <atomic>
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -26,6 +27,9 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -34,6 +38,9 @@
 #include "BKE_main.hh"
 #include "BKE_undo_system.hh"
 
+#include <xxhash.h>
+#include <zstd.h>
+
 #include "BLI_strict_flags.h" /* Keep last. */
 
 /* **************** support for memory-write, for undo buffers *************** */
@@ -59,6 +66,99 @@ MemFileSharedStorage::~MemFileSharedStorage()
   }
 }
 
+/* Compressing small chunks isn't worth the overhead. */
+#define MEM_CHUNK_COMPRESS_MIN_SIZE 1024
+/* Favor speed, compression is done when pushing undo steps. */
+#define MEM_CHUNK_COMPRESSION_LEVEL 1
+
+void BLO_memfile_compress(MemFile *memfile, const MemFile *next_memfile)
+{
+  using namespace blender;
+  if (memfile->is_compressed) {
+    return;
+  }
+  memfile->is_compressed = true;
+
+  Set<const char *> shared_buffers;
+  if (next_memfile) {
+    LISTBASE_FOREACH (const MemFileChunk *, chunk, &next_memfile->chunks) {
+      if (chunk->is_identical) {
+        shared_buffers.add(chunk->buf);
+      }
+    }
+  }
+
+  Vector<MemFileChunk *> chunks;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (!chunk->is_identical && chunk->compressed_size == 0 &&
+        chunk->size >= MEM_CHUNK_COMPRESS_MIN_SIZE && !shared_buffers.contains(chunk->buf))
+    {
+      chunks.append(chunk);
+    }
+  }
+
+  std::atomic<size_t> saved_size = 0;
+  threading::parallel_for(chunks.index_range(), 16, [&](const IndexRange range) {
+    Vector<char> compress_buffer;
+    size_t saved_size_range = 0;
+    for (const int64_t i : range) {
+      MemFileChunk *chunk = chunks[i];
+      compress_buffer.resize(int64_t(ZSTD_compressBound(chunk->size)));
+      const size_t compressed_size = ZSTD_compress(compress_buffer.data(),
+                                                   size_t(compress_buffer.size()),
+                                                   chunk->buf,
+                                                   chunk->size,
+                                                   MEM_CHUNK_COMPRESSION_LEVEL);
+      if (ZSTD_isError(compressed_size) || compressed_size >= chunk->size) {
+        continue;
+      }
+      char *buf_new = static_cast<char *>(MEM_mallocN(compressed_size, "Compressed chunk buffer"));
+      memcpy(buf_new, compress_buffer.data(), compressed_size);
+      MEM_freeN((void *)chunk->buf);
+      chunk->buf = buf_new;
+      chunk->compressed_size = compressed_size;
+      saved_size_range += chunk->size - compressed_size;
+    }
+    saved_size += saved_size_range;
+  });
+  memfile->size -= saved_size;
+}
+
+void BLO_memfile_decompress(MemFile *memfile)
+{
+  using namespace blender;
+  if (!memfile->is_compressed) {
+    return;
+  }
+  memfile->is_compressed = false;
+
+  Vector<MemFileChunk *> chunks;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->compressed_size != 0) {
+      chunks.append(chunk);
+    }
+  }
+
+  std::atomic<size_t> restored_size = 0;
+  threading::parallel_for(chunks.index_range(), 16, [&](const IndexRange range) {
+    size_t restored_size_range = 0;
+    for (const int64_t i : range) {
+      MemFileChunk *chunk = chunks[i];
+      char *buf_new = static_cast<char *>(MEM_mallocN(chunk->size, "Chunk buffer"));
+      const size_t size = ZSTD_decompress(
+          buf_new, chunk->size, chunk->buf, chunk->compressed_size);
+      BLI_assert(size == chunk->size);
+      UNUSED_VARS_NDEBUG(size);
+      MEM_freeN((void *)chunk->buf);
+      chunk->buf = buf_new;
+      restored_size_range += chunk->size - chunk->compressed_size;
+      chunk->compressed_size = 0;
+    }
+    restored_size += restored_size_range;
+  });
+  memfile->size += restored_size;
+}
+
 void BLO_memfile_merge(MemFile *first, MemFile *second)
 {
   /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
@@ -80,6 +180,8 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
         BLI_assert(sc->is_identical);
         sc->is_identical = false;
         fc->is_identical = true;
+        /* The buffer may be compressed now that it's only used by the second memfile. */
+        second->is_compressed = false;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
        * fully owns it without sharing it with any other memfile, and hence it should be freed with
@@ -136,6 +238,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   MemFileChunk *curchunk = static_cast<MemFileChunk *>(
       MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk"));
   curchunk->size = size;
+  curchunk->compressed_size = 0;
   curchunk->buf = nullptr;
   curchunk->is_identical = false;
   /* This is unsafe in the sense that an app handler or other code that does not
@@ -145,11 +248,19 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->id_session_uid = mem_data->current_id_session_uid;
   BLI_addtail(&memfile->chunks, curchunk);
 
+  /* Hashing only reads the new data once, comparing memory would also read the previous step,
+   * which is typically not in cache anymore. The hash is kept for comparison with the next step.
+   * A 128 bit hash makes collisions between differing chunks practically impossible. */
+  const XXH128_hash_t hash = XXH3_128bits(buf, size);
+  curchunk->hash[0] = hash.low64;
+  curchunk->hash[1] = hash.high64;
+
   /* we compare compchunk with buf */
   if (*compchunk_step != nullptr) {
     MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
-      if (memcmp(compchunk->buf, buf, size) == 0) {
+    /* Compressed buffers can't be shared, see #BLO_memfile_compress. */
+    if (compchunk->size == curchunk->size && compchunk->compressed_size == 0) {
+      if (compchunk->hash[0] == curchunk->hash[0] && compchunk->hash[1] == curchunk->hash[1]) {
         curchunk->buf = compchunk->buf;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
@@ -231,6 +342,7 @@ static int64_t undo_read(FileReader *reader, void *buffer, size_t size)
         printf("illegal read, chunk zero\n");
         return 0;
       }
+      BLI_assert_msg(chunk->compressed_size == 0, "Memfile must be decompressed before reading");
 
       chunkoffset = seek - offset;
       readsize = size - totread;
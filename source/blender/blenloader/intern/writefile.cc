@@ -96,7 +96,9 @@
 #include "BLI_linklist.h"
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -127,6 +129,7 @@
 
 #include "readfile.hh"
 
+#include <xxhash.h>
 #include <zstd.h>
 
 /* Make preferences read-only. */
@@ -143,11 +146,28 @@
 
 #define ZSTD_COMPRESSION_LEVEL 3
 
+/**
+ * Granularity of differential writes, each block of the file that has the same hash as
+ * in the previous write is skipped.
+ */
+#define DIFF_BLOCK_SIZE (1 << 16) /* 64kb */
+/**
+ * Re-write the whole file every N differential writes, in case it was modified on disk
+ * without its size or modification time changing.
+ */
+#define DIFF_FULL_WRITE_INTERVAL 16
+
 static CLG_LogRef LOG = {"blo.writefile"};
 
 /** Use if we want to store how many bytes have been written to the file. */
 // #define USE_WRITE_DATA_LEN
 
+/**
+ * Serialize IDs of types flagged with #IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE in parallel,
+ * each into its own stream which is then written in order.
+ */
+#define USE_PARALLEL_ID_WRITE
+
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
@@ -167,6 +187,11 @@ class WriteWrap {
 
   /** Buffer output (we only want when output isn't already buffered). */
   bool use_buf = true;
+  /**
+   * Write to the destination file directly,
+   * instead of a temporary file which is renamed on success.
+   */
+  bool use_in_place = false;
 };
 
 class RawWriteWrap : public WriteWrap {
@@ -390,12 +415,215 @@ bool ZstdWriteWrap::write(const void *buf, size_t buf_len)
   return true;
 }
 
+struct BlendFileWriteDiffState {
+  /** The file written last time, differential writes are only done when writing it again. */
+  char filepath[FILE_MAX] = "";
+  /** Size and modification time of the file after the last write, to detect external edits. */
+  int64_t file_size = 0;
+  int64_t file_mtime = 0;
+  /** Hash of each #DIFF_BLOCK_SIZE block of the file, empty when the file isn't known. */
+  blender::Vector<uint64_t> block_hashes;
+  /** Number of differential writes since the whole file was last written. */
+  int diff_write_count = 0;
+};
+
+/**
+ * Write wrapper updating an existing file in-place, skipping all blocks that are unchanged
+ * since the previous write. This avoids most of the IO when writing large files repeatedly,
+ * e.g. for auto-save.
+ *
+ * Only blocks at the same offset are compared, changes causing the data after them to move
+ * (e.g. an ID growing) still re-write everything that follows.
+ *
+ * The first block is written last, while writing, the file header is invalid so an
+ * interrupted write never leaves a file that looks valid but contains mixed data.
+ */
+class DiffWriteWrap : public WriteWrap {
+  BlendFileWriteDiffState &state;
+
+  int file_handle = -1;
+  char filepath[FILE_MAX] = "";
+  /** When false the whole file is written (still computing block hashes for the next write). */
+  bool use_diff = false;
+
+  blender::Vector<uint64_t> block_hashes;
+  uchar *block_buf = nullptr;
+  size_t block_used_len = 0;
+  /** The first block is only written on close. */
+  uchar *header_block = nullptr;
+  size_t header_block_len = 0;
+
+  size_t file_len = 0;
+  size_t skipped_len = 0;
+  bool write_error = false;
+
+ public:
+  DiffWriteWrap(BlendFileWriteDiffState &state) : state(state)
+  {
+    use_in_place = true;
+  }
+
+  bool open(const char *filepath) override;
+  bool close() override;
+  bool write(const void *buf, size_t buf_len) override;
+
+ private:
+  bool write_at(size_t offset, const void *buf, size_t buf_len);
+  void write_block();
+};
+
+bool DiffWriteWrap::open(const char *filepath)
+{
+  STRNCPY(this->filepath, filepath);
+
+  BLI_stat_t st;
+  use_diff = (STREQ(state.filepath, filepath) && !state.block_hashes.is_empty() &&
+              state.diff_write_count < DIFF_FULL_WRITE_INTERVAL &&
+              (BLI_stat(filepath, &st) == 0) && (int64_t(st.st_size) == state.file_size) &&
+              (int64_t(st.st_mtime) == state.file_mtime));
+
+  file_handle = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + (use_diff ? 0 : O_TRUNC), 0666);
+  if (file_handle == -1) {
+    return false;
+  }
+
+  /* Invalidate the header until the file is complete again. */
+  if (use_diff) {
+    const char zero = 0;
+    if (!write_at(0, &zero, 1)) {
+      ::close(file_handle);
+      file_handle = -1;
+      return false;
+    }
+  }
+
+  block_buf = static_cast<uchar *>(MEM_mallocN(DIFF_BLOCK_SIZE, __func__));
+  header_block = static_cast<uchar *>(MEM_mallocN(DIFF_BLOCK_SIZE, __func__));
+  block_hashes.reserve(state.block_hashes.size());
+
+  return true;
+}
+
+bool DiffWriteWrap::write_at(const size_t offset, const void *buf, const size_t buf_len)
+{
+  if (BLI_lseek(file_handle, int64_t(offset), SEEK_SET) != int64_t(offset)) {
+    return false;
+  }
+  return ::write(file_handle, buf, buf_len) == buf_len;
+}
+
+void DiffWriteWrap::write_block()
+{
+  if (block_used_len == 0) {
+    return;
+  }
+
+  const int64_t block_index = block_hashes.size();
+  const uint64_t hash = XXH3_64bits(block_buf, block_used_len);
+  block_hashes.append(hash);
+
+  if (block_index == 0) {
+    memcpy(header_block, block_buf, block_used_len);
+    header_block_len = block_used_len;
+  }
+  else if (use_diff && block_index < state.block_hashes.size() &&
+           state.block_hashes[block_index] == hash)
+  {
+    skipped_len += block_used_len;
+  }
+  else if (!write_at(file_len, block_buf, block_used_len)) {
+    write_error = true;
+  }
+
+  file_len += block_used_len;
+  block_used_len = 0;
+}
+
+bool DiffWriteWrap::write(const void *buf, size_t buf_len)
+{
+  if (write_error) {
+    return false;
+  }
+
+  const uchar *data = static_cast<const uchar *>(buf);
+  while (buf_len > 0) {
+    const size_t len = std::min(buf_len, size_t(DIFF_BLOCK_SIZE) - block_used_len);
+    memcpy(block_buf + block_used_len, data, len);
+    block_used_len += len;
+    data += len;
+    buf_len -= len;
+
+    if (block_used_len == DIFF_BLOCK_SIZE) {
+      write_block();
+    }
+  }
+
+  return !write_error;
+}
+
+bool DiffWriteWrap::close()
+{
+  write_block();
+
+  if (!write_error) {
+    /* The file may have been larger the previous time. */
+#ifdef WIN32
+    write_error = _chsize_s(file_handle, int64_t(file_len)) != 0;
+#else
+    write_error = ftruncate(file_handle, int64_t(file_len)) != 0;
+#endif
+  }
+  if (!write_error) {
+    write_error = !write_at(0, header_block, header_block_len);
+  }
+
+  write_error |= (::close(file_handle) == -1);
+  file_handle = -1;
+
+  MEM_SAFE_FREE(block_buf);
+  MEM_SAFE_FREE(header_block);
+
+  BLI_stat_t st;
+  if (!write_error && BLI_stat(filepath, &st) == 0) {
+    STRNCPY(state.filepath, filepath);
+    state.file_size = int64_t(st.st_size);
+    state.file_mtime = int64_t(st.st_mtime);
+    state.block_hashes = std::move(block_hashes);
+    state.diff_write_count = use_diff ? state.diff_write_count + 1 : 0;
+
+    CLOG_INFO(&LOG,
+              2,
+              "Differential write of \"%s\": %zu of %zu bytes unchanged",
+              filepath,
+              skipped_len,
+              file_len);
+  }
+  else {
+    /* Don't trust the content of the file for the next write. */
+    state.filepath[0] = '\0';
+    state.block_hashes.clear();
+  }
+
+  return !write_error;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
 /** \name Write Data Type & Functions
  * \{ */
 
+#ifdef USE_PARALLEL_ID_WRITE
+/**
+ * Data of a single ID serialized by a worker thread. The size of every #mywrite call is kept,
+ * so writing it again afterwards results in exactly the same chunks as writing it directly.
+ */
+struct IDWriteStream {
+  blender::Vector<uchar> data;
+  blender::Vector<size_t> write_sizes;
+};
+#endif
+
 struct WriteData {
   const SDNA *sdna;
 
@@ -430,6 +658,13 @@ struct WriteData {
    * Will be nullptr for UNDO.
    */
   WriteWrap *ww;
+
+#ifdef USE_PARALLEL_ID_WRITE
+  /** When set, all data is stored here instead of being written. */
+  IDWriteStream *id_stream;
+  /** Locked when accessing #MemFile.shared_storage, only set when writing IDs in parallel. */
+  ThreadMutex *shared_storage_mutex;
+#endif
 };
 
 struct BlendWriter {
@@ -527,6 +762,14 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
     return;
   }
 
+#ifdef USE_PARALLEL_ID_WRITE
+  if (wd->id_stream) {
+    wd->id_stream->data.extend(blender::Span(static_cast<const uchar *>(adr), int64_t(len)));
+    wd->id_stream->write_sizes.append(len);
+    return;
+  }
+#endif
+
 #ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
 #endif
@@ -1218,6 +1461,57 @@ static int write_id_direct_linked_data_process_cb(LibraryIDLinkCallbackData *cb_
  * \param compare: Previous memory file (can be nullptr).
  * \param current: The current memory file (can be nullptr).
  */
+#ifdef USE_PARALLEL_ID_WRITE
+/**
+ * Serialize \a ids in parallel, then write them in order.
+ */
+static void write_ids_parallel(WriteData *wd, const IDTypeInfo *id_type, blender::Span<ID *> ids)
+{
+  using namespace blender;
+
+  if (ids.is_empty()) {
+    return;
+  }
+
+  Array<IDWriteStream> streams(ids.size());
+  ThreadMutex shared_storage_mutex;
+  BLI_mutex_init(&shared_storage_mutex);
+
+  threading::parallel_for(ids.index_range(), 1, [&](const IndexRange range) {
+    BLO_Write_IDBuffer *id_buffer = BLO_write_allocate_id_buffer();
+    id_buffer_init_for_id_type(id_buffer, id_type);
+
+    WriteData *thread_wd = MEM_new<WriteData>(__func__);
+    thread_wd->sdna = wd->sdna;
+    thread_wd->use_memfile = wd->use_memfile;
+    thread_wd->mem.written_memfile = wd->mem.written_memfile;
+    thread_wd->shared_storage_mutex = &shared_storage_mutex;
+    BlendWriter writer = {thread_wd};
+
+    for (const int64_t i : range) {
+      thread_wd->id_stream = &streams[i];
+      id_buffer_init_from_id(id_buffer, ids[i], wd->use_memfile);
+      id_type->blend_write(&writer, static_cast<ID *>(id_buffer->temp_id), ids[i]);
+    }
+
+    MEM_delete(thread_wd);
+    BLO_write_destroy_id_buffer(&id_buffer);
+  });
+
+  BLI_mutex_end(&shared_storage_mutex);
+
+  for (const int64_t i : ids.index_range()) {
+    mywrite_id_begin(wd, ids[i]);
+    const uchar *data = streams[i].data.data();
+    for (const size_t size : streams[i].write_sizes) {
+      mywrite(wd, data, size);
+      data += size;
+    }
+    mywrite_id_end(wd, ids[i]);
+  }
+}
+#endif
+
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
                               MemFile *compare,
@@ -1319,6 +1613,14 @@ static bool write_file_handle(Main *mainvar,
       const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
       id_buffer_init_for_id_type(id_buffer, id_type);
 
+#ifdef USE_PARALLEL_ID_WRITE
+      const bool use_parallel_write = (id_type->flags & IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE) &&
+                                      (id_type->blend_write != nullptr);
+      /* Limit the memory used to store the serialized IDs before writing them. */
+      const int parallel_write_batch_size = max_ii(2, 2 * BLI_system_thread_count());
+      blender::Vector<ID *> parallel_write_ids;
+#endif
+
       for (; id; id = static_cast<ID *>(id->next)) {
         /* We should never attempt to write non-regular IDs
          * (i.e. all kind of temp/runtime ones). */
@@ -1378,6 +1680,20 @@ static bool write_file_handle(Main *mainvar,
                                       IDWALK_READONLY | IDWALK_INCLUDE_UI);
         }
 
+#ifdef USE_PARALLEL_ID_WRITE
+        if (use_parallel_write && !do_override) {
+          parallel_write_ids.append(id);
+          if (parallel_write_ids.size() >= parallel_write_batch_size) {
+            write_ids_parallel(wd, id_type, parallel_write_ids);
+            parallel_write_ids.clear();
+          }
+          continue;
+        }
+        /* Keep the order of IDs in the file. */
+        write_ids_parallel(wd, id_type, parallel_write_ids);
+        parallel_write_ids.clear();
+#endif
+
         if (do_override) {
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
@@ -1397,6 +1713,10 @@ static bool write_file_handle(Main *mainvar,
         mywrite_id_end(wd, id);
       }
 
+#ifdef USE_PARALLEL_ID_WRITE
+      write_ids_parallel(wd, id_type, parallel_write_ids);
+#endif
+
       mywrite_flush(wd);
     }
   } while ((bmain != override_storage) && (bmain = override_storage));
@@ -1516,6 +1836,46 @@ static void write_file_main_validate_post(Main *bmain, ReportList *reports)
   }
 }
 
+/**
+ * Move the temporary file written by \a ww in place, or remove it on error.
+ * \return True on success.
+ */
+static bool write_file_finalize(const char *filepath,
+                                const char *tempname,
+                                const bool err,
+                                const bool use_save_versions,
+                                ReportList *reports,
+                                const WriteWrap &ww)
+{
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    if (!ww.use_in_place) {
+      remove(tempname);
+    }
+    return false;
+  }
+
+  if (ww.use_in_place) {
+    return true;
+  }
+
+  /* File save to temporary file was successful, now do reverse file history
+   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
+  if (use_save_versions) {
+    if (!do_history(filepath, reports)) {
+      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
+      return false;
+    }
+  }
+
+  if (BLI_rename_overwrite(tempname, filepath) != 0) {
+    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
+    return false;
+  }
+
+  return true;
+}
+
 static bool BLO_write_file_impl(Main *mainvar,
                                 const char *filepath,
                                 const int write_flags,
@@ -1551,7 +1911,12 @@ static bool BLO_write_file_impl(Main *mainvar,
   write_file_main_validate_pre(mainvar, reports);
 
   /* Open temporary file, so we preserve the original in case we crash. */
-  SNPRINTF(tempname, "%s@", filepath);
+  if (ww.use_in_place) {
+    STRNCPY(tempname, filepath);
+  }
+  else {
+    SNPRINTF(tempname, "%s@", filepath);
+  }
 
   if (ww.open(tempname) == false) {
     BKE_reportf(
@@ -1643,40 +2008,151 @@ static bool BLO_write_file_impl(Main *mainvar,
   }
 
   /* Actual file writing. */
-  const bool err = write_file_handle(
-      mainvar, &ww, nullptr, nullptr, write_flags, use_userdef, thumb);
+  bool err = write_file_handle(mainvar, &ww, nullptr, nullptr, write_flags, use_userdef, thumb);
 
-  ww.close();
+  if (!ww.close()) {
+    err = true;
+  }
 
   if (UNLIKELY(path_list_backup)) {
     BKE_bpath_list_restore(mainvar, path_list_flag, path_list_backup);
     BKE_bpath_list_free(path_list_backup);
   }
 
-  if (err) {
-    BKE_report(reports, RPT_ERROR, strerror(errno));
-    remove(tempname);
+  if (!write_file_finalize(filepath, tempname, err, use_save_versions, reports, ww)) {
+    return false;
+  }
+
+  write_file_main_validate_post(mainvar, reports);
+
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name File Writing Snapshot
+ *
+ * Write the file to memory first, so writing it to disk doesn't need #Main anymore.
+ * \{ */
+
+struct BlendFileWriteSnapshot {
+  char filepath[FILE_MAX];
+  bool use_save_versions;
+  bool use_compress;
+  BlendFileWriteDiffState *diff_state;
+  /** The whole file, chunks are never shared with an undo step. */
+  MemFile memfile;
+};
+
+/**
+ * Write wrapper storing all data into a #MemFile.
+ * Opening doesn't create any file, #BLO_write_file_snapshot_write does that.
+ */
+class MemFileWriteWrap : public WriteWrap {
+  MemFileWriteData mem_data = {};
+
+ public:
+  MemFileWriteWrap(MemFile &memfile)
+  {
+    use_in_place = true;
+    BLO_memfile_write_init(&mem_data, &memfile, nullptr);
+    mem_data.current_id_session_uid = MAIN_ID_SESSION_UID_UNSET;
+  }
 
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    BLO_memfile_write_finalize(&mem_data);
+    return true;
+  }
+  bool write(const void *buf, size_t buf_len) override
+  {
+    BLO_memfile_chunk_add(&mem_data, static_cast<const char *>(buf), buf_len);
+    return true;
+  }
+};
+
+BlendFileWriteSnapshot *BLO_write_file_snapshot(Main *mainvar,
+                                                const char *filepath,
+                                                const int write_flags,
+                                                const BlendFileWriteParams *params,
+                                                ReportList *reports)
+{
+  BlendFileWriteSnapshot *snapshot = MEM_new<BlendFileWriteSnapshot>(__func__);
+  STRNCPY(snapshot->filepath, filepath);
+  snapshot->use_save_versions = params->use_save_versions;
+  snapshot->use_compress = (write_flags & G_FILE_COMPRESS) != 0;
+  snapshot->diff_state = params->diff_state;
+
+  MemFileWriteWrap mem_wrap(snapshot->memfile);
+  if (!BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, mem_wrap)) {
+    BLO_write_file_snapshot_free(snapshot);
+    return nullptr;
+  }
+
+  return snapshot;
+}
+
+static bool write_file_snapshot_impl(const BlendFileWriteSnapshot *snapshot,
+                                     ReportList *reports,
+                                     WriteWrap &ww)
+{
+  const char *filepath = snapshot->filepath;
+  char tempname[FILE_MAX + 1];
+
+  if (ww.use_in_place) {
+    STRNCPY(tempname, filepath);
+  }
+  else {
+    SNPRINTF(tempname, "%s@", filepath);
+  }
+
+  if (ww.open(tempname) == false) {
+    BKE_reportf(
+        reports, RPT_ERROR, "Cannot open file %s for writing: %s", tempname, strerror(errno));
     return false;
   }
 
-  /* File save to temporary file was successful, now do reverse file history
-   * (move `.blend1` -> `.blend2`, `.blend` -> `.blend1` .. etc). */
-  if (use_save_versions) {
-    if (!do_history(filepath, reports)) {
-      BKE_report(reports, RPT_ERROR, "Version backup failed (file saved with @)");
-      return false;
+  bool err = false;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &snapshot->memfile.chunks) {
+    if (!ww.write(chunk->buf, chunk->size)) {
+      err = true;
+      break;
     }
   }
 
-  if (BLI_rename_overwrite(tempname, filepath) != 0) {
-    BKE_report(reports, RPT_ERROR, "Cannot change old file (file saved with @)");
-    return false;
+  if (!ww.close()) {
+    err = true;
   }
 
-  write_file_main_validate_post(mainvar, reports);
+  return write_file_finalize(filepath, tempname, err, snapshot->use_save_versions, reports, ww);
+}
 
-  return true;
+bool BLO_write_file_snapshot_write(const BlendFileWriteSnapshot *snapshot, ReportList *reports)
+{
+  RawWriteWrap raw_wrap;
+
+  if (snapshot->use_compress) {
+    ZstdWriteWrap zstd_wrap(raw_wrap);
+    return write_file_snapshot_impl(snapshot, reports, zstd_wrap);
+  }
+
+  if (snapshot->diff_state && !snapshot->use_save_versions) {
+    DiffWriteWrap diff_wrap(*snapshot->diff_state);
+    return write_file_snapshot_impl(snapshot, reports, diff_wrap);
+  }
+
+  return write_file_snapshot_impl(snapshot, reports, raw_wrap);
+}
+
+void BLO_write_file_snapshot_free(BlendFileWriteSnapshot *snapshot)
+{
+  BLO_memfile_free(&snapshot->memfile);
+  MEM_delete(snapshot);
 }
 
 /** \} */
@@ -1698,6 +2174,11 @@ bool BLO_write_file(Main *mainvar,
     return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, zstd_wrap);
   }
 
+  if (params->diff_state && !params->use_save_versions) {
+    DiffWriteWrap diff_wrap(*params->diff_state);
+    return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, diff_wrap);
+  }
+
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
@@ -1711,6 +2192,16 @@ bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, int w
   return (err == 0);
 }
 
+BlendFileWriteDiffState *BLO_write_diff_state_new()
+{
+  return MEM_new<BlendFileWriteDiffState>(__func__);
+}
+
+void BLO_write_diff_state_free(BlendFileWriteDiffState *diff_state)
+{
+  MEM_delete(diff_state);
+}
+
 /*
  * API to handle writing IDs while clearing some of their runtime data.
  */
@@ -1891,6 +2382,12 @@ void BLO_write_shared(BlendWriter *writer,
   if (BLO_write_is_undo(writer)) {
     MemFile &memfile = *writer->wd->mem.written_memfile;
     if (sharing_info != nullptr) {
+#ifdef USE_PARALLEL_ID_WRITE
+      ThreadMutex *mutex = writer->wd->shared_storage_mutex;
+      if (mutex) {
+        BLI_mutex_lock(mutex);
+      }
+#endif
       if (memfile.shared_storage == nullptr) {
         memfile.shared_storage = MEM_new<MemFileSharedStorage>(__func__);
       }
@@ -1899,8 +2396,15 @@ void BLO_write_shared(BlendWriter *writer,
         sharing_info->add_user();
         /* This size is an estimate, but good enough to count data with many users less. */
         memfile.size += approximate_size_in_bytes / sharing_info->strong_users();
-        return;
       }
+#ifdef USE_PARALLEL_ID_WRITE
+      if (mutex) {
+        BLI_mutex_unlock(mutex);
+      }
+#endif
+      /* Data shared by multiple IDs is only stored once, reading looks it up by its address. This
+       * also makes the result independent of the order IDs are written in. */
+      return;
     }
   }
   write_fn();
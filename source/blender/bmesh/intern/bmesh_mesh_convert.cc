@@ -71,6 +71,8 @@
  *   These indices are also used to maintain correct indices for hook modifiers and vertex parents.
  */
 
+#include <atomic>
+
 #include "DNA_key_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -81,9 +83,11 @@
 
 #include "BLI_alloca.h"
 #include "BLI_array.hh"
+#include "BLI_function_ref.hh"
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_mempool.h"
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_task.hh"
@@ -110,6 +114,7 @@ static CLG_LogRef LOG = {"bmesh.mesh.convert"};
 
 using blender::Array;
 using blender::float3;
+using blender::FunctionRef;
 using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
@@ -193,20 +198,59 @@ static Vector<MeshToBMeshLayerInfo> mesh_to_bm_copy_info_calc(const CustomData &
   return infos;
 }
 
-static void mesh_attributes_copy_to_bmesh_block(CustomData &data,
-                                                const Span<MeshToBMeshLayerInfo> copy_info,
-                                                const int mesh_index,
-                                                BMHeader &header)
+static void mesh_attributes_copy_to_bmesh_block_values(const Span<MeshToBMeshLayerInfo> copy_info,
+                                                       const int mesh_index,
+                                                       void *block)
 {
-  CustomData_bmesh_alloc_block(&data, &header.data);
   for (const MeshToBMeshLayerInfo &info : copy_info) {
     if (info.mesh_data) {
       CustomData_data_copy_value(info.type,
                                  POINTER_OFFSET(info.mesh_data, info.elem_size * mesh_index),
-                                 POINTER_OFFSET(header.data, info.bmesh_offset));
+                                 POINTER_OFFSET(block, info.bmesh_offset));
     }
     else {
-      CustomData_data_set_default_value(info.type, POINTER_OFFSET(header.data, info.bmesh_offset));
+      CustomData_data_set_default_value(info.type, POINTER_OFFSET(block, info.bmesh_offset));
+    }
+  }
+}
+
+/**
+ * Allocate the custom data blocks of elements that don't have one yet in a single call, so that
+ * the attribute values can be copied from the mesh in parallel. The element at every index
+ * corresponds to the mesh element with the same index, null elements (from skipped faces) are
+ * ignored.
+ */
+template<typename T>
+static void mesh_attributes_copy_to_bmesh_blocks(CustomData &data,
+                                                 const Span<MeshToBMeshLayerInfo> copy_info,
+                                                 const Span<T *> elems,
+                                                 const FunctionRef<void(int, T &)> fn = {})
+{
+  if (data.totsize == 0) {
+    return;
+  }
+  Array<void *> blocks(elems.size());
+  BLI_mempool_alloc_n(data.pool, blocks.data(), uint(blocks.size()));
+  std::atomic<bool> has_null_elems = false;
+  blender::threading::parallel_for(elems.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (UNLIKELY(elems[i] == nullptr)) {
+        has_null_elems.store(true, std::memory_order_relaxed);
+        continue;
+      }
+      BLI_assert(elems[i]->head.data == nullptr);
+      elems[i]->head.data = blocks[i];
+      mesh_attributes_copy_to_bmesh_block_values(copy_info, i, blocks[i]);
+      if (fn) {
+        fn(i, *elems[i]);
+      }
+    }
+  });
+  if (UNLIKELY(has_null_elems)) {
+    for (const int i : elems.index_range()) {
+      if (elems[i] == nullptr) {
+        BLI_mempool_free(data.pool, blocks[i]);
+      }
     }
   }
 }
@@ -445,22 +489,22 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
     if (!vert_normals.is_empty()) {
       copy_v3_v3(v->no, vert_normals[i]);
     }
-
-    mesh_attributes_copy_to_bmesh_block(bm->vdata, vert_info, i, v->head);
-
-    /* Set shape key original index. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-    }
-
-    /* Set shape-key data. */
-    if (tot_shape_keys) {
-      float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(v, cd_shape_key_offset);
-      for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
-        copy_v3_v3(*co_dst, shape_key_table[j][i]);
-      }
-    }
   }
+  mesh_attributes_copy_to_bmesh_blocks<BMVert>(
+      bm->vdata, vert_info, vtable, [&](const int i, BMVert &v) {
+        /* Set shape key original index. */
+        if (cd_shape_keyindex_offset != -1) {
+          BM_ELEM_CD_SET_INT(&v, cd_shape_keyindex_offset, i);
+        }
+
+        /* Set shape-key data. */
+        if (tot_shape_keys) {
+          float(*co_dst)[3] = (float(*)[3])BM_ELEM_CD_GET_VOID_P(&v, cd_shape_key_offset);
+          for (int j = 0; j < tot_shape_keys; j++, co_dst++) {
+            copy_v3_v3(*co_dst, shape_key_table[j][i]);
+          }
+        }
+      });
   if (is_new) {
     bm->elem_index_dirty &= ~BM_VERT; /* Added in order, clear dirty flag. */
   }
@@ -485,9 +529,8 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
     if (!(!sharp_edges.is_empty() && sharp_edges[i])) {
       BM_elem_flag_enable(e, BM_ELEM_SMOOTH);
     }
-
-    mesh_attributes_copy_to_bmesh_block(bm->edata, edge_info, i, e->head);
   }
+  mesh_attributes_copy_to_bmesh_blocks<BMEdge>(bm->edata, edge_info, etable);
   if (is_new) {
     bm->elem_index_dirty &= ~BM_EDGE; /* Added in order, clear dirty flag. */
   }
@@ -496,21 +539,16 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
   const Span<int> corner_verts = mesh->corner_verts();
   const Span<int> corner_edges = mesh->corner_edges();
 
-  /* Only needed for selection. */
-
-  Array<BMFace *> ftable;
-  if (mesh->mselect && mesh->totselect != 0) {
-    ftable.reinitialize(mesh->faces_num);
-  }
+  /* Also used for selection. */
+  Array<BMFace *> ftable(mesh->faces_num);
+  /* Loops of skipped faces stay null. */
+  Array<BMLoop *> ltable(mesh->corners_num, nullptr);
 
   int totloops = 0;
   for (const int i : faces.index_range()) {
     const IndexRange face = faces[i];
-    BMFace *f = bm_face_create_from_mpoly(
+    BMFace *f = ftable[i] = bm_face_create_from_mpoly(
         *bm, corner_verts.slice(face), corner_edges.slice(face), vtable, etable);
-    if (!ftable.is_empty()) {
-      ftable[i] = f;
-    }
 
     if (UNLIKELY(f == nullptr)) {
       printf(
@@ -547,16 +585,23 @@ void BM_mesh_bm_from_me(BMesh *bm, const Mesh *mesh, const BMeshFromMeshParams *
     do {
       /* Don't use 'j' since we may have skipped some faces, hence some loops. */
       BM_elem_index_set(l_iter, totloops++); /* set_ok */
-
-      mesh_attributes_copy_to_bmesh_block(bm->ldata, loop_info, j, l_iter->head);
+      ltable[j] = l_iter;
       j++;
     } while ((l_iter = l_iter->next) != l_first);
+  }
 
-    mesh_attributes_copy_to_bmesh_block(bm->pdata, poly_info, i, f->head);
-
-    if (params->calc_face_normal) {
-      BM_face_normal_update(f);
-    }
+  /* Creating the faces links them into the disk and radial cycles, which has to stay serial.
+   * Everything that only touches the face or its own loops is done in parallel afterwards. */
+  mesh_attributes_copy_to_bmesh_blocks<BMLoop>(bm->ldata, loop_info, ltable);
+  mesh_attributes_copy_to_bmesh_blocks<BMFace>(bm->pdata, poly_info, ftable);
+  if (params->calc_face_normal) {
+    threading::parallel_for(ftable.index_range(), 1024, [&](const IndexRange range) {
+      for (BMFace *f : ftable.as_span().slice(range)) {
+        if (f) {
+          BM_face_normal_update(f);
+        }
+      }
+    });
   }
   if (is_new) {
     bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* Added in order, clear dirty flag. */
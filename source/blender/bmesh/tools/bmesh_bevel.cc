@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_memarena.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -2139,6 +2140,11 @@ static void calculate_profile_segments(const Profile *profile,
   }
 }
 
+/**
+ * Allocate the space for the coordinates of a profile if that hasn't been done already.
+ * Only the allocation uses the shared memory arena, so profiles whose coordinates have already
+ * been allocated can be calculated in parallel.
+ */
 /**
  * Calculate the actual coordinate values for bndv's profile.
  * This is only needed if bp->seg > 1.
@@ -2147,6 +2153,21 @@ static void calculate_profile_segments(const Profile *profile,
  * the coordinate values for the power of 2 >= bp->seg, because the ADJ pattern needs power-of-2
  * boundaries during construction.
  */
+static void profile_coords_ensure(BevelParams *bp, Profile *pro)
+{
+  if (bp->seg == 1 || pro->prof_co != nullptr) {
+    return;
+  }
+  pro->prof_co = (float *)BLI_memarena_alloc(bp->mem_arena, sizeof(float[3]) * (bp->seg + 1));
+  if (bp->seg != bp->pro_spacing.seg_2) {
+    pro->prof_co_2 = (float *)BLI_memarena_alloc(bp->mem_arena,
+                                                 sizeof(float[3]) * (bp->pro_spacing.seg_2 + 1));
+  }
+  else {
+    pro->prof_co_2 = pro->prof_co;
+  }
+}
+
 static void calculate_profile(BevelParams *bp, BoundVert *bndv, bool reversed, bool miter)
 {
   Profile *pro = &bndv->profile;
@@ -2157,16 +2178,7 @@ static void calculate_profile(BevelParams *bp, BoundVert *bndv, bool reversed, b
   }
 
   bool need_2 = bp->seg != bp->pro_spacing.seg_2;
-  if (pro->prof_co == nullptr) {
-    pro->prof_co = (float *)BLI_memarena_alloc(bp->mem_arena, sizeof(float[3]) * (bp->seg + 1));
-    if (need_2) {
-      pro->prof_co_2 = (float *)BLI_memarena_alloc(bp->mem_arena,
-                                                   sizeof(float[3]) * (bp->pro_spacing.seg_2 + 1));
-    }
-    else {
-      pro->prof_co_2 = pro->prof_co;
-    }
-  }
+  profile_coords_ensure(bp, pro);
 
   bool use_map;
   float map[4][4];
@@ -5920,6 +5932,55 @@ static void bevel_vert_two_edges(BevelParams *bp, BMesh *bm, BevVert *bv)
   }
 }
 
+static bool is_weld_vmesh(const BevVert *bv)
+{
+  return (bv->selcount == 2) && (bv->vmesh->count == 2);
+}
+
+/**
+ * Allocate the profile coordinates of all of the BevVert's BoundVerts,
+ * so that #build_vmesh_profiles doesn't need the memory arena.
+ */
+static void build_vmesh_profiles_alloc(BevelParams *bp, BevVert *bv)
+{
+  BoundVert *bndv = bv->vmesh->boundstart;
+  do {
+    profile_coords_ensure(bp, &bndv->profile);
+  } while ((bndv = bndv->next) != bv->vmesh->boundstart);
+}
+
+/**
+ * Calculate the final profiles of the BevVert's BoundVerts, before #build_vmesh creates the mesh
+ * vertices. This only changes data owned by the BevVert, so it can run in parallel for different
+ * BevVerts once #build_vmesh_profiles_alloc has been called for them.
+ */
+static void build_vmesh_profiles(BevelParams *bp, BevVert *bv)
+{
+  VMesh *vm = bv->vmesh;
+  /* Move profile planes if this is a weld case. */
+  if (is_weld_vmesh(bv)) {
+    BoundVert *weld1 = nullptr;
+    BoundVert *bndv = vm->boundstart;
+    do {
+      if (bndv->ebev) {
+        if (!weld1) {
+          weld1 = bndv;
+        }
+        else {
+          set_profile_params(bp, bv, weld1);
+          set_profile_params(bp, bv, bndv);
+          move_weld_profile_planes(bv, weld1, bndv);
+          break;
+        }
+      }
+    } while ((bndv = bndv->next) != vm->boundstart);
+  }
+
+  /* It's simpler to calculate all profiles only once at a single moment, so keep just a single
+   * profile calculation here, the last point before actual mesh verts are created. */
+  calculate_vm_profiles(bp, bv, vm);
+}
+
 /* Given that the boundary is built, now make the actual BMVerts
  * for the boundary and the interior of the vertex mesh. */
 static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
@@ -5935,7 +5996,7 @@ static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
                                            sizeof(NewVert) * n * (ns2 + 1) * (ns + 1));
 
   /* Special case: just two beveled edges welded together. */
-  const bool weld = (bv->selcount == 2) && (vm->count == 2);
+  const bool weld = is_weld_vmesh(bv);
   BoundVert *weld1 = nullptr; /* Will hold two BoundVerts involved in weld. */
   BoundVert *weld2 = nullptr;
 
@@ -5947,24 +6008,17 @@ static void build_vmesh(BevelParams *bp, BMesh *bm, BevVert *bv)
     create_mesh_bmvert(bm, vm, i, 0, 0, bv->v);          /* Create BMVert for that NewVert. */
     bndv->nv.v = mesh_vert(vm, i, 0, 0)->v; /* Use the BMVert for the BoundVert's NewVert. */
 
-    /* Find boundverts and move profile planes if this is a weld case. */
+    /* Find boundverts if this is a weld case. */
     if (weld && bndv->ebev) {
       if (!weld1) {
         weld1 = bndv;
       }
       else { /* Get the last of the two BoundVerts. */
         weld2 = bndv;
-        set_profile_params(bp, bv, weld1);
-        set_profile_params(bp, bv, weld2);
-        move_weld_profile_planes(bv, weld1, weld2);
       }
     }
   } while ((bndv = bndv->next) != vm->boundstart);
 
-  /* It's simpler to calculate all profiles only once at a single moment, so keep just a single
-   * profile calculation here, the last point before actual mesh verts are created. */
-  calculate_vm_profiles(bp, bv, vm);
-
   /* Create new vertices and place them based on the profiles. */
   /* Copy other ends to (i, 0, ns) for all i, and fill in profiles for edges. */
   bndv = vm->boundstart;
@@ -7849,15 +7903,28 @@ void BM_mesh_bevel(BMesh *bm,
     }
   }
 
-  /* Build the meshes around vertices, now that positions are final. */
+  /* Build the meshes around vertices, now that positions are final. The profiles of different
+   * vertices are independent, so they are calculated in parallel before creating the geometry,
+   * which has to be done serially. */
+  Vector<BevVert *> bevverts;
   BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
     if (BM_elem_flag_test(v, BM_ELEM_TAG)) {
       bv = find_bevvert(&bp, v);
       if (bv) {
-        build_vmesh(&bp, bm, bv);
+        build_vmesh_profiles_alloc(&bp, bv);
+        bevverts.append(bv);
       }
     }
   }
+  blender::threading::parallel_for(
+      bevverts.index_range(), 256, [&](const blender::IndexRange range) {
+        for (BevVert *bevvert : bevverts.as_span().slice(range)) {
+          build_vmesh_profiles(&bp, bevvert);
+        }
+      });
+  for (BevVert *bevvert : bevverts) {
+    build_vmesh(&bp, bm, bevvert);
+  }
 
   /* Build polygons for edges. */
   if (bp.affect_type != BEVEL_AFFECT_VERTICES) {
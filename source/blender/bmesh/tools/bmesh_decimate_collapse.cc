@@ -8,11 +8,13 @@
  * BMesh decimator that uses an edge collapse method.
  */
 
+#include <algorithm>
 #include <cstddef>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
@@ -21,7 +23,9 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
 
@@ -66,62 +70,103 @@ ENUM_OPERATORS(CD_UseFlag, CD_DO_LOOP)
 /* BMesh Helper Functions
  * ********************** */
 
-/**
- * \param vquadrics: must be calloc'd
- */
-static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+static void bm_decim_face_quadric(BMFace *f, Quadric *r_q)
 {
-  BMIter iter;
-  BMFace *f;
-  BMEdge *e;
+  float center[3];
+  double plane_db[4];
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_first;
-    BMLoop *l_iter;
+  BM_face_calc_center_median(f, center);
+  copy_v3db_v3fl(plane_db, f->no);
+  plane_db[3] = -dot_v3db_v3fl(plane_db, center);
 
-    float center[3];
-    double plane_db[4];
-    Quadric q;
+  BLI_quadric_from_plane(r_q, plane_db);
+}
 
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+/** \return false when the edge isn't a boundary edge, or its plane is degenerate. */
+static bool bm_decim_boundary_edge_quadric(BMEdge *e, Quadric *r_q)
+{
+  if (LIKELY(!BM_edge_is_boundary(e))) {
+    return false;
+  }
+  float edge_vector[3];
+  float edge_plane[3];
+  double edge_plane_db[4];
+  sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
 
-    BLI_quadric_from_plane(&q, plane_db);
+  cross_v3_v3v3(edge_plane, edge_vector, e->l->f->no);
+  copy_v3db_v3fl(edge_plane_db, edge_plane);
 
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
-    } while ((l_iter = l_iter->next) != l_first);
+  if (normalize_v3_db(edge_plane_db) <= double(FLT_EPSILON)) {
+    return false;
   }
+  float center[3];
+  mid_v3_v3v3(center, e->v1->co, e->v2->co);
 
-  /* boundary edges */
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    if (UNLIKELY(BM_edge_is_boundary(e))) {
-      float edge_vector[3];
-      float edge_plane[3];
-      double edge_plane_db[4];
-      sub_v3_v3v3(edge_vector, e->v2->co, e->v1->co);
-      f = e->l->f;
-
-      cross_v3_v3v3(edge_plane, edge_vector, f->no);
-      copy_v3db_v3fl(edge_plane_db, edge_plane);
+  edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
+  BLI_quadric_from_plane(r_q, edge_plane_db);
+  BLI_quadric_mul(r_q, BOUNDARY_PRESERVE_WEIGHT);
+  return true;
+}
 
-      if (normalize_v3_db(edge_plane_db) > double(FLT_EPSILON)) {
-        Quadric q;
-        float center[3];
+/**
+ * The face and boundary edge quadrics are calculated in parallel. Each vertex then adds the
+ * quadrics of its faces in face order, followed by its boundary edges in edge order, which gives
+ * the same sums as accumulating them serially over all faces and then all edges.
+ *
+ * \param vquadrics: must be calloc'd
+ */
+static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
+{
+  using namespace blender;
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  Array<Quadric> face_quadrics(bm->totface);
+  threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      bm_decim_face_quadric(bm->ftable[i], &face_quadrics[i]);
+    }
+  });
+
+  /* Boundary edges. */
+  Array<Quadric> edge_quadrics(bm->totedge);
+  Array<bool> edge_quadric_used(bm->totedge);
+  threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      edge_quadric_used[i] = bm_decim_boundary_edge_quadric(bm->etable[i], &edge_quadrics[i]);
+    }
+  });
 
-        mid_v3_v3v3(center, e->v1->co, e->v2->co);
+  threading::parallel_for(IndexRange(bm->totvert), 512, [&](const IndexRange range) {
+    Vector<int, 16> indices;
+    for (const int i : range) {
+      BMVert *v = bm->vtable[i];
+      BMIter iter;
 
-        edge_plane_db[3] = -dot_v3db_v3fl(edge_plane_db, center);
-        BLI_quadric_from_plane(&q, edge_plane_db);
-        BLI_quadric_mul(&q, BOUNDARY_PRESERVE_WEIGHT);
+      indices.clear();
+      BMLoop *l;
+      BM_ITER_ELEM (l, &iter, v, BM_LOOPS_OF_VERT) {
+        indices.append(BM_elem_index_get(l->f));
+      }
+      std::sort(indices.begin(), indices.end());
+      for (const int face_index : indices) {
+        BLI_quadric_add_qu_qu(&vquadrics[i], &face_quadrics[face_index]);
+      }
 
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v1)], &q);
-        BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(e->v2)], &q);
+      indices.clear();
+      BMEdge *e;
+      BM_ITER_ELEM (e, &iter, v, BM_EDGES_OF_VERT) {
+        const int edge_index = BM_elem_index_get(e);
+        if (edge_quadric_used[edge_index]) {
+          indices.append(edge_index);
+        }
+      }
+      std::sort(indices.begin(), indices.end());
+      for (const int edge_index : indices) {
+        BLI_quadric_add_qu_qu(&vquadrics[i], &edge_quadrics[edge_index]);
       }
     }
-  }
+  });
 }
 
 static void bm_decim_calc_target_co_db(BMEdge *e, double optimize_co[3], const Quadric *vquadrics)
@@ -227,12 +272,15 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * Calculate the cost of collapsing the edge.
+ * \return false when the edge shouldn't be collapsed at all.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
@@ -315,10 +363,26 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
 
 clear:
+  return false;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
+
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -340,14 +404,26 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
-  BMIter iter;
-  BMEdge *e;
-  uint i;
+  using namespace blender;
+  BM_mesh_elem_table_ensure(bm, BM_EDGE);
+
+  /* Calculate the costs in parallel, then fill the heap in edge order so the result is the same
+   * as inserting the edges one at a time. */
+  Array<float> costs(bm->totedge);
+  Array<bool> costs_valid(bm->totedge);
+  threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      costs_valid[i] = bm_decim_calc_edge_cost(
+          bm->etable[i], vquadrics, vweights, vweight_factor, &costs[i]);
+    }
+  });
 
-  BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
+  for (const int i : IndexRange(bm->totedge)) {
     /* keep sanity check happy */
     eheap_table[i] = nullptr;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    if (costs_valid[i]) {
+      eheap_table[i] = BLI_heap_insert(eheap, costs[i], bm->etable[i]);
+    }
   }
 }
 
@@ -9,6 +9,7 @@
 #include "BLT_translation.hh"
 
 #include "COM_Debug.h"
+#include "COM_OperationBufferCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -27,7 +28,8 @@ FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  Span<NodeOperation *> operations)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
-      num_operations_finished_(0)
+      num_operations_finished_(0),
+      use_buffer_cache_(!context.is_rendering())
 {
   priorities_.append(eCompositorPriority::High);
   priorities_.append(eCompositorPriority::Medium);
@@ -43,7 +45,68 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
   determine_areas_to_render_and_reads();
+  if (use_buffer_cache_) {
+    determine_operations_needing_cache_key();
+  }
   render_operations();
+  if (use_buffer_cache_) {
+    OperationBufferCache::get().end_execution();
+  }
+}
+
+void FullFrameExecutionModel::determine_operations_needing_cache_key()
+{
+  Vector<NodeOperation *> stack;
+  for (NodeOperation *op : operations_) {
+    if (op->get_flags().use_buffer_cache) {
+      stack.append(op);
+    }
+  }
+  while (stack.size() > 0) {
+    NodeOperation *operation = stack.pop_last();
+    if (!operations_needing_cache_key_.add(operation)) {
+      continue;
+    }
+    for (int i = 0; i < operation->get_number_of_input_sockets(); i++) {
+      stack.append(operation->get_input_operation(i));
+    }
+  }
+}
+
+std::optional<uint64_t> FullFrameExecutionModel::compute_cache_key(NodeOperation *op)
+{
+  const std::optional<NodeOperationHash> hash = op->generate_hash();
+  if (!hash) {
+    return std::nullopt;
+  }
+
+  uint64_t key = hash->get_type_and_params_hash();
+  const rcti &canvas = op->get_canvas();
+  for (const rcti &area : active_buffers_.get_areas_to_render(op, -canvas.xmin, -canvas.ymin)) {
+    key = get_default_hash(key, get_default_hash(area.xmin, area.xmax, area.ymin, area.ymax));
+  }
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    key = get_default_hash(key, get_input_cache_key(op->get_input_operation(i)));
+  }
+  return key;
+}
+
+uint64_t FullFrameExecutionModel::get_input_cache_key(NodeOperation *input_op)
+{
+  if (const uint64_t *key = cache_keys_.lookup_ptr(input_op)) {
+    return *key;
+  }
+
+  /* Inputs are only disposed once all operations reading them are rendered, so the pixels are
+   * still available. */
+  const MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input_op);
+  const rcti &canvas = input_op->get_canvas();
+  const Vector<rcti> areas = active_buffers_.get_areas_to_render(
+      input_op, -canvas.xmin, -canvas.ymin);
+  const uint64_t content_hash = buf ? OperationBufferCache::hash_buffer_content(*buf, areas) : 0;
+  const uint64_t key = get_default_hash(typeid(*input_op).hash_code(), content_hash);
+  cache_keys_.add_new(input_op, key);
+  return key;
 }
 
 void FullFrameExecutionModel::determine_areas_to_render_and_reads()
@@ -98,13 +161,53 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
 }
 
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
+{
+  const timeit::TimePoint before_time = timeit::Clock::now();
+
+  const bool has_outputs = op->get_number_of_output_sockets() > 0;
+
+  std::optional<uint64_t> cache_key;
+  if (use_buffer_cache_ && operations_needing_cache_key_.contains(op)) {
+    cache_key = compute_cache_key(op);
+    if (cache_key) {
+      cache_keys_.add_new(op, *cache_key);
+    }
+  }
+  const bool use_buffer_cache = cache_key && has_outputs && op->get_flags().use_buffer_cache;
+
+  MemoryBuffer *cached_buf = use_buffer_cache ? OperationBufferCache::get().lookup(*cache_key) :
+                                               nullptr;
+  if (cached_buf) {
+    /* Rendered by a previous execution with the same parameters and inputs. */
+    active_buffers_.set_rendered_buffer(op,
+                                        std::make_unique<MemoryBuffer>(
+                                            cached_buf->get_buffer(),
+                                            cached_buf->get_num_channels(),
+                                            cached_buf->get_rect(),
+                                            cached_buf->is_a_single_elem()));
+  }
+  else {
+    render_operation_buffer(op, use_buffer_cache ? cache_key : std::nullopt);
+  }
+
+  operation_finished(op);
+
+  /* The operation may not come from any node. For example, it may have been added to convert data
+   * type. Do not accumulate time from its execution. */
+  const timeit::TimePoint after_time = timeit::Clock::now();
+  const bNodeInstanceKey node_instance_key = op->get_node_instance_key();
+  if (context_.get_profiler() && node_instance_key != bke::NODE_INSTANCE_KEY_NONE) {
+    context_.get_profiler()->set_node_evaluation_time(node_instance_key, after_time - before_time);
+  }
+}
+
+void FullFrameExecutionModel::render_operation_buffer(NodeOperation *op,
+                                                      const std::optional<uint64_t> cache_key)
 {
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
-  const timeit::TimePoint before_time = timeit::Clock::now();
-
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
   MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
   if (op->get_width() > 0 && op->get_height() > 0) {
@@ -119,19 +222,19 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
       delete buf;
     }
   }
+  if (cache_key && !op->is_braked()) {
+    /* Keep the buffer in the cache, other operations read it through a buffer that doesn't own
+     * the pixels. */
+    OperationBufferCache::get().add(*cache_key, std::unique_ptr<MemoryBuffer>(op_buf));
+    op_buf = new MemoryBuffer(op_buf->get_buffer(),
+                              op_buf->get_num_channels(),
+                              op_buf->get_rect(),
+                              op_buf->is_a_single_elem());
+  }
+
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
   active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
-
-  operation_finished(op);
-
-  /* The operation may not come from any node. For example, it may have been added to convert data
-   * type. Do not accumulate time from its execution. */
-  const timeit::TimePoint after_time = timeit::Clock::now();
-  const bNodeInstanceKey node_instance_key = op->get_node_instance_key();
-  if (context_.get_profiler() && node_instance_key != bke::NODE_INSTANCE_KEY_NONE) {
-    context_.get_profiler()->set_node_evaluation_time(node_instance_key, after_time - before_time);
-  }
 }
 
 void FullFrameExecutionModel::render_operations()
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -43,6 +47,22 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Whether rendered buffers are kept between executions, see #OperationBufferCache.
+   */
+  bool use_buffer_cache_;
+
+  /**
+   * Operations that need a cache key, because they or operations depending on them use the
+   * buffer cache.
+   */
+  Set<NodeOperation *> operations_needing_cache_key_;
+
+  /**
+   * Cache keys of rendered operations.
+   */
+  Map<NodeOperation *, uint64_t> cache_keys_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -64,6 +84,23 @@ class FullFrameExecutionModel : public ExecutionModel {
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op, int output_x, int output_y);
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
+  /**
+   * Render the buffer of the operation. When given a cache key, the buffer is added to the
+   * #OperationBufferCache.
+   */
+  void render_operation_buffer(NodeOperation *op, std::optional<uint64_t> cache_key);
+
+  void determine_operations_needing_cache_key();
+  /**
+   * Computes the cache key of an operation from its parameters and the keys of its inputs, which
+   * must be rendered. Operations that don't hash their parameters have no key.
+   */
+  std::optional<uint64_t> compute_cache_key(NodeOperation *op);
+  /**
+   * Get the key of a rendered input. When the input has no key, the key is computed from its
+   * rendered pixels.
+   */
+  uint64_t get_input_cache_key(NodeOperation *input_op);
 
   void operation_finished(NodeOperation *operation);
 
@@ -206,6 +206,14 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether the rendered buffer is kept between executions, so that it is not rendered again
+   * while editing nodes that do not affect it. Only useful for expensive operations, which must
+   * hash all the parameters that affect their result in #NodeOperation::hash_output_params.
+   * See #OperationBufferCache.
+   */
+  bool use_buffer_cache : 1;
+
   NodeOperationFlags()
   {
     use_render_border = false;
@@ -217,6 +225,7 @@ struct NodeOperationFlags {
     use_datatype_conversion = true;
     is_constant_operation = false;
     can_be_constant = false;
+    use_buffer_cache = false;
   }
 };
 
@@ -236,6 +245,12 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  /** Hash of the operation type and its parameters, without the inputs. */
+  uint64_t get_type_and_params_hash() const
+  {
+    return get_default_hash(type_hash_, params_hash_);
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -0,0 +1,101 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "xxhash.h"
+
+#include "BLI_rect.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_OperationBufferCache.h"
+
+namespace blender::compositor {
+
+/** Memory used by cached buffers, larger than the buffers of a few 8K plates. */
+static constexpr size_t DEFAULT_MAX_MEMORY = size_t(4) * 1024 * 1024 * 1024;
+
+static OperationBufferCache *g_cache = nullptr;
+
+static size_t buffer_memory_size(const MemoryBuffer &buffer)
+{
+  return sizeof(float) * buffer.get_num_channels() * buffer.get_memory_width() *
+         buffer.get_memory_height();
+}
+
+OperationBufferCache::OperationBufferCache(const size_t max_memory) : max_memory_(max_memory) {}
+
+OperationBufferCache::~OperationBufferCache() = default;
+
+OperationBufferCache &OperationBufferCache::get()
+{
+  if (g_cache == nullptr) {
+    g_cache = new OperationBufferCache(DEFAULT_MAX_MEMORY);
+  }
+  return *g_cache;
+}
+
+void OperationBufferCache::free()
+{
+  delete g_cache;
+  g_cache = nullptr;
+}
+
+MemoryBuffer *OperationBufferCache::lookup(const uint64_t key)
+{
+  CachedBuffer *cached = buffers_.lookup_ptr(key);
+  if (cached == nullptr) {
+    return nullptr;
+  }
+  cached->is_used = true;
+  return cached->buffer.get();
+}
+
+MemoryBuffer *OperationBufferCache::add(const uint64_t key, std::unique_ptr<MemoryBuffer> buffer)
+{
+  MemoryBuffer *result = buffer.get();
+  buffers_.add_new(key, {std::move(buffer), true});
+  return result;
+}
+
+void OperationBufferCache::end_execution()
+{
+  size_t memory = 0;
+  buffers_.remove_if([&](auto item) {
+    if (!item.value.is_used) {
+      return true;
+    }
+    memory += buffer_memory_size(*item.value.buffer);
+    return memory > max_memory_;
+  });
+  for (CachedBuffer &cached : buffers_.values()) {
+    cached.is_used = false;
+  }
+}
+
+uint64_t OperationBufferCache::hash_buffer_content(const MemoryBuffer &buffer,
+                                                   const Span<rcti> areas)
+{
+  const size_t elem_size = sizeof(float) * buffer.get_num_channels();
+  if (buffer.is_a_single_elem()) {
+    return XXH3_64bits(buffer.get_elem(0, 0), elem_size);
+  }
+
+  XXH3_state_t *state = XXH3_createState();
+  XXH3_64bits_reset(state);
+  for (const rcti &area : areas) {
+    rcti buffer_area;
+    if (!BLI_rcti_isect(&area, &buffer.get_rect(), &buffer_area)) {
+      continue;
+    }
+    XXH3_64bits_update(state, &buffer_area, sizeof(buffer_area));
+    const size_t row_size = elem_size * BLI_rcti_size_x(&buffer_area);
+    for (int y = buffer_area.ymin; y < buffer_area.ymax; y++) {
+      XXH3_64bits_update(state, buffer.get_elem(buffer_area.xmin, y), row_size);
+    }
+  }
+  const uint64_t hash = XXH3_64bits_digest(state);
+  XXH3_freeState(state);
+  return hash;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+
+#include "DNA_vec_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Keeps rendered buffers of expensive operations between executions, so that editing a node only
+ * renders the operations it affects again. Buffers are identified by a key of the operation
+ * type, its parameters, its areas to render and the keys or contents of its inputs.
+ *
+ * Buffers that were not used by the last execution are freed when it ends, so the cache only
+ * holds the results of the node tree that is being edited.
+ */
+class OperationBufferCache {
+ private:
+  struct CachedBuffer {
+    std::unique_ptr<MemoryBuffer> buffer;
+    bool is_used;
+  };
+  Map<uint64_t, CachedBuffer> buffers_;
+  size_t max_memory_;
+
+ public:
+  OperationBufferCache(size_t max_memory);
+  ~OperationBufferCache();
+
+  /**
+   * Get the cache shared by all executions, which are serialized by the compositor.
+   */
+  static OperationBufferCache &get();
+  static void free();
+
+  /**
+   * Get the buffer stored with the key, or null when there is none. The buffer stays valid until
+   * the end of the execution.
+   */
+  MemoryBuffer *lookup(uint64_t key);
+  /**
+   * Store a rendered buffer, which stays valid until the end of the execution. There must be no
+   * buffer with the key yet.
+   */
+  MemoryBuffer *add(uint64_t key, std::unique_ptr<MemoryBuffer> buffer);
+  /**
+   * Free buffers that were not used by the execution, and more when the cache uses too much
+   * memory. Must be called when no buffers are in use anymore.
+   */
+  void end_execution();
+
+  int64_t size() const
+  {
+    return buffers_.size();
+  }
+
+  /**
+   * Hash the pixels of the areas of a rendered buffer. Areas are in buffer coordinates.
+   */
+  static uint64_t hash_buffer_content(const MemoryBuffer &buffer, Span<rcti> areas);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:OperationBufferCache")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -11,6 +11,7 @@
 #include "BKE_scene.hh"
 
 #include "COM_ExecutionSystem.h"
+#include "COM_OperationBufferCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.hh"
 
@@ -77,12 +78,15 @@ void COM_execute(Render *render,
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
+  /* GPU compositor. Renders that can't be composited on the GPU fall back to the CPU
+   * compositor. */
+  bool is_executed = false;
   if (scene->r.compositor_device == SCE_COMPOSITOR_DEVICE_GPU) {
-    /* GPU compositor. */
-    RE_compositor_execute(
+    is_executed = RE_compositor_execute(
         *render, *scene, *render_data, *node_tree, view_name, render_context, profiler);
   }
-  else {
+
+  if (!is_executed) {
     /* CPU compositor. */
 
     /* Initialize workscheduler. */
@@ -103,6 +107,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    blender::compositor::OperationBufferCache::free();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
@@ -16,6 +16,7 @@ BlurBaseOperation::BlurBaseOperation(DataType data_type)
   this->add_input_socket(DataType::Value);
   this->add_output_socket(data_type);
   flags_.can_be_constant = true;
+  flags_.use_buffer_cache = true;
   memset(&data_, 0, sizeof(NodeBlurData));
   size_ = 1.0f;
   sizeavailable_ = false;
@@ -23,6 +24,15 @@ BlurBaseOperation::BlurBaseOperation(DataType data_type)
   use_variable_size_ = false;
 }
 
+void BlurBaseOperation::hash_output_params()
+{
+  hash_params(int(data_.sizex), int(data_.sizey), int(data_.filtertype));
+  hash_params(int(data_.relative), int(data_.aspect), int(data_.gamma));
+  hash_params(data_.percentx, data_.percenty, int(data_.bokeh));
+  hash_params(data_.image_in_width, data_.image_in_height);
+  hash_params(size_, sizeavailable_, extend_bounds_);
+}
+
 void BlurBaseOperation::init_data()
 {
   update_size();
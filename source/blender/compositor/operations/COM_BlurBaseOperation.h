@@ -34,6 +34,8 @@ class BlurBaseOperation : public MultiThreadedOperation {
 
   void update_size();
 
+  void hash_output_params() override;
+
   NodeBlurData data_;
 
   float size_;
@@ -24,6 +24,7 @@ BokehBlurOperation::BokehBlurOperation()
   this->add_output_socket(DataType::Color);
 
   flags_.can_be_constant = true;
+  flags_.use_buffer_cache = true;
 
   size_ = 1.0f;
   sizeavailable_ = false;
@@ -31,6 +32,11 @@ BokehBlurOperation::BokehBlurOperation()
   extend_bounds_ = false;
 }
 
+void BokehBlurOperation::hash_output_params()
+{
+  hash_params(size_, sizeavailable_, extend_bounds_);
+}
+
 void BokehBlurOperation::init_data()
 {
   update_size();
@@ -134,6 +134,7 @@ DenoiseOperation::DenoiseOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   settings_ = nullptr;
+  flags_.use_buffer_cache = true;
 }
 
 static bool are_guiding_passes_noise_free(const NodeDenoise *settings)
@@ -11,6 +11,17 @@ DirectionalBlurOperation::DirectionalBlurOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   flags_.can_be_constant = true;
+  flags_.use_buffer_cache = true;
+}
+
+void DirectionalBlurOperation::hash_output_params()
+{
+  if (data_ == nullptr) {
+    return;
+  }
+  hash_params(data_->center_x, data_->center_y, data_->distance);
+  hash_params(data_->angle, data_->spin, data_->zoom);
+  hash_param(int(data_->iter));
 }
 
 void DirectionalBlurOperation::init_execution()
@@ -15,6 +15,12 @@ GaussianAlphaBlurBaseOperation::GaussianAlphaBlurBaseOperation(eDimension dim)
   dimension_ = dim;
 }
 
+void GaussianAlphaBlurBaseOperation::hash_output_params()
+{
+  BlurBaseOperation::hash_output_params();
+  hash_params(falloff_, do_subtract_);
+}
+
 void GaussianAlphaBlurBaseOperation::init_data()
 {
   BlurBaseOperation::init_data();
@@ -46,6 +46,9 @@ class GaussianAlphaBlurBaseOperation : public BlurBaseOperation {
   {
     return (LIKELY(test == false)) ? f : 1.0f - f;
   }
+
+ protected:
+  void hash_output_params() override;
 };
 
 class GaussianAlphaXBlurOperation : public GaussianAlphaBlurBaseOperation {
@@ -12,9 +12,21 @@ GlareBaseOperation::GlareBaseOperation()
   this->add_output_socket(DataType::Color);
   settings_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.use_buffer_cache = true;
   is_output_rendered_ = false;
 }
 
+void GlareBaseOperation::hash_output_params()
+{
+  if (settings_ == nullptr) {
+    return;
+  }
+  hash_params(int(settings_->quality), int(settings_->type), int(settings_->iter));
+  hash_params(int(settings_->size), int(settings_->star_45), int(settings_->streaks));
+  hash_params(settings_->colmod, settings_->mix, settings_->threshold);
+  hash_params(settings_->fade, settings_->angle_ofs);
+}
+
 void GlareBaseOperation::get_area_of_interest(const int input_idx,
                                               const rcti & /*output_area*/,
                                               rcti &r_input_area)
@@ -20,6 +20,12 @@ KuwaharaAnisotropicOperation::KuwaharaAnisotropicOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   this->flags_.can_be_constant = true;
+  this->flags_.use_buffer_cache = true;
+}
+
+void KuwaharaAnisotropicOperation::hash_output_params()
+{
+  hash_params(sharpness_, eccentricity_);
 }
 
 /* An implementation of the Anisotropic Kuwahara filter described in the paper:
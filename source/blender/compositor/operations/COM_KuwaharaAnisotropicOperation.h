@@ -24,6 +24,9 @@ class KuwaharaAnisotropicOperation : public MultiThreadedOperation {
   float get_eccentricity();
   void set_sharpness(float sharpness);
   void set_eccentricity(float eccentricity);
+
+ protected:
+  void hash_output_params() override;
 };
 
 }  // namespace blender::compositor
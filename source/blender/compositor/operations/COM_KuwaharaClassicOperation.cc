@@ -20,6 +20,12 @@ KuwaharaClassicOperation::KuwaharaClassicOperation()
   this->add_output_socket(DataType::Color);
 
   this->flags_.can_be_constant = true;
+  this->flags_.use_buffer_cache = true;
+}
+
+void KuwaharaClassicOperation::hash_output_params()
+{
+  hash_param(high_precision_);
 }
 
 void KuwaharaClassicOperation::update_memory_buffer_partial(MemoryBuffer *output,
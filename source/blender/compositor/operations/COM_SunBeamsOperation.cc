@@ -18,6 +18,12 @@ SunBeamsOperation::SunBeamsOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   this->set_canvas_input_index(0);
+  flags_.use_buffer_cache = true;
+}
+
+void SunBeamsOperation::hash_output_params()
+{
+  hash_params(data_.source[0], data_.source[1], data_.ray_length);
 }
 
 void SunBeamsOperation::update_memory_buffer_partial(MemoryBuffer *output,
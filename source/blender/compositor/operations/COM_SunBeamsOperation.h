@@ -21,6 +21,9 @@ class SunBeamsOperation : public MultiThreadedOperation {
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
 
+ protected:
+  void hash_output_params() override;
+
  private:
   NodeSunBeams data_;
 };
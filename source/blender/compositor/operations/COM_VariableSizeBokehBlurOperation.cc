@@ -21,12 +21,18 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
 #endif
   this->add_output_socket(DataType::Color);
   flags_.can_be_constant = true;
+  flags_.use_buffer_cache = true;
 
   max_blur_ = 32.0f;
   threshold_ = 1.0f;
   do_size_scale_ = false;
 }
 
+void VariableSizeBokehBlurOperation::hash_output_params()
+{
+  hash_params(max_blur_, threshold_, do_size_scale_);
+}
+
 struct VariableSizeBokehBlurTileData {
   MemoryBuffer *color;
   MemoryBuffer *bokeh;
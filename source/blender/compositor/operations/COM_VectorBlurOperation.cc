@@ -30,6 +30,16 @@ VectorBlurOperation::VectorBlurOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   settings_ = nullptr;
+  flags_.use_buffer_cache = true;
+}
+
+void VectorBlurOperation::hash_output_params()
+{
+  if (settings_ == nullptr) {
+    return;
+  }
+  hash_params(int(settings_->samples), int(settings_->maxspeed), int(settings_->minspeed));
+  hash_params(int(settings_->curved), settings_->fac);
 }
 
 /* Returns the input velocity that has the larger magnitude. */
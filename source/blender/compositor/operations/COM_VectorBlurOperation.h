@@ -29,6 +29,9 @@ class VectorBlurOperation : public NodeOperation {
                             const rcti &area,
                             Span<MemoryBuffer *> inputs) override;
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+
+ protected:
+  void hash_output_params() override;
 };
 
 }  // namespace blender::compositor
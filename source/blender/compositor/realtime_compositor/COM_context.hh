@@ -41,6 +41,9 @@ class Context {
   /* A static cache manager that can be used to acquire cached resources for the compositor
    * efficiently. */
   StaticCacheManager cache_manager_;
+  /* True if half precision intermediate results should be used even if full precision ones were
+   * requested, because they are not expected to fit in GPU memory. See get_precision. */
+  bool use_half_precision_fallback_ = false;
 
  public:
   Context(TexturePool &texture_pool);
@@ -93,8 +96,9 @@ class Context {
   /* Get the name of the view currently being rendered. */
   virtual StringRef get_view_name() const = 0;
 
-  /* Get the precision of the intermediate results of the compositor. */
-  virtual ResultPrecision get_precision() const = 0;
+  /* Get the precision of the intermediate results of the compositor that was requested by the
+   * user. See get_precision for the precision that is actually used. */
+  virtual ResultPrecision get_requested_precision() const = 0;
 
   /* Set an info message. This is called by the compositor evaluator to inform or warn the user
    * about something, typically an error. The implementation should display the message in an
@@ -154,6 +158,15 @@ class Context {
   /* Get the current time in seconds of the active scene. */
   float get_time() const;
 
+  /* Get the precision of the intermediate results of the compositor. This is the requested
+   * precision, unless the evaluator decided to fall back to half precision to fit in GPU memory.
+   * See the use_half_precision_fallback_ member. */
+  ResultPrecision get_precision() const;
+
+  /* Set whether half precision intermediate results should be used regardless of the requested
+   * precision. This should only be changed by the evaluator before compiling the node tree. */
+  void set_half_precision_fallback(bool use_half_precision_fallback);
+
   /* Get a GPU shader with the given info name and precision. */
   GPUShader *get_shader(const char *info_name, ResultPrecision precision);
 
@@ -145,6 +145,11 @@ class Evaluator {
   /* Compile the node tree into an operations stream and evaluate it. */
   void compile_and_evaluate();
 
+  /* Fall back to half precision intermediate results if full precision is requested but the
+   * intermediate results are estimated to not fit in the free GPU memory. The estimate assumes
+   * that all intermediate results have the size of the compositing region. */
+  void compute_half_precision_fallback();
+
   /* Compile the given node into a node operation, map each input to the result of the output
    * linked to it, update the compile state, add the newly created operation to the operations
    * stream, and evaluate the operation. */
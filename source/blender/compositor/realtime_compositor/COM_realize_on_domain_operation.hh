@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <optional>
+
+#include "BLI_math_vector_types.hh"
+
 #include "GPU_shader.hh"
 
 #include "COM_context.hh"
@@ -39,6 +43,12 @@ class RealizeOnDomainOperation : public SimpleOperation {
                                               const InputDescriptor &input_descriptor,
                                               const Domain &operation_domain);
 
+  /* If realizing the given input on the given operation domain only translates it by a whole
+   * number of texels, return that translation, such that the input can be read with an offset
+   * instead of being realized. Otherwise, return nothing. */
+  static std::optional<int2> compute_texel_translation(Result &input_result,
+                                                       const Domain &operation_domain);
+
  protected:
   /* The operation domain is just the target domain. */
   Domain compute_domain() override;
@@ -22,4 +22,9 @@ using Schedule = VectorSet<DNode>;
  * traversal of dependencies based on a heuristic estimation of the number of needed buffers. */
 Schedule compute_schedule(const Context &context, const DerivedNodeTree &tree);
 
+/* Estimates the largest number of intermediate buffers that are alive at the same time while
+ * evaluating the schedule computed by compute_schedule, using the same heuristic it uses to order
+ * the nodes. */
+int estimate_peak_number_of_needed_buffers(const Context &context, const DerivedNodeTree &tree);
+
 }  // namespace blender::realtime_compositor
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_vector_set.hh"
 
@@ -117,6 +118,11 @@ class ShaderOperation : public Operation {
   /* A vector set that stores all output sockets that are used as previews for nodes inside the
    * shader operation. */
   VectorSet<DOutputSocket> preview_outputs_;
+  /* A map that associates the identifier of each input that is not realized on the operation
+   * domain with its translation in texels. Those are inputs whose realization is just a
+   * translation by a whole number of texels, which the shader does when loading them, instead of
+   * realizing them into an intermediate texture. See add_and_evaluate_input_processors. */
+  Map<std::string, int2> inputs_to_texel_translations_map_;
 
  public:
   /* Construct and compile a GPU material from the given shader compile unit and execution schedule
@@ -161,6 +167,11 @@ class ShaderOperation : public Operation {
   void compute_results_reference_counts(const Schedule &schedule);
 
  private:
+  /* Add the default input processors, except for realization of inputs whose realization is just
+   * a translation by a whole number of texels, which is done by the shader instead. See the
+   * inputs_to_texel_translations_map_ member for more information. */
+  void add_and_evaluate_input_processors() override;
+
   /* Bind the uniform buffer of the GPU material as well as any color band textures needed by the
    * GPU material.  The compiled shader of the material is given as an argument and assumed to be
    * bound. */
@@ -169,7 +180,8 @@ class ShaderOperation : public Operation {
   /* Bind the input results of the operation to the appropriate textures in the GPU material. The
    * attributes stored in output_to_material_attribute_map_ have names that match the texture
    * samplers in the shader as well as the identifiers of the operation inputs that they correspond
-   * to. The compiled shader of the material is given as an argument and assumed to be bound. */
+   * to. Additionally, set the offsets used to load the inputs that are not realized. The compiled
+   * shader of the material is given as an argument and assumed to be bound. */
   void bind_inputs(GPUShader *shader);
 
   /* Bind the output results of the operation to the appropriate images in the GPU material. The
@@ -89,6 +89,19 @@ float Context::get_time() const
   return frame_number / frame_rate;
 }
 
+ResultPrecision Context::get_precision() const
+{
+  if (use_half_precision_fallback_) {
+    return ResultPrecision::Half;
+  }
+  return get_requested_precision();
+}
+
+void Context::set_half_precision_fallback(const bool use_half_precision_fallback)
+{
+  use_half_precision_fallback_ = use_half_precision_fallback;
+}
+
 GPUShader *Context::get_shader(const char *info_name, ResultPrecision precision)
 {
   return cache_manager().cached_shaders.get(info_name, precision);
@@ -6,6 +6,8 @@
 
 #include "DNA_node_types.h"
 
+#include "GPU_capabilities.hh"
+
 #include "NOD_derived_node_tree.hh"
 
 #include "COM_compile_state.hh"
@@ -84,6 +86,8 @@ void Evaluator::compile_and_evaluate()
     return;
   }
 
+  compute_half_precision_fallback();
+
   const Schedule schedule = compute_schedule(context_, *derived_node_tree_);
 
   CompileState compile_state(schedule);
@@ -110,6 +114,34 @@ void Evaluator::compile_and_evaluate()
   is_compiled_ = true;
 }
 
+void Evaluator::compute_half_precision_fallback()
+{
+  context_.set_half_precision_fallback(false);
+
+  if (context_.get_requested_precision() == ResultPrecision::Half || !GPU_mem_stats_supported()) {
+    return;
+  }
+
+  int total_memory_kb = 0;
+  int free_memory_kb = 0;
+  GPU_mem_stats_get(&total_memory_kb, &free_memory_kb);
+  if (free_memory_kb <= 0) {
+    return;
+  }
+
+  /* Full precision color results have four 32-bit channels. */
+  const int2 size = context_.get_compositing_region_size();
+  const int64_t result_memory = int64_t(size.x) * size.y * 4 * sizeof(float);
+  const int64_t needed_memory = result_memory * estimate_peak_number_of_needed_buffers(
+                                                    context_, *derived_node_tree_);
+  if (needed_memory <= int64_t(free_memory_kb) * 1024) {
+    return;
+  }
+
+  context_.set_half_precision_fallback(true);
+  context_.set_info_message("Compositor uses half precision to fit in GPU memory");
+}
+
 void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_state)
 {
   NodeOperation *operation = node->typeinfo->get_compositor_operation(context_, node);
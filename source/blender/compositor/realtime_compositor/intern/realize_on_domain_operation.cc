@@ -2,6 +2,9 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_math_matrix.hh"
+#include "BLI_math_vector.hh"
+
 #include "COM_algorithm_realize_on_domain.hh"
 #include "COM_context.hh"
 #include "COM_domain.hh"
@@ -74,4 +77,36 @@ SimpleOperation *RealizeOnDomainOperation::construct_if_needed(
   return new RealizeOnDomainOperation(context, operation_domain, input_descriptor.type);
 }
 
+std::optional<int2> RealizeOnDomainOperation::compute_texel_translation(
+    Result &input_result, const Domain &operation_domain)
+{
+  /* Wrapping repeats the input, and bicubic interpolation smooths it even at texel centers. */
+  const RealizationOptions &realization_options = input_result.get_realization_options();
+  if (realization_options.wrap_x || realization_options.wrap_y ||
+      realization_options.interpolation == Interpolation::Bicubic)
+  {
+    return std::nullopt;
+  }
+
+  /* The input must not be rotated or scaled relative to the domain. */
+  const float3x3 local_transformation = math::invert(operation_domain.transformation) *
+                                        input_result.domain().transformation;
+  if (!math::is_equal(float2x2(local_transformation), float2x2::identity(), 1e-5f)) {
+    return std::nullopt;
+  }
+
+  /* An input with an identity transformation is centered in the domain, so its lower left corner
+   * is offset by half the difference between their sizes, floored like in the realization
+   * shader. */
+  const int2 size_difference = operation_domain.size - input_result.domain().size;
+  const float2 translation = local_transformation.location() +
+                             math::floor(float2(size_difference) / 2.0f);
+  const float2 texel_translation = math::round(translation);
+  if (!math::is_equal(translation, texel_translation, 1e-3f)) {
+    return std::nullopt;
+  }
+
+  return int2(texel_translation);
+}
+
 }  // namespace blender::realtime_compositor
@@ -364,4 +364,21 @@ Schedule compute_schedule(const Context &context, const DerivedNodeTree &tree)
   return schedule;
 }
 
+int estimate_peak_number_of_needed_buffers(const Context &context, const DerivedNodeTree &tree)
+{
+  Stack<DNode> output_nodes;
+  add_output_nodes(context, tree, output_nodes);
+
+  const NeededBuffers needed_buffers = compute_number_of_needed_buffers(output_nodes);
+
+  /* The output nodes are evaluated one after the other, so the peak is that of the most demanding
+   * output node. */
+  int peak_number_of_buffers = 0;
+  while (!output_nodes.is_empty()) {
+    peak_number_of_buffers = std::max(peak_number_of_buffers,
+                                      needed_buffers.lookup(output_nodes.pop()));
+  }
+  return peak_number_of_buffers;
+}
+
 }  // namespace blender::realtime_compositor
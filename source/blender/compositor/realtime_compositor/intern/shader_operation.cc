@@ -8,8 +8,10 @@
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_customdata_types.h"
 
@@ -25,11 +27,15 @@
 #include "NOD_node_declaration.hh"
 
 #include "COM_context.hh"
+#include "COM_conversion_operation.hh"
 #include "COM_operation.hh"
+#include "COM_realize_on_domain_operation.hh"
+#include "COM_reduce_to_single_value_operation.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_node.hh"
 #include "COM_shader_operation.hh"
+#include "COM_simple_operation.hh"
 #include "COM_utilities.hh"
 
 #include <sstream>
@@ -134,14 +140,69 @@ void ShaderOperation::bind_material_resources(GPUShader *shader)
   }
 }
 
+void ShaderOperation::add_and_evaluate_input_processors()
+{
+  /* This follows the default implementation, see Operation::add_and_evaluate_input_processors. */
+  for (const StringRef identifier : inputs_to_linked_outputs_map_.keys()) {
+    SimpleOperation *single_value = ReduceToSingleValueOperation::construct_if_needed(
+        context(), get_input(identifier));
+    add_and_evaluate_input_processor(identifier, single_value);
+  }
+
+  for (const StringRef identifier : inputs_to_linked_outputs_map_.keys()) {
+    SimpleOperation *conversion = ConversionOperation::construct_if_needed(
+        context(), get_input(identifier), get_input_descriptor(identifier));
+    add_and_evaluate_input_processor(identifier, conversion);
+  }
+
+  for (const StringRef identifier : inputs_to_linked_outputs_map_.keys()) {
+    const Domain operation_domain = compute_domain();
+    SimpleOperation *realize_on_domain = RealizeOnDomainOperation::construct_if_needed(
+        context(), get_input(identifier), get_input_descriptor(identifier), operation_domain);
+    if (!realize_on_domain) {
+      continue;
+    }
+
+    /* Loading the input with an offset in the shader is much cheaper than writing and reading an
+     * intermediate texture, so skip the realization if it is just a translation. */
+    const std::optional<int2> texel_translation =
+        RealizeOnDomainOperation::compute_texel_translation(get_input(identifier),
+                                                            operation_domain);
+    if (texel_translation) {
+      delete realize_on_domain;
+      inputs_to_texel_translations_map_.add_new(identifier, *texel_translation);
+      continue;
+    }
+
+    add_and_evaluate_input_processor(identifier, realize_on_domain);
+  }
+}
+
 void ShaderOperation::bind_inputs(GPUShader *shader)
 {
   /* Attributes represents the inputs of the operation and their names match those of the inputs of
    * the operation as well as the corresponding texture samples in the shader. */
   ListBase attributes = GPU_material_attributes(material_);
+  if (BLI_listbase_is_empty(&attributes)) {
+    return;
+  }
+
+  /* The offset of each input is stored at the index of its attribute, see the
+   * generate_code_for_inputs method. */
+  Vector<int4> offsets;
   LISTBASE_FOREACH (GPUMaterialAttribute *, attribute, &attributes) {
     get_input(attribute->name).bind_as_texture(shader, attribute->name);
+
+    const int2 *texel_translation = inputs_to_texel_translations_map_.lookup_ptr(attribute->name);
+    offsets.append(texel_translation ? int4(texel_translation->x, texel_translation->y, 1, 0) :
+                                       int4(0));
   }
+
+  GPU_shader_uniform_int_ex(shader,
+                            GPU_shader_get_uniform(shader, "input_offsets"),
+                            4,
+                            offsets.size(),
+                            reinterpret_cast<const int *>(offsets.data()));
 }
 
 void ShaderOperation::bind_outputs(GPUShader *shader)
@@ -537,6 +598,12 @@ void ShaderOperation::generate_code_for_inputs(GPUMaterial *material,
     shader_create_info.sampler(0, ImageType::FLOAT_2D, attribute->name, Frequency::PASS);
   }
 
+  /* Add an offset for each of the inputs, which is used to load inputs that are not realized on
+   * the operation domain because their realization is a translation, see the bind_inputs
+   * method. */
+  shader_create_info.push_constant(
+      Type::IVEC4, "input_offsets", BLI_listbase_count(&attributes));
+
   /* Declare a struct called var_attrs that includes an appropriately typed member for each of the
    * inputs. The names of the members should be the letter v followed by the ID of the attribute
    * corresponding to the input. Such names are expected by the code generator. */
@@ -558,12 +625,15 @@ void ShaderOperation::generate_code_for_inputs(GPUMaterial *material,
   /* Initialize each member of the previously declared struct by loading its corresponding texture
    * with an appropriate swizzle for its type. */
   std::stringstream initialize_attributes;
+  int input_index = 0;
   LISTBASE_FOREACH (GPUMaterialAttribute *, attribute, &attributes) {
     const InputDescriptor &input_descriptor = get_input_descriptor(attribute->name);
     const std::string swizzle = glsl_swizzle_from_result_type(input_descriptor.type);
     initialize_attributes << "var_attrs.v" << attribute->id << " = "
-                          << "texture_load(" << attribute->name
-                          << ", ivec2(gl_GlobalInvocationID.xy))." << swizzle << ";\n";
+                          << "texture_load_input(" << attribute->name
+                          << ", ivec2(gl_GlobalInvocationID.xy), input_offsets[" << input_index
+                          << "])." << swizzle << ";\n";
+    input_index++;
   }
   initialize_attributes << "\n";
 
@@ -44,6 +44,18 @@ vec4 texture_load(sampler2D sampler_2d, ivec2 texel, vec4 fallback)
   return texelFetch(sampler_2d, texel, 0);
 }
 
+/* Load the texel of an input of a shader operation. If the z component of the given offset is not
+ * zero, the input was not realized on the domain of the operation because its realization is a
+ * translation by the xy components of the offset. So the texel is translated instead, and texels
+ * outside of the input are zero like in realized inputs. */
+vec4 texture_load_input(sampler2D sampler_2d, ivec2 texel, ivec4 offset)
+{
+  if (offset.z == 0) {
+    return texture_load(sampler_2d, texel);
+  }
+  return texture_load(sampler_2d, texel - offset.xy, vec4(0.0));
+}
+
 /* A shorthand for 2D textureSize with a zero LOD. */
 ivec2 texture_size(isampler2D sampler_2d)
 {
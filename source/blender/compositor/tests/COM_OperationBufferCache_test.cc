@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_rect.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_OperationBufferCache.h"
+
+namespace blender::compositor::tests {
+
+static std::unique_ptr<MemoryBuffer> create_buffer(const int width, const int height)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, 0, width, 0, height);
+  return std::make_unique<MemoryBuffer>(DataType::Color, rect);
+}
+
+TEST(OperationBufferCache, LookupAdded)
+{
+  OperationBufferCache cache(1024 * 1024);
+  EXPECT_EQ(cache.lookup(1), nullptr);
+
+  MemoryBuffer *buffer = cache.add(1, create_buffer(4, 4));
+  EXPECT_EQ(cache.lookup(1), buffer);
+  EXPECT_EQ(cache.lookup(2), nullptr);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(OperationBufferCache, FreeUnused)
+{
+  OperationBufferCache cache(1024 * 1024);
+  cache.add(1, create_buffer(4, 4));
+  cache.add(2, create_buffer(4, 4));
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 2);
+
+  /* Only the buffer used by the second execution is kept. */
+  cache.lookup(2);
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.lookup(1), nullptr);
+  EXPECT_NE(cache.lookup(2), nullptr);
+}
+
+TEST(OperationBufferCache, FreeOverMemoryLimit)
+{
+  const size_t buffer_memory = sizeof(float) * 4 * 16 * 16;
+  OperationBufferCache cache(buffer_memory * 2);
+  cache.add(1, create_buffer(16, 16));
+  cache.add(2, create_buffer(16, 16));
+  cache.add(3, create_buffer(16, 16));
+  cache.end_execution();
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(OperationBufferCache, HashBufferContent)
+{
+  std::unique_ptr<MemoryBuffer> a = create_buffer(8, 8);
+  std::unique_ptr<MemoryBuffer> b = create_buffer(8, 8);
+  const float color[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+  a->fill(a->get_rect(), color);
+  b->fill(b->get_rect(), color);
+
+  rcti area;
+  BLI_rcti_init(&area, 0, 4, 0, 4);
+  const Span<rcti> areas(&area, 1);
+  EXPECT_EQ(OperationBufferCache::hash_buffer_content(*a, areas),
+            OperationBufferCache::hash_buffer_content(*b, areas));
+
+  /* Pixels outside of the areas are not hashed. */
+  *b->get_elem(6, 6) = 1.0f;
+  EXPECT_EQ(OperationBufferCache::hash_buffer_content(*a, areas),
+            OperationBufferCache::hash_buffer_content(*b, areas));
+
+  *b->get_elem(1, 1) = 1.0f;
+  EXPECT_NE(OperationBufferCache::hash_buffer_content(*a, areas),
+            OperationBufferCache::hash_buffer_content(*b, areas));
+}
+
+}  // namespace blender::compositor::tests
@@ -237,6 +237,13 @@ void DEG_make_inactive(Depsgraph *depsgraph);
 /* Returns the number of times the graph has been evaluated. */
 uint64_t DEG_get_update_count(const Depsgraph *depsgraph);
 
+/**
+ * Returns a number that changes whenever evaluated copies of IDs are created again, or the
+ * relations are updated. Pointers into the evaluated data of IDs stay valid as long as it doesn't
+ * change, so it can be used to cache data like resolved RNA paths across evaluations.
+ */
+uint64_t DEG_get_copy_on_eval_count(const Depsgraph *depsgraph);
+
 /**
  * Disable the visibility optimization making it so IDs which affect hidden objects or disabled
  * modifiers are still evaluated.
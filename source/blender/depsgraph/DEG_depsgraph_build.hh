@@ -72,6 +72,15 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations of a single ID for update in all dependency graphs.
+ *
+ * Only dependencies of the ID itself are allowed to change (for example, after adding or removing
+ * a modifier or a constraint), which allows the graphs to rebuild nodes and relations of this ID
+ * only instead of the entire graph. Falls back to a full update when that is not possible.
+ */
+void DEG_relations_tag_update_id(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
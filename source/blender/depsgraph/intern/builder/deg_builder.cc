@@ -17,7 +17,9 @@
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_stack.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_action.h"
@@ -27,6 +29,7 @@
 #include "RNA_prototypes.hh"
 
 #include "intern/builder/deg_builder_cache.h"
+#include "intern/builder/deg_builder_inline_operations.h"
 #include "intern/builder/deg_builder_remove_noop.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
@@ -176,70 +179,92 @@ const char *DepsgraphBuilder::get_rna_path_relative_to_scene_camera(const Scene
 /** \name Builder Finalizer.
  * \{ */
 
+/* Finalize the build of the ID node, and get the recalc flags it is to be tagged with.
+ * Only modifies the given node, so it can be called for multiple nodes in parallel. */
+static int deg_graph_build_finalize_id_node(Depsgraph *graph, IDNode *id_node)
+{
+  const ID_Type id_type = id_node->id_type;
+  const ID *id_orig = id_node->id_orig;
+  id_node->finalize_build(graph);
+  int flag = 0;
+  /* Tag rebuild if special evaluation flags changed. */
+  if (id_node->eval_flags != id_node->previous_eval_flags) {
+    flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
+  }
+  /* Tag rebuild if the custom data mask changed. */
+  if (id_node->customdata_masks != id_node->previous_customdata_masks) {
+    flag |= ID_RECALC_GEOMETRY;
+  }
+  const bool is_expanded = deg_eval_copy_is_expanded(id_node->id_cow);
+  if (!is_expanded) {
+    flag |= ID_RECALC_SYNC_TO_EVAL;
+    /* This means ID is being added to the dependency graph first
+     * time, which is similar to "ob-visible-change" */
+    if (id_type == ID_OB) {
+      flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
+    }
+    if (id_type == ID_NT) {
+      flag |= ID_RECALC_NTREE_OUTPUT;
+    }
+  }
+  else if (id_type == ID_SCE) {
+    /* During undo the sequence strips might obtain a new session ID, which will disallow the
+     * audio handles to be re-used. Tag for the audio and sequence update to ensure the audio
+     * handles are open.
+     * NOTE: This is not something that should be required, and perhaps indicates a weakness in
+     * design somewhere else. For the cause of the problem check #117760. */
+    flag |= ID_RECALC_AUDIO | ID_RECALC_SEQUENCER_STRIPS;
+  }
+  /* Restore recalc flags from original ID, which could possibly contain recalc flags set by
+   * an operator and then were carried on by the undo system.
+   *
+   * Only do it for active dependency graph, because otherwise modifications to the original
+   * objects might keep affecting the render pipeline. For example, when a Python script is
+   * executed in headless mode it will tag original objects for recalculation, and the flag
+   * will never be reset to 0 because there is no active dependency graph (since the
+   * DEG_ids_clear_recalc() only clears original ID recalc flags for the active depsgraph.
+   *
+   * A bit of a safety is to also consider the accumulated recalc flags from the original
+   * data-block for the first evaluation of the data-block within an inactive graph. */
+  if (graph->is_active || !is_expanded) {
+    flag |= id_orig->recalc;
+  }
+  return flag;
+}
+
 void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
 {
   deg_graph_flush_visibility_flags(graph);
   deg_graph_remove_unused_noops(graph);
+  deg_graph_tag_inline_operations(graph);
+
+  /* Building the graph may also change evaluated data, like the channels of evaluated poses. */
+  graph->copy_on_eval_count++;
+
+  /* Finalizing the ID nodes only touches data owned by each of them, so it is done in parallel,
+   * which matters for graphs with a lot of objects. The tagging modifies data shared by the whole
+   * graph, and is done afterwards from a single thread. */
+  Array<int> id_node_flags(graph->id_nodes.size());
+  threading::parallel_for(graph->id_nodes.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      id_node_flags[i] = deg_graph_build_finalize_id_node(graph, graph->id_nodes[i]);
+    }
+  });
 
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
-  for (IDNode *id_node : graph->id_nodes) {
-    const ID_Type id_type = id_node->id_type;
-    ID *id_orig = id_node->id_orig;
-    id_node->finalize_build(graph);
-    int flag = 0;
-    /* Tag rebuild if special evaluation flags changed. */
-    if (id_node->eval_flags != id_node->previous_eval_flags) {
-      flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
-    }
-    /* Tag rebuild if the custom data mask changed. */
-    if (id_node->customdata_masks != id_node->previous_customdata_masks) {
-      flag |= ID_RECALC_GEOMETRY;
-    }
-    const bool is_expanded = deg_eval_copy_is_expanded(id_node->id_cow);
-    if (!is_expanded) {
-      flag |= ID_RECALC_SYNC_TO_EVAL;
-      /* This means ID is being added to the dependency graph first
-       * time, which is similar to "ob-visible-change" */
-      if (id_type == ID_OB) {
-        flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
-      }
-      if (id_type == ID_NT) {
-        flag |= ID_RECALC_NTREE_OUTPUT;
-      }
-    }
-    else {
-      if (id_type == ID_GR) {
-        /* Collection content might have changed (children collection might have been added or
-         * removed from the graph based on their inclusion and visibility flags). */
-        BKE_collection_object_cache_free(
-            nullptr, reinterpret_cast<Collection *>(id_node->id_cow), LIB_ID_CREATE_NO_DEG_TAG);
-      }
-      else if (id_type == ID_SCE) {
-        /* During undo the sequence strips might obtain a new session ID, which will disallow the
-         * audio handles to be re-used. Tag for the audio and sequence update to ensure the audio
-         * handles are open.
-         * NOTE: This is not something that should be required, and perhaps indicates a weakness in
-         * design somewhere else. For the cause of the problem check #117760. */
-        flag |= ID_RECALC_AUDIO | ID_RECALC_SEQUENCER_STRIPS;
-      }
-    }
-    /* Restore recalc flags from original ID, which could possibly contain recalc flags set by
-     * an operator and then were carried on by the undo system.
-     *
-     * Only do it for active dependency graph, because otherwise modifications to the original
-     * objects might keep affecting the render pipeline. For example, when a Python script is
-     * executed in headless mode it will tag original objects for recalculation, and the flag
-     * will never be reset to 0 because there is no active dependency graph (since the
-     * DEG_ids_clear_recalc() only clears original ID recalc flags for the active depsgraph.
-     *
-     * A bit of a safety is to also consider the accumulated recalc flags from the original
-     * data-block for the first evaluation of the data-block within an inactive graph. */
-    if (graph->is_active || !is_expanded) {
-      flag |= id_orig->recalc;
+  for (const int64_t i : graph->id_nodes.index_range()) {
+    IDNode *id_node = graph->id_nodes[i];
+    if (id_node->id_type == ID_GR && deg_eval_copy_is_expanded(id_node->id_cow)) {
+      /* Collection content might have changed (children collection might have been added or
+       * removed from the graph based on their inclusion and visibility flags). The cache of the
+       * parent collections is freed as well, so this is not done in parallel. */
+      BKE_collection_object_cache_free(
+          nullptr, reinterpret_cast<Collection *>(id_node->id_cow), LIB_ID_CREATE_NO_DEG_TAG);
     }
-    if (flag != 0) {
-      graph_id_tag_update(bmain, graph, id_node->id_orig, flag, DEG_UPDATE_SOURCE_RELATIONS);
+    if (id_node_flags[i] != 0) {
+      graph_id_tag_update(
+          bmain, graph, id_node->id_orig, id_node_flags[i], DEG_UPDATE_SOURCE_RELATIONS);
     }
   }
 }
@@ -98,7 +98,9 @@ void animated_property_cb(ID * /*id*/, FCurve *fcurve, void *data_v)
 
 }  // namespace
 
-AnimatedPropertyStorage::AnimatedPropertyStorage() : is_fully_initialized(false) {}
+AnimatedPropertyStorage::AnimatedPropertyStorage() : is_fully_initialized(false), id_session_uid(0)
+{
+}
 
 void AnimatedPropertyStorage::initializeFromID(DepsgraphBuilderCache *builder_cache, const ID *id)
 {
@@ -140,18 +142,35 @@ bool AnimatedPropertyStorage::isAnyPropertyAnimated(const PointerRNA *pointer_rn
 /* Builder cache itself. */
 
 DepsgraphBuilderCache::~DepsgraphBuilderCache()
+{
+  clear();
+}
+
+void DepsgraphBuilderCache::clear()
 {
   for (AnimatedPropertyStorage *animated_property_storage :
        animated_property_storage_map_.values())
   {
     delete animated_property_storage;
   }
+  animated_property_storage_map_.clear();
 }
 
 AnimatedPropertyStorage *DepsgraphBuilderCache::ensureAnimatedPropertyStorage(const ID *id)
 {
-  return animated_property_storage_map_.lookup_or_add_cb(
-      id, []() { return new AnimatedPropertyStorage(); });
+  AnimatedPropertyStorage *animated_property_storage =
+      animated_property_storage_map_.lookup_or_add_cb(
+          id, []() { return new AnimatedPropertyStorage(); });
+  if (animated_property_storage->id_session_uid != id->session_uid) {
+    /* Storage was left behind by a freed ID which happened to have the same address. */
+    if (animated_property_storage->id_session_uid != 0) {
+      delete animated_property_storage;
+      animated_property_storage = new AnimatedPropertyStorage();
+      animated_property_storage_map_.add_overwrite(id, animated_property_storage);
+    }
+    animated_property_storage->id_session_uid = id->session_uid;
+  }
+  return animated_property_storage;
 }
 
 AnimatedPropertyStorage *DepsgraphBuilderCache::ensureInitializedAnimatedPropertyStorage(
@@ -58,6 +58,10 @@ class AnimatedPropertyStorage {
   /* The storage is fully initialized from all F-Curves from corresponding ID. */
   bool is_fully_initialized;
 
+  /* Session UID of the ID the storage was created for. The cache outlives a single build, so an
+   * ID freed and re-allocated at the same address must not inherit stale animated properties. */
+  uint32_t id_session_uid;
+
   /* indexed by PointerRNA.data. */
   Set<const void *> animated_objects_set;
   Set<AnimatedPropertyID> animated_properties_set;
@@ -70,6 +74,9 @@ class DepsgraphBuilderCache {
  public:
   ~DepsgraphBuilderCache();
 
+  /* Forget all cached data, so that it gets re-initialized from the current state of IDs. */
+  void clear();
+
   /* Makes sure storage for animated properties exists and initialized for the given ID. */
   AnimatedPropertyStorage *ensureAnimatedPropertyStorage(const ID *id);
   AnimatedPropertyStorage *ensureInitializedAnimatedPropertyStorage(const ID *id);
@@ -0,0 +1,64 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/builder/deg_builder_inline_operations.h"
+
+#include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_operation.hh"
+
+#include "intern/depsgraph.hh"
+
+namespace blender::deg {
+
+/* Operations which only do a small fixed amount of work, regardless of the size of the data. */
+static bool is_cheap_operation(const OperationNode *op_node)
+{
+  switch (op_node->opcode) {
+    case OperationCode::ID_PROPERTY:
+    case OperationCode::PARAMETERS_ENTRY:
+    case OperationCode::PARAMETERS_EVAL:
+    case OperationCode::PARAMETERS_EXIT:
+    case OperationCode::VISIBILITY:
+    case OperationCode::HIERARCHY:
+    case OperationCode::OBJECT_FROM_LAYER_ENTRY:
+    case OperationCode::OBJECT_BASE_FLAGS:
+    case OperationCode::OBJECT_FROM_LAYER_EXIT:
+    case OperationCode::TRANSFORM_INIT:
+    case OperationCode::TRANSFORM_LOCAL:
+    case OperationCode::TRANSFORM_PARENT:
+    case OperationCode::TRANSFORM_EVAL:
+    case OperationCode::TRANSFORM_FINAL:
+    case OperationCode::GEOMETRY_EVAL_INIT:
+    case OperationCode::GEOMETRY_EVAL_DONE:
+    case OperationCode::POSE_DONE:
+    case OperationCode::BONE_LOCAL:
+    case OperationCode::BONE_POSE_PARENT:
+    case OperationCode::BONE_READY:
+    case OperationCode::BONE_DONE:
+    case OperationCode::SHADING_DONE:
+    case OperationCode::INSTANCER:
+    case OperationCode::INSTANCE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void deg_graph_tag_inline_operations(Depsgraph *graph)
+{
+  for (OperationNode *op_node : graph->operations) {
+    if (!op_node->is_noop() && is_cheap_operation(op_node)) {
+      op_node->flag |= DEPSOP_FLAG_EVAL_INLINE;
+    }
+    else {
+      op_node->flag &= ~DEPSOP_FLAG_EVAL_INLINE;
+    }
+  }
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,21 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+namespace blender::deg {
+
+struct Depsgraph;
+
+/* Tag operations which are cheap to evaluate, so that the evaluation engine runs them directly
+ * from the task of the operation which made them ready, instead of paying for a task of their
+ * own. This coalesces chains and sibling groups of cheap operations (such as bone transforms and
+ * parameters evaluation) into a single task. */
+void deg_graph_tag_inline_operations(Depsgraph *graph);
+
+}  // namespace blender::deg
@@ -16,8 +16,10 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_action_types.h"
@@ -110,6 +112,7 @@
 #include "intern/builder/deg_builder_rna.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_light_linking.hh"
+#include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_tag.hh"
 #include "intern/depsgraph_type.hh"
 #include "intern/eval/deg_eval_copy_on_write.h"
@@ -375,31 +378,37 @@ ID *DepsgraphNodeBuilder::ensure_cow_id(ID *id_orig)
 
 /* **** Build functions for entity nodes **** */
 
+void DepsgraphNodeBuilder::store_id_info(IDNode *id_node)
+{
+  /* It is possible that the ID does not need to have evaluated version in which case id_cow is
+   * the same as id_orig. Additionally, such ID might have been removed, which makes the check
+   * for whether id_cow is expanded to access freed memory. In order to deal with this we
+   * check whether an evaluated copy is needed based on a scalar value which does not lead to
+   * access of possibly deleted memory.
+   *
+   * The evaluated copy is kept even when it is not expanded (which is the case for dormant IDs),
+   * since other evaluated data-blocks might be pointing to it. */
+  IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+  if (deg_eval_copy_is_needed(id_node->id_type) && id_node->id_orig != id_node->id_cow) {
+    id_info->id_cow = id_node->id_cow;
+  }
+  else {
+    id_info->id_cow = nullptr;
+  }
+  id_info->previously_visible_components_mask = id_node->visible_components_mask;
+  id_info->previous_eval_flags = id_node->eval_flags;
+  id_info->previous_customdata_masks = id_node->customdata_masks;
+  BLI_assert(!id_info_hash_.contains(id_node->id_orig_session_uid));
+  id_info_hash_.add_new(id_node->id_orig_session_uid, id_info);
+  id_node->id_cow = nullptr;
+}
+
 void DepsgraphNodeBuilder::begin_build()
 {
   /* Store existing evaluated versions of datablock, so we can re-use
    * them for new ID nodes. */
   for (IDNode *id_node : graph_->id_nodes) {
-    /* It is possible that the ID does not need to have evaluated version in which case id_cow is
-     * the same as id_orig. Additionally, such ID might have been removed, which makes the check
-     * for whether id_cow is expanded to access freed memory. In order to deal with this we
-     * check whether an evaluated copy is needed based on a scalar value which does not lead to
-     * access of possibly deleted memory. */
-    IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
-    if (deg_eval_copy_is_needed(id_node->id_type) && deg_eval_copy_is_expanded(id_node->id_cow) &&
-        id_node->id_orig != id_node->id_cow)
-    {
-      id_info->id_cow = id_node->id_cow;
-    }
-    else {
-      id_info->id_cow = nullptr;
-    }
-    id_info->previously_visible_components_mask = id_node->visible_components_mask;
-    id_info->previous_eval_flags = id_node->eval_flags;
-    id_info->previous_customdata_masks = id_node->customdata_masks;
-    BLI_assert(!id_info_hash_.contains(id_node->id_orig_session_uid));
-    id_info_hash_.add_new(id_node->id_orig_session_uid, id_info);
-    id_node->id_cow = nullptr;
+    store_id_info(id_node);
   }
 
   for (const OperationNode *op_node : graph_->entry_tags) {
@@ -418,6 +427,111 @@ void DepsgraphNodeBuilder::begin_build()
   graph_->entry_tags.clear();
 }
 
+void DepsgraphNodeBuilder::begin_build_incremental(Span<IDNode *> id_nodes)
+{
+  /* Setup the same building context as the view layer builder. */
+  scene_ = graph_->scene;
+  view_layer_ = graph_->view_layer;
+  view_layer_index_ = 0;
+
+  Set<const Node *> removed_operations;
+  for (IDNode *id_node : id_nodes) {
+    IncrementalIDState state;
+    state.linked_state = id_node->linked_state;
+    state.is_visible_on_build = id_node->is_visible_on_build;
+    state.has_base = id_node->has_base;
+    state.is_user_modified = id_node->is_user_modified;
+    state.eval_flags = id_node->eval_flags;
+    state.customdata_masks = id_node->customdata_masks;
+    incremental_id_states_.add_new(id_node->id_orig_session_uid, state);
+
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        removed_operations.add(op_node);
+        if (graph_->entry_tags.contains(op_node)) {
+          saved_entry_tags_.append_as(op_node);
+        }
+        if (op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) {
+          needs_update_operations_.append_as(op_node);
+        }
+      }
+    }
+  }
+
+  /* Relations between the removed operations are freed together with the nodes, the ones which
+   * connect them to the rest of the graph need to be unlinked first. */
+  Vector<Relation *> relations_to_remove;
+  for (const Node *node : removed_operations) {
+    for (Relation *rel : node->inlinks) {
+      if (!removed_operations.contains(rel->from)) {
+        relations_to_remove.append(rel);
+      }
+    }
+    for (Relation *rel : node->outlinks) {
+      if (!removed_operations.contains(rel->to)) {
+        relations_to_remove.append(rel);
+      }
+    }
+  }
+  for (Relation *rel : relations_to_remove) {
+    rel->unlink();
+    delete rel;
+  }
+
+  graph_->operations.remove_if(
+      [&](OperationNode *op_node) { return removed_operations.contains(op_node); });
+  graph_->entry_tags.remove_if(
+      [&](OperationNode *op_node) { return removed_operations.contains(op_node); });
+
+  for (IDNode *id_node : id_nodes) {
+    store_id_info(id_node);
+    graph_->id_hash.remove(id_node->id_orig);
+    graph_->id_nodes.remove(graph_->id_nodes.first_index_of(id_node));
+    delete id_node;
+  }
+
+  /* Nodes of all the other IDs are kept as-is. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
+void DepsgraphNodeBuilder::rebuild_object(Object *object)
+{
+  const IncrementalIDState &state = incremental_id_states_.lookup(object->id.session_uid);
+
+  int base_index = -1;
+  if (state.has_base) {
+    /* Find the index of the base the same way as #build_view_layer does. */
+    int index = 0;
+    BKE_view_layer_synced_ensure(scene_, view_layer_);
+    LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer_)) {
+      if (!need_pull_base_into_graph(base)) {
+        continue;
+      }
+      if (base->object == object) {
+        base_index = index;
+        break;
+      }
+      index++;
+    }
+  }
+
+  build_object(base_index, object, state.linked_state, state.is_visible_on_build);
+
+  IDNode *id_node = find_id_node(&object->id);
+  id_node->linked_state = max(id_node->linked_state, state.linked_state);
+  id_node->is_visible_on_build |= state.is_visible_on_build;
+  id_node->has_base |= state.has_base;
+  id_node->is_user_modified |= state.is_user_modified;
+  id_node->eval_flags |= state.eval_flags;
+  id_node->customdata_masks |= state.customdata_masks;
+
+  if (base_index != -1 && !graph_->has_animated_visibility) {
+    graph_->has_animated_visibility |= is_object_visibility_animated(object);
+  }
+}
+
 /* Util callbacks for `BKE_library_foreach_ID_link`, used to detect when an evaluated ID is using
  * ID pointers that are either:
  *  - evaluated ID pointers that do not exist anymore in current depsgraph.
@@ -428,41 +542,31 @@ void DepsgraphNodeBuilder::begin_build()
  * NOTE: This is split in two, a static function and a public method of the node builder, to allow
  * the code to access the builder's data more easily. */
 
-int DepsgraphNodeBuilder::foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self,
-                                                                         ID *id_pointer)
+bool DepsgraphNodeBuilder::check_id_cow_pointer_needs_update(ID *id_pointer)
 {
   if (id_pointer->orig_id == nullptr) {
-    /* `id_cow_self` uses a non-cow ID, if that ID has an evaluated copy in current depsgraph its
-     * owner needs to be remapped, i.e. copy-on-eval-flushed. */
+    /* The user of `id_pointer` uses a non-cow ID, if that ID has an evaluated copy in current
+     * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
     IDNode *id_node = find_id_node(id_pointer);
-    if (id_node != nullptr && id_node->id_cow != nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
+    return id_node != nullptr && id_node->id_cow != nullptr;
   }
-  else {
-    /* `id_cow_self` uses an evaluated ID, if that evaluated copy is removed from current depsgraph
-     * its owner needs to be remapped, i.e. copy-on-eval-flushed. */
-    /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
-     * of evaluated depsgraph are still valid pointers, they are freed later (typically during
-     * destruction of the builder itself). */
-    IDNode *id_node = find_id_node(id_pointer->orig_id);
-    if (id_node == nullptr) {
-      graph_id_tag_update(bmain_,
-                          graph_,
-                          id_cow_self->orig_id,
-                          ID_RECALC_SYNC_TO_EVAL,
-                          DEG_UPDATE_SOURCE_RELATIONS);
-      return IDWALK_RET_STOP_ITER;
-    }
-  }
-  return IDWALK_RET_NOP;
+  /* The user of `id_pointer` uses an evaluated ID, if that evaluated copy is removed from current
+   * depsgraph its owner needs to be remapped, i.e. copy-on-eval-flushed. */
+  /* NOTE: at that stage, old existing evaluated copies that are to be removed from current state
+   * of evaluated depsgraph are still valid pointers, they are freed later (typically during
+   * destruction of the builder itself). */
+  return find_id_node(id_pointer->orig_id) == nullptr;
 }
 
+namespace {
+
+struct DetectNeedForUpdateData {
+  DepsgraphNodeBuilder *builder;
+  bool need_update = false;
+};
+
+}  // namespace
+
 static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackData *cb_data)
 {
   ID *id = *cb_data->id_pointer;
@@ -475,10 +579,12 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
     return IDWALK_RET_NOP;
   }
 
-  DepsgraphNodeBuilder *builder = static_cast<DepsgraphNodeBuilder *>(cb_data->user_data);
-  ID *id_cow_self = cb_data->self_id;
-
-  return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
+  DetectNeedForUpdateData *data = static_cast<DetectNeedForUpdateData *>(cb_data->user_data);
+  if (data->builder->check_id_cow_pointer_needs_update(id)) {
+    data->need_update = true;
+    return IDWALK_RET_STOP_ITER;
+  }
+  return IDWALK_RET_NOP;
 }
 
 void DepsgraphNodeBuilder::update_invalid_cow_pointers()
@@ -493,41 +599,58 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
-    if (id_node->previously_visible_components_mask == 0) {
-      /* Newly added node/ID, no need to check it. */
-      continue;
-    }
-    if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
-      /* Node/ID with no copy-on-eval data, no need to check it. */
-      continue;
-    }
-    if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
-      /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
-      continue;
+  /* Detection only reads the graph and the evaluated copies, so it is done for all IDs in
+   * parallel. The tagging modifies the graph, and is done afterwards from a single thread. */
+  threading::EnumerableThreadSpecific<Vector<ID *>> ids_to_update;
+  threading::parallel_for(graph_->id_nodes.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const IDNode *id_node = graph_->id_nodes[i];
+      if (id_node->previously_visible_components_mask == 0) {
+        /* Newly added node/ID, no need to check it. */
+        continue;
+      }
+      if (ELEM(id_node->id_cow, id_node->id_orig, nullptr)) {
+        /* Node/ID with no copy-on-eval data, no need to check it. */
+        continue;
+      }
+      if ((id_node->id_cow->recalc & ID_RECALC_SYNC_TO_EVAL) != 0) {
+        /* Node/ID already tagged for copy-on-eval flush, no need to check it. */
+        continue;
+      }
+      if ((id_node->id_cow->flag & LIB_EMBEDDED_DATA) != 0) {
+        /* For now, we assume embedded data are managed by their owner IDs and do not need to be
+         * checked here.
+         *
+         * NOTE: This exception somewhat weak, and ideally should not be needed. Currently
+         * however, embedded data are handled as full local (private) data of their owner IDs in
+         * part of Blender (like read/write code, including undo/redo), while depsgraph generally
+         * treat them as regular independent IDs. This leads to inconsistencies that can lead to
+         * bad level memory accesses.
+         *
+         * E.g. when undoing creation/deletion of a collection directly child of a scene's master
+         * collection, the scene itself is re-read in place, but its master collection becomes a
+         * completely new different pointer, and the existing copy-on-eval of the old master
+         * collection in the matching deg node is therefore pointing to fully invalid (freed)
+         * memory. */
+        continue;
+      }
+      DetectNeedForUpdateData data = {this};
+      BKE_library_foreach_ID_link(nullptr,
+                                  id_node->id_cow,
+                                  deg::foreach_id_cow_detect_need_for_update_callback,
+                                  &data,
+                                  IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
+      if (data.need_update) {
+        ids_to_update.local().append(id_node->id_orig);
+      }
     }
-    if ((id_node->id_cow->flag & LIB_EMBEDDED_DATA) != 0) {
-      /* For now, we assume embedded data are managed by their owner IDs and do not need to be
-       * checked here.
-       *
-       * NOTE: This exception somewhat weak, and ideally should not be needed. Currently however,
-       * embedded data are handled as full local (private) data of their owner IDs in part of
-       * Blender (like read/write code, including undo/redo), while depsgraph generally treat them
-       * as regular independent IDs. This leads to inconsistencies that can lead to bad level
-       * memory accesses.
-       *
-       * E.g. when undoing creation/deletion of a collection directly child of a scene's master
-       * collection, the scene itself is re-read in place, but its master collection becomes a
-       * completely new different pointer, and the existing copy-on-eval of the old master
-       * collection in the matching deg node is therefore pointing to fully invalid (freed) memory.
-       */
-      continue;
+  });
+
+  for (const Vector<ID *> &ids : ids_to_update) {
+    for (ID *id_orig : ids) {
+      graph_id_tag_update(
+          bmain_, graph_, id_orig, ID_RECALC_SYNC_TO_EVAL, DEG_UPDATE_SOURCE_RELATIONS);
     }
-    BKE_library_foreach_ID_link(nullptr,
-                                id_node->id_cow,
-                                deg::foreach_id_cow_detect_need_for_update_callback,
-                                this,
-                                IDWALK_IGNORE_EMBEDDED_ID | IDWALK_READONLY);
   }
 }
 
@@ -90,10 +90,23 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void end_build();
 
   /**
-   * `id_cow_self` is the user of `id_pointer`,
-   * see also `LibraryIDLinkCallbackData` struct definition.
+   * Prepare for re-building nodes of the given IDs only, keeping the rest of the graph.
+   *
+   * The ID nodes are removed from the graph together with all their relations. Their evaluated
+   * copies, tags and the state accumulated from builders of other IDs are stored so that they are
+   * carried over to the re-created nodes.
+   */
+  virtual void begin_build_incremental(Span<IDNode *> id_nodes);
+  /* Re-create nodes of an object removed from the graph by #begin_build_incremental(). */
+  virtual void rebuild_object(Object *object);
+
+  /**
+   * Check whether the evaluated copy which uses `id_pointer` needs to be copy-on-eval-flushed
+   * for its pointer to be remapped, see #update_invalid_cow_pointers().
+   *
+   * Only reads the graph, so it can be called from multiple threads.
    */
-  int foreach_id_cow_detect_need_for_update_callback(ID *id_cow_self, ID *id_pointer);
+  bool check_id_cow_pointer_needs_update(ID *id_pointer);
 
   IDNode *add_id_node(ID *id);
   IDNode *find_id_node(const ID *id);
@@ -288,6 +301,17 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
     DEGCustomDataMeshMasks previous_customdata_masks;
   };
 
+  /* State of an ID node removed by #begin_build_incremental() which is not coming from the
+   * builder of the ID itself, so it is to be applied on top of the re-created node. */
+  struct IncrementalIDState {
+    eDepsNode_LinkedState_Type linked_state;
+    bool is_visible_on_build;
+    bool has_base;
+    bool is_user_modified;
+    uint32_t eval_flags;
+    DEGCustomDataMeshMasks customdata_masks;
+  };
+
  protected:
   /* Entry tags and non-updated operations from the previous state of the dependency graph.
    * The entry tags are operations which were directly tagged, the matching operations from the
@@ -310,6 +334,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
                               bool is_reference,
                               void *user_data);
 
+  void store_id_info(IDNode *id_node);
   void tag_previously_tagged_nodes();
   /**
    * Check for IDs that need to be flushed (copy-on-eval-updated)
@@ -331,6 +356,9 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   /* Indexed by original ID.session_uid, values are IDInfo. */
   Map<uint, IDInfo *> id_info_hash_;
 
+  /* Indexed by original ID.session_uid, only filled in by #begin_build_incremental(). */
+  Map<uint, IncrementalIDState> incremental_id_states_;
+
   /* Set of IDs which were already build. Makes it easier to keep track of
    * what was already built and what was not. */
   BuilderMap built_map_;
@@ -72,6 +72,7 @@
 #include "BKE_image.h"
 #include "BKE_key.hh"
 #include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_material.h"
 #include "BKE_mball.hh"
@@ -202,6 +203,52 @@ bool object_particles_depends_on_time(Object *object)
   return false;
 }
 
+/* The F-Curve evaluates to the same value at any time. */
+bool fcurve_is_time_invariant(const FCurve *fcu)
+{
+  /* Modifiers (such as noise or cycles) can vary in time even on a flat curve. */
+  if (!BLI_listbase_is_empty(&fcu->modifiers)) {
+    return false;
+  }
+  if (fcu->bezt != nullptr) {
+    const float value = fcu->bezt[0].vec[1][1];
+    for (int i = 0; i < fcu->totvert; i++) {
+      /* With all the keys and their handles at the same value every interpolation and
+       * extrapolation mode gives this value. */
+      const BezTriple &bezt = fcu->bezt[i];
+      if (bezt.vec[0][1] != value || bezt.vec[1][1] != value || bezt.vec[2][1] != value) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (fcu->fpt != nullptr) {
+    const float value = fcu->fpt[0].vec[1];
+    for (int i = 0; i < fcu->totvert; i++) {
+      if (fcu->fpt[i].vec[1] != value) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return true;
+}
+
+/* All the F-Curves of the action evaluate to constant values. */
+bool action_is_time_invariant(bAction *dna_action)
+{
+  const animrig::Action &action = dna_action->wrap();
+  if (!action.is_action_legacy()) {
+    return false;
+  }
+  LISTBASE_FOREACH (const FCurve *, fcu, &dna_action->curves) {
+    if (!fcurve_is_time_invariant(fcu)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool check_id_has_anim_component(ID *id)
 {
   AnimData *adt = BKE_animdata_from_id(id);
@@ -375,7 +422,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return add_new_relation(timesrc, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -390,6 +437,25 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
   return nullptr;
 }
 
+Relation *DepsgraphRelationBuilder::add_new_relation(Node *node_from,
+                                                     Node *node_to,
+                                                     const char *description,
+                                                     int flags)
+{
+  const ID *owner_id = stack_.current_id();
+  const uint owner_session_uid = owner_id ? owner_id->session_uid : MAIN_ID_SESSION_UID_UNSET;
+  const int64_t num_outlinks = node_from->outlinks.size();
+  Relation *relation = graph_->add_new_relation(node_from, node_to, description, flags);
+  if (node_from->outlinks.size() != num_outlinks) {
+    relation->owner_session_uid = owner_session_uid;
+  }
+  else if (relation->owner_session_uid != owner_session_uid) {
+    /* The same relation is requested by builders of different IDs, so none of them owns it. */
+    relation->owner_session_uid = MAIN_ID_SESSION_UID_UNSET;
+  }
+  return relation;
+}
+
 void DepsgraphRelationBuilder::add_visibility_relation(ID *id_from, ID *id_to)
 {
   ComponentKey from_key(id_from, NodeType::VISIBILITY);
@@ -403,7 +469,7 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return add_new_relation(node_from, node_to, description, flags);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -517,6 +583,14 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+void DepsgraphRelationBuilder::begin_build_incremental(Span<IDNode *> unchanged_id_nodes)
+{
+  scene_ = graph_->scene;
+  for (IDNode *id_node : unchanged_id_nodes) {
+    built_map_.tagBuild(id_node->id_orig);
+  }
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -1613,6 +1687,12 @@ void DepsgraphRelationBuilder::build_animdata_curves(ID *id)
     ComponentKey action_key(&adt->action->id, NodeType::ANIMATION);
     add_relation(action_key, adt_key, "Action -> Animation");
   }
+  /* NLA strips map the time of their actions and have limited range, making the result depend on
+   * time even when the actions themselves are constant. */
+  if (graph_->mode == DAG_EVAL_RENDER && !BLI_listbase_is_empty(&adt->nla_tracks)) {
+    TimeSourceKey time_src_key;
+    add_relation(time_src_key, adt_key, "TimeSrc -> NLA");
+  }
   /* Get source operations. */
   Node *node_from = get_node(adt_key);
   BLI_assert(node_from != nullptr);
@@ -1652,8 +1732,7 @@ void DepsgraphRelationBuilder::build_animdata_fcurve_target(
     add_relation(adt_key, pose_init_key, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
     return;
   }
-  graph_->add_new_relation(
-      operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
+  add_new_relation(operation_from, operation_to, "Animation -> Prop", RELATION_CHECK_BEFORE_ADD);
   /* It is possible that animation is writing to a nested ID data-block,
    * need to make sure animation is evaluated after target ID is copied. */
   const IDNode *id_node_from = operation_from->owner->owner;
@@ -1851,11 +1930,22 @@ void DepsgraphRelationBuilder::build_action(bAction *dna_action)
   }
 #endif
 
-  if (!action.is_empty()) {
-    TimeSourceKey time_src_key;
-    ComponentKey animation_key(&dna_action->id, NodeType::ANIMATION);
-    add_relation(time_src_key, animation_key, "TimeSrc -> Animation");
+  if (action.is_empty()) {
+    return;
   }
+  /* For the render graphs, evaluation of actions which are constant in time is kept from the
+   * first frame for the entire frame sequence. This is not done for interactive graphs, as every
+   * keyframe edit would need relations update then. */
+  if (graph_->mode == DAG_EVAL_RENDER && action_is_time_invariant(dna_action)) {
+    IDNode *id_node = graph_->find_id_node(&dna_action->id);
+    if (id_node != nullptr) {
+      id_node->has_time_invariant_animation = true;
+      return;
+    }
+  }
+  TimeSourceKey time_src_key;
+  ComponentKey animation_key(&dna_action->id, NodeType::ANIMATION);
+  add_relation(time_src_key, animation_key, "TimeSrc -> Animation");
 }
 
 void DepsgraphRelationBuilder::build_driver(ID *id, FCurve *fcu)
@@ -3541,6 +3631,8 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
     return;
   }
 
+  const BuilderStack::ScopedEntry stack_entry = stack_.trace(*id_orig);
+
   OperationKey copy_on_write_key(id_orig, NodeType::COPY_ON_EVAL, OperationCode::COPY_ON_EVAL);
   /* XXX: This is a quick hack to make Alt-A to work. */
   // add_relation(time_source_key, copy_on_write_key, "Fluxgate capacitor hack");
@@ -3595,7 +3687,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
      * copy of ID. */
     OperationNode *op_entry = comp_node->get_entry_operation();
     if (op_entry != nullptr) {
-      Relation *rel = graph_->add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
+      Relation *rel = add_new_relation(op_cow, op_entry, "Copy-on-Eval Dependency");
       rel->flag |= rel_flag;
     }
     /* All dangling operations should also be executed after copy-on-evaluation. */
@@ -3604,7 +3696,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
         continue;
       }
       if (op_node->inlinks.is_empty()) {
-        Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
+        Relation *rel = add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
         rel->flag |= rel_flag;
       }
       else {
@@ -3620,7 +3712,7 @@ void DepsgraphRelationBuilder::build_copy_on_write_relations(IDNode *id_node)
           }
         }
         if (!has_same_comp_dependency) {
-          Relation *rel = graph_->add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
+          Relation *rel = add_new_relation(op_cow, op_node, "Copy-on-Eval Dependency");
           rel->flag |= rel_flag;
         }
       }
@@ -86,6 +86,9 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /* Prepare for building relations of some IDs only, on top of the existing relations. Relations
+   * of the given ID nodes are considered to be up to date and are not built again. */
+  void begin_build_incremental(Span<IDNode *> unchanged_id_nodes);
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -310,6 +313,12 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
                                    const char *description,
                                    int flags = 0);
 
+  /* Add relation to the graph, marking it as owned by the ID which is currently being built. */
+  Relation *add_new_relation(Node *node_from,
+                             Node *node_to,
+                             const char *description,
+                             int flags = 0);
+
   template<typename KeyType>
   DepsNodeHandle create_node_handle(const KeyType &key, const char *default_name = "");
 
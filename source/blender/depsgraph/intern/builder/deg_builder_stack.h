@@ -115,6 +115,17 @@ class BuilderStack {
     return stack_.is_empty();
   }
 
+  /* Get the innermost ID which is being built, nullptr if the stack has no ID entry. */
+  const ID *current_id() const
+  {
+    for (int64_t i = stack_.size() - 1; i >= 0; i--) {
+      if (stack_[i].id_ != nullptr) {
+        return stack_[i].id_;
+      }
+    }
+    return nullptr;
+  }
+
   void print_backtrace(std::ostream &stream);
 
   template<class... Args> ScopedEntry trace(const Args &...args)
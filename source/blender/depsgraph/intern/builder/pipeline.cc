@@ -21,7 +21,8 @@ AbstractBuilderPipeline::AbstractBuilderPipeline(::Depsgraph *graph)
     : deg_graph_(reinterpret_cast<Depsgraph *>(graph)),
       bmain_(deg_graph_->bmain),
       scene_(deg_graph_->scene),
-      view_layer_(deg_graph_->view_layer)
+      view_layer_(deg_graph_->view_layer),
+      builder_cache_(*deg_graph_->builder_cache)
 {
 }
 
@@ -92,6 +93,9 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->relations_update_ids.clear();
+  /* Timing of the operations is to be gathered again to prioritize their scheduling. */
+  deg_graph_->need_update_critical_path = true;
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
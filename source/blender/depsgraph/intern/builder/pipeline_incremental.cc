@@ -0,0 +1,307 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "pipeline_incremental.h"
+
+#include "BLI_listbase.h"
+#include "BLI_time.h"
+
+#include "BKE_collision.h"
+#include "BKE_effect.h"
+#include "BKE_global.hh"
+#include "BKE_modifier.hh"
+
+#include "DNA_object_force_types.h"
+#include "DNA_object_types.h"
+
+#include "DEG_depsgraph_physics.hh"
+
+#include "intern/builder/deg_builder_key.h"
+#include "intern/builder/deg_builder_nodes.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+#include "intern/node/deg_node_time.hh"
+
+namespace blender::deg {
+
+namespace {
+
+/* Relation which connects a re-built ID with the rest of the graph, and which was added by a
+ * builder of another ID. Such relations are not re-created by building the ID again. */
+struct SavedRelation {
+  std::optional<PersistentOperationKey> from;
+  PersistentOperationKey to;
+  const char *name;
+  int flag;
+  unsigned int owner_session_uid;
+};
+
+bool object_has_physics(const Object *object)
+{
+  if (object->pd != nullptr && object->pd->forcefield != 0) {
+    return true;
+  }
+  if (object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr) {
+    return true;
+  }
+  if (!BLI_listbase_is_empty(&object->particlesystem)) {
+    return true;
+  }
+  for (const ModifierType type : {eModifierType_Collision,
+                                  eModifierType_Fluid,
+                                  eModifierType_DynamicPaint,
+                                  eModifierType_Surface})
+  {
+    if (BKE_modifiers_findby_type(object, type) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool object_in_physics_relations(const Depsgraph *graph, const Object *object)
+{
+  for (int i = 0; i < DEG_PHYSICS_RELATIONS_NUM; i++) {
+    const Map<const ID *, ListBase *> *hash = graph->physics_relations[i];
+    if (hash == nullptr) {
+      continue;
+    }
+    for (const ListBase *relations : hash->values()) {
+      if (i == DEG_PHYSICS_EFFECTOR) {
+        LISTBASE_FOREACH (const EffectorRelation *, relation, relations) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+      else {
+        LISTBASE_FOREACH (const CollisionRelation *, relation, relations) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/* Same as #DepsgraphRelationBuilder::find_node, without reporting missing nodes. */
+OperationNode *find_operation_node(const Depsgraph *graph, const OperationKey &key)
+{
+  IDNode *id_node = graph->find_id_node(key.id);
+  if (id_node == nullptr) {
+    return nullptr;
+  }
+  ComponentNode *comp_node = id_node->find_component(key.component_type, key.component_name);
+  if (comp_node == nullptr) {
+    return nullptr;
+  }
+  return comp_node->find_operation(key.opcode, key.name, key.name_tag);
+}
+
+}  // namespace
+
+IncrementalBuilderPipeline::IncrementalBuilderPipeline(::Depsgraph *graph, Span<ID *> ids)
+    : AbstractBuilderPipeline(graph), ids_(ids)
+{
+}
+
+bool IncrementalBuilderPipeline::can_rebuild_id_node(const IDNode *id_node) const
+{
+  if (id_node->id_type != ID_OB) {
+    return false;
+  }
+  /* Objects from set scenes are built with a different scene and view layer. */
+  if (id_node->linked_state == DEG_ID_LINKED_VIA_SET) {
+    return false;
+  }
+  /* Particle systems and physics have dependencies which are shared with other objects in the
+   * scene (collider and effector lists), rebuilding those requires a full update. */
+  if (id_node->find_component(NodeType::PARTICLE_SYSTEM) != nullptr) {
+    return false;
+  }
+  const Object *object = reinterpret_cast<const Object *>(id_node->id_orig);
+  if (object->light_linking != nullptr || object_has_physics(object) ||
+      object_in_physics_relations(deg_graph_, object))
+  {
+    return false;
+  }
+  return true;
+}
+
+bool IncrementalBuilderPipeline::build_incremental()
+{
+  if (deg_graph_->is_render_pipeline_depsgraph ||
+      deg_graph_->light_linking_cache.has_light_linking())
+  {
+    return false;
+  }
+  for (ID *id : ids_) {
+    /* The look-up is done by pointer, so that there is no access to the possibly freed memory of
+     * an ID which is not in the graph anymore. */
+    IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr || !can_rebuild_id_node(id_node)) {
+      return false;
+    }
+    rebuilt_id_nodes_.append(id_node);
+  }
+
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = BLI_time_now_seconds();
+  }
+
+  Set<unsigned int> rebuilt_session_uids;
+  Set<const Node *> rebuilt_operations;
+  for (IDNode *id_node : rebuilt_id_nodes_) {
+    rebuilt_session_uids.add(id_node->id_orig_session_uid);
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        rebuilt_operations.add(op_node);
+      }
+    }
+  }
+
+  /* Store relations which are not going to be re-created by the builders. Do it before any
+   * modification of the graph, so that it is still possible to fall back to a full rebuild. */
+  Vector<SavedRelation> saved_relations;
+  for (const Node *node : rebuilt_operations) {
+    const OperationNode *op_node = static_cast<const OperationNode *>(node);
+    for (const Relation *rel : op_node->inlinks) {
+      if (rebuilt_operations.contains(rel->from) ||
+          rebuilt_session_uids.contains(rel->owner_session_uid))
+      {
+        continue;
+      }
+      if (rel->from == deg_graph_->time_source) {
+        saved_relations.append(
+            {std::nullopt, op_node, rel->name, rel->flag, rel->owner_session_uid});
+      }
+      else if (rel->from->type == NodeType::OPERATION) {
+        saved_relations.append({static_cast<const OperationNode *>(rel->from),
+                                op_node,
+                                rel->name,
+                                rel->flag,
+                                rel->owner_session_uid});
+      }
+      else {
+        return false;
+      }
+    }
+    for (const Relation *rel : op_node->outlinks) {
+      if (rebuilt_operations.contains(rel->to) ||
+          rebuilt_session_uids.contains(rel->owner_session_uid))
+      {
+        continue;
+      }
+      if (rel->to->type != NodeType::OPERATION) {
+        return false;
+      }
+      saved_relations.append({op_node,
+                              static_cast<const OperationNode *>(rel->to),
+                              rel->name,
+                              rel->flag & ~RELATION_FLAG_CYCLIC,
+                              rel->owner_session_uid});
+    }
+  }
+
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (!rebuilt_id_nodes_.contains(id_node)) {
+      unchanged_id_nodes_.append(id_node);
+      /* Avoid re-tagging of the IDs which are not affected by the update. */
+      id_node->previous_eval_flags = id_node->eval_flags;
+      id_node->previous_customdata_masks = id_node->customdata_masks;
+      id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    }
+  }
+
+  /* Nodes. */
+  {
+    unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+    node_builder->begin_build_incremental(rebuilt_id_nodes_);
+    build_nodes(*node_builder);
+    node_builder->end_build();
+  }
+  /* The removed nodes are not to be accessed anymore. */
+  rebuilt_id_nodes_.clear();
+
+  /* Relations. */
+  {
+    unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+    relation_builder->begin_build_incremental(unchanged_id_nodes_);
+    build_relations(*relation_builder);
+
+    for (const SavedRelation &saved_relation : saved_relations) {
+      Node *from = deg_graph_->time_source;
+      if (saved_relation.from) {
+        from = find_operation_node(deg_graph_, *saved_relation.from);
+      }
+      OperationNode *to = find_operation_node(deg_graph_, saved_relation.to);
+      if (from == nullptr || to == nullptr) {
+        /* Dependency of another ID on an operation which does not exist anymore. The graph is
+         * already modified at this point, so the full rebuild is to be done from scratch. */
+        deg_graph_->relations_update_ids.clear();
+        return false;
+      }
+      Relation *rel = deg_graph_->add_new_relation(
+          from, to, saved_relation.name, saved_relation.flag | RELATION_CHECK_BEFORE_ADD);
+      rel->owner_session_uid = saved_relation.owner_session_uid;
+    }
+
+    Set<const IDNode *> unchanged_id_nodes_set;
+    unchanged_id_nodes_set.add_multiple(unchanged_id_nodes_);
+    for (IDNode *id_node : deg_graph_->id_nodes) {
+      if (!unchanged_id_nodes_set.contains(id_node)) {
+        relation_builder->build_copy_on_write_relations(id_node);
+        relation_builder->build_driver_relations(id_node);
+      }
+    }
+  }
+
+  /* Cycles are detected again for the whole graph. */
+  for (OperationNode *op_node : deg_graph_->operations) {
+    for (Relation *rel : op_node->outlinks) {
+      rel->flag &= ~RELATION_FLAG_CYCLIC;
+    }
+  }
+  for (Relation *rel : deg_graph_->time_source->outlinks) {
+    rel->flag &= ~RELATION_FLAG_CYCLIC;
+  }
+
+  build_step_finalize();
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph updated incrementally in %f seconds.\n",
+           BLI_time_now_seconds() - start_time);
+  }
+  return true;
+}
+
+void IncrementalBuilderPipeline::build_nodes(DepsgraphNodeBuilder &node_builder)
+{
+  for (ID *id : ids_) {
+    node_builder.rebuild_object(reinterpret_cast<Object *>(id));
+  }
+}
+
+void IncrementalBuilderPipeline::build_relations(DepsgraphRelationBuilder &relation_builder)
+{
+  for (ID *id : ids_) {
+    Object *object = reinterpret_cast<Object *>(id);
+    const IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node->has_base) {
+      relation_builder.build_object_from_view_layer_base(object);
+    }
+    else {
+      relation_builder.build_object(object);
+    }
+  }
+}
+
+}  // namespace blender::deg
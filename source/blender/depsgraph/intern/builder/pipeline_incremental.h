@@ -0,0 +1,47 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "pipeline.h"
+
+namespace blender::deg {
+
+class IDNode;
+
+/* Builder which updates an already built view layer dependency graph after dependencies of some
+ * of its objects have changed.
+ *
+ * Nodes and relations of the given objects are removed from the graph and built again, the rest
+ * of the graph is kept as-is. Relations which were added by builders of other IDs and point to or
+ * from the re-built objects are carried over to their re-created nodes.
+ *
+ * Only simple and common cases are supported (such as adding or removing a modifier or a
+ * constraint), #build_incremental() returns false when the graph is to be fully rebuilt. */
+class IncrementalBuilderPipeline : public AbstractBuilderPipeline {
+  Span<ID *> ids_;
+
+ public:
+  IncrementalBuilderPipeline(::Depsgraph *graph, Span<ID *> ids);
+
+  /* Returns false if the incremental update is not possible. The graph stays unmodified in this
+   * case and is to be rebuilt with #ViewLayerBuilderPipeline. */
+  bool build_incremental();
+
+ protected:
+  virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
+  virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+ private:
+  bool can_rebuild_id_node(const IDNode *id_node) const;
+
+  Vector<IDNode *> rebuilt_id_nodes_;
+  Vector<IDNode *> unchanged_id_nodes_;
+};
+
+}  // namespace blender::deg
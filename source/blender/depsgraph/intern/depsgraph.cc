@@ -26,6 +26,7 @@
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_debug.hh"
 
+#include "intern/builder/deg_builder_cache.h"
 #include "intern/depsgraph_physics.hh"
 #include "intern/depsgraph_registry.hh"
 #include "intern/depsgraph_relation.hh"
@@ -49,6 +50,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       has_animated_visibility(false),
       need_update_relations(true),
       need_update_nodes_visibility(true),
+      need_update_critical_path(true),
       need_tag_id_on_graph_visibility_update(true),
       need_tag_id_on_graph_visibility_time_update(false),
       bmain(bmain),
@@ -63,7 +65,8 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false),
-      update_count(0)
+      update_count(0),
+      copy_on_eval_count(0)
 {
   BLI_spin_init(&lock);
   memset(id_type_updated, 0, sizeof(id_type_updated));
@@ -71,6 +74,8 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
   memset(id_type_exist, 0, sizeof(id_type_exist));
   memset(physics_relations, 0, sizeof(physics_relations));
 
+  builder_cache = std::make_unique<DepsgraphBuilderCache>();
+
   add_time_source();
 }
 
@@ -352,3 +357,9 @@ uint64_t DEG_get_update_count(const Depsgraph *depsgraph)
   const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
   return deg_graph->update_count;
 }
+
+uint64_t DEG_get_copy_on_eval_count(const Depsgraph *depsgraph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  return deg_graph->copy_on_eval_count;
+}
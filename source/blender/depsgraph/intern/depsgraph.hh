@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <stdlib.h>
 
@@ -37,6 +39,7 @@ struct ViewLayer;
 
 namespace blender::deg {
 
+class DepsgraphBuilderCache;
 struct IDNode;
 struct Node;
 struct OperationNode;
@@ -97,10 +100,18 @@ struct Depsgraph {
 
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
+  /* IDs for which relations are to be updated, see #DEG_relations_tag_update_id.
+   * When empty while #need_update_relations is set the entire graph is to be rebuilt. */
+  Set<ID *> relations_update_ids;
 
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
 
+  /* Indicates whether operation timings are to be gathered on the next evaluation to update the
+   * critical path used for scheduling priority. Set when the graph is built, since the newly
+   * created operations have no timing information yet. */
+  bool need_update_critical_path;
+
   /* Indicated whether IDs in this graph are to be tagged as if they first appear visible, with
    * an optional tag for their animation (time) update. */
   bool need_tag_id_on_graph_visibility_update;
@@ -175,9 +186,18 @@ struct Depsgraph {
 
   light_linking::Cache light_linking_cache;
 
+  /* Animated property lookups done while building relations. Kept across relations updates, so
+   * that rebuilding after changes which do not touch animation (collection exclusion, visibility
+   * toggles) does not walk all F-Curves again. Cleared when any non-scene ID is edited. */
+  std::unique_ptr<DepsgraphBuilderCache> builder_cache;
+
   /* The number of times this graph has been evaluated. */
   uint64_t update_count;
 
+  /* The number of times evaluated copies of IDs were created or the relations were updated. It is
+   * changed while copying IDs from multiple threads, see #DEG_get_copy_on_eval_count. */
+  mutable std::atomic<uint64_t> copy_on_eval_count;
+
   /**
    * Stores functions that can be called after depsgraph evaluation to writeback some changes to
    * original data. Also see `DEG_depsgraph_writeback_sync.hh`.
@@ -35,6 +35,7 @@
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_collection.h"
 #include "builder/pipeline_from_ids.h"
+#include "builder/pipeline_incremental.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
 
@@ -288,6 +289,8 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update_relations = true;
+  /* Full update of relations supersedes any pending update of individual IDs. */
+  deg_graph->relations_update_ids.clear();
 
   /* NOTE: When relations are updated, it's quite possible that we've got new bases in the scene.
    * This means, we need to re-create flat array of bases in view layer. */
@@ -311,9 +314,38 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (!deg_graph->relations_update_ids.is_empty()) {
+    const blender::Vector<ID *> ids(deg_graph->relations_update_ids.begin(),
+                                    deg_graph->relations_update_ids.end());
+    deg::IncrementalBuilderPipeline builder(graph, ids);
+    if (builder.build_incremental()) {
+      return;
+    }
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
+void DEG_relations_tag_update_id(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *deg_graph : deg::get_all_registered_graphs(bmain)) {
+    if (deg_graph->need_update_relations && deg_graph->relations_update_ids.is_empty()) {
+      /* Full rebuild of relations is already pending. */
+      continue;
+    }
+    deg_graph->relations_update_ids.add(id);
+    deg_graph->need_update_relations = true;
+    deg::IDNode *id_node = deg_graph->find_id_node(&deg_graph->scene->id);
+    if (id_node != nullptr) {
+      graph_id_tag_update(bmain,
+                          deg_graph,
+                          &deg_graph->scene->id,
+                          ID_RECALC_BASE_FLAGS | ID_RECALC_HIERARCHY,
+                          deg::DEG_UPDATE_SOURCE_RELATIONS);
+    }
+  }
+}
+
 void DEG_relations_tag_update(Main *bmain)
 {
   DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations for update.\n", __func__);
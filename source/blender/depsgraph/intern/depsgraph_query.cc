@@ -67,6 +67,9 @@ static const ID *get_evaluated_id(const Depsgraph *deg_graph, const ID *id)
   if (id_node == nullptr) {
     return id;
   }
+  if (id_node->is_dormant) {
+    deg_eval_copy_ensure_dormant(deg_graph, id_node);
+  }
   return id_node->id_cow;
 }
 
@@ -424,6 +424,12 @@ static void DEG_iterator_ids_step(BLI_Iterator *iter, deg::IDNode *id_node, bool
     return;
   }
 
+  /* Dormant IDs are not evaluated, so their updates do not affect anything visible. */
+  if (only_updated && id_node->is_dormant) {
+    iter->skip = true;
+    return;
+  }
+
   if (only_updated && !(id_cow->recalc & ID_RECALC_ALL)) {
     /* Node-tree is considered part of the data-block. */
     bNodeTree *ntree = blender::bke::ntreeFromID(id_cow);
@@ -48,6 +48,12 @@ struct Relation {
   const char *name; /* label for debugging */
   int flag;         /* Bitmask of RelationFlag) */
 
+  /* Session UID of the ID whose builder added this relation, or MAIN_ID_SESSION_UID_UNSET when
+   * the relation is not owned by a single ID (added outside of an ID builder, or by multiple ID
+   * builders). Used to know which relations are to be re-created when only some of the IDs are
+   * rebuilt, see #IncrementalBuilderPipeline. */
+  unsigned int owner_session_uid;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("Relation");
 };
 
@@ -39,10 +39,12 @@
 #include "BKE_workspace.hh"
 
 #include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
 #include "DEG_depsgraph_debug.hh"
 #include "DEG_depsgraph_query.hh"
 
 #include "intern/builder/deg_builder.h"
+#include "intern/builder/deg_builder_cache.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_registry.hh"
 #include "intern/depsgraph_update.hh"
@@ -716,6 +718,21 @@ void graph_id_tag_update(
   if (graph != nullptr) {
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id->name));
   }
+  if (id_node != nullptr && id_node->has_time_invariant_animation &&
+      update_source == DEG_UPDATE_SOURCE_USER_EDIT)
+  {
+    /* The animation might not be constant anymore, and needs a time dependency then. */
+    DEG_graph_tag_relations_update(reinterpret_cast<::Depsgraph *>(graph));
+  }
+  if (graph != nullptr && update_source == DEG_UPDATE_SOURCE_USER_EDIT &&
+      (!ELEM(GS(id->name), ID_SCE, ID_GR) || flags == 0 || (flags & ID_RECALC_ANIMATION)) &&
+      !graph->builder_cache->animated_property_storage_map_.is_empty())
+  {
+    /* Edits might have changed F-Curves or freed the data they point to. Non-animation scene and
+     * collection tags are left out, they are what collection exclusion and visibility toggles
+     * send. */
+    graph->builder_cache->clear();
+  }
   if (flags == 0) {
     deg_graph_node_tag_zero(bmain, graph, id_node, update_source);
   }
@@ -723,6 +740,7 @@ void graph_id_tag_update(
    * Allows to have more granularity than a node-factory based flags. */
   if (id_node != nullptr) {
     id_node->id_cow->recalc |= flags;
+    id_node->tagged_recalc |= (flags != 0) ? flags : ID_RECALC_ALL;
   }
   /* When ID is tagged for update based on an user edits store the recalc flags in the original ID.
    * This way IDs in the undo steps will have this flag preserved, making it possible to restore
@@ -964,6 +982,7 @@ void DEG_ids_clear_recalc(Depsgraph *depsgraph, const bool backup)
      * the recalc flag. */
     id_node->is_user_modified = false;
     id_node->is_cow_explicitly_tagged = false;
+    id_node->tagged_recalc = 0;
     deg_graph_clear_id_recalc_flags(id_node->id_cow);
     if (deg_graph->is_active) {
       deg_graph_clear_id_recalc_flags(id_node->id_orig);
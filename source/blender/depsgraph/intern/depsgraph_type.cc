@@ -17,6 +17,7 @@
 #include "DEG_depsgraph.hh"
 
 #include "intern/depsgraph_type.hh"
+#include "intern/eval/deg_eval_trace.h"
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_factory.hh"
@@ -32,7 +33,10 @@ void DEG_register_node_types()
   deg::deg_register_operation_depsnodes();
 }
 
-void DEG_free_node_types() {}
+void DEG_free_node_types()
+{
+  deg::deg_eval_trace_finish();
+}
 
 deg::DEGCustomDataMeshMasks::DEGCustomDataMeshMasks(const CustomData_MeshMasks *other)
     : vert_mask(other->vmask),
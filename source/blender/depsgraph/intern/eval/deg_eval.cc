@@ -10,6 +10,9 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <optional>
+
 #include "BLI_compiler_attrs.h"
 #include "BLI_function_ref.hh"
 #include "BLI_gsqueue.h"
@@ -38,6 +41,7 @@
 #include "intern/eval/deg_eval_copy_on_write.h"
 #include "intern/eval/deg_eval_flush.h"
 #include "intern/eval/deg_eval_stats.h"
+#include "intern/eval/deg_eval_trace.h"
 #include "intern/eval/deg_eval_visibility.h"
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -45,6 +49,20 @@
 #include "intern/node/deg_node_operation.hh"
 #include "intern/node/deg_node_time.hh"
 
+/* Schedule operations with the longest chain of dependent operations first, based on the timing
+ * from previous evaluations. This avoids heavy chains (such as rig, then armature deform, then
+ * subdivision) to be started late while workers are busy with cheap operations. */
+#define USE_CRITICAL_PATH_SCHEDULING
+
+/* Interval (in number of graph evaluations) of gathering operation timing when it is not
+ * explicitly requested. Gathering has a small per-operation cost, so it is only done once in a
+ * while to follow changes of the evaluation cost. */
+#define CRITICAL_PATH_SAMPLING_INTERVAL 16
+
+/* Operations tagged as cheap at build time are evaluated directly in the task which made them
+ * ready, unless their measured average time exceeds this threshold (in seconds). */
+#define INLINE_OPERATION_MAX_TIME 2e-5
+
 namespace blender::deg {
 
 namespace {
@@ -80,6 +98,14 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Measure evaluation time of operations. Happens when statistics are requested, and also
+   * periodically for the critical path scheduling. */
+  bool do_timing;
+  /* Run the operation with the longest critical path directly from the task which made it ready,
+   * and push the roots in the order of their critical path. */
+  bool use_critical_path;
+  /* Recorder of the evaluation timeline, when requested with `--debug-depsgraph-trace`. */
+  EvalTraceRecorder *trace = nullptr;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
@@ -92,10 +118,16 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_timing || state->trace != nullptr) {
     const double start_time = BLI_time_now_seconds();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    const double end_time = BLI_time_now_seconds();
+    if (state->do_timing) {
+      operation_node->stats.current_time += end_time - start_time;
+    }
+    if (state->trace != nullptr) {
+      state->trace->record_operation(operation_node, start_time, end_time);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -108,28 +140,82 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   operation_node->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
 }
 
+bool is_inline_operation(const OperationNode *operation_node)
+{
+  return (operation_node->flag & DEPSOP_FLAG_EVAL_INLINE) &&
+         operation_node->stats.average_time < INLINE_OPERATION_MAX_TIME;
+}
+
+/* Check whether the ready operation is a better candidate to be continued in the current task
+ * than the currently chosen one. Prefers the most expensive chain when using critical path, and
+ * operations of the same ID as the one which was just evaluated: its data is likely still in the
+ * cache of this core. */
+bool is_better_continuation(const DepsgraphEvalState *state,
+                            const IDNode *id_node,
+                            const OperationNode *node,
+                            const OperationNode *current_node)
+{
+  if (current_node == nullptr) {
+    return true;
+  }
+  if (state->use_critical_path && node->critical_path_time != current_node->critical_path_time) {
+    return node->critical_path_time > current_node->critical_path_time;
+  }
+  return node->owner->owner == id_node && current_node->owner->owner != id_node;
+}
+
 void deg_task_run_func(TaskPool *pool, void *taskdata)
 {
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  /* Operations to be evaluated by this task. Starts with the scheduled one, and gets cheap
+   * operations which it makes ready appended. */
+  Vector<OperationNode *, 16> local_queue;
+  local_queue.append(reinterpret_cast<OperationNode *>(taskdata));
+  while (!local_queue.is_empty()) {
+    OperationNode *operation_node = local_queue.pop_last();
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
+
+    /* Schedule children. One of them continues in this task, avoiding the round-trip through the
+     * task pool and keeping data of the ID hot in the cache. When using critical path this is the
+     * most expensive chain, so it does not wait behind cheaper operations. Other children are
+     * pushed to the pool, where idle threads steal them. */
+    const IDNode *id_node = operation_node->owner->owner;
+    OperationNode *next_node = nullptr;
+    const int64_t next_node_index = local_queue.size();
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (is_inline_operation(node)) {
+        local_queue.append(node);
+        return;
+      }
+      if (!is_better_continuation(state, id_node, node, next_node)) {
+        BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+        return;
+      }
+      if (next_node != nullptr) {
+        BLI_task_pool_push(pool, deg_task_run_func, next_node, false, nullptr);
+      }
+      next_node = node;
+    });
+    if (next_node != nullptr) {
+      /* Evaluate the cheap operations first, they might make more operations ready for other
+       * threads to pick up. */
+      local_queue.insert(next_node_index, next_node);
+    }
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
   /* Special case for copy-on-eval component: it is to be always evaluated, to keep copied
-   * "database" in a consistent state. */
+   * "database" in a consistent state. The exception are dormant IDs, which are only copied when
+   * they are requested. */
   if (comp_node->type == NodeType::COPY_ON_EVAL) {
-    return true;
+    return !comp_node->owner->is_dormant;
   }
 
   /* Special case for dynamic visibility pass: the actual visibility is not yet known, so limit to
@@ -189,7 +275,7 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
-  if (state->do_stats) {
+  if (state->do_timing) {
     for (OperationNode *node : graph->operations) {
       node->stats.reset_current();
     }
@@ -286,8 +372,22 @@ void schedule_node(DepsgraphEvalState *state,
 void schedule_graph(DepsgraphEvalState *state,
                     const FunctionRef<void(OperationNode *node)> schedule_fn)
 {
+  if (!state->use_critical_path) {
+    for (OperationNode *node : state->graph->operations) {
+      schedule_node(state, node, false, schedule_fn);
+    }
+    return;
+  }
+  /* Start the longest chains first. */
+  Vector<OperationNode *> roots;
   for (OperationNode *node : state->graph->operations) {
-    schedule_node(state, node, false, schedule_fn);
+    schedule_node(state, node, false, [&](OperationNode *root) { roots.append(root); });
+  }
+  std::stable_sort(roots.begin(), roots.end(), [](const OperationNode *a, const OperationNode *b) {
+    return a->critical_path_time > b->critical_path_time;
+  });
+  for (OperationNode *node : roots) {
+    schedule_fn(node);
   }
 }
 
@@ -402,6 +502,22 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+#ifdef USE_CRITICAL_PATH_SCHEDULING
+  state.use_critical_path = (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) == 0;
+  state.do_timing = state.do_stats ||
+                    (state.use_critical_path &&
+                     (graph->need_update_critical_path ||
+                      graph->update_count % CRITICAL_PATH_SAMPLING_INTERVAL == 0));
+#else
+  state.use_critical_path = false;
+  state.do_timing = state.do_stats;
+#endif
+
+  std::optional<EvalTraceRecorder> trace;
+  if (deg_eval_trace_is_enabled()) {
+    trace.emplace(graph);
+    state.trace = &*trace;
+  }
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -450,12 +566,20 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   evaluate_graph_single_threaded_if_needed(&state);
 
+  /* Write the recorded timeline while the operation nodes are still known to be valid. */
+  state.trace = nullptr;
+  trace.reset();
+
   /* Finalize statistics gathering. This is because we only gather single
    * operation timing here, without aggregating anything to avoid any extra
    * synchronization. */
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.do_timing && state.use_critical_path) {
+    deg_eval_stats_update_critical_path(graph);
+    graph->need_update_critical_path = false;
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
@@ -19,11 +19,13 @@
 #include "intern/eval/deg_eval_copy_on_write.h"
 
 #include <cstring>
+#include <mutex>
 
 #include "BLI_listbase.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_curve.hh"
 #include "BKE_global.hh"
@@ -44,6 +46,7 @@
 #include "DNA_ID.h"
 #include "DNA_anim_types.h"
 #include "DNA_armature_types.h"
+#include "DNA_genfile.h"
 #include "DNA_gpencil_legacy_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
@@ -51,6 +54,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_rigidbody_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_sdna_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_sound_types.h"
 
@@ -87,7 +91,9 @@
 #include "intern/depsgraph.hh"
 #include "intern/eval/deg_eval_runtime_backup.h"
 #include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_component.hh"
 #include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
 
 namespace blender::deg {
 
@@ -855,6 +861,250 @@ ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
   return id_cow;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Partial update of evaluated objects
+ *
+ * Moving an object only tags its transform for update, but the copy-on-evaluation component then
+ * frees and re-creates the whole evaluated object, which includes backup and restore of all its
+ * runtime data. When the object is only tagged for transform its owned data (modifiers,
+ * constraints, pose, ...) is known to be unchanged, so it is enough to copy the plain DNA members
+ * which differ between the original and the evaluated object.
+ *
+ * The members are classified once based on the SDNA of the Object struct, so that new members get
+ * handled without changes here. Anything which can not be verified to be in sync (owned lists,
+ * non-ID pointers, remapped ID pointers) makes the update fall back to the full copy.
+ * \{ */
+
+enum class ObjectMemberSync {
+  /* Plain data, copied from the original when it differs. */
+  COPY,
+  /* Owned or evaluated data of the copy, which is not affected by transform changes. */
+  SKIP,
+  /* Embedded struct which has pointers (such as a ListBase). Must be bitwise equal. */
+  EMBEDDED_POINTERS,
+  /* Pointers to non-ID data. Only in sync when null in both original and evaluated object. */
+  POINTER,
+  /* Pointers to IDs, in sync when the evaluated pointer points to the copy of the original ID. */
+  ID_POINTER,
+  /* Special cases. */
+  DATA,
+  MATERIALS,
+  MATERIAL_BITS,
+};
+
+struct ObjectMemberInfo {
+  int offset;
+  int size;
+  ObjectMemberSync sync;
+};
+
+bool dna_struct_has_pointers(const SDNA *sdna, const int struct_nr)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  for (const int i : IndexRange(struct_info->members_len)) {
+    const SDNA_StructMember &member = struct_info->members[i];
+    const char *name = sdna->names[member.name];
+    if (ELEM(name[0], '*', '(')) {
+      return true;
+    }
+    const int member_struct_nr = DNA_struct_find_without_alias(sdna, sdna->types[member.type]);
+    if (member_struct_nr != -1 && dna_struct_has_pointers(sdna, member_struct_nr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool dna_struct_is_id(const SDNA *sdna, const int struct_nr)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  return struct_info->members_len != 0 &&
+         STREQ(sdna->types[struct_info->members[0].type], "ID");
+}
+
+ObjectMemberSync object_member_sync_get(const SDNA *sdna,
+                                        const SDNA_StructMember &member,
+                                        const int offset)
+{
+  /* Members which are owned by the evaluated object, or are set by the evaluation. */
+  static const int skip_offsets[] = {
+      offsetof(Object, id),
+      offsetof(Object, adt),
+      offsetof(Object, drawdata),
+      offsetof(Object, pose),
+      offsetof(Object, mpath),
+      offsetof(Object, modifiers),
+      offsetof(Object, greasepencil_modifiers),
+      offsetof(Object, shader_fx),
+      offsetof(Object, base_flag),
+      offsetof(Object, base_local_view_bits),
+      offsetof(Object, preview),
+      offsetof(Object, lightprobe_cache),
+      offsetof(Object, runtime),
+  };
+  for (const int skip_offset : skip_offsets) {
+    if (offset == skip_offset) {
+      return ObjectMemberSync::SKIP;
+    }
+  }
+  if (offset == offsetof(Object, data)) {
+    return ObjectMemberSync::DATA;
+  }
+  if (offset == offsetof(Object, mat)) {
+    return ObjectMemberSync::MATERIALS;
+  }
+  if (offset == offsetof(Object, matbits)) {
+    return ObjectMemberSync::MATERIAL_BITS;
+  }
+  const char *name = sdna->names[member.name];
+  const int member_struct_nr = DNA_struct_find_without_alias(sdna, sdna->types[member.type]);
+  if (ELEM(name[0], '*', '(')) {
+    if (name[0] == '*' && name[1] != '*' && member_struct_nr != -1 &&
+        dna_struct_is_id(sdna, member_struct_nr))
+    {
+      return ObjectMemberSync::ID_POINTER;
+    }
+    return ObjectMemberSync::POINTER;
+  }
+  if (member_struct_nr != -1 && dna_struct_has_pointers(sdna, member_struct_nr)) {
+    return ObjectMemberSync::EMBEDDED_POINTERS;
+  }
+  return ObjectMemberSync::COPY;
+}
+
+const Vector<ObjectMemberInfo> &object_members_info_get()
+{
+  static const Vector<ObjectMemberInfo> members_info = []() {
+    Vector<ObjectMemberInfo> result;
+    const SDNA *sdna = DNA_sdna_current_get();
+    const int struct_nr = DNA_struct_find_without_alias(sdna, "Object");
+    BLI_assert(struct_nr != -1);
+    const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+    int offset = 0;
+    for (const int i : IndexRange(struct_info->members_len)) {
+      const SDNA_StructMember &member = struct_info->members[i];
+      const int size = DNA_struct_member_size(sdna, member.type, member.name);
+      result.append({offset, size, object_member_sync_get(sdna, member, offset)});
+      offset += size;
+    }
+    BLI_assert(offset == sizeof(Object));
+    return result;
+  }();
+  return members_info;
+}
+
+bool id_pointer_is_in_sync(const ID *id_orig, const ID *id_cow)
+{
+  return id_cow == id_orig || (id_cow != nullptr && id_cow->orig_id == id_orig);
+}
+
+/* Copy the plain DNA members of the original object to its evaluated copy.
+ *
+ * Returns false if the evaluated object can not be brought in sync this way, in which case nothing
+ * is modified and the full copy-on-evaluation update is needed. */
+bool object_sync_plain_members(const Object *object_orig, Object *object_cow)
+{
+  if (object_orig->type != object_cow->type || object_orig->sculpt != object_cow->sculpt ||
+      object_orig->totcol != object_cow->totcol)
+  {
+    return false;
+  }
+  if (!IDP_EqualsProperties(object_orig->id.properties, object_cow->id.properties)) {
+    return false;
+  }
+
+  const char *data_orig = reinterpret_cast<const char *>(object_orig);
+  char *data_cow = reinterpret_cast<char *>(object_cow);
+  Vector<const ObjectMemberInfo *, 64> changed_members;
+  for (const ObjectMemberInfo &member : object_members_info_get()) {
+    const void *member_orig = data_orig + member.offset;
+    const void *member_cow = data_cow + member.offset;
+    const int pointers_num = member.size / int(sizeof(void *));
+    switch (member.sync) {
+      case ObjectMemberSync::COPY:
+        if (memcmp(member_orig, member_cow, member.size) != 0) {
+          changed_members.append(&member);
+        }
+        break;
+      case ObjectMemberSync::SKIP:
+        break;
+      case ObjectMemberSync::EMBEDDED_POINTERS:
+        if (memcmp(member_orig, member_cow, member.size) != 0) {
+          return false;
+        }
+        break;
+      case ObjectMemberSync::POINTER:
+        for (const int i : IndexRange(pointers_num)) {
+          if (static_cast<void *const *>(member_orig)[i] != nullptr ||
+              static_cast<void *const *>(member_cow)[i] != nullptr)
+          {
+            return false;
+          }
+        }
+        break;
+      case ObjectMemberSync::ID_POINTER:
+        for (const int i : IndexRange(pointers_num)) {
+          if (!id_pointer_is_in_sync(static_cast<const ID *const *>(member_orig)[i],
+                                     static_cast<const ID *const *>(member_cow)[i]))
+          {
+            return false;
+          }
+        }
+        break;
+      case ObjectMemberSync::DATA: {
+        /* The evaluated object might point to the evaluated geometry already. */
+        const ID *object_data_cow = object_cow->runtime->data_orig ?
+                                        object_cow->runtime->data_orig :
+                                        static_cast<const ID *>(object_cow->data);
+        if (!id_pointer_is_in_sync(static_cast<const ID *>(object_orig->data), object_data_cow)) {
+          return false;
+        }
+        break;
+      }
+      case ObjectMemberSync::MATERIALS:
+        for (const int i : IndexRange(object_orig->totcol)) {
+          if (!id_pointer_is_in_sync(reinterpret_cast<const ID *>(object_orig->mat[i]),
+                                     reinterpret_cast<const ID *>(object_cow->mat[i])))
+          {
+            return false;
+          }
+        }
+        break;
+      case ObjectMemberSync::MATERIAL_BITS:
+        if (object_orig->totcol != 0 &&
+            memcmp(object_orig->matbits, object_cow->matbits, object_orig->totcol) != 0)
+        {
+          return false;
+        }
+        break;
+    }
+  }
+
+  for (const ObjectMemberInfo *member : changed_members) {
+    memcpy(data_cow + member->offset, data_orig + member->offset, member->size);
+  }
+  DEG_COW_PRINT(
+      "  Synchronized %d members of %s\n", int(changed_members.size()), object_orig->id.name);
+  return true;
+}
+
+/* Update of the evaluated copy which avoids full copy of the datablock.
+ * Returns false if the full update is needed. */
+bool deg_update_eval_copy_datablock_partial(const IDNode *id_node)
+{
+  const ID *id_orig = id_node->id_orig;
+  ID *id_cow = id_node->id_cow;
+  if (GS(id_orig->name) != ID_OB || id_node->is_cow_explicitly_tagged ||
+      id_node->tagged_recalc != ID_RECALC_TRANSFORM || !check_datablock_expanded(id_cow))
+  {
+    return false;
+  }
+  return object_sync_plain_members(reinterpret_cast<const Object *>(id_orig),
+                                   reinterpret_cast<Object *>(id_cow));
+}
+
+/** \} */
+
 }  // namespace
 
 ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
@@ -898,6 +1148,12 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
     }
   }
 
+  if (deg_update_eval_copy_datablock_partial(id_node)) {
+    return id_cow;
+  }
+
+  depsgraph->copy_on_eval_count++;
+
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_eval_copy_datablock(id_cow);
@@ -1038,6 +1294,32 @@ void deg_create_eval_copy(::Depsgraph *graph, const IDNode *id_node)
   deg_update_eval_copy_datablock(depsgraph, id_node);
 }
 
+void deg_eval_copy_ensure_dormant(const Depsgraph *depsgraph, const IDNode *id_node)
+{
+  BLI_assert(id_node->is_dormant);
+  OperationNode *op_cow =
+      id_node->find_component(NodeType::COPY_ON_EVAL)->get_entry_operation();
+  BLI_assert(op_cow != nullptr);
+
+  /* The same ID might be requested from multiple threads. There is no need in a fine-grained lock,
+   * as requests for dormant IDs are rare. */
+  static std::mutex mutex;
+  std::lock_guard lock(mutex);
+
+  /* The update is needed when the ID was never copied, or was tagged since the last copy. The
+   * operation keeps the tag as it is not evaluated when the ID is dormant. */
+  if (check_datablock_expanded(id_node->id_cow) && (op_cow->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0)
+  {
+    return;
+  }
+  DEG_COW_PRINT("Ensure dormant evaluated copy for %s: id_orig=%p id_cow=%p\n",
+                id_node->id_orig->name,
+                id_node->id_orig,
+                id_node->id_cow);
+  deg_update_eval_copy_datablock(depsgraph, id_node);
+  op_cow->flag &= ~DEPSOP_FLAG_CLEAR_ON_EVAL;
+}
+
 bool deg_validate_eval_copy_datablock(ID *id_cow)
 {
   if (id_cow == nullptr) {
@@ -50,6 +50,15 @@ void deg_free_eval_copy_datablock(struct ID *id_cow);
  */
 void deg_create_eval_copy(struct ::Depsgraph *depsgraph, const struct IDNode *id_node);
 
+/**
+ * Make sure the evaluated copy of a dormant ID (see #IDNode::is_dormant) is in sync with the
+ * original, as its copy-on-evaluation operation is not run by the graph evaluation.
+ *
+ * Is called when the evaluated data-block is requested, and is safe to be called from multiple
+ * threads.
+ */
+void deg_eval_copy_ensure_dormant(const struct Depsgraph *depsgraph, const struct IDNode *id_node);
+
 /**
  * Check that given ID is properly expanded and does not have any shallow
  * copies inside.
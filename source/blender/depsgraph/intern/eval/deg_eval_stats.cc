@@ -8,9 +8,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <algorithm>
+
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
 
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -39,4 +42,53 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_critical_path(Depsgraph *graph)
+{
+  enum { OP_UNVISITED = 0, OP_VISITING = 1, OP_VISITED = 2 };
+
+  for (OperationNode *op_node : graph->operations) {
+    /* Operations which were not evaluated keep their previous average. */
+    if (op_node->stats.current_time > 0.0) {
+      op_node->stats.accumulate_current();
+    }
+    op_node->custom_flags = OP_UNVISITED;
+  }
+
+  /* Depth-first traversal, with the critical path time calculated in post-order so that all the
+   * dependent operations are known by then. The stack stores the index of the next relation to
+   * visit. Cyclic relations are ignored, same as during the evaluation. */
+  Vector<std::pair<OperationNode *, int64_t>> stack;
+  for (OperationNode *root : graph->operations) {
+    if (root->custom_flags != OP_UNVISITED) {
+      continue;
+    }
+    root->custom_flags = OP_VISITING;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      OperationNode *op_node = stack.last().first;
+      const int64_t relation_index = stack.last().second;
+      if (relation_index < op_node->outlinks.size()) {
+        stack.last().second++;
+        const Relation *rel = op_node->outlinks[relation_index];
+        OperationNode *child = static_cast<OperationNode *>(rel->to);
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->custom_flags == OP_UNVISITED) {
+          child->custom_flags = OP_VISITING;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      double max_child_time = 0.0;
+      for (const Relation *rel : op_node->outlinks) {
+        const OperationNode *child = static_cast<const OperationNode *>(rel->to);
+        if ((rel->flag & RELATION_FLAG_CYCLIC) == 0 && child->custom_flags == OP_VISITED) {
+          max_child_time = std::max(max_child_time, child->critical_path_time);
+        }
+      }
+      op_node->critical_path_time = op_node->stats.average_time + max_child_time;
+      op_node->custom_flags = OP_VISITED;
+      stack.remove_last();
+    }
+  }
+}
+
 }  // namespace blender::deg
@@ -15,4 +15,8 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Accumulate timings of the operations evaluated during the current graph evaluation to their
+ * average, and update critical path time of all operations. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace blender::deg
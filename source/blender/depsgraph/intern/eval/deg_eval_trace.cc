@@ -0,0 +1,213 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/eval/deg_eval_trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "BLI_fileops.hh"
+#include "BLI_serialize.hh"
+#include "BLI_set.hh"
+#include "BLI_time.h"
+
+#include "BKE_global.hh"
+
+#include "DNA_layer_types.h"
+#include "DNA_scene_types.h"
+
+#include "intern/depsgraph.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_factory.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+namespace {
+
+using io::serialize::DictionaryValue;
+
+/* All events are written to a single file, which is kept open for the whole session. The events
+ * are written in the JSON array format, where the closing bracket is optional, so that the file
+ * is usable even when Blender did not exit cleanly. */
+struct TraceFile {
+  std::mutex mutex;
+  std::unique_ptr<fstream> stream;
+  bool is_failed = false;
+  bool has_events = false;
+  /* Threads for which the name meta-data event has been written. */
+  Set<int> named_threads;
+};
+
+TraceFile &trace_file_get()
+{
+  static TraceFile trace_file;
+  return trace_file;
+}
+
+/* Timestamps in the trace are relative to the first evaluation, in microseconds. */
+double trace_time_origin()
+{
+  static const double time_origin = BLI_time_now_seconds();
+  return time_origin;
+}
+
+double trace_timestamp(const double time)
+{
+  return (time - trace_time_origin()) * 1e6;
+}
+
+/* Small sequential thread identifiers, which are stable for the whole session and easier to read
+ * in the trace viewers than the system thread identifiers. */
+int trace_thread_id()
+{
+  static std::atomic<int> next_thread_id = 0;
+  static thread_local const int thread_id = next_thread_id++;
+  return thread_id;
+}
+
+bool trace_file_ensure_open(TraceFile &trace_file)
+{
+  if (trace_file.stream) {
+    return true;
+  }
+  if (trace_file.is_failed) {
+    return false;
+  }
+  trace_file.stream = std::make_unique<fstream>(G.debug_depsgraph_trace_filepath,
+                                                std::ios::out | std::ios::trunc);
+  if (!trace_file.stream->is_open()) {
+    fprintf(stderr,
+            "Depsgraph: unable to open trace file '%s'\n",
+            G.debug_depsgraph_trace_filepath);
+    trace_file.stream.reset();
+    trace_file.is_failed = true;
+    return false;
+  }
+  return true;
+}
+
+void trace_file_write_event(TraceFile &trace_file, const DictionaryValue &event)
+{
+  io::serialize::JsonFormatter formatter;
+  *trace_file.stream << (trace_file.has_events ? ",\n" : "[\n");
+  formatter.serialize(*trace_file.stream, event);
+  trace_file.has_events = true;
+}
+
+void trace_file_write_thread_name(TraceFile &trace_file, const int thread_id)
+{
+  if (!trace_file.named_threads.add(thread_id)) {
+    return;
+  }
+  DictionaryValue event;
+  event.append_str("name", "thread_name");
+  event.append_str("ph", "M");
+  event.append_int("pid", 1);
+  event.append_int("tid", thread_id);
+  std::shared_ptr<DictionaryValue> args = event.append_dict("args");
+  args->append_str("name", "Thread " + std::to_string(thread_id));
+  trace_file_write_event(trace_file, event);
+}
+
+/* Write a complete event, which has both its start time and duration. */
+void trace_file_write_complete_event(TraceFile &trace_file,
+                                     DictionaryValue &event,
+                                     const int thread_id,
+                                     const double start_time,
+                                     const double end_time)
+{
+  trace_file_write_thread_name(trace_file, thread_id);
+  event.append_str("ph", "X");
+  event.append_int("pid", 1);
+  event.append_int("tid", thread_id);
+  event.append_double("ts", trace_timestamp(start_time));
+  event.append_double("dur", (end_time - start_time) * 1e6);
+  trace_file_write_event(trace_file, event);
+}
+
+}  // namespace
+
+bool deg_eval_trace_is_enabled()
+{
+  return G.debug_depsgraph_trace_filepath[0] != '\0';
+}
+
+void deg_eval_trace_finish()
+{
+  TraceFile &trace_file = trace_file_get();
+  std::lock_guard lock(trace_file.mutex);
+  if (!trace_file.stream) {
+    return;
+  }
+  *trace_file.stream << "\n]\n";
+  trace_file.stream.reset();
+}
+
+EvalTraceRecorder::EvalTraceRecorder(const Depsgraph *graph)
+    : graph_(graph), start_time_(BLI_time_now_seconds()), thread_id_(trace_thread_id())
+{
+  /* Make sure the origin is not later than any of the recorded events. */
+  trace_time_origin();
+}
+
+EvalTraceRecorder::~EvalTraceRecorder()
+{
+  const double end_time = BLI_time_now_seconds();
+
+  TraceFile &trace_file = trace_file_get();
+  std::lock_guard lock(trace_file.mutex);
+  if (!trace_file_ensure_open(trace_file)) {
+    return;
+  }
+
+  int64_t operations_num = 0;
+  for (const Vector<OperationEvent> &events : operation_events_) {
+    for (const OperationEvent &operation_event : events) {
+      const OperationNode *node = operation_event.node;
+      const ComponentNode *comp_node = node->owner;
+      const IDNode *id_node = comp_node->owner;
+      DictionaryValue event;
+      event.append_str("name", node->full_identifier());
+      event.append_str("cat", type_get_factory(comp_node->type)->type_name());
+      std::shared_ptr<DictionaryValue> args = event.append_dict("args");
+      args->append_str("id", id_node->name);
+      args->append_str("component", comp_node->name);
+      trace_file_write_complete_event(trace_file,
+                                      event,
+                                      operation_event.thread_id,
+                                      operation_event.start_time,
+                                      operation_event.end_time);
+      operations_num++;
+    }
+  }
+
+  DictionaryValue event;
+  event.append_str("name", "Depsgraph Evaluation");
+  event.append_str("cat", "depsgraph");
+  std::shared_ptr<DictionaryValue> args = event.append_dict("args");
+  args->append_str("scene", graph_->scene->id.name + 2);
+  args->append_str("view_layer", graph_->view_layer->name);
+  args->append_str("mode", graph_->mode == DAG_EVAL_RENDER ? "RENDER" : "VIEWPORT");
+  args->append_int("operations_num", operations_num);
+  trace_file_write_complete_event(trace_file, event, thread_id_, start_time_, end_time);
+
+  trace_file.stream->flush();
+}
+
+void EvalTraceRecorder::record_operation(const OperationNode *node,
+                                         const double start_time,
+                                         const double end_time)
+{
+  operation_events_.local().append({node, start_time, end_time, trace_thread_id()});
+}
+
+}  // namespace blender::deg
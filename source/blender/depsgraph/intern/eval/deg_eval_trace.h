@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording of the evaluation timeline in the Chrome trace event format, which can be opened in
+ * `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * Enabled with the `--debug-depsgraph-trace <filepath>` command line argument.
+ */
+
+#pragma once
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct OperationNode;
+
+/* Trace recording is requested for the current session. */
+bool deg_eval_trace_is_enabled();
+
+/* Finish the trace file. Is called when the dependency graph module is freed on exit. */
+void deg_eval_trace_finish();
+
+/* Collects the events of a single graph evaluation, and appends them to the trace file on
+ * destruction. Operations are recorded from the evaluation threads without locking. */
+class EvalTraceRecorder {
+  struct OperationEvent {
+    const OperationNode *node;
+    double start_time;
+    double end_time;
+    int thread_id;
+  };
+
+  const Depsgraph *graph_;
+  double start_time_;
+  int thread_id_;
+  threading::EnumerableThreadSpecific<Vector<OperationEvent>> operation_events_;
+
+ public:
+  EvalTraceRecorder(const Depsgraph *graph);
+  ~EvalTraceRecorder();
+
+  void record_operation(const OperationNode *node, double start_time, double end_time);
+};
+
+}  // namespace blender::deg
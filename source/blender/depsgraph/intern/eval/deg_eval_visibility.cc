@@ -221,6 +221,29 @@ void deg_graph_flush_visibility_flags(Depsgraph *graph)
   }
   BLI_stack_free(stack);
 
+  for (IDNode *id_node : graph->id_nodes) {
+    id_node->is_dormant = false;
+    if (!graph->use_visibility_optimization) {
+      continue;
+    }
+    /* Scenes and collections are always copied: they are used to access other IDs (for example,
+     * via the bases and the collection objects cache) without having relations to them. */
+    if (ELEM(id_node->id_type, ID_SCE, ID_GR)) {
+      continue;
+    }
+    if (id_node->find_component(NodeType::COPY_ON_EVAL) == nullptr) {
+      continue;
+    }
+    id_node->is_dormant = true;
+    for (const ComponentNode *comp_node : id_node->components.values()) {
+      if (comp_node->possibly_affects_visible_id && comp_node->type != NodeType::SYNCHRONIZATION)
+      {
+        id_node->is_dormant = false;
+        break;
+      }
+    }
+  }
+
   graph->need_update_nodes_visibility = false;
 }
 
@@ -274,6 +274,7 @@ Node::Stats::Stats()
 void Node::Stats::reset()
 {
   current_time = 0.0;
+  average_time = 0.0;
 }
 
 void Node::Stats::reset_current()
@@ -281,6 +282,18 @@ void Node::Stats::reset_current()
   current_time = 0.0;
 }
 
+void Node::Stats::accumulate_current()
+{
+  /* Exponential moving average: follows changes of the evaluation cost (such as a modifier being
+   * enabled) within a few evaluations, while smoothing out noise of a single one. */
+  if (average_time == 0.0) {
+    average_time = current_time;
+  }
+  else {
+    average_time += (current_time - average_time) * 0.25;
+  }
+}
+
 /*******************************************************************************
  * Node itself.
  */
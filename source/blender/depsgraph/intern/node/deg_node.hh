@@ -166,8 +166,13 @@ struct Node {
     /* Reset counters needed for the current graph evaluation, does not
      * touch averaging accumulators. */
     void reset_current();
+    /* Accumulate time of the current graph evaluation to the average. */
+    void accumulate_current();
     /* Time spent on this node during current graph evaluation. */
     double current_time;
+    /* Running average of the time spent on this node, over the graph evaluations which had timing
+     * enabled and evaluated this node. */
+    double average_time;
   };
   /* Relationships between nodes
    * The reason why all depsgraph nodes are descended from this type (apart
@@ -170,7 +170,14 @@ OperationNode *ComponentNode::add_operation(const DepsEvalOperationCb &op,
 
     /* register opnode in this component's operation set */
     OperationIDKey key(opcode, op_node->name.c_str(), name_tag);
-    operations_map->add(key, op_node);
+    if (operations_map != nullptr) {
+      operations_map->add(key, op_node);
+    }
+    else {
+      /* The component is kept from a previous build of the graph, see
+       * #DepsgraphNodeBuilder::begin_build_incremental. */
+      operations.append(op_node);
+    }
 
     /* Set back-link. */
     op_node->owner = this;
@@ -279,6 +286,10 @@ OperationNode *ComponentNode::get_exit_operation()
 
 void ComponentNode::finalize_build(Depsgraph * /*graph*/)
 {
+  if (operations_map == nullptr) {
+    /* Already finalized by a previous build of the graph. */
+    return;
+  }
   operations.reserve(operations_map->size());
   for (OperationNode *op_node : operations_map->values()) {
     operations.append(op_node);
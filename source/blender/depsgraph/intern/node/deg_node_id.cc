@@ -72,7 +72,11 @@ void IDNode::init(const ID *id, const char * /*subdata*/)
   is_enabled_on_eval = true;
   is_collection_fully_expanded = false;
   has_base = false;
+  is_dormant = false;
+  has_time_invariant_animation = false;
   is_user_modified = false;
+  is_cow_explicitly_tagged = false;
+  tagged_recalc = 0;
   id_cow_recalc_backup = 0;
 
   visible_components_mask = 0;
@@ -88,6 +92,11 @@ void IDNode::init_copy_on_write(Depsgraph &depsgraph, ID *id_cow_hint)
     // BLI_assert(deg_eval_copy_is_needed(id_orig));
     if (deg_eval_copy_is_needed(id_orig)) {
       id_cow = id_cow_hint;
+      /* The original might have been re-allocated (for example, by undo) while the evaluated
+       * copy was not expanded yet. Expansion takes care of it for the other evaluated copies. */
+      if (!deg_eval_copy_is_expanded(id_cow)) {
+        deg_tag_eval_copy_id(depsgraph, id_cow, id_orig);
+      }
     }
     else {
       id_cow = id_orig;
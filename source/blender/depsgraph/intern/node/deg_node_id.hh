@@ -115,12 +115,29 @@ struct IDNode : public Node {
   /* Is used to figure out whether object came to the dependency graph via a base. */
   bool has_base;
 
+  /* Nothing visible depends on this ID, not even potentially (via animated visibility or modifier
+   * modes), so not even its copy-on-evaluation operation is run by the graph evaluation. The
+   * evaluated copy is only created or updated when it is requested via #DEG_get_evaluated_id().
+   * Calculated by #deg_graph_flush_visibility_flags(). */
+  bool is_dormant;
+
+  /* Animation of this ID evaluates to the same values on every frame, so its evaluated result is
+   * kept across frame changes instead of depending on the time source. Only used by the render
+   * graphs, see #DepsgraphRelationBuilder::build_action. A user edit of such ID requires relations
+   * update, so that the time dependency is added back when the animation is no longer constant. */
+  bool has_time_invariant_animation;
+
   /* Accumulated flag from operation. Is initialized and used during updates flush. */
   bool is_user_modified;
 
   /* Copy-on-Write component has been explicitly tagged for update. */
   bool is_cow_explicitly_tagged;
 
+  /* Recalc flags this ID was tagged with since the last update pass. Allows copy-on-evaluation to
+   * only synchronize the part of the evaluated copy affected by the tag.
+   * ID_RECALC_ALL is used for the legacy tag with flags 0. */
+  uint32_t tagged_recalc;
+
   /* Accumulate recalc flags from multiple update passes. */
   int id_cow_recalc_backup;
 
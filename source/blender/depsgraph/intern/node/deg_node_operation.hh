@@ -232,6 +232,10 @@ enum OperationFlag {
   /* Evaluation of the node is temporarily disabled. */
   DEPSOP_FLAG_MUTE = (1 << 5),
 
+  /* The operation is cheap to evaluate, and is to be evaluated from the same task which made it
+   * ready, see #deg_graph_tag_inline_operations. */
+  DEPSOP_FLAG_EVAL_INLINE = (1 << 6),
+
   /* Set of flags which gets flushed along the relations. */
   DEPSOP_FLAG_FLUSH = (DEPSOP_FLAG_USER_MODIFIED),
 
@@ -281,6 +285,11 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Average evaluation time of this operation and of the most expensive chain of operations
+   * depending on it. Operations with a longer critical path are scheduled first, see
+   * #deg_eval_stats_update_critical_path. */
+  double critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -96,7 +96,11 @@ struct PBVH_GPU_Args {
   int cd_mask_layer;
 };
 
-void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args);
+/**
+ * Update the existing draw buffers of a node. Only buffers that depend on the data tagged in
+ * #update_flag (#PBVHNodeFlags) are updated, unless #PBVH_UpdateDrawBuffers is set.
+ */
+void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args, int update_flag);
 void update_pre(PBVHBatches *batches, const PBVH_GPU_Args &args);
 
 void node_gpu_flush(PBVHBatches *batches);
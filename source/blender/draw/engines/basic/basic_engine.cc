@@ -276,6 +276,7 @@ DrawEngineType draw_engine_basic_type = {
     /*cache_init*/ &basic_cache_init,
     /*cache_populate*/ &basic_cache_populate,
     /*cache_finish*/ &basic_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &basic_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
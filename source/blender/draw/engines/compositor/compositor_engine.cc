@@ -163,7 +163,7 @@ class Context : public realtime_compositor::Context {
     return view->name;
   }
 
-  realtime_compositor::ResultPrecision get_precision() const override
+  realtime_compositor::ResultPrecision get_requested_precision() const override
   {
     switch (get_scene().r.compositor_precision) {
       case SCE_COMPOSITOR_PRECISION_AUTO:
@@ -326,6 +326,7 @@ DrawEngineType draw_engine_compositor_type = {
     /*cache_init*/ nullptr,
     /*cache_populate*/ nullptr,
     /*cache_finish*/ nullptr,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &compositor_engine_draw,
     /*view_update*/ &compositor_engine_update,
     /*id_update*/ nullptr,
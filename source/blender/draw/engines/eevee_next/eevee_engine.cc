@@ -203,6 +203,7 @@ DrawEngineType draw_engine_eevee_next_type = {
     /*cache_init*/ &eevee_cache_init,
     /*cache_populate*/ &eevee_cache_populate,
     /*cache_finish*/ &eevee_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &eevee_draw_scene,
     /*view_update*/ &eevee_view_update,
     /*id_update*/ nullptr,
@@ -104,6 +104,12 @@ class HiZBuffer {
 
   void debug_draw(View &view, GPUFrameBuffer *view_fb);
 
+  /** Scale factor from render UV to HiZ UV, as the HiZ buffer is padded. */
+  float2 uv_scale_get() const
+  {
+    return data_.uv_scale;
+  }
+
   /* Back is Previous layer depth (ex: For refraction). Front for current layer depth. */
   struct {
     /** References to the textures in the swap-chain. */
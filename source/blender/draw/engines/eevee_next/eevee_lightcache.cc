@@ -8,6 +8,7 @@
  * Contains everything about light baking.
  */
 
+#include <algorithm>
 #include <mutex>
 
 #include "DRW_render.hh"
@@ -17,6 +18,8 @@
 
 #include "DNA_lightprobe_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_math_matrix.hh"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 
@@ -92,6 +95,7 @@ class LightBake {
         original_probes_(probes)
   {
     BLI_assert(BLI_thread_is_main());
+    sort_probes_by_priority(scene);
     bake_result_.resize(probes.size());
     bake_result_.fill(nullptr);
 
@@ -200,6 +204,49 @@ class LightBake {
   }
 
  private:
+  /**
+   * Bake the probes closest to the scene camera first. They are the ones the most likely to be
+   * visible in the viewport, so the user gets a usable preview long before the whole bake is
+   * finished. Distance is measured to the probe volume bounds, so a camera inside a volume
+   * always bakes it first.
+   */
+  void sort_probes_by_priority(const Scene *scene)
+  {
+    if (scene->camera == nullptr || original_probes_.size() < 2) {
+      return;
+    }
+    const float3 camera_pos = scene->camera->object_to_world().location();
+
+    auto distance_to_camera = [&](const Object *ob) {
+      const float4x4 &object_to_world = ob->object_to_world();
+      /* Probe volumes are unit cubes in object space. */
+      const float3 local_pos = math::transform_point(math::invert(object_to_world), camera_pos);
+      const float3 closest_local = math::clamp(local_pos, float3(-1.0f), float3(1.0f));
+      const float3 closest = math::transform_point(object_to_world, closest_local);
+      return math::distance_squared(closest, camera_pos);
+    };
+
+    Array<float> distances(original_probes_.size());
+    for (const int i : original_probes_.index_range()) {
+      distances[i] = distance_to_camera(original_probes_[i]);
+    }
+    Array<int> order(original_probes_.size());
+    for (const int i : order.index_range()) {
+      order[i] = i;
+    }
+    /* Stable to keep a deterministic order between probes at the same distance. */
+    std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+      return distances[a] < distances[b];
+    });
+
+    Vector<Object *> sorted_probes;
+    sorted_probes.reserve(order.size());
+    for (const int i : order) {
+      sorted_probes.append(original_probes_[i]);
+    }
+    original_probes_ = std::move(sorted_probes);
+  }
+
   void context_enable(bool render_begin = true)
   {
     if (GPU_use_main_context_workaround() && !BLI_thread_is_main()) {
@@ -792,7 +792,12 @@ GPUTexture *DeferredLayer::render(View &main_view,
   inst_.shadows.set_view(render_view, extent);
 
   inst_.gbuffer.bind(gbuffer_fb);
+  /* The GBuffer pass is depth tested for equality against the prepass depth, so objects that are
+   * entirely behind it can be culled on the GPU. */
+  render_view.occlusion_culling_set(inst_.hiz_buffer.front.ref_tx_,
+                                    inst_.hiz_buffer.uv_scale_get());
   inst_.manager->submit(gbuffer_ps_, render_view);
+  render_view.occlusion_culling_set(nullptr);
 
   for (int i = 0; i < ARRAY_SIZE(direct_radiance_txs_); i++) {
     direct_radiance_txs_[i].acquire(
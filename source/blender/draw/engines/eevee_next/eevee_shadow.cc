@@ -1030,6 +1030,7 @@ void ShadowModule::end_sync()
         sub.bind_ssbo("render_view_buf", &render_view_buf_);
         sub.bind_ssbo("tilemaps_clip_buf", &tilemap_pool.tilemaps_clip);
         sub.bind_image("tilemaps_img", &tilemap_pool.tilemap_tx);
+        sub.push_constant("view_budget", &view_budget_);
         sub.dispatch(int3(1, 1, tilemap_pool.tilemaps_data.size()));
         sub.barrier(GPU_BARRIER_SHADER_STORAGE | GPU_BARRIER_UNIFORM | GPU_BARRIER_TEXTURE_FETCH |
                     GPU_BARRIER_SHADER_IMAGE_ACCESS);
@@ -1046,6 +1047,7 @@ void ShadowModule::end_sync()
         sub.bind_ssbo("dst_coord_buf", &dst_coord_buf_);
         sub.bind_ssbo("src_coord_buf", &src_coord_buf_);
         sub.bind_ssbo("render_map_buf", &render_map_buf_);
+        sub.push_constant("view_budget", &view_budget_);
         sub.dispatch(int3(1, 1, SHADOW_VIEW_MAX));
         sub.barrier(GPU_BARRIER_SHADER_STORAGE);
       }
@@ -1205,6 +1207,20 @@ int ShadowModule::max_view_per_tilemap()
   return max_view_count;
 }
 
+int ShadowModule::view_budget()
+{
+  if (inst_.is_image_render()) {
+    return SHADOW_VIEW_MAX;
+  }
+  /* Rendering shadow views is the most expensive part of the update. During interaction, keep
+   * the redraw time bounded when a lot of lights need an update at once, at the cost of
+   * refining their shadows over a few redraws. */
+  if (inst_.is_transforming() || inst_.is_navigating() || inst_.is_playback()) {
+    return SHADOW_VIEW_MAX / 4;
+  }
+  return SHADOW_VIEW_MAX;
+}
+
 void ShadowModule::set_view(View &view, int2 extent)
 {
   if (enabled_ == false) {
@@ -1219,6 +1235,7 @@ void ShadowModule::set_view(View &view, int2 extent)
   dispatch_depth_scan_size_ = int3(math::divide_ceil(extent, int2(SHADOW_DEPTH_SCAN_GROUP_SIZE)),
                                    1);
   max_view_per_tilemap_ = max_view_per_tilemap();
+  view_budget_ = view_budget();
 
   data_.film_pixel_radius = screen_pixel_radius(view.wininv(), view.is_persp(), extent);
   inst_.uniform_data.push_update();
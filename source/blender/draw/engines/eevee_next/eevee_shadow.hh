@@ -244,6 +244,8 @@ class ShadowModule {
   int2 usage_tag_fb_resolution_;
   int usage_tag_fb_lod_ = 5;
   int max_view_per_tilemap_ = 1;
+  /** Maximum number of views rendered by one shadow update. */
+  int view_budget_ = SHADOW_VIEW_MAX;
   int2 input_depth_extent_;
 
   /* Statistics that are read back to CPU after a few frame (to avoid stall). */
@@ -373,6 +375,12 @@ class ShadowModule {
   void debug_page_map_call(DRWPass *pass);
   bool shadow_update_finished(int loop_count);
 
+  /**
+   * Limit the number of shadow views rendered per redraw during interaction. The tiles whose view
+   * didn't fit use a lower resolution LOD and are rendered in the next redraws.
+   */
+  int view_budget();
+
   /** Compute approximate punctual shadow pixel world space radius, 1 unit away of the light. */
   float tilemap_pixel_radius();
 
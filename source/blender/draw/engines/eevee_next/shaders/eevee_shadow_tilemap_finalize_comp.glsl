@@ -84,7 +84,9 @@ void main()
       bool lod_has_update = rect_min.x < rect_max.x;
       if (lod_has_update) {
         int view_index = atomicAdd(statistics_buf.view_needed_count, 1);
-        if (view_index < SHADOW_VIEW_MAX) {
+        /* Views over the budget are not rendered, coarser LODs are used for their tiles until
+         * they get a view in a later update. */
+        if (view_index < min(view_budget, SHADOW_VIEW_MAX)) {
           lod_rendered |= 1u << lod;
 
           /* Setup the view. */
@@ -14,7 +14,7 @@ void main()
 {
   int view_index = int(gl_GlobalInvocationID.z);
   /* Dispatch size if already bounded by SHADOW_VIEW_MAX. */
-  if (view_index >= statistics_buf.view_needed_count) {
+  if (view_index >= min(statistics_buf.view_needed_count, view_budget)) {
     return;
   }
 
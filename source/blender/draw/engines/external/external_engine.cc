@@ -450,6 +450,7 @@ DrawEngineType draw_engine_external_type = {
     /*cache_init*/ &external_cache_init,
     /*cache_populate*/ &external_cache_populate,
     /*cache_finish*/ &external_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &external_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
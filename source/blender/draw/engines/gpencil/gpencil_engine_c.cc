@@ -1285,6 +1285,7 @@ DrawEngineType draw_engine_gpencil_type = {
     /*cache_init*/ &GPENCIL_cache_init,
     /*cache_populate*/ &GPENCIL_cache_populate,
     /*cache_finish*/ &GPENCIL_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &GPENCIL_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
@@ -198,6 +198,7 @@ DrawEngineType draw_engine_image_type = {
     /*cache_init*/ &IMAGE_cache_init,
     /*cache_populate*/ &IMAGE_cache_populate,
     /*cache_finish*/ nullptr,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &IMAGE_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
@@ -813,6 +813,7 @@ DrawEngineType draw_engine_overlay_type = {
     /*cache_init*/ &OVERLAY_cache_init,
     /*cache_populate*/ &OVERLAY_cache_populate,
     /*cache_finish*/ &OVERLAY_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &OVERLAY_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
@@ -104,6 +104,7 @@ DrawEngineType draw_engine_overlay_next_type = {
     /*cache_init*/ &OVERLAY_next_cache_init,
     /*cache_populate*/ &OVERLAY_next_cache_populate,
     /*cache_finish*/ &OVERLAY_next_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &OVERLAY_next_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
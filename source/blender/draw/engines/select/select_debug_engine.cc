@@ -110,6 +110,7 @@ DrawEngineType draw_engine_debug_select_type = {
     /*cache_init*/ nullptr,
     /*cache_populate*/ nullptr,
     /*cache_finish*/ nullptr,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &select_debug_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
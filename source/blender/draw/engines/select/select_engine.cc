@@ -311,6 +311,7 @@ DrawEngineType draw_engine_select_type = {
     /*cache_init*/ &select_cache_init,
     /*cache_populate*/ &select_cache_populate,
     /*cache_finish*/ nullptr,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &select_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
@@ -92,6 +92,7 @@ DrawEngineType draw_engine_select_next_type = {
     /*cache_init*/ &SELECT_next_cache_init,
     /*cache_populate*/ &SELECT_next_cache_populate,
     /*cache_finish*/ &SELECT_next_cache_finish,
+    /*cache_retain*/ nullptr,
     /*draw_scene*/ &SELECT_next_draw_scene,
     /*view_update*/ nullptr,
     /*id_update*/ nullptr,
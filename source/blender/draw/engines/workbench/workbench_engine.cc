@@ -67,8 +67,18 @@ class Instance {
     anti_aliasing_ps.init(scene_state);
   }
 
+  /* False when the object passes of the last sync depend on more than the object data and the
+   * scene settings, so they can't be drawn again without being synced. */
+  bool object_passes_retainable = false;
+
   void begin_sync()
   {
+    /* Nothing is synced once the render finished. Image textures are freed when no sync used
+     * them for a while. */
+    object_passes_retainable = !scene_state.render_finished &&
+                               scene_state.object_mode == CTX_MODE_OBJECT &&
+                               scene_state.shading.color_type != V3D_SHADING_TEXTURE_COLOR;
+
     resources.material_buf.clear_and_trim();
 
     opaque_ps.sync(scene_state, resources);
@@ -87,6 +97,21 @@ class Instance {
     resources.material_buf.push_update();
   }
 
+  /**
+   * Draw the object passes of the last sync again, which is only valid as long as no object
+   * changed. Only the passes that depend on the view and the sample are synced.
+   */
+  bool retain_sync()
+  {
+    if (!object_passes_retainable || scene_state.object_settings_changed) {
+      return false;
+    }
+    outline_ps.sync(resources);
+    dof_ps.sync(resources);
+    anti_aliasing_ps.sync(scene_state, resources);
+    return true;
+  }
+
   Material get_material(ObjectRef ob_ref, eV3DShadingColorType color_type, int slot = 0)
   {
     switch (color_type) {
@@ -132,6 +157,8 @@ class Instance {
       if (md && BKE_modifier_is_enabled(scene_state.scene, md, eModifierMode_Realtime)) {
         FluidModifierData *fmd = (FluidModifierData *)md;
         if (fmd->domain) {
+          /* Volumes are drawn with a jitter that depends on the sample. */
+          object_passes_retainable = false;
           volume_ps.object_sync_modifier(manager, resources, scene_state, ob_ref, md);
 
           if (fmd->domain->type == FLUID_DOMAIN_TYPE_GAS) {
@@ -145,6 +172,12 @@ class Instance {
     ResourceHandle emitter_handle(0);
 
     if (is_object_data_visible) {
+      /* Sculpt, curves, point cloud and volume passes use data that is only valid for one
+       * redraw. */
+      if (object_state.sculpt_pbvh || ELEM(ob->type, OB_POINTCLOUD, OB_CURVES, OB_VOLUME)) {
+        object_passes_retainable = false;
+      }
+
       if (object_state.sculpt_pbvh) {
         const Bounds<float3> bounds = bke::pbvh::bounds_get(*ob_ref.object->sculpt->pbvh);
         const float3 center = math::midpoint(bounds.min, bounds.max);
@@ -188,6 +221,7 @@ class Instance {
         const int draw_as = (part->draw_as == PART_DRAW_REND) ? part->ren_as : part->draw_as;
 
         if (draw_as == PART_DRAW_PATH) {
+          object_passes_retainable = false;
           hair_sync(manager, ob_ref, emitter_handle, object_state, psys, md);
         }
       }
@@ -560,6 +594,11 @@ static void workbench_cache_finish(void *vedata)
   reinterpret_cast<WORKBENCH_Data *>(vedata)->instance->end_sync();
 }
 
+static bool workbench_cache_retain(void *vedata)
+{
+  return reinterpret_cast<WORKBENCH_Data *>(vedata)->instance->retain_sync();
+}
+
 static void workbench_draw_scene(void *vedata)
 {
   WORKBENCH_Data *ved = reinterpret_cast<WORKBENCH_Data *>(vedata);
@@ -801,6 +840,7 @@ DrawEngineType draw_engine_workbench = {
     /*cache_init*/ &workbench_cache_init,
     /*cache_populate*/ &workbench_cache_populate,
     /*cache_finish*/ &workbench_cache_finish,
+    /*cache_retain*/ &workbench_cache_retain,
     /*draw_scene*/ &workbench_draw_scene,
     /*view_update*/ &workbench_view_update,
     /*id_update*/ &workbench_id_update,
@@ -174,6 +174,9 @@ struct SceneState {
 
   bool overlays_enabled = false;
 
+  /* True when a setting the object passes depend on changed since the last init. */
+  bool object_settings_changed = true;
+
   /* Used when material_type == eMaterialType::SINGLE */
   Material material_override = Material(float3(1.0f));
   /* When r == -1.0 the shader uses the vertex color */
@@ -42,6 +42,7 @@ void SceneState::init(Object *camera_ob /*=nullptr*/)
                static_cast<Camera *>(camera_object->data) :
                nullptr;
 
+  const eContextObjectMode previous_object_mode = object_mode;
   object_mode = CTX_data_mode_enum_ex(context->object_edit, context->obact, context->object_mode);
 
   /* TODO(@pragma37):
@@ -62,6 +63,7 @@ void SceneState::init(Object *camera_ob /*=nullptr*/)
   if (new_clip_state != old_clip_state) {
     reset_taa = true;
   }
+  const Vector<float4> previous_clip_planes = clip_planes;
   clip_planes.clear();
   if (new_clip_state & DRW_STATE_CLIP_PLANES) {
     int plane_len = (RV3D_LOCK_FLAGS(rv3d) & RV3D_BOXCLIP) ? 4 : 6;
@@ -93,6 +95,10 @@ void SceneState::init(Object *camera_ob /*=nullptr*/)
     reset_taa = true;
   }
 
+  object_settings_changed = object_mode != previous_object_mode ||
+                            clip_planes != previous_clip_planes ||
+                            memcmp(&shading, &previous_shading, sizeof(View3DShading)) != 0;
+
   lighting_type = lighting_type_from_v3d_lighting(shading.light);
   material_override = Material(shading.single_color);
 
@@ -129,6 +129,11 @@ struct DrawEngineType {
   void (*cache_init)(void *vedata);
   void (*cache_populate)(void *vedata, Object *ob);
   void (*cache_finish)(void *vedata);
+  /**
+   * Optional, called instead of the cache callbacks when no data changed since the last cache
+   * population. Return false when the caches have to be populated again anyway.
+   */
+  bool (*cache_retain)(void *vedata);
 
   void (*draw_scene)(void *vedata);
 
@@ -21,7 +21,10 @@
 
 #include "UI_resources.hh"
 
+#include "BLI_array.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "BKE_object.hh"
 #include "BKE_paint.hh"
@@ -2882,46 +2885,55 @@ blender::gpu::Batch *DRW_cache_camera_distances_get()
 /** \name Meshes
  * \{ */
 
+/**
+ * The mesh whose batch cache is used to draw an object, which might be shared with other objects
+ * that draw identical meshes.
+ */
+static Mesh &mesh_for_drawing(Object &ob)
+{
+  return blender::draw::DRW_mesh_batch_cache_shared_mesh_get(ob, *static_cast<Mesh *>(ob.data));
+}
+
 blender::gpu::Batch *DRW_cache_mesh_all_verts_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_all_verts(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_all_verts(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_all_edges_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_all_edges(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_all_edges(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_loose_edges_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_loose_edges(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_loose_edges(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_edge_detection_get(Object *ob, bool *r_is_manifold)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_edge_detection(*static_cast<Mesh *>(ob->data), r_is_manifold);
+  return DRW_mesh_batch_cache_get_edge_detection(mesh_for_drawing(*ob), r_is_manifold);
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_edges(*ob, *static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_edges(*ob, mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch **DRW_cache_mesh_surface_shaded_get(Object *ob,
@@ -2931,63 +2943,63 @@ blender::gpu::Batch **DRW_cache_mesh_surface_shaded_get(Object *ob,
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
   return DRW_mesh_batch_cache_get_surface_shaded(
-      *ob, *static_cast<Mesh *>(ob->data), gpumat_array, gpumat_array_len);
+      *ob, mesh_for_drawing(*ob), gpumat_array, gpumat_array_len);
 }
 
 blender::gpu::Batch **DRW_cache_mesh_surface_texpaint_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_texpaint(*ob, *static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_texpaint(*ob, mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_texpaint_single_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_texpaint_single(*ob, *static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_texpaint_single(*ob, mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_vertpaint_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_vertpaint(*ob, *static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_vertpaint(*ob, mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_sculptcolors_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_sculpt(*ob, *static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_sculpt(*ob, mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_weights_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_weights(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_weights(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_face_wireframe_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_wireframes_face(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_wireframes_face(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_mesh_analysis_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_edit_mesh_analysis(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_edit_mesh_analysis(mesh_for_drawing(*ob));
 }
 
 blender::gpu::Batch *DRW_cache_mesh_surface_viewer_attribute_get(Object *ob)
 {
   using namespace blender::draw;
   BLI_assert(ob->type == OB_MESH);
-  return DRW_mesh_batch_cache_get_surface_viewer_attribute(*static_cast<Mesh *>(ob->data));
+  return DRW_mesh_batch_cache_get_surface_viewer_attribute(mesh_for_drawing(*ob));
 }
 
 /** \} */
@@ -3357,9 +3369,16 @@ void drw_batch_cache_validate(Object *ob)
 {
   using namespace blender::draw;
   switch (ob->type) {
-    case OB_MESH:
-      DRW_mesh_batch_cache_validate(*ob, *(Mesh *)ob->data);
+    case OB_MESH: {
+      Mesh &mesh = *static_cast<Mesh *>(ob->data);
+      /* Engines may still access the object's own mesh directly. */
+      DRW_mesh_batch_cache_validate(*ob, mesh);
+      Mesh &shared_mesh = mesh_for_drawing(*ob);
+      if (&shared_mesh != &mesh) {
+        DRW_mesh_batch_cache_validate(*ob, shared_mesh);
+      }
       break;
+    }
     case OB_CURVES_LEGACY:
     case OB_FONT:
     case OB_SURF:
@@ -3384,6 +3403,35 @@ void drw_batch_cache_validate(Object *ob)
   }
 }
 
+void drw_batch_cache_validate_parallel(const blender::Span<Object *> objects)
+{
+  using namespace blender;
+  using namespace blender::draw;
+  /* Only meshes are handled, they are by far the most common object type in heavy scenes. Objects
+   * sharing a mesh are skipped, they would access the same cache concurrently. */
+  VectorSet<Mesh *> meshes;
+  Vector<Object *> mesh_objects;
+  for (Object *ob : objects) {
+    if (ob->type == OB_MESH && meshes.add(static_cast<Mesh *>(ob->data))) {
+      mesh_objects.append(ob);
+    }
+  }
+
+  Array<bool> is_valid(mesh_objects.size());
+  threading::parallel_for(mesh_objects.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      is_valid[i] = DRW_mesh_batch_cache_validate_threaded(*mesh_objects[i], *meshes[i]);
+    }
+  });
+
+  /* Freeing the GPU resources of invalid caches must happen on the main thread. */
+  for (const int64_t i : mesh_objects.index_range()) {
+    if (!is_valid[i]) {
+      DRW_mesh_batch_cache_validate(*mesh_objects[i], *meshes[i]);
+    }
+  }
+}
+
 void drw_batch_cache_generate_requested(Object *ob)
 {
   using namespace blender::draw;
@@ -3400,10 +3448,17 @@ void drw_batch_cache_generate_requested(Object *ob)
                           ((mode == CTX_MODE_EDIT_MESH) && DRW_object_is_in_edit_mode(ob))));
 
   switch (ob->type) {
-    case OB_MESH:
+    case OB_MESH: {
+      Mesh &mesh = *static_cast<Mesh *>(ob->data);
+      Mesh &shared_mesh = mesh_for_drawing(*ob);
+      if (&shared_mesh != &mesh) {
+        DRW_mesh_batch_cache_create_requested(
+            *DST.task_graph, *ob, shared_mesh, *scene, is_paint_mode, use_hide);
+      }
       DRW_mesh_batch_cache_create_requested(
-          *DST.task_graph, *ob, *(Mesh *)ob->data, *scene, is_paint_mode, use_hide);
+          *DST.task_graph, *ob, mesh, *scene, is_paint_mode, use_hide);
       break;
+    }
     case OB_CURVES_LEGACY:
     case OB_FONT:
     case OB_SURF:
@@ -252,6 +252,8 @@ struct MeshBatchCache {
   int mat_len;
   /* Instantly invalidates cache, skipping mesh check */
   bool is_dirty;
+  /* The vertex positions changed, only the index buffers are still valid. */
+  bool is_deform_dirty;
   bool is_editmode;
   bool is_uvsyncsel;
 
@@ -200,11 +200,15 @@ void mesh_buffer_cache_create_requested(TaskGraph &task_graph,
   double rdata_end = BLI_time_now_seconds();
 #endif
 
-  TaskNode *task_node_mesh_render_data = BLI_task_graph_node_create(
+  /* All extraction nodes of the mesh depend on the render data, so prioritize it over the
+   * extraction of other meshes in the same graph. */
+  TaskNode *task_node_mesh_render_data = BLI_task_graph_node_create_ex(
       &task_graph,
       mesh_extract_render_data_node_exec,
       new MeshRenderDataUpdateTaskData{std::move(mr_ptr), mbc},
-      [](void *task_data) { delete static_cast<MeshRenderDataUpdateTaskData *>(task_data); });
+      [](void *task_data) { delete static_cast<MeshRenderDataUpdateTaskData *>(task_data); },
+      TASK_PRIORITY_HIGH);
+  BLI_task_graph_node_set_name(task_node_mesh_render_data, "Mesh Render Data");
 
   if (DRW_vbo_requested(buffers.vbo.pos)) {
     struct TaskData {
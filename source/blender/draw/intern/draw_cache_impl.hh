@@ -42,6 +42,12 @@ void DRW_curve_batch_cache_free(Curve *cu);
 
 void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode);
 void DRW_mesh_batch_cache_validate(Object &object, Mesh &mesh);
+/**
+ * Create the batch cache of the mesh if it doesn't exist yet, without freeing any GPU resources,
+ * so that it can be called from worker threads for different meshes. Return false when an
+ * existing cache is invalid and has to be validated with #DRW_mesh_batch_cache_validate.
+ */
+bool DRW_mesh_batch_cache_validate_threaded(Object &object, Mesh &mesh);
 void DRW_mesh_batch_cache_free(void *batch_cache);
 
 void DRW_lattice_batch_cache_dirty_tag(Lattice *lt, int mode);
@@ -285,6 +291,14 @@ gpu::VertBuf *DRW_mesh_batch_cache_pos_vertbuf_get(Mesh &mesh);
 
 int DRW_mesh_material_count_get(const Object &object, const Mesh &mesh);
 
+/**
+ * Get the mesh whose batch cache is used to draw the object. That is another mesh drawn in the
+ * same redraw if it shares all of its data arrays with #mesh through implicit sharing, which is
+ * common for evaluated copies of linked duplicates. That way identical meshes share their GPU
+ * buffers. Otherwise #mesh itself is returned.
+ */
+Mesh &DRW_mesh_batch_cache_shared_mesh_get(const Object &object, Mesh &mesh);
+
 /* Edit mesh bitflags (is this the right place?) */
 enum {
   VFLAG_VERT_ACTIVE = 1 << 0,
@@ -535,7 +535,7 @@ static void ensure_control_point_attribute(const Curves &curves,
 
   MutableSpan<ColorGeometry4f> vbo_span = attr_vbo.data<ColorGeometry4f>();
 
-  attribute.varray.materialize(vbo_span);
+  array_utils::copy(attribute.varray, vbo_span);
 }
 
 static void ensure_final_attribute(const Curves &curves,
@@ -564,15 +564,19 @@ static void ensure_final_attribute(const Curves &curves,
 }
 
 static void fill_curve_offsets_vbos(const OffsetIndices<int> points_by_curve,
-                                    GPUVertBufRaw &data_step,
-                                    GPUVertBufRaw &seg_step)
+                                    const GPUVertBufRaw &data_step,
+                                    const GPUVertBufRaw &seg_step)
 {
-  for (const int i : points_by_curve.index_range()) {
-    const IndexRange points = points_by_curve[i];
-
-    *(uint *)GPU_vertbuf_raw_step(&data_step) = points.start();
-    *(ushort *)GPU_vertbuf_raw_step(&seg_step) = points.size() - 1;
-  }
+  /* Write with the strides of the buffers directly, so that the curves can be filled in
+   * parallel instead of stepping through the buffers. */
+  threading::parallel_for(points_by_curve.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange points = points_by_curve[i];
+
+      *(uint *)(data_step.data + size_t(i) * data_step.stride) = points.start();
+      *(ushort *)(seg_step.data + size_t(i) * seg_step.stride) = points.size() - 1;
+    }
+  });
 }
 
 static void create_curve_offsets_vbos(const OffsetIndices<int> points_by_curve,
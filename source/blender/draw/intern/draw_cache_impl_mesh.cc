@@ -14,6 +14,8 @@
 
 #include "BLI_bitmap.h"
 #include "BLI_buffer.h"
+#include "BLI_ghash.h"
+#include "BLI_hash.hh"
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
@@ -562,7 +564,7 @@ static bool mesh_batch_cache_valid(Object &object, Mesh &mesh)
     return false;
   }
 
-  if (cache->is_dirty) {
+  if (cache->is_dirty || cache->is_deform_dirty) {
     return false;
   }
 
@@ -603,8 +605,48 @@ static void mesh_batch_cache_init(Object &object, Mesh &mesh)
   drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
+/**
+ * Extraction of object mode meshes isn't waited for immediately (see
+ * #DRW_mesh_batch_cache_create_requested). The mesh may be used by multiple objects though, so
+ * make sure any running extraction is finished before its cache is accessed again.
+ */
+static void mesh_batch_cache_wait_for_extraction(const Mesh &mesh)
+{
+  if (DST.extracting_meshes == nullptr || !BLI_gset_haskey(DST.extracting_meshes, &mesh)) {
+    return;
+  }
+  BLI_task_graph_work_and_wait(DST.task_graph);
+  BLI_gset_clear(DST.extracting_meshes, nullptr);
+}
+
+/**
+ * Discard all vertex buffers and batches of a deformed mesh. The index buffers and the topology
+ * caches are kept, since they don't depend on the positions.
+ */
+static void mesh_batch_cache_discard_deformed(MeshBatchCache &cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    gpu::VertBuf **vbos = (gpu::VertBuf **)&mbc->buff.vbo;
+    for (int i = 0; i < sizeof(mbc->buff.vbo) / sizeof(void *); i++) {
+      GPU_VERTBUF_DISCARD_SAFE(vbos[i]);
+    }
+  }
+  for (int i = 0; i < sizeof(cache.batch) / sizeof(void *); i++) {
+    gpu::Batch **batch = (gpu::Batch **)&cache.batch;
+    GPU_BATCH_DISCARD_SAFE(batch[i]);
+  }
+  mesh_batch_cache_discard_surface_batches(cache);
+  cache.batch_ready = (DRWBatchFlag)0;
+  cache.is_deform_dirty = false;
+}
+
 void DRW_mesh_batch_cache_validate(Object &object, Mesh &mesh)
 {
+  mesh_batch_cache_wait_for_extraction(mesh);
+  MeshBatchCache *cache = static_cast<MeshBatchCache *>(mesh.runtime->batch_cache);
+  if (cache && cache->is_deform_dirty) {
+    mesh_batch_cache_discard_deformed(*cache);
+  }
   if (!mesh_batch_cache_valid(object, mesh)) {
     if (mesh.runtime->batch_cache) {
       mesh_batch_cache_clear(*static_cast<MeshBatchCache *>(mesh.runtime->batch_cache));
@@ -613,8 +655,110 @@ void DRW_mesh_batch_cache_validate(Object &object, Mesh &mesh)
   }
 }
 
+bool DRW_mesh_batch_cache_validate_threaded(Object &object, Mesh &mesh)
+{
+  /* Waiting for extraction is not thread-safe, so it must not have started yet. */
+  BLI_assert(DST.extracting_meshes == nullptr || !BLI_gset_haskey(DST.extracting_meshes, &mesh));
+  if (mesh.runtime->batch_cache == nullptr) {
+    mesh_batch_cache_init(object, mesh);
+    return true;
+  }
+  return mesh_batch_cache_valid(object, mesh);
+}
+
+static uint64_t customdata_layers_hash(const CustomData &data, uint64_t hash)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    hash = get_default_hash(hash, layer.data);
+  }
+  return hash;
+}
+
+static bool customdata_layers_equal(const CustomData &a, const CustomData &b)
+{
+  if (a.totlayer != b.totlayer) {
+    return false;
+  }
+  for (const int i : IndexRange(a.totlayer)) {
+    const CustomDataLayer &layer_a = a.layers[i];
+    const CustomDataLayer &layer_b = b.layers[i];
+    if (layer_a.data != layer_b.data || layer_a.type != layer_b.type ||
+        layer_a.flag != layer_b.flag || layer_a.active != layer_b.active ||
+        layer_a.active_rnd != layer_b.active_rnd || !STREQ(layer_a.name, layer_b.name))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint mesh_shared_data_hash(const void *key)
+{
+  const Mesh &mesh = *static_cast<const Mesh *>(key);
+  uint64_t hash = get_default_hash(mesh.verts_num, mesh.edges_num, mesh.faces_num);
+  hash = get_default_hash(hash, mesh.corners_num, mesh.face_offset_indices);
+  hash = customdata_layers_hash(mesh.vert_data, hash);
+  hash = customdata_layers_hash(mesh.edge_data, hash);
+  hash = customdata_layers_hash(mesh.face_data, hash);
+  hash = customdata_layers_hash(mesh.corner_data, hash);
+  return uint(hash);
+}
+
+/** Return true if the meshes are different, as expected from a #GSetCmpFP. */
+static bool mesh_shared_data_cmp(const void *a, const void *b)
+{
+  const Mesh &mesh_a = *static_cast<const Mesh *>(a);
+  const Mesh &mesh_b = *static_cast<const Mesh *>(b);
+  if (mesh_a.verts_num != mesh_b.verts_num || mesh_a.edges_num != mesh_b.edges_num ||
+      mesh_a.faces_num != mesh_b.faces_num || mesh_a.corners_num != mesh_b.corners_num ||
+      mesh_a.face_offset_indices != mesh_b.face_offset_indices)
+  {
+    return true;
+  }
+  if (StringRef(mesh_a.active_color_attribute) != StringRef(mesh_b.active_color_attribute) ||
+      StringRef(mesh_a.default_color_attribute) != StringRef(mesh_b.default_color_attribute))
+  {
+    return true;
+  }
+  return !(customdata_layers_equal(mesh_a.vert_data, mesh_b.vert_data) &&
+           customdata_layers_equal(mesh_a.edge_data, mesh_b.edge_data) &&
+           customdata_layers_equal(mesh_a.face_data, mesh_b.face_data) &&
+           customdata_layers_equal(mesh_a.corner_data, mesh_b.corner_data));
+}
+
+Mesh &DRW_mesh_batch_cache_shared_mesh_get(const Object &object, Mesh &mesh)
+{
+  if (DST.task_graph == nullptr) {
+    return mesh;
+  }
+  /* Only object mode drawing is independent of the object's state and the mesh's original data. */
+  if (object.mode != OB_MODE_OBJECT || object.sculpt != nullptr ||
+      mesh.runtime->edit_mesh != nullptr || mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA ||
+      BKE_subsurf_modifier_has_gpu_subdiv(&mesh))
+  {
+    return mesh;
+  }
+  if (DST.shared_meshes == nullptr) {
+    DST.shared_meshes = BLI_gset_new(mesh_shared_data_hash, mesh_shared_data_cmp, __func__);
+  }
+  void **r_key;
+  if (!BLI_gset_ensure_p_ex(DST.shared_meshes, &mesh, &r_key)) {
+    *r_key = &mesh;
+    return mesh;
+  }
+  Mesh &shared_mesh = *static_cast<Mesh *>(*r_key);
+  /* The number of materials depends on the object, and a batch cache only supports one. */
+  const MeshBatchCache *cache = static_cast<const MeshBatchCache *>(
+      shared_mesh.runtime->batch_cache);
+  if (cache == nullptr || cache->mat_len != mesh_render_mat_len_get(object, shared_mesh)) {
+    return mesh;
+  }
+  return shared_mesh;
+}
+
 static MeshBatchCache *mesh_batch_cache_get(Mesh &mesh)
 {
+  mesh_batch_cache_wait_for_extraction(mesh);
   return static_cast<MeshBatchCache *>(mesh.runtime->batch_cache);
 }
 
@@ -754,6 +898,9 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *mesh, eMeshBatchDirtyMode mode)
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache.is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      cache.is_deform_dirty = true;
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -1928,14 +2075,24 @@ void DRW_mesh_batch_cache_create_requested(TaskGraph &task_graph,
                                      ts,
                                      use_hide);
 
-  /* Ensure that all requested batches have finished.
-   * Ideally we want to remove this sync, but there are cases where this doesn't work.
-   * See #79038 for example.
-   *
-   * An idea to improve this is to separate the Object mode from the edit mode draw caches. And
-   * based on the mode the correct one will be updated. Other option is to look into using
-   * drw_batch_cache_generate_requested_delayed. */
-  BLI_task_graph_work_and_wait(&task_graph);
+  if (is_editmode || is_paint_mode) {
+    /* Ensure that all requested batches have finished.
+     * Ideally we want to remove this sync, but there are cases where this doesn't work.
+     * See #79038 for example.
+     *
+     * An idea to improve this is to separate the Object mode from the edit mode draw caches. And
+     * based on the mode the correct one will be updated. Other option is to look into using
+     * drw_batch_cache_generate_requested_delayed. */
+    BLI_task_graph_work_and_wait(&task_graph);
+    BLI_gset_clear(DST.extracting_meshes, nullptr);
+  }
+  else {
+    /* In object mode, the extraction of many meshes is scheduled in the same task graph without
+     * waiting for each of them, which avoids the synchronization overhead for scenes with many
+     * small meshes. The graph is finished at the end of the cache populate phase, or when the
+     * same mesh is requested again. */
+    BLI_gset_add(DST.extracting_meshes, &mesh);
+  }
 #ifndef NDEBUG
   drw_mesh_batch_cache_check_available(task_graph, mesh);
 #endif
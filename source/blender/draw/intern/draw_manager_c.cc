@@ -17,6 +17,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BLF_api.hh"
 
@@ -163,6 +164,7 @@ static void drw_task_graph_init()
   BLI_assert(DST.task_graph == nullptr);
   DST.task_graph = BLI_task_graph_create();
   DST.delayed_extraction = BLI_gset_ptr_new(__func__);
+  DST.extracting_meshes = BLI_gset_ptr_new(__func__);
 }
 
 static void drw_task_graph_deinit()
@@ -174,6 +176,13 @@ static void drw_task_graph_deinit()
   DST.delayed_extraction = nullptr;
   BLI_task_graph_work_and_wait(DST.task_graph);
 
+  BLI_gset_free(DST.extracting_meshes, nullptr);
+  DST.extracting_meshes = nullptr;
+  if (DST.shared_meshes) {
+    BLI_gset_free(DST.shared_meshes, nullptr);
+    DST.shared_meshes = nullptr;
+  }
+
   BLI_task_graph_free(DST.task_graph);
   DST.task_graph = nullptr;
 }
@@ -990,6 +999,9 @@ void DRW_cache_free_old_batches(Main *bmain)
 
   lasttime = ctime;
 
+  /* Retained caches may still reference the freed batches. */
+  DRW_view_data_cache_tag_all_outdated();
+
   for (scene = static_cast<Scene *>(bmain->scenes.first); scene;
        scene = static_cast<Scene *>(scene->id.next))
   {
@@ -1036,6 +1048,8 @@ static void drw_engines_init()
 
 static void drw_engines_cache_init()
 {
+  /* The manager is shared by all draw loops of the view, so any sync replaces its resources. */
+  DRW_view_data_cache_tag_outdated(DST.view_data_active);
   DRW_manager_begin_sync();
 
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
@@ -1066,6 +1080,31 @@ static void drw_engines_world_update(Scene *scene)
   }
 }
 
+/**
+ * Validate the batch caches of all objects drawn in the viewport in parallel. Instances are
+ * skipped, their data is validated once per instanced data in #drw_duplidata_load.
+ */
+static void drw_batch_caches_validate_all(Depsgraph *depsgraph, View3D *v3d)
+{
+  blender::Vector<Object *> objects;
+  DEGObjectIterSettings deg_iter_settings = {nullptr};
+  deg_iter_settings.depsgraph = depsgraph;
+  deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, ob) {
+    if ((v3d->object_type_exclude_viewport & (1 << ob->type)) != 0) {
+      continue;
+    }
+    if (!BKE_object_is_visible_in_viewport(v3d, ob)) {
+      continue;
+    }
+    objects.append(ob);
+  }
+  DEG_OBJECT_ITER_END;
+
+  drw_batch_cache_validate_parallel(objects);
+}
+
 static void drw_engines_cache_populate(Object *ob)
 {
   DST.ob_handle = 0;
@@ -1104,6 +1143,12 @@ static void drw_engines_cache_populate(Object *ob)
 
 static void drw_engines_cache_finish()
 {
+  /* Engines may use the extracted mesh data when finishing their caches. */
+  if (DST.task_graph) {
+    BLI_task_graph_work_and_wait(DST.task_graph);
+    BLI_gset_clear(DST.extracting_meshes, nullptr);
+  }
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->cache_finish) {
       engine->cache_finish(data);
@@ -1701,14 +1746,16 @@ void DRW_draw_render_loop_ex(Depsgraph *depsgraph,
   /* Init engines */
   drw_engines_init();
 
-  /* Cache filling */
-  {
+  /* Cache filling, skipped when nothing changed since the last redraw of this view. */
+  if (DST.options.is_image_render || !DRW_view_data_cache_retain(DST.view_data_active)) {
     PROFILE_START(stime);
     drw_engines_cache_init();
     drw_engines_world_update(scene);
 
     /* Only iterate over objects for internal engines or when overlays are enabled */
     if (do_populate_loop) {
+      drw_batch_caches_validate_all(depsgraph, v3d);
+
       DST.dupli_origin = nullptr;
       DST.dupli_origin_data = nullptr;
       DEGObjectIterSettings deg_iter_settings = {nullptr};
@@ -1734,6 +1781,7 @@ void DRW_draw_render_loop_ex(Depsgraph *depsgraph,
 
     drw_duplidata_free();
     drw_engines_cache_finish();
+    DRW_view_data_cache_tag_synced(DST.view_data_active);
 
     drw_task_graph_deinit();
     DRW_render_instance_buffer_finish();
@@ -1743,6 +1791,9 @@ void DRW_draw_render_loop_ex(Depsgraph *depsgraph,
     PROFILE_END_UPDATE(*cache_time, stime);
 #endif
   }
+  else {
+    drw_task_graph_deinit();
+  }
 
   DRW_stats_begin();
 
@@ -16,6 +16,7 @@
 #include "BLI_assert.h"
 #include "BLI_linklist.h"
 #include "BLI_memblock.h"
+#include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_threads.h"
 
@@ -670,6 +671,10 @@ struct DRWManager {
   TaskGraph *task_graph;
   /* Contains list of objects that needs to be extracted from other objects. */
   GSet *delayed_extraction;
+  /* Meshes with extraction tasks in #task_graph that may not have finished yet. */
+  GSet *extracting_meshes;
+  /* Object mode meshes compared by their data, see #DRW_mesh_batch_cache_shared_mesh_get. */
+  GSet *shared_meshes;
 
   /* ---------- Nothing after this point is cleared after use ----------- */
 
@@ -709,6 +714,11 @@ GPUStorageBuf *drw_debug_gpu_print_buf_get();
 eDRWCommandType command_type_get(const uint64_t *command_type_bits, int index);
 
 void drw_batch_cache_validate(Object *ob);
+/**
+ * Validate the batch caches of the objects in parallel before the engines populate their caches,
+ * which only leaves cheap checks to #drw_batch_cache_validate on the main thread.
+ */
+void drw_batch_cache_validate_parallel(blender::Span<Object *> objects);
 void drw_batch_cache_generate_requested(Object *ob);
 
 /**
@@ -350,7 +350,7 @@ struct PBVHBatches {
   PBVHBatches(const PBVH_GPU_Args &args);
   ~PBVHBatches();
 
-  void update(const PBVH_GPU_Args &args);
+  void update(const PBVH_GPU_Args &args, int update_flag);
   void update_pre(const PBVH_GPU_Args &args);
 
   int create_vbo(const AttributeRequest &request, const PBVH_GPU_Args &args);
@@ -1076,12 +1076,39 @@ static void fill_vbo_bmesh(PBVHVbo &vbo, const PBVH_GPU_Args &args)
   }
 }
 
-void PBVHBatches::update(const PBVH_GPU_Args &args)
+static bool vbo_needs_update(const AttributeRequest &request, const int update_flag)
+{
+  if (const CustomRequest *request_type = std::get_if<CustomRequest>(&request)) {
+    switch (*request_type) {
+      case CustomRequest::Position:
+      case CustomRequest::Normal:
+        return update_flag & PBVH_UpdateDrawPositions;
+      case CustomRequest::Mask:
+        return update_flag & PBVH_UpdateDrawMask;
+      case CustomRequest::FaceSet:
+        return update_flag & PBVH_UpdateDrawFaceSets;
+    }
+    BLI_assert_unreachable();
+    return true;
+  }
+  const GenericRequest &attr = std::get<GenericRequest>(request);
+  return (update_flag & PBVH_UpdateDrawColor) && (CD_TYPE_AS_MASK(attr.type) & CD_MASK_COLOR_ALL);
+}
+
+void PBVHBatches::update(const PBVH_GPU_Args &args, const int update_flag)
 {
   if (!this->lines_index) {
     create_index(args);
   }
+  /* With dynamic topology the buffers may have been cleared in #update_pre. */
+  const bool update_all = (update_flag & PBVH_UpdateDrawBuffers) ||
+                          args.pbvh_type == PBVH_BMESH;
   for (PBVHVbo &vbo : this->vbos) {
+    if (!update_all && !vbo_needs_update(vbo.request, update_flag)) {
+      /* The data of buffers that are not updated was freed after uploading, so they are skipped
+       * when flushing as well. */
+      continue;
+    }
     switch (args.pbvh_type) {
       case PBVH_FACES:
         fill_vbo_faces(vbo, args);
@@ -1557,9 +1584,9 @@ static PBVHBatch &ensure_batch(PBVHBatches &batches,
   });
 }
 
-void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args)
+void node_update(PBVHBatches *batches, const PBVH_GPU_Args &args, const int update_flag)
 {
-  batches->update(args);
+  batches->update(args, update_flag);
 }
 
 void node_gpu_flush(PBVHBatches *batches)
@@ -276,17 +276,28 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
   GPU_storagebuf_clear(visibility_buf_, data);
 
   if (do_visibility_) {
-    GPUShader *shader = DRW_shader_draw_visibility_compute_get();
+    const bool use_occlusion_culling = occlusion_hiz_tx_ != nullptr && view_len_ == 1;
+    GPUShader *shader = use_occlusion_culling ?
+                            DRW_shader_draw_visibility_occlusion_compute_get() :
+                            DRW_shader_draw_visibility_compute_get();
     GPU_shader_bind(shader);
     GPU_shader_uniform_1i(shader, "resource_len", resource_len);
     GPU_shader_uniform_1i(shader, "view_len", view_len_);
     GPU_shader_uniform_1i(shader, "visibility_word_per_draw", word_per_draw);
+    if (use_occlusion_culling) {
+      GPU_shader_uniform_2fv(shader, "hiz_uv_scale", occlusion_hiz_uv_scale_);
+      GPU_shader_uniform_1i(shader, "hiz_lod_max", GPU_texture_mip_count(occlusion_hiz_tx_) - 1);
+      GPU_texture_bind(occlusion_hiz_tx_, GPU_shader_get_sampler_binding(shader, "hiz_tx"));
+    }
     GPU_storagebuf_bind(bounds, GPU_shader_get_ssbo_binding(shader, "bounds_buf"));
     GPU_storagebuf_bind(visibility_buf_, GPU_shader_get_ssbo_binding(shader, "visibility_buf"));
     GPU_uniformbuf_bind(frozen_ ? data_freeze_ : data_, DRW_VIEW_UBO_SLOT);
     GPU_uniformbuf_bind(frozen_ ? culling_freeze_ : culling_, DRW_VIEW_CULLING_UBO_SLOT);
     GPU_compute_dispatch(shader, divide_ceil_u(resource_len, DRW_VISIBILITY_GROUP_SIZE), 1, 1);
     GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+    if (use_occlusion_culling) {
+      GPU_texture_unbind(occlusion_hiz_tx_);
+    }
   }
 
   if (frozen_) {
@@ -43,6 +43,10 @@ class View {
   UniformArrayBuffer<ViewCullingData, DRW_VIEW_MAX> culling_freeze_;
   /** Result of the visibility computation. 1 bit or 1 or 2 word per resource ID per view. */
   VisibilityBuf visibility_buf_;
+  /** Max depth pyramid used for occlusion culling. Not owned. */
+  GPUTexture *occlusion_hiz_tx_ = nullptr;
+  /** Scale from view UV to the UV of the depth pyramid, when it is padded. */
+  float2 occlusion_hiz_uv_scale_ = float2(1.0f);
 
   const char *debug_name_;
 
@@ -79,6 +83,22 @@ class View {
     do_visibility_ = enable;
   }
 
+  /**
+   * Cull the resources that are entirely behind the depth of the given max depth pyramid
+   * (HiZ buffer), in addition to frustum culling. The pyramid needs to be built from a depth
+   * buffer rendered with this view. Passing nullptr disables occlusion culling.
+   *
+   * IMPORTANT: This is only valid for passes whose drawing is depth tested against that depth
+   * buffer, for instance the shading pass following a depth pre-pass. Only supported for
+   * single views.
+   */
+  void occlusion_culling_set(GPUTexture *hiz_tx, float2 uv_scale = float2(1.0f))
+  {
+    BLI_assert(hiz_tx == nullptr || view_len_ == 1);
+    occlusion_hiz_tx_ = hiz_tx;
+    occlusion_hiz_uv_scale_ = uv_scale;
+  }
+
   /**
    * Update culling data using a compute shader.
    * This is to be used if the matrices were updated externally
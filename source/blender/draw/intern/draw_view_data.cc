@@ -23,6 +23,9 @@
 
 using namespace blender;
 
+/** Incremented to invalidate the retained caches of all views. */
+static int cache_outdated_generation = 0;
+
 struct DRWViewData {
   DefaultFramebufferList dfbl = {};
   DefaultTextureList dtxl = {};
@@ -37,6 +40,10 @@ struct DRWViewData {
   Vector<ViewportEngineData> engines;
   Vector<ViewportEngineData *> enabled_engines;
 
+  /** Enabled engines of the last cache population, empty when the caches are outdated. */
+  Vector<ViewportEngineData *> synced_engines;
+  int synced_generation = 0;
+
   /** New per view/viewport manager. Null if not supported by current hardware. */
   draw::Manager *manager = nullptr;
 
@@ -215,6 +222,8 @@ void DRW_view_data_free_unused(DRWViewData *view_data)
 
 void DRW_view_data_engines_view_update(DRWViewData *view_data)
 {
+  DRW_view_data_cache_tag_outdated(view_data);
+
   for (ViewportEngineData &engine_data : view_data->engines) {
     DrawEngineType *draw_engine = engine_data.engine_type->draw_engine;
     if (draw_engine->view_update) {
@@ -223,6 +232,39 @@ void DRW_view_data_engines_view_update(DRWViewData *view_data)
   }
 }
 
+void DRW_view_data_cache_tag_outdated(DRWViewData *view_data)
+{
+  view_data->synced_engines.clear();
+}
+
+void DRW_view_data_cache_tag_all_outdated()
+{
+  cache_outdated_generation++;
+}
+
+void DRW_view_data_cache_tag_synced(DRWViewData *view_data)
+{
+  view_data->synced_engines = view_data->enabled_engines;
+  view_data->synced_generation = cache_outdated_generation;
+}
+
+bool DRW_view_data_cache_retain(DRWViewData *view_data)
+{
+  if (view_data->synced_engines.is_empty() ||
+      view_data->synced_engines != view_data->enabled_engines ||
+      view_data->synced_generation != cache_outdated_generation)
+  {
+    return false;
+  }
+  for (ViewportEngineData *engine_data : view_data->enabled_engines) {
+    DrawEngineType *draw_engine = engine_data->engine_type->draw_engine;
+    if (draw_engine->cache_retain == nullptr || !draw_engine->cache_retain(engine_data)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 double *DRW_view_data_cache_time_get(DRWViewData *view_data)
 {
   return &view_data->cache_time;
@@ -106,6 +106,18 @@ void DRW_view_data_use_engine(DRWViewData *view_data, DrawEngineType *engine_typ
 void DRW_view_data_reset(DRWViewData *view_data);
 void DRW_view_data_free_unused(DRWViewData *view_data);
 void DRW_view_data_engines_view_update(DRWViewData *view_data);
+/** The caches of the view have to be populated again before they are drawn. */
+void DRW_view_data_cache_tag_outdated(DRWViewData *view_data);
+/** Tag the caches of all views outdated, e.g. when batches they may reference are freed. */
+void DRW_view_data_cache_tag_all_outdated();
+/** The caches of the enabled engines were populated. */
+void DRW_view_data_cache_tag_synced(DRWViewData *view_data);
+/**
+ * Check if the caches of the last population can be drawn again, which is the case when they
+ * were not tagged outdated since, the same engines are enabled and all of them retain their
+ * caches.
+ */
+bool DRW_view_data_cache_retain(DRWViewData *view_data);
 double *DRW_view_data_cache_time_get(DRWViewData *view_data);
 DefaultFramebufferList *DRW_view_data_default_framebuffer_list_get(DRWViewData *view_data);
 DefaultTextureList *DRW_view_data_default_texture_list_get(DRWViewData *view_data);
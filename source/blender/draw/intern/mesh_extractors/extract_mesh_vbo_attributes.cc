@@ -224,11 +224,21 @@ static void extract_attribute(const MeshRenderData &mr,
     const bke::AttributeAccessor attributes = mr.mesh->attributes();
     const StringRef name = request.attribute_name;
     const eCustomDataType data_type = request.cd_type;
-    const GVArraySpan attribute = *attributes.lookup_or_default(name, request.domain, data_type);
+    const GVArray varray = *attributes.lookup_or_default(name, request.domain, data_type);
 
     bke::attribute_math::convert_to_static_type(request.cd_type, [&](auto dummy) {
       using T = decltype(dummy);
-      if constexpr (!std::is_void_v<typename AttributeConverter<T>::VBOType>) {
+      using VBOType = typename AttributeConverter<T>::VBOType;
+      if constexpr (std::is_same_v<T, VBOType>) {
+        if (request.domain == bke::AttrDomain::Corner && !varray.is_span()) {
+          /* Write virtual arrays (e.g. implicitly converted attributes) directly into the vertex
+           * buffer, instead of copying them to a temporary array first. */
+          varray.typed<T>().materialize(vbo.data<VBOType>());
+          return;
+        }
+      }
+      if constexpr (!std::is_void_v<VBOType>) {
+        const GVArraySpan attribute(varray);
         switch (request.domain) {
           case bke::AttrDomain::Point:
             extract_data_mesh_mapped_corner(attribute.typed<T>(), mr.corner_verts, vbo);
@@ -24,6 +24,52 @@ void mask_visibility_bit(uint view_id)
   }
 }
 
+#ifdef DRW_VISIBILITY_OCCLUSION
+/**
+ * Return true if the bounding box is entirely behind the depth stored in the max depth pyramid.
+ * Conservative: boxes crossing the camera plane or covering too many texels are never occluded.
+ */
+bool is_occluded(ObjectBounds bounds)
+{
+  vec3 origin = bounds.bounding_corners[0].xyz;
+  vec2 uv_min = vec2(1.0);
+  vec2 uv_max = vec2(0.0);
+  float depth_min = 1.0;
+  for (int i = 0; i < 8; i++) {
+    vec3 P = origin + float(i & 1) * bounds.bounding_corners[1].xyz +
+             float((i >> 1) & 1) * bounds.bounding_corners[2].xyz +
+             float((i >> 2) & 1) * bounds.bounding_corners[3].xyz;
+    vec4 hs_P = drw_view.winmat * (drw_view.viewmat * vec4(P, 1.0));
+    if (hs_P.w <= 0.0) {
+      return false;
+    }
+    vec3 ss_P = (hs_P.xyz / hs_P.w) * 0.5 + 0.5;
+    uv_min = min(uv_min, ss_P.xy);
+    uv_max = max(uv_max, ss_P.xy);
+    depth_min = min(depth_min, ss_P.z);
+  }
+  uv_min = clamp(uv_min, 0.0, 1.0) * hiz_uv_scale;
+  uv_max = clamp(uv_max, 0.0, 1.0) * hiz_uv_scale;
+
+  /* Select the level at which the screen rectangle covers at most 2x2 texels. */
+  vec2 texel_extent = (uv_max - uv_min) * vec2(textureSize(hiz_tx, 0));
+  int lod = int(ceil(log2(max(1.0, max(texel_extent.x, texel_extent.y)))));
+  lod = min(lod, hiz_lod_max);
+  ivec2 lod_size = textureSize(hiz_tx, lod);
+  ivec2 texel_min = clamp(ivec2(uv_min * vec2(lod_size)), ivec2(0), lod_size - 1);
+  ivec2 texel_max = clamp(ivec2(uv_max * vec2(lod_size)), ivec2(0), lod_size - 1);
+  if (any(greaterThan(texel_max - texel_min, ivec2(1)))) {
+    return false;
+  }
+
+  float hiz_depth = max(max(texelFetch(hiz_tx, texel_min, lod).r,
+                            texelFetch(hiz_tx, ivec2(texel_max.x, texel_min.y), lod).r),
+                        max(texelFetch(hiz_tx, ivec2(texel_min.x, texel_max.y), lod).r,
+                            texelFetch(hiz_tx, texel_max, lod).r));
+  return depth_min > hiz_depth;
+}
+#endif
+
 void main()
 {
   if (int(gl_GlobalInvocationID.x) >= resource_len) {
@@ -42,19 +88,29 @@ void main()
                                            bounds._inner_sphere_radius);
 
     for (drw_view_id = 0u; drw_view_id < uint(view_len); drw_view_id++) {
+      bool is_visible = true;
       if (drw_view_culling.bound_sphere.w == -1.0) {
         /* View disabled. */
-        mask_visibility_bit(drw_view_id);
+        is_visible = false;
       }
       else if (intersect_view(inscribed_sphere) == true) {
         /* Visible. */
       }
       else if (intersect_view(bounding_sphere) == false) {
         /* Not visible. */
-        mask_visibility_bit(drw_view_id);
+        is_visible = false;
       }
       else if (intersect_view(box) == false) {
         /* Not visible. */
+        is_visible = false;
+      }
+#ifdef DRW_VISIBILITY_OCCLUSION
+      if (is_visible && is_occluded(bounds)) {
+        /* Behind the depth buffer. */
+        is_visible = false;
+      }
+#endif
+      if (!is_visible) {
         mask_visibility_bit(drw_view_id);
       }
     }
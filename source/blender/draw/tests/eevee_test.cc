@@ -875,6 +875,7 @@ static void test_eevee_shadow_finalize()
   pass.bind_ssbo("viewport_index_buf", viewport_index_buf);
   pass.bind_ssbo("pages_infos_buf", pages_infos_data);
   pass.bind_image("tilemaps_img", tilemap_tx);
+  pass.push_constant("view_budget", int(SHADOW_VIEW_MAX));
   pass.dispatch(int3(1, 1, tilemaps_data.size()));
   pass.barrier(GPU_BARRIER_BUFFER_UPDATE | GPU_BARRIER_TEXTURE_UPDATE);
 
@@ -67,6 +67,11 @@
  */
 #  define ARRAY_CHUNK_SIZE_IN_BYTES 65536
 #  define ARRAY_CHUNK_NUM_MIN 256
+/**
+ * Edit-mode operations often insert or remove elements in the middle of the arrays,
+ * content defined chunks keep the data after such changes shared with the previous step.
+ */
+#  define ARRAY_STORE_FLAG BLI_ARRAY_STORE_CONTENT_DEFINED_CHUNKS
 
 #  define USE_ARRAY_STORE_THREAD
 #endif
@@ -215,10 +220,12 @@ static void um_arraystore_cd_compact(CustomData *cdata,
     }
 
     const int stride = CustomData_sizeof(type);
-    BArrayStore *bs = create ? BLI_array_store_at_size_ensure(&um_arraystore.bs_stride[bs_index],
-                                                              stride,
-                                                              array_chunk_size_calc(stride)) :
-                               nullptr;
+    BArrayStore *bs = create ?
+                          BLI_array_store_at_size_ensure_ex(&um_arraystore.bs_stride[bs_index],
+                                                            stride,
+                                                            array_chunk_size_calc(stride),
+                                                            ARRAY_STORE_FLAG) :
+                          nullptr;
     const int layer_len = layer_end - layer_start;
 
     if (create) {
@@ -430,10 +437,11 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
           if (create) {
             BArrayState *state_reference = um_ref ? um_ref->store.face_offset_indices : nullptr;
             const size_t stride = sizeof(*mesh->face_offset_indices);
-            BArrayStore *bs = BLI_array_store_at_size_ensure(
+            BArrayStore *bs = BLI_array_store_at_size_ensure_ex(
                 &um_arraystore.bs_stride[ARRAY_STORE_INDEX_POLY_OFFSETS],
                 stride,
-                array_chunk_size_calc(stride));
+                array_chunk_size_calc(stride),
+                ARRAY_STORE_FLAG);
             um->store.face_offset_indices = BLI_array_store_state_add(bs,
                                                                       mesh->face_offset_indices,
                                                                       size_t(mesh->faces_num + 1) *
@@ -447,10 +455,11 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
       [&]() {
         if (mesh->key && mesh->key->totkey) {
           const size_t stride = mesh->key->elemsize;
-          BArrayStore *bs = create ? BLI_array_store_at_size_ensure(
+          BArrayStore *bs = create ? BLI_array_store_at_size_ensure_ex(
                                          &um_arraystore.bs_stride[ARRAY_STORE_INDEX_SHAPE],
                                          stride,
-                                         array_chunk_size_calc(stride)) :
+                                         array_chunk_size_calc(stride),
+                                         ARRAY_STORE_FLAG) :
                                      nullptr;
           if (create) {
             um->store.keyblocks = static_cast<BArrayState **>(
@@ -480,10 +489,11 @@ static void um_arraystore_compact_ex(UndoMesh *um, const UndoMesh *um_ref, bool
           if (create) {
             BArrayState *state_reference = um_ref ? um_ref->store.mselect : nullptr;
             const size_t stride = sizeof(*mesh->mselect);
-            BArrayStore *bs = BLI_array_store_at_size_ensure(
+            BArrayStore *bs = BLI_array_store_at_size_ensure_ex(
                 &um_arraystore.bs_stride[ARRAY_STORE_INDEX_MSEL],
                 stride,
-                array_chunk_size_calc(stride));
+                array_chunk_size_calc(stride),
+                ARRAY_STORE_FLAG);
             um->store.mselect = BLI_array_store_state_add(
                 bs, mesh->mselect, size_t(mesh->totselect) * stride, state_reference);
           }
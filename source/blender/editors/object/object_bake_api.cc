@@ -1786,6 +1786,9 @@ cleanup:
     BKE_id_free(nullptr, &me_cage_eval->id);
   }
 
+  /* The engine may still reference the depsgraph. */
+  RE_bake_engine_free(re, depsgraph);
+
   DEG_graph_free(depsgraph);
 
   return op_result;
@@ -254,7 +254,8 @@ ModifierData *modifier_add(
   BKE_object_modifier_set_active(ob, new_md);
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  /* Only dependencies of the object itself are changed by a new modifier. */
+  DEG_relations_tag_update_id(bmain, &ob->id);
 
   return new_md;
 }
@@ -409,7 +410,12 @@ bool modifier_remove(ReportList *reports, Main *bmain, Scene *scene, Object *ob,
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  if (sort_depsgraph) {
+    DEG_relations_tag_update(bmain);
+  }
+  else {
+    DEG_relations_tag_update_id(bmain, &ob->id);
+  }
 
   return true;
 }
@@ -631,7 +637,7 @@ bool modifier_copy_to_object(Main *bmain,
 
   WM_main_add_notifier(NC_OBJECT | ND_MODIFIER, ob_dst);
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
-  DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_id(bmain, &ob_dst->id);
   return true;
 }
 
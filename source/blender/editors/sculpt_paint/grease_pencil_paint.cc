@@ -608,7 +608,7 @@ struct PaintOperationExecutor {
     bke::fill_attribute_range_default(
         attributes, bke::AttrDomain::Curve, curve_attributes_to_skip, IndexRange(active_curve, 1));
 
-    drawing_->tag_topology_changed();
+    drawing_->tag_topology_changed(IndexRange::from_single(active_curve));
   }
 
   void active_smoothing(PaintOperation &self, const IndexRange smooth_window)
@@ -972,7 +972,12 @@ struct PaintOperationExecutor {
   void execute(PaintOperation &self, const bContext &C, const InputSample &extension_sample)
   {
     this->process_extension_sample(self, C, extension_sample);
-    drawing_->tag_topology_changed();
+
+    const Scene *scene = CTX_data_scene(&C);
+    const bool on_back = (scene->toolsettings->gpencil_flags & GP_TOOL_FLAG_PAINT_ONBACK) != 0;
+    const IndexRange curves_range = drawing_->strokes().curves_range();
+    const int active_curve = on_back ? curves_range.first() : curves_range.last();
+    drawing_->tag_topology_changed(IndexRange::from_single(active_curve));
   }
 };
 
@@ -1089,7 +1094,7 @@ static void smooth_stroke(bke::greasepencil::Drawing &drawing,
                                    true,
                                    positions.span);
   positions.finish();
-  drawing.tag_positions_changed();
+  drawing.tag_positions_changed(stroke);
 
   if (drawing.opacities().is_span()) {
     bke::GSpanAttributeWriter opacities = attributes.lookup_for_write_span("opacity");
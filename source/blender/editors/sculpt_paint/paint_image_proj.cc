@@ -30,6 +30,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -3799,50 +3800,54 @@ static void proj_paint_state_viewport_init(ProjPaintState *ps, const char symmet
 
 static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
 {
-  float *projScreenCo;
   float projMargin;
-  int a;
 
   INIT_MINMAX2(ps->screenMin, ps->screenMax);
 
   ps->screenCoords = static_cast<float(*)[4]>(
       MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts"));
-  projScreenCo = *ps->screenCoords;
 
-  if (ps->is_ortho) {
-    for (a = 0; a < ps->totvert_eval; a++, projScreenCo += 4) {
-      mul_v3_m4v3(projScreenCo, ps->projectMat, ps->vert_positions_eval[a]);
+  blender::threading::parallel_for(
+      blender::IndexRange(ps->totvert_eval), 4096, [&](const blender::IndexRange range) {
+        for (const int a : range) {
+          float *projScreenCo = ps->screenCoords[a];
+          if (ps->is_ortho) {
+            mul_v3_m4v3(projScreenCo, ps->projectMat, ps->vert_positions_eval[a]);
 
-      /* screen space, not clamped */
-      projScreenCo[0] = float(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
-      projScreenCo[1] = float(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
-      minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-    }
-  }
-  else {
-    for (a = 0; a < ps->totvert_eval; a++, projScreenCo += 4) {
-      copy_v3_v3(projScreenCo, ps->vert_positions_eval[a]);
-      projScreenCo[3] = 1.0f;
-
-      mul_m4_v4(ps->projectMat, projScreenCo);
-
-      if (projScreenCo[3] > ps->clip_start) {
-        /* screen space, not clamped */
-        projScreenCo[0] = float(ps->winx * 0.5f) +
-                          (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
-        projScreenCo[1] = float(ps->winy * 0.5f) +
-                          (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
-        /* Use the depth for bucket point occlusion */
-        projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
-        minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-      }
-      else {
-        /* TODO: deal with cases where 1 side of a face goes behind the view ?
-         *
-         * After some research this is actually very tricky, only option is to
-         * clip the derived mesh before painting, which is a Pain */
-        projScreenCo[0] = FLT_MAX;
-      }
+            /* screen space, not clamped */
+            projScreenCo[0] = float(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
+            projScreenCo[1] = float(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
+            continue;
+          }
+
+          copy_v3_v3(projScreenCo, ps->vert_positions_eval[a]);
+          projScreenCo[3] = 1.0f;
+
+          mul_m4_v4(ps->projectMat, projScreenCo);
+
+          if (projScreenCo[3] > ps->clip_start) {
+            /* screen space, not clamped */
+            projScreenCo[0] = float(ps->winx * 0.5f) +
+                              (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
+            projScreenCo[1] = float(ps->winy * 0.5f) +
+                              (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
+            /* Use the depth for bucket point occlusion */
+            projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
+          }
+          else {
+            /* TODO: deal with cases where 1 side of a face goes behind the view ?
+             *
+             * After some research this is actually very tricky, only option is to
+             * clip the derived mesh before painting, which is a Pain */
+            projScreenCo[0] = FLT_MAX;
+          }
+        }
+      });
+
+  /* Vertices behind the view are tagged with #FLT_MAX and don't contribute to the bounds. */
+  for (int a = 0; a < ps->totvert_eval; a++) {
+    if (ps->is_ortho || ps->screenCoords[a][0] != FLT_MAX) {
+      minmax_v2v2_v2(ps->screenMin, ps->screenMax, ps->screenCoords[a]);
     }
   }
 
@@ -3963,36 +3968,37 @@ static void proj_paint_state_thread_init(ProjPaintState *ps, const bool reset_th
 static void proj_paint_state_vert_flags_init(ProjPaintState *ps)
 {
   if (ps->do_backfacecull && ps->do_mask_normal) {
-    float viewDirPersp[3];
-    float no[3];
-    int a;
-
     ps->vertFlags = MEM_cnew_array<char>(ps->totvert_eval, "paint-vertFlags");
 
-    for (a = 0; a < ps->totvert_eval; a++) {
-      copy_v3_v3(no, ps->vert_normals[a]);
-      if (UNLIKELY(ps->is_flip_object)) {
-        negate_v3(no);
-      }
+    blender::threading::parallel_for(
+        blender::IndexRange(ps->totvert_eval), 4096, [&](const blender::IndexRange range) {
+          for (const int a : range) {
+            float viewDirPersp[3];
+            float no[3];
+            copy_v3_v3(no, ps->vert_normals[a]);
+            if (UNLIKELY(ps->is_flip_object)) {
+              negate_v3(no);
+            }
 
-      if (ps->is_ortho) {
-        if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-      else {
-        sub_v3_v3v3(viewDirPersp, ps->viewPos, ps->vert_positions_eval[a]);
-        normalize_v3(viewDirPersp);
-        if (UNLIKELY(ps->is_flip_object)) {
-          negate_v3(viewDirPersp);
-        }
-        if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-    }
+            if (ps->is_ortho) {
+              if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
+                /* 1 vert of this face is towards us */
+                ps->vertFlags[a] |= PROJ_VERT_CULL;
+              }
+            }
+            else {
+              sub_v3_v3v3(viewDirPersp, ps->viewPos, ps->vert_positions_eval[a]);
+              normalize_v3(viewDirPersp);
+              if (UNLIKELY(ps->is_flip_object)) {
+                negate_v3(viewDirPersp);
+              }
+              if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
+                /* 1 vert of this face is towards us */
+                ps->vertFlags[a] |= PROJ_VERT_CULL;
+              }
+            }
+          }
+        });
   }
   else {
     ps->vertFlags = nullptr;
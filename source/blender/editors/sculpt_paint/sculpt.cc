@@ -7482,11 +7482,7 @@ void transform_positions(const Span<float3> src,
                          const float4x4 &transform,
                          const MutableSpan<float3> dst)
 {
-  BLI_assert(src.size() == dst.size());
-
-  for (const int i : src.index_range()) {
-    dst[i] = math::transform_point(transform, src[i]);
-  }
+  math::transform_points(transform, src, dst);
 }
 
 OffsetIndices<int> create_node_vert_offsets(Span<PBVHNode *> nodes, Array<int> &node_data)
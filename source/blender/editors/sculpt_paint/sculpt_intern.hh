@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <optional>
 #include <queue>
 
@@ -168,6 +169,14 @@ struct Node {
   Array<int> face_sets;
 
   Vector<int> face_indices;
+
+  /**
+   * After the undo step is finished, the float arrays above (except for normals) are compressed
+   * in the background and freed. They are decompressed before the step is restored.
+   */
+  Array<uint8_t> compressed_arrays;
+  /** The sizes of the compressed arrays, used to allocate them again when decompressing. */
+  std::array<int, 6> compressed_array_sizes = {};
 };
 
 }
@@ -31,6 +31,7 @@
 #include "BKE_ccg.hh"
 #include "BKE_context.hh"
 #include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_mesh.hh"
 #include "BKE_mesh_mirror.hh"
@@ -44,6 +45,8 @@
 
 #include "DEG_depsgraph.hh"
 
+#include "GEO_reorder.hh"
+
 #include "IMB_colormanagement.hh"
 
 #include "WM_api.hh"
@@ -135,9 +138,46 @@ static void SCULPT_OT_set_persistent_base(wmOperatorType *ot)
 
 /************************* SCULPT_OT_optimize *************************/
 
-static int sculpt_optimize_exec(bContext *C, wmOperator * /*op*/)
+/**
+ * Reorder the vertices and faces of the mesh so that the data of every BVH node is contiguous
+ * in memory, which makes brush loops over the nodes much more cache friendly.
+ */
+static void sculpt_reorder_mesh_by_nodes(Object &ob, wmOperator *op)
+{
+  using namespace blender;
+  Mesh &mesh = *static_cast<Mesh *>(ob.data);
+  Array<int> vert_order;
+  Array<int> face_order;
+  bke::pbvh::leaf_contiguous_orders_calc(*ob.sculpt->pbvh, mesh, vert_order, face_order);
+
+  ed::sculpt_paint::undo::geometry_begin(ob, op);
+  Mesh *verts_reordered = geometry::reorder_mesh(mesh, vert_order, bke::AttrDomain::Point, {});
+  Mesh *result = geometry::reorder_mesh(
+      *verts_reordered, face_order, bke::AttrDomain::Face, {});
+  BKE_id_free(nullptr, verts_reordered);
+  BKE_mesh_nomain_to_mesh(result, &mesh, &ob);
+  ed::sculpt_paint::undo::geometry_end(ob);
+
+  SCULPT_topology_islands_invalidate(*ob.sculpt);
+  BKE_mesh_batch_cache_dirty_tag(&mesh, BKE_MESH_BATCH_DIRTY_ALL);
+}
+
+static int sculpt_optimize_exec(bContext *C, wmOperator *op)
 {
   Object *ob = CTX_data_active_object(C);
+  SculptSession &ss = *ob->sculpt;
+
+  if (RNA_boolean_get(op->ptr, "reorder_vertices") && ss.pbvh &&
+      BKE_pbvh_type(*ss.pbvh) == PBVH_FACES)
+  {
+    const Mesh &mesh = *static_cast<const Mesh *>(ob->data);
+    if (mesh.key) {
+      BKE_report(op->reports, RPT_WARNING, "Cannot reorder vertices of a mesh with shape keys");
+    }
+    else {
+      sculpt_reorder_mesh_by_nodes(*ob, op);
+    }
+  }
 
   SCULPT_pbvh_clear(*ob);
   WM_event_add_notifier(C, NC_OBJECT | ND_DRAW, ob);
@@ -161,6 +201,13 @@ static void SCULPT_OT_optimize(wmOperatorType *ot)
   ot->poll = SCULPT_mode_poll;
 
   ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+
+  RNA_def_boolean(ot->srna,
+                  "reorder_vertices",
+                  false,
+                  "Reorder Vertices",
+                  "Change the order of the mesh vertices and faces to match the BVH, which makes "
+                  "brushes faster on large meshes");
 }
 
 /********************* Dynamic topology symmetrize ********************/
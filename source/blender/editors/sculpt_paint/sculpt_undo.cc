@@ -30,13 +30,17 @@
  * Operators must have the OPTYPE_UNDO flag set for this to work properly.
  */
 
+#include <atomic>
 #include <cstddef>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.hh"
 #include "BLI_listbase.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_key_types.h"
@@ -208,6 +212,12 @@ struct StepData {
   Vector<std::unique_ptr<Node>> nodes;
 
   size_t undo_size;
+
+  /** Compresses the arrays of the nodes in the background, see #compress_nodes_start. */
+  TaskPool *compress_pool = nullptr;
+  /** Set by the compression task when it is done, #undo_size is updated on the main thread. */
+  std::atomic<bool> compress_finished = false;
+  size_t compressed_undo_size = 0;
 };
 
 struct SculptAttrRef {
@@ -1736,9 +1746,199 @@ static size_t node_size_in_bytes(const Node &node)
   size += node.grid_hidden.all_bits().size() / 8;
   size += node.face_sets.as_span().size_in_bytes();
   size += node.face_indices.as_span().size_in_bytes();
+  size += node.compressed_arrays.as_span().size_in_bytes();
   return size;
 }
 
+static size_t nodes_size_in_bytes(const Span<std::unique_ptr<Node>> nodes)
+{
+  return threading::parallel_reduce(
+      nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Node Data Compression
+ *
+ * Long sculpting sessions create many undo steps with copies of large parts of the mesh data.
+ * To reduce memory usage, the float arrays of finished steps are compressed on a background
+ * thread. The compression is lossless, since restoring swaps the stored values with the current
+ * ones. Every 32 bit value is combined with the same component of the previous element with XOR,
+ * which gives many zero bits because neighboring vertices have similar values. The bytes are then
+ * grouped by their significance before they are compressed with zstd.
+ * \{ */
+
+/* Fast compression, most of the size reduction comes from the XOR and byte grouping. */
+#define NODE_COMPRESSION_LEVEL 1
+
+/** Call #fn for every compressed array of the node with the number of floats per element. */
+template<typename Fn> static void foreach_compressed_array(Node &unode, const Fn &fn)
+{
+  fn(unode.position, 3);
+  fn(unode.orig_position, 3);
+  fn(unode.col, 4);
+  fn(unode.mask, 1);
+  fn(unode.loop_col, 4);
+  fn(unode.orig_loop_col, 4);
+}
+
+static void compress_node(Node &unode)
+{
+  BLI_assert(unode.compressed_arrays.is_empty());
+  int64_t words_num = 0;
+  foreach_compressed_array(unode, [&](const auto &array, const int /*components*/) {
+    words_num += array.as_span().size_in_bytes() / sizeof(uint32_t);
+  });
+  if (words_num == 0) {
+    return;
+  }
+
+  Array<uint8_t> shuffled(words_num * sizeof(uint32_t), NoInitialization());
+  int64_t offset = 0;
+  foreach_compressed_array(unode, [&](const auto &array, const int components) {
+    const Span<uint32_t> words = array.as_span().template cast<uint32_t>();
+    for (const int64_t i : words.index_range()) {
+      const uint32_t word = i < components ? words[i] : words[i] ^ words[i - components];
+      for (const int byte : IndexRange(sizeof(uint32_t))) {
+        shuffled[byte * words_num + offset + i] = uint8_t(word >> (byte * 8));
+      }
+    }
+    offset += words.size();
+  });
+
+  Array<uint8_t> buffer(ZSTD_compressBound(shuffled.size()), NoInitialization());
+  const size_t compressed_size = ZSTD_compress(
+      buffer.data(), buffer.size(), shuffled.data(), shuffled.size(), NODE_COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size) || compressed_size >= shuffled.size()) {
+    /* Keep the uncompressed data. */
+    return;
+  }
+
+  unode.compressed_arrays = buffer.as_span().take_front(compressed_size);
+  int array_index = 0;
+  foreach_compressed_array(unode, [&](auto &array, const int /*components*/) {
+    unode.compressed_array_sizes[array_index++] = array.size();
+    array = {};
+  });
+}
+
+static void decompress_node(Node &unode)
+{
+  if (unode.compressed_arrays.is_empty()) {
+    return;
+  }
+  int array_index = 0;
+  int64_t words_num = 0;
+  foreach_compressed_array(unode, [&](auto &array, const int components) {
+    array.reinitialize(unode.compressed_array_sizes[array_index++]);
+    words_num += int64_t(array.size()) * components;
+  });
+
+  Array<uint8_t> shuffled(words_num * sizeof(uint32_t), NoInitialization());
+  const size_t size = ZSTD_decompress(shuffled.data(),
+                                      shuffled.size(),
+                                      unode.compressed_arrays.data(),
+                                      unode.compressed_arrays.size());
+  BLI_assert(size == shuffled.size());
+  UNUSED_VARS_NDEBUG(size);
+
+  int64_t offset = 0;
+  foreach_compressed_array(unode, [&](auto &array, const int components) {
+    MutableSpan<uint32_t> words = array.as_mutable_span().template cast<uint32_t>();
+    for (const int64_t i : words.index_range()) {
+      uint32_t word = 0;
+      for (const int byte : IndexRange(sizeof(uint32_t))) {
+        word |= uint32_t(shuffled[byte * words_num + offset + i]) << (byte * 8);
+      }
+      words[i] = i < components ? word : word ^ words[i - components];
+    }
+    offset += words.size();
+  });
+
+  unode.compressed_arrays = {};
+  unode.compressed_array_sizes = {};
+}
+
+static void compress_nodes_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  StepData &step_data = *static_cast<StepData *>(taskdata);
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    compress_node(*unode);
+  }
+  size_t size = 0;
+  for (const std::unique_ptr<Node> &unode : step_data.nodes) {
+    size += node_size_in_bytes(*unode);
+  }
+  step_data.compressed_undo_size = size;
+  step_data.compress_finished.store(true, std::memory_order_release);
+}
+
+/**
+ * Start compressing the node data in the background. The step must not be modified or restored
+ * until #compress_nodes_wait is called.
+ */
+static void compress_nodes_start(StepData &step_data)
+{
+  BLI_assert(step_data.compress_pool == nullptr);
+  if (step_data.nodes.is_empty()) {
+    return;
+  }
+  step_data.compress_finished = false;
+  step_data.compress_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(step_data.compress_pool, compress_nodes_task, &step_data, false, nullptr);
+}
+
+static void compress_nodes_wait(StepData &step_data)
+{
+  if (step_data.compress_pool == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(step_data.compress_pool);
+  BLI_task_pool_free(step_data.compress_pool);
+  step_data.compress_pool = nullptr;
+  step_data.undo_size = step_data.compressed_undo_size;
+}
+
+static void decompress_nodes(StepData &step_data)
+{
+  compress_nodes_wait(step_data);
+  threading::parallel_for(step_data.nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      decompress_node(*step_data.nodes[i]);
+    }
+  });
+}
+
+/**
+ * Update the memory usage of the undo steps whose compression finished in the meantime, so that
+ * the undo memory limit takes the reduced size into account.
+ */
+static void compressed_step_sizes_update(UndoStack &ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us, &ustack.steps) {
+    if (us->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      continue;
+    }
+    StepData &step_data = reinterpret_cast<SculptUndoStep *>(us)->data;
+    if (step_data.compress_pool &&
+        step_data.compress_finished.load(std::memory_order_acquire))
+    {
+      compress_nodes_wait(step_data);
+      us->data_size = step_data.undo_size;
+    }
+  }
+}
+
+/** \} */
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1755,17 +1955,8 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
     unode->normal = {};
   }
 
-  step_data->undo_size = threading::parallel_reduce(
-      step_data->nodes.index_range(),
-      16,
-      0,
-      [&](const IndexRange range, size_t size) {
-        for (const int i : range) {
-          size += node_size_in_bytes(*step_data->nodes[i]);
-        }
-        return size;
-      },
-      std::plus<size_t>());
+  step_data->undo_size = nodes_size_in_bytes(step_data->nodes);
+  compress_nodes_start(*step_data);
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -1773,6 +1964,7 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
     UndoStack *ustack = ED_undo_stack_get();
     BKE_undosys_step_push(ustack, nullptr, nullptr);
     if (wm->op_undo_depth == 0) {
+      compressed_step_sizes_update(*ustack);
       BKE_undosys_stack_limit_steps_and_memory_defaults(ustack);
     }
     WM_file_tag_modified();
@@ -1868,7 +2060,9 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_start(us->data);
   us->step.is_applied = false;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
@@ -1878,7 +2072,9 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+  decompress_nodes(us->data);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_start(us->data);
   us->step.is_applied = true;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
@@ -1993,6 +2189,7 @@ static void step_decode(
 static void step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  compress_nodes_wait(us->data);
   free_step_data(us->data);
 }
 
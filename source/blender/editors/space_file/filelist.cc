@@ -36,9 +36,11 @@
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_math_vector.h"
+#include "BLI_map.hh"
 #include "BLI_stack.h"
 #include "BLI_string_utils.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include "BLI_uuid.h"
@@ -3297,6 +3299,120 @@ static int filelist_readjob_list_lib_populate_from_index(FileListReadJob *job_pa
 }
 
 /**
+ * The linkable groups of a library file, with the data-blocks of each group when listing
+ * recursively. Reading them from the library file is thread-safe, unlike adding them to the file
+ * list.
+ */
+struct ListLibGroups {
+  struct Group {
+    std::string name;
+    int idcode;
+    LinkNode * /*BLODataBlockInfo*/ datablock_infos = nullptr;
+    int datablock_len = 0;
+  };
+  Vector<Group> groups;
+
+  ListLibGroups() = default;
+  ListLibGroups(const ListLibGroups &) = delete;
+  ListLibGroups &operator=(const ListLibGroups &) = delete;
+  ~ListLibGroups()
+  {
+    for (Group &group : groups) {
+      BLO_datablock_info_linklist_free(group.datablock_infos);
+    }
+  }
+};
+
+static void filelist_readjob_list_lib_groups_read(BlendHandle *libfiledata,
+                                                  const ListLibOptions options,
+                                                  ListLibGroups &r_groups)
+{
+  LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
+  for (LinkNode *ln = groups; ln; ln = ln->next) {
+    ListLibGroups::Group group;
+    group.name = static_cast<char *>(ln->link);
+    group.idcode = groupname_to_code(group.name.c_str());
+    if (options & LIST_LIB_RECURSIVE) {
+      group.datablock_infos = BLO_blendhandle_get_datablock_info(
+          libfiledata, group.idcode, options & LIST_LIB_ASSETS_ONLY, &group.datablock_len);
+    }
+    r_groups.groups.append(std::move(group));
+  }
+  BLI_linklist_freeN(groups);
+}
+
+/**
+ * A library file that was read ahead of time by #filelist_readjob_list_libs_prefetch, before
+ * it is listed by #filelist_readjob_list_lib.
+ */
+struct ListLibPrefetch {
+  eFileIndexerResult indexer_result = FILE_INDEXER_NEEDS_UPDATE;
+  FileIndexerEntries indexer_entries = {nullptr};
+  int read_from_index = 0;
+  /** When the index needs an update: whether the library file could be read. */
+  bool is_valid = false;
+  ListLibGroups groups;
+
+  ~ListLibPrefetch()
+  {
+    ED_file_indexer_entries_clear(&indexer_entries);
+  }
+};
+
+/** Library files that were read ahead of time, by the path of the library file. */
+using ListLibPrefetches = Map<std::string, std::unique_ptr<ListLibPrefetch>>;
+
+/**
+ * Read the library files in \a lib_dirs ahead of time. Their index is checked first, the library
+ * files that are not indexed yet (or with an outdated index) are then read in parallel. Reading a
+ * large asset library for the first time is dominated by opening these files.
+ */
+static void filelist_readjob_list_libs_prefetch(const Span<std::string> lib_dirs,
+                                                const ListLibOptions options,
+                                                FileIndexer *indexer_runtime,
+                                                const bool *stop,
+                                                ListLibPrefetches &r_prefetches)
+{
+  Vector<std::pair<std::string, ListLibPrefetch *>> to_read;
+  for (const std::string &lib_dir : lib_dirs) {
+    char dir[FILE_MAX_LIBEXTRA], *group;
+    if (!BKE_blendfile_library_path_explode(lib_dir.c_str(), dir, &group, nullptr) ||
+        group != nullptr)
+    {
+      continue;
+    }
+    std::unique_ptr<ListLibPrefetch> prefetch = std::make_unique<ListLibPrefetch>();
+    prefetch->indexer_result = indexer_runtime->callbacks->read_index(
+        dir, &prefetch->indexer_entries, &prefetch->read_from_index, indexer_runtime->user_data);
+    if (prefetch->indexer_result == FILE_INDEXER_NEEDS_UPDATE) {
+      to_read.append({dir, prefetch.get()});
+    }
+    r_prefetches.add_overwrite(dir, std::move(prefetch));
+  }
+
+  threading::parallel_for(to_read.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (*stop) {
+        return;
+      }
+      ListLibPrefetch &prefetch = *to_read[i].second;
+      BlendFileReadReport bf_reports{};
+      BlendHandle *libfiledata = BLO_blendhandle_from_file(to_read[i].first.c_str(),
+                                                           &bf_reports);
+      if (libfiledata == nullptr) {
+        continue;
+      }
+      filelist_readjob_list_lib_groups_read(libfiledata, options, prefetch.groups);
+      BLO_blendhandle_close(libfiledata);
+      prefetch.is_valid = true;
+    }
+  });
+}
+
+/**
+ * \param prefetch: The library file read ahead of time by #filelist_readjob_list_libs_prefetch,
+ * if any.
+ *
  * \return The number of entries found if the \a root path points to a valid library file.
  *         Otherwise returns no value (#std::nullopt).
  */
@@ -3304,7 +3420,8 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
                                                     const char *root,
                                                     ListBase *entries,
                                                     const ListLibOptions options,
-                                                    FileIndexer *indexer_runtime)
+                                                    FileIndexer *indexer_runtime,
+                                                    ListLibPrefetch *prefetch)
 {
   BLI_assert(indexer_runtime);
 
@@ -3334,8 +3451,18 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
    * Adding support for partial reading/updating indexes would increase the complexity.
    */
   const bool use_indexer = !has_group;
+  BLI_assert(prefetch == nullptr || use_indexer);
   FileIndexerEntries indexer_entries = {nullptr};
-  if (use_indexer) {
+  if (prefetch) {
+    if (prefetch->indexer_result == FILE_INDEXER_ENTRIES_LOADED) {
+      return filelist_readjob_list_lib_populate_from_index(job_params,
+                                                           entries,
+                                                           options,
+                                                           prefetch->read_from_index,
+                                                           &prefetch->indexer_entries);
+    }
+  }
+  else if (use_indexer) {
     int read_from_index = 0;
     eFileIndexerResult indexer_result = indexer_runtime->callbacks->read_index(
         dir, &indexer_entries, &read_from_index, indexer_runtime->user_data);
@@ -3347,11 +3474,18 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     }
   }
 
-  /* Open the library file. */
-  BlendFileReadReport bf_reports{};
-  libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
-  if (libfiledata == nullptr) {
-    return std::nullopt;
+  /* Open the library file, unless it was read ahead of time already. */
+  if (prefetch) {
+    if (!prefetch->is_valid) {
+      return std::nullopt;
+    }
+  }
+  else {
+    BlendFileReadReport bf_reports{};
+    libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
+    if (libfiledata == nullptr) {
+      return std::nullopt;
+    }
   }
 
   /* Add current parent when requested. */
@@ -3379,35 +3513,33 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
   }
   /* Read all datablocks from all groups. */
   else {
-    LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
-    group_len = BLI_linklist_count(groups);
+    ListLibGroups local_groups;
+    if (prefetch == nullptr) {
+      filelist_readjob_list_lib_groups_read(libfiledata, options, local_groups);
+    }
+    const ListLibGroups &lib_groups = prefetch ? prefetch->groups : local_groups;
+    group_len = lib_groups.groups.size();
 
-    for (LinkNode *ln = groups; ln; ln = ln->next) {
-      const char *group_name = static_cast<char *>(ln->link);
-      const int idcode = groupname_to_code(group_name);
+    for (const ListLibGroups::Group &group : lib_groups.groups) {
       FileListInternEntry *group_entry = filelist_readjob_list_lib_group_create(
-          job_params, idcode, group_name);
+          job_params, group.idcode, group.name.c_str());
       BLI_addtail(entries, group_entry);
 
       if (options & LIST_LIB_RECURSIVE) {
-        int group_datablock_len;
-        LinkNode *group_datablock_infos = BLO_blendhandle_get_datablock_info(
-            libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &group_datablock_len);
         filelist_readjob_list_lib_add_datablocks(
-            job_params, entries, group_datablock_infos, true, idcode, group_name);
+            job_params, entries, group.datablock_infos, true, group.idcode, group.name.c_str());
         if (use_indexer) {
           ED_file_indexer_entries_extend_from_datablock_infos(
-              &indexer_entries, group_datablock_infos, idcode);
+              &indexer_entries, group.datablock_infos, group.idcode);
         }
-        BLO_datablock_info_linklist_free(group_datablock_infos);
-        datablock_len += group_datablock_len;
+        datablock_len += group.datablock_len;
       }
     }
-
-    BLI_linklist_freeN(groups);
   }
 
-  BLO_blendhandle_close(libfiledata);
+  if (libfiledata) {
+    BLO_blendhandle_close(libfiledata);
+  }
 
   /* Update the index. */
   if (use_indexer) {
@@ -3684,6 +3816,8 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
   if (indexer_runtime.callbacks->init_user_data) {
     indexer_runtime.user_data = indexer_runtime.callbacks->init_user_data(dir, sizeof(dir));
   }
+  ListLibPrefetches lib_prefetches;
+  Vector<std::string> new_lib_dirs;
 
   while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
     int entries_num = 0;
@@ -3713,25 +3847,32 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
     /* Update the current relative base path within the filelist root. */
     STRNCPY(job_params->cur_relbase, rel_subdir);
 
+    /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
+     * still a recursion level over. */
+    ListLibOptions list_lib_read_options = LIST_LIB_OPTION_NONE;
+    if (max_recursion > 0) {
+      list_lib_read_options |= LIST_LIB_RECURSIVE;
+    }
+    /* Only load assets when browsing an asset library. For normal file browsing we return all
+     * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
+    if (job_params->load_asset_library) {
+      list_lib_read_options |= LIST_LIB_ASSETS_ONLY;
+    }
+
     bool is_lib = false;
     if (do_lib) {
-      ListLibOptions list_lib_options = LIST_LIB_OPTION_NONE;
+      ListLibOptions list_lib_options = list_lib_read_options;
       if (!skip_currpar) {
         list_lib_options |= LIST_LIB_ADD_PARENT;
       }
 
-      /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
-       * still a recursion level over. */
-      if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
-      }
-      /* Only load assets when browsing an asset library. For normal file browsing we return all
-       * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
-      if (job_params->load_asset_library) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
+      char lib_path[FILE_MAX_LIBEXTRA], *lib_group;
+      std::unique_ptr<ListLibPrefetch> prefetch;
+      if (BKE_blendfile_library_path_explode(subdir, lib_path, &lib_group, nullptr)) {
+        prefetch = lib_prefetches.pop_default(lib_path, nullptr);
       }
       std::optional<int> lib_entries_num = filelist_readjob_list_lib(
-          job_params, subdir, &entries, list_lib_options, &indexer_runtime);
+          job_params, subdir, &entries, list_lib_options, &indexer_runtime, prefetch.get());
       if (lib_entries_num) {
         is_lib = true;
         entries_num += *lib_entries_num;
@@ -3765,9 +3906,19 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
         td_dir->level = recursion_level + 1;
         td_dir->dir = BLI_strdup(dir);
         dirs_todo_count++;
+        if (do_lib && (entry->typeflag & FILE_TYPE_BLENDER)) {
+          new_lib_dirs.append(dir);
+        }
       }
     }
 
+    /* Read the library files of this directory before listing them one by one. */
+    if (!new_lib_dirs.is_empty()) {
+      filelist_readjob_list_libs_prefetch(
+          new_lib_dirs, list_lib_read_options, &indexer_runtime, stop, lib_prefetches);
+      new_lib_dirs.clear();
+    }
+
     if (filelist_readjob_append_entries(job_params, &entries, entries_num)) {
       *do_update = true;
     }
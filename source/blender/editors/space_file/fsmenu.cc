@@ -41,9 +41,14 @@ struct FSMenu {
 };
 
 static FSMenu *g_fsmenu = nullptr;
+static bool g_fsmenu_read_pending = false;
 
 FSMenu *ED_fsmenu_get()
 {
+  if (g_fsmenu_read_pending) {
+    /* Clears the pending read, see #fsmenu_free. */
+    ED_file_read_bookmarks();
+  }
   if (!g_fsmenu) {
     g_fsmenu = MEM_cnew<FSMenu>(__func__);
   }
@@ -537,6 +542,13 @@ static void fsmenu_free_ex(FSMenu **fsmenu)
 void fsmenu_free()
 {
   fsmenu_free_ex(&g_fsmenu);
+  g_fsmenu_read_pending = false;
+}
+
+void fsmenu_read_bookmarks_on_first_use()
+{
+  fsmenu_free();
+  g_fsmenu_read_pending = true;
 }
 
 static void fsmenu_copy_category(FSMenu *fsmenu_dst,
@@ -57,6 +57,9 @@ void fsmenu_read_system(struct FSMenu *fsmenu, int read_bookmarks);
 /** Frees all the memory associated with the `fsmenu`. */
 void fsmenu_free(void);
 
+/** Postpone reading the bookmarks with #ED_file_read_bookmarks until the menu is first used. */
+void fsmenu_read_bookmarks_on_first_use(void);
+
 /** Refresh system directory menu */
 void fsmenu_refresh_system_category(struct FSMenu *fsmenu);
 
@@ -1024,11 +1024,16 @@ void ED_spacetype_file()
 
 void ED_file_init()
 {
-  ED_file_read_bookmarks();
-
   if (G.background == false) {
+    ED_file_read_bookmarks();
     filelist_init_icons();
   }
+  else {
+    /* Reading the system bookmarks checks the mounted volumes, which can be slow, especially
+     * with network drives. There is no file browser in background mode, so only read them when
+     * a script actually uses them. */
+    fsmenu_read_bookmarks_on_first_use();
+  }
 
   IMB_thumb_makedirs();
 }
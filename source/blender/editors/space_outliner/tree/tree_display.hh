@@ -155,6 +155,8 @@ class TreeDisplayViewLayer final : public AbstractTreeDisplay {
 
   bool supports_mode_column() const override;
 
+  bool is_lazy_built() const override;
+
  private:
   void add_view_layer(Scene &, ListBase &, TreeElement *);
   void add_layer_collections_recursive(ListBase &, ListBase &, TreeElement &);
@@ -59,6 +59,12 @@ bool TreeDisplayViewLayer::supports_mode_column() const
   return true;
 }
 
+bool TreeDisplayViewLayer::is_lazy_built() const
+{
+  /* Object contents are only added for open objects, see #TreeElementIDObject. */
+  return true;
+}
+
 ListBase TreeDisplayViewLayer::build_tree(const TreeSourceData &source_data)
 {
   ListBase tree = {nullptr};
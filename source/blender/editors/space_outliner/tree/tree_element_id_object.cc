@@ -13,11 +13,14 @@
 #include "DNA_armature_types.h"
 #include "DNA_object_types.h"
 #include "DNA_outliner_types.h"
+#include "DNA_space_types.h"
 
 #include "BKE_deform.hh"
 
 #include "../outliner_intern.hh"
 
+#include "common.hh"
+#include "tree_display.hh"
 #include "tree_element_id_object.hh"
 
 namespace blender::ed::outliner {
@@ -27,11 +30,19 @@ TreeElementIDObject::TreeElementIDObject(TreeElement &legacy_te, Object &object)
 {
 }
 
-void TreeElementIDObject::expand(SpaceOutliner & /*space_outliner*/) const
+void TreeElementIDObject::expand(SpaceOutliner &space_outliner) const
 {
   /* tuck pointer back in object, to construct hierarchy */
   object_.id.newid = (ID *)(&legacy_te_);
 
+  if (is_expand_deferred(space_outliner)) {
+    /* Contents of objects are removed by this filter anyway. */
+    if ((space_outliner.filter & SO_FILTER_NO_OB_CONTENT) == 0 && has_contents()) {
+      legacy_te_.flag |= TE_PRETEND_HAS_CHILDREN;
+    }
+    return;
+  }
+
   expand_animation_data(object_.adt);
   expand_pose();
   expand_data();
@@ -44,6 +55,31 @@ void TreeElementIDObject::expand(SpaceOutliner & /*space_outliner*/) const
   expand_duplicated_group();
 }
 
+bool TreeElementIDObject::is_expand_deferred(const SpaceOutliner &space_outliner) const
+{
+  /* In big scenes most objects are collapsed, and adding their contents (data, materials,
+   * modifiers, ...) makes up most of the tree. Lazily built displays are rebuilt when an element
+   * is opened, so these contents only have to be added for open objects. Objects in a mode other
+   * than object mode are always expanded, so their active bones etc. can be found. */
+  if (!display_ || !display_->is_lazy_built()) {
+    return false;
+  }
+  if (SEARCHING_OUTLINER(&space_outliner) || object_.mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  return !TSELEM_OPEN(legacy_te_.store_elem, &space_outliner);
+}
+
+bool TreeElementIDObject::has_contents() const
+{
+  return object_.data || object_.pose || object_.totcol > 0 ||
+         outliner_animdata_test(object_.adt) || !BLI_listbase_is_empty(&object_.constraints) ||
+         !BLI_listbase_is_empty(&object_.modifiers) ||
+         !BLI_listbase_is_empty(&object_.greasepencil_modifiers) ||
+         !BLI_listbase_is_empty(&object_.shader_fx) ||
+         (object_.instance_collection && (object_.transflag & OB_DUPLICOLLECTION));
+}
+
 void TreeElementIDObject::expand_data() const
 {
   add_element(
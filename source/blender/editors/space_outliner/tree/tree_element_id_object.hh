@@ -21,6 +21,8 @@ class TreeElementIDObject final : public TreeElementID {
   void expand(SpaceOutliner &) const override;
 
  private:
+  bool is_expand_deferred(const SpaceOutliner &space_outliner) const;
+  bool has_contents() const;
   void expand_data() const;
   void expand_pose() const;
   void expand_materials() const;
@@ -70,6 +70,27 @@ static bool memfile_undosys_poll(bContext *C)
   return true;
 }
 
+/**
+ * Compress the memory of global undo steps before \a us_reference, the step the new step is
+ * written against. Those are only read when undoing further back, and are decompressed then.
+ */
+static void memfile_undosys_compress_old_steps(MemFileUndoStep *us_reference)
+{
+  MemFileUndoStep *us_next = us_reference;
+  for (UndoStep *us_iter = us_reference->step.prev; us_iter; us_iter = us_iter->prev) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+      continue;
+    }
+    MemFileUndoStep *us = (MemFileUndoStep *)us_iter;
+    if (!us->data->memfile.is_compressed) {
+      BLO_memfile_compress(&us->data->memfile, &us_next->data->memfile);
+      us->data->undo_size = us->data->memfile.size;
+      us->step.data_size = us->data->undo_size;
+    }
+    us_next = us;
+  }
+}
+
 static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
 {
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
@@ -87,6 +108,10 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr);
   us->step.data_size = us->data->undo_size;
 
+  if (us_prev) {
+    memfile_undosys_compress_old_steps(us_prev);
+  }
+
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
@@ -203,6 +228,10 @@ static void memfile_undosys_step_decode(
   ED_preview_kill_jobs(CTX_wm_manager(C), bmain);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  /* Older steps are compressed, see #memfile_undosys_compress_old_steps. */
+  BLO_memfile_decompress(&us->data->memfile);
+  us->data->undo_size = us->data->memfile.size;
+  us->step.data_size = us->data->undo_size;
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
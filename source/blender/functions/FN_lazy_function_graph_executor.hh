@@ -11,6 +11,9 @@
  * another #Graph again).
  */
 
+#include <atomic>
+
+#include "BLI_array.hh"
 #include "BLI_vector.hh"
 #include "BLI_vector_set.hh"
 
@@ -118,6 +121,14 @@ class GraphExecutor : public LazyFunction {
     int total_size;
   } init_buffer_info_;
 
+  /**
+   * Estimated execution time of every node in nanoseconds, indexed by #Node::index_in_graph. It is
+   * updated whenever a node is executed, so that later evaluations of the graph know which nodes
+   * are expensive before they run. The executor is usually kept alive between evaluations (e.g. it
+   * is cached per node tree), so this is what makes the estimate useful.
+   */
+  mutable Array<std::atomic<int64_t>> node_execution_time_estimates_;
+
   friend class Executor;
 
  public:
@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup fn
+ *
+ * A #FusedFunction evaluates a tree of element-wise multi-functions as a single multi-function.
+ * Instead of computing every intermediate value for all indices before moving on to the next
+ * function, the indices are processed in small chunks. That way the intermediate values stay in
+ * the CPU cache, which is what makes long chains of cheap math functions memory bound otherwise.
+ */
+
+#include "FN_multi_function.hh"
+
+namespace blender::fn::multi_function {
+
+class FusedFunction : public MultiFunction {
+ public:
+  /** Describes where a parameter of a fused function gets its value from or writes it to. */
+  struct ParamSource {
+    enum class Type {
+      /** An input parameter of the #FusedFunction. */
+      Input,
+      /** A value computed by one step and used by exactly one later step. */
+      Intermediate,
+      /** The output parameter of the #FusedFunction. */
+      Output,
+    };
+    Type type;
+    /** Index of the input or intermediate value. Unused for the output. */
+    int index = 0;
+  };
+
+  struct Step {
+    const MultiFunction *fn;
+    /** Source of every parameter of #fn. */
+    Vector<ParamSource> params;
+  };
+
+ private:
+  Signature signature_;
+  Vector<Step> steps_;
+  Vector<const CPPType *> intermediate_types_;
+
+ public:
+  /**
+   * \param steps: Functions in the order they are evaluated in. The last one computes the output.
+   */
+  FusedFunction(Span<const CPPType *> input_types,
+                const CPPType &output_type,
+                Vector<Step> steps,
+                Vector<const CPPType *> intermediate_types);
+
+  void call(const IndexMask &mask, Params params, Context context) const override;
+  std::string debug_name() const override;
+
+  /**
+   * Only functions with single value inputs and exactly one single value output can be fused,
+   * because the result for every index is computed independently of the others then.
+   */
+  static bool is_fusable(const MultiFunction &fn);
+
+ private:
+  void call_steps(const IndexMask &mask,
+                  Span<GVArray> inputs,
+                  GMutableSpan output,
+                  Span<void *> intermediate_buffers,
+                  Context context) const;
+
+  ExecutionHints get_execution_hints() const override;
+};
+
+}  // namespace blender::fn::multi_function
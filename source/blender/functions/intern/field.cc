@@ -11,6 +11,7 @@
 
 #include "FN_field.hh"
 #include "FN_multi_function_builder.hh"
+#include "FN_multi_function_fused.hh"
 #include "FN_multi_function_procedure.hh"
 #include "FN_multi_function_procedure_builder.hh"
 #include "FN_multi_function_procedure_executor.hh"
@@ -140,17 +141,94 @@ static Set<GFieldRef> find_varying_fields(const FieldTreeInfo &field_tree_info,
   return found_fields;
 }
 
+/**
+ * A tree of element-wise operations that is evaluated by a single #mf::FusedFunction, so that
+ * the intermediate values never have to be stored for all indices.
+ */
+struct FusedOperations {
+  /** Fields computed outside of the tree, which are passed into the fused function. */
+  VectorSet<GFieldRef> inputs;
+  Vector<mf::FusedFunction::Step> steps;
+  Vector<const CPPType *> intermediate_types;
+};
+
+/**
+ * An operation can be evaluated as part of the fused function of its user when its result is not
+ * needed anywhere else. Fields that are the same for all indices are left out, they are cheaper to
+ * evaluate only once.
+ */
+static bool is_fusable_into_user(const GFieldRef field,
+                                 const FieldTreeInfo &field_tree_info,
+                                 const Set<GFieldRef> &varying_fields,
+                                 const Span<GFieldRef> output_fields)
+{
+  if (field.node().node_type() != FieldNodeType::Operation) {
+    return false;
+  }
+  const FieldOperation &operation = static_cast<const FieldOperation &>(field.node());
+  return mf::FusedFunction::is_fusable(operation.multi_function()) &&
+         field_tree_info.field_users.lookup(field).size() == 1 &&
+         varying_fields.contains(field) && !output_fields.contains(field);
+}
+
+static void add_fused_operation_steps(const FieldOperation &operation,
+                                      const mf::FusedFunction::ParamSource output_source,
+                                      const FieldTreeInfo &field_tree_info,
+                                      const Set<GFieldRef> &varying_fields,
+                                      const Span<GFieldRef> output_fields,
+                                      FusedOperations &r_fused)
+{
+  using ParamSource = mf::FusedFunction::ParamSource;
+  const mf::MultiFunction &fn = operation.multi_function();
+  mf::FusedFunction::Step step;
+  step.fn = &fn;
+  step.params.resize(fn.param_amount());
+  int param_input_index = 0;
+  for (const int param_index : fn.param_indices()) {
+    if (fn.param_type(param_index).interface_type() == mf::ParamType::Output) {
+      step.params[param_index] = output_source;
+      continue;
+    }
+    const GFieldRef input_field = operation.inputs()[param_input_index];
+    param_input_index++;
+    if (is_fusable_into_user(input_field, field_tree_info, varying_fields, output_fields)) {
+      const int intermediate_index = r_fused.intermediate_types.append_and_get_index(
+          &input_field.cpp_type());
+      const ParamSource source{ParamSource::Type::Intermediate, intermediate_index};
+      add_fused_operation_steps(static_cast<const FieldOperation &>(input_field.node()),
+                                source,
+                                field_tree_info,
+                                varying_fields,
+                                output_fields,
+                                r_fused);
+      step.params[param_index] = source;
+    }
+    else {
+      step.params[param_index] = {ParamSource::Type::Input,
+                                  int(r_fused.inputs.index_of_or_add(input_field))};
+    }
+  }
+  /* Steps of the inputs have been added above already. */
+  r_fused.steps.append(std::move(step));
+}
+
 /**
  * Builds the #procedure so that it computes the fields.
+ *
+ * \param varying_fields: When provided, chains of element-wise operations on varying fields are
+ * fused into a single function call.
  */
 static void build_multi_function_procedure_for_fields(mf::Procedure &procedure,
                                                       ResourceScope &scope,
                                                       const FieldTreeInfo &field_tree_info,
-                                                      Span<GFieldRef> output_fields)
+                                                      Span<GFieldRef> output_fields,
+                                                      const Set<GFieldRef> *varying_fields)
 {
   mf::ProcedureBuilder builder{procedure};
   /* Every input, intermediate and output field corresponds to a variable in the procedure. */
   Map<GFieldRef, mf::Variable *> variable_by_field;
+  /* Operations which are evaluated together with the operations they depend on. */
+  Map<GFieldRef, FusedOperations> fused_operations_by_field;
 
   /* Start by adding the field inputs as parameters to the procedure. */
   for (const FieldInput &field_input : field_tree_info.deduplicated_field_inputs) {
@@ -188,7 +266,48 @@ static void build_multi_function_procedure_for_fields(mf::Procedure &procedure,
           const FieldOperation &operation_node = static_cast<const FieldOperation &>(field.node());
           const Span<GField> operation_inputs = operation_node.inputs();
 
-          if (field_with_index.current_input_index < operation_inputs.size()) {
+          if (field_with_index.current_input_index == 0 && varying_fields != nullptr &&
+              mf::FusedFunction::is_fusable(operation_node.multi_function()))
+          {
+            FusedOperations fused;
+            add_fused_operation_steps(operation_node,
+                                      {mf::FusedFunction::ParamSource::Type::Output},
+                                      field_tree_info,
+                                      *varying_fields,
+                                      output_fields,
+                                      fused);
+            if (fused.steps.size() > 1) {
+              fused_operations_by_field.add_new(field, std::move(fused));
+            }
+          }
+          const FusedOperations *fused = fused_operations_by_field.lookup_ptr(field);
+
+          if (fused != nullptr) {
+            if (field_with_index.current_input_index < fused->inputs.size()) {
+              /* Only the inputs of the fused tree need variables. */
+              fields_to_check.push({fused->inputs[field_with_index.current_input_index]});
+              field_with_index.current_input_index++;
+            }
+            else {
+              Vector<const CPPType *> input_types;
+              Vector<mf::Variable *> variables;
+              for (const GFieldRef &input_field : fused->inputs) {
+                input_types.append(&input_field.cpp_type());
+                variables.append(variable_by_field.lookup(input_field));
+              }
+              const mf::MultiFunction &fused_fn = procedure.construct_function<mf::FusedFunction>(
+                  input_types.as_span(),
+                  field.cpp_type(),
+                  fused->steps,
+                  fused->intermediate_types);
+              mf::Variable &new_variable = procedure.new_variable(
+                  mf::DataType::ForSingle(field.cpp_type()));
+              variables.append(&new_variable);
+              variable_by_field.add_new(field, &new_variable);
+              builder.add_call_with_all_variables(fused_fn, variables);
+            }
+          }
+          else if (field_with_index.current_input_index < operation_inputs.size()) {
             /* Not all inputs are handled yet. Push the next input field to the stack and increment
              * the input index. */
             fields_to_check.push({operation_inputs[field_with_index.current_input_index]});
@@ -370,7 +489,7 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     /* Build the procedure for those fields. */
     mf::Procedure procedure;
     build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, varying_fields_to_evaluate);
+        procedure, scope, field_tree_info, varying_fields_to_evaluate, &varying_fields);
     mf::ProcedureExecutor procedure_executor{procedure};
 
     mf::ParamsBuilder mf_params{procedure_executor, &mask};
@@ -422,7 +541,7 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
     /* Build the procedure for those fields. */
     mf::Procedure procedure;
     build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, constant_fields_to_evaluate);
+        procedure, scope, field_tree_info, constant_fields_to_evaluate, nullptr);
     mf::ProcedureExecutor procedure_executor{procedure};
     const IndexMask mask(1);
     mf::ParamsBuilder mf_params{procedure_executor, &mask};
@@ -55,6 +55,12 @@
 
 namespace blender::fn::lazy_function {
 
+/**
+ * Nodes that took longer than this in a previous evaluation are executed while other threads can
+ * work on the remaining scheduled nodes. This is much larger than the overhead of pushing a task.
+ */
+static constexpr int64_t expensive_node_threshold_ns = 200'000;
+
 enum class NodeScheduleState : uint8_t {
   /**
    * Default state of every node.
@@ -1447,6 +1453,17 @@ inline void Executor::execute_node(const FunctionNode &node,
     this->push_all_scheduled_nodes_to_task_pool(current_task);
   };
 
+  /* Nodes that took long in previous evaluations are likely to take long again. Spread the other
+   * scheduled nodes across threads right away, instead of waiting until the node sends a hint.
+   * This way independent expensive branches run in parallel, while cheap nodes are still executed
+   * on the current thread to avoid the threading overhead. */
+  std::atomic<int64_t> &time_estimate =
+      self_.node_execution_time_estimates_[node.index_in_graph()];
+  if (time_estimate.load(std::memory_order_relaxed) > expensive_node_threshold_ns) {
+    blocking_hint_fn();
+  }
+
+  const timeit::TimePoint start_time = timeit::Clock::now();
   lazy_threading::HintReceiver blocking_hint_receiver{blocking_hint_fn};
   if (self_.node_execute_wrapper_) {
     self_.node_execute_wrapper_->execute_node(node, node_params, fn_context);
@@ -1454,6 +1471,12 @@ inline void Executor::execute_node(const FunctionNode &node,
   else {
     fn.execute(node_params, fn_context);
   }
+  const int64_t duration_ns =
+      std::chrono::duration_cast<timeit::Nanoseconds>(timeit::Clock::now() - start_time).count();
+  /* A node may be executed multiple times until it has all its inputs. Only halve the estimate
+   * for short executions, so that requesting inputs does not hide that the node is expensive. */
+  time_estimate.store(std::max(duration_ns, time_estimate.load(std::memory_order_relaxed) / 2),
+                      std::memory_order_relaxed);
 
   if (self_.logger_ != nullptr) {
     self_.logger_->log_after_node_execute(node, node_params, fn_context);
@@ -1473,8 +1496,12 @@ GraphExecutor::GraphExecutor(const Graph &graph,
       graph_output_index_by_socket_index_(graph.graph_outputs().size(), -1),
       logger_(logger),
       side_effect_provider_(side_effect_provider),
-      node_execute_wrapper_(node_execute_wrapper)
+      node_execute_wrapper_(node_execute_wrapper),
+      node_execution_time_estimates_(graph.nodes().size())
 {
+  for (std::atomic<int64_t> &time_estimate : node_execution_time_estimates_) {
+    time_estimate.store(0, std::memory_order_relaxed);
+  }
   /* The graph executor can handle partial execution when there are still missing inputs. */
   allow_missing_requested_inputs_ = true;
 
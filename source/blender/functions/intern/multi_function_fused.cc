@@ -0,0 +1,174 @@
+/* SPDX-FileCopyrightText: 2023 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "FN_multi_function_fused.hh"
+
+#include "BLI_linear_allocator.hh"
+
+namespace blender::fn::multi_function {
+
+/**
+ * Number of indices that all steps are evaluated for before moving on to the next chunk. The
+ * intermediate values of a few steps should fit into the L1 cache, while the per-chunk overhead
+ * of calling every function is still small compared to the actual work.
+ */
+static constexpr int64_t chunk_size = 512;
+
+FusedFunction::FusedFunction(const Span<const CPPType *> input_types,
+                             const CPPType &output_type,
+                             Vector<Step> steps,
+                             Vector<const CPPType *> intermediate_types)
+    : steps_(std::move(steps)), intermediate_types_(std::move(intermediate_types))
+{
+  BLI_assert(!steps_.is_empty());
+  SignatureBuilder builder{"Fused", signature_};
+  for (const CPPType *type : input_types) {
+    builder.single_input("Input", *type);
+  }
+  builder.single_output("Output", output_type);
+  this->set_signature(&signature_);
+}
+
+bool FusedFunction::is_fusable(const MultiFunction &fn)
+{
+  int outputs_num = 0;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    switch (param_type.category()) {
+      case ParamCategory::SingleInput:
+        break;
+      case ParamCategory::SingleOutput:
+        outputs_num++;
+        break;
+      default:
+        return false;
+    }
+  }
+  return outputs_num == 1;
+}
+
+void FusedFunction::call(const IndexMask &mask, Params params, Context context) const
+{
+  const int inputs_num = signature_.params.size() - 1;
+  Vector<GVArray, 8> inputs;
+  for (const int i : IndexRange(inputs_num)) {
+    inputs.append(params.readonly_single_input(i));
+  }
+  const GMutableSpan output = params.uninitialized_single_output(inputs_num);
+
+  LinearAllocator<> allocator;
+  Vector<void *, 8> intermediate_buffers;
+
+  const IndexRange bounds = mask.bounds();
+  if (bounds.size() <= chunk_size || mask.size() * 2 < bounds.size()) {
+    /* Chunking does not help for small masks, and sparse masks would result in many chunks with
+     * only a few indices. */
+    const int64_t array_size = mask.min_array_size();
+    for (const CPPType *type : intermediate_types_) {
+      intermediate_buffers.append(
+          allocator.allocate(type->size() * array_size, type->alignment()));
+    }
+    this->call_steps(mask, inputs, output, intermediate_buffers, context);
+    return;
+  }
+
+  for (const CPPType *type : intermediate_types_) {
+    intermediate_buffers.append(allocator.allocate(type->size() * chunk_size, type->alignment()));
+  }
+
+  Vector<GVArray, 8> sliced_inputs(inputs_num);
+  for (int64_t chunk_start = bounds.start(); chunk_start < bounds.one_after_last();
+       chunk_start += chunk_size)
+  {
+    const IndexRange chunk_range{chunk_start,
+                                 std::min(chunk_size, bounds.one_after_last() - chunk_start)};
+    const IndexMask chunk_mask = mask.slice_content(chunk_range);
+    if (chunk_mask.is_empty()) {
+      continue;
+    }
+    /* Shift the indices so that the intermediate buffers only have to hold a single chunk. */
+    IndexMaskMemory memory;
+    const IndexMask shifted_mask = chunk_mask.shift(-chunk_start, memory);
+    for (const int i : IndexRange(inputs_num)) {
+      sliced_inputs[i] = inputs[i].slice(chunk_range);
+    }
+    this->call_steps(
+        shifted_mask, sliced_inputs, output.slice(chunk_range), intermediate_buffers, context);
+  }
+}
+
+void FusedFunction::call_steps(const IndexMask &mask,
+                               const Span<GVArray> inputs,
+                               const GMutableSpan output,
+                               const Span<void *> intermediate_buffers,
+                               Context context) const
+{
+  const int64_t array_size = mask.min_array_size();
+  for (const Step &step : steps_) {
+    const MultiFunction &fn = *step.fn;
+    ParamsBuilder step_params{fn, &mask};
+    for (const int param_index : fn.param_indices()) {
+      const ParamSource &source = step.params[param_index];
+      const ParamType param_type = fn.param_type(param_index);
+      switch (source.type) {
+        case ParamSource::Type::Input: {
+          step_params.add_readonly_single_input(inputs[source.index]);
+          break;
+        }
+        case ParamSource::Type::Intermediate: {
+          const GMutableSpan span{*intermediate_types_[source.index],
+                                  intermediate_buffers[source.index],
+                                  array_size};
+          if (param_type.interface_type() == ParamType::Input) {
+            step_params.add_readonly_single_input(GSpan(span));
+          }
+          else {
+            step_params.add_uninitialized_single_output(span);
+          }
+          break;
+        }
+        case ParamSource::Type::Output: {
+          step_params.add_uninitialized_single_output(output);
+          break;
+        }
+      }
+    }
+    fn.call(mask, step_params, context);
+
+    /* Every intermediate value has a single user, so it can be destructed right away. */
+    for (const int param_index : fn.param_indices()) {
+      const ParamSource &source = step.params[param_index];
+      if (source.type == ParamSource::Type::Intermediate &&
+          fn.param_type(param_index).interface_type() == ParamType::Input)
+      {
+        const CPPType &type = *intermediate_types_[source.index];
+        if (!type.is_trivially_destructible()) {
+          type.destruct_indices(intermediate_buffers[source.index], mask);
+        }
+      }
+    }
+  }
+}
+
+std::string FusedFunction::debug_name() const
+{
+  std::string name = "Fused";
+  for (const Step &step : steps_) {
+    name += " " + step.fn->debug_name();
+  }
+  return name;
+}
+
+MultiFunction::ExecutionHints FusedFunction::get_execution_hints() const
+{
+  ExecutionHints hints;
+  for (const Step &step : steps_) {
+    const ExecutionHints step_hints = step.fn->execution_hints();
+    hints.min_grain_size = std::min(hints.min_grain_size, step_hints.min_grain_size);
+    hints.uniform_execution_time &= step_hints.uniform_execution_time;
+  }
+  return hints;
+}
+
+}  // namespace blender::fn::multi_function
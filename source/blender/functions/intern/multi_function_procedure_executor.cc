@@ -148,9 +148,20 @@ class ValueAllocator : NonCopyable, NonMovable {
   Stack<void *> small_single_value_free_list_;
   Map<const CPPType *, Stack<void *>> single_value_free_lists_;
 
+  /**
+   * Span buffers are allocated for at least this many elements. Buffers are reused regardless of
+   * their size, so this has to be set when the allocator is used for differently sized masks.
+   */
+  int64_t min_span_size_ = 0;
+
  public:
   ValueAllocator(LinearAllocator<> &linear_allocator) : linear_allocator_(linear_allocator) {}
 
+  void set_min_span_size(const int64_t size)
+  {
+    min_span_size_ = size;
+  }
+
   VariableValue_GVArray *obtain_GVArray(const GVArray &varray)
   {
     return this->obtain<VariableValue_GVArray>(varray);
@@ -166,9 +177,10 @@ class ValueAllocator : NonCopyable, NonMovable {
     return this->obtain<VariableValue_Span>(buffer, false);
   }
 
-  VariableValue_Span *obtain_Span(const CPPType &type, int size)
+  VariableValue_Span *obtain_Span(const CPPType &type, int64_t size)
   {
     void *buffer = nullptr;
+    size = std::max(size, min_span_size_);
 
     const int64_t element_size = type.size();
     const int64_t alignment = type.alignment();
@@ -813,17 +825,17 @@ class VariableState : NonCopyable, NonMovable {
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   const Procedure &procedure_;
   /** The state of every variable, indexed by #Variable::index_in_procedure(). */
   Array<VariableState> variable_states_;
   const IndexMask &full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator,
+  VariableStates(ValueAllocator &value_allocator,
                  const Procedure &procedure,
                  const IndexMask &full_mask)
-      : value_allocator_(linear_allocator),
+      : value_allocator_(value_allocator),
         procedure_(procedure),
         variable_states_(procedure.variables().size()),
         full_mask_(full_mask)
@@ -1157,19 +1169,18 @@ class InstructionScheduler {
   }
 };
 
-void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              const IndexMask &full_mask,
+                              Params &params,
+                              ValueAllocator &value_allocator,
+                              Context context)
 {
-  BLI_assert(procedure_.validate());
-
-  AlignedBuffer<512, 64> local_buffer;
-  LinearAllocator<> linear_allocator;
-  linear_allocator.provide_buffer(local_buffer);
-
-  VariableStates variable_states{linear_allocator, procedure_, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  VariableStates variable_states{value_allocator, procedure, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (!scheduler.is_done()) {
@@ -1218,9 +1229,9 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const ParamType param_type = this->param_type(param_index);
-    const Variable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    const Variable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case ParamType::Input: {
@@ -1241,6 +1252,85 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
   }
 }
 
+/**
+ * Procedures are evaluated in chunks of at most this many indices. All intermediate values of a
+ * chunk fit into the CPU cache, instead of being computed for all indices before they are used.
+ */
+static constexpr int64_t chunk_size = 4096;
+
+static bool supports_chunking(const ProcedureExecutor &fn)
+{
+  for (const int param_index : fn.param_indices()) {
+    if (fn.param_type(param_index).data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+{
+  BLI_assert(procedure_.validate());
+
+  AlignedBuffer<512, 64> local_buffer;
+  LinearAllocator<> linear_allocator;
+  linear_allocator.provide_buffer(local_buffer);
+  ValueAllocator value_allocator{linear_allocator};
+
+  const IndexRange bounds = full_mask.bounds();
+  if (bounds.size() <= chunk_size || full_mask.size() * 2 < bounds.size() ||
+      !supports_chunking(*this))
+  {
+    /* Sparse masks would result in many chunks that contain only a few indices. */
+    execute_procedure(*this, procedure_, full_mask, params, value_allocator, context);
+    return;
+  }
+
+  /* All chunks share the allocator, so that buffers of intermediate values are reused. */
+  value_allocator.set_min_span_size(chunk_size);
+  for (int64_t chunk_start = bounds.start(); chunk_start < bounds.one_after_last();
+       chunk_start += chunk_size)
+  {
+    const IndexRange chunk_range{chunk_start,
+                                 std::min(chunk_size, bounds.one_after_last() - chunk_start)};
+    const IndexMask chunk_mask = full_mask.slice_content(chunk_range);
+    if (chunk_mask.is_empty()) {
+      continue;
+    }
+    IndexMaskMemory memory;
+    const IndexMask shifted_mask = chunk_mask.shift(-chunk_start, memory);
+
+    ParamsBuilder sliced_params{*this, &shifted_mask};
+    for (const int param_index : this->param_indices()) {
+      switch (this->param_type(param_index).category()) {
+        case ParamCategory::SingleInput: {
+          const GVArray &varray = params.readonly_single_input(param_index);
+          sliced_params.add_readonly_single_input(varray.slice(chunk_range));
+          break;
+        }
+        case ParamCategory::SingleMutable: {
+          const GMutableSpan span = params.single_mutable(param_index);
+          sliced_params.add_single_mutable(span.slice(chunk_range));
+          break;
+        }
+        case ParamCategory::SingleOutput: {
+          const GMutableSpan span = params.uninitialized_single_output(param_index);
+          sliced_params.add_uninitialized_single_output(span.slice(chunk_range));
+          break;
+        }
+        case ParamCategory::VectorInput:
+        case ParamCategory::VectorMutable:
+        case ParamCategory::VectorOutput: {
+          BLI_assert_unreachable();
+          break;
+        }
+      }
+    }
+    Params chunk_params = sliced_params;
+    execute_procedure(*this, procedure_, shifted_mask, chunk_params, value_allocator, context);
+  }
+}
+
 MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
@@ -281,4 +281,41 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+TEST(field, FusedFunctionsLargeMask)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  auto to_string_fn = mf::build::SI1_SO<int, std::string>(
+      "to_string", [](int a) { return std::to_string(a); });
+  GField string_field{FieldOperation::Create(to_string_fn, {index_field}), 0};
+
+  auto append_fn = mf::build::SI1_SO<std::string, std::string>(
+      "append", [](const std::string &a) { return a + "!"; });
+  GField appended_field{FieldOperation::Create(append_fn, {string_field}), 0};
+
+  auto length_fn = mf::build::SI2_SO<std::string, int, int>(
+      "length", [](const std::string &a, int b) { return int(a.size()) * 100000 + b; });
+  GField result_field{FieldOperation::Create(length_fn, {appended_field, index_field}), 0};
+
+  /* Large enough to be evaluated in multiple chunks, with some indices left out. */
+  const int size = 5000;
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(1024), memory, [](const int64_t i) { return i % 7 != 3; });
+
+  Array<int> result(size, -1);
+  FieldContext context;
+  FieldEvaluator evaluator{context, &mask};
+  evaluator.add_with_destination(result_field, result.as_mutable_span());
+  evaluator.evaluate();
+  for (const int i : IndexRange(size)) {
+    if (i % 7 == 3) {
+      EXPECT_EQ(result[i], -1);
+    }
+    else {
+      EXPECT_EQ(result[i], int(std::to_string(i).size() + 1) * 100000 + i);
+    }
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -392,6 +392,70 @@ TEST(multi_function_procedure, BufferReuse)
   EXPECT_EQ(results[4], 53);
 }
 
+TEST(multi_function_procedure, ChunkedEvaluation)
+{
+  /**
+   * procedure(int a, bool cond, int *out) {
+   *   int b = a + 10;
+   *   if (cond) {
+   *     b += 100;
+   *   }
+   *   out = b + 10;
+   * }
+   */
+
+  auto add_10_fn = build::SI1_SO<int, int>("add 10", [](int a) { return a + 10; });
+  auto add_100_fn = build::SM<int>("add_100", [](int &a) { a += 100; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var_a = &builder.add_single_input_parameter<int>();
+  Variable *var_cond = &builder.add_single_input_parameter<bool>();
+  auto [var_b] = builder.add_call<1>(add_10_fn, {var_a});
+  builder.add_destruct(*var_a);
+  ProcedureBuilder::Branch branch = builder.add_branch(*var_cond);
+  branch.branch_true.add_call(add_100_fn, {var_b});
+  builder.set_cursor_after_branch(branch);
+  builder.add_destruct(*var_cond);
+  auto [var_out] = builder.add_call<1>(add_10_fn, {var_b});
+  builder.add_destruct(*var_b);
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  ProcedureExecutor procedure_fn{procedure};
+
+  /* Large enough to be evaluated in multiple chunks. */
+  const int size = 20000;
+  Array<int> inputs(size);
+  Array<bool> conditions(size);
+  for (const int i : IndexRange(size)) {
+    inputs[i] = i;
+    conditions[i] = i % 3 == 0;
+  }
+  Array<int> results(size, -1);
+
+  const IndexMask mask(IndexRange(5, size - 10));
+  ParamsBuilder params{procedure_fn, &mask};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_readonly_single_input(conditions.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  ContextBuilder context;
+  procedure_fn.call(mask, params, context);
+
+  for (const int i : IndexRange(size)) {
+    if (!mask.contains(i)) {
+      EXPECT_EQ(results[i], -1);
+    }
+    else {
+      EXPECT_EQ(results[i], i + (i % 3 == 0 ? 120 : 20));
+    }
+  }
+}
+
 TEST(multi_function_procedure, OutputBufferReplaced)
 {
   Procedure procedure;
@@ -9,6 +9,8 @@
 #include "BLI_index_mask.hh"
 #include "BLI_span.hh"
 
+#include "GEO_point_merge_by_distance.hh"
+
 struct Mesh;
 
 /** \file
@@ -26,7 +28,8 @@ namespace blender::geometry {
  */
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
-                                                 float merge_distance);
+                                                 float merge_distance,
+                                                 MergeByDistanceMethod method);
 
 /**
  * Merge selected vertices along edges to other selected vertices. Only vertices connected by edges
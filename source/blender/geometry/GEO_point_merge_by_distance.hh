@@ -5,6 +5,8 @@
 #pragma once
 
 #include "BLI_index_mask.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 struct PointCloud;
 namespace blender::bke {
@@ -17,6 +19,31 @@ class AnonymousAttributePropagationInfo;
 
 namespace blender::geometry {
 
+enum class MergeByDistanceMethod {
+  /** Visit the points in index order and find their neighbors in a KD-tree. */
+  KDTree,
+  /**
+   * Sort the points into a uniform grid and process cells that are far enough apart in parallel.
+   * Much faster for large inputs and independent of threading, but the chosen merge targets can
+   * differ from #KDTree.
+   */
+  Grid,
+};
+
+/**
+ * Find selected points within \a merge_distance of other selected points with a uniform grid,
+ * in parallel. The output has the same format as #BLI_kdtree_3d_calc_duplicates_fast: every
+ * merged point stores the index of its target, targets store their own index, and other points
+ * stay -1. Merging is always a single step, targets are never merged into other points.
+ *
+ * \param r_duplicates: Indexed by point, the values of selected points must be -1.
+ * \return The number of merged points.
+ */
+int find_duplicates_grid(Span<float3> positions,
+                         const IndexMask &selection,
+                         float merge_distance,
+                         MutableSpan<int> r_duplicates);
+
 /**
  * Merge selected points into other selected points within the \a merge_distance. The merged
  * indices favor speed over accuracy, since the results will depend on the order of the points.
@@ -25,6 +52,7 @@ PointCloud *point_merge_by_distance(
     const PointCloud &src_points,
     const float merge_distance,
     const IndexMask &selection,
-    const bke::AnonymousAttributePropagationInfo &propagation_info);
+    const bke::AnonymousAttributePropagationInfo &propagation_info,
+    MergeByDistanceMethod method);
 
 }  // namespace blender::geometry
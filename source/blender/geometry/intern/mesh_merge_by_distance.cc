@@ -1696,19 +1696,29 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
 
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
-                                                 const float merge_distance)
+                                                 const float merge_distance,
+                                                 const MergeByDistanceMethod method)
 {
   Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
-
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<float3> positions = mesh.vert_positions();
-  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
 
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, true, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  int vert_kill_len = 0;
+  switch (method) {
+    case MergeByDistanceMethod::KDTree: {
+      KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+      selection.foreach_index(
+          [&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+
+      BLI_kdtree_3d_balance(tree);
+      vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+          tree, merge_distance, true, vert_dest_map.data());
+      BLI_kdtree_3d_free(tree);
+      break;
+    }
+    case MergeByDistanceMethod::Grid:
+      vert_kill_len = find_duplicates_grid(positions, selection, merge_distance, vert_dest_map);
+      break;
+  }
 
   if (vert_kill_len == 0) {
     return std::nullopt;
@@ -2,10 +2,16 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+
 #include "BLI_array_utils.hh"
+#include "BLI_bounds.hh"
 #include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_sort.hh"
 #include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_pointcloud_types.h"
 
@@ -17,15 +23,151 @@
 
 namespace blender::geometry {
 
-PointCloud *point_merge_by_distance(const PointCloud &src_points,
-                                    const float merge_distance,
-                                    const IndexMask &selection,
-                                    const bke::AnonymousAttributePropagationInfo &propagation_info)
+/** Bits of every cell coordinate in the cell keys. */
+static constexpr int grid_key_bits = 21;
+static constexpr int grid_coord_max = (1 << grid_key_bits) - 1;
+
+static uint64_t grid_cell_key(const int3 &cell)
 {
-  const bke::AttributeAccessor src_attributes = src_points.attributes();
-  const Span<float3> positions = src_points.positions();
-  const int src_size = positions.size();
+  return uint64_t(cell.x) | (uint64_t(cell.y) << grid_key_bits) |
+         (uint64_t(cell.z) << (2 * grid_key_bits));
+}
+
+static int3 grid_cell_from_key(const uint64_t key)
+{
+  return int3(int(key & grid_coord_max),
+              int((key >> grid_key_bits) & grid_coord_max),
+              int(key >> (2 * grid_key_bits)));
+}
+
+int find_duplicates_grid(const Span<float3> positions,
+                         const IndexMask &selection,
+                         const float merge_distance,
+                         MutableSpan<int> r_duplicates)
+{
+  if (selection.is_empty()) {
+    return 0;
+  }
+  Array<int> indices(selection.size());
+  selection.to_indices<int>(indices);
+
+  const Bounds<float3> bounds = threading::parallel_reduce(
+      indices.index_range(),
+      4096,
+      Bounds<float3>(positions[indices.first()]),
+      [&](const IndexRange range, Bounds<float3> init) {
+        for (const int i : indices.as_span().slice(range)) {
+          math::min_max(positions[i], init.min, init.max);
+        }
+        return init;
+      },
+      [](const Bounds<float3> &a, const Bounds<float3> &b) { return bounds::merge(a, b); });
+
+  /* Points within the merge distance must be in the same or in neighboring cells. The cells are
+   * slightly larger than the merge distance to account for rounding and large enough to keep the
+   * cell coordinates within the key bits. */
+  const float max_extent = math::reduce_max(bounds.max - bounds.min);
+  const double cell_size = std::max({double(merge_distance) * (1.0 + 1e-6),
+                                     double(max_extent) / double(grid_coord_max / 2),
+                                     double(FLT_MIN)});
+  const double3 grid_min(bounds.min);
+
+  Array<uint64_t> keys(indices.size());
+  threading::parallel_for(indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const double3 co = (double3(positions[indices[i]]) - grid_min) / cell_size;
+      keys[i] = grid_cell_key(math::clamp(int3(math::floor(co)), int3(0), int3(grid_coord_max)));
+    }
+  });
+
+  /* The sort is stable, so the points in every cell stay in index order. */
+  parallel_radix_sort_by_key(keys.as_mutable_span(), indices.as_mutable_span());
+
+  Vector<uint64_t> cell_keys;
+  Vector<int> cell_offsets_data;
+  for (const int i : keys.index_range()) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      cell_keys.append(keys[i]);
+      cell_offsets_data.append(i);
+    }
+  }
+  cell_offsets_data.append(keys.size());
+  const OffsetIndices<int> cell_offsets(cell_offsets_data);
+  keys = {};
+
+  /* Cells whose coordinates are equal modulo 3 don't share any neighbors, so they can be
+   * processed at the same time. */
+  std::array<Vector<int>, 27> phase_cells;
+  for (const int cell : cell_keys.index_range()) {
+    const int3 coord = grid_cell_from_key(cell_keys[cell]);
+    phase_cells[(coord.x % 3) + (coord.y % 3) * 3 + (coord.z % 3) * 9].append(cell);
+  }
+
+  const float merge_distance_sq = merge_distance * merge_distance;
+  for (const Vector<int> &cells : phase_cells) {
+    threading::parallel_for(cells.index_range(), 16, [&](const IndexRange range) {
+      Vector<int, 27> neighbors;
+      for (const int cell : cells.as_span().slice(range)) {
+        const int3 coord = grid_cell_from_key(cell_keys[cell]);
+        neighbors.clear();
+        for (int z = std::max(coord.z - 1, 0); z <= std::min(coord.z + 1, grid_coord_max); z++) {
+          for (int y = std::max(coord.y - 1, 0); y <= std::min(coord.y + 1, grid_coord_max); y++)
+          {
+            for (int x = std::max(coord.x - 1, 0); x <= std::min(coord.x + 1, grid_coord_max);
+                 x++)
+            {
+              const uint64_t key = grid_cell_key(int3(x, y, z));
+              const uint64_t *found = std::lower_bound(cell_keys.begin(), cell_keys.end(), key);
+              if (found != cell_keys.end() && *found == key) {
+                neighbors.append(int(found - cell_keys.begin()));
+              }
+            }
+          }
+        }
+
+        for (const int point : indices.as_span().slice(cell_offsets[cell])) {
+          if (!ELEM(r_duplicates[point], -1, point)) {
+            continue;
+          }
+          bool found = false;
+          for (const int neighbor : neighbors) {
+            for (const int other : indices.as_span().slice(cell_offsets[neighbor])) {
+              if (other != point && r_duplicates[other] == -1 &&
+                  math::distance_squared(positions[point], positions[other]) <=
+                      merge_distance_sq)
+              {
+                r_duplicates[other] = point;
+                found = true;
+              }
+            }
+          }
+          if (found) {
+            /* Prevent chains of merges. */
+            r_duplicates[point] = point;
+          }
+        }
+      }
+    });
+  }
+
+  return threading::parallel_reduce(
+      indices.index_range(),
+      4096,
+      0,
+      [&](const IndexRange range, int count) {
+        for (const int i : indices.as_span().slice(range)) {
+          count += !ELEM(r_duplicates[i], -1, i);
+        }
+        return count;
+      },
+      std::plus<>());
+}
 
+static int find_duplicates_kdtree(const Span<float3> positions,
+                                  const float merge_distance,
+                                  const IndexMask &selection,
+                                  MutableSpan<int> merge_indices)
+{
   /* Create the KD tree based on only the selected points, to speed up merge detection and
    * balancing. */
   KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
@@ -41,17 +183,7 @@ PointCloud *point_merge_by_distance(const PointCloud &src_points,
       tree, merge_distance, false, selection_merge_indices.data());
   BLI_kdtree_3d_free(tree);
 
-  /* Create the new point cloud and add it to a temporary component for the attribute API. */
-  const int dst_size = src_size - duplicate_count;
-  PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(dst_size);
-  bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
-
-  /* By default, every point is just "merged" with itself. Then fill in the results of the merge
-   * finding, converting from indices into the selection to indices into the full input point
-   * cloud. */
-  Array<int> merge_indices(src_size);
-  array_utils::fill_index_range<int>(merge_indices);
-
+  /* Convert from indices into the selection to indices into the full input point cloud. */
   selection.foreach_index([&](const int src_index, const int pos) {
     const int merge_index = selection_merge_indices[pos];
     if (merge_index != -1) {
@@ -59,6 +191,46 @@ PointCloud *point_merge_by_distance(const PointCloud &src_points,
       merge_indices[src_index] = src_merge_index;
     }
   });
+  return duplicate_count;
+}
+
+PointCloud *point_merge_by_distance(const PointCloud &src_points,
+                                    const float merge_distance,
+                                    const IndexMask &selection,
+                                    const bke::AnonymousAttributePropagationInfo &propagation_info,
+                                    const MergeByDistanceMethod method)
+{
+  const bke::AttributeAccessor src_attributes = src_points.attributes();
+  const Span<float3> positions = src_points.positions();
+  const int src_size = positions.size();
+
+  /* By default, every point is just "merged" with itself. Then fill in the results of the merge
+   * finding. */
+  Array<int> merge_indices(src_size);
+  int duplicate_count = 0;
+  switch (method) {
+    case MergeByDistanceMethod::KDTree:
+      array_utils::fill_index_range<int>(merge_indices);
+      duplicate_count = find_duplicates_kdtree(
+          positions, merge_distance, selection, merge_indices);
+      break;
+    case MergeByDistanceMethod::Grid:
+      merge_indices.fill(-1);
+      duplicate_count = find_duplicates_grid(positions, selection, merge_distance, merge_indices);
+      threading::parallel_for(merge_indices.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          if (merge_indices[i] == -1) {
+            merge_indices[i] = i;
+          }
+        }
+      });
+      break;
+  }
+
+  /* Create the new point cloud and add it to a temporary component for the attribute API. */
+  const int dst_size = src_size - duplicate_count;
+  PointCloud *dst_pointcloud = BKE_pointcloud_new_nomain(dst_size);
+  bke::MutableAttributeAccessor dst_attributes = dst_pointcloud->attributes_for_write();
 
   /* For every source index, find the corresponding index in the result by iterating through the
    * source indices and counting how many merges happened before that point. */
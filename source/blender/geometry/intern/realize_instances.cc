@@ -7,6 +7,7 @@
 
 #include "DNA_collection_types.h"
 
+#include "BLI_arena_allocator.hh"
 #include "BLI_array_utils.hh"
 #include "BLI_noise.hh"
 
@@ -57,9 +58,10 @@ struct AttributeFallbacksArray {
    * Instance attribute values used as fallback when the geometry does not have the
    * corresponding attributes itself. The pointers point to attributes stored in the instances
    * component or in #r_temporary_arrays. The order depends on the corresponding #OrderedAttributes
-   * instance.
+   * instance. There is one of these for every realized instance, so it is allocated from the
+   * active #ArenaScope if there is one.
    */
-  Array<const void *> array;
+  Array<const void *, default_inline_buffer_capacity(sizeof(const void *)), ArenaAllocator> array;
 
   AttributeFallbacksArray(int size) : array(size, nullptr) {}
 };
@@ -434,6 +436,41 @@ static void copy_generic_attributes_to_result(
       });
 }
 
+/**
+ * Execute the tasks in parallel, grouping consecutive tasks by the number of elements they copy
+ * instead of by their count. A group copies all attributes of its instances before moving on, so
+ * many small instances are processed with little threading overhead and while their source data
+ * is still in the cache. Large instances form their own groups and are split up further by the
+ * copy functions.
+ */
+static void parallel_for_weighted_tasks(const int64_t tasks_num,
+                                        const FunctionRef<int64_t(int64_t task_index)> size_fn,
+                                        const FunctionRef<void(int64_t task_index)> fn)
+{
+  constexpr int64_t elements_per_group = 16384;
+  Vector<IndexRange> groups;
+  int64_t group_start = 0;
+  int64_t group_size = 0;
+  for (const int64_t task_index : IndexRange(tasks_num)) {
+    group_size += size_fn(task_index);
+    if (group_size >= elements_per_group) {
+      groups.append(IndexRange::from_begin_end_inclusive(group_start, task_index));
+      group_start = task_index + 1;
+      group_size = 0;
+    }
+  }
+  if (group_start < tasks_num) {
+    groups.append(IndexRange::from_begin_end(group_start, tasks_num));
+  }
+  threading::parallel_for(groups.index_range(), 1, [&](const IndexRange groups_range) {
+    for (const IndexRange group : groups.as_span().slice(groups_range)) {
+      for (const int64_t task_index : group) {
+        fn(task_index);
+      }
+    }
+  });
+}
+
 static void create_result_ids(const RealizeInstancesOptions &options,
                               const Span<int> stored_ids,
                               const int task_id,
@@ -1204,18 +1241,20 @@ static void execute_realize_pointcloud_tasks(const RealizeInstancesOptions &opti
   }
 
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizePointCloudTask &task = tasks[task_index];
-      execute_realize_pointcloud_task(options,
-                                      task,
-                                      ordered_attributes,
-                                      dst_attribute_writers,
-                                      point_radii.span,
-                                      point_ids.span,
-                                      positions.span);
-    }
-  });
+  parallel_for_weighted_tasks(
+      tasks.size(),
+      [&](const int64_t task_index) {
+        return int64_t(tasks[task_index].pointcloud_info->pointcloud->totpoint);
+      },
+      [&](const int64_t task_index) {
+        execute_realize_pointcloud_task(options,
+                                        tasks[task_index],
+                                        ordered_attributes,
+                                        dst_attribute_writers,
+                                        point_radii.span,
+                                        point_ids.span,
+                                        positions.span);
+      });
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1562,22 +1601,25 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
     }
   }
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeMeshTask &task = tasks[task_index];
-      execute_realize_mesh_task(options,
-                                task,
-                                ordered_attributes,
-                                dst_attribute_writers,
-                                dst_positions,
-                                dst_edges,
-                                dst_face_offsets,
-                                dst_corner_verts,
-                                dst_corner_edges,
-                                vertex_ids.span,
-                                material_indices.span);
-    }
-  });
+  parallel_for_weighted_tasks(
+      tasks.size(),
+      [&](const int64_t task_index) {
+        const Mesh &mesh = *tasks[task_index].mesh_info->mesh;
+        return int64_t(mesh.verts_num) + mesh.edges_num + mesh.faces_num + mesh.corners_num;
+      },
+      [&](const int64_t task_index) {
+        execute_realize_mesh_task(options,
+                                  tasks[task_index],
+                                  ordered_attributes,
+                                  dst_attribute_writers,
+                                  dst_positions,
+                                  dst_edges,
+                                  dst_face_offsets,
+                                  dst_corner_verts,
+                                  dst_corner_edges,
+                                  vertex_ids.span,
+                                  material_indices.span);
+      });
 
   /* Tag modified attributes. */
   for (GSpanAttributeWriter &dst_attribute : dst_attribute_writers) {
@@ -1899,24 +1941,27 @@ static void execute_realize_curve_tasks(const RealizeInstancesOptions &options,
   }
 
   /* Actually execute all tasks. */
-  threading::parallel_for(tasks.index_range(), 100, [&](const IndexRange task_range) {
-    for (const int task_index : task_range) {
-      const RealizeCurveTask &task = tasks[task_index];
-      execute_realize_curve_task(options,
-                                 all_curves_info,
-                                 task,
-                                 ordered_attributes,
-                                 dst_curves,
-                                 dst_attribute_writers,
-                                 point_ids.span,
-                                 handle_left.span,
-                                 handle_right.span,
-                                 radius.span,
-                                 nurbs_weight.span,
-                                 resolution.span,
-                                 custom_normal.span);
-    }
-  });
+  parallel_for_weighted_tasks(
+      tasks.size(),
+      [&](const int64_t task_index) {
+        const bke::CurvesGeometry &curves = tasks[task_index].curve_info->curves->geometry.wrap();
+        return int64_t(curves.points_num()) + curves.curves_num();
+      },
+      [&](const int64_t task_index) {
+        execute_realize_curve_task(options,
+                                   all_curves_info,
+                                   tasks[task_index],
+                                   ordered_attributes,
+                                   dst_curves,
+                                   dst_attribute_writers,
+                                   point_ids.span,
+                                   handle_left.span,
+                                   handle_right.span,
+                                   radius.span,
+                                   nurbs_weight.span,
+                                   resolution.span,
+                                   custom_normal.span);
+      });
 
   /* Type counts have to be updated eagerly. */
   dst_curves.runtime->type_counts.fill(0);
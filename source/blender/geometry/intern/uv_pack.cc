@@ -22,6 +22,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_scene_types.h"
@@ -2265,15 +2266,18 @@ class OverlapMerger {
 
 static void finalize_geometry(const Span<PackIsland *> islands, const UVPackIsland_Params &params)
 {
-  MemArena *arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
-  Heap *heap = BLI_heap_new();
-  for (const int64_t i : islands.index_range()) {
-    islands[i]->finalize_geometry_(params, arena, heap);
-    BLI_memarena_clear(arena);
-  }
-
-  BLI_heap_free(heap, nullptr);
-  BLI_memarena_free(arena);
+  /* Islands are finalized independently, each thread uses its own scratch memory. */
+  threading::parallel_for(islands.index_range(), 256, [&](const IndexRange range) {
+    MemArena *arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
+    Heap *heap = BLI_heap_new();
+    for (const int64_t i : range) {
+      islands[i]->finalize_geometry_(params, arena, heap);
+      BLI_memarena_clear(arena);
+    }
+
+    BLI_heap_free(heap, nullptr);
+    BLI_memarena_free(arena);
+  });
 }
 
 float pack_islands(const Span<PackIsland *> islands, const UVPackIsland_Params &params)
@@ -167,7 +167,15 @@ void GPU_compilation_subprocess_run(const char *subprocess_name)
 
   static char tmp_dir[1024];
   BLI_temp_directory_path_get(tmp_dir, sizeof(tmp_dir));
-  std::string cache_dir = std::string(tmp_dir) + "BLENDER_SHADER_CACHE" + SEP_STR;
+  /* Binaries are only valid for the driver that created them, keep a separate cache per driver
+   * so updating or switching drivers doesn't invalidate the cached binaries of the others. */
+  DefaultHash<StringRefNull> driver_hasher;
+  const uint64_t driver_hash = driver_hasher(
+      std::string(reinterpret_cast<const char *>(glGetString(GL_VENDOR))) +
+      reinterpret_cast<const char *>(glGetString(GL_RENDERER)) +
+      reinterpret_cast<const char *>(glGetString(GL_VERSION)));
+  std::string cache_dir = std::string(tmp_dir) + "BLENDER_SHADER_CACHE" + SEP_STR +
+                          std::to_string(driver_hash) + SEP_STR;
   BLI_dir_create_recursive(cache_dir.c_str());
 
   while (true) {
@@ -118,11 +118,17 @@ class VKCommandBuilder {
   /**
    * Build the pipeline barriers that should be recorded before any other commands of the node
    * group the given node is part of is being recorded.
+   *
+   * The barriers of all nodes in a node group are batched into a single pipeline barrier
+   * command. Pending barriers are only sent when the node accesses a resource that already has
+   * a pending barrier, as barriers inside a single command aren't ordered.
    */
   void build_pipeline_barriers(VKRenderGraph &render_graph,
                                VKCommandBufferInterface &command_buffer,
                                NodeHandle node_handle,
                                VkPipelineStageFlags pipeline_stage);
+  /** Does the node access any resource that has a pending barrier. */
+  bool node_has_pending_barriers(const VKRenderGraph &render_graph, NodeHandle node_handle) const;
   void reset_barriers();
   void send_pipeline_barriers(VKCommandBufferInterface &command_buffer);
 
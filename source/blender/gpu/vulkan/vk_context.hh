@@ -16,6 +16,7 @@
 #include "vk_common.hh"
 #include "vk_debug.hh"
 #include "vk_descriptor_pools.hh"
+#include "vk_staging_buffer.hh"
 
 namespace blender::gpu {
 class VKFrameBuffer;
@@ -36,6 +37,7 @@ class VKContext : public Context, NonCopyable {
 
   /* Reusable data. Stored inside context to limit reallocations. */
   render_graph::VKResourceAccessInfo access_info_ = {};
+  VKStagingRingBuffer staging_ring_buffer_;
 
   bool is_init_ = false;
 
@@ -108,6 +110,11 @@ class VKContext : public Context, NonCopyable {
     return descriptor_set_;
   }
 
+  VKStagingRingBuffer &staging_ring_buffer_get()
+  {
+    return staging_ring_buffer_;
+  }
+
   VKStateManager &state_manager_get() const;
 
   static void swap_buffers_pre_callback(const GHOST_VulkanSwapChainData *data);
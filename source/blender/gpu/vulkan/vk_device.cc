@@ -19,7 +19,14 @@
 
 #include "GPU_capabilities.hh"
 
+#include "BKE_appdir.hh"
+
+#include "BLI_fileops.h"
+#include "BLI_fileops.hh"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_path_util.h"
+
+#include "MEM_guardedalloc.h"
 
 #include "GHOST_C-api.h"
 
@@ -52,6 +59,7 @@ void VKDevice::deinit()
   samplers_.free();
   destroy_discarded_resources();
   pipelines.free_data();
+  save_pipeline_cache();
   vkDestroyPipelineCache(vk_device_, vk_pipeline_cache_, vk_allocation_callbacks);
   descriptor_set_layouts_.deinit();
   vmaDestroyAllocator(mem_allocator_);
@@ -183,12 +191,90 @@ void VKDevice::init_memory_allocator()
   vmaCreateAllocator(&info, &mem_allocator_);
 }
 
+bool VKDevice::pipeline_cache_path(char *r_path, const size_t r_path_maxncpy) const
+{
+  if (!BKE_appdir_folder_caches(r_path, r_path_maxncpy)) {
+    return false;
+  }
+
+  const VkPhysicalDeviceProperties &properties = vk_physical_device_properties_;
+  std::stringstream file_name;
+  file_name << std::hex << properties.vendorID << "_" << properties.deviceID << "_"
+            << properties.driverVersion << ".bin";
+  BLI_path_append(r_path, r_path_maxncpy, "vulkan-pipeline-cache");
+  BLI_path_append(r_path, r_path_maxncpy, file_name.str().c_str());
+  return true;
+}
+
 void VKDevice::init_pipeline_cache()
 {
   VK_ALLOCATION_CALLBACKS;
   VkPipelineCacheCreateInfo create_info = {};
   create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+  /* Start from the pipelines compiled in a previous session. The header is checked as some
+   * drivers don't validate the initial data themselves. */
+  char cache_path[FILE_MAX];
+  void *cache_data = nullptr;
+  if (pipeline_cache_path(cache_path, sizeof(cache_path)) && BLI_exists(cache_path)) {
+    size_t cache_size = 0;
+    cache_data = BLI_file_read_binary_as_mem(cache_path, 0, &cache_size);
+    const VkPipelineCacheHeaderVersionOne *header =
+        static_cast<const VkPipelineCacheHeaderVersionOne *>(cache_data);
+    if (cache_data && cache_size >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+        header->headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header->vendorID == vk_physical_device_properties_.vendorID &&
+        header->deviceID == vk_physical_device_properties_.deviceID &&
+        memcmp(header->pipelineCacheUUID,
+               vk_physical_device_properties_.pipelineCacheUUID,
+               VK_UUID_SIZE) == 0)
+    {
+      create_info.initialDataSize = cache_size;
+      create_info.pInitialData = cache_data;
+    }
+  }
+
   vkCreatePipelineCache(vk_device_, &create_info, vk_allocation_callbacks, &vk_pipeline_cache_);
+  MEM_SAFE_FREE(cache_data);
+}
+
+void VKDevice::save_pipeline_cache()
+{
+  char cache_path[FILE_MAX];
+  if (vk_pipeline_cache_ == VK_NULL_HANDLE || !pipeline_cache_path(cache_path, sizeof(cache_path)))
+  {
+    return;
+  }
+
+  size_t cache_size = 0;
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &cache_size, nullptr) != VK_SUCCESS ||
+      cache_size == 0)
+  {
+    return;
+  }
+  Array<char> cache_data(cache_size);
+  if (vkGetPipelineCacheData(vk_device_, vk_pipeline_cache_, &cache_size, cache_data.data()) !=
+      VK_SUCCESS)
+  {
+    return;
+  }
+
+  /* Write to a temporary file first, so an interrupted write never leaves a truncated cache
+   * behind for another Blender instance to read. */
+  if (!BLI_file_ensure_parent_dir_exists(cache_path)) {
+    return;
+  }
+  const std::string temp_path = std::string(cache_path) + ".tmp";
+  {
+    fstream file(temp_path, std::ios::binary | std::ios::out | std::ios::trunc);
+    file.write(cache_data.data(), cache_size);
+    if (!file.good()) {
+      file.close();
+      BLI_delete(temp_path.c_str(), false, false);
+      return;
+    }
+  }
+  BLI_rename_overwrite(temp_path.c_str(), cache_path);
 }
 
 void VKDevice::init_dummy_buffer(VKContext &context)
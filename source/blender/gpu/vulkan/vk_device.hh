@@ -268,6 +268,17 @@ class VKDevice : public NonCopyable {
   void init_debug_callbacks();
   void init_memory_allocator();
   void init_pipeline_cache();
+  /**
+   * Write the pipeline cache to disk, so pipelines compiled in this session don't have to be
+   * compiled again by the driver in the next session.
+   */
+  void save_pipeline_cache();
+  /**
+   * Path of the on disk pipeline cache. The file name contains the vendor, device and driver
+   * version, so caches of other drivers are never loaded. Returns false when there is no cache
+   * folder.
+   */
+  bool pipeline_cache_path(char *r_path, size_t r_path_maxncpy) const;
   /**
    * Initialize the functions struct with extension specific function pointer.
    */
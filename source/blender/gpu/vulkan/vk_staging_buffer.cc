@@ -9,6 +9,8 @@
 #include "vk_staging_buffer.hh"
 #include "vk_context.hh"
 
+#include "BLI_math_base.h"
+
 namespace blender::gpu {
 
 VKStagingBuffer::VKStagingBuffer(const VKBuffer &device_buffer, Direction direction)
@@ -54,4 +56,40 @@ void VKStagingBuffer::free()
   host_buffer_.free();
 }
 
+std::optional<VKStagingRingBuffer::Allocation> VKStagingRingBuffer::allocate(
+    VKContext &context, const VkDeviceSize size, const VkDeviceSize alignment)
+{
+  if (submission_tracker_.is_changed(context)) {
+    /* All previous allocations have been used by commands that have finished. */
+    offset_ = 0;
+  }
+
+  if (!buffer_.is_allocated()) {
+    if (!buffer_.create(
+            size_in_bytes_, GPU_USAGE_STREAM, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, true))
+    {
+      return std::nullopt;
+    }
+    debug::object_label(buffer_.vk_handle(), "StagingRingBuffer");
+  }
+  if (!buffer_.is_mapped()) {
+    return std::nullopt;
+  }
+
+  const VkDeviceSize offset = ceil_to_multiple_ul(offset_, alignment);
+  if (offset + size > size_in_bytes_) {
+    return std::nullopt;
+  }
+  offset_ = offset + size;
+
+  return Allocation{buffer_.vk_handle(),
+                    offset,
+                    static_cast<uint8_t *>(buffer_.mapped_memory_get()) + offset};
+}
+
+void VKStagingRingBuffer::flush() const
+{
+  buffer_.flush();
+}
+
 }  // namespace blender::gpu
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include <optional>
+
 #include "vk_buffer.hh"
 #include "vk_common.hh"
+#include "vk_resource_tracker.hh"
 
 namespace blender::gpu {
 
@@ -73,4 +76,44 @@ class VKStagingBuffer {
    */
   void free();
 };
+
+/**
+ * Persistent host visible buffer of a context that is sub-allocated for uploads.
+ *
+ * Creating a staging buffer for every upload allocates device memory each time, and the buffers
+ * are only destroyed when the frame is presented. Uploading many textures would stall on these
+ * allocations. Allocations are linear and are released all together when the render graph of the
+ * context has been submitted, as submissions wait until the commands have finished.
+ *
+ * When an upload doesn't fit in the remaining space the caller should fall back to a
+ * #VKStagingBuffer.
+ */
+class VKStagingRingBuffer : NonCopyable {
+ public:
+  struct Allocation {
+    VkBuffer vk_buffer;
+    VkDeviceSize offset;
+    void *mapped_memory;
+  };
+
+ private:
+  static constexpr VkDeviceSize size_in_bytes_ = 64 * 1024 * 1024;
+
+  VKBuffer buffer_;
+  VkDeviceSize offset_ = 0;
+  VKSubmissionTracker submission_tracker_;
+
+ public:
+  /**
+   * Allocate `size` bytes with an offset that is a multiple of `alignment`. Returns nothing when
+   * the allocation doesn't fit in the remaining space of the ring buffer.
+   */
+  std::optional<Allocation> allocate(VKContext &context,
+                                     VkDeviceSize size,
+                                     VkDeviceSize alignment);
+
+  /** Make host writes to the allocations visible to the device. */
+  void flush() const;
+};
+
 }  // namespace blender::gpu
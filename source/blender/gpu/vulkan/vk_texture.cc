@@ -288,13 +288,32 @@ void VKTexture::update_sub(
     sample_len = device_memory_size / to_bytesize(device_format_);
   }
 
+  /* Use the staging ring buffer of the context when the data fits, to avoid allocating device
+   * memory for every upload. The buffer offset must be a multiple of the texel (block) size and
+   * of 4. */
+  VKStagingRingBuffer &staging_ring_buffer = context.staging_ring_buffer_get();
+  const VkDeviceSize alignment = VkDeviceSize(is_compressed ? to_block_size(device_format_) :
+                                                              to_bytesize(device_format_)) *
+                                 4;
+  std::optional<VKStagingRingBuffer::Allocation> staging_allocation =
+      staging_ring_buffer.allocate(context, device_memory_size, alignment);
+
   VKBuffer staging_buffer;
-  staging_buffer.create(device_memory_size, GPU_USAGE_DYNAMIC, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-  convert_host_to_device(
-      staging_buffer.mapped_memory_get(), data, sample_len, format, format_, device_format_);
+  if (staging_allocation) {
+    convert_host_to_device(
+        staging_allocation->mapped_memory, data, sample_len, format, format_, device_format_);
+    staging_ring_buffer.flush();
+  }
+  else {
+    staging_buffer.create(device_memory_size, GPU_USAGE_DYNAMIC, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    convert_host_to_device(
+        staging_buffer.mapped_memory_get(), data, sample_len, format, format_, device_format_);
+  }
 
   render_graph::VKCopyBufferToImageNode::CreateInfo copy_buffer_to_image = {};
-  copy_buffer_to_image.src_buffer = staging_buffer.vk_handle();
+  copy_buffer_to_image.src_buffer = staging_allocation ? staging_allocation->vk_buffer :
+                                                         staging_buffer.vk_handle();
+  copy_buffer_to_image.region.bufferOffset = staging_allocation ? staging_allocation->offset : 0;
   copy_buffer_to_image.dst_image = vk_image_handle();
   copy_buffer_to_image.region.imageExtent.width = extent.x;
   copy_buffer_to_image.region.imageExtent.height = extent.y;
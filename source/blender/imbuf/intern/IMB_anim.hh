@@ -22,7 +22,12 @@ struct SwsContext;
 #endif
 
 struct IDProperty;
+struct ImBuf;
 struct ImBufAnimIndex;
+struct TaskPool;
+
+/** Number of frames that are decoded ahead of the requested frame during playback. */
+#define ANIM_LOOKAHEAD_FRAMES 8
 
 struct ImBufAnim {
   enum class State { Uninitialized, Failed, Valid };
@@ -54,11 +59,35 @@ struct ImBufAnim {
   AVFrame *pFrame_backup;
   bool pFrame_backup_complete;
 
+  /**
+   * Pixel format (#AVPixelFormat) of frames that are decoded on the GPU, or `AV_PIX_FMT_NONE`
+   * when decoding on the CPU. These frames are downloaded into #pFrameSoftware to convert them,
+   * the converter for their pixel format is created on first use.
+   */
+  int hw_pix_fmt;
+  AVFrame *pFrameSoftware;
+  SwsContext *hw_convert_ctx;
+  int hw_convert_pix_fmt;
+
   int64_t cur_pts;
   int64_t cur_key_frame_pts;
   AVPacket *cur_packet;
 
   bool seek_before_decode;
+
+  /**
+   * Frames that are decoded in the background in the playback direction, before they are
+   * requested. The frames are only accessed while no look-ahead task is running, which is the
+   * case whenever #IMB_anim_absolute returns.
+   */
+  TaskPool *lookahead_pool;
+  ImBuf *lookahead_ibufs[ANIM_LOOKAHEAD_FRAMES];
+  int lookahead_positions[ANIM_LOOKAHEAD_FRAMES];
+  IMB_Timecode_Type lookahead_tc;
+  /** The last requested position and the step to it from the position before, to detect
+   * playback. */
+  int lookahead_last_position;
+  int lookahead_step;
 #endif
 
   char index_dir[768];
@@ -75,3 +104,9 @@ struct ImBufAnim {
 
   IDProperty *metadata;
 };
+
+/**
+ * Stop decoding frames ahead of the requested ones, and wait for the frame that is currently
+ * being decoded. Needed before freeing data that the decoding uses, like the timecode indices.
+ */
+void IMB_anim_lookahead_cancel(ImBufAnim *anim);
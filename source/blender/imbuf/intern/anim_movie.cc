@@ -6,6 +6,7 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
 #include <cctype>
 #include <climits>
 #include <cmath>
@@ -20,10 +21,12 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -43,7 +46,9 @@
 extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
+#  include <libavutil/pixdesc.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
 
@@ -161,6 +166,102 @@ void IMB_suffix_anim(ImBufAnim *anim, const char *suffix)
 
 #ifdef WITH_FFMPEG
 
+static AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *codec_ctx,
+                                          const AVPixelFormat *pix_fmts)
+{
+  const ImBufAnim *anim = static_cast<const ImBufAnim *>(codec_ctx->opaque);
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The hardware does not support this stream, decode it on the CPU instead. */
+  return avcodec_default_get_format(codec_ctx, pix_fmts);
+}
+
+/**
+ * Use the first hardware device that can decode the codec, if any. Stays on CPU decoding when
+ * there is none, or when the frames need processing that only works on the decoded pixels.
+ */
+static void ffmpeg_hardware_decoding_init(ImBufAnim *anim,
+                                          const AVCodec *codec,
+                                          AVCodecContext *codec_ctx)
+{
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+
+  if ((U.video_flag & USER_VIDEO_HARDWARE_DECODING) == 0 ||
+      (anim->ib_flags & IB_animdeinterlace))
+  {
+    return;
+  }
+  /* Hardware decoders don't output alpha. */
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(codec_ctx->pix_fmt);
+  if (pix_fmt_descriptor == nullptr || (pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA)) {
+    return;
+  }
+
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(codec, i);
+    if (config == nullptr) {
+      return;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+    AVBufferRef *device_ctx = nullptr;
+    if (av_hwdevice_ctx_create(&device_ctx, config->device_type, nullptr, nullptr, 0) < 0) {
+      continue;
+    }
+    /* The codec context owns the device from now on. */
+    codec_ctx->hw_device_ctx = device_ctx;
+    codec_ctx->opaque = anim;
+    codec_ctx->get_format = ffmpeg_get_hw_format;
+    anim->hw_pix_fmt = config->pix_fmt;
+    av_log(nullptr,
+           AV_LOG_INFO,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(config->device_type));
+    return;
+  }
+}
+
+/** Use the color range and coefficients of the video for the conversion to RGB. */
+static void ffmpeg_set_colorspace_details(ImBufAnim *anim, SwsContext *convert_ctx)
+{
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
+  if (!sws_getColorspaceDetails(convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation))
+  {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation))
+    {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+}
+
 static int startffmpeg(ImBufAnim *anim)
 {
   int i, video_stream_index;
@@ -174,11 +275,6 @@ static int startffmpeg(ImBufAnim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == nullptr) {
     return (-1);
   }
@@ -242,6 +338,8 @@ static int startffmpeg(ImBufAnim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  ffmpeg_hardware_decoding_init(anim, pCodec, pCodecCtx);
+
   if (avcodec_open2(pCodecCtx, pCodec, nullptr) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -363,6 +461,9 @@ static int startffmpeg(ImBufAnim *anim)
   anim->pFrame_backup_complete = false;
   anim->pFrame_complete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
+  anim->pFrameSoftware = av_frame_alloc();
+  anim->hw_convert_ctx = nullptr;
+  anim->hw_convert_pix_fmt = AV_PIX_FMT_NONE;
   anim->pFrameRGB = av_frame_alloc();
   anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
   anim->pFrameRGB->width = anim->x;
@@ -375,6 +476,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSoftware);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
     anim->pCodecCtx = nullptr;
@@ -388,6 +490,7 @@ static int startffmpeg(ImBufAnim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSoftware);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
     anim->pCodecCtx = nullptr;
@@ -422,40 +525,14 @@ static int startffmpeg(ImBufAnim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSoftware);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
     anim->pCodecCtx = nullptr;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation))
-  {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation))
-    {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
+  ffmpeg_set_colorspace_details(anim, anim->img_convert_ctx);
 
   return 0;
 }
@@ -514,6 +591,38 @@ static AVFrame *ffmpeg_double_buffer_frame_fallback_get(ImBufAnim *anim)
   return nullptr;
 }
 
+/**
+ * Download a frame that was decoded on the GPU, and get the converter for its pixel format.
+ */
+static AVFrame *ffmpeg_frame_from_hardware(ImBufAnim *anim, AVFrame *input)
+{
+  av_frame_unref(anim->pFrameSoftware);
+  if (av_hwframe_transfer_data(anim->pFrameSoftware, input, 0) < 0) {
+    fprintf(stderr, "Could not download the frame from the GPU.\n");
+    return nullptr;
+  }
+
+  /* The pixel format is chosen by the transfer, e.g. NV12 or P010. */
+  const int pix_fmt = anim->pFrameSoftware->format;
+  if (anim->hw_convert_ctx == nullptr || anim->hw_convert_pix_fmt != pix_fmt) {
+    if (anim->hw_convert_ctx) {
+      BKE_ffmpeg_sws_release_context(anim->hw_convert_ctx);
+    }
+    anim->hw_convert_ctx = BKE_ffmpeg_sws_get_context(anim->x,
+                                                      anim->y,
+                                                      AVPixelFormat(pix_fmt),
+                                                      AV_PIX_FMT_RGBA,
+                                                      SWS_BILINEAR | SWS_FULL_CHR_H_INT);
+    anim->hw_convert_pix_fmt = pix_fmt;
+    if (anim->hw_convert_ctx == nullptr) {
+      fprintf(stderr, "Can't transform color space of the frame from the GPU.\n");
+      return nullptr;
+    }
+    ffmpeg_set_colorspace_details(anim, anim->hw_convert_ctx);
+  }
+  return anim->pFrameSoftware;
+}
+
 /**
  * Postprocess the image in anim->pFrame and do color conversion and de-interlacing stuff.
  *
@@ -542,6 +651,15 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
          input->data[2],
          input->data[3]);
 
+  SwsContext *convert_ctx = anim->img_convert_ctx;
+  if (anim->hw_pix_fmt != AV_PIX_FMT_NONE && input->format == anim->hw_pix_fmt) {
+    input = ffmpeg_frame_from_hardware(anim, input);
+    if (input == nullptr) {
+      return;
+    }
+    convert_ctx = anim->hw_convert_ctx;
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (av_image_deinterlace(anim->pFrameDeinterlaced,
                              anim->pFrame,
@@ -577,14 +695,14 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
     anim->pFrameRGB->linesize[0] = -ibuf_linesize;
     anim->pFrameRGB->data[0] = ibuf->byte_buffer.data + (ibuf->y - 1) * ibuf_linesize;
 
-    BKE_ffmpeg_sws_scale_frame(anim->img_convert_ctx, anim->pFrameRGB, input);
+    BKE_ffmpeg_sws_scale_frame(convert_ctx, anim->pFrameRGB, input);
 
     anim->pFrameRGB->linesize[0] = rgb_linesize;
     anim->pFrameRGB->data[0] = rgb_data;
   }
   else {
     /* Decode, then do vertical flip into destination. */
-    BKE_ffmpeg_sws_scale_frame(anim->img_convert_ctx, anim->pFrameRGB, input);
+    BKE_ffmpeg_sws_scale_frame(convert_ctx, anim->pFrameRGB, input);
 
     /* Use negative line size to do vertical image flip. */
     const int src_linesize[4] = {-rgb_linesize, 0, 0, 0};
@@ -1168,12 +1286,207 @@ static ImBuf *ffmpeg_fetchibuf(ImBufAnim *anim, int position, IMB_Timecode_Type
   return cur_frame_final;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Look-ahead Decoding
+ *
+ * During playback the frames following the requested one are decoded in the background, so
+ * that they are ready when they are requested. Playing forward only decodes the next frame that
+ * is missing, which never needs a seek. Playing backward decodes a batch of the previous frames
+ * in increasing order, so the whole batch is decoded with a single seek to a key frame. When a
+ * timecode index exists, batches don't cross the start of a group of pictures, to avoid decoding
+ * the frames of the previous group that are decoded again by the next batch.
+ * \{ */
+
+struct LookAheadTaskData {
+  /** Positions to decode, in increasing order. */
+  int positions[ANIM_LOOKAHEAD_FRAMES];
+  int positions_num;
+};
+
+static bool ffmpeg_lookahead_has_position(const ImBufAnim *anim, const int position)
+{
+  for (int slot = 0; slot < ANIM_LOOKAHEAD_FRAMES; slot++) {
+    if (anim->lookahead_ibufs[slot] && anim->lookahead_positions[slot] == position) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void ffmpeg_lookahead_task(TaskPool *pool, void *taskdata)
+{
+  ImBufAnim *anim = static_cast<ImBufAnim *>(BLI_task_pool_user_data(pool));
+  const LookAheadTaskData *data = static_cast<const LookAheadTaskData *>(taskdata);
+
+  for (int i = 0; i < data->positions_num; i++) {
+    if (BLI_task_pool_current_canceled(pool)) {
+      break;
+    }
+    ImBuf *ibuf = ffmpeg_fetchibuf(anim, data->positions[i], anim->lookahead_tc);
+    if (ibuf == nullptr) {
+      continue;
+    }
+    /* A backward batch also decodes frames that are still there, to avoid seeking. */
+    if (ffmpeg_lookahead_has_position(anim, data->positions[i])) {
+      IMB_freeImBuf(ibuf);
+      continue;
+    }
+    /* The main thread made sure that there are enough free slots. */
+    for (int slot = 0; slot < ANIM_LOOKAHEAD_FRAMES; slot++) {
+      if (anim->lookahead_ibufs[slot] == nullptr) {
+        anim->lookahead_ibufs[slot] = ibuf;
+        anim->lookahead_positions[slot] = data->positions[i];
+        ibuf = nullptr;
+        break;
+      }
+    }
+    if (ibuf) {
+      IMB_freeImBuf(ibuf);
+    }
+  }
+}
+
+static void ffmpeg_lookahead_clear(ImBufAnim *anim)
+{
+  for (int slot = 0; slot < ANIM_LOOKAHEAD_FRAMES; slot++) {
+    if (anim->lookahead_ibufs[slot]) {
+      IMB_freeImBuf(anim->lookahead_ibufs[slot]);
+      anim->lookahead_ibufs[slot] = nullptr;
+    }
+  }
+}
+
+/**
+ * The first position of a backward batch that ends at \a last_position, which stays in the
+ * same group of pictures when the timecode index is known.
+ */
+static int ffmpeg_lookahead_backward_batch_start(ImBufAnim *anim, const int last_position)
+{
+  const int first_position = std::max(last_position - ANIM_LOOKAHEAD_FRAMES + 1, 0);
+  ImBufAnimIndex *tc_index = IMB_anim_open_index(anim, anim->lookahead_tc);
+  if (tc_index == nullptr) {
+    return first_position;
+  }
+  const uint64_t seek_pos = IMB_indexer_get_seek_pos(
+      tc_index, IMB_indexer_get_frame_index(tc_index, last_position));
+  int position = last_position;
+  while (position > first_position &&
+         IMB_indexer_get_seek_pos(tc_index,
+                                  IMB_indexer_get_frame_index(tc_index, position - 1)) == seek_pos)
+  {
+    position--;
+  }
+  return position;
+}
+
+static void ffmpeg_lookahead_start(ImBufAnim *anim, const int position, const int step)
+{
+  LookAheadTaskData *data = MEM_cnew<LookAheadTaskData>(__func__);
+
+  if (step > 0) {
+    for (int i = 1; i <= ANIM_LOOKAHEAD_FRAMES; i++) {
+      const int lookahead_position = position + i;
+      if (lookahead_position >= anim->duration_in_frames) {
+        break;
+      }
+      if (!ffmpeg_lookahead_has_position(anim, lookahead_position)) {
+        data->positions[data->positions_num++] = lookahead_position;
+      }
+    }
+  }
+  else if (position > 0 && !ffmpeg_lookahead_has_position(anim, position - 1)) {
+    /* All frames before the requested one were used, decode the next batch. */
+    const int last_position = position - 1;
+    const int first_position = ffmpeg_lookahead_backward_batch_start(anim, last_position);
+    for (int lookahead_position = first_position; lookahead_position <= last_position;
+         lookahead_position++)
+    {
+      data->positions[data->positions_num++] = lookahead_position;
+    }
+  }
+
+  if (data->positions_num == 0) {
+    MEM_freeN(data);
+    return;
+  }
+
+  if (anim->lookahead_pool == nullptr) {
+    anim->lookahead_pool = BLI_task_pool_create_background_serial(anim, TASK_PRIORITY_LOW);
+  }
+  BLI_task_pool_push(anim->lookahead_pool, ffmpeg_lookahead_task, data, true, nullptr);
+}
+
+static ImBuf *ffmpeg_fetchibuf_lookahead(ImBufAnim *anim, int position, IMB_Timecode_Type tc)
+{
+  const int step = position - anim->lookahead_last_position;
+  const bool is_playing = ELEM(step, -1, 1) && step == anim->lookahead_step &&
+                          tc == anim->lookahead_tc;
+
+  if (anim->lookahead_pool) {
+    if (is_playing || step == 0) {
+      BLI_task_pool_work_and_wait(anim->lookahead_pool);
+    }
+    else {
+      /* Don't wait for frames that are not going to be used. */
+      BLI_task_pool_cancel(anim->lookahead_pool);
+    }
+  }
+
+  if (step != 0) {
+    anim->lookahead_last_position = position;
+    anim->lookahead_step = step;
+  }
+  if (tc != anim->lookahead_tc) {
+    ffmpeg_lookahead_clear(anim);
+    anim->lookahead_tc = tc;
+  }
+
+  /* Use the frame when it was decoded ahead, and free frames that are not going to be used. The
+   * frames in the playback direction are kept when the same frame is requested again. */
+  ImBuf *ibuf = nullptr;
+  for (int slot = 0; slot < ANIM_LOOKAHEAD_FRAMES; slot++) {
+    ImBuf *lookahead_ibuf = anim->lookahead_ibufs[slot];
+    if (lookahead_ibuf == nullptr) {
+      continue;
+    }
+    const int offset = (anim->lookahead_positions[slot] - position) * anim->lookahead_step;
+    if (offset == 0 && ibuf == nullptr) {
+      ibuf = lookahead_ibuf;
+    }
+    else if (offset > 0 && offset <= ANIM_LOOKAHEAD_FRAMES && (is_playing || step == 0)) {
+      continue;
+    }
+    else {
+      IMB_freeImBuf(lookahead_ibuf);
+    }
+    anim->lookahead_ibufs[slot] = nullptr;
+  }
+
+  if (ibuf == nullptr) {
+    ibuf = ffmpeg_fetchibuf(anim, position, tc);
+  }
+
+  if (is_playing) {
+    ffmpeg_lookahead_start(anim, position, step);
+  }
+  return ibuf;
+}
+
+/** \} */
+
 static void free_anim_ffmpeg(ImBufAnim *anim)
 {
   if (anim == nullptr) {
     return;
   }
 
+  if (anim->lookahead_pool) {
+    BLI_task_pool_cancel(anim->lookahead_pool);
+    BLI_task_pool_free(anim->lookahead_pool);
+    anim->lookahead_pool = nullptr;
+  }
+  ffmpeg_lookahead_clear(anim);
+
   if (anim->pCodecCtx) {
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -1183,13 +1496,28 @@ static void free_anim_ffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrame_backup);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameSoftware);
     BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
+    if (anim->hw_convert_ctx) {
+      BKE_ffmpeg_sws_release_context(anim->hw_convert_ctx);
+    }
   }
   anim->duration_in_frames = 0;
 }
 
 #endif
 
+void IMB_anim_lookahead_cancel(ImBufAnim *anim)
+{
+#ifdef WITH_FFMPEG
+  if (anim->lookahead_pool) {
+    BLI_task_pool_cancel(anim->lookahead_pool);
+  }
+#else
+  UNUSED_VARS(anim);
+#endif
+}
+
 /**
  * Try to initialize the #anim struct.
  * Returns true on success.
@@ -1288,15 +1616,14 @@ ImBuf *IMB_anim_absolute(ImBufAnim *anim,
 
 #ifdef WITH_FFMPEG
   if (anim->state == ImBufAnim::State::Valid) {
-    ibuf = ffmpeg_fetchibuf(anim, position, tc);
-    if (ibuf) {
-      anim->cur_position = position;
-    }
+    /* The current position is the position of the last decoded frame, which can be different
+     * from the requested one when it was decoded ahead. */
+    ibuf = ffmpeg_fetchibuf_lookahead(anim, position, tc);
   }
 #endif
 
   if (ibuf) {
-    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, anim->cur_position + 1);
+    SNPRINTF(ibuf->filepath, "%s.%04d", anim->filepath, position + 1);
   }
   return ibuf;
 }
@@ -1549,6 +1549,8 @@ bool IMB_colormanagement_set_whitepoint(const float whitepoint[3], float &temper
 
 struct DisplayBufferThread {
   ColormanageProcessor *cm_processor;
+  /* Converts the image buffer to scene linear, null when it already is. */
+  ColormanageProcessor *to_scene_linear_processor;
 
   const float *buffer;
   uchar *byte_buffer;
@@ -1565,13 +1567,13 @@ struct DisplayBufferThread {
   bool is_data;
   bool predivide;
 
-  const char *byte_colorspace;
   const char *float_colorspace;
 };
 
 struct DisplayBufferInitData {
   ImBuf *ibuf;
   ColormanageProcessor *cm_processor;
+  ColormanageProcessor *to_scene_linear_processor;
   const float *buffer;
   uchar *byte_buffer;
 
@@ -1580,7 +1582,6 @@ struct DisplayBufferInitData {
 
   int width;
 
-  const char *byte_colorspace;
   const char *float_colorspace;
 };
 
@@ -1603,6 +1604,7 @@ static void display_buffer_init_handle(void *handle_v,
   memset(handle, 0, sizeof(DisplayBufferThread));
 
   handle->cm_processor = init_data->cm_processor;
+  handle->to_scene_linear_processor = init_data->to_scene_linear_processor;
 
   if (init_data->buffer) {
     handle->buffer = init_data->buffer + offset;
@@ -1630,7 +1632,6 @@ static void display_buffer_init_handle(void *handle_v,
   handle->is_data = is_data;
   handle->predivide = IMB_alpha_affects_rgb(ibuf);
 
-  handle->byte_colorspace = init_data->byte_colorspace;
   handle->float_colorspace = init_data->float_colorspace;
 }
 
@@ -1651,9 +1652,6 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
   if (!handle->buffer) {
     uchar *byte_buffer = handle->byte_buffer;
 
-    const char *from_colorspace = handle->byte_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     float *fp;
     uchar *cp;
     const size_t i_last = size_t(width) * height;
@@ -1674,10 +1672,10 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
       }
     }
 
-    if (!is_data && !is_data_display) {
+    if (!is_data && !is_data_display && handle->to_scene_linear_processor) {
       /* convert float buffer to scene linear space */
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, false);
+      IMB_colormanagement_processor_apply(
+          handle->to_scene_linear_processor, linear_buffer, width, height, channels, false);
     }
 
     *is_straight_alpha = true;
@@ -1689,14 +1687,11 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
      * Need to convert float buffer to linear space before applying display transform
      */
 
-    const char *from_colorspace = handle->float_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     memcpy(linear_buffer, handle->buffer, buffer_size * sizeof(float));
 
-    if (!is_data && !is_data_display) {
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, predivide);
+    if (!is_data && !is_data_display && handle->to_scene_linear_processor) {
+      IMB_colormanagement_processor_apply(
+          handle->to_scene_linear_processor, linear_buffer, width, height, channels, predivide);
     }
 
     *is_straight_alpha = false;
@@ -1714,9 +1709,8 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
   }
 }
 
-static void *do_display_buffer_apply_thread(void *handle_v)
+static void do_display_buffer_apply_thread(DisplayBufferThread *handle)
 {
-  DisplayBufferThread *handle = (DisplayBufferThread *)handle_v;
   ColormanageProcessor *cm_processor = handle->cm_processor;
   float *display_buffer = handle->display_buffer;
   uchar *display_buffer_byte = handle->display_buffer_byte;
@@ -1803,8 +1797,25 @@ static void *do_display_buffer_apply_thread(void *handle_v)
 
     MEM_freeN(linear_buffer);
   }
+}
 
-  return nullptr;
+/**
+ * Processor converting from the color space to scene linear, or null when that does not change
+ * the pixels.
+ */
+static ColormanageProcessor *display_buffer_to_scene_linear_processor_new(
+    const char *from_colorspace)
+{
+  if (from_colorspace[0] == '\0' || STREQ(from_colorspace, global_role_scene_linear)) {
+    return nullptr;
+  }
+  ColormanageProcessor *cm_processor = IMB_colormanagement_colorspace_processor_new(
+      from_colorspace, global_role_scene_linear);
+  if (IMB_colormanagement_processor_is_noop(cm_processor)) {
+    IMB_colormanagement_processor_free(cm_processor);
+    return nullptr;
+  }
+  return cm_processor;
 }
 
 static void display_buffer_apply_threaded(ImBuf *ibuf,
@@ -1814,23 +1825,26 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
                                           uchar *display_buffer_byte,
                                           ColormanageProcessor *cm_processor)
 {
+  using namespace blender;
   DisplayBufferInitData init_data;
 
   init_data.ibuf = ibuf;
   init_data.cm_processor = cm_processor;
+  init_data.to_scene_linear_processor = nullptr;
   init_data.buffer = buffer;
   init_data.byte_buffer = byte_buffer;
   init_data.display_buffer = display_buffer;
   init_data.display_buffer_byte = display_buffer_byte;
 
+  const char *byte_colorspace;
   if (ibuf->byte_buffer.colorspace != nullptr) {
-    init_data.byte_colorspace = ibuf->byte_buffer.colorspace->name;
+    byte_colorspace = ibuf->byte_buffer.colorspace->name;
   }
   else {
     /* happens for viewer images, which are not so simple to determine where to
      * set image buffer's color spaces
      */
-    init_data.byte_colorspace = global_role_default_byte;
+    byte_colorspace = global_role_default_byte;
   }
 
   if (ibuf->float_buffer.colorspace != nullptr) {
@@ -1841,11 +1855,27 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.float_colorspace = nullptr;
   }
 
-  IMB_processor_apply_threaded(ibuf->y,
-                               sizeof(DisplayBufferThread),
-                               &init_data,
-                               display_buffer_init_handle,
-                               do_display_buffer_apply_thread);
+  /* Create the conversion to scene linear once, instead of for every part of the image. */
+  if (cm_processor != nullptr) {
+    if (buffer == nullptr) {
+      init_data.to_scene_linear_processor = display_buffer_to_scene_linear_processor_new(
+          byte_colorspace);
+    }
+    else if (init_data.float_colorspace) {
+      init_data.to_scene_linear_processor = display_buffer_to_scene_linear_processor_new(
+          init_data.float_colorspace);
+    }
+  }
+
+  threading::parallel_for(IndexRange(ibuf->y), 64, [&](const IndexRange y_range) {
+    DisplayBufferThread handle;
+    display_buffer_init_handle(&handle, y_range.start(), y_range.size(), &init_data);
+    do_display_buffer_apply_thread(&handle);
+  });
+
+  if (init_data.to_scene_linear_processor) {
+    IMB_colormanagement_processor_free(init_data.to_scene_linear_processor);
+  }
 }
 
 static bool is_ibuf_rect_in_display_space(ImBuf *ibuf,
@@ -1980,9 +2010,8 @@ static void processor_transform_init_handle(void *handle_v,
   handle->float_from_byte = float_from_byte;
 }
 
-static void *do_processor_transform_thread(void *handle_v)
+static void do_processor_transform_thread(ProcessorTransformThread *handle)
 {
-  ProcessorTransformThread *handle = (ProcessorTransformThread *)handle_v;
   uchar *byte_buffer = handle->byte_buffer;
   float *float_buffer = handle->float_buffer;
   const int channels = handle->channels;
@@ -2015,8 +2044,6 @@ static void *do_processor_transform_thread(void *handle_v)
           handle->cm_processor, float_buffer, width, height, channels, predivide);
     }
   }
-
-  return nullptr;
 }
 
 static void processor_transform_apply_threaded(uchar *byte_buffer,
@@ -2028,6 +2055,7 @@ static void processor_transform_apply_threaded(uchar *byte_buffer,
                                                const bool predivide,
                                                const bool float_from_byte)
 {
+  using namespace blender;
   ProcessorTransformInitData init_data;
 
   init_data.cm_processor = cm_processor;
@@ -2039,11 +2067,11 @@ static void processor_transform_apply_threaded(uchar *byte_buffer,
   init_data.predivide = predivide;
   init_data.float_from_byte = float_from_byte;
 
-  IMB_processor_apply_threaded(height,
-                               sizeof(ProcessorTransformThread),
-                               &init_data,
-                               processor_transform_init_handle,
-                               do_processor_transform_thread);
+  threading::parallel_for(IndexRange(height), 64, [&](const IndexRange y_range) {
+    ProcessorTransformThread handle;
+    processor_transform_init_handle(&handle, y_range.start(), y_range.size(), &init_data);
+    do_processor_transform_thread(&handle);
+  });
 }
 
 /** \} */
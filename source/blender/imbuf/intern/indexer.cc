@@ -1328,6 +1328,8 @@ void IMB_free_indices(ImBufAnim *anim)
 {
   int i;
 
+  IMB_anim_lookahead_cancel(anim);
+
   for (i = 0; i < IMB_PROXY_MAX_SLOT; i++) {
     if (anim->proxy_anim[i]) {
       IMB_close_anim(anim->proxy_anim[i]);
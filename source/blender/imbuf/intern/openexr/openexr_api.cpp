@@ -50,6 +50,7 @@
 #include <OpenEXR/ImfRgbaFile.h>
 #include <OpenEXR/ImfStandardAttributes.h>
 #include <OpenEXR/ImfStringAttribute.h>
+#include <OpenEXR/ImfTiledRgbaFile.h>
 #include <OpenEXR/ImfVersion.h>
 
 /* multiview/multipart */
@@ -79,6 +80,8 @@
 #include "BLI_fileops.h"
 #include "BLI_math_color.h"
 #include "BLI_mmap.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.hh"
@@ -497,38 +500,31 @@ static bool imb_save_openexr_half(ImBuf *ibuf, const char *filepath, const int f
     if (is_alpha) {
       frameBuffer.insert("A", Slice(HALF, (char *)&to->a, xstride, ystride));
     }
-    if (ibuf->float_buffer.data) {
-      float *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = ibuf->float_buffer.data + channels * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = float_to_half_safe(from[0]);
-          to->g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
-          to->b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
-          to->a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
-          to++;
-          from += channels;
-        }
-      }
-    }
-    else {
-      uchar *from;
-
-      for (int i = ibuf->y - 1; i >= 0; i--) {
-        from = ibuf->byte_buffer.data + 4 * i * width;
-
-        for (int j = ibuf->x; j > 0; j--) {
-          to->r = srgb_to_linearrgb(float(from[0]) / 255.0f);
-          to->g = srgb_to_linearrgb(float(from[1]) / 255.0f);
-          to->b = srgb_to_linearrgb(float(from[2]) / 255.0f);
-          to->a = channels >= 4 ? float(from[3]) / 255.0f : 1.0f;
-          to++;
-          from += 4;
-        }
-      }
-    }
+    /* Rows are flipped, the file starts with the top scan-line. */
+    blender::threading::parallel_for(
+        blender::IndexRange(height), 64, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            RGBAZ *to_row = pixels.data() + (height - 1 - i) * width;
+            if (ibuf->float_buffer.data) {
+              const float *from = ibuf->float_buffer.data + channels * i * width;
+              for (int j = 0; j < width; j++, from += channels) {
+                to_row[j].r = float_to_half_safe(from[0]);
+                to_row[j].g = float_to_half_safe((channels >= 2) ? from[1] : from[0]);
+                to_row[j].b = float_to_half_safe((channels >= 3) ? from[2] : from[0]);
+                to_row[j].a = float_to_half_safe((channels >= 4) ? from[3] : 1.0f);
+              }
+            }
+            else {
+              const uchar *from = ibuf->byte_buffer.data + 4 * i * width;
+              for (int j = 0; j < width; j++, from += 4) {
+                to_row[j].r = srgb_to_linearrgb(float(from[0]) / 255.0f);
+                to_row[j].g = srgb_to_linearrgb(float(from[1]) / 255.0f);
+                to_row[j].b = srgb_to_linearrgb(float(from[2]) / 255.0f);
+                to_row[j].a = channels >= 4 ? float(from[3]) / 255.0f : 1.0f;
+              }
+            }
+          }
+        });
 
     exr_printf("OpenEXR-save: Writing OpenEXR file of height %d.\n", height);
 
@@ -1155,14 +1151,28 @@ void IMB_exr_write_channels(void *handle)
       current_rect_half = rect_half;
     }
 
+    /* Files with many passes spend most of their time converting to half, do that for all
+     * channels at once and in parallel over the pixels. */
+    blender::Vector<std::pair<const ExrChannel *, half *>> half_channels;
+    LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
+      if (echan->use_half_float) {
+        half_channels.append({echan, rect_half + half_channels.size() * num_pixels});
+      }
+    }
+    blender::threading::parallel_for(
+        blender::IndexRange(num_pixels), 16384, [&](const blender::IndexRange range) {
+          for (const std::pair<const ExrChannel *, half *> &channel : half_channels) {
+            const float *rect = channel.first->rect;
+            const int xstride = channel.first->xstride;
+            for (const int64_t i : range) {
+              channel.second[i] = float_to_half_safe(rect[i * xstride]);
+            }
+          }
+        });
+
     LISTBASE_FOREACH (ExrChannel *, echan, &data->channels) {
       /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -2267,6 +2277,65 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, char colorspac
   }
 }
 
+/**
+ * Create a thumbnail from the smallest mip-map level of a tiled file that is still at least as
+ * large as the thumbnail, so only a fraction of the tiles have to be decoded. Returns null when
+ * the file has no such level, in which case the full resolution image has to be sampled.
+ */
+static ImBuf *imb_load_thumbnail_from_mip_level(IStream &stream, const size_t max_thumb_size)
+{
+  stream.seekg(0);
+  TiledRgbaInputFile file(stream, 1);
+  if (!file.isComplete() || file.levelMode() == ONE_LEVEL) {
+    return nullptr;
+  }
+
+  /* Both directions are reduced in the same steps, for rip-maps that is the diagonal. */
+  const int levels_num = file.levelMode() == MIPMAP_LEVELS ?
+                             file.numLevels() :
+                             std::min(file.numXLevels(), file.numYLevels());
+  int level = 0;
+  while (level + 1 < levels_num &&
+         size_t(std::max(file.levelWidth(level + 1), file.levelHeight(level + 1))) >=
+             max_thumb_size)
+  {
+    level++;
+  }
+  if (level == 0) {
+    return nullptr;
+  }
+
+  const Box2i dw = file.dataWindowForLevel(level, level);
+  const int source_w = dw.max.x - dw.min.x + 1;
+  const int source_h = dw.max.y - dw.min.y + 1;
+  Imf::Array2D<Imf::Rgba> pixels(source_h, source_w);
+  file.setFrameBuffer(&pixels[0][0] - dw.min.x - dw.min.y * source_w, 1, source_w);
+  file.readTiles(0, file.numXTiles(level) - 1, 0, file.numYTiles(level) - 1, level, level);
+
+  const float scale_factor = std::min(float(max_thumb_size) / float(source_w),
+                                      float(max_thumb_size) / float(source_h));
+  const int dest_w = std::max(int(source_w * scale_factor), 1);
+  const int dest_h = std::max(int(source_h * scale_factor), 1);
+
+  ImBuf *ibuf = IMB_allocImBuf(dest_w, dest_h, 32, IB_rectfloat);
+  for (int h = 0; h < dest_h; h++) {
+    const int source_y = std::min(int(float(h) / scale_factor), source_h - 1);
+    for (int w = 0; w < dest_w; w++) {
+      const int source_x = std::min(int(float(w) / scale_factor), source_w - 1);
+      const Imf::Rgba &source_px = pixels[source_y][source_x];
+      float *dest_px = &ibuf->float_buffer.data[(h * dest_w + w) * 4];
+      dest_px[0] = source_px.r;
+      dest_px[1] = source_px.g;
+      dest_px[2] = source_px.b;
+      dest_px[3] = source_px.a;
+    }
+  }
+
+  /* The rows were read from top to bottom. */
+  IMB_flipy(ibuf);
+  return ibuf;
+}
+
 ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
                                            const int /*flags*/,
                                            const size_t max_thumb_size,
@@ -2322,6 +2391,20 @@ ImBuf *imb_load_filepath_thumbnail_openexr(const char *filepath,
       colorspace_set_default_role(colorspace, IM_MAX_SPACE, COLOR_ROLE_DEFAULT_FLOAT);
     }
 
+    /* Sampling rows of a large tiled file still decodes nearly every tile, prefer reading one of
+     * its lower resolution levels. */
+    if (file->header().hasTileDescription()) {
+      delete file;
+      file = nullptr;
+      ImBuf *ibuf = imb_load_thumbnail_from_mip_level(*stream, max_thumb_size);
+      if (ibuf) {
+        delete stream;
+        return ibuf;
+      }
+      stream->seekg(0);
+      file = new RgbaInputFile(*stream, 1);
+    }
+
     float scale_factor = std::min(float(max_thumb_size) / float(source_w),
                                   float(max_thumb_size) / float(source_h));
     int dest_w = std::max(int(source_w * scale_factor), 1);
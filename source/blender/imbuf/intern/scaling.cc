@@ -8,7 +8,11 @@
 
 #include <cmath>
 
+#include "BLI_array.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 #include "MEM_guardedalloc.h"
 
 #include "IMB_filter.hh"
@@ -18,6 +22,8 @@
 
 #include "BLI_sys_types.h" /* for intptr_t support */
 
+using namespace blender;
+
 static void imb_half_x_no_alloc(ImBuf *ibuf2, ImBuf *ibuf1)
 {
   uchar *p1, *_p1, *dest;
@@ -748,694 +754,222 @@ static bool q_scale_linear_interpolation(ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(ImBuf *ibuf, int newx)
-{
-  const bool do_rect = (ibuf->byte_buffer.data != nullptr);
-  const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
-
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+/* -------------------------------------------------------------------- */
+/** \name Separable Scaling
+ *
+ * Images are scaled along one axis at a time. The source pixels that contribute to every
+ * destination pixel and their weights only depend on the image size along that axis, so they are
+ * computed once and used for all rows or columns. The inner loops then only do multiply-adds of
+ * consecutive pixels, which the compiler vectorizes, and rows are processed in parallel.
+ * \{ */
+
+/** Source pixel weights of every destination pixel along one axis. */
+struct ScaleWeights {
+  struct Pixel {
+    /** First source pixel, the weights are for consecutive source pixels. */
+    int src_first;
+    IndexRange weights;
+  };
+  Array<Pixel> pixels;
+  Vector<float> weights;
+};
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
+/**
+ * Box filter for scaling down, every destination pixel is the average of the source pixels it
+ * covers, including partially covered pixels at its borders.
+ */
+static ScaleWeights scale_weights_box(const int src_size, const int dst_size)
+{
+  ScaleWeights result;
+  result.pixels.reinitialize(dst_size);
+  result.weights.reserve(dst_size * (src_size / dst_size + 2));
+
+  const float add = (src_size - 0.01) / dst_size;
+  /* Part of the last used source pixel that is not covered yet, negative or zero. */
+  float sample = 0.0f;
+  int src = 0;
+  for (const int dst : IndexRange(dst_size)) {
+    const int weights_start = result.weights.size();
+    auto add_weight = [&](const float weight) {
+      if (src < src_size) {
+        result.weights.append(weight / add);
+      }
+      src++;
+    };
 
-  if (do_rect) {
-    _newrect = static_cast<uchar *>(MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx"));
-    if (_newrect == nullptr) {
-      return ibuf;
+    /* The last pixel of the previous destination pixel is partially covered by this one. */
+    const bool use_previous = sample < 0.0f;
+    if (use_previous) {
+      src--;
     }
-  }
-  if (do_float) {
-    _newrectf = static_cast<float *>(
-        MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf"));
-    if (_newrectf == nullptr) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
+    result.pixels[dst].src_first = src;
+    if (use_previous) {
+      add_weight(-sample);
     }
-  }
-
-  add = (ibuf->x - 0.01) / newx;
-
-  if (do_rect) {
-    rect = ibuf->byte_buffer.data;
-    newrect = _newrect;
-  }
-  if (do_float) {
-    rectf = ibuf->float_buffer.data;
-    newrectf = _newrectf;
-  }
-
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
-
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
-      }
-
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += 4;
-      }
-      if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
-
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
-
-        newrectf += 4;
-      }
-
+    sample += add;
+    while (sample >= 1.0f) {
       sample -= 1.0f;
+      add_weight(1.0f);
     }
-  }
-
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ibuf->byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
-    imb_freerectImBuf(ibuf);
-    IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
+    add_weight(sample);
+    sample -= 1.0f;
 
-    imb_freerectfloatImBuf(ibuf);
-    IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
+    result.pixels[dst].weights = IndexRange::from_begin_end(weights_start,
+                                                            result.weights.size());
   }
-
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->x = newx;
-  return ibuf;
+  return result;
 }
 
-static ImBuf *scaledowny(ImBuf *ibuf, int newy)
+/** Linear interpolation between the two nearest source pixels for scaling up. */
+static ScaleWeights scale_weights_linear(const int src_size, const int dst_size)
 {
-  const bool do_rect = (ibuf->byte_buffer.data != nullptr);
-  const bool do_float = (ibuf->float_buffer.data != nullptr);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
-
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
-
-  rectf = _newrectf = newrectf = nullptr;
-  rect = _newrect = newrect = nullptr;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
-
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
-
-  if (do_rect) {
-    _newrect = static_cast<uchar *>(MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny"));
-    if (_newrect == nullptr) {
-      return ibuf;
-    }
-  }
-  if (do_float) {
-    _newrectf = static_cast<float *>(
-        MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf"));
-    if (_newrectf == nullptr) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ibuf->byte_buffer.data + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->float_buffer.data + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
-
-      sample += add;
-
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
-
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
-
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
-
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
-
-        newrect += skipx;
-      }
-      if (do_float) {
-
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
-
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
-
-        newrectf += skipx;
-      }
-
+  ScaleWeights result;
+  result.pixels.reinitialize(dst_size);
+
+  /* Special case, copy the single source pixel, since the interpolation below needs at least two
+   * pixels to interpolate between, see #70356. */
+  if (UNLIKELY(src_size == 1)) {
+    result.weights.append(1.0f);
+    result.pixels.fill({0, IndexRange(1)});
+    return result;
+  }
+
+  result.weights.resize(dst_size * 2);
+  const float add = (src_size - 1.001) / (dst_size - 1.0);
+  float sample = 0.0f;
+  int src = 0;
+  for (const int dst : IndexRange(dst_size)) {
+    if (sample >= 1.0f) {
       sample -= 1.0f;
+      src++;
     }
+    result.weights[dst * 2] = 1.0f - sample;
+    result.weights[dst * 2 + 1] = sample;
+    result.pixels[dst] = {src, IndexRange(dst * 2, 2)};
+    sample += add;
   }
-
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - byte_buffer.data, rect_size);
-    BLI_assert((uchar *)rect - ibuf->byte_buffer.data == rect_size); /* see bug #26502. */
-
-    imb_freerectImBuf(ibuf);
-    IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->float_buffer.data, rect_size);
-    BLI_assert((rectf - ibuf->float_buffer.data) == rect_size); /* see bug #26502. */
-
-    imb_freerectfloatImBuf(ibuf);
-    IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
-  }
-
-  (void)rect_size; /* UNUSED in release builds */
-
-  ibuf->y = newy;
-  return ibuf;
+  return result;
 }
 
-static ImBuf *scaleupx(ImBuf *ibuf, int newx)
+static float4 scale_load(const float4 &value)
 {
-  uchar *rect, *_newrect = nullptr, *newrect;
-  float *rectf, *_newrectf = nullptr, *newrectf;
-  int x, y;
-  bool do_rect = false, do_float = false;
+  return value;
+}
 
-  if (ibuf == nullptr) {
-    return nullptr;
-  }
-  if (ibuf->byte_buffer.data == nullptr && ibuf->float_buffer.data == nullptr) {
-    return ibuf;
-  }
+static float4 scale_load(const uchar4 &value)
+{
+  return float4(value);
+}
 
-  if (ibuf->byte_buffer.data) {
-    do_rect = true;
-    _newrect = static_cast<uchar *>(MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx"));
-    if (_newrect == nullptr) {
-      return ibuf;
-    }
-  }
-  if (ibuf->float_buffer.data) {
-    do_float = true;
-    _newrectf = static_cast<float *>(MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaleupxf"));
-    if (_newrectf == nullptr) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
+static void scale_store(const float4 &value, float4 &r_dst)
+{
+  r_dst = value;
+}
 
-  rect = ibuf->byte_buffer.data;
-  rectf = ibuf->float_buffer.data;
-  newrect = _newrect;
-  newrectf = _newrectf;
+static void scale_store(const float4 &value, uchar4 &r_dst)
+{
+  r_dst = uchar4(math::clamp(value + 0.5f, 0.0f, 255.0f));
+}
 
-  /* Special case, copy all columns, needed since the scaling logic assumes there is at least
-   * two rows to interpolate between causing out of bounds read for 1px images, see #70356. */
-  if (UNLIKELY(ibuf->x == 1)) {
-    if (do_rect) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
-          memcpy(newrect, rect, sizeof(char[4]));
-          newrect += 4;
-        }
-        rect += 4;
-      }
-    }
-    if (do_float) {
-      for (y = ibuf->y; y > 0; y--) {
-        for (x = newx; x > 0; x--) {
-          memcpy(newrectf, rectf, sizeof(float[4]));
-          newrectf += 4;
+template<typename T>
+static void scale_rows_x(const T *src,
+                         T *dst,
+                         const int src_width,
+                         const int dst_width,
+                         const int height,
+                         const ScaleWeights &weights)
+{
+  threading::parallel_for(IndexRange(height), 8, [&](const IndexRange y_range) {
+    for (const int y : y_range) {
+      const T *src_row = src + size_t(y) * src_width;
+      T *dst_row = dst + size_t(y) * dst_width;
+      for (const int x : IndexRange(dst_width)) {
+        const ScaleWeights::Pixel &pixel = weights.pixels[x];
+        const float *pixel_weights = weights.weights.data() + pixel.weights.start();
+        const T *src_pixels = src_row + pixel.src_first;
+        float4 value(0.0f);
+        for (const int i : IndexRange(pixel.weights.size())) {
+          value += scale_load(src_pixels[i]) * pixel_weights[i];
         }
-        rectf += 4;
+        scale_store(value, dst_row[x]);
       }
     }
-  }
-  else {
-    const float add = (ibuf->x - 1.001) / (newx - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (y = ibuf->y; y > 0; y--) {
-
-      sample = 0;
-
-      if (do_rect) {
-        val_a = rect[0];
-        nval_a = rect[4];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[5];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[6];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[7];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 8;
-      }
-      if (do_float) {
-        val_af = rectf[0];
-        nval_af = rectf[4];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[5];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[6];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[7];
-        diff_rf = nval_rf - val_rf;
+  });
+}
 
-        rectf += 8;
-      }
-      for (x = newx; x > 0; x--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += 4;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += 4;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += 4;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += 4;
+template<typename T>
+static void scale_rows_y(
+    const T *src, T *dst, const int width, const int dst_height, const ScaleWeights &weights)
+{
+  threading::parallel_for(IndexRange(dst_height), 8, [&](const IndexRange y_range) {
+    Array<float4> row(width);
+    for (const int y : y_range) {
+      const ScaleWeights::Pixel &pixel = weights.pixels[y];
+      const Span<float> pixel_weights = weights.weights.as_span().slice(pixel.weights);
+      row.fill(float4(0.0f));
+      for (const int i : pixel_weights.index_range()) {
+        const T *src_row = src + size_t(pixel.src_first + i) * width;
+        const float weight = pixel_weights[i];
+        for (const int x : IndexRange(width)) {
+          row[x] += scale_load(src_row[x]) * weight;
         }
-        sample += add;
+      }
+      T *dst_row = dst + size_t(y) * width;
+      for (const int x : IndexRange(width)) {
+        scale_store(row[x], dst_row[x]);
       }
     }
-  }
+  });
+}
 
-  if (do_rect) {
+static void scale_ibuf_x(ImBuf *ibuf, const int newx, const ScaleWeights &weights)
+{
+  if (ibuf->byte_buffer.data) {
+    uchar4 *dst = static_cast<uchar4 *>(MEM_mallocN(sizeof(uchar4) * newx * ibuf->y, __func__));
+    scale_rows_x(reinterpret_cast<const uchar4 *>(ibuf->byte_buffer.data),
+                 dst,
+                 ibuf->x,
+                 newx,
+                 ibuf->y,
+                 weights);
     imb_freerectImBuf(ibuf);
-    IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
+    IMB_assign_byte_buffer(ibuf, reinterpret_cast<uint8_t *>(dst), IB_TAKE_OWNERSHIP);
   }
-  if (do_float) {
+  if (ibuf->float_buffer.data) {
+    float4 *dst = static_cast<float4 *>(MEM_mallocN(sizeof(float4) * newx * ibuf->y, __func__));
+    scale_rows_x(reinterpret_cast<const float4 *>(ibuf->float_buffer.data),
+                 dst,
+                 ibuf->x,
+                 newx,
+                 ibuf->y,
+                 weights);
     imb_freerectfloatImBuf(ibuf);
-    IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
+    IMB_assign_float_buffer(ibuf, reinterpret_cast<float *>(dst), IB_TAKE_OWNERSHIP);
   }
-
   ibuf->x = newx;
-  return ibuf;
 }
 
-static ImBuf *scaleupy(ImBuf *ibuf, int newy)
+static void scale_ibuf_y(ImBuf *ibuf, const int newy, const ScaleWeights &weights)
 {
-  uchar *rect, *_newrect = nullptr, *newrect;
-  float *rectf, *_newrectf = nullptr, *newrectf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
-
-  if (ibuf == nullptr) {
-    return nullptr;
-  }
-  if (ibuf->byte_buffer.data == nullptr && ibuf->float_buffer.data == nullptr) {
-    return ibuf;
-  }
-
   if (ibuf->byte_buffer.data) {
-    do_rect = true;
-    _newrect = static_cast<uchar *>(MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy"));
-    if (_newrect == nullptr) {
-      return ibuf;
-    }
-  }
-  if (ibuf->float_buffer.data) {
-    do_float = true;
-    _newrectf = static_cast<float *>(MEM_mallocN(sizeof(float[4]) * ibuf->x * newy, "scaleupyf"));
-    if (_newrectf == nullptr) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
-  }
-
-  rect = ibuf->byte_buffer.data;
-  rectf = ibuf->float_buffer.data;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  skipx = 4 * ibuf->x;
-
-  /* Special case, copy all rows, needed since the scaling logic assumes there is at least
-   * two rows to interpolate between causing out of bounds read for 1px images, see #70356. */
-  if (UNLIKELY(ibuf->y == 1)) {
-    if (do_rect) {
-      for (y = newy; y > 0; y--) {
-        memcpy(newrect, rect, sizeof(char) * skipx);
-        newrect += skipx;
-      }
-    }
-    if (do_float) {
-      for (y = newy; y > 0; y--) {
-        memcpy(newrectf, rectf, sizeof(float) * skipx);
-        newrectf += skipx;
-      }
-    }
-  }
-  else {
-    const float add = (ibuf->y - 1.001) / (newy - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (x = ibuf->x; x > 0; x--) {
-      sample = 0;
-      if (do_rect) {
-        rect = ibuf->byte_buffer.data + 4 * (x - 1);
-        newrect = _newrect + 4 * (x - 1);
-
-        val_a = rect[0];
-        nval_a = rect[skipx];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[skipx + 1];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[skipx + 2];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[skipx + 3];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 2 * skipx;
-      }
-      if (do_float) {
-        rectf = ibuf->float_buffer.data + 4 * (x - 1);
-        newrectf = _newrectf + 4 * (x - 1);
-
-        val_af = rectf[0];
-        nval_af = rectf[skipx];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[skipx + 1];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[skipx + 2];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[skipx + 3];
-        diff_rf = nval_rf - val_rf;
-
-        rectf += 2 * skipx;
-      }
-
-      for (y = newy; y > 0; y--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += skipx;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += skipx;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += skipx;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += skipx;
-        }
-        sample += add;
-      }
-    }
-  }
-
-  if (do_rect) {
+    uchar4 *dst = static_cast<uchar4 *>(MEM_mallocN(sizeof(uchar4) * ibuf->x * newy, __func__));
+    scale_rows_y(
+        reinterpret_cast<const uchar4 *>(ibuf->byte_buffer.data), dst, ibuf->x, newy, weights);
     imb_freerectImBuf(ibuf);
-    IMB_assign_byte_buffer(ibuf, _newrect, IB_TAKE_OWNERSHIP);
+    IMB_assign_byte_buffer(ibuf, reinterpret_cast<uint8_t *>(dst), IB_TAKE_OWNERSHIP);
   }
-  if (do_float) {
+  if (ibuf->float_buffer.data) {
+    float4 *dst = static_cast<float4 *>(MEM_mallocN(sizeof(float4) * ibuf->x * newy, __func__));
+    scale_rows_y(
+        reinterpret_cast<const float4 *>(ibuf->float_buffer.data), dst, ibuf->x, newy, weights);
     imb_freerectfloatImBuf(ibuf);
-    IMB_assign_float_buffer(ibuf, _newrectf, IB_TAKE_OWNERSHIP);
+    IMB_assign_float_buffer(ibuf, reinterpret_cast<float *>(dst), IB_TAKE_OWNERSHIP);
   }
-
   ibuf->y = newy;
-  return ibuf;
 }
 
+/** \} */
+
 bool IMB_scaleImBuf(ImBuf *ibuf, uint newx, uint newy)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
@@ -1458,16 +992,16 @@ bool IMB_scaleImBuf(ImBuf *ibuf, uint newx, uint newy)
   }
 
   if (newx && (newx < ibuf->x)) {
-    scaledownx(ibuf, newx);
+    scale_ibuf_x(ibuf, newx, scale_weights_box(ibuf->x, newx));
   }
   if (newy && (newy < ibuf->y)) {
-    scaledowny(ibuf, newy);
+    scale_ibuf_y(ibuf, newy, scale_weights_box(ibuf->y, newy));
   }
   if (newx && (newx > ibuf->x)) {
-    scaleupx(ibuf, newx);
+    scale_ibuf_x(ibuf, newx, scale_weights_linear(ibuf->x, newx));
   }
   if (newy && (newy > ibuf->y)) {
-    scaleupy(ibuf, newy);
+    scale_ibuf_y(ibuf, newy, scale_weights_linear(ibuf->y, newy));
   }
 
   return true;
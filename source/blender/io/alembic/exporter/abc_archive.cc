@@ -19,13 +19,6 @@
 #include <Alembic/AbcCoreOgawa/ReadWrite.h>
 #include <Alembic/AbcGeom/ArchiveBounds.h>
 
-#ifdef WIN32
-#  include "BLI_path_util.h"
-#  include "BLI_string.h"
-
-#  include "utfconv.hh"
-#endif
-
 namespace blender::io::alembic {
 
 using Alembic::Abc::ErrorHandler;
@@ -69,22 +62,14 @@ static MetaData create_abc_metadata(const Main *bmain, double scene_fps)
   return abc_metadata;
 }
 
-static OArchive *create_archive(std::ofstream *abc_ostream,
+static OArchive *create_archive(ABCBackgroundFileBuffer *abc_file_buffer,
+                                std::ostream *abc_ostream,
                                 const std::string &filepath,
                                 MetaData &abc_metadata)
 {
-  /* Use stream to support unicode character paths on Windows. */
-#ifdef WIN32
-  char filepath_cstr[FILE_MAX];
-  BLI_strncpy(filepath_cstr, filepath.c_str(), FILE_MAX);
-
-  UTF16_ENCODE(filepath_cstr);
-  std::wstring wstr(filepath_cstr_16);
-  abc_ostream->open(wstr.c_str(), std::ios::out | std::ios::binary);
-  UTF16_UN_ENCODE(filepath_cstr);
-#else
-  abc_ostream->open(filepath, std::ios::out | std::ios::binary);
-#endif
+  if (!abc_file_buffer->open(filepath)) {
+    abc_ostream->setstate(std::ios::failbit);
+  }
 
   ErrorHandler::Policy policy = ErrorHandler::kThrowPolicy;
 
@@ -161,13 +146,13 @@ ABCArchive::ABCArchive(const Main *bmain,
                        const Scene *scene,
                        AlembicExportParams params,
                        const std::string &filepath)
-    : archive(nullptr)
+    : archive(nullptr), abc_ostream_(&abc_file_buffer_)
 {
   double scene_fps = FPS;
   MetaData abc_metadata = create_abc_metadata(bmain, scene_fps);
 
   /* Create the Archive. */
-  archive = create_archive(&abc_ostream_, filepath, abc_metadata);
+  archive = create_archive(&abc_file_buffer_, &abc_ostream_, filepath, abc_metadata);
 
   /* Create time samples for transforms and shapes. */
   TimeSamplingPtr ts_xform;
@@ -201,6 +186,8 @@ ABCArchive::ABCArchive(const Main *bmain,
 ABCArchive::~ABCArchive()
 {
   delete archive;
+  /* Wait for the background thread to write the rest of the archive. */
+  abc_file_buffer_.close();
 }
 
 uint32_t ABCArchive::time_sampling_index_transforms() const
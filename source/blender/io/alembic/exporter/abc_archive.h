@@ -10,11 +10,12 @@
 
 #include "ABC_alembic.h"
 #include "IO_abstract_hierarchy_iterator.h"
+#include "abc_file_buffer.h"
 
 #include <Alembic/Abc/OArchive.h>
 #include <Alembic/Abc/OTypedScalarProperty.h>
 
-#include <fstream>
+#include <ostream>
 #include <set>
 #include <string>
 
@@ -54,7 +55,8 @@ class ABCArchive {
   void update_bounding_box(const Imath::Box3d &bounds);
 
  private:
-  std::ofstream abc_ostream_;
+  ABCBackgroundFileBuffer abc_file_buffer_;
+  std::ostream abc_ostream_;
   uint32_t time_sampling_index_transforms_;
   uint32_t time_sampling_index_shapes_;
 
@@ -0,0 +1,161 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup Alembic
+ */
+
+#include "abc_file_buffer.h"
+
+#include "BLI_fileops.h"
+#include "BLI_task.h"
+
+namespace blender::io::alembic {
+
+ABCBackgroundFileBuffer::~ABCBackgroundFileBuffer()
+{
+  this->close();
+}
+
+bool ABCBackgroundFileBuffer::open(const std::string &filepath)
+{
+  BLI_assert(file_ == nullptr);
+  /* #BLI_fopen supports unicode file paths on Windows. */
+  file_ = BLI_fopen(filepath.c_str(), "wb");
+  if (file_ == nullptr) {
+    return false;
+  }
+  /* The data is written in large blocks, buffering it again is not useful. */
+  setvbuf(file_, nullptr, _IONBF, 0);
+
+  task_pool_ = BLI_task_pool_create_background_serial(this, TASK_PRIORITY_HIGH);
+  buffer_.reinitialize(buffer_size);
+  writing_buffer_.reinitialize(buffer_size);
+  buffer_file_offset_ = 0;
+  write_error_ = false;
+  this->setp(buffer_.begin(), buffer_.end());
+  return true;
+}
+
+bool ABCBackgroundFileBuffer::close()
+{
+  if (file_ == nullptr) {
+    return !write_error_;
+  }
+  this->sync();
+  BLI_task_pool_free(task_pool_);
+  task_pool_ = nullptr;
+  if (fclose(file_) != 0) {
+    write_error_ = true;
+  }
+  file_ = nullptr;
+  this->setp(nullptr, nullptr);
+  buffer_ = {};
+  writing_buffer_ = {};
+  return !write_error_;
+}
+
+int64_t ABCBackgroundFileBuffer::position() const
+{
+  return buffer_file_offset_ + (this->pptr() - this->pbase());
+}
+
+void ABCBackgroundFileBuffer::flush_buffer()
+{
+  const int64_t size = this->pptr() - this->pbase();
+  if (size == 0) {
+    return;
+  }
+  this->wait_for_writes();
+  std::swap(buffer_, writing_buffer_);
+  writing_size_ = size;
+  BLI_task_pool_push(task_pool_, write_task, nullptr, false, nullptr);
+  buffer_file_offset_ += size;
+  this->setp(buffer_.begin(), buffer_.end());
+}
+
+void ABCBackgroundFileBuffer::wait_for_writes()
+{
+  BLI_task_pool_work_and_wait(task_pool_);
+}
+
+void ABCBackgroundFileBuffer::write_task(TaskPool *pool, void * /*taskdata*/)
+{
+  ABCBackgroundFileBuffer &buffer = *static_cast<ABCBackgroundFileBuffer *>(
+      BLI_task_pool_user_data(pool));
+  const size_t size = size_t(buffer.writing_size_);
+  if (fwrite(buffer.writing_buffer_.data(), 1, size, buffer.file_) != size) {
+    buffer.write_error_ = true;
+  }
+}
+
+ABCBackgroundFileBuffer::int_type ABCBackgroundFileBuffer::overflow(const int_type ch)
+{
+  if (file_ == nullptr || write_error_) {
+    return traits_type::eof();
+  }
+  this->flush_buffer();
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *this->pptr() = traits_type::to_char_type(ch);
+    this->pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int ABCBackgroundFileBuffer::sync()
+{
+  if (file_ == nullptr) {
+    return -1;
+  }
+  this->flush_buffer();
+  this->wait_for_writes();
+  if (fflush(file_) != 0) {
+    write_error_ = true;
+  }
+  return write_error_ ? -1 : 0;
+}
+
+ABCBackgroundFileBuffer::pos_type ABCBackgroundFileBuffer::seekoff(
+    const off_type off, const std::ios_base::seekdir dir, const std::ios_base::openmode which)
+{
+  if (file_ == nullptr || !(which & std::ios_base::out)) {
+    return pos_type(off_type(-1));
+  }
+  switch (dir) {
+    case std::ios_base::beg:
+      return this->seekpos(pos_type(off), which);
+    case std::ios_base::cur:
+      return this->seekpos(pos_type(this->position() + off), which);
+    default: {
+      this->flush_buffer();
+      this->wait_for_writes();
+      if (BLI_fseek(file_, off, SEEK_END) != 0) {
+        return pos_type(off_type(-1));
+      }
+      buffer_file_offset_ = BLI_ftell(file_);
+      return pos_type(buffer_file_offset_);
+    }
+  }
+}
+
+ABCBackgroundFileBuffer::pos_type ABCBackgroundFileBuffer::seekpos(
+    const pos_type pos, const std::ios_base::openmode which)
+{
+  if (file_ == nullptr || !(which & std::ios_base::out)) {
+    return pos_type(off_type(-1));
+  }
+  /* Alembic asks for the position before every write, which must not flush the buffer. */
+  if (off_type(pos) == this->position()) {
+    return pos;
+  }
+  this->flush_buffer();
+  this->wait_for_writes();
+  if (BLI_fseek(file_, off_type(pos), SEEK_SET) != 0) {
+    return pos_type(off_type(-1));
+  }
+  buffer_file_offset_ = off_type(pos);
+  return pos;
+}
+
+}  // namespace blender::io::alembic
@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup Alembic
+ */
+
+#pragma once
+
+#include "BLI_array.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <streambuf>
+#include <string>
+
+struct TaskPool;
+
+namespace blender::io::alembic {
+
+/**
+ * Stream buffer for writing an Alembic archive, which writes the data to the file on a background
+ * thread. While one buffer is written to the file, the next one is filled by the exporter, so that
+ * evaluating and converting the next frames does not wait for the disk. The memory usage is
+ * bounded by the two buffers, regardless of the number of exported frames.
+ */
+class ABCBackgroundFileBuffer : public std::streambuf {
+  static constexpr int64_t buffer_size = 16 * 1024 * 1024;
+
+  FILE *file_ = nullptr;
+  TaskPool *task_pool_ = nullptr;
+
+  /** Buffer that is filled by the stream. */
+  Array<char, 0> buffer_;
+  /** Buffer that is written to the file by the background thread. */
+  Array<char, 0> writing_buffer_;
+  int64_t writing_size_ = 0;
+  /** Position in the file of the start of #buffer_. */
+  int64_t buffer_file_offset_ = 0;
+
+  std::atomic<bool> write_error_ = false;
+
+ public:
+  ~ABCBackgroundFileBuffer() override;
+
+  bool open(const std::string &filepath);
+  /** Write all remaining data and close the file. Return false when writing failed. */
+  bool close();
+
+ protected:
+  int_type overflow(int_type ch) override;
+  int sync() override;
+  pos_type seekoff(off_type off,
+                   std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+ private:
+  int64_t position() const;
+  /** Start writing the filled buffer to the file, after waiting for the previous one. */
+  void flush_buffer();
+  void wait_for_writes();
+  static void write_task(TaskPool *pool, void *taskdata);
+};
+
+}  // namespace blender::io::alembic
@@ -11,8 +11,11 @@
 #include <Alembic/Abc/IObject.h>
 
 #include <fstream>
+#include <memory>
 #include <vector>
 
+#include "abc_sample_prefetch.h"
+
 struct Main;
 
 namespace blender::io::alembic {
@@ -24,11 +27,14 @@ namespace blender::io::alembic {
  */
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  /* Ogawa serializes reads on each stream, so open several to allow reading in parallel. */
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
   std::vector<ArchiveReader *> m_readers;
 
+  SamplePrefetcher m_prefetcher;
+
   ArchiveReader(const std::vector<ArchiveReader *> &readers);
 
   ArchiveReader(const struct Main *bmain, const char *filename);
@@ -41,6 +47,8 @@ class ArchiveReader {
   bool valid() const;
 
   Alembic::Abc::IObject getTop();
+
+  SamplePrefetcher &prefetcher();
 };
 
 }  // namespace blender::io::alembic
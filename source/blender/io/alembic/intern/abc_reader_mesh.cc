@@ -435,10 +435,11 @@ static bool samples_have_same_topology(const SampleType &sample, const SampleTyp
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             SampleCache<IPolyMeshSchema::Sample> &sample_cache,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
+  const IPolyMeshSchema::Sample sample = get_cached_sample(schema, sample_cache, selector);
 
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
@@ -451,8 +452,8 @@ static void read_mesh_sample(const std::string &iobject_full_name,
 
   const bool use_vertex_interpolation = settings->read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   if (use_vertex_interpolation && interpolation_settings.has_value()) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
+    const IPolyMeshSchema::Sample ceil_sample = get_cached_sample(
+        schema, sample_cache, Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
     if (samples_have_same_topology(sample, ceil_sample)) {
       /* Only set interpolation data if the samples are compatible. */
       abc_mesh_data.ceil_positions = ceil_sample.getPositions();
@@ -486,13 +487,16 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 }
 
-static CDStreamConfig get_config(Mesh *mesh)
+static CDStreamConfig get_config(Mesh *mesh, const int read_flag)
 {
   CDStreamConfig config;
   config.mesh = mesh;
   config.positions = mesh->vert_positions_for_write().data();
-  config.corner_verts = mesh->corner_verts_for_write().data();
-  config.face_offsets = mesh->face_offsets_for_write().data();
+  /* Only request the topology for writing when it is read, to keep it shared otherwise. */
+  if (read_flag & (MOD_MESHSEQ_READ_POLY | MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR)) {
+    config.corner_verts = mesh->corner_verts_for_write().data();
+    config.face_offsets = mesh->face_offsets_for_write().data();
+  }
   config.totvert = mesh->verts_num;
   config.totloop = mesh->corners_num;
   config.faces_num = mesh->faces_num;
@@ -625,7 +629,7 @@ bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSel
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_cached_sample(m_schema, m_sample_cache, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -684,6 +688,16 @@ bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSel
   return false;
 }
 
+void AbcMeshReader::prefetch(const ISampleSelector &sample_sel)
+{
+  try {
+    get_cached_sample(m_schema, m_sample_cache, sample_sel);
+  }
+  catch (Alembic::Util::Exception & /*ex*/) {
+    /* Errors are reported when the sample is actually read. */
+  }
+}
+
 void AbcMeshReader::read_geometry(bke::GeometrySet &geometry_set,
                                   const Alembic::Abc::ISampleSelector &sample_sel,
                                   const int read_flag,
@@ -711,7 +725,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_cached_sample(m_schema, m_sample_cache, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -773,14 +787,19 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             "read!");
       }
     }
+    else if (read_flag & MOD_MESHSEQ_STABLE_TOPOLOGY) {
+      /* Keep the topology and all other data of the existing mesh. */
+      settings.read_flag &= MOD_MESHSEQ_READ_VERT | MOD_MESHSEQ_INTERPOLATE_VERTICES;
+    }
   }
 
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
-  CDStreamConfig config = get_config(mesh_to_export);
+  CDStreamConfig config = get_config(mesh_to_export, settings.read_flag);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(
+      m_iobject.getFullName(), &settings, m_schema, m_sample_cache, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -863,10 +882,11 @@ void AbcMeshReader::readFaceSetsSample(Main *bmain, Mesh *mesh, const ISampleSel
 static void read_subd_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const ISubDSchema &schema,
+                             SampleCache<ISubDSchema::Sample> &sample_cache,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const ISubDSchema::Sample sample = schema.getValue(selector);
+  const ISubDSchema::Sample sample = get_cached_sample(schema, sample_cache, selector);
 
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
@@ -879,8 +899,8 @@ static void read_subd_sample(const std::string &iobject_full_name,
 
   const bool use_vertex_interpolation = settings->read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   if (use_vertex_interpolation && interpolation_settings.has_value()) {
-    Alembic::AbcGeom::ISubDSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
+    const ISubDSchema::Sample ceil_sample = get_cached_sample(
+        schema, sample_cache, Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
     if (samples_have_same_topology(sample, ceil_sample)) {
       /* Only set interpolation data if the samples are compatible. */
       abc_mesh_data.ceil_positions = ceil_sample.getPositions();
@@ -1023,7 +1043,7 @@ void AbcSubDReader::readObjectData(Main *bmain, const Alembic::Abc::ISampleSelec
 
   ISubDSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_cached_sample(m_schema, m_sample_cache, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -1056,7 +1076,7 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
 {
   ISubDSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_cached_sample(m_schema, m_sample_cache, sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -1102,18 +1122,37 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
             "read!");
       }
     }
+    else if ((read_flag & MOD_MESHSEQ_STABLE_TOPOLOGY) && !m_is_reading_a_file_sequence &&
+             m_schema.getFaceIndicesProperty().isConstant() &&
+             m_schema.getFaceCountsProperty().isConstant())
+    {
+      /* Keep the topology and all other data of the existing mesh. Unlike for polygon meshes the
+       * connectivity is not compared, so only do this when it cannot change over time. */
+      settings.read_flag &= MOD_MESHSEQ_READ_VERT | MOD_MESHSEQ_INTERPOLATE_VERTICES;
+    }
   }
 
   /* Only read point data when streaming meshes, unless we need to create new ones. */
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
-  CDStreamConfig config = get_config(mesh_to_export);
+  CDStreamConfig config = get_config(mesh_to_export, settings.read_flag);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
-  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_subd_sample(
+      m_iobject.getFullName(), &settings, m_schema, m_sample_cache, sample_sel, config);
 
   return mesh_to_export;
 }
 
+void AbcSubDReader::prefetch(const ISampleSelector &sample_sel)
+{
+  try {
+    get_cached_sample(m_schema, m_sample_cache, sample_sel);
+  }
+  catch (Alembic::Util::Exception & /*ex*/) {
+    /* Errors are reported when the sample is actually read. */
+  }
+}
+
 void AbcSubDReader::read_geometry(bke::GeometrySet &geometry_set,
                                   const Alembic::Abc::ISampleSelector &sample_sel,
                                   const int read_flag,
@@ -10,6 +10,7 @@
 #include "BLI_span.hh"
 
 #include "abc_reader_object.h"
+#include "abc_sample_prefetch.h"
 
 #include <Alembic/AbcGeom/IPolyMesh.h>
 #include <Alembic/AbcGeom/ISubD.h>
@@ -20,6 +21,7 @@ namespace blender::io::alembic {
 
 class AbcMeshReader final : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
+  SampleCache<Alembic::AbcGeom::IPolyMeshSchema::Sample> m_sample_cache;
 
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
@@ -47,6 +49,8 @@ class AbcMeshReader final : public AbcObjectReader {
   bool topology_changed(const Mesh *existing_mesh,
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
+  void prefetch(const Alembic::Abc::ISampleSelector &sample_sel) override;
+
  private:
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
@@ -59,6 +63,7 @@ class AbcMeshReader final : public AbcObjectReader {
 
 class AbcSubDReader final : public AbcObjectReader {
   Alembic::AbcGeom::ISubDSchema m_schema;
+  SampleCache<Alembic::AbcGeom::ISubDSchema::Sample> m_sample_cache;
 
  public:
   AbcSubDReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
@@ -76,6 +81,8 @@ class AbcSubDReader final : public AbcObjectReader {
                      const float velocity_scale,
                      const char **err_str) override;
 
+  void prefetch(const Alembic::Abc::ISampleSelector &sample_sel) override;
+
  private:
   struct Mesh *read_mesh(struct Mesh *existing_mesh,
                          const Alembic::Abc::ISampleSelector &sample_sel,
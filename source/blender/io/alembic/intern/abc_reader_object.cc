@@ -41,6 +41,7 @@ AbcObjectReader::AbcObjectReader(const IObject &object, ImportSettings &settings
       m_min_time(std::numeric_limits<chrono_t>::max()),
       m_max_time(std::numeric_limits<chrono_t>::min()),
       m_refcount(0),
+      m_prefetcher(nullptr),
       parent_reader(nullptr)
 {
   m_name = object.getFullName();
@@ -157,6 +158,18 @@ bool AbcObjectReader::topology_changed(const Mesh * /*existing_mesh*/,
   return false;
 }
 
+void AbcObjectReader::prefetch(const Alembic::Abc::ISampleSelector & /*sample_sel*/) {}
+
+SamplePrefetcher *AbcObjectReader::prefetcher() const
+{
+  return m_prefetcher;
+}
+
+void AbcObjectReader::prefetcher(SamplePrefetcher *prefetcher)
+{
+  m_prefetcher = prefetcher;
+}
+
 void AbcObjectReader::setupObjectTransform(const chrono_t time)
 {
   bool is_constant = false;
@@ -29,6 +29,8 @@ using Alembic::AbcCoreAbstract::chrono_t;
 
 namespace blender::io::alembic {
 
+class SamplePrefetcher;
+
 struct ImportSettings {
   bool do_convert_mat;
   float conversion_mat[4][4];
@@ -102,6 +104,9 @@ class AbcObjectReader {
 
   bool m_inherits_xform;
 
+  /* Prefetcher of the archive the reader was opened from, for readers used by cache files. */
+  SamplePrefetcher *m_prefetcher;
+
  public:
   AbcObjectReader *parent_reader;
 
@@ -157,6 +162,15 @@ class AbcObjectReader {
   virtual bool topology_changed(const Mesh *existing_mesh,
                                 const Alembic::Abc::ISampleSelector &sample_sel);
 
+  /**
+   * Read and decode the sample at the given time ahead of its use, so that a later
+   * #read_geometry() does not have to wait for the file. This can be called from any thread.
+   */
+  virtual void prefetch(const Alembic::Abc::ISampleSelector &sample_sel);
+
+  SamplePrefetcher *prefetcher() const;
+  void prefetcher(SamplePrefetcher *prefetcher);
+
   /** Reads the object matrix and sets up an object transform if animated. */
   void setupObjectTransform(chrono_t time);
 
@@ -0,0 +1,113 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include "abc_sample_prefetch.h"
+#include "abc_reader_object.h"
+
+#include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include <cmath>
+
+using Alembic::Abc::ISampleSelector;
+
+namespace blender::io::alembic {
+
+SamplePrefetcher::~SamplePrefetcher()
+{
+  if (m_task_pool) {
+    this->cancel();
+    BLI_task_pool_free(m_task_pool);
+  }
+}
+
+void SamplePrefetcher::add_reader(AbcObjectReader *reader)
+{
+  std::lock_guard lock{m_mutex};
+  m_readers.add(reader);
+}
+
+void SamplePrefetcher::remove_reader(AbcObjectReader *reader)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_readers.remove(reader);
+  }
+  /* A prefetch that started before the reader was removed may still be using it. */
+  if (m_is_prefetching) {
+    this->cancel();
+  }
+}
+
+void SamplePrefetcher::cancel()
+{
+  std::lock_guard task_lock{m_task_mutex};
+  if (m_task_pool) {
+    BLI_task_pool_cancel(m_task_pool);
+  }
+  m_is_prefetching = false;
+}
+
+void SamplePrefetcher::time_requested(const chrono_t time)
+{
+  std::lock_guard task_lock{m_task_mutex};
+  {
+    std::lock_guard lock{m_mutex};
+    /* All readers request the same time while a frame is evaluated. */
+    if (m_has_last_time && time == m_last_time) {
+      return;
+    }
+    /* Only predict the next frame when the time moved by the same step twice, which is the case
+     * during playback but not when jumping around in the timeline. */
+    const chrono_t time_step = m_has_last_time ? time - m_last_time : 0.0;
+    const bool is_playing = time_step != 0.0 &&
+                            std::abs(time_step - m_last_time_step) <= 1e-6 * std::abs(time_step);
+    m_has_last_time = true;
+    m_last_time = time;
+    m_last_time_step = time_step;
+    if (!is_playing || m_readers.is_empty() || m_is_prefetching) {
+      return;
+    }
+    m_prefetch_time = time + time_step;
+  }
+
+  if (m_task_pool == nullptr) {
+    m_task_pool = BLI_task_pool_create_background(this, TASK_PRIORITY_LOW);
+  }
+  m_is_prefetching = true;
+  BLI_task_pool_push(m_task_pool, prefetch_task, nullptr, false, nullptr);
+}
+
+void SamplePrefetcher::prefetch_task(TaskPool *pool, void * /*taskdata*/)
+{
+  SamplePrefetcher &prefetcher = *static_cast<SamplePrefetcher *>(BLI_task_pool_user_data(pool));
+
+  Vector<AbcObjectReader *> readers;
+  chrono_t time;
+  {
+    std::lock_guard lock{prefetcher.m_mutex};
+    readers.extend(prefetcher.m_readers.begin(), prefetcher.m_readers.end());
+    time = prefetcher.m_prefetch_time;
+  }
+
+  /* kFloorIndex is used to match the sample selector used for reading geometry. */
+  const ISampleSelector sample_sel(time, ISampleSelector::kFloorIndex);
+  threading::parallel_for(readers.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (BLI_task_pool_current_canceled(pool)) {
+        return;
+      }
+      readers[i]->prefetch(sample_sel);
+    }
+  });
+
+  prefetcher.m_is_prefetching = false;
+}
+
+}  // namespace blender::io::alembic
@@ -0,0 +1,127 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include <Alembic/Abc/ISampleSelector.h>
+#include <Alembic/AbcCoreAbstract/Foundation.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include "BLI_set.hh"
+
+struct TaskPool;
+
+namespace blender::io::alembic {
+
+class AbcObjectReader;
+
+/**
+ * Small ring buffer of decoded schema samples of one reader, keyed by their sample index. It
+ * holds the samples decoded by the #SamplePrefetcher until the depsgraph uses them, and avoids
+ * reading the same sample again when it is needed several times while evaluating a frame.
+ */
+template<typename Sample> class SampleCache {
+  static constexpr int capacity = 3;
+
+  struct Item {
+    Alembic::AbcCoreAbstract::index_t index = -1;
+    Sample sample;
+  };
+
+  std::mutex m_mutex;
+  std::array<Item, capacity> m_items;
+  int m_next_item = 0;
+
+ public:
+  bool lookup(const Alembic::AbcCoreAbstract::index_t index, Sample &r_sample)
+  {
+    std::lock_guard lock{m_mutex};
+    for (const Item &item : m_items) {
+      if (item.index == index) {
+        r_sample = item.sample;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void add(const Alembic::AbcCoreAbstract::index_t index, const Sample &sample)
+  {
+    std::lock_guard lock{m_mutex};
+    for (const Item &item : m_items) {
+      if (item.index == index) {
+        return;
+      }
+    }
+    /* Overwrite the oldest sample. */
+    m_items[m_next_item] = {index, sample};
+    m_next_item = (m_next_item + 1) % capacity;
+  }
+};
+
+/**
+ * Get the sample of the schema at the selected time, from the cache when it was read before.
+ * Like `Schema::getValue`, this throws an Alembic exception when the sample cannot be read.
+ */
+template<typename Schema>
+typename Schema::Sample get_cached_sample(const Schema &schema,
+                                          SampleCache<typename Schema::Sample> &cache,
+                                          const Alembic::Abc::ISampleSelector &sample_sel)
+{
+  const Alembic::AbcCoreAbstract::index_t index = sample_sel.getIndex(schema.getTimeSampling(),
+                                                                       schema.getNumSamples());
+  typename Schema::Sample sample;
+  if (!cache.lookup(index, sample)) {
+    schema.get(sample, Alembic::Abc::ISampleSelector(index));
+    cache.add(index, sample);
+  }
+  return sample;
+}
+
+/**
+ * Reads the samples of the next frame for all readers of an archive in the background during
+ * playback, so that the depsgraph evaluation of that frame does not have to wait for the file.
+ * The next frame is predicted from the last frames that were requested, and decoded for all
+ * readers in parallel into the #SampleCache of each reader.
+ */
+class SamplePrefetcher {
+  using chrono_t = Alembic::AbcCoreAbstract::chrono_t;
+
+  /** Protects the readers and the times below, the prefetch task only locks this briefly. */
+  std::mutex m_mutex;
+  Set<AbcObjectReader *> m_readers;
+  bool m_has_last_time = false;
+  chrono_t m_last_time = 0.0;
+  chrono_t m_last_time_step = 0.0;
+  chrono_t m_prefetch_time = 0.0;
+
+  /** Serializes starting and canceling the prefetch task. */
+  std::mutex m_task_mutex;
+  TaskPool *m_task_pool = nullptr;
+  std::atomic<bool> m_is_prefetching = false;
+
+ public:
+  ~SamplePrefetcher();
+
+  void add_reader(AbcObjectReader *reader);
+  /** Remove the reader and make sure that it is not used by a running prefetch anymore. */
+  void remove_reader(AbcObjectReader *reader);
+
+  /** Called whenever a sample is read, to start prefetching the next frame during playback. */
+  void time_requested(chrono_t time);
+
+  /** Stop and wait for a running prefetch. */
+  void cancel();
+
+ private:
+  static void prefetch_task(TaskPool *pool, void *taskdata);
+};
+
+}  // namespace blender::io::alembic
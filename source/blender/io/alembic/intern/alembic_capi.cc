@@ -20,6 +20,7 @@
 #include "abc_reader_nurbs.h"
 #include "abc_reader_points.h"
 #include "abc_reader_transform.h"
+#include "abc_sample_prefetch.h"
 #include "abc_util.h"
 
 #include "MEM_guardedalloc.h"
@@ -838,6 +839,11 @@ void ABC_read_geometry(CacheReader *reader,
     return;
   }
 
+  /* Let the prefetcher read the next frame of all objects while this one is evaluated. */
+  if (SamplePrefetcher *prefetcher = abc_reader->prefetcher()) {
+    prefetcher->time_requested(params->time);
+  }
+
   ISampleSelector sample_sel = sample_selector_for_time(params->time);
   return abc_reader->read_geometry(geometry_set,
                                    sample_sel,
@@ -870,6 +876,9 @@ void ABC_CacheReader_free(CacheReader *reader)
   abc_reader->decref();
 
   if (abc_reader->refcount() == 0) {
+    if (SamplePrefetcher *prefetcher = abc_reader->prefetcher()) {
+      prefetcher->remove_reader(abc_reader);
+    }
     delete abc_reader;
   }
 }
@@ -913,5 +922,8 @@ CacheReader *CacheReader_open_alembic_object(CacheArchiveHandle *handle,
   abc_reader->object(object);
   abc_reader->incref();
 
+  abc_reader->prefetcher(&archive->prefetcher());
+  archive->prefetcher().add_reader(abc_reader);
+
   return reinterpret_cast<CacheReader *>(abc_reader);
 }
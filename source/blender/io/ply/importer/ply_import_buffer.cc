@@ -5,6 +5,7 @@
 #include "ply_import_buffer.hh"
 
 #include "BLI_fileops.h"
+#include "BLI_mmap.h"
 
 #include <cstdio>
 #include <cstring>
@@ -25,6 +26,9 @@ PlyReadBuffer::PlyReadBuffer(const char *file_path, size_t read_buffer_size)
 
 PlyReadBuffer::~PlyReadBuffer()
 {
+  if (mmap_file_ != nullptr) {
+    BLI_mmap_free(mmap_file_);
+  }
   if (file_ != nullptr) {
     fclose(file_);
   }
@@ -33,6 +37,39 @@ PlyReadBuffer::~PlyReadBuffer()
 void PlyReadBuffer::after_header(bool is_binary)
 {
   is_binary_ = is_binary;
+  if (!is_binary || file_ == nullptr) {
+    return;
+  }
+  /* Mapping the file moves the file position, restore it in case mapping fails. */
+  const int64_t file_pos = BLI_ftell(file_);
+  mmap_file_ = BLI_mmap_open(fileno(file_));
+  if (mmap_file_ == nullptr) {
+    BLI_fseek(file_, file_pos, SEEK_SET);
+    return;
+  }
+  /* Continue after the part of the read buffer that was used for the header. */
+  mapped_pos_ = size_t(file_pos) - size_t(buf_used_ - pos_);
+}
+
+Span<uint8_t> PlyReadBuffer::mapped_remainder() const
+{
+  if (mmap_file_ == nullptr) {
+    return {};
+  }
+  const size_t length = BLI_mmap_get_length(mmap_file_);
+  const uint8_t *memory = static_cast<const uint8_t *>(
+      BLI_mmap_get_pointer(const_cast<BLI_mmap_file *>(mmap_file_)));
+  return Span<uint8_t>(memory + mapped_pos_, int64_t(length - mapped_pos_));
+}
+
+bool PlyReadBuffer::skip_mapped(size_t size)
+{
+  BLI_assert(mmap_file_ != nullptr);
+  if (mapped_pos_ + size > BLI_mmap_get_length(mmap_file_) || BLI_mmap_has_io_error(mmap_file_)) {
+    return false;
+  }
+  mapped_pos_ += size;
+  return true;
 }
 
 Span<char> PlyReadBuffer::read_line()
@@ -62,6 +99,13 @@ Span<char> PlyReadBuffer::read_line()
 
 bool PlyReadBuffer::read_bytes(void *dst, size_t size)
 {
+  if (mmap_file_ != nullptr) {
+    if (!BLI_mmap_read(mmap_file_, dst, mapped_pos_, size)) {
+      return false;
+    }
+    mapped_pos_ += size;
+    return true;
+  }
   while (size > 0) {
     if (pos_ + size > buf_used_) {
       if (!refill_buffer()) {
@@ -13,6 +13,8 @@
 #include "BLI_array.hh"
 #include "BLI_span.hh"
 
+struct BLI_mmap_file;
+
 namespace blender::io::ply {
 
 /**
@@ -24,7 +26,10 @@ class PlyReadBuffer {
   PlyReadBuffer(const char *file_path, size_t read_buffer_size = 64 * 1024);
   ~PlyReadBuffer();
 
-  /** After header is parsed, indicate whether the rest of reading will be ascii or binary. */
+  /**
+   * After header is parsed, indicate whether the rest of reading will be ascii or binary.
+   * Binary files are memory mapped when possible.
+   */
   void after_header(bool is_binary);
 
   /**
@@ -38,11 +43,25 @@ class PlyReadBuffer {
    */
   bool read_bytes(void *dst, size_t size);
 
+  /**
+   * In binary mode, the rest of the file when it is memory mapped, for reading it directly.
+   * Empty when the file could not be mapped.
+   */
+  Span<uint8_t> mapped_remainder() const;
+
+  /**
+   * Move past a number of bytes at the start of #mapped_remainder. Returns false if the bytes
+   * can not be read, i.e. the file is too short or an IO error happened.
+   */
+  bool skip_mapped(size_t size);
+
  private:
   bool refill_buffer();
 
  private:
   FILE *file_ = nullptr;
+  BLI_mmap_file *mmap_file_ = nullptr;
+  size_t mapped_pos_ = 0;
   Array<char> buffer_;
   int pos_ = 0;
   int buf_used_ = 0;
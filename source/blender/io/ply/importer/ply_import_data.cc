@@ -11,7 +11,9 @@
 #include "ply_import_buffer.hh"
 
 #include "BLI_endian_switch.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "fast_float.h"
 
@@ -266,15 +268,15 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     data->vertex_custom_attr.append(attr);
   }
 
-  data->vertices.reserve(element.count);
+  data->vertices.resize(element.count);
   if (has_color) {
-    data->vertex_colors.reserve(element.count);
+    data->vertex_colors.resize(element.count);
   }
   if (has_normal) {
-    data->vertex_normals.reserve(element.count);
+    data->vertex_normals.resize(element.count);
   }
   if (has_uv) {
-    data->uv_coordinates.reserve(element.count);
+    data->uv_coordinates.resize(element.count);
   }
 
   float4 color_norm = {1, 1, 1, 1};
@@ -287,31 +289,13 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     color_norm.w = data_type_normalizer[element.properties[alpha_index].type];
   }
 
-  Vector<float> value_vec(element.properties.size());
-  Vector<uint8_t> scratch;
-  if (header.type != PlyFormatType::ASCII) {
-    scratch.resize(element.stride);
-  }
-
-  for (int i = 0; i < element.count; i++) {
-
-    const char *error = nullptr;
-    if (header.type == PlyFormatType::ASCII) {
-      error = parse_row_ascii(file, value_vec);
-    }
-    else {
-      error = parse_row_binary(file, header, element, scratch, value_vec);
-    }
-    if (error != nullptr) {
-      return error;
-    }
-
+  auto store_row = [&](const int i, const Span<float> value_vec) {
     /* Vertex coord */
     float3 vertex3;
     vertex3.x = value_vec[vertex_index.x];
     vertex3.y = value_vec[vertex_index.y];
     vertex3.z = value_vec[vertex_index.z];
-    data->vertices.append(vertex3);
+    data->vertices[i] = vertex3;
 
     /* Vertex color */
     if (has_color) {
@@ -325,7 +309,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       else {
         colors4.w = 1.0f;
       }
-      data->vertex_colors.append(colors4);
+      data->vertex_colors[i] = colors4;
     }
 
     /* If normals */
@@ -334,7 +318,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       normals3.x = value_vec[normal_index.x];
       normals3.y = value_vec[normal_index.y];
       normals3.z = value_vec[normal_index.z];
-      data->vertex_normals.append(normals3);
+      data->vertex_normals[i] = normals3;
     }
 
     /* If uv */
@@ -342,7 +326,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float2 uvmap;
       uvmap.x = value_vec[uv_index.x];
       uvmap.y = value_vec[uv_index.y];
-      data->uv_coordinates.append(uvmap);
+      data->uv_coordinates[i] = uvmap;
     }
 
     /* Custom attributes */
@@ -350,6 +334,50 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float value = value_vec[custom_attr_indices[ci]];
       data->vertex_custom_attr[ci].data[i] = value;
     }
+  };
+
+  /* Memory mapped little endian files with fixed size rows are converted in parallel. */
+  const Span<uint8_t> mapped = file.mapped_remainder();
+  if (header.type == PlyFormatType::BINARY_LE && element.stride > 0 && !mapped.is_empty()) {
+    const size_t size = size_t(element.count) * element.stride;
+    if (mapped.size() < size) {
+      return "Could not read row of binary property";
+    }
+    threading::parallel_for(IndexRange(element.count), 4096, [&](const IndexRange range) {
+      Vector<float, 16> value_vec(element.properties.size());
+      for (const int i : range) {
+        const uint8_t *ptr = mapped.data() + size_t(i) * element.stride;
+        for (const int j : element.properties.index_range()) {
+          value_vec[j] = get_binary_value<float>(element.properties[j].type, ptr);
+        }
+        store_row(i, value_vec);
+      }
+    });
+    if (!file.skip_mapped(size)) {
+      return "Could not read row of binary property";
+    }
+    return nullptr;
+  }
+
+  Vector<float> value_vec(element.properties.size());
+  Vector<uint8_t> scratch;
+  if (header.type != PlyFormatType::ASCII) {
+    scratch.resize(element.stride);
+  }
+
+  for (int i = 0; i < element.count; i++) {
+
+    const char *error = nullptr;
+    if (header.type == PlyFormatType::ASCII) {
+      error = parse_row_ascii(file, value_vec);
+    }
+    else {
+      error = parse_row_binary(file, header, element, scratch, value_vec);
+    }
+    if (error != nullptr) {
+      return error;
+    }
+    store_row(i, value_vec);
   }
   return nullptr;
 }
@@ -385,6 +413,105 @@ static void skip_property(PlyReadBuffer &file,
   }
 }
 
+/**
+ * Move past a property of a memory mapped little endian file. Returns null if the property
+ * does not fit into the remaining data.
+ */
+static const uint8_t *skip_property_mapped(const uint8_t *ptr,
+                                           const uint8_t *end,
+                                           const PlyProperty &prop)
+{
+  if (prop.count_type == PlyDataTypes::NONE) {
+    ptr += data_type_size[prop.type];
+    return ptr <= end ? ptr : nullptr;
+  }
+  if (ptr + data_type_size[prop.count_type] > end) {
+    return nullptr;
+  }
+  const uint32_t count = get_binary_value<uint32_t>(prop.count_type, ptr);
+  ptr += size_t(count) * data_type_size[prop.type];
+  return ptr <= end ? ptr : nullptr;
+}
+
+/**
+ * Load faces from a memory mapped little endian file. The rows have varying sizes, so they are
+ * located with a quick serial scan first, then the vertex indices are converted in parallel.
+ */
+static const char *load_face_element_mapped(PlyReadBuffer &file,
+                                            const PlyElement &element,
+                                            const int prop_index,
+                                            PlyData *data)
+{
+  const Span<uint8_t> mapped = file.mapped_remainder();
+  const uint8_t *start = mapped.data();
+  const uint8_t *end = start + mapped.size();
+  const PlyProperty &prop = element.properties[prop_index];
+  const int index_size = data_type_size[prop.type];
+
+  /* Byte offsets of the vertex index lists of the faces that are kept. */
+  Vector<size_t> list_offsets;
+  list_offsets.reserve(element.count);
+  data->face_sizes.reserve(element.count);
+
+  const uint8_t *ptr = start;
+  for (int i = 0; i < element.count; i++) {
+    /* Skip any properties before vertex indices. */
+    for (int j = 0; j < prop_index && ptr; j++) {
+      ptr = skip_property_mapped(ptr, end, element.properties[j]);
+    }
+    if (ptr == nullptr || ptr + data_type_size[prop.count_type] > end) {
+      return "Could not read row of binary property";
+    }
+
+    /* Read vertex indices list size. */
+    const uint32_t count = get_binary_value<uint32_t>(prop.count_type, ptr);
+    if (count < 1 || count > 255) {
+      return "Invalid face size, must be between 1 and 255";
+    }
+    if (ptr + size_t(count) * index_size > end) {
+      return "Could not read row of binary property";
+    }
+    /* Previous python based importer was accepting faces with fewer
+     * than 3 vertices, and silently dropping them. */
+    if (count < 3) {
+      fprintf(stderr, "PLY Importer: ignoring face %i (%i vertices)\n", i, int(count));
+    }
+    else {
+      list_offsets.append(size_t(ptr - start));
+      data->face_sizes.append(count);
+    }
+    ptr += size_t(count) * index_size;
+
+    /* Skip any properties after vertex indices. */
+    for (int j = prop_index + 1; j < element.properties.size() && ptr; j++) {
+      ptr = skip_property_mapped(ptr, end, element.properties[j]);
+    }
+    if (ptr == nullptr) {
+      return "Could not read row of binary property";
+    }
+  }
+
+  Array<int> face_offsets(data->face_sizes.size() + 1);
+  for (const int i : data->face_sizes.index_range()) {
+    face_offsets[i] = int(data->face_sizes[i]);
+  }
+  const OffsetIndices<int> faces = offset_indices::accumulate_counts_to_offsets(face_offsets);
+  data->face_vertices.resize(faces.total_size());
+  threading::parallel_for(faces.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const uint8_t *list_ptr = start + list_offsets[i];
+      for (const int corner : faces[i]) {
+        data->face_vertices[corner] = get_binary_value<uint32_t>(prop.type, list_ptr);
+      }
+    }
+  });
+
+  if (!file.skip_mapped(size_t(ptr - start))) {
+    return "Could not read row of binary property";
+  }
+  return nullptr;
+}
+
 static const char *load_face_element(PlyReadBuffer &file,
                                      const PlyHeader &header,
                                      const PlyElement &element,
@@ -405,6 +532,10 @@ static const char *load_face_element(PlyReadBuffer &file,
     return "Face element vertex indices property must be a list";
   }
 
+  if (header.type == PlyFormatType::BINARY_LE && !file.mapped_remainder().is_empty()) {
+    return load_face_element_mapped(file, element, prop_index, data);
+  }
+
   data->face_vertices.reserve(element.count * 3);
   data->face_sizes.reserve(element.count);
 
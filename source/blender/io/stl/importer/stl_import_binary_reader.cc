@@ -8,10 +8,16 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <iostream>
 
+#include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
 
 #include "BLI_array.hh"
+#include "BLI_concurrent_map.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -22,9 +28,121 @@
 
 namespace blender::io::stl {
 
+/**
+ * Find the first corner with the same key for every corner, in parallel. Using the first corner
+ * instead of the order of insertion keeps the result the same as a serial deduplication.
+ */
+template<typename Key, typename GetKeyFn>
+static void find_first_index_with_key(const IndexMask &mask,
+                                      const GetKeyFn &get_key,
+                                      MutableSpan<int> r_first)
+{
+  ConcurrentMap<Key, int> map;
+  map.reserve(mask.size());
+  mask.foreach_index(GrainSize(4096), [&](const int i) {
+    map.add_or_modify(
+        get_key(i),
+        [&](int *first) { new (first) int(i); },
+        [&](int *first) { *first = std::min(*first, i); });
+  });
+  mask.foreach_index(GrainSize(4096),
+                     [&](const int i) { r_first[i] = map.lookup_default(get_key(i), i); });
+}
+
+/**
+ * Create a mesh from the triangles of a binary STL file. Like #STLMeshHelper, duplicate
+ * vertices are merged and degenerate and duplicate triangles are removed, but the
+ * deduplication happens in parallel.
+ */
+static Mesh *mesh_from_packed_triangles(const Span<PackedTriangle> tris,
+                                        const bool use_custom_normals)
+{
+  const int tris_num = int(tris.size());
+  const IndexRange corners(int64_t(tris_num) * 3);
+  auto corner_position = [&](const int corner) -> float3 {
+    return tris[corner / 3].vertices[corner % 3];
+  };
+
+  Array<int> corner_first(corners.size());
+  find_first_index_with_key<float3>(corners, corner_position, corner_first);
+
+  IndexMaskMemory memory;
+  const IndexMask first_corners = IndexMask::from_predicate(
+      corners, GrainSize(4096), memory, [&](const int corner) {
+        return corner_first[corner] == corner;
+      });
+
+  /* Vertices are ordered by their first use, the same as when adding them one by one. */
+  Array<int> corner_verts(corners.size());
+  first_corners.foreach_index(GrainSize(4096), [&](const int corner, const int vert) {
+    corner_verts[corner] = vert;
+  });
+  threading::parallel_for(corners, 4096, [&](const IndexRange range) {
+    for (const int corner : range) {
+      corner_verts[corner] = corner_verts[corner_first[corner]];
+    }
+  });
+
+  const IndexMask valid_tris = IndexMask::from_predicate(
+      IndexRange(tris_num), GrainSize(4096), memory, [&](const int tri) {
+        const int v1 = corner_verts[tri * 3];
+        const int v2 = corner_verts[tri * 3 + 1];
+        const int v3 = corner_verts[tri * 3 + 2];
+        return v1 != v2 && v1 != v3 && v2 != v3;
+      });
+
+  Array<int> tri_first(tris_num);
+  find_first_index_with_key<Triangle>(
+      valid_tris,
+      [&](const int tri) {
+        return Triangle{
+            corner_verts[tri * 3], corner_verts[tri * 3 + 1], corner_verts[tri * 3 + 2]};
+      },
+      tri_first);
+  const IndexMask unique_tris = IndexMask::from_predicate(
+      valid_tris, GrainSize(4096), memory, [&](const int tri) { return tri_first[tri] == tri; });
+
+  const int degenerate_tris_num = tris_num - valid_tris.size();
+  const int duplicate_tris_num = valid_tris.size() - unique_tris.size();
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
+              << std::endl;
+  }
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
+              << std::endl;
+  }
+
+  Mesh *mesh = BKE_mesh_new_nomain(
+      first_corners.size(), 0, unique_tris.size(), unique_tris.size() * 3);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  first_corners.foreach_index(GrainSize(4096), [&](const int corner, const int vert) {
+    positions[vert] = corner_position(corner);
+  });
+  offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> dst_corner_verts = mesh->corner_verts_for_write();
+  unique_tris.foreach_index(GrainSize(4096), [&](const int tri, const int face) {
+    for (const int i : IndexRange(3)) {
+      dst_corner_verts[face * 3 + i] = corner_verts[tri * 3 + i];
+    }
+  });
+
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  bke::mesh_calc_edges(*mesh, false, false);
+
+  if (use_custom_normals) {
+    Array<float3> corner_normals(mesh->corners_num);
+    unique_tris.foreach_index(GrainSize(4096), [&](const int tri, const int face) {
+      corner_normals.as_mutable_span().slice(face * 3, 3).fill(tris[tri].normal);
+    });
+    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(corner_normals.data()));
+  }
+
+  return mesh;
+}
+
 Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
 {
-  const int chunk_size = 1024;
   uint32_t num_tris = 0;
   fseek(file, BINARY_HEADER_SIZE, SEEK_SET);
   if (fread(&num_tris, sizeof(uint32_t), 1, file) != 1) {
@@ -36,16 +154,30 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
     return BKE_mesh_new_nomain(0, 0, 0, 0);
   }
 
-  Array<PackedTriangle> tris_buf(chunk_size);
-  STLMeshHelper stl_mesh(num_tris, use_custom_normals);
-  size_t num_read_tris;
-  while ((num_read_tris = fread(tris_buf.data(), sizeof(PackedTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
-      stl_mesh.add_triangle(tris_buf[i]);
+  /* Use the triangles in the file directly when it can be memory mapped. */
+  const size_t tris_offset = BINARY_HEADER_SIZE + sizeof(uint32_t);
+  if (BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(file))) {
+    const size_t length = BLI_mmap_get_length(mmap_file);
+    const size_t tris_in_file = length > tris_offset ? (length - tris_offset) / BINARY_STRIDE : 0;
+    const Span<PackedTriangle> tris(
+        reinterpret_cast<const PackedTriangle *>(
+            static_cast<const uint8_t *>(BLI_mmap_get_pointer(mmap_file)) + tris_offset),
+        std::min<size_t>(num_tris, tris_in_file));
+    Mesh *mesh = mesh_from_packed_triangles(tris, use_custom_normals);
+    const bool io_error = BLI_mmap_has_io_error(mmap_file);
+    BLI_mmap_free(mmap_file);
+    if (io_error) {
+      fprintf(stderr, "STL Importer: failed to read file, IO error.\n");
+      BKE_id_free(nullptr, mesh);
+      return nullptr;
     }
+    return mesh;
   }
 
-  return stl_mesh.to_mesh();
+  fseek(file, tris_offset, SEEK_SET);
+  Array<PackedTriangle> tris(num_tris);
+  const size_t num_read_tris = fread(tris.data(), sizeof(PackedTriangle), num_tris, file);
+  return mesh_from_packed_triangles(tris.as_span().take_front(num_read_tris), use_custom_normals);
 }
 
 }  // namespace blender::io::stl
@@ -25,6 +25,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "BLT_translation.hh"
@@ -333,6 +334,25 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
+  /* Read data that doesn't need #Main, like geometry, for all readers in parallel. */
+  const Span<USDPrimReader *> readers = archive->readers();
+  threading::parallel_for(readers.index_range(), 1, [&](const IndexRange range) {
+    for (USDPrimReader *reader : readers.slice(range)) {
+      if (G.is_break) {
+        return;
+      }
+      if (reader) {
+        reader->prepare_object_data(0.0);
+      }
+    }
+  });
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+  *data->do_update = true;
+  *data->progress = 0.75f;
+
   /* Setup parenthood and read actual object data. */
   i = 0;
   for (USDPrimReader *reader : archive->readers()) {
@@ -354,7 +374,7 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.5f + 0.5f * (++i / size);
+    *data->progress = 0.75f + 0.25f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -17,6 +17,7 @@ struct ImageUser;
 
 namespace blender::io::usd {
 
+class MeshDataRegistry;
 class USDHierarchyIterator;
 
 struct USDExporterContext {
@@ -34,6 +35,11 @@ struct USDExporterContext {
   const USDExportParams &export_params;
   std::string export_file_path;
   std::function<std::string(Main *, Scene *, Image *, ImageUser *)> export_image_fn;
+  /**
+   * Meshes that were written with their data, to reference identical meshes instead of writing
+   * them again. Null when meshes should not reference each other.
+   */
+  MeshDataRegistry *mesh_data_registry = nullptr;
 };
 
 }  // namespace blender::io::usd
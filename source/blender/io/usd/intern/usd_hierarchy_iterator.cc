@@ -113,8 +113,14 @@ USDExporterContext USDHierarchyIterator::create_usd_export_context(const Hierarc
   const std::string export_file_path = root_layer->GetRealPath();
   auto get_time_code = [this]() { return this->export_time_; };
 
-  return USDExporterContext{
+  USDExporterContext usd_export_context{
       bmain_, depsgraph_, stage_, path, get_time_code, params_, export_file_path};
+  /* Meshes are only identical when they share their data on all frames, which cannot be known
+   * while exporting the first frame of an animation. */
+  if (params_.use_instancing && !params_.export_animation) {
+    usd_export_context.mesh_data_registry = &mesh_data_registry_;
+  }
+  return usd_export_context;
 }
 
 AbstractHierarchyWriter *USDHierarchyIterator::create_transform_writer(
@@ -6,6 +6,7 @@
 #include "IO_abstract_hierarchy_iterator.h"
 #include "usd.hh"
 #include "usd_exporter_context.hh"
+#include "usd_mesh_utils.hh"
 #include "usd_skel_convert.hh"
 
 #include <string>
@@ -33,6 +34,8 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
   ObjExportMap skinned_mesh_export_map_;
   ObjExportMap shape_key_mesh_export_map_;
 
+  MeshDataRegistry mesh_data_registry_;
+
  public:
   USDHierarchyIterator(Main *bmain,
                        Depsgraph *depsgraph,
@@ -7,12 +7,15 @@
 #include "usd_hash_types.hh"
 
 #include "BKE_attribute.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh_types.hh"
 #include "BKE_report.hh"
 
 #include "BLI_color.hh"
 #include "BLI_span.hh"
 
 #include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
 
 namespace blender::io::usd {
 
@@ -137,4 +140,51 @@ void read_color_data_primvar(Mesh *mesh,
   color_data.finish();
 }
 
+static bool add_layer_arrays(const CustomData &data,
+                             Vector<ImplicitSharingPtr<ImplicitSharingInfo>> &arrays,
+                             Vector<std::string> &names)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    const ImplicitSharingInfo *sharing_info = layer.sharing_info;
+    if (sharing_info == nullptr) {
+      return false;
+    }
+    sharing_info->add_user();
+    arrays.append(ImplicitSharingPtr<ImplicitSharingInfo>(sharing_info));
+    names.append(layer.name);
+  }
+  return true;
+}
+
+const pxr::SdfPath *MeshDataRegistry::lookup_or_add(const Mesh &mesh, const pxr::SdfPath &path)
+{
+  Key key;
+  if (mesh.faces_num > 0) {
+    const ImplicitSharingInfo *sharing_info = mesh.runtime->face_offsets_sharing_info;
+    if (sharing_info == nullptr) {
+      return nullptr;
+    }
+    sharing_info->add_user();
+    key.arrays.append(ImplicitSharingPtr<ImplicitSharingInfo>(sharing_info));
+  }
+  for (const CustomData *data :
+       {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+  {
+    if (!add_layer_arrays(*data, key.arrays, key.names)) {
+      return nullptr;
+    }
+  }
+  const int active_uv_map = CustomData_get_render_layer_index(&mesh.corner_data, CD_PROP_FLOAT2);
+  if (active_uv_map != -1) {
+    key.names.append(mesh.corner_data.layers[active_uv_map].name);
+  }
+
+  bool is_new = false;
+  const pxr::SdfPath &existing_path = paths_.lookup_or_add_cb(std::move(key), [&]() {
+    is_new = true;
+    return path;
+  });
+  return is_new ? nullptr : &existing_path;
+}
+
 }  // namespace blender::io::usd
@@ -1,9 +1,20 @@
 /* SPDX-FileCopyrightText: 2024 Blender Authors
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
 
+#include "BLI_implicit_sharing_ptr.hh"
+#include "BLI_map.hh"
+#include "BLI_struct_equality_utils.hh"
+#include "BLI_vector.hh"
+
+#include "usd_hash_types.hh"
+
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usdGeom/primvar.h>
 
+#include <string>
+
 struct Mesh;
 struct ReportList;
 
@@ -15,4 +26,37 @@ void read_color_data_primvar(Mesh *mesh,
                              ReportList *reports,
                              bool is_left_handed);
 
+/**
+ * Paths of the meshes that were exported with all of their data, keyed by the implicitly shared
+ * arrays of the mesh. A mesh that shares all of its arrays with a mesh that was exported before is
+ * identical to it, and can reference that mesh instead of writing the same data again. This finds
+ * linked duplicates and meshes of different objects which share their evaluated data, which are
+ * not instances in the export hierarchy.
+ */
+class MeshDataRegistry {
+  struct Key {
+    /** The users keep the arrays alive, so that their address cannot be reused by other data. */
+    Vector<ImplicitSharingPtr<ImplicitSharingInfo>> arrays;
+    /** Names of the attributes and of the active UV map, which are part of the exported data. */
+    Vector<std::string> names;
+
+    uint64_t hash() const
+    {
+      return get_default_hash(arrays.hash(), names.hash());
+    }
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(Key, arrays, names)
+  };
+
+  Map<Key, pxr::SdfPath> paths_;
+
+ public:
+  /**
+   * Return the path of a mesh that was added before and is identical to the given mesh. Otherwise
+   * add the mesh with the given path and return null. Meshes that don't share all of their arrays
+   * are never added.
+   */
+  const pxr::SdfPath *lookup_or_add(const Mesh &mesh, const pxr::SdfPath &path);
+};
+
 }  // namespace blender::io::usd
@@ -16,6 +16,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
 #include "BKE_geometry_set.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_material.h"
 #include "BKE_mesh.hh"
@@ -35,6 +36,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <utility>
+
 #include <pxr/base/gf/matrix4f.h>
 #include <pxr/base/vt/array.h>
 #include <pxr/base/vt/types.h>
@@ -157,10 +160,20 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
       mesh_prim_(prim),
       is_left_handed_(false),
       is_time_varying_(false),
-      is_initial_load_(false)
+      is_initial_load_(false),
+      is_prepared_(false),
+      prepared_mesh_(nullptr)
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  /* The import was canceled before the prepared mesh was used. */
+  if (prepared_mesh_) {
+    BKE_id_free(nullptr, prepared_mesh_);
+  }
+}
+
 static const std::optional<bke::AttrDomain> convert_usd_varying_to_blender(
     const pxr::TfToken usd_domain)
 {
@@ -195,7 +208,7 @@ void USDMeshReader::create_object(Main *bmain, const double /*motionSampleTime*/
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prepare_object_data(const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
@@ -204,9 +217,22 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
                                                            import_params_.mesh_read_flag);
 
   Mesh *read_mesh = this->read_mesh(mesh, params, nullptr);
+  prepared_mesh_ = (read_mesh != mesh) ? read_mesh : nullptr;
+  is_prepared_ = true;
 
   is_initial_load_ = false;
-  if (read_mesh != mesh) {
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  if (!is_prepared_) {
+    this->prepare_object_data(motionSampleTime);
+  }
+  is_prepared_ = false;
+
+  if (Mesh *read_mesh = std::exchange(prepared_mesh_, nullptr)) {
     BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
   }
 
@@ -314,6 +340,45 @@ void USDMeshReader::read_mpolys(Mesh *mesh)
   bke::mesh_calc_edges(*mesh, false, false);
 }
 
+bool USDMeshReader::faces_match_mesh(const Mesh &mesh) const
+{
+  const OffsetIndices faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  if (size_t(faces.size()) != face_counts_.size() ||
+      size_t(corner_verts.size()) != face_indices_.size())
+  {
+    return false;
+  }
+  for (const int i : faces.index_range()) {
+    if (faces[i].size() != face_counts_[i]) {
+      return false;
+    }
+  }
+  const Span<int> usd_face_indices(face_indices_.cdata(), face_indices_.size());
+  if (!is_left_handed_) {
+    return corner_verts == usd_face_indices;
+  }
+  /* See #read_mpolys() for the reversal of the face corners. */
+  for (const int i : faces.index_range()) {
+    const IndexRange face = faces[i];
+    for (const int corner : face) {
+      if (corner_verts[corner] != usd_face_indices[face.last() - (corner - face.start())]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void USDMeshReader::read_vert_positions(Mesh *mesh)
+{
+  MutableSpan<float3> vert_positions = mesh->vert_positions_for_write();
+  for (int i = 0; i < positions_.size(); i++) {
+    vert_positions[i] = {positions_[i][0], positions_[i][1], positions_[i][2]};
+  }
+  mesh->tag_positions_changed();
+}
+
 void USDMeshReader::read_uv_data_primvar(Mesh *mesh,
                                          const pxr::UsdGeomPrimvar &primvar,
                                          const double motionSampleTime)
@@ -568,11 +633,7 @@ void USDMeshReader::read_mesh_sample(ImportSettings *settings,
    * in code that expect this data to be there. */
 
   if (new_mesh || (settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
-    MutableSpan<float3> vert_positions = mesh->vert_positions_for_write();
-    for (int i = 0; i < positions_.size(); i++) {
-      vert_positions[i] = {positions_[i][0], positions_[i][1], positions_[i][2]};
-    }
-    mesh->tag_positions_changed();
+    read_vert_positions(mesh);
 
     read_vertex_creases(mesh, motionSampleTime);
   }
@@ -823,9 +884,6 @@ Mesh *USDMeshReader::read_mesh(Mesh *existing_mesh,
   Mesh *active_mesh = existing_mesh;
   bool new_mesh = false;
 
-  /* TODO(makowalski): implement the optimization of only updating the mesh points when
-   * the topology is consistent, as in the Alembic importer. */
-
   ImportSettings settings;
   if (settings_) {
     settings.validate_meshes = settings_->validate_meshes;
@@ -837,6 +895,17 @@ Mesh *USDMeshReader::read_mesh(Mesh *existing_mesh,
     active_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions_.size(), 0, face_counts_.size(), face_indices_.size());
   }
+  else if ((settings.read_flag & MOD_MESHSEQ_STABLE_TOPOLOGY) && !is_initial_load_ &&
+           faces_match_mesh(*existing_mesh))
+  {
+    /* Keep the topology and all other data of the existing mesh, so that it stays shared and
+     * caches derived from it remain valid. Only stream the positions and velocities. */
+    if (settings.read_flag & MOD_MESHSEQ_READ_VERT) {
+      read_vert_positions(existing_mesh);
+      read_velocities(existing_mesh, params.motion_sample_time);
+    }
+    return existing_mesh;
+  }
 
   read_mesh_sample(
       &settings, active_mesh, params.motion_sample_time, new_mesh || is_initial_load_);
@@ -40,14 +40,20 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /* Set by #prepare_object_data(), with the new mesh if the existing mesh was not reused. */
+  bool is_prepared_;
+  Mesh *prepared_mesh_;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
                 const ImportSettings &settings);
+  ~USDMeshReader() override;
 
   bool valid() const override;
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void prepare_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_geometry(bke::GeometrySet &geometry_set,
@@ -77,6 +83,9 @@ class USDMeshReader : public USDGeomReader {
                                            blender::Map<pxr::SdfPath, int> *r_mat_map);
 
   void read_mpolys(Mesh *mesh);
+  /** Whether the faces read by #topology_changed() are the same as the faces of the mesh. */
+  bool faces_match_mesh(const Mesh &mesh) const;
+  void read_vert_positions(Mesh *mesh);
   void read_vertex_creases(Mesh *mesh, double motionSampleTime);
   void read_velocities(Mesh *mesh, double motionSampleTime);
 
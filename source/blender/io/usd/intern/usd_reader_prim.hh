@@ -108,6 +108,12 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Read data that does not need access to #Main or other readers, such as geometry, ahead of
+   * #read_object_data(). This is called for many readers in parallel, after all objects have been
+   * created.
+   */
+  virtual void prepare_object_data(double /*motionSampleTime*/){};
   virtual void read_object_data(Main * /*bmain*/, double /*motionSampleTime*/){};
 
   Object *object() const;
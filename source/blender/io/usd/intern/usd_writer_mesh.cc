@@ -6,6 +6,7 @@
 #include "usd_armature_utils.hh"
 #include "usd_attribute_utils.hh"
 #include "usd_blend_shape_utils.hh"
+#include "usd_mesh_utils.hh"
 #include "usd_skel_convert.hh"
 #include "usd_utils.hh"
 
@@ -127,7 +128,7 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
     const SubsurfModifierData *subsurfData = get_last_subdiv_modifier(
         usd_export_context_.export_params.evaluation_mode, object_eval);
 
-    write_mesh(context, mesh, subsurfData);
+    write_mesh(context, mesh, subsurfData, needsfree);
 
     auto prim = usd_export_context_.stage->GetPrimAtPath(usd_export_context_.usd_path);
     if (prim.IsValid() && object_eval) {
@@ -343,6 +344,11 @@ void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(nullptr, mesh);
 }
 
+bool USDGenericMeshWriter::can_reference_mesh_data() const
+{
+  return true;
+}
+
 struct USDMeshData {
   pxr::VtArray<pxr::GfVec3f> points;
   pxr::VtIntArray face_vertex_counts;
@@ -374,7 +380,8 @@ struct USDMeshData {
 
 void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
                                       Mesh *mesh,
-                                      const SubsurfModifierData *subsurfData)
+                                      const SubsurfModifierData *subsurfData,
+                                      const bool is_temporary_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdStageRefPtr stage = usd_export_context_.stage;
@@ -383,9 +390,20 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
   /* Ensure data exists if currently in edit mode. */
   BKE_mesh_wrapper_ensure_mdata(mesh);
+
+  /* Temporary meshes never share their data with other meshes, and the subdivision settings are
+   * written from the modifier of the object. */
+  if (usd_export_context_.mesh_data_registry && !context.is_instance() && !is_temporary_mesh &&
+      subsurfData == nullptr && can_reference_mesh_data())
+  {
+    if (reference_identical_mesh(context, mesh, usd_mesh)) {
+      return;
+    }
+  }
+
+  USDMeshData usd_mesh_data;
   get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
@@ -575,10 +593,11 @@ void USDGenericMeshWriter::write_subdiv(const pxr::TfToken &subdiv_scheme,
 static void get_positions(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   const Span<pxr::GfVec3f> positions = mesh->vert_positions().cast<pxr::GfVec3f>();
-  usd_mesh_data.points = pxr::VtArray<pxr::GfVec3f>(positions.begin(), positions.end());
+  usd_mesh_data.points.resize(positions.size());
+  array_utils::copy(positions, MutableSpan(usd_mesh_data.points.data(), positions.size()));
 }
 
-static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
   /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
    * assignments. */
@@ -591,6 +610,11 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
       usd_mesh_data.face_groups.lookup_or_add_default(indices_span[i]).push_back(i);
     }
   }
+}
+
+static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  get_face_groups(mesh, usd_mesh_data);
 
   usd_mesh_data.face_vertex_counts.resize(mesh->faces_num);
   const OffsetIndices faces = mesh->faces();
@@ -600,7 +624,9 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
       MutableSpan(usd_mesh_data.face_vertex_counts.data(), mesh->faces_num));
 
   const Span<int> corner_verts = mesh->corner_verts();
-  usd_mesh_data.face_indices = pxr::VtIntArray(corner_verts.begin(), corner_verts.end());
+  usd_mesh_data.face_indices.resize(corner_verts.size());
+  array_utils::copy(corner_verts,
+                    MutableSpan(usd_mesh_data.face_indices.data(), corner_verts.size()));
 }
 
 static void get_edge_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -655,6 +681,33 @@ void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_
   get_vert_creases(mesh, usd_mesh_data);
 }
 
+bool USDGenericMeshWriter::reference_identical_mesh(HierarchyContext &context,
+                                                    const Mesh *mesh,
+                                                    pxr::UsdGeomMesh &usd_mesh)
+{
+  const pxr::SdfPath *ref_path = usd_export_context_.mesh_data_registry->lookup_or_add(
+      *mesh, usd_export_context_.usd_path);
+  if (ref_path == nullptr) {
+    return false;
+  }
+  if (!usd_mesh.GetPrim().GetReferences().AddInternalReference(*ref_path)) {
+    CLOG_WARN(&LOG,
+              "Unable to add reference from %s to %s, writing mesh data instead",
+              usd_export_context_.usd_path.GetAsString().c_str(),
+              ref_path->GetAsString().c_str());
+    return false;
+  }
+
+  /* The materials are assigned to the object, so they may differ between objects that share
+   * the same mesh. Like for instances, they are overridden on the referencing prim. */
+  if (usd_export_context_.export_params.export_materials) {
+    USDMeshData usd_mesh_data;
+    get_face_groups(mesh, usd_mesh_data);
+    assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
+  }
+  return true;
+}
+
 void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
                                             pxr::UsdGeomMesh usd_mesh,
                                             const MaterialFaceGroups &usd_face_groups)
@@ -922,6 +975,12 @@ void USDMeshWriter::do_write(HierarchyContext &context)
   }
 }
 
+bool USDMeshWriter::can_reference_mesh_data() const
+{
+  /* Skinning and blend shapes are written for each object. */
+  return !write_skinned_mesh_ && !write_blend_shapes_;
+}
+
 Mesh *USDMeshWriter::get_export_mesh(Object *object_eval, bool &r_needsfree)
 {
   if (write_blend_shapes_) {
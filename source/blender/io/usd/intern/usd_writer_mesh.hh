@@ -33,11 +33,27 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
 
+  /**
+   * Whether the written mesh only depends on the mesh data, so that objects with identical meshes
+   * can reference the same data.
+   */
+  virtual bool can_reference_mesh_data() const;
+
  private:
   /* Mapping from material slot number to array of face indices with that material. */
   using MaterialFaceGroups = Map<short, pxr::VtIntArray>;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh, const SubsurfModifierData *subsurfData);
+  void write_mesh(HierarchyContext &context,
+                  Mesh *mesh,
+                  const SubsurfModifierData *subsurfData,
+                  bool is_temporary_mesh);
+  /**
+   * Reference an identical mesh that was written before instead of writing the same data again.
+   * Return false when no such mesh was written.
+   */
+  bool reference_identical_mesh(HierarchyContext &context,
+                                const Mesh *mesh,
+                                pxr::UsdGeomMesh &usd_mesh);
   pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData);
   void write_subdiv(const pxr::TfToken &subdiv_scheme,
                     pxr::UsdGeomMesh &usd_mesh,
@@ -76,6 +92,8 @@ class USDMeshWriter : public USDGenericMeshWriter {
 
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
 
+  virtual bool can_reference_mesh_data() const override;
+
   /**
    * Determine whether we should write skinned mesh or blend shape data
    * based on the export parameters and the modifiers enabled on the object.
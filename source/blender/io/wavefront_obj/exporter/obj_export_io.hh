@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <charconv>
+#include <cmath>
 #include <cstdio>
 #include <type_traits>
 
@@ -71,19 +73,28 @@ class FormatHandler : NonCopyable, NonMovable {
 
   void write_obj_vertex(float x, float y, float z)
   {
-    write_impl("v {:.6f} {:.6f} {:.6f}\n", x, y, z);
+    LineBuffer line("v");
+    line.add_float<6>(x).add_float<6>(y).add_float<6>(z);
+    write_line(line);
   }
   void write_obj_vertex_color(float x, float y, float z, float r, float g, float b)
   {
-    write_impl("v {:.6f} {:.6f} {:.6f} {:.4f} {:.4f} {:.4f}\n", x, y, z, r, g, b);
+    LineBuffer line("v");
+    line.add_float<6>(x).add_float<6>(y).add_float<6>(z);
+    line.add_float<4>(r).add_float<4>(g).add_float<4>(b);
+    write_line(line);
   }
   void write_obj_uv(float x, float y)
   {
-    write_impl("vt {:.6f} {:.6f}\n", x, y);
+    LineBuffer line("vt");
+    line.add_float<6>(x).add_float<6>(y);
+    write_line(line);
   }
   void write_obj_normal(float x, float y, float z)
   {
-    write_impl("vn {:.4f} {:.4f} {:.4f}\n", x, y, z);
+    LineBuffer line("vn");
+    line.add_float<4>(x).add_float<4>(y).add_float<4>(z);
+    write_line(line);
   }
   void write_obj_face_begin()
   {
@@ -95,19 +106,27 @@ class FormatHandler : NonCopyable, NonMovable {
   }
   void write_obj_face_v_uv_normal(int v, int uv, int n)
   {
-    write_impl(" {}/{}/{}", v, uv, n);
+    LineBuffer corner;
+    corner.add_char(' ').add_int(v).add_char('/').add_int(uv).add_char('/').add_int(n);
+    write_chars(corner);
   }
   void write_obj_face_v_normal(int v, int n)
   {
-    write_impl(" {}//{}", v, n);
+    LineBuffer corner;
+    corner.add_char(' ').add_int(v).add_char('/').add_char('/').add_int(n);
+    write_chars(corner);
   }
   void write_obj_face_v_uv(int v, int uv)
   {
-    write_impl(" {}/{}", v, uv);
+    LineBuffer corner;
+    corner.add_char(' ').add_int(v).add_char('/').add_int(uv);
+    write_chars(corner);
   }
   void write_obj_face_v(int v)
   {
-    write_impl(" {}", v);
+    LineBuffer corner;
+    corner.add_char(' ').add_int(v);
+    write_chars(corner);
   }
   void write_obj_usemtl(StringRef s)
   {
@@ -198,6 +217,93 @@ class FormatHandler : NonCopyable, NonMovable {
   }
 
  private:
+  /**
+   * Small stack buffer for the most common lines, which are formatted without parsing a format
+   * string. The output is the same as with the corresponding `fmt` format specifiers.
+   */
+  class LineBuffer {
+    /* Enough for a prefix and six floats of the largest magnitude. */
+    char data_[384];
+    char *end_ = data_;
+
+   public:
+    LineBuffer() = default;
+    LineBuffer(const char *prefix)
+    {
+      while (*prefix) {
+        *end_++ = *prefix++;
+      }
+    }
+
+    LineBuffer &add_char(const char c)
+    {
+      *end_++ = c;
+      return *this;
+    }
+
+    LineBuffer &add_int(const int value)
+    {
+      end_ = std::to_chars(end_, std::end(data_), value).ptr;
+      return *this;
+    }
+
+    /**
+     * Add a space and the value with a fixed number of decimals, like `{:.6f}`. The float
+     * multiplied by a power of ten up to 10^6 is exact in double precision, so rounding it to
+     * the nearest integer (with ties to even) gives the correctly rounded decimal digits.
+     */
+    template<int Precision> LineBuffer &add_float(const float value)
+    {
+      static_assert(Precision > 0 && Precision <= 6);
+      constexpr uint64_t scale = power_of_ten(Precision);
+      *end_++ = ' ';
+      const double scaled = std::abs(double(value)) * double(scale);
+      if (!(scaled < 1e18)) {
+        /* Large values and non-finite numbers. */
+        end_ = fmt::format_to(end_, "{:.{}f}", value, Precision);
+        return *this;
+      }
+      if (std::signbit(value)) {
+        *end_++ = '-';
+      }
+      const uint64_t digits = uint64_t(std::nearbyint(scaled));
+      end_ = std::to_chars(end_, std::end(data_), digits / scale).ptr;
+      *end_++ = '.';
+      uint64_t fraction = digits % scale;
+      for (int i = Precision - 1; i >= 0; i--) {
+        end_[i] = char('0' + fraction % 10);
+        fraction /= 10;
+      }
+      end_ += Precision;
+      return *this;
+    }
+
+    Span<char> as_span() const
+    {
+      return Span<char>(data_, end_ - data_);
+    }
+
+   private:
+    static constexpr uint64_t power_of_ten(const int exponent)
+    {
+      return exponent == 0 ? 1 : 10 * power_of_ten(exponent - 1);
+    }
+  };
+
+  void write_chars(const LineBuffer &buffer)
+  {
+    const Span<char> chars = buffer.as_span();
+    ensure_space(chars.size());
+    VectorChar &bb = blocks_.last();
+    bb.insert(bb.end(), chars.begin(), chars.end());
+  }
+
+  void write_line(LineBuffer &buffer)
+  {
+    buffer.add_char('\n');
+    write_chars(buffer);
+  }
+
   /* Ensure the last block contains at least this amount of free space.
    * If not, add a new block with max of block size & the amount of space needed. */
   void ensure_space(size_t at_least)
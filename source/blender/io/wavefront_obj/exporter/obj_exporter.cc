@@ -8,6 +8,7 @@
 
 #include <cstdio>
 #include <memory>
+#include <mutex>
 #include <system_error>
 
 #include "BKE_context.hh"
@@ -202,6 +203,31 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
     offsets.normal_offset += obj.get_normal_coords().size();
   }
 
+  /* Write the object text buffers into the output file in order, as soon as all previous objects
+   * are done. This overlaps writing the file with formatting the remaining objects, and releases
+   * the buffers early. A thread that finds another thread writing just returns, the writing
+   * thread picks up its buffer before it stops, so threads never wait for each other. */
+  FILE *f = obj_writer.get_outfile();
+  std::mutex write_mutex;
+  Array<bool> buffer_done(count, false);
+  int64_t next_buffer = 0;
+  bool is_writing = false;
+  auto write_done_buffers = [&]() {
+    std::unique_lock lock{write_mutex};
+    if (is_writing) {
+      return;
+    }
+    is_writing = true;
+    while (next_buffer < count && buffer_done[next_buffer]) {
+      const int64_t i = next_buffer;
+      lock.unlock();
+      buffers[i].write_to_file(f);
+      lock.lock();
+      next_buffer++;
+    }
+    is_writing = false;
+  };
+
   /* Parallel over meshes: main result writing. */
   threading::parallel_for(IndexRange(count), 1, [&](IndexRange range) {
     for (const int i : range) {
@@ -240,14 +266,15 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
       /* Nothing will need this object's data after this point, release
        * various arrays here. */
       obj.clear();
+
+      {
+        std::lock_guard lock{write_mutex};
+        buffer_done[i] = true;
+      }
+      write_done_buffers();
     }
   });
-
-  /* Write all the object text buffers into the output file. */
-  FILE *f = obj_writer.get_outfile();
-  for (auto &b : buffers) {
-    b.write_to_file(f);
-  }
+  BLI_assert(next_buffer == count);
 }
 
 /**
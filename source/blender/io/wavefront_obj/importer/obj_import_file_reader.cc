@@ -14,6 +14,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "obj_export_mtl.hh"
@@ -71,37 +72,99 @@ static Geometry *create_geometry(Geometry *const prev_geometry,
   return new_geometry();
 }
 
-static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+/**
+ * Records of a part of the read buffer, parsed independently of the other parts. Vertex data does
+ * not depend on any state, so it is stored directly. Faces and all other lines depend on the
+ * preceding lines and are handled in file order afterwards.
+ */
+struct ParsedChunk {
+  Vector<float3> vertices;
+  /**
+   * Linear colors of the vertices, only filled when the chunk contains `xyzrgb` vertex colors.
+   * Negative components mean the vertex has no color.
+   */
+  Vector<float3> vertex_colors;
+  Vector<float2> uv_vertices;
+  Vector<float3> vert_normals;
+
+  /** Face corners as spelled out in the file, the indices are not resolved yet. */
+  struct Corner {
+    FaceCorner corner;
+    bool got_uv = false;
+    bool got_normal = false;
+  };
+  Vector<Corner> face_corners;
+
+  struct Line {
+    /* The line after leading white-space. For faces, the part after the keyword. */
+    const char *p;
+    const char *end;
+    /* Number of records of the chunk that come before this line. */
+    int vertices_num;
+    int uv_vertices_num;
+    int vert_normals_num;
+    /* For faces, the range in #face_corners. Empty for other lines. */
+    IndexRange corners;
+    bool is_face;
+  };
+  Vector<Line> lines;
+  size_t lines_num = 0;
+
+  void clear()
+  {
+    vertices.clear();
+    vertex_colors.clear();
+    uv_vertices.clear();
+    vert_normals.clear();
+    face_corners.clear();
+    lines.clear();
+    lines_num = 0;
+  }
+};
+
+static void geom_parse_vertex(const char *p, const char *end, ParsedChunk &r_chunk)
 {
   float3 vert;
   p = parse_floats(p, end, 0.0f, vert, 3);
-  r_global_vertices.vertices.append(vert);
+  r_chunk.vertices.append(vert);
   /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
    * is followed by 3 more RGB color components. See
    * http://paulbourke.net/dataformats/obj/colour.html */
+  float3 linear(-1.0f);
   if (p < end) {
     float3 srgb;
     p = parse_floats(p, end, -1.0f, srgb, 3);
     if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
-      float3 linear;
       srgb_to_linearrgb_v3_v3(linear, srgb);
-
-      auto &blocks = r_global_vertices.vertex_colors;
-      /* If we don't have vertex colors yet, or the previous vertex
-       * was without color, we need to start a new vertex colors block. */
-      if (blocks.is_empty() || (blocks.last().start_vertex_index + blocks.last().colors.size() !=
-                                r_global_vertices.vertices.size() - 1))
-      {
-        GlobalVertices::VertexColorsBlock block;
-        block.start_vertex_index = r_global_vertices.vertices.size() - 1;
-        blocks.append(block);
-      }
-      blocks.last().colors.append(linear);
     }
   }
+  if (linear.x >= 0.0f) {
+    r_chunk.vertex_colors.resize(r_chunk.vertices.size() - 1, float3(-1.0f));
+    r_chunk.vertex_colors.append(linear);
+  }
+  else if (!r_chunk.vertex_colors.is_empty()) {
+    r_chunk.vertex_colors.append(linear);
+  }
   UNUSED_VARS(p);
 }
 
+static void geom_add_vertex_color(const int vertex_index,
+                                  const float3 &linear,
+                                  GlobalVertices &r_global_vertices)
+{
+  auto &blocks = r_global_vertices.vertex_colors;
+  /* If we don't have vertex colors yet, or the previous vertex
+   * was without color, we need to start a new vertex colors block. */
+  if (blocks.is_empty() ||
+      (blocks.last().start_vertex_index + blocks.last().colors.size() != vertex_index))
+  {
+    GlobalVertices::VertexColorsBlock block;
+    block.start_vertex_index = vertex_index;
+    blocks.append(block);
+  }
+  blocks.last().colors.append(linear);
+}
+
 static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices &r_global_vertices)
 {
   /* MRGB color extension, in the form of
@@ -142,9 +205,7 @@ static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices
   }
 }
 
-static void geom_add_vertex_normal(const char *p,
-                                   const char *end,
-                                   GlobalVertices &r_global_vertices)
+static void geom_parse_vertex_normal(const char *p, const char *end, ParsedChunk &r_chunk)
 {
   float3 normal;
   parse_floats(p, end, 0.0f, normal, 3);
@@ -152,14 +213,55 @@ static void geom_add_vertex_normal(const char *p,
    * making them ever-so-slightly non unit length. Make sure they are
    * normalized. */
   normalize_v3(normal);
-  r_global_vertices.vert_normals.append(normal);
+  r_chunk.vert_normals.append(normal);
 }
 
-static void geom_add_uv_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+static void geom_parse_uv_vertex(const char *p, const char *end, ParsedChunk &r_chunk)
 {
   float2 uv;
   parse_floats(p, end, 0.0f, uv, 2);
-  r_global_vertices.uv_vertices.append(uv);
+  r_chunk.uv_vertices.append(uv);
+}
+
+/**
+ * Append the vertex data of the chunk to the global vertices, up to the given record counts.
+ * The global vertex counts have to match the file position of the next line handled in order,
+ * since relative indices are based on them.
+ */
+static void flush_chunk_vertices(const ParsedChunk &chunk,
+                                 const int vertices_num,
+                                 const int uv_vertices_num,
+                                 const int vert_normals_num,
+                                 int3 &r_flushed,
+                                 GlobalVertices &r_global_vertices)
+{
+  if (vertices_num > r_flushed.x) {
+    const IndexRange range = IndexRange::from_begin_end(r_flushed.x, vertices_num);
+    const int global_start = r_global_vertices.vertices.size();
+    r_global_vertices.vertices.extend(chunk.vertices.as_span().slice(range));
+    if (!chunk.vertex_colors.is_empty()) {
+      for (const int i : range.index_range()) {
+        if (range[i] >= chunk.vertex_colors.size()) {
+          break;
+        }
+        const float3 &color = chunk.vertex_colors[range[i]];
+        if (color.x >= 0.0f) {
+          geom_add_vertex_color(global_start + i, color, r_global_vertices);
+        }
+      }
+    }
+    r_flushed.x = vertices_num;
+  }
+  if (uv_vertices_num > r_flushed.y) {
+    r_global_vertices.uv_vertices.extend(chunk.uv_vertices.as_span().slice(
+        IndexRange::from_begin_end(r_flushed.y, uv_vertices_num)));
+    r_flushed.y = uv_vertices_num;
+  }
+  if (vert_normals_num > r_flushed.z) {
+    r_global_vertices.vert_normals.extend(chunk.vert_normals.as_span().slice(
+        IndexRange::from_begin_end(r_flushed.z, vert_normals_num)));
+    r_flushed.z = vert_normals_num;
+  }
 }
 
 /**
@@ -225,9 +327,48 @@ static void geom_add_polyline(Geometry *geom,
   }
 }
 
+static void geom_parse_polygon(const char *p, const char *end, ParsedChunk &r_chunk)
+{
+  p = drop_whitespace(p, end);
+  while (p < end) {
+    ParsedChunk::Corner corner;
+    /* Parse vertex index. */
+    p = parse_int(p, end, INT32_MAX, corner.corner.vert_index, false);
+
+    /* Skip parsing when we reach start of the comment. */
+    if (*p == '#') {
+      break;
+    }
+
+    if (p < end && *p == '/') {
+      /* Parse UV index. */
+      ++p;
+      if (p < end && *p != '/') {
+        p = parse_int(p, end, INT32_MAX, corner.corner.uv_vert_index, false);
+        corner.got_uv = corner.corner.uv_vert_index != INT32_MAX;
+      }
+      /* Parse normal index. */
+      if (p < end && *p == '/') {
+        ++p;
+        p = parse_int(p, end, INT32_MAX, corner.corner.vertex_normal_index, false);
+        corner.got_normal = corner.corner.vertex_normal_index != INT32_MAX;
+      }
+    }
+    r_chunk.face_corners.append(corner);
+    if (corner.corner.vert_index == INT32_MAX) {
+      /* The face is invalid, no need to parse more corners. */
+      break;
+    }
+
+    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
+    p = drop_non_whitespace(p, end);
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
 static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
+                             const Span<ParsedChunk::Corner> corners,
                              const GlobalVertices &global_vertices,
                              const int material_index,
                              const int group_index,
@@ -245,33 +386,12 @@ static void geom_add_polygon(Geometry *geom,
   curr_face.start_index_ = orig_corners_size;
 
   bool face_valid = true;
-  p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
-    FaceCorner corner;
-    bool got_uv = false, got_normal = false;
-    /* Parse vertex index. */
-    p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
-
-    /* Skip parsing when we reach start of the comment. */
-    if (*p == '#') {
+  for (const ParsedChunk::Corner &parsed_corner : corners) {
+    if (!face_valid) {
       break;
     }
-
+    FaceCorner corner = parsed_corner.corner;
     face_valid &= corner.vert_index != INT32_MAX;
-    if (p < end && *p == '/') {
-      /* Parse UV index. */
-      ++p;
-      if (p < end && *p != '/') {
-        p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
-      }
-      /* Parse normal index. */
-      if (p < end && *p == '/') {
-        ++p;
-        p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
-      }
-    }
     /* Always keep stored indices non-negative and zero-based. */
     corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
     if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
@@ -285,7 +405,7 @@ static void geom_add_polygon(Geometry *geom,
       geom->track_vertex_index(corner.vert_index);
     }
     /* Ignore UV index, if the geometry does not have any UVs (#103212). */
-    if (got_uv && !global_vertices.uv_vertices.is_empty()) {
+    if (parsed_corner.got_uv && !global_vertices.uv_vertices.is_empty()) {
       corner.uv_vert_index += corner.uv_vert_index < 0 ? global_vertices.uv_vertices.size() : -1;
       if (corner.uv_vert_index < 0 || corner.uv_vert_index >= global_vertices.uv_vertices.size()) {
         fprintf(stderr,
@@ -298,7 +418,7 @@ static void geom_add_polygon(Geometry *geom,
     /* Ignore corner normal index, if the geometry does not have any normals.
      * Some obj files out there do have face definitions that refer to normal indices,
      * without any normals being present (#98782). */
-    if (got_normal && !global_vertices.vert_normals.is_empty()) {
+    if (parsed_corner.got_normal && !global_vertices.vert_normals.is_empty()) {
       corner.vertex_normal_index += corner.vertex_normal_index < 0 ?
                                         global_vertices.vert_normals.size() :
                                         -1;
@@ -314,11 +434,6 @@ static void geom_add_polygon(Geometry *geom,
     }
     geom->face_corners_.append(corner);
     curr_face.corner_count_++;
-
-    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
-    p = drop_non_whitespace(p, end);
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
   }
 
   if (face_valid) {
@@ -500,6 +615,54 @@ static void use_all_vertices_if_no_faces(Geometry *geom,
   }
 }
 
+/** Size of the parts of the read buffer that are parsed in parallel. */
+static constexpr int64_t parse_part_size = 16 * 1024;
+
+/**
+ * Parse the vertex data and faces of a part of the read buffer that ends at a line boundary, and
+ * store the remaining lines for handling in file order.
+ */
+static void parse_chunk(StringRef buffer_str, ParsedChunk &r_chunk)
+{
+  r_chunk.clear();
+  while (!buffer_str.is_empty()) {
+    StringRef line = read_next_line(buffer_str);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    r_chunk.lines_num++;
+    if (p == end) {
+      continue;
+    }
+    /* Most common things that start with 'v': vertices, normals, UVs. */
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        geom_parse_vertex(p, end, r_chunk);
+      }
+      else if (parse_keyword(p, end, "vn")) {
+        geom_parse_vertex_normal(p, end, r_chunk);
+      }
+      else if (parse_keyword(p, end, "vt")) {
+        geom_parse_uv_vertex(p, end, r_chunk);
+      }
+      continue;
+    }
+    ParsedChunk::Line chunk_line;
+    chunk_line.vertices_num = r_chunk.vertices.size();
+    chunk_line.uv_vertices_num = r_chunk.uv_vertices.size();
+    chunk_line.vert_normals_num = r_chunk.vert_normals.size();
+    chunk_line.is_face = parse_keyword(p, end, "f");
+    if (chunk_line.is_face) {
+      const int corners_start = r_chunk.face_corners.size();
+      geom_parse_polygon(p, end, r_chunk);
+      chunk_line.corners = IndexRange::from_begin_end(corners_start,
+                                                      r_chunk.face_corners.size());
+    }
+    chunk_line.p = p;
+    chunk_line.end = end;
+    r_chunk.lines.append(chunk_line);
+  }
+}
+
 void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
                       GlobalVertices &r_global_vertices)
 {
@@ -525,6 +688,8 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
   /* Read the input file in chunks. We need up to twice the possible chunk size,
    * to possibly store remainder of the previous input line that got broken mid-chunk. */
   Array<char> buffer(read_buffer_size_ * 2);
+  Vector<StringRef> parts;
+  Vector<ParsedChunk> chunks;
 
   size_t buffer_offset = 0;
   size_t line_number = 0;
@@ -571,128 +736,143 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
     }
     ++last_nl;
 
-    /* Parse the buffer (until last newline) that we have so far,
-     * line by line. */
+    /* Split the buffer (until last newline) that we have so far into parts at line boundaries
+     * and parse the vertex data and faces of the parts in parallel. */
+    parts.clear();
     StringRef buffer_str{buffer.data(), int64_t(last_nl)};
     while (!buffer_str.is_empty()) {
-      StringRef line = read_next_line(buffer_str);
-      const char *p = line.begin(), *end = line.end();
-      p = drop_whitespace(p, end);
-      ++line_number;
-      if (p == end) {
-        continue;
-      }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
+      int64_t part_size = std::min<int64_t>(parse_part_size, buffer_str.size());
+      while (part_size < buffer_str.size() && buffer_str[part_size - 1] != '\n') {
+        part_size++;
+      }
+      parts.append(buffer_str.substr(0, part_size));
+      buffer_str = buffer_str.drop_prefix(part_size);
+    }
+    chunks.resize(parts.size());
+    threading::parallel_for(parts.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        parse_chunk(parts[i], chunks[i]);
+      }
+    });
+
+    /* Handle the faces and all other lines in file order. */
+    for (const ParsedChunk &chunk : chunks) {
+      int3 flushed(0);
+      for (const ParsedChunk::Line &line : chunk.lines) {
+        flush_chunk_vertices(chunk,
+                             line.vertices_num,
+                             line.uv_vertices_num,
+                             line.vert_normals_num,
+                             flushed,
+                             r_global_vertices);
+        if (line.is_face) {
+          /* If we don't have a material index assigned yet, get one.
+           * It means "usemtl" state came from the previous object. */
+          if (state_material_index == -1 && !state_material_name.empty() &&
+              curr_geom->material_indices_.is_empty())
+          {
+            curr_geom->material_indices_.add_new(state_material_name, 0);
+            curr_geom->material_order_.append(state_material_name);
+            state_material_index = 0;
+          }
+
+          geom_add_polygon(curr_geom,
+                           chunk.face_corners.as_span().slice(line.corners),
+                           r_global_vertices,
+                           state_material_index,
+                           state_group_index,
+                           state_shaded_smooth);
+          continue;
         }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
+        const char *p = line.p, *end = line.end;
+        /* Lines. */
+        if (parse_keyword(p, end, "l")) {
+          geom_add_polyline(curr_geom, p, end, r_global_vertices);
         }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        /* If we don't have a material index assigned yet, get one.
-         * It means "usemtl" state came from the previous object. */
-        if (state_material_index == -1 && !state_material_name.empty() &&
-            curr_geom->material_indices_.is_empty())
-        {
-          curr_geom->material_indices_.add_new(state_material_name, 0);
-          curr_geom->material_order_.append(state_material_name);
-          state_material_index = 0;
+        /* Objects. */
+        else if (parse_keyword(p, end, "o")) {
+          if (import_params_.use_split_objects) {
+            geom_new_object(p,
+                            end,
+                            state_shaded_smooth,
+                            state_group_name,
+                            state_material_index,
+                            curr_geom,
+                            r_all_geometries);
+          }
         }
-
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_polyline(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        if (import_params_.use_split_objects) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
+        /* Groups. */
+        else if (parse_keyword(p, end, "g")) {
+          if (import_params_.use_split_groups) {
+            geom_new_object(p,
+                            end,
+                            state_shaded_smooth,
+                            state_group_name,
+                            state_material_index,
+                            curr_geom,
+                            r_all_geometries);
+          }
+          else {
+            geom_update_group(StringRef(p, end).trim(), state_group_name);
+            int new_index = curr_geom->group_indices_.size();
+            state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name,
+                                                                        new_index);
+            if (new_index == state_group_index) {
+              curr_geom->group_order_.append(state_group_name);
+            }
+          }
         }
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        if (import_params_.use_split_groups) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
+        /* Smoothing groups. */
+        else if (parse_keyword(p, end, "s")) {
+          geom_update_smooth_group(p, end, state_shaded_smooth);
         }
-        else {
-          geom_update_group(StringRef(p, end).trim(), state_group_name);
-          int new_index = curr_geom->group_indices_.size();
-          state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-          if (new_index == state_group_index) {
-            curr_geom->group_order_.append(state_group_name);
+        /* Materials and their libraries. */
+        else if (parse_keyword(p, end, "usemtl")) {
+          state_material_name = StringRef(p, end).trim();
+          int new_mat_index = curr_geom->material_indices_.size();
+          state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
+                                                                            new_mat_index);
+          if (new_mat_index == state_material_index) {
+            curr_geom->material_order_.append(state_material_name);
           }
         }
-      }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
+        else if (parse_keyword(p, end, "mtllib")) {
+          add_mtl_library(StringRef(p, end).trim());
+        }
+        else if (parse_keyword(p, end, "#MRGB")) {
+          geom_add_mrgb_colors(p, end, r_global_vertices);
+        }
+        /* Comments. */
+        else if (*p == '#') {
+          /* Nothing to do. */
+        }
+        /* Curve related things. */
+        else if (parse_keyword(p, end, "cstype")) {
+          curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
+        }
+        else if (parse_keyword(p, end, "deg")) {
+          geom_set_curve_degree(curr_geom, p, end);
+        }
+        else if (parse_keyword(p, end, "curv")) {
+          geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
+        }
+        else if (parse_keyword(p, end, "parm")) {
+          geom_add_curve_parameters(curr_geom, p, end);
+        }
+        else if (StringRef(p, end).startswith("end")) {
+          /* End of curve definition, nothing else to do. */
+        }
+        else {
+          std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
         }
       }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
-      }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
-      }
-      /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
-      }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
-      }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
-      }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
-      }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
-      }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
-      }
-      else {
-        std::cout << "OBJ element not recognized: '" << std::string(p, end) << "'" << std::endl;
-      }
+      flush_chunk_vertices(chunk,
+                           chunk.vertices.size(),
+                           chunk.uv_vertices.size(),
+                           chunk.vert_normals.size(),
+                           flushed,
+                           r_global_vertices);
+      line_number += chunk.lines_num;
     }
 
     /* We might have a line that was cut in the middle by the previous buffer;
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <ios>
+#include <limits>
 #include <memory>
 #include <string>
 #include <system_error>
@@ -243,6 +244,40 @@ parm u 0.0
   ASSERT_EQ(got_string, expected);
 }
 
+TEST(obj_exporter_writer, format_handler_floats)
+{
+  const float values[] = {0.0f,
+                          -0.0f,
+                          1.0f,
+                          -1.5f,
+                          0.0078125f,
+                          0.0234375f,
+                          -0.0000001f,
+                          0.00005f,
+                          0.99999994f,
+                          123456.789f,
+                          -9999999.0f,
+                          1.0e20f,
+                          -3.4e38f,
+                          std::numeric_limits<float>::infinity(),
+                          std::numeric_limits<float>::quiet_NaN()};
+  for (const float value : values) {
+    FormatHandler h;
+    h.write_obj_vertex(value, -value, value * 0.1f);
+    h.write_obj_normal(value, value * 3.0f, -value);
+    h.write_obj_face_v_uv_normal(1, 22, 333);
+    const std::string expected = fmt::format("v {:.6f} {:.6f} {:.6f}\nvn {:.4f} {:.4f} {:.4f}\n",
+                                             value,
+                                             -value,
+                                             value * 0.1f,
+                                             value,
+                                             value * 3.0f,
+                                             -value) +
+                                 " 1/22/333";
+    EXPECT_EQ(h.get_as_string(), expected);
+  }
+}
+
 /* Return true if string #a and string #b are equal after their first newline. */
 static bool strings_equal_after_first_lines(const std::string &a, const std::string &b)
 {
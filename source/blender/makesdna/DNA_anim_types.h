@@ -522,6 +522,8 @@ typedef struct ChannelDriver {
 
   /** Compiled simple arithmetic expression. */
   struct ExprPyLike_Parsed *expr_simple;
+  /** Resolved RNA paths of the targets of an evaluated driver, don't save this. */
+  struct DriverTargetsCache *targets_cache;
 
   /** Result of previous evaluation. */
   float curval;
@@ -653,6 +655,13 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe that ended the segment found by the last evaluation, used as a hint for
+   * the next evaluation (runtime only, it is checked against the keyframes before it is used).
+   */
+  int eval_segment_hint;
+  char _pad2[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -22,6 +22,10 @@
 
 namespace blender {
 template<typename T> struct Bounds;
+namespace index_mask {
+class IndexMask;
+}  // namespace index_mask
+using index_mask::IndexMask;
 namespace offset_indices {
 template<typename T> struct GroupedSpan;
 template<typename T> class OffsetIndices;
@@ -321,6 +325,10 @@ typedef struct Mesh {
    * Cached map from each vertex to the faces using it.
    */
   blender::GroupedSpan<int> vert_to_face_map() const;
+  /**
+   * Cached map from each vertex to the edges using it.
+   */
+  blender::GroupedSpan<int> vert_to_edge_map() const;
 
   /**
    * Cached information about loose edges, calculated lazily when necessary.
@@ -397,6 +405,11 @@ typedef struct Mesh {
 
   /** Call after changing vertex positions to tag lazily calculated caches for recomputation. */
   void tag_positions_changed();
+  /**
+   * Call after moving only the vertices in the mask. Cached normals are updated for the faces and
+   * vertices around the changed vertices instead of being recomputed for the whole mesh.
+   */
+  void tag_positions_changed(const blender::IndexMask &changed_verts);
   /** Call after moving every mesh vertex by the same translation. */
   void tag_positions_changed_uniformly();
   /** Like #tag_positions_changed but doesn't tag normals; they must be updated separately. */
@@ -2282,6 +2282,11 @@ enum {
 
   /* Read animated custom attributes from point cache files. */
   MOD_MESHSEQ_READ_ATTRIBUTES = (1 << 5),
+
+  /* When the topology of the cached mesh matches the input mesh, only read vertex positions and
+   * velocities. The faces and all other data of the input mesh are kept and stay shared with it,
+   * so that caches derived from the topology remain valid. */
+  MOD_MESHSEQ_STABLE_TOPOLOGY = (1 << 6),
 };
 
 typedef struct SDefBind {
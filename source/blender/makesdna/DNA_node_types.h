@@ -2823,6 +2823,7 @@ typedef enum GeometryNodeMeshCircleFillType {
 typedef enum GeometryNodeMergeByDistanceMode {
   GEO_NODE_MERGE_BY_DISTANCE_MODE_ALL = 0,
   GEO_NODE_MERGE_BY_DISTANCE_MODE_CONNECTED = 1,
+  GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID = 2,
 } GeometryNodeMergeByDistanceMode;
 
 typedef enum GeometryNodeUVUnwrapMethod {
@@ -25,6 +25,7 @@
 #include "BLI_memarena.h"
 #include "BLI_string.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLI_ghash.h"
 
@@ -1172,6 +1173,9 @@ struct DNA_ReconstructInfo {
 
   int *step_counts;
   ReconstructStep **steps;
+
+  /** Index in `newsdna->structs` for every struct in `oldsdna`, -1 if it does not exist. */
+  int *new_struct_nrs;
 };
 
 static void reconstruct_structs(const DNA_ReconstructInfo *reconstruct_info,
@@ -1271,10 +1275,7 @@ void *DNA_struct_reconstruct(const DNA_ReconstructInfo *reconstruct_info,
   const SDNA *oldsdna = reconstruct_info->oldsdna;
   const SDNA *newsdna = reconstruct_info->newsdna;
 
-  const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
-  const char *type_name = oldsdna->types[old_struct->type];
-  const int new_struct_nr = DNA_struct_find_without_alias(newsdna, type_name);
-
+  const int new_struct_nr = reconstruct_info->new_struct_nrs[old_struct_nr];
   if (new_struct_nr == -1) {
     return nullptr;
   }
@@ -1569,6 +1570,109 @@ static int compress_reconstruct_steps(ReconstructStep *steps, const int old_step
   return new_step_count;
 }
 
+/**
+ * Maximum number of steps a #RECONSTRUCT_STEP_SUBSTRUCT step is expanded to when inlining the
+ * steps of the nested struct. Inlining avoids the recursion and allows merging more #memcpy
+ * steps, but large arrays of nested structs are better handled by looping over them.
+ */
+#define RECONSTRUCT_SUBSTRUCT_INLINE_STEPS_MAX 64
+
+static void reconstruct_step_offset(ReconstructStep &step,
+                                    const int old_offset,
+                                    const int new_offset)
+{
+  switch (step.type) {
+    case RECONSTRUCT_STEP_MEMCPY:
+      step.data.memcpy.old_offset += old_offset;
+      step.data.memcpy.new_offset += new_offset;
+      break;
+    case RECONSTRUCT_STEP_CAST_PRIMITIVE:
+      step.data.cast_primitive.old_offset += old_offset;
+      step.data.cast_primitive.new_offset += new_offset;
+      break;
+    case RECONSTRUCT_STEP_CAST_POINTER_TO_32:
+    case RECONSTRUCT_STEP_CAST_POINTER_TO_64:
+      step.data.cast_pointer.old_offset += old_offset;
+      step.data.cast_pointer.new_offset += new_offset;
+      break;
+    case RECONSTRUCT_STEP_SUBSTRUCT:
+      step.data.substruct.old_offset += old_offset;
+      step.data.substruct.new_offset += new_offset;
+      break;
+    case RECONSTRUCT_STEP_INIT_ZERO:
+      break;
+  }
+}
+
+/**
+ * Replace #RECONSTRUCT_STEP_SUBSTRUCT steps of a struct by the steps of the nested struct, so
+ * that reconstructing becomes a flat list of copy and cast operations. Nested structs are
+ * processed first, `r_is_inlined` tracks which structs are done already.
+ */
+static void inline_reconstruct_substruct_steps(DNA_ReconstructInfo *reconstruct_info,
+                                               const int new_struct_nr,
+                                               bool *r_is_inlined)
+{
+  if (r_is_inlined[new_struct_nr]) {
+    return;
+  }
+  r_is_inlined[new_struct_nr] = true;
+
+  ReconstructStep *steps = reconstruct_info->steps[new_struct_nr];
+  const int step_count = reconstruct_info->step_counts[new_struct_nr];
+  bool has_substruct = false;
+  for (int a = 0; a < step_count; a++) {
+    if (steps[a].type == RECONSTRUCT_STEP_SUBSTRUCT) {
+      inline_reconstruct_substruct_steps(
+          reconstruct_info, steps[a].data.substruct.new_struct_nr, r_is_inlined);
+      has_substruct = true;
+    }
+  }
+  if (!has_substruct) {
+    return;
+  }
+
+  const SDNA *oldsdna = reconstruct_info->oldsdna;
+  const SDNA *newsdna = reconstruct_info->newsdna;
+
+  blender::Vector<ReconstructStep, 16> new_steps;
+  for (int a = 0; a < step_count; a++) {
+    const ReconstructStep &step = steps[a];
+    if (step.type != RECONSTRUCT_STEP_SUBSTRUCT) {
+      new_steps.append(step);
+      continue;
+    }
+    const int sub_new_struct_nr = step.data.substruct.new_struct_nr;
+    const ReconstructStep *sub_steps = reconstruct_info->steps[sub_new_struct_nr];
+    const int sub_step_count = reconstruct_info->step_counts[sub_new_struct_nr];
+    const int array_len = step.data.substruct.array_len;
+    if (sub_step_count * array_len > RECONSTRUCT_SUBSTRUCT_INLINE_STEPS_MAX) {
+      new_steps.append(step);
+      continue;
+    }
+    const int old_size =
+        oldsdna->types_size[oldsdna->structs[step.data.substruct.old_struct_nr]->type];
+    const int new_size = newsdna->types_size[newsdna->structs[sub_new_struct_nr]->type];
+    for (int elem = 0; elem < array_len; elem++) {
+      for (int b = 0; b < sub_step_count; b++) {
+        ReconstructStep sub_step = sub_steps[b];
+        reconstruct_step_offset(sub_step,
+                                step.data.substruct.old_offset + elem * old_size,
+                                step.data.substruct.new_offset + elem * new_size);
+        new_steps.append(sub_step);
+      }
+    }
+  }
+
+  MEM_freeN(steps);
+  steps = static_cast<ReconstructStep *>(MEM_malloc_arrayN(
+      std::max<int64_t>(new_steps.size(), 1), sizeof(ReconstructStep), __func__));
+  std::copy(new_steps.begin(), new_steps.end(), steps);
+  reconstruct_info->steps[new_struct_nr] = steps;
+  reconstruct_info->step_counts[new_struct_nr] = compress_reconstruct_steps(steps,
+                                                                            new_steps.size());
+}
+
 DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
                                                  const SDNA *newsdna,
                                                  const char *compare_flags)
@@ -1582,6 +1686,9 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
       MEM_malloc_arrayN(newsdna->structs_len, sizeof(int), __func__));
   reconstruct_info->steps = static_cast<ReconstructStep **>(
       MEM_malloc_arrayN(newsdna->structs_len, sizeof(ReconstructStep *), __func__));
+  reconstruct_info->new_struct_nrs = static_cast<int *>(
+      MEM_malloc_arrayN(oldsdna->structs_len, sizeof(int), __func__));
+  std::fill_n(reconstruct_info->new_struct_nrs, oldsdna->structs_len, -1);
 
   /* Generate reconstruct steps for all structs. */
   for (int new_struct_nr = 0; new_struct_nr < newsdna->structs_len; new_struct_nr++) {
@@ -1593,6 +1700,7 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
       reconstruct_info->step_counts[new_struct_nr] = 0;
       continue;
     }
+    reconstruct_info->new_struct_nrs[old_struct_nr] = new_struct_nr;
     const SDNA_Struct *old_struct = oldsdna->structs[old_struct_nr];
     ReconstructStep *steps = create_reconstruct_steps_for_struct(
         oldsdna, newsdna, compare_flags, old_struct, new_struct);
@@ -1614,6 +1722,16 @@ DNA_ReconstructInfo *DNA_reconstruct_info_create(const SDNA *oldsdna,
 #endif
   }
 
+  /* Inline nested structs, turning the reconstruction into mostly flat copy operations. */
+  bool *is_inlined = static_cast<bool *>(
+      MEM_calloc_arrayN(newsdna->structs_len, sizeof(bool), __func__));
+  for (int new_struct_nr = 0; new_struct_nr < newsdna->structs_len; new_struct_nr++) {
+    if (reconstruct_info->steps[new_struct_nr] != nullptr) {
+      inline_reconstruct_substruct_steps(reconstruct_info, new_struct_nr, is_inlined);
+    }
+  }
+  MEM_freeN(is_inlined);
+
   return reconstruct_info;
 }
 
@@ -1626,6 +1744,7 @@ void DNA_reconstruct_info_free(DNA_ReconstructInfo *reconstruct_info)
   }
   MEM_freeN(reconstruct_info->steps);
   MEM_freeN(reconstruct_info->step_counts);
+  MEM_freeN(reconstruct_info->new_struct_nrs);
   MEM_freeN(reconstruct_info);
 }
 
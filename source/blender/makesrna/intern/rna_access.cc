@@ -16,6 +16,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_ID.h"
 #include "DNA_anim_types.h"
 #include "DNA_constraint_types.h"
@@ -77,24 +79,41 @@ void RNA_init()
   BLENDER_RNA.structs_map = BLI_ghash_str_new_ex(__func__, 2048);
   BLENDER_RNA.structs_len = 0;
 
+  /* The property hashes are created on first use by #rna_struct_prophash_ensure, most structs are
+   * never accessed by name in a typical session and building all of them slows down startup. */
   for (srna = static_cast<StructRNA *>(BLENDER_RNA.structs.first); srna;
        srna = static_cast<StructRNA *>(srna->cont.next))
   {
-    if (!srna->cont.prophash) {
-      srna->cont.prophash = BLI_ghash_str_new("RNA_init gh");
-
-      LISTBASE_FOREACH (PropertyRNA *, prop, &srna->cont.properties) {
-        if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
-          BLI_ghash_insert(srna->cont.prophash, (void *)prop->identifier, prop);
-        }
-      }
-    }
     BLI_assert(srna->flag & STRUCT_PUBLIC_NAMESPACE);
     BLI_ghash_insert(BLENDER_RNA.structs_map, (void *)srna->identifier, srna);
     BLENDER_RNA.structs_len += 1;
   }
 }
 
+GHash *rna_struct_prophash_ensure(StructRNA *srna)
+{
+  GHash *prophash = static_cast<GHash *>(atomic_load_ptr((void **)&srna->cont.prophash));
+  if (prophash || (srna->flag & STRUCT_RUNTIME)) {
+    /* Runtime structs are freed without their hash, they use a linear lookup instead. */
+    return prophash;
+  }
+
+  prophash = BLI_ghash_str_new("RNA_init gh");
+  LISTBASE_FOREACH (PropertyRNA *, prop, &srna->cont.properties) {
+    if (!(prop->flag_internal & PROP_INTERN_BUILTIN)) {
+      BLI_ghash_insert(prophash, (void *)prop->identifier, prop);
+    }
+  }
+  /* Lookups can happen from multiple threads, only keep the hash of the first one. */
+  GHash *prophash_orig = static_cast<GHash *>(
+      atomic_cas_ptr((void **)&srna->cont.prophash, nullptr, prophash));
+  if (prophash_orig) {
+    BLI_ghash_free(prophash, nullptr, nullptr);
+    return prophash_orig;
+  }
+  return prophash;
+}
+
 void RNA_exit()
 {
   StructRNA *srna;
@@ -4748,6 +4767,80 @@ size_t RNA_raw_type_sizeof(RawPropertyType type)
   }
 }
 
+/** Call the function with a value of the C++ type corresponding to the raw type. */
+template<typename Fn> static void rna_raw_type_to_static_type(const RawPropertyType type, Fn &&fn)
+{
+  switch (type) {
+    case PROP_RAW_CHAR:
+      fn(char());
+      break;
+    case PROP_RAW_INT8:
+      fn(int8_t());
+      break;
+    case PROP_RAW_UINT8:
+      fn(uint8_t());
+      break;
+    case PROP_RAW_SHORT:
+      fn(short());
+      break;
+    case PROP_RAW_UINT16:
+      fn(uint16_t());
+      break;
+    case PROP_RAW_INT:
+      fn(int());
+      break;
+    case PROP_RAW_BOOLEAN:
+      fn(bool());
+      break;
+    case PROP_RAW_FLOAT:
+      fn(float());
+      break;
+    case PROP_RAW_DOUBLE:
+      fn(double());
+      break;
+    case PROP_RAW_INT64:
+      fn(int64_t());
+      break;
+    case PROP_RAW_UINT64:
+      fn(uint64_t());
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+/**
+ * Copy values between a contiguous array and the items of a raw collection array with different
+ * types, converting them with a cast like #RAW_GET and #RAW_SET do.
+ */
+static void rna_raw_array_convert(RawArray &contiguous,
+                                  RawArray &items,
+                                  const int values_per_item,
+                                  const bool set)
+{
+  rna_raw_type_to_static_type(contiguous.type, [&](auto contiguous_dummy) {
+    using ContiguousT = decltype(contiguous_dummy);
+    rna_raw_type_to_static_type(items.type, [&](auto item_dummy) {
+      using ItemT = decltype(item_dummy);
+      ContiguousT *contiguous_values = static_cast<ContiguousT *>(contiguous.array);
+      for (int a = 0; a < items.len; a++) {
+        ItemT *item_values = reinterpret_cast<ItemT *>(static_cast<char *>(items.array) +
+                                                       int64_t(a) * items.stride);
+        for (int i = 0; i < values_per_item; i++) {
+          if (set) {
+            item_values[i] = ItemT(contiguous_values[i]);
+          }
+          else {
+            contiguous_values[i] = ContiguousT(item_values[i]);
+          }
+        }
+        contiguous_values += values_per_item;
+      }
+    });
+  });
+}
+
 static int rna_property_array_length_all_dimensions(PointerRNA *ptr, PropertyRNA *prop)
 {
   int i, len[RNA_MAX_ARRAY_DIMENSION];
@@ -4857,8 +4950,12 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Convert the values directly instead of getting or setting every item through RNA, which
+       * is a common case for scripts that use arrays of a different type than the property. */
+      if (out.type != PROP_RAW_UNSET && in.type != PROP_RAW_UNSET) {
+        rna_raw_array_convert(in, out, arraylen, set);
+        return 1;
+      }
     }
     BLI_assert_msg(itemlen == 0 || itemtype != PROP_ENUM,
                    "Enum array properties should not exist");
@@ -21,6 +21,7 @@
 enum class AttributeOwnerType;
 
 struct FreestyleSettings;
+struct GHash;
 struct ID;
 struct IDOverrideLibrary;
 struct IDProperty;
@@ -545,6 +546,11 @@ void rna_builtin_properties_next(CollectionPropertyIterator *iter);
 PointerRNA rna_builtin_properties_get(CollectionPropertyIterator *iter);
 PointerRNA rna_builtin_type_get(PointerRNA *ptr);
 bool rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, PointerRNA *r_ptr);
+/**
+ * Get the hash of the properties of the struct by identifier, creating it on first use.
+ * Returns null for structs registered at runtime, which don't have a hash.
+ */
+GHash *rna_struct_prophash_ensure(StructRNA *srna);
 
 /* Iterators */
 
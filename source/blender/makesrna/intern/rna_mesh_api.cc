@@ -39,6 +39,10 @@
 
 #  include "WM_api.hh"
 
+#  ifdef WITH_PYTHON
+#    include "BPY_extern.h"
+#  endif
+
 static const char *rna_Mesh_unit_test_compare(Mesh *mesh, Mesh *mesh2, float threshold)
 {
   using namespace blender::bke::compare_meshes;
@@ -74,7 +78,15 @@ static void rna_Mesh_calc_tangents(Mesh *mesh, ReportList *reports, const char *
     CustomData_set_layer_flag(&mesh->corner_data, CD_MLOOPTANGENT, CD_FLAG_TEMPORARY);
   }
 
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   BKE_mesh_calc_loop_tangent_single(mesh, uvmap, r_looptangents, reports);
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
 }
 
 static void rna_Mesh_free_tangents(Mesh *mesh)
@@ -84,7 +96,15 @@ static void rna_Mesh_free_tangents(Mesh *mesh)
 
 static void rna_Mesh_calc_corner_tri(Mesh *mesh)
 {
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   mesh->corner_tris();
+
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
 }
 
 static void rna_Mesh_calc_smooth_groups(
@@ -120,8 +140,16 @@ static void rna_Mesh_normals_split_custom_set(Mesh *mesh,
     return;
   }
 
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   BKE_mesh_set_custom_normals(mesh, corner_normals);
 
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
+
   DEG_id_tag_update(&mesh->id, 0);
 }
 
@@ -141,8 +169,16 @@ static void rna_Mesh_normals_split_custom_set_from_vertices(Mesh *mesh,
     return;
   }
 
+#  ifdef WITH_PYTHON
+  BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
   BKE_mesh_set_custom_normals_from_verts(mesh, vert_normals);
 
+#  ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#  endif
+
   DEG_id_tag_update(&mesh->id, 0);
 }
 
@@ -168,7 +204,16 @@ static void rna_Mesh_update(Mesh *mesh,
                             const bool calc_edges_loose)
 {
   if (calc_edges || ((mesh->faces_num || mesh->totface_legacy) && mesh->edges_num == 0)) {
+#  ifdef WITH_PYTHON
+    /* Allow other Python threads to run while the edges are calculated. */
+    BPy_BEGIN_ALLOW_THREADS;
+#  endif
+
     blender::bke::mesh_calc_edges(*mesh, calc_edges, true);
+
+#  ifdef WITH_PYTHON
+    BPy_END_ALLOW_THREADS;
+#  endif
   }
 
   if (calc_edges_loose) {
@@ -847,6 +847,7 @@ static const EnumPropertyItem grease_pencil_build_time_mode_items[] = {
 #  include "DNA_particle_types.h"
 
 #  include "BKE_cachefile.hh"
+#  include "BKE_compute_contexts.hh"
 #  include "BKE_context.hh"
 #  include "BKE_deform.hh"
 #  include "BKE_material.h"
@@ -864,6 +865,8 @@ static const EnumPropertyItem grease_pencil_build_time_mode_items[] = {
 
 #  include "ED_object.hh"
 
+#  include "NOD_geometry_nodes_log.hh"
+
 #  ifdef WITH_ALEMBIC
 #    include "ABC_alembic.h"
 #  endif
@@ -1924,6 +1927,20 @@ static IDProperty **rna_NodesModifier_properties(PointerRNA *ptr)
   return &settings->properties;
 }
 
+static void rna_NodesModifier_profile_report(NodesModifierData *nmd,
+                                             const char **r_report,
+                                             int *r_report_len)
+{
+  using namespace blender;
+  std::string report = "{}";
+  if (nmd->node_group && nmd->runtime->eval_log) {
+    const bke::ModifierComputeContext compute_context{nullptr, nmd->modifier.name};
+    report = nmd->runtime->eval_log->profile_report_json(*nmd->node_group, compute_context);
+  }
+  *r_report = BLI_strdupn(report.c_str(), report.size());
+  *r_report_len = int(report.size());
+}
+
 static void rna_Lineart_start_level_set(PointerRNA *ptr, int value)
 {
   GreasePencilLineartModifierData *lmd = (GreasePencilLineartModifierData *)ptr->data;
@@ -6851,6 +6868,16 @@ static void rna_def_modifier_meshseqcache(BlenderRNA *brna)
       prop, "Vertex Interpolation", "Allow interpolation of vertex positions");
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_property(srna, "use_stable_topology", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "read_flag", MOD_MESHSEQ_STABLE_TOPOLOGY);
+  RNA_def_property_ui_text(prop,
+                           "Stable Topology",
+                           "Only read vertex positions and velocities when the topology of the "
+                           "cached mesh does not change, and keep faces, UVs, colors and normals "
+                           "of the mesh. This is faster for deforming meshes, but ignores changes "
+                           "to other data in the cache");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "velocity_scale", PROP_FLOAT, PROP_NONE);
   RNA_def_property_float_sdna(prop, nullptr, "velocity_scale");
   RNA_def_property_range(prop, 0.0f, FLT_MAX);
@@ -7912,6 +7939,15 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   rna_def_modifier_panel_open_prop(srna, "open_bake_data_blocks_panel", 4);
 
   RNA_define_lib_overridable(false);
+
+  FunctionRNA *func = RNA_def_function(
+      srna, "profile_report", "rna_NodesModifier_profile_report");
+  RNA_def_function_ui_description(
+      func,
+      "Return a JSON report of the run time, allocated memory and output element counts of the "
+      "nodes in the last evaluation, nested by node groups and zone iterations");
+  PropertyRNA *parm = RNA_def_string(func, "report", nullptr, 0, "", "");
+  RNA_def_parameter_flags(parm, PROP_DYNAMIC, PARM_OUTPUT);
 }
 
 static void rna_def_modifier_mesh_to_volume(BlenderRNA *brna)
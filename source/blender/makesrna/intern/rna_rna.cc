@@ -559,8 +559,8 @@ bool rna_builtin_properties_lookup_string(PointerRNA *ptr, const char *key, Poin
   srna = ptr->type;
 
   do {
-    if (srna->cont.prophash) {
-      prop = static_cast<PropertyRNA *>(BLI_ghash_lookup(srna->cont.prophash, (void *)key));
+    if (GHash *prophash = rna_struct_prophash_ensure(srna)) {
+      prop = static_cast<PropertyRNA *>(BLI_ghash_lookup(prophash, (void *)key));
 
       if (prop) {
         propptr.type = &RNA_Property;
@@ -6056,6 +6056,14 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "use_sequencer_cache_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "video_flag", USER_VIDEO_CACHE_COMPRESSION);
+  RNA_def_property_ui_text(prop,
+                           "Compress Cache",
+                           "Store more images in the sequencer memory cache. Float images are "
+                           "stored with half float precision, byte images are compressed "
+                           "without loss");
+
   /* Sequencer disk cache */
 
   prop = RNA_def_property(srna, "use_sequencer_disk_cache", PROP_BOOLEAN, PROP_NONE);
@@ -6081,6 +6089,14 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Disk Cache Compression Level",
       "Smaller compression will result in larger files, but less decoding overhead");
 
+  prop = RNA_def_property(srna, "use_hardware_video_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "video_flag", USER_VIDEO_HARDWARE_DECODING);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies on the GPU when the video codec is supported by it, "
+                           "which is faster for high resolution footage. This only affects movies "
+                           "opened after changing it");
+
   /* Sequencer proxy setup */
 
   prop = RNA_def_property(srna, "sequencer_proxy_setup", PROP_ENUM, PROP_NONE);
@@ -6217,6 +6233,25 @@ static void rna_def_userdef_system(BlenderRNA *brna)
                            "When making a selection in 3D View, use the GPU depth buffer to "
                            "ensure the frontmost object is selected first");
 
+  /* Volumes. */
+
+  prop = RNA_def_property(srna, "use_volume_delay_load", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", USER_VOLUME_DELAY_LOAD);
+  RNA_def_property_ui_text(prop,
+                           "Delay Loading Volumes",
+                           "Only read the topology of OpenVDB grids when loading them, and read "
+                           "the voxel data of their leaf nodes once it is accessed. This reduces "
+                           "memory usage of large volumes, but can be slow on network drives. "
+                           "Only affects volume files that are loaded afterwards");
+
+  prop = RNA_def_property(srna, "volume_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "volume_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Volume Cache Limit",
+                           "Memory that loaded volume grids can use before the least recently "
+                           "used ones are unloaded (in megabytes, 0 for no limit)");
+
   /* GPU subdivision evaluation. */
 
   prop = RNA_def_property(srna, "use_gpu_subdivision", PROP_BOOLEAN, PROP_NONE);
@@ -328,14 +328,7 @@ static void copy_masked_verts_to_new_mesh(const Mesh &src_mesh,
                                           Span<int> vertex_map)
 {
   BLI_assert(src_mesh.verts_num == vertex_map.size());
-  for (const int i_src : vertex_map.index_range()) {
-    const int i_dst = vertex_map[i_src];
-    if (i_dst == -1) {
-      continue;
-    }
-
-    CustomData_copy_data(&src_mesh.vert_data, &dst_mesh.vert_data, i_src, i_dst, 1);
-  }
+  CustomData_copy_data_map(&src_mesh.vert_data, &dst_mesh.vert_data, vertex_map);
 }
 
 static float get_interp_factor_from_vgroup(
@@ -423,13 +416,13 @@ static void copy_masked_edges_to_new_mesh(const Mesh &src_mesh,
 
   BLI_assert(src_mesh.verts_num == vertex_map.size());
   BLI_assert(src_mesh.edges_num == edge_map.size());
+  CustomData_copy_data_map(&src_mesh.edge_data, &dst_mesh.edge_data, edge_map);
   for (const int i_src : IndexRange(src_mesh.edges_num)) {
     const int i_dst = edge_map[i_src];
     if (ELEM(i_dst, -1, -2)) {
       continue;
     }
 
-    CustomData_copy_data(&src_mesh.edge_data, &dst_mesh.edge_data, i_src, i_dst, 1);
     dst_edges[i_dst][0] = vertex_map[src_edges[i_src][0]];
     dst_edges[i_dst][1] = vertex_map[src_edges[i_src][1]];
   }
@@ -14,6 +14,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_arena_allocator.hh"
 #include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vector_types.hh"
@@ -93,6 +94,7 @@
 #include "NOD_geometry_nodes_execute.hh"
 #include "NOD_geometry_nodes_gizmos.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_result_cache.hh"
 #include "NOD_node_declaration.hh"
 
 #include "FN_field.hh"
@@ -115,6 +117,7 @@ static void init_data(ModifierData *md)
   MEMCPY_STRUCT_AFTER(nmd, DNA_struct_default_get(NodesModifierData), modifier);
   nmd->runtime = MEM_new<NodesModifierRuntime>(__func__);
   nmd->runtime->cache = std::make_shared<bake::ModifierCache>();
+  nmd->runtime->result_cache = std::make_shared<nodes::GeoNodesResultCache>();
 }
 
 static void find_used_ids_from_settings(const NodesModifierSettings &settings, Set<ID *> &ids)
@@ -966,6 +969,10 @@ static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache
   if (!frame_cache.state.items_by_id.is_empty()) {
     return;
   }
+  if (frame_cache.is_paged) {
+    bake_cache.page_in(frame_cache);
+    return;
+  }
   if (!bake_cache.blobs_dir) {
     return;
   }
@@ -1187,7 +1194,8 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
         {
           /* Read the previous frame's data and store the newly computed simulation state. */
           auto &output_copy_info = zone_behavior.input.emplace<sim_input::OutputCopy>();
-          const bake::FrameCache &prev_frame_cache = *node_cache.bake.frames[*frame_indices.prev];
+          bake::FrameCache &prev_frame_cache = *node_cache.bake.frames[*frame_indices.prev];
+          ensure_bake_loaded(node_cache.bake, prev_frame_cache);
           const float real_delta_frames = float(current_frame_) - float(prev_frame_cache.frame);
           if (real_delta_frames != 1) {
             node_cache.cache_status = bake::CacheStatus::Invalid;
@@ -1266,6 +1274,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
       frame_cache->frame = current_frame;
       frame_cache->state = std::move(state);
       node_cache->bake.frames.append(std::move(frame_cache));
+      node_cache->bake.page_out_distant_frames(current_frame);
     };
   }
 
@@ -1292,6 +1301,7 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     if (frame_indices.prev) {
       auto &output_copy_info = zone_behavior.input.emplace<sim_input::OutputCopy>();
       bake::FrameCache &frame_cache = *node_cache.bake.frames[*frame_indices.prev];
+      ensure_bake_loaded(node_cache.bake, frame_cache);
       const float delta_frames = std::min(max_delta_frames,
                                           float(current_frame_) - float(frame_cache.frame));
       output_copy_info.delta_time = delta_frames / fps_;
@@ -1318,6 +1328,8 @@ class NodesModifierSimulationParams : public nodes::GeoNodesSimulationParams {
     else {
       this->output_pass_through(zone_behavior);
     }
+    /* Free states that were loaded while scrubbing through a long simulation. */
+    node_cache.bake.page_out_distant_frames(current_frame_);
   }
 
   void read_single(const int frame_index,
@@ -1751,6 +1763,19 @@ static void modifyGeometry(ModifierData *md,
   find_side_effect_nodes(*nmd, *ctx, side_effect_nodes, socket_log_contexts);
   call_data.side_effect_nodes = &side_effect_nodes;
 
+  /* Only the active depsgraph is evaluated repeatedly with small changes, other evaluations would
+   * just replace the cached outputs. */
+  nodes::GeoNodesResultCache *result_cache = nullptr;
+  if (DEG_is_active(ctx->depsgraph) && !(ctx->flag & MOD_APPLY_TO_BASE_MESH)) {
+    result_cache = nmd->runtime->result_cache.get();
+  }
+  call_data.result_cache = result_cache;
+
+  /* Temporary containers of the evaluation are freed together when the modifier is done. */
+  ArenaScope arena;
+  ArenaScope::Activation arena_activation(&arena);
+  call_data.arena = &arena;
+
   bke::ModifierComputeContext modifier_compute_context{nullptr, nmd->modifier.name};
 
   geometry_set = nodes::execute_geometry_nodes_on_geometry(tree,
@@ -1759,6 +1784,10 @@ static void modifyGeometry(ModifierData *md,
                                                            call_data,
                                                            std::move(geometry_set));
 
+  if (result_cache) {
+    result_cache->remove_unused();
+  }
+
   if (logging_enabled(ctx)) {
     nmd_orig->runtime->eval_log = std::move(eval_log);
   }
@@ -2462,6 +2491,7 @@ static void blend_read(BlendDataReader *reader, ModifierData *md)
 
   nmd->runtime = MEM_new<NodesModifierRuntime>(__func__);
   nmd->runtime->cache = std::make_shared<bake::ModifierCache>();
+  nmd->runtime->result_cache = std::make_shared<nodes::GeoNodesResultCache>();
 }
 
 static void copy_data(const ModifierData *md, ModifierData *target, const int flag)
@@ -2502,11 +2532,13 @@ static void copy_data(const ModifierData *md, ModifierData *target, const int fl
   if (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) {
     /* Share the simulation cache between the original and evaluated modifier. */
     tnmd->runtime->cache = nmd->runtime->cache;
+    tnmd->runtime->result_cache = nmd->runtime->result_cache;
     /* Keep bake path in the evaluated modifier. */
     tnmd->bake_directory = nmd->bake_directory ? BLI_strdup(nmd->bake_directory) : nullptr;
   }
   else {
     tnmd->runtime->cache = std::make_shared<bake::ModifierCache>();
+    tnmd->runtime->result_cache = std::make_shared<nodes::GeoNodesResultCache>();
     /* Clear the bake path when duplicating. */
     tnmd->bake_directory = nullptr;
   }
@@ -1919,10 +1919,7 @@ static Mesh *base_skin(Mesh *origmesh, SkinModifierData *smd, eSkinErrorFlag *r_
   const MDeformVert *dvert = origmesh->deform_verts().data();
   const int verts_num = origmesh->verts_num;
 
-  blender::Array<int> vert_to_edge_offsets;
-  blender::Array<int> vert_to_edge_indices;
-  const blender::GroupedSpan<int> vert_to_edge = blender::bke::mesh::build_vert_to_edge_map(
-      edges, verts_num, vert_to_edge_offsets, vert_to_edge_indices);
+  const blender::GroupedSpan<int> vert_to_edge = origmesh->vert_to_edge_map();
 
   emat = build_edge_mats(nodes, vert_positions, verts_num, edges, vert_to_edge, &has_valid_root);
   skin_nodes = build_frames(vert_positions, verts_num, nodes, vert_to_edge, emat);
@@ -102,10 +102,16 @@ static std::optional<Mesh *> calculate_weld(const Mesh &mesh, const WeldModifier
       const IndexMask selected_indices = selected_indices_from_vertex_group(
           vertex_group, defgrp_index, invert, memory);
       return blender::geometry::mesh_merge_by_distance_all(
-          mesh, IndexMask(selected_indices), wmd.merge_dist);
+          mesh,
+          IndexMask(selected_indices),
+          wmd.merge_dist,
+          blender::geometry::MergeByDistanceMethod::KDTree);
     }
     return blender::geometry::mesh_merge_by_distance_all(
-        mesh, IndexMask(mesh.verts_num), wmd.merge_dist);
+        mesh,
+        IndexMask(mesh.verts_num),
+        wmd.merge_dist,
+        blender::geometry::MergeByDistanceMethod::KDTree);
   }
   if (wmd.mode == MOD_WELD_MODE_CONNECTED) {
     const bool only_loose_edges = (wmd.flag & MOD_WELD_LOOSE_EDGES) != 0;
@@ -132,6 +132,8 @@ class GeoNodeExecParams {
 
   void check_input_geometry_set(StringRef identifier, const GeometrySet &geometry_set) const;
   void check_output_geometry_set(const GeometrySet &geometry_set) const;
+  /** Log the number of elements in the output geometry for profiling. */
+  void log_output_geometry_set(const GeometrySet &geometry_set) const;
 
   /**
    * Get the input value for the input socket with the given identifier.
@@ -180,6 +182,7 @@ class GeoNodeExecParams {
 #endif
       if constexpr (std::is_same_v<StoredT, GeometrySet>) {
         this->check_output_geometry_set(value);
+        this->log_output_geometry_set(value);
       }
       const int index = this->get_output_index(identifier);
       params_.set_output(index, std::forward<T>(value));
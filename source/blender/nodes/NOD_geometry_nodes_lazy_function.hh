@@ -38,6 +38,13 @@ struct Object;
 struct Depsgraph;
 struct Scene;
 
+namespace blender {
+class ArenaScope;
+}
+namespace blender::nodes {
+class GeoNodesResultCache;
+}
+
 namespace blender::nodes {
 
 using lf::LazyFunction;
@@ -238,6 +245,16 @@ struct GeoNodesCallData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /**
+   * Optional cache that allows reusing the outputs of expensive nodes from a previous evaluation
+   * when their inputs did not change.
+   */
+  GeoNodesResultCache *result_cache = nullptr;
+  /**
+   * Optional scope that is activated while nodes are executed, so that temporary containers using
+   * #ArenaAllocator are all freed at once at the end of the evaluation.
+   */
+  ArenaScope *arena = nullptr;
 
   /**
    * Data from the modifier that is being evaluated.
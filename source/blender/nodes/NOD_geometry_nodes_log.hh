@@ -48,6 +48,10 @@
 
 struct SpaceNode;
 
+namespace blender::io::serialize {
+class DictionaryValue;
+}
+
 namespace blender::nodes::geo_eval_log {
 
 using fn::GField;
@@ -189,6 +193,8 @@ class GeoTreeLogger {
  public:
   std::optional<ComputeContextHash> parent_hash;
   std::optional<int32_t> parent_node_id;
+  /** Set when the compute context is an iteration of a repeat zone. */
+  std::optional<int> zone_iteration;
   Vector<ComputeContextHash> children_hashes;
 
   LinearAllocator<> *allocator = nullptr;
@@ -206,6 +212,17 @@ class GeoTreeLogger {
     int32_t node_id;
     TimePoint start;
     TimePoint end;
+    /**
+     * Memory allocated on the executing thread while the node was running, see
+     * #MEM_get_thread_allocation_totals.
+     */
+    int64_t allocated_bytes;
+    int64_t allocations_num;
+  };
+  struct NodeOutputElements {
+    int32_t node_id;
+    /** Number of vertices, points and instances in an output geometry. */
+    int64_t elements_num;
   };
   struct ViewerNodeLogWithNode {
     int32_t node_id;
@@ -228,6 +245,7 @@ class GeoTreeLogger {
   linear_allocator::ChunkedList<SocketValueLog, 16> input_socket_values;
   linear_allocator::ChunkedList<SocketValueLog, 16> output_socket_values;
   linear_allocator::ChunkedList<NodeExecutionTime, 16> node_execution_times;
+  linear_allocator::ChunkedList<NodeOutputElements, 16> node_output_elements;
   linear_allocator::ChunkedList<ViewerNodeLogWithNode> viewer_node_logs;
   linear_allocator::ChunkedList<AttributeUsageWithNode> used_named_attributes;
   linear_allocator::ChunkedList<DebugMessage> debug_messages;
@@ -258,6 +276,11 @@ class GeoNodeLog {
    * inside.
    */
   std::chrono::nanoseconds run_time{0};
+  /** Memory allocated by this node. For node groups this contains the nodes inside. */
+  int64_t allocated_bytes = 0;
+  int64_t allocations_num = 0;
+  /** Sum of the element counts of all geometries that are output by the node. */
+  int64_t output_elements_num = 0;
   /** Maps from socket indices to their values. */
   Map<int, ValueLog *> input_values_;
   Map<int, ValueLog *> output_values_;
@@ -293,11 +316,15 @@ class GeoTreeLog {
   bool reduced_debug_messages_ = false;
   bool reduced_evaluated_gizmo_nodes_ = false;
 
+  friend GeoModifierLog;
+
  public:
   Map<int32_t, GeoNodeLog> nodes;
   Map<int32_t, ViewerNodeLog *, 0> viewer_node_logs;
   Vector<NodeWarning> all_warnings;
   std::chrono::nanoseconds run_time_sum{0};
+  int64_t allocated_bytes_sum = 0;
+  int64_t allocations_num_sum = 0;
   Vector<const GeometryAttributeInfo *> existing_attributes;
   Map<StringRefNull, NamedAttributeUsage> used_named_attributes;
   Set<int> evaluated_gizmo_nodes;
@@ -306,6 +333,7 @@ class GeoTreeLog {
   ~GeoTreeLog();
 
   void ensure_node_warnings();
+  /** Also gathers the other statistics in #GeoNodeLog that are used for profiling. */
   void ensure_node_run_time();
   void ensure_socket_values();
   void ensure_viewer_node_logs();
@@ -373,6 +401,23 @@ class GeoModifierLog {
    */
   GeoTreeLog &get_tree_log(const ComputeContextHash &compute_context_hash);
 
+  /**
+   * Create a JSON report of the execution time, allocated memory and number of output elements
+   * of every evaluated node. Nodes in node groups and zone iterations are nested in the same way
+   * as the compute contexts. Every entry has a `name`, a `value` (the run time in nanoseconds) and
+   * `children`, so that the report can be displayed as flame graph directly.
+   *
+   * \param tree: The node tree that is evaluated in the given compute context.
+   */
+  std::string profile_report_json(const bNodeTree &tree, const ComputeContext &compute_context);
+
+ private:
+  void append_profile_report(GeoTreeLog &tree_log,
+                             const bNodeTree &tree,
+                             io::serialize::DictionaryValue &r_entry);
+
+ public:
+
   /**
    * Utility accessor to logged data.
    */
@@ -0,0 +1,78 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Outputs of expensive geometry nodes are remembered between evaluations of a modifier, so that
+ * they can be reused when the node is evaluated again with the same inputs. That is common when
+ * only parts of a node tree depend on e.g. the current frame or on a property that is being
+ * tweaked.
+ *
+ * Geometry inputs are not compared by their values. Instead, the #ImplicitSharingInfo and its
+ * version of every array is compared, which makes detecting unchanged geometry very cheap. Geometry
+ * that is not shared with the previous evaluation is considered to be different, even if it is
+ * equal in value.
+ */
+
+#include <memory>
+#include <mutex>
+
+#include "BLI_compute_context.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_struct_equality_utils.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+
+namespace blender::nodes {
+
+class GeoNodesResultCache : NonCopyable, NonMovable {
+ public:
+  struct Entry;
+
+ private:
+  struct Key {
+    ComputeContextHash context_hash;
+    int32_t node_id;
+
+    uint64_t hash() const
+    {
+      return get_default_hash(context_hash, node_id);
+    }
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(Key, context_hash, node_id)
+  };
+
+  std::mutex mutex_;
+  Map<Key, std::unique_ptr<Entry>> entries_;
+
+ public:
+  GeoNodesResultCache();
+  ~GeoNodesResultCache();
+
+  /**
+   * Set the used outputs of the node from a previous evaluation if its inputs and settings did not
+   * change since then. Otherwise, the node is evaluated with `execute_fn` and its outputs are
+   * remembered for the next evaluation.
+   *
+   * All inputs of the node have to be available already.
+   */
+  void execute(const bNode &node,
+               const ComputeContextHash &context_hash,
+               lf::Params &params,
+               FunctionRef<void(lf::Params &params)> execute_fn);
+
+  /**
+   * Free the outputs of nodes that have not been evaluated since the last call. This should be
+   * called after every evaluation of the node tree.
+   */
+  void remove_unused();
+};
+
+}  // namespace blender::nodes
@@ -0,0 +1,167 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <mutex>
+
+#include "BLI_fileops.h"
+#include "BLI_map.hh"
+
+#include "BKE_attribute.hh"
+#include "BKE_instances.hh"
+#include "BKE_report.hh"
+
+#include "node_geometry_util.hh"
+
+namespace blender::nodes {
+
+/**
+ * Imported files are evicted from the cache, least recently used first, when all cached
+ * geometry uses more memory than this.
+ */
+static constexpr int64_t import_cache_memory_budget = int64_t(1024) * 1024 * 1024;
+
+struct ImportCacheKey {
+  std::string path;
+  std::string options;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(path, options);
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_2(ImportCacheKey, path, options)
+};
+
+struct ImportCacheItem {
+  /** Used to detect that the file changed since it was imported. */
+  int64_t file_mtime;
+  int64_t file_size;
+  ImportFileResult result;
+  int64_t memory;
+  uint64_t last_use;
+};
+
+/**
+ * Singleton cache that's shared by all import nodes.
+ */
+struct ImportCache {
+  std::mutex mutex;
+  Map<ImportCacheKey, ImportCacheItem> items;
+  int64_t memory = 0;
+  uint64_t use_counter = 0;
+
+  void remove(const ImportCacheKey &key)
+  {
+    memory -= items.lookup(key).memory;
+    items.remove_contained(key);
+  }
+
+  void remove_least_recently_used()
+  {
+    const ImportCacheKey *oldest_key = nullptr;
+    uint64_t oldest_use = UINT64_MAX;
+    for (const auto item : items.items()) {
+      if (item.value.last_use < oldest_use) {
+        oldest_key = &item.key;
+        oldest_use = item.value.last_use;
+      }
+    }
+    this->remove(ImportCacheKey(*oldest_key));
+  }
+};
+
+/**
+ * Uses the "construct on first use" idiom to get the cache.
+ */
+static ImportCache &get_import_cache()
+{
+  static ImportCache import_cache;
+  return import_cache;
+}
+
+static int64_t geometry_memory_estimate(const bke::GeometrySet &geometry)
+{
+  int64_t memory = 0;
+  for (const bke::GeometryComponent *component : geometry.get_components()) {
+    const std::optional<bke::AttributeAccessor> attributes = component->attributes();
+    if (!attributes) {
+      continue;
+    }
+    attributes->for_all(
+        [&](const bke::AttributeIDRef & /*attribute_id*/, const bke::AttributeMetaData &meta_data) {
+          const CPPType &type = *bke::custom_data_type_to_cpp_type(meta_data.data_type);
+          memory += attributes->domain_size(meta_data.domain) * type.size();
+          return true;
+        });
+  }
+  if (const bke::Instances *instances = geometry.get_instances()) {
+    for (const bke::InstanceReference &reference : instances->references()) {
+      if (reference.type() == bke::InstanceReference::Type::GeometrySet) {
+        memory += geometry_memory_estimate(reference.geometry_set());
+      }
+    }
+  }
+  return memory;
+}
+
+ImportFileResult import_file_cached(const StringRefNull path,
+                                    const StringRef options,
+                                    const FunctionRef<ImportFileResult()> import_fn)
+{
+  BLI_stat_t stat;
+  if (BLI_stat(path.c_str(), &stat) != 0) {
+    /* Let the importer report that the file can't be read. */
+    return import_fn();
+  }
+
+  ImportCache &cache = get_import_cache();
+  const ImportCacheKey key{path, options};
+  {
+    std::lock_guard lock{cache.mutex};
+    if (ImportCacheItem *item = cache.items.lookup_ptr(key)) {
+      if (item->file_mtime == int64_t(stat.st_mtime) && item->file_size == int64_t(stat.st_size))
+      {
+        item->last_use = ++cache.use_counter;
+        return item->result;
+      }
+      cache.remove(key);
+    }
+  }
+
+  /* Import without holding the lock, so that different files can be imported in parallel. */
+  ImportFileResult result = import_fn();
+
+  const int64_t memory = geometry_memory_estimate(result.geometry);
+  if (memory > import_cache_memory_budget) {
+    return result;
+  }
+
+  std::lock_guard lock{cache.mutex};
+  if (cache.items.contains(key)) {
+    /* The same file was imported by another thread in the meantime. */
+    cache.remove(key);
+  }
+  while (!cache.items.is_empty() && cache.memory + memory > import_cache_memory_budget) {
+    cache.remove_least_recently_used();
+  }
+  cache.items.add_new(key,
+                      {int64_t(stat.st_mtime),
+                       int64_t(stat.st_size),
+                       result,
+                       memory,
+                       ++cache.use_counter});
+  cache.memory += memory;
+  return result;
+}
+
+void import_reports_to_warnings(const ReportList &reports, ImportFileResult &result)
+{
+  LISTBASE_FOREACH (const Report *, report, &reports.list) {
+    const NodeWarningType type = report->type == RPT_ERROR ? NodeWarningType::Error :
+                                                             NodeWarningType::Info;
+    result.warnings.append({type, TIP_(report->message)});
+  }
+}
+
+}  // namespace blender::nodes
@@ -17,6 +17,7 @@
 #include "node_util.hh"
 
 struct BVHTreeFromMesh;
+struct ReportList;
 struct GeometrySet;
 namespace blender::nodes {
 class GatherAddNodeSearchParams;
@@ -35,6 +36,23 @@ void search_link_ops_for_tool_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_volume_grid_node(GatherLinkSearchOpParams &params);
 void search_link_ops_for_import_node(GatherLinkSearchOpParams &params);
 
+/** Geometry and warnings of a file that was imported by an import node. */
+struct ImportFileResult {
+  bke::GeometrySet geometry;
+  Vector<std::pair<NodeWarningType, std::string>> warnings;
+};
+
+/**
+ * Return the result of importing the file with the given options earlier when the file did not
+ * change since then, otherwise import it with the callback. Results are kept in a cache that is
+ * shared by all import nodes, so that evaluating a node tree again does not read the same files
+ * again. The cache evicts the least recently used results when it uses too much memory.
+ */
+ImportFileResult import_file_cached(StringRefNull path,
+                                    StringRef options,
+                                    FunctionRef<ImportFileResult()> import_fn);
+void import_reports_to_warnings(const ReportList &reports, ImportFileResult &result);
+
 void get_closest_in_bvhtree(BVHTreeFromMesh &tree_data,
                             const VArray<float3> &positions,
                             const IndexMask &mask,
@@ -35,42 +35,41 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  OBJImportParams import_params;
-  STRNCPY(import_params.filepath, path.c_str());
-
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
-  import_params.reports = &reports;
-
-  Vector<bke::GeometrySet> geometries;
-  OBJ_import_geometries(&import_params, geometries);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
+  const ImportFileResult result = import_file_cached(path, "obj", [&]() {
+    OBJImportParams import_params;
+    STRNCPY(import_params.filepath, path.c_str());
+
+    ReportList reports;
+    BKE_reports_init(&reports, RPT_STORE);
+    BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); });
+    import_params.reports = &reports;
+
+    Vector<bke::GeometrySet> geometries;
+    OBJ_import_geometries(&import_params, geometries);
+
+    ImportFileResult import_result;
+    import_reports_to_warnings(reports, import_result);
+    if (!geometries.is_empty()) {
+      bke::Instances *instances = new bke::Instances();
+      for (GeometrySet geometry : geometries) {
+        const int handle = instances->add_reference(bke::InstanceReference{std::move(geometry)});
+        instances->add_instance(handle, float4x4::identity());
+      }
+      import_result.geometry = GeometrySet::from_instances(instances);
     }
-    params.error_message_add(type, TIP_(report->message));
+    return import_result;
+  });
+
+  for (const auto &[type, message] : result.warnings) {
+    params.error_message_add(type, message);
   }
 
-  if (geometries.is_empty()) {
+  if (!result.geometry.has_instances()) {
     params.set_default_remaining_outputs();
     return;
   }
 
-  bke::Instances *instances = new bke::Instances();
-  for (GeometrySet geometry : geometries) {
-    const int handle = instances->add_reference(bke::InstanceReference{std::move(geometry)});
-    instances->add_instance(handle, float4x4::identity());
-  }
-
-  params.set_output("Instances", GeometrySet::from_instances(instances));
+  params.set_output("Instances", result.geometry);
 #else
   params.error_message_add(NodeWarningType::Error,
                            TIP_("Disabled, Blender was compiled without OBJ I/O"));
@@ -34,37 +34,33 @@ static void node_geo_exec(GeoNodeExecParams params)
     return;
   }
 
-  STLImportParams import_params;
-  STRNCPY(import_params.filepath, path.c_str());
-
-  import_params.forward_axis = IO_AXIS_NEGATIVE_Z;
-  import_params.up_axis = IO_AXIS_Y;
-  import_params.use_facet_normal = false;
-  import_params.use_scene_unit = false;
-  import_params.global_scale = 1.0f;
-  import_params.use_mesh_validate = true;
-
-  ReportList reports;
-  BKE_reports_init(&reports, RPT_STORE);
-  BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
-  import_params.reports = &reports;
-
-  Mesh *mesh = STL_import_mesh(&import_params);
-
-  LISTBASE_FOREACH (Report *, report, &(import_params.reports)->list) {
-    NodeWarningType type;
-    switch (report->type) {
-      case RPT_ERROR:
-        type = NodeWarningType::Error;
-        break;
-      default:
-        type = NodeWarningType::Info;
-        break;
-    }
-    params.error_message_add(type, TIP_(report->message));
+  const ImportFileResult result = import_file_cached(path, "stl", [&]() {
+    STLImportParams import_params;
+    STRNCPY(import_params.filepath, path.c_str());
+
+    import_params.forward_axis = IO_AXIS_NEGATIVE_Z;
+    import_params.up_axis = IO_AXIS_Y;
+    import_params.use_facet_normal = false;
+    import_params.use_scene_unit = false;
+    import_params.global_scale = 1.0f;
+    import_params.use_mesh_validate = true;
+
+    ReportList reports;
+    BKE_reports_init(&reports, RPT_STORE);
+    BLI_SCOPED_DEFER([&]() { BKE_reports_free(&reports); })
+    import_params.reports = &reports;
+
+    ImportFileResult import_result;
+    import_result.geometry = GeometrySet::from_mesh(STL_import_mesh(&import_params));
+    import_reports_to_warnings(reports, import_result);
+    return import_result;
+  });
+
+  for (const auto &[type, message] : result.warnings) {
+    params.error_message_add(type, message);
   }
 
-  params.set_output("Mesh", GeometrySet::from_mesh(mesh));
+  params.set_output("Mesh", result.geometry);
 
 #else
   params.error_message_add(NodeWarningType::Error,
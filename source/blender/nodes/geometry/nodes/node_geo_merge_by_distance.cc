@@ -46,6 +46,7 @@ static PointCloud *pointcloud_merge_by_distance(
     const PointCloud &src_points,
     const float merge_distance,
     const Field<bool> &selection_field,
+    const geometry::MergeByDistanceMethod method,
     const AnonymousAttributePropagationInfo &propagation_info)
 {
   const bke::PointCloudFieldContext context{src_points};
@@ -59,7 +60,7 @@ static PointCloud *pointcloud_merge_by_distance(
   }
 
   return geometry::point_merge_by_distance(
-      src_points, merge_distance, selection, propagation_info);
+      src_points, merge_distance, selection, propagation_info, method);
 }
 
 static std::optional<Mesh *> mesh_merge_by_distance_connected(const Mesh &mesh,
@@ -75,9 +76,11 @@ static std::optional<Mesh *> mesh_merge_by_distance_connected(const Mesh &mesh,
   return geometry::mesh_merge_by_distance_connected(mesh, selection, merge_distance, false);
 }
 
-static std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
-                                                        const float merge_distance,
-                                                        const Field<bool> &selection_field)
+static std::optional<Mesh *> mesh_merge_by_distance_all(
+    const Mesh &mesh,
+    const float merge_distance,
+    const Field<bool> &selection_field,
+    const geometry::MergeByDistanceMethod method)
 {
   const bke::MeshFieldContext context{mesh, AttrDomain::Point};
   FieldEvaluator evaluator{context, mesh.verts_num};
@@ -89,7 +92,7 @@ static std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
     return std::nullopt;
   }
 
-  return geometry::mesh_merge_by_distance_all(mesh, selection, merge_distance);
+  return geometry::mesh_merge_by_distance_all(mesh, selection, merge_distance, method);
 }
 
 static void node_geo_exec(GeoNodeExecParams params)
@@ -101,11 +104,18 @@ static void node_geo_exec(GeoNodeExecParams params)
 
   const Field<bool> selection = params.extract_input<Field<bool>>("Selection");
   const float merge_distance = params.extract_input<float>("Distance");
+  const geometry::MergeByDistanceMethod method = mode == GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID ?
+                                                     geometry::MergeByDistanceMethod::Grid :
+                                                     geometry::MergeByDistanceMethod::KDTree;
 
   geometry_set.modify_geometry_sets([&](GeometrySet &geometry_set) {
     if (const PointCloud *pointcloud = geometry_set.get_pointcloud()) {
       PointCloud *result = pointcloud_merge_by_distance(
-          *pointcloud, merge_distance, selection, params.get_output_propagation_info("Geometry"));
+          *pointcloud,
+          merge_distance,
+          selection,
+          method,
+          params.get_output_propagation_info("Geometry"));
       if (result) {
         geometry_set.replace_pointcloud(result);
       }
@@ -114,7 +124,8 @@ static void node_geo_exec(GeoNodeExecParams params)
       std::optional<Mesh *> result;
       switch (mode) {
         case GEO_NODE_MERGE_BY_DISTANCE_MODE_ALL:
-          result = mesh_merge_by_distance_all(*mesh, merge_distance, selection);
+        case GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID:
+          result = mesh_merge_by_distance_all(*mesh, merge_distance, selection, method);
           break;
         case GEO_NODE_MERGE_BY_DISTANCE_MODE_CONNECTED:
           result = mesh_merge_by_distance_connected(*mesh, merge_distance, selection);
@@ -144,6 +155,12 @@ static void node_rna(StructRNA *srna)
        0,
        "Connected",
        "Only merge mesh vertices along existing edges. This method can be much faster"},
+      {GEO_NODE_MERGE_BY_DISTANCE_MODE_GRID,
+       "GRID",
+       0,
+       "All (Grid)",
+       "Merge all close selected points, searching a grid in parallel. Much faster for large "
+       "inputs, but the merge targets can differ from \"All\""},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
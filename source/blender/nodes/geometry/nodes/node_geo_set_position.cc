@@ -52,6 +52,27 @@ static void set_points_position(bke::MutableAttributeAccessor attributes,
                                      position_field);
 }
 
+static void set_mesh_position(Mesh &mesh,
+                              const Field<bool> &selection_field,
+                              const Field<float3> &position_field)
+{
+  const bke::MeshFieldContext context(mesh, bke::AttrDomain::Point);
+  fn::FieldEvaluator evaluator(context, mesh.verts_num);
+  evaluator.set_selection(selection_field);
+  /* Use a temporary array because the position field may depend on the original positions. */
+  Array<float3> result(mesh.verts_num);
+  evaluator.add_with_destination(position_field, result.as_mutable_span());
+  evaluator.evaluate();
+
+  const IndexMask selection = evaluator.get_evaluated_selection_as_mask();
+  if (selection.is_empty()) {
+    return;
+  }
+  array_utils::copy(result.as_span(), selection, mesh.vert_positions_for_write());
+  /* Passing the selection allows updating cached normals only around the moved vertices. */
+  mesh.tag_positions_changed(selection);
+}
+
 static void set_curves_position(bke::CurvesGeometry &curves,
                                 const fn::FieldContext &field_context,
                                 const Field<bool> &selection_field,
@@ -117,20 +138,43 @@ static void set_instances_position(bke::Instances &instances,
                           [&](const int i) { transforms[i].location() = result[i]; });
 }
 
+static bool is_constant_zero(const Field<float3> &field)
+{
+  if (field.node().depends_on_input()) {
+    return false;
+  }
+  return math::is_zero(fn::evaluate_constant_field(field));
+}
+
+static bool is_position_input(const Field<float3> &field)
+{
+  if (const auto *attribute_input = dynamic_cast<const bke::AttributeFieldInput *>(&field.node()))
+  {
+    return attribute_input->attribute_name() == "position";
+  }
+  return false;
+}
+
 static void node_geo_exec(GeoNodeExecParams params)
 {
   GeometrySet geometry = params.extract_input<GeometrySet>("Geometry");
   const Field<bool> selection_field = params.extract_input<Field<bool>>("Selection");
-  const fn::Field<float3> position_field(
-      fn::FieldOperation::Create(get_add_fn(),
-                                 {params.extract_input<Field<float3>>("Position"),
-                                  params.extract_input<Field<float3>>("Offset")}));
+  Field<float3> position_field = params.extract_input<Field<float3>>("Position");
+  const Field<float3> offset_field = params.extract_input<Field<float3>>("Offset");
+
+  /* Often only one of the inputs is used. Avoid evaluating the addition for every element then,
+   * or even making the geometry mutable when the positions would not change at all. */
+  if (!is_constant_zero(offset_field)) {
+    position_field = Field<float3>(
+        fn::FieldOperation::Create(get_add_fn(), {std::move(position_field), offset_field}));
+  }
+  else if (is_position_input(position_field)) {
+    params.set_output("Geometry", std::move(geometry));
+    return;
+  }
 
   if (Mesh *mesh = geometry.get_mesh_for_write()) {
-    set_points_position(mesh->attributes_for_write(),
-                        bke::MeshFieldContext(*mesh, bke::AttrDomain::Point),
-                        selection_field,
-                        position_field);
+    set_mesh_position(*mesh, selection_field, position_field);
   }
   if (PointCloud *point_cloud = geometry.get_pointcloud_for_write()) {
     set_points_position(point_cloud->attributes_for_write(),
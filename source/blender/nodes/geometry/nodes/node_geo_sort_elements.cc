@@ -62,7 +62,15 @@ static void grouped_sort(const OffsetIndices<int> offsets,
   threading::parallel_for(offsets.index_range(), 250, [&](const IndexRange range) {
     for (const int group_index : range) {
       MutableSpan<int> group = indices.slice(offsets[group_index]);
-      parallel_sort(group.begin(), group.end(), comparator);
+      if (group.size() < 4096) {
+        std::sort(group.begin(), group.end(), comparator);
+        continue;
+      }
+      /* The indices in a group are sorted already, so a stable sort by weight gives the same
+       * result as the comparator. */
+      Array<float> group_weights(group.size());
+      array_utils::gather(weights, group.as_span(), group_weights.as_mutable_span());
+      parallel_radix_sort_by_key(group_weights.as_mutable_span(), group);
     }
   });
 }
@@ -110,9 +118,8 @@ static int identifiers_to_indices(MutableSpan<int> r_identifiers_to_indices)
 
   Array<int> indices(deduplicated_identifiers.size());
   array_utils::fill_index_range<int>(indices);
-  parallel_sort(indices.begin(), indices.end(), [&](const int index_a, const int index_b) {
-    return deduplicated_identifiers[index_a] < deduplicated_identifiers[index_b];
-  });
+  Array<int> sorted_identifiers(deduplicated_identifiers.as_span());
+  parallel_radix_sort_by_key(sorted_identifiers.as_mutable_span(), indices.as_mutable_span());
   Array<int> permutation = invert_permutation(indices);
   parallel_transform(
       r_identifiers_to_indices, 4096, [&](const int index) { return permutation[index]; });
@@ -179,6 +179,7 @@ static void node_register()
   ntype.declare = node_declare;
   ntype.initfunc = geo_triangulate_init;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.cache_results = true;
   ntype.draw_buttons = node_layout;
   blender::bke::nodeRegisterType(&ntype);
 
@@ -22,9 +22,11 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_result_cache.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
+#include "BLI_arena_allocator.hh"
 #include "BLI_array_utils.hh"
 #include "BLI_bit_group_vector.hh"
 #include "BLI_bit_span_ops.hh"
@@ -317,22 +319,41 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return;
     }
 
-    GeoNodeExecParams geo_params{
-        node_,
-        params,
-        context,
-        own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
-        own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
-        get_output_attribute_id};
+    auto execute_node = [&](lf::Params &node_params) {
+      ArenaScope::Activation arena_activation(user_data->call_data->arena);
+      GeoNodeExecParams geo_params{
+          node_,
+          node_params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_attribute_propagation_to_output,
+          get_output_attribute_id};
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
 
+    size_t allocated_bytes_start, allocations_num_start;
+    MEM_get_thread_allocation_totals(&allocated_bytes_start, &allocations_num_start);
     geo_eval_log::TimePoint start_time = geo_eval_log::Clock::now();
-    node_.typeinfo->geometry_node_execute(geo_params);
+    if (user_data->call_data->result_cache && node_.typeinfo->cache_results) {
+      user_data->call_data->result_cache->execute(
+          node_, user_data->compute_context->hash(), params, execute_node);
+    }
+    else {
+      execute_node(params);
+    }
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
+    size_t allocated_bytes_end, allocations_num_end;
+    MEM_get_thread_allocation_totals(&allocated_bytes_end, &allocations_num_end);
 
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(*user_data))
     {
-      tree_logger->node_execution_times.append(*tree_logger->allocator,
-                                               {node_.identifier, start_time, end_time});
+      tree_logger->node_execution_times.append(
+          *tree_logger->allocator,
+          {node_.identifier,
+           start_time,
+           end_time,
+           int64_t(allocated_bytes_end - allocated_bytes_start),
+           int64_t(allocations_num_end - allocations_num_start)});
     }
   }
 
@@ -2,9 +2,14 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <fmt/format.h>
+#include <sstream>
+
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_geometry_nodes_log.hh"
 
+#include "BLI_serialize.hh"
+
 #include "BKE_compute_contexts.hh"
 #include "BKE_curves.hh"
 #include "BKE_geometry_nodes_gizmos_transforms.hh"
@@ -300,8 +305,17 @@ void GeoTreeLog::ensure_node_run_time()
   for (GeoTreeLogger *tree_logger : tree_loggers_) {
     for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
       const std::chrono::nanoseconds duration = timings.end - timings.start;
-      this->nodes.lookup_or_add_default_as(timings.node_id).run_time += duration;
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(timings.node_id);
+      node_log.run_time += duration;
+      node_log.allocated_bytes += timings.allocated_bytes;
+      node_log.allocations_num += timings.allocations_num;
       this->run_time_sum += duration;
+      this->allocated_bytes_sum += timings.allocated_bytes;
+      this->allocations_num_sum += timings.allocations_num;
+    }
+    for (const GeoTreeLogger::NodeOutputElements &output : tree_logger->node_output_elements) {
+      this->nodes.lookup_or_add_default_as(output.node_id).output_elements_num +=
+          output.elements_num;
     }
   }
   for (const ComputeContextHash &child_hash : children_hashes_) {
@@ -312,9 +326,14 @@ void GeoTreeLog::ensure_node_run_time()
     child_log.ensure_node_run_time();
     const std::optional<int32_t> &parent_node_id = child_log.tree_loggers_[0]->parent_node_id;
     if (parent_node_id.has_value()) {
-      this->nodes.lookup_or_add_default(*parent_node_id).run_time += child_log.run_time_sum;
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default(*parent_node_id);
+      node_log.run_time += child_log.run_time_sum;
+      node_log.allocated_bytes += child_log.allocated_bytes_sum;
+      node_log.allocations_num += child_log.allocations_num_sum;
     }
     this->run_time_sum += child_log.run_time_sum;
+    this->allocated_bytes_sum += child_log.allocated_bytes_sum;
+    this->allocations_num_sum += child_log.allocations_num_sum;
   }
   reduced_node_run_times_ = true;
 }
@@ -561,6 +580,7 @@ GeoTreeLogger &GeoModifierLog::get_local_tree_logger(const ComputeContext &compu
                dynamic_cast<const bke::RepeatZoneComputeContext *>(&compute_context))
   {
     tree_logger.parent_node_id.emplace(node_group_compute_context->output_node_id());
+    tree_logger.zone_iteration.emplace(node_group_compute_context->iteration());
   }
   else if (const bke::SimulationZoneComputeContext *node_group_compute_context =
                dynamic_cast<const bke::SimulationZoneComputeContext *>(&compute_context))
@@ -586,6 +606,80 @@ GeoTreeLog &GeoModifierLog::get_tree_log(const ComputeContextHash &compute_conte
   return reduced_tree_log;
 }
 
+std::string GeoModifierLog::profile_report_json(const bNodeTree &tree,
+                                                const ComputeContext &compute_context)
+{
+  io::serialize::DictionaryValue report;
+  report.append_str("name", tree.id.name + 2);
+  this->append_profile_report(this->get_tree_log(compute_context.hash()), tree, report);
+
+  std::stringstream stream;
+  io::serialize::JsonFormatter formatter;
+  formatter.serialize(stream, report);
+  return stream.str();
+}
+
+void GeoModifierLog::append_profile_report(GeoTreeLog &tree_log,
+                                           const bNodeTree &tree,
+                                           io::serialize::DictionaryValue &r_entry)
+{
+  using namespace io::serialize;
+  tree_log.ensure_node_run_time();
+  r_entry.append_int("value", tree_log.run_time_sum.count());
+  r_entry.append_int("allocated_bytes", tree_log.allocated_bytes_sum);
+  r_entry.append_int("allocations", tree_log.allocations_num_sum);
+  ArrayValue &children = *r_entry.append_array("children");
+
+  /* Nested node groups and zones are logged in separate compute contexts. */
+  MultiValueMap<int32_t, GeoTreeLog *> child_logs_by_node_id;
+  for (const ComputeContextHash &child_hash : tree_log.children_hashes_) {
+    GeoTreeLog &child_log = this->get_tree_log(child_hash);
+    if (child_log.tree_loggers_.is_empty()) {
+      continue;
+    }
+    if (const std::optional<int32_t> &node_id = child_log.tree_loggers_[0]->parent_node_id) {
+      child_logs_by_node_id.add(*node_id, &child_log);
+    }
+  }
+
+  for (const bNode *node : tree.all_nodes()) {
+    const GeoNodeLog *node_log = tree_log.nodes.lookup_ptr(node->identifier);
+    if (node_log == nullptr || node_log->run_time.count() == 0) {
+      continue;
+    }
+    DictionaryValue &node_entry = *children.append_dict();
+    node_entry.append_str("name", node->label_or_name());
+    node_entry.append_int("value", node_log->run_time.count());
+    node_entry.append_int("allocated_bytes", node_log->allocated_bytes);
+    node_entry.append_int("allocations", node_log->allocations_num);
+    node_entry.append_int("output_elements", node_log->output_elements_num);
+
+    const Span<GeoTreeLog *> child_logs = child_logs_by_node_id.lookup(node->identifier);
+    if (child_logs.is_empty()) {
+      continue;
+    }
+    /* Zones are evaluated in a separate compute context, but their nodes are in the same tree. */
+    const bNodeTree *child_tree = node->is_group() ?
+                                      reinterpret_cast<const bNodeTree *>(node->id) :
+                                      &tree;
+    if (child_tree == nullptr) {
+      continue;
+    }
+    ArrayValue &node_children = *node_entry.append_array("children");
+    for (GeoTreeLog *child_log : child_logs) {
+      DictionaryValue &child_entry = *node_children.append_dict();
+      if (const std::optional<int> &iteration = child_log->tree_loggers_[0]->zone_iteration) {
+        child_entry.append_str("name", fmt::format("Iteration {}", *iteration));
+        child_entry.append_int("iteration", *iteration);
+      }
+      else {
+        child_entry.append_str("name", child_tree->id.name + 2);
+      }
+      this->append_profile_report(*child_log, *child_tree, child_entry);
+    }
+  }
+}
+
 static void find_tree_zone_hash_recursive(
     const bNodeTreeZone &zone,
     ComputeContextBuilder &compute_context_builder,
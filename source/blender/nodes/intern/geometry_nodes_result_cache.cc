@@ -0,0 +1,548 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "NOD_geometry_nodes_result_cache.hh"
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_listbase.h"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_anonymous_attribute_id.hh"
+#include "BKE_curves.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_mesh_types.hh"
+#include "BKE_node.hh"
+#include "BKE_node_socket_value.hh"
+
+#include "FN_field.hh"
+
+struct Collection;
+struct Image;
+struct Material;
+struct Tex;
+
+namespace blender::nodes {
+
+using bke::GeometryComponent;
+using bke::GeometrySet;
+using bke::SocketValueVariant;
+
+/**
+ * Identifies the state of a geometry without storing its data. Arrays are identified by their
+ * #ImplicitSharingInfo, which is kept alive with a weak user, so that its pointer can not be
+ * reused for other data.
+ */
+class GeometryFingerprint : NonCopyable {
+ private:
+  struct SharedArray {
+    const ImplicitSharingInfo *sharing_info;
+    const void *data;
+    int64_t version;
+  };
+
+  Vector<int64_t> values_;
+  Vector<std::string> names_;
+  Vector<SharedArray> arrays_;
+
+ public:
+  GeometryFingerprint() = default;
+
+  GeometryFingerprint(GeometryFingerprint &&other) = default;
+
+  ~GeometryFingerprint()
+  {
+    for (const SharedArray &array : arrays_) {
+      array.sharing_info->remove_weak_user_and_delete_if_last();
+    }
+  }
+
+  /** \return False if the geometry contains data that can't be identified cheaply. */
+  [[nodiscard]] bool build(const GeometrySet &geometry)
+  {
+    names_.append(geometry.name);
+    for (const GeometryComponent *component : geometry.get_components()) {
+      values_.append(int64_t(component->type()));
+      switch (component->type()) {
+        case GeometryComponent::Type::Mesh: {
+          if (!this->add_mesh(*geometry.get_mesh())) {
+            return false;
+          }
+          break;
+        }
+        case GeometryComponent::Type::PointCloud: {
+          if (!this->add_pointcloud(*geometry.get_pointcloud())) {
+            return false;
+          }
+          break;
+        }
+        case GeometryComponent::Type::Curve: {
+          if (!this->add_curves(*geometry.get_curves())) {
+            return false;
+          }
+          break;
+        }
+        default: {
+          /* Instances, volumes, grease pencil and edit data reference data that is not implicitly
+           * shared. */
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool operator==(const GeometryFingerprint &other) const
+  {
+    if (values_ != other.values_ || names_ != other.names_) {
+      return false;
+    }
+    if (arrays_.size() != other.arrays_.size()) {
+      return false;
+    }
+    for (const int i : arrays_.index_range()) {
+      const SharedArray &a = arrays_[i];
+      const SharedArray &b = other.arrays_[i];
+      if (a.sharing_info != b.sharing_info || a.data != b.data) {
+        return false;
+      }
+      if (a.sharing_info->is_expired() || a.sharing_info->version() != b.version ||
+          a.version != b.version)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  [[nodiscard]] bool add_array(const ImplicitSharingInfo *sharing_info, const void *data)
+  {
+    if (data == nullptr) {
+      values_.append(0);
+      return true;
+    }
+    if (sharing_info == nullptr) {
+      return false;
+    }
+    sharing_info->add_weak_user();
+    arrays_.append({sharing_info, data, sharing_info->version()});
+    values_.append(1);
+    return true;
+  }
+
+  [[nodiscard]] bool add_custom_data(const CustomData &data)
+  {
+    values_.append(data.totlayer);
+    for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+      values_.append(layer.type);
+      values_.append(layer.flag);
+      names_.append(layer.name);
+      if (!this->add_array(layer.sharing_info, layer.data)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void add_materials(Material *const *materials, const int materials_num)
+  {
+    values_.append(materials_num);
+    for (const int i : IndexRange(materials_num)) {
+      values_.append(int64_t(uintptr_t(materials[i])));
+    }
+  }
+
+  void add_vertex_group_names(const ListBase &vertex_group_names)
+  {
+    values_.append(BLI_listbase_count(&vertex_group_names));
+    LISTBASE_FOREACH (const bDeformGroup *, group, &vertex_group_names) {
+      names_.append(group->name);
+    }
+  }
+
+  [[nodiscard]] bool add_mesh(const Mesh &mesh)
+  {
+    if (mesh.runtime->wrapper_type != ME_WRAPPER_TYPE_MDATA) {
+      return false;
+    }
+    values_.extend({mesh.verts_num, mesh.edges_num, mesh.faces_num, mesh.corners_num, mesh.flag});
+    this->add_materials(mesh.mat, mesh.totcol);
+    this->add_vertex_group_names(mesh.vertex_group_names);
+    if (!this->add_array(mesh.runtime->face_offsets_sharing_info, mesh.face_offset_indices)) {
+      return false;
+    }
+    return this->add_custom_data(mesh.vert_data) && this->add_custom_data(mesh.edge_data) &&
+           this->add_custom_data(mesh.face_data) && this->add_custom_data(mesh.corner_data);
+  }
+
+  [[nodiscard]] bool add_pointcloud(const PointCloud &pointcloud)
+  {
+    values_.extend({pointcloud.totpoint, pointcloud.flag});
+    this->add_materials(pointcloud.mat, pointcloud.totcol);
+    return this->add_custom_data(pointcloud.pdata);
+  }
+
+  [[nodiscard]] bool add_curves(const Curves &curves_id)
+  {
+    const bke::CurvesGeometry &curves = curves_id.geometry.wrap();
+    values_.extend({curves.points_num(), curves.curves_num(), curves_id.flag});
+    this->add_materials(curves_id.mat, curves_id.totcol);
+    this->add_vertex_group_names(curves.vertex_group_names);
+    if (!this->add_array(curves.runtime->curve_offsets_sharing_info, curves.curve_offsets)) {
+      return false;
+    }
+    return this->add_custom_data(curves.point_data) && this->add_custom_data(curves.curve_data);
+  }
+};
+
+static bool is_id_pointer_type(const CPPType &type)
+{
+  /* The referenced data-blocks can change without the pointer changing. */
+  return type.is<Object *>() || type.is<Collection *>() || type.is<Tex *>() ||
+         type.is<Image *>() || type.is<Material *>();
+}
+
+/**
+ * Copy of a socket value that can be compared with the values passed into the node in later
+ * evaluations.
+ */
+static std::optional<SocketValueVariant> socket_value_fingerprint(const SocketValueVariant &value)
+{
+  if (value.is_volume_grid()) {
+    return std::nullopt;
+  }
+  if (value.is_context_dependent_field()) {
+    return value;
+  }
+  SocketValueVariant single_value = value;
+  single_value.convert_to_single();
+  const CPPType &type = *single_value.get_single_ptr().type();
+  if (is_id_pointer_type(type)) {
+    return std::nullopt;
+  }
+  return single_value;
+}
+
+static bool socket_values_equal(const SocketValueVariant &a, const SocketValueVariant &b)
+{
+  if (a.is_context_dependent_field() || b.is_context_dependent_field()) {
+    if (!a.is_context_dependent_field() || !b.is_context_dependent_field()) {
+      return false;
+    }
+    return a.get<fn::GField>() == b.get<fn::GField>();
+  }
+  const GPointer a_ptr = a.get_single_ptr();
+  const GPointer b_ptr = b.get_single_ptr();
+  if (a_ptr.type() != b_ptr.type()) {
+    return false;
+  }
+  return a_ptr.type()->is_equal_or_false(a_ptr.get(), b_ptr.get());
+}
+
+static bool attribute_sets_equal(const bke::AnonymousAttributeSet &a,
+                                 const bke::AnonymousAttributeSet &b)
+{
+  if (!a.names || !b.names) {
+    return !a.names && !b.names;
+  }
+  return *a.names == *b.names;
+}
+
+/** Fingerprint of a single input of the lazy-function. */
+struct InputFingerprint {
+  std::optional<SocketValueVariant> socket_value;
+  Vector<SocketValueVariant> socket_values;
+  Vector<GeometryFingerprint> geometries;
+  std::optional<bool> boolean;
+  std::optional<bke::AnonymousAttributeSet> attribute_set;
+
+  bool operator==(const InputFingerprint &other) const
+  {
+    if (socket_value.has_value() != other.socket_value.has_value()) {
+      return false;
+    }
+    if (socket_value && !socket_values_equal(*socket_value, *other.socket_value)) {
+      return false;
+    }
+    if (socket_values.size() != other.socket_values.size()) {
+      return false;
+    }
+    for (const int i : socket_values.index_range()) {
+      if (!socket_values_equal(socket_values[i], other.socket_values[i])) {
+        return false;
+      }
+    }
+    if (geometries != other.geometries || boolean != other.boolean) {
+      return false;
+    }
+    if (attribute_set.has_value() != other.attribute_set.has_value()) {
+      return false;
+    }
+    return !attribute_set || attribute_sets_equal(*attribute_set, *other.attribute_set);
+  }
+};
+
+static std::optional<InputFingerprint> input_fingerprint(const CPPType &type, const void *value)
+{
+  InputFingerprint fingerprint;
+  if (type.is<GeometrySet>()) {
+    fingerprint.geometries.append_as();
+    if (!fingerprint.geometries.last().build(*static_cast<const GeometrySet *>(value))) {
+      return std::nullopt;
+    }
+  }
+  else if (type.is<Vector<GeometrySet>>()) {
+    for (const GeometrySet &geometry_set : *static_cast<const Vector<GeometrySet> *>(value)) {
+      fingerprint.geometries.append_as();
+      if (!fingerprint.geometries.last().build(geometry_set)) {
+        return std::nullopt;
+      }
+    }
+  }
+  else if (type.is<SocketValueVariant>()) {
+    fingerprint.socket_value = socket_value_fingerprint(
+        *static_cast<const SocketValueVariant *>(value));
+    if (!fingerprint.socket_value) {
+      return std::nullopt;
+    }
+  }
+  else if (type.is<Vector<SocketValueVariant>>()) {
+    for (const SocketValueVariant &item : *static_cast<const Vector<SocketValueVariant> *>(value))
+    {
+      std::optional<SocketValueVariant> item_fingerprint = socket_value_fingerprint(item);
+      if (!item_fingerprint) {
+        return std::nullopt;
+      }
+      fingerprint.socket_values.append(std::move(*item_fingerprint));
+    }
+  }
+  else if (type.is<bool>()) {
+    fingerprint.boolean = *static_cast<const bool *>(value);
+  }
+  else if (type.is<bke::AnonymousAttributeSet>()) {
+    fingerprint.attribute_set = *static_cast<const bke::AnonymousAttributeSet *>(value);
+  }
+  else {
+    return std::nullopt;
+  }
+  return fingerprint;
+}
+
+struct GeoNodesResultCache::Entry {
+  /** Settings of the node that are not passed in as inputs. */
+  const bke::bNodeType *typeinfo;
+  std::array<float, 4> custom;
+  Vector<char> storage;
+
+  Vector<InputFingerprint> inputs;
+  /**
+   * Copies of the values output by the node. This only contains values for outputs that were
+   * used in the evaluation that created the entry.
+   */
+  Vector<std::unique_ptr<void, void (*)(void *)>> outputs;
+  Vector<const CPPType *> output_types;
+
+  /** True when the entry was used since the last call to #remove_unused. */
+  bool used = true;
+
+  Entry() = default;
+  Entry(const Entry &other) = delete;
+
+  ~Entry()
+  {
+    for (const int i : outputs.index_range()) {
+      if (outputs[i]) {
+        output_types[i]->destruct(outputs[i].get());
+      }
+    }
+  }
+
+  bool has_same_inputs(const Entry &other) const
+  {
+    return typeinfo == other.typeinfo && custom == other.custom && storage == other.storage &&
+           inputs == other.inputs;
+  }
+};
+
+/**
+ * Forwards all calls to the params of the caller, but keeps a copy of every output value. A copy is
+ * necessary, because the caller may move the value out of the output once it has been set.
+ */
+class CachingParams : public lf::Params {
+ private:
+  lf::Params &base_params_;
+  GeoNodesResultCache::Entry &entry_;
+  bool multi_threading_enabled_;
+  std::mutex mutex_;
+
+ public:
+  CachingParams(lf::Params &base_params, GeoNodesResultCache::Entry &entry)
+      : lf::Params(base_params.fn_, false),
+        base_params_(base_params),
+        entry_(entry),
+        multi_threading_enabled_(false)
+  {
+  }
+
+  void *try_get_input_data_ptr_impl(const int index) const override
+  {
+    return base_params_.try_get_input_data_ptr(index);
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    return base_params_.try_get_input_data_ptr_or_request(index);
+  }
+
+  void *get_output_data_ptr_impl(const int index) override
+  {
+    return base_params_.get_output_data_ptr(index);
+  }
+
+  void output_set_impl(const int index) override
+  {
+    const CPPType &type = *entry_.output_types[index];
+    void *copy = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+    type.copy_construct(base_params_.get_output_data_ptr(index), copy);
+    {
+      std::lock_guard lock{mutex_};
+      entry_.outputs[index].reset(copy);
+    }
+    base_params_.output_set(index);
+  }
+
+  bool output_was_set_impl(const int index) const override
+  {
+    return base_params_.output_was_set(index);
+  }
+
+  lf::ValueUsage get_output_usage_impl(const int index) const override
+  {
+    return base_params_.get_output_usage(index);
+  }
+
+  void set_input_unused_impl(const int index) override
+  {
+    base_params_.set_input_unused(index);
+  }
+
+  bool try_enable_multi_threading_impl() override
+  {
+    if (multi_threading_enabled_) {
+      return true;
+    }
+    if (base_params_.try_enable_multi_threading()) {
+      multi_threading_enabled_ = true;
+      return true;
+    }
+    return false;
+  }
+};
+
+static void free_output_copy(void *value)
+{
+  MEM_freeN(value);
+}
+
+static std::unique_ptr<GeoNodesResultCache::Entry> create_entry(const bNode &node,
+                                                                lf::Params &params)
+{
+  const lf::LazyFunction &fn = params.fn_;
+  auto entry = std::make_unique<GeoNodesResultCache::Entry>();
+  entry->typeinfo = node.typeinfo;
+  entry->custom = {float(node.custom1), float(node.custom2), node.custom3, node.custom4};
+  if (node.storage) {
+    const char *storage = static_cast<const char *>(node.storage);
+    entry->storage.extend(Span(storage, int64_t(MEM_allocN_len(node.storage))));
+  }
+  for (const int i : fn.inputs().index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    BLI_assert(value != nullptr);
+    std::optional<InputFingerprint> fingerprint = input_fingerprint(*fn.inputs()[i].type, value);
+    if (!fingerprint) {
+      return nullptr;
+    }
+    entry->inputs.append(std::move(*fingerprint));
+  }
+  for (const lf::Output &output : fn.outputs()) {
+    entry->outputs.append({nullptr, free_output_copy});
+    entry->output_types.append(output.type);
+  }
+  return entry;
+}
+
+/** \return True if the entry contains all the outputs that are still required by the caller. */
+static bool entry_has_required_outputs(const GeoNodesResultCache::Entry &entry,
+                                       const lf::Params &params)
+{
+  for (const int i : entry.outputs.index_range()) {
+    if (entry.outputs[i] || params.output_was_set(i)) {
+      continue;
+    }
+    if (params.get_output_usage(i) != lf::ValueUsage::Unused) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GeoNodesResultCache::GeoNodesResultCache() = default;
+GeoNodesResultCache::~GeoNodesResultCache() = default;
+
+void GeoNodesResultCache::execute(const bNode &node,
+                                  const ComputeContextHash &context_hash,
+                                  lf::Params &params,
+                                  const FunctionRef<void(lf::Params &params)> execute_fn)
+{
+  std::unique_ptr<Entry> new_entry = create_entry(node, params);
+  if (!new_entry) {
+    execute_fn(params);
+    return;
+  }
+  const Key key{context_hash, node.identifier};
+  {
+    std::lock_guard lock{mutex_};
+    std::unique_ptr<Entry> *entry = entries_.lookup_ptr(key);
+    if (entry && (*entry)->has_same_inputs(*new_entry) &&
+        entry_has_required_outputs(**entry, params))
+    {
+      for (const int i : (*entry)->outputs.index_range()) {
+        if (!(*entry)->outputs[i] || params.output_was_set(i)) {
+          continue;
+        }
+        const CPPType &type = *(*entry)->output_types[i];
+        type.copy_construct((*entry)->outputs[i].get(), params.get_output_data_ptr(i));
+        params.output_set(i);
+      }
+      (*entry)->used = true;
+      return;
+    }
+  }
+
+  CachingParams caching_params{params, *new_entry};
+  execute_fn(caching_params);
+
+  std::lock_guard lock{mutex_};
+  entries_.add_overwrite(key, std::move(new_entry));
+}
+
+void GeoNodesResultCache::remove_unused()
+{
+  std::lock_guard lock{mutex_};
+  entries_.remove_if([](const auto &item) { return !item.value->used; });
+  for (std::unique_ptr<Entry> &entry : entries_.values()) {
+    entry->used = false;
+  }
+}
+
+}  // namespace blender::nodes
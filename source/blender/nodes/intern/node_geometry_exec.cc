@@ -150,6 +150,21 @@ void GeoNodeExecParams::check_output_geometry_set(const GeometrySet &geometry_se
 #endif
 }
 
+void GeoNodeExecParams::log_output_geometry_set(const GeometrySet &geometry_set) const
+{
+  geo_eval_log::GeoTreeLogger *tree_logger = this->get_local_tree_logger();
+  if (tree_logger == nullptr) {
+    return;
+  }
+  int64_t elements_num = 0;
+  for (const bke::GeometryComponent *component : geometry_set.get_components()) {
+    elements_num += component->attribute_domain_size(AttrDomain::Point);
+    elements_num += component->attribute_domain_size(AttrDomain::Instance);
+  }
+  tree_logger->node_output_elements.append(*tree_logger->allocator,
+                                           {node_.identifier, elements_num});
+}
+
 const bNodeSocket *GeoNodeExecParams::find_available_socket(const StringRef name) const
 {
   for (const bNodeSocket *socket : node_.input_sockets()) {
@@ -339,6 +339,23 @@ class NoiseFunction : public mf::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
+        if (detail.is_single() && roughness.is_single() && lacunarity.is_single() &&
+            offset.is_single() && gain.is_single() && distortion.is_single())
+        {
+          /* Common case of noise that only varies with the position, evaluate it in batches. */
+          this->call_3d_batched(mask,
+                                vector,
+                                scale,
+                                math::clamp(detail.get_internal_single(), 0.0f, 15.0f),
+                                math::max(roughness.get_internal_single(), 0.0f),
+                                lacunarity.get_internal_single(),
+                                offset.get_internal_single(),
+                                gain.get_internal_single(),
+                                distortion.get_internal_single(),
+                                r_factor,
+                                r_color);
+          break;
+        }
         if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position = vector[i] * scale[i];
@@ -415,6 +432,59 @@ class NoiseFunction : public mf::MultiFunction {
     }
   }
 
+  void call_3d_batched(const IndexMask &mask,
+                       const VArray<float3> &vector,
+                       const VArray<float> &scale,
+                       const float detail,
+                       const float roughness,
+                       const float lacunarity,
+                       const float offset,
+                       const float gain,
+                       const float distortion,
+                       MutableSpan<float> r_factor,
+                       MutableSpan<ColorGeometry4f> r_color) const
+  {
+    mask.foreach_segment([&](const IndexMaskSegment segment) {
+      Array<float3> positions(segment.size());
+      for (const int64_t i : segment.index_range()) {
+        positions[i] = vector[segment[i]] * scale[segment[i]];
+      }
+      if (!r_factor.is_empty()) {
+        Array<float> factors(segment.size());
+        noise::perlin_fractal_distorted(positions,
+                                        detail,
+                                        roughness,
+                                        lacunarity,
+                                        offset,
+                                        gain,
+                                        distortion,
+                                        type_,
+                                        normalize_,
+                                        factors);
+        for (const int64_t i : segment.index_range()) {
+          r_factor[segment[i]] = factors[i];
+        }
+      }
+      if (!r_color.is_empty()) {
+        Array<float3> colors(segment.size());
+        noise::perlin_float3_fractal_distorted(positions,
+                                               detail,
+                                               roughness,
+                                               lacunarity,
+                                               offset,
+                                               gain,
+                                               distortion,
+                                               type_,
+                                               normalize_,
+                                               colors);
+        for (const int64_t i : segment.index_range()) {
+          const float3 &c = colors[i];
+          r_color[segment[i]] = ColorGeometry4f(c[0], c[1], c[2], 1.0f);
+        }
+      }
+    });
+  }
+
   ExecutionHints get_execution_hints() const override
   {
     ExecutionHints hints;
@@ -428,6 +428,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_doc,
      (void *)G_DEBUG_HANDLERS},
     {"debug_wm", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_WM},
+    {"debug_wm_time",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_WM_TIME},
     {"debug_depsgraph",
      bpy_app_debug_get,
      bpy_app_debug_set,
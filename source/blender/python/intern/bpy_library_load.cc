@@ -34,6 +34,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BPY_extern.h"
+
 #include "bpy_capi_utils.h"
 #include "bpy_library.h"
 
@@ -313,7 +315,10 @@ static PyObject *bpy_lib_enter(BPy_Library *self)
   memset(bf_reports, 0, sizeof(*bf_reports));
   bf_reports->reports = reports;
 
+  /* Reading the file doesn't access any Python data, let other threads run meanwhile. */
+  BPy_BEGIN_ALLOW_THREADS;
   self->blo_handle = BLO_blendhandle_from_file(self->abspath, bf_reports);
+  BPy_END_ALLOW_THREADS;
 
   if (self->blo_handle == nullptr) {
     if (BPy_reports_to_error(reports, PyExc_IOError, true) != -1) {
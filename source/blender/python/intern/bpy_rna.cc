@@ -5533,6 +5533,78 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return false;
 }
 
+/**
+ * Get the raw type of the values in a buffer, to convert them directly when its type doesn't match
+ * the property. Returns #PROP_RAW_UNSET when the buffer format isn't supported.
+ */
+static RawPropertyType foreach_buffer_raw_type(const Py_buffer &buf)
+{
+  const char *format = buf.format ? buf.format : "B";
+  if (*format == '@') {
+    format++;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return PROP_RAW_UNSET;
+  }
+
+  RawPropertyType raw_type = PROP_RAW_UNSET;
+  switch (*format) {
+    case 'b':
+      raw_type = PROP_RAW_INT8;
+      break;
+    case 'B':
+      raw_type = PROP_RAW_UINT8;
+      break;
+    case 'h':
+      raw_type = PROP_RAW_SHORT;
+      break;
+    case 'H':
+      raw_type = PROP_RAW_UINT16;
+      break;
+    case '?':
+      raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      raw_type = PROP_RAW_DOUBLE;
+      break;
+    case 'i':
+    case 'l':
+    case 'q':
+      raw_type = buf.itemsize == sizeof(int) ? PROP_RAW_INT : PROP_RAW_INT64;
+      break;
+    case 'L':
+    case 'Q':
+      raw_type = PROP_RAW_UINT64;
+      break;
+  }
+  if (raw_type == PROP_RAW_UNSET || RNA_raw_type_sizeof(raw_type) != size_t(buf.itemsize)) {
+    return PROP_RAW_UNSET;
+  }
+  return raw_type;
+}
+
+/**
+ * Access the buffer directly when its values can be converted to the type of the property, such
+ * as NumPy arrays of doubles for float properties. For setting, only floating point properties
+ * are supported, converting to integers would silently truncate values which raise an error when
+ * accessed as a sequence.
+ */
+static bool foreach_buffer_is_convertible(const RawPropertyType raw_type,
+                                          const Py_buffer &buf,
+                                          const int tot,
+                                          const bool set,
+                                          RawPropertyType *r_buffer_raw_type)
+{
+  if (set && !ELEM(raw_type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE)) {
+    return false;
+  }
+  *r_buffer_raw_type = foreach_buffer_raw_type(buf);
+  return *r_buffer_raw_type != PROP_RAW_UNSET && buf.len == Py_ssize_t(tot) * buf.itemsize;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = nullptr;
@@ -5580,10 +5652,16 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 
         buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
+        RawPropertyType buffer_raw_type;
         if (buffer_is_compat) {
           ok = RNA_property_collection_raw_set(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else if (foreach_buffer_is_convertible(raw_type, buf, tot, true, &buffer_raw_type)) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_set(
+              nullptr, &self->ptr, self->prop, attr, buf.buf, buffer_raw_type, tot);
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -5656,10 +5734,16 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 
         buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
 
+        RawPropertyType buffer_raw_type;
         if (buffer_is_compat) {
           ok = RNA_property_collection_raw_get(
               nullptr, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
         }
+        else if (foreach_buffer_is_convertible(raw_type, buf, tot, false, &buffer_raw_type)) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_get(
+              nullptr, &self->ptr, self->prop, attr, buf.buf, buffer_raw_type, tot);
+        }
 
         PyBuffer_Release(&buf);
       }
@@ -81,6 +81,13 @@ bool RE_bake_engine(struct Render *re,
                     int pass_filter,
                     float result[]);
 
+/**
+ * Free the engine that #RE_bake_engine keeps between calls, before freeing the depsgraph it baked.
+ * Baking several objects with the same depsgraph reuses the engine, so it only has to synchronize
+ * the scene once.
+ */
+void RE_bake_engine_free(struct Render *re, struct Depsgraph *depsgraph);
+
 /* `bake.cc` */
 
 int RE_pass_depth(eScenePassType pass_type);
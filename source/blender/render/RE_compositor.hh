@@ -28,8 +28,10 @@ namespace blender::render {
 class RealtimeCompositor;
 }
 
-/* Execute compositor. */
-void RE_compositor_execute(Render &render,
+/* Execute compositor. Returns false if the render can't be composited on the GPU, for instance
+ * because it is larger than the maximum texture size, in which case the CPU compositor should be
+ * used instead. */
+bool RE_compositor_execute(Render &render,
                            const Scene &scene,
                            const RenderData &render_data,
                            const bNodeTree &node_tree,
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <string>
 
+#include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
@@ -36,6 +37,7 @@
 
 #include "WM_api.hh"
 
+#include "GPU_capabilities.hh"
 #include "GPU_context.hh"
 
 #include "render_types.h"
@@ -332,7 +334,7 @@ class Context : public realtime_compositor::Context {
     return input_data_.view_name;
   }
 
-  realtime_compositor::ResultPrecision get_precision() const override
+  realtime_compositor::ResultPrecision get_requested_precision() const override
   {
     switch (input_data_.scene->r.compositor_precision) {
       case SCE_COMPOSITOR_PRECISION_AUTO:
@@ -449,6 +451,16 @@ class Context : public realtime_compositor::Context {
     RE_ReleaseResult(render);
   }
 
+  /* Release the references to the input textures, which are acquired again in the next
+   * evaluation. This avoids keeping render pass textures of previous renders alive. */
+  void release_input_textures()
+  {
+    for (GPUTexture *texture : textures_) {
+      GPU_texture_free(texture);
+    }
+    textures_.clear();
+  }
+
   void output_to_render_result()
   {
     if (!output_texture_) {
@@ -602,8 +614,9 @@ class RealtimeCompositor {
     }
   }
 
-  /* Evaluate the compositor and output to the scene render result. */
-  void execute(const ContextInputData &input_data)
+  /* Evaluate the compositor and output to the scene render result. Returns false if the render
+   * is too large to be composited on the GPU. */
+  bool execute(const ContextInputData &input_data)
   {
     /* For main thread rendering in background mode, blocking rendering, or when we do not have a
      * render system GPU context, use the DRW context directly, while for threaded rendering when
@@ -625,16 +638,24 @@ class RealtimeCompositor {
 
     context_->update_input_data(input_data);
 
-    /* Always recreate the evaluator, as this only runs on compositing node changes and
-     * there is no reason to cache this. Unlike the viewport where it helps for navigation. */
-    {
-      realtime_compositor::Evaluator evaluator(*context_);
-      evaluator.evaluate();
-    }
+    /* The output and intermediate results are textures of the render size, which can't be
+     * allocated if it is larger than the maximum texture size. */
+    const int2 render_size = context_->get_render_size();
+    const bool is_supported_size = math::reduce_max(render_size) <= GPU_max_texture_size();
+
+    if (is_supported_size) {
+      /* Always recreate the evaluator, as this only runs on compositing node changes and
+       * there is no reason to cache this. Unlike the viewport where it helps for navigation. */
+      {
+        realtime_compositor::Evaluator evaluator(*context_);
+        evaluator.evaluate();
+      }
 
-    context_->output_to_render_result();
-    context_->viewer_output_to_viewer_image();
-    texture_pool_->free_unused_and_reset();
+      context_->output_to_render_result();
+      context_->viewer_output_to_viewer_image();
+      context_->release_input_textures();
+      texture_pool_->free_unused_and_reset();
+    }
 
     if (BLI_thread_is_main() || re_system_gpu_context == nullptr) {
       DRW_gpu_context_disable();
@@ -645,12 +666,14 @@ class RealtimeCompositor {
       void *re_system_gpu_context = RE_system_gpu_context_get(&render_);
       WM_system_gpu_context_release(re_system_gpu_context);
     }
+
+    return is_supported_size;
   }
 };
 
 }  // namespace blender::render
 
-void Render::compositor_execute(const Scene &scene,
+bool Render::compositor_execute(const Scene &scene,
                                 const RenderData &render_data,
                                 const bNodeTree &node_tree,
                                 const char *view_name,
@@ -666,7 +689,7 @@ void Render::compositor_execute(const Scene &scene,
     gpu_compositor = new blender::render::RealtimeCompositor(*this, input_data);
   }
 
-  gpu_compositor->execute(input_data);
+  return gpu_compositor->execute(input_data);
 }
 
 void Render::compositor_free()
@@ -679,7 +702,7 @@ void Render::compositor_free()
   }
 }
 
-void RE_compositor_execute(Render &render,
+bool RE_compositor_execute(Render &render,
                            const Scene &scene,
                            const RenderData &render_data,
                            const bNodeTree &node_tree,
@@ -687,7 +710,8 @@ void RE_compositor_execute(Render &render,
                            blender::realtime_compositor::RenderContext *render_context,
                            blender::realtime_compositor::Profiler *profiler)
 {
-  render.compositor_execute(scene, render_data, node_tree, view_name, render_context, profiler);
+  return render.compositor_execute(
+      scene, render_data, node_tree, view_name, render_context, profiler);
 }
 
 void RE_compositor_free(Render &render)
@@ -773,6 +773,9 @@ bool RE_bake_engine(Render *re,
 
   /* render */
   engine = re->engine;
+  /* The engine is kept after baking an object, so the next objects of the same bake don't have to
+   * synchronize the scene again. */
+  const bool is_synced = (engine != nullptr && engine->depsgraph == depsgraph);
 
   if (!engine) {
     engine = RE_engine_create(type);
@@ -791,7 +794,7 @@ bool RE_bake_engine(Render *re,
     engine->depsgraph = depsgraph;
 
     /* update is only called so we create the engine.session */
-    if (type->update) {
+    if (!is_synced && type->update) {
       type->update(engine, re->main, engine->depsgraph);
     }
 
@@ -816,17 +819,10 @@ bool RE_bake_engine(Render *re,
     }
 
     memset(&engine->bake, 0, sizeof(engine->bake));
-
-    engine->depsgraph = nullptr;
   }
 
   engine->flag &= ~RE_ENGINE_RENDERING;
 
-  engine_depsgraph_free(engine);
-
-  RE_engine_free(engine);
-  re->engine = nullptr;
-
   if (BKE_reports_contain(re->reports, RPT_ERROR)) {
     G.is_break = true;
   }
@@ -834,6 +830,16 @@ bool RE_bake_engine(Render *re,
   return true;
 }
 
+void RE_bake_engine_free(Render *re, Depsgraph *depsgraph)
+{
+  if (re->engine && re->engine->depsgraph == depsgraph) {
+    /* The depsgraph is owned by the caller of #RE_bake_engine. */
+    re->engine->depsgraph = nullptr;
+    RE_engine_free(re->engine);
+    re->engine = nullptr;
+  }
+}
+
 /* Render */
 
 static void engine_render_view_layer(Render *re,
@@ -46,8 +46,8 @@ struct BaseRender {
    * highlight. */
   virtual blender::render::TilesHighlight *get_tile_highlight() = 0;
 
-  /* GPU/realtime compositor. */
-  virtual void compositor_execute(const Scene &scene,
+  /* GPU/realtime compositor. Returns false if the GPU compositor can't be used. */
+  virtual bool compositor_execute(const Scene &scene,
                                   const RenderData &render_data,
                                   const bNodeTree &node_tree,
                                   const char *view_name,
@@ -99,13 +99,14 @@ struct ViewRender : public BaseRender {
     return nullptr;
   }
 
-  void compositor_execute(const Scene & /*scene*/,
+  bool compositor_execute(const Scene & /*scene*/,
                           const RenderData & /*render_data*/,
                           const bNodeTree & /*node_tree*/,
                           const char * /*view_name*/,
                           blender::realtime_compositor::RenderContext * /*render_context*/,
                           blender::realtime_compositor::Profiler * /*profiler*/) override
   {
+    return false;
   }
   void compositor_free() override {}
 
@@ -144,7 +145,7 @@ struct Render : public BaseRender {
     return &tile_highlight;
   }
 
-  void compositor_execute(const Scene &scene,
+  bool compositor_execute(const Scene &scene,
                           const RenderData &render_data,
                           const bNodeTree &node_tree,
                           const char *view_name,
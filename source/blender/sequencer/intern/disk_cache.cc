@@ -6,9 +6,14 @@
  * \ingroup sequencer
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <ctime>
 #include <memory.h>
+#include <string>
+
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -25,8 +30,12 @@
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
@@ -51,6 +60,12 @@
  * size specified in user preferences.
  * To distinguish 2 blend files with same name, scene->ed->disk_cache_timestamp
  * is used as UID. Blend file can still be copied manually which may cause conflict.
+ *
+ * Images are compressed and written on a background thread, so that rendering doesn't wait for
+ * the disk. The files and their headers are kept in memory after the directory was scanned once,
+ * so looking up an image that isn't cached doesn't access the disk. When an image is read, the
+ * data of the images that follow it in the same file is read along with it, because playback
+ * reads them next.
  */
 
 /* Format string:
@@ -59,6 +74,16 @@
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
+/* When more images wait to be written, images are written on the calling thread instead, so that
+ * a slow disk doesn't hold on to too much memory. */
+#define DCACHE_MAX_PENDING_WRITES 8
+/* Limits of the data that is read ahead of the requested image. */
+#define DCACHE_READ_AHEAD_IMAGES 8
+#define DCACHE_READ_AHEAD_SIZE (64 * 1024 * 1024)
+/* Files are touched on read to delete the least recently used ones first, once per interval. */
+#define DCACHE_TOUCH_INTERVAL 60
+
+using namespace blender;
 
 struct DiskCacheHeaderEntry {
   uchar encoding;
@@ -73,14 +98,6 @@ struct DiskCacheHeader {
   DiskCacheHeaderEntry entry[DCACHE_IMAGES_PER_FILE];
 };
 
-struct SeqDiskCache {
-  Main *bmain;
-  int64_t timestamp;
-  ListBase files;
-  ThreadMutex read_write_mutex;
-  size_t size_total;
-};
-
 struct DiskCacheFile {
   DiskCacheFile *next, *prev;
   char filepath[FILE_MAX];
@@ -93,6 +110,28 @@ struct DiskCacheFile {
   int render_size;
   int view_id;
   int start_frame;
+  /** The header as it was last read from or written to the file. */
+  DiskCacheHeader header;
+  bool header_is_cached;
+};
+
+struct SeqDiskCache {
+  Main *bmain = nullptr;
+  int64_t timestamp = 0;
+  ListBase files = {nullptr, nullptr};
+  /** The #files by their path in lower case, paths are compared case insensitive. */
+  Map<std::string, DiskCacheFile *> files_by_path;
+  ThreadMutex read_write_mutex;
+  size_t size_total = 0;
+
+  /** Serial pool that writes images in the order in which they were rendered. */
+  TaskPool *write_pool = nullptr;
+  std::atomic<int> pending_writes = 0;
+
+  /** Data that was read from #read_ahead_file starting at #read_ahead_offset. */
+  DiskCacheFile *read_ahead_file = nullptr;
+  uint64_t read_ahead_offset = 0;
+  Vector<uint8_t> read_ahead_data;
 };
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -128,6 +167,13 @@ bool seq_disk_cache_is_enabled(Main *bmain)
           bmain->filepath[0] != '\0');
 }
 
+static std::string seq_disk_cache_path_key(const char *filepath)
+{
+  std::string key = filepath;
+  BLI_str_tolower_ascii(key.data(), key.size());
+  return key;
+}
+
 static DiskCacheFile *seq_disk_cache_add_file_to_list(SeqDiskCache *disk_cache,
                                                       const char *filepath)
 {
@@ -149,9 +195,18 @@ static DiskCacheFile *seq_disk_cache_add_file_to_list(SeqDiskCache *disk_cache,
          &cache_file->start_frame);
   cache_file->start_frame *= DCACHE_IMAGES_PER_FILE;
   BLI_addtail(&disk_cache->files, cache_file);
+  disk_cache->files_by_path.add_overwrite(seq_disk_cache_path_key(filepath), cache_file);
   return cache_file;
 }
 
+static void seq_disk_cache_clear_files(SeqDiskCache *disk_cache)
+{
+  BLI_freelistN(&disk_cache->files);
+  disk_cache->files_by_path.clear();
+  disk_cache->read_ahead_file = nullptr;
+  disk_cache->size_total = 0;
+}
+
 static void seq_disk_cache_get_files(SeqDiskCache *disk_cache, const char *dirpath)
 {
   direntry *filelist, *fl;
@@ -208,52 +263,47 @@ static DiskCacheFile *seq_disk_cache_get_oldest_file(SeqDiskCache *disk_cache)
   return oldest_file;
 }
 
-static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *file)
+/** Remove the file from the index, without deleting it from the disk. */
+static void seq_disk_cache_remove_file_from_list(SeqDiskCache *disk_cache, DiskCacheFile *file)
 {
   disk_cache->size_total -= file->fstat.st_size;
-  BLI_delete(file->filepath, false, false);
+  disk_cache->files_by_path.remove(seq_disk_cache_path_key(file->filepath));
+  if (disk_cache->read_ahead_file == file) {
+    disk_cache->read_ahead_file = nullptr;
+  }
   BLI_remlink(&disk_cache->files, file);
   MEM_freeN(file);
 }
 
-bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
+static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *file)
+{
+  BLI_delete(file->filepath, false, false);
+  seq_disk_cache_remove_file_from_list(disk_cache, file);
+}
+
+static void seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
   while (disk_cache->size_total > seq_disk_cache_size_limit()) {
     DiskCacheFile *oldest_file = seq_disk_cache_get_oldest_file(disk_cache);
 
     if (!oldest_file) {
-      /* We shouldn't enforce limits with no files, do re-scan. */
-      seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
-      continue;
-    }
-
-    if (BLI_exists(oldest_file->filepath) == 0) {
-      /* File may have been manually deleted during runtime, do re-scan. */
-      BLI_freelistN(&disk_cache->files);
-      seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
-      continue;
+      /* The total size is only made of the files in the index. */
+      BLI_assert_unreachable();
+      disk_cache->size_total = 0;
+      break;
     }
 
+    /* A file that was deleted during runtime is only removed from the index. */
     seq_disk_cache_delete_file(disk_cache, oldest_file);
   }
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
-
-  return true;
 }
 
 static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache,
                                                             const char *filepath)
 {
-  DiskCacheFile *cache_file = static_cast<DiskCacheFile *>(disk_cache->files.first);
-
-  for (; cache_file; cache_file = cache_file->next) {
-    if (BLI_strcasecmp(cache_file->filepath, filepath) == 0) {
-      return cache_file;
-    }
-  }
-
-  return nullptr;
+  return disk_cache->files_by_path.lookup_default(seq_disk_cache_path_key(filepath), nullptr);
 }
 
 /* Update file size and timestamp. */
@@ -403,6 +453,9 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Images that wait to be written may be outdated. */
+  BLI_task_pool_cancel(disk_cache->write_pool);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, seq_changed) - DCACHE_IMAGES_PER_FILE;
@@ -431,6 +484,24 @@ static size_t deflate_imbuf_to_file(ImBuf *ibuf,
   return fwrite(data, 1, header_entry->size_raw, file);
 }
 
+static size_t inflate_mem_to_imbuf(ImBuf *ibuf,
+                                  const uint8_t *src,
+                                  const DiskCacheHeaderEntry *header_entry)
+{
+  void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
+                                                     (void *)ibuf->float_buffer.data;
+  if (header_entry->size_compressed >= 4 && BLI_file_magic_is_zstd((const char *)src)) {
+    const size_t size = ZSTD_decompress(
+        data, header_entry->size_raw, src, header_entry->size_compressed);
+    return ZSTD_isError(size) ? 0 : size;
+  }
+  if (header_entry->size_compressed != header_entry->size_raw) {
+    return 0;
+  }
+  memcpy(data, src, header_entry->size_raw);
+  return header_entry->size_raw;
+}
+
 static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
 {
   void *data = (ibuf->byte_buffer.data != nullptr) ? (void *)ibuf->byte_buffer.data :
@@ -478,7 +549,9 @@ static size_t seq_disk_cache_write_header(FILE *file, const DiskCacheHeader *hea
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(const uint64_t frameno,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -511,7 +584,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frameno;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -531,7 +604,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
 static int seq_disk_cache_get_header_entry(SeqCacheKey *key, const DiskCacheHeader *header)
 {
   for (int i = 0; i < DCACHE_IMAGES_PER_FILE; i++) {
-    if (header->entry[i].frameno == key->frame_index) {
+    if (header->entry[i].size_compressed != 0 && header->entry[i].frameno == key->frame_index) {
       return i;
     }
   }
@@ -539,38 +612,66 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, const DiskCacheHead
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+/** Read the header of the file, or use the header that is kept in memory. */
+static bool seq_disk_cache_ensure_header(DiskCacheFile *cache_file, FILE *file)
 {
-  BLI_mutex_lock(&disk_cache->read_write_mutex);
+  if (cache_file->header_is_cached) {
+    return true;
+  }
+  if (!seq_disk_cache_read_header(file, &cache_file->header)) {
+    return false;
+  }
+  cache_file->header_is_cached = true;
+  return true;
+}
 
-  char filepath[FILE_MAX];
+static bool seq_disk_cache_write_file_ex(SeqDiskCache *disk_cache,
+                                         const char *filepath,
+                                         const uint64_t frameno,
+                                         ImBuf *ibuf)
+{
+  BLI_mutex_lock(&disk_cache->read_write_mutex);
 
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_file_ensure_parent_dir_exists(filepath);
 
   /* Touch the file. */
   FILE *file = BLI_fopen(filepath, "rb+");
+  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, filepath);
   if (!file) {
     file = BLI_fopen(filepath, "wb+");
     if (!file) {
       BLI_mutex_unlock(&disk_cache->read_write_mutex);
       return false;
     }
-    seq_disk_cache_add_file_to_list(disk_cache, filepath);
+    if (cache_file) {
+      /* The file was deleted during runtime. */
+      seq_disk_cache_remove_file_from_list(disk_cache, cache_file);
+    }
+    cache_file = nullptr;
+  }
+  if (cache_file == nullptr) {
+    cache_file = seq_disk_cache_add_file_to_list(disk_cache, filepath);
+  }
+
+  /* The data that was read ahead may be overwritten. */
+  if (disk_cache->read_ahead_file == cache_file) {
+    disk_cache->read_ahead_file = nullptr;
   }
 
-  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, filepath);
-  DiskCacheHeader header;
-  memset(&header, 0, sizeof(header));
   /* The file may be empty when touched (above).
    * This is fine, don't attempt reading the header in that case. */
-  if (cache_file->fstat.st_size != 0 && !seq_disk_cache_read_header(file, &header)) {
+  if (cache_file->fstat.st_size == 0) {
+    memset(&cache_file->header, 0, sizeof(cache_file->header));
+    cache_file->header_is_cached = true;
+  }
+  else if (!seq_disk_cache_ensure_header(cache_file, file)) {
     fclose(file);
     seq_disk_cache_delete_file(disk_cache, cache_file);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  DiskCacheHeader &header = cache_file->header;
+  int entry_index = seq_disk_cache_add_header_entry(frameno, ibuf, &header);
 
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
@@ -581,43 +682,172 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
      */
     header.entry[entry_index].size_compressed = bytes_written;
     seq_disk_cache_write_header(file, &header);
-    seq_disk_cache_update_file(disk_cache, filepath);
     fclose(file);
+    seq_disk_cache_update_file(disk_cache, filepath);
 
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return true;
   }
 
+  /* The header in the file is unchanged. */
+  cache_file->header_is_cached = false;
+  fclose(file);
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return false;
 }
 
+struct DiskCacheWriteData {
+  char filepath[FILE_MAX];
+  uint64_t frameno;
+  ImBuf *ibuf;
+};
+
+static void seq_disk_cache_write_task(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(BLI_task_pool_user_data(pool));
+  const DiskCacheWriteData *data = static_cast<const DiskCacheWriteData *>(taskdata);
+  if (BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+  seq_disk_cache_write_file_ex(disk_cache, data->filepath, data->frameno, data->ibuf);
+  seq_disk_cache_enforce_limits(disk_cache);
+}
+
+static void seq_disk_cache_write_data_free(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(BLI_task_pool_user_data(pool));
+  DiskCacheWriteData *data = static_cast<DiskCacheWriteData *>(taskdata);
+  IMB_freeImBuf(data->ibuf);
+  MEM_freeN(data);
+  disk_cache->pending_writes--;
+}
+
+bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  DiskCacheWriteData *data = MEM_cnew<DiskCacheWriteData>(__func__);
+  seq_disk_cache_get_file_path(disk_cache, key, data->filepath, sizeof(data->filepath));
+  data->frameno = key->frame_index;
+
+  if (disk_cache->pending_writes >= DCACHE_MAX_PENDING_WRITES) {
+    const bool success = seq_disk_cache_write_file_ex(
+        disk_cache, data->filepath, data->frameno, ibuf);
+    seq_disk_cache_enforce_limits(disk_cache);
+    MEM_freeN(data);
+    return success;
+  }
+
+  /* The image is not modified anymore once it's cached, so it can be written later. */
+  IMB_refImBuf(ibuf);
+  data->ibuf = ibuf;
+  disk_cache->pending_writes++;
+  BLI_task_pool_push(disk_cache->write_pool,
+                     seq_disk_cache_write_task,
+                     data,
+                     true,
+                     seq_disk_cache_write_data_free);
+  return true;
+}
+
+/**
+ * Read the data of the entry, together with the data of the entries that directly follow it in
+ * the file. The following entries are kept in memory for the next reads.
+ */
+static size_t seq_disk_cache_read_entry(SeqDiskCache *disk_cache,
+                                        DiskCacheFile *cache_file,
+                                        FILE **r_file,
+                                        const int entry_index,
+                                        ImBuf *ibuf)
+{
+  DiskCacheHeaderEntry *entry = &cache_file->header.entry[entry_index];
+  const uint64_t read_ahead_end = disk_cache->read_ahead_offset +
+                                  disk_cache->read_ahead_data.size();
+  if (disk_cache->read_ahead_file == cache_file &&
+      entry->offset >= disk_cache->read_ahead_offset &&
+      entry->offset + entry->size_compressed <= read_ahead_end)
+  {
+    return inflate_mem_to_imbuf(
+        ibuf,
+        disk_cache->read_ahead_data.data() + (entry->offset - disk_cache->read_ahead_offset),
+        entry);
+  }
+
+  /* Find the entries that are stored right after the requested one. */
+  uint64_t read_end = entry->offset + entry->size_compressed;
+  const int last_index = std::min(entry_index + DCACHE_READ_AHEAD_IMAGES,
+                                  DCACHE_IMAGES_PER_FILE - 1);
+  for (int i = entry_index + 1; i <= last_index; i++) {
+    const DiskCacheHeaderEntry &next_entry = cache_file->header.entry[i];
+    if (next_entry.size_compressed == 0 || next_entry.offset != read_end ||
+        read_end + next_entry.size_compressed - entry->offset > DCACHE_READ_AHEAD_SIZE)
+    {
+      break;
+    }
+    read_end = next_entry.offset + next_entry.size_compressed;
+  }
+  if (*r_file == nullptr) {
+    *r_file = BLI_fopen(cache_file->filepath, "rb");
+    if (*r_file == nullptr) {
+      return 0;
+    }
+  }
+  FILE *file = *r_file;
+
+  if (read_end == entry->offset + entry->size_compressed) {
+    /* Nothing to read ahead, decompress from the file directly. */
+    disk_cache->read_ahead_file = nullptr;
+    return inflate_file_to_imbuf(ibuf, file, entry);
+  }
+
+  disk_cache->read_ahead_data.resize(read_end - entry->offset);
+  BLI_fseek(file, entry->offset, SEEK_SET);
+  if (fread(disk_cache->read_ahead_data.data(), 1, disk_cache->read_ahead_data.size(), file) !=
+      disk_cache->read_ahead_data.size())
+  {
+    disk_cache->read_ahead_file = nullptr;
+    return 0;
+  }
+  disk_cache->read_ahead_file = cache_file;
+  disk_cache->read_ahead_offset = entry->offset;
+  return inflate_mem_to_imbuf(ibuf, disk_cache->read_ahead_data.data(), entry);
+}
+
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   char filepath[FILE_MAX];
-  DiskCacheHeader header;
 
   seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
-  BLI_file_ensure_parent_dir_exists(filepath);
 
-  FILE *file = BLI_fopen(filepath, "rb");
-  if (!file) {
+  /* Files that are not in the index were not written. */
+  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, filepath);
+  if (!cache_file) {
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  if (!seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return nullptr;
+  /* The file is only opened when the header or the image data is not in memory. */
+  FILE *file = nullptr;
+  if (!cache_file->header_is_cached) {
+    file = BLI_fopen(filepath, "rb");
+    if (!file) {
+      BLI_mutex_unlock(&disk_cache->read_write_mutex);
+      return nullptr;
+    }
+    if (!seq_disk_cache_ensure_header(cache_file, file)) {
+      fclose(file);
+      BLI_mutex_unlock(&disk_cache->read_write_mutex);
+      return nullptr;
+    }
   }
+  const DiskCacheHeader &header = cache_file->header;
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
   if (entry_index < 0) {
-    fclose(file);
+    if (file) {
+      fclose(file);
+    }
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
@@ -640,23 +870,28 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
   }
   else {
-    fclose(file);
+    if (file) {
+      fclose(file);
+    }
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  size_t bytes_read = seq_disk_cache_read_entry(disk_cache, cache_file, &file, entry_index, ibuf);
+  if (file) {
+    fclose(file);
+  }
 
   /* Sanity check. */
   if (bytes_read != expected_size) {
-    fclose(file);
     IMB_freeImBuf(ibuf);
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
-  BLI_file_touch(filepath);
-  seq_disk_cache_update_file(disk_cache, filepath);
-  fclose(file);
+  if (time(nullptr) - cache_file->fstat.st_mtime > DCACHE_TOUCH_INTERVAL) {
+    BLI_file_touch(filepath);
+    seq_disk_cache_update_file(disk_cache, filepath);
+  }
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return ibuf;
@@ -664,20 +899,23 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 
 SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 {
-  SeqDiskCache *disk_cache = static_cast<SeqDiskCache *>(
-      MEM_callocN(sizeof(SeqDiskCache), "SeqDiskCache"));
+  SeqDiskCache *disk_cache = MEM_new<SeqDiskCache>(__func__);
   disk_cache->bmain = bmain;
   BLI_mutex_init(&disk_cache->read_write_mutex);
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
+  disk_cache->write_pool = BLI_task_pool_create_background_serial(disk_cache, TASK_PRIORITY_LOW);
   BLI_mutex_unlock(&cache_create_lock);
   return disk_cache;
 }
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
-  BLI_freelistN(&disk_cache->files);
+  /* Finish writing the cached images. */
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+  BLI_task_pool_free(disk_cache->write_pool);
+  seq_disk_cache_clear_files(disk_cache);
   BLI_mutex_end(&disk_cache->read_write_mutex);
-  MEM_freeN(disk_cache);
+  MEM_delete(disk_cache);
 }
@@ -10,19 +10,31 @@
 #include <ctime>
 #include <memory.h>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h" /* for FILE_MAX. */
+#include "DNA_userdef_types.h"
 
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
+#include "IMB_metadata.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
+#include "BLI_implicit_sharing.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_half.hh"
+#include "BLI_math_vector.h"
 #include "BLI_mempool.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "BKE_main.hh"
 
@@ -35,6 +47,8 @@
 #include "image_cache.hh"
 #include "prefetch.hh"
 
+using namespace blender;
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -59,6 +73,9 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Compression: When enabled in the preferences, the images that are kept in the cache are stored
+ * as #SeqCacheCompressedImage, which fits more images into the memory cache limit.
  */
 
 #define THUMB_CACHE_LIMIT 5000
@@ -74,9 +91,13 @@ struct SeqCache {
   int thumbnail_count;
 };
 
+struct SeqCacheCompressedImage;
+
 struct SeqCacheItem {
   SeqCache *cache_owner;
   ImBuf *ibuf;
+  /** Stored instead of #ibuf when the image is compressed. */
+  SeqCacheCompressedImage *compressed;
 };
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -184,6 +205,149 @@ static void seq_cache_keyfree(void *val)
   BLI_mempool_free(key->cache_owner->keys_pool, key);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compressed Images
+ *
+ * Float pixels are stored as half floats, byte pixels are compressed losslessly with zstd. Both
+ * are done for chunks of rows in parallel, outside of the cache lock. The compressed image is
+ * shared, so that it can be removed from the cache while another thread decompresses it.
+ * \{ */
+
+/* Fast compression, images are compressed and decompressed during playback. */
+#define SEQ_CACHE_COMPRESSION_LEVEL 1
+#define SEQ_CACHE_COMPRESSION_CHUNK_ROWS 64
+
+struct SeqCacheCompressedImage : public ImplicitSharingMixin {
+  /** Image without pixels, which has the properties of the compressed image. */
+  ImBuf *header = nullptr;
+  Array<uint16_t> half_pixels;
+  /** Chunks of rows of the byte pixels. Chunks that don't get smaller are stored as they are. */
+  Vector<Array<uint8_t>> byte_chunks;
+
+  ~SeqCacheCompressedImage() override
+  {
+    IMB_freeImBuf(header);
+  }
+
+ private:
+  void delete_self() override
+  {
+    MEM_delete(this);
+  }
+};
+
+static void seq_cache_copy_image_properties(ImBuf *dst, const ImBuf *src)
+{
+  dst->byte_buffer.colorspace = src->byte_buffer.colorspace;
+  dst->float_buffer.colorspace = src->float_buffer.colorspace;
+  copy_v2_v2_db(dst->ppm, src->ppm);
+  dst->dither = src->dither;
+  dst->ftype = src->ftype;
+  dst->foptions = src->foptions;
+  STRNCPY(dst->filepath, src->filepath);
+  IMB_metadata_copy(dst, src);
+}
+
+static IndexRange seq_cache_chunk_rows(const ImBuf *ibuf, const int64_t chunk)
+{
+  const int64_t start = chunk * SEQ_CACHE_COMPRESSION_CHUNK_ROWS;
+  return IndexRange(start, std::min<int64_t>(SEQ_CACHE_COMPRESSION_CHUNK_ROWS, ibuf->y - start));
+}
+
+static SeqCacheCompressedImage *seq_cache_compress(const ImBuf *ibuf)
+{
+  if (ibuf->byte_buffer.data == nullptr && ibuf->float_buffer.data == nullptr) {
+    return nullptr;
+  }
+
+  SeqCacheCompressedImage *compressed = MEM_new<SeqCacheCompressedImage>(__func__);
+  compressed->header = IMB_allocImBuf(ibuf->x, ibuf->y, ibuf->planes, 0);
+  compressed->header->channels = ibuf->channels;
+  seq_cache_copy_image_properties(compressed->header, ibuf);
+
+  const IndexRange chunks(divide_ceil_ul(ibuf->y, SEQ_CACHE_COMPRESSION_CHUNK_ROWS));
+  if (ibuf->float_buffer.data) {
+    const int64_t row_size = int64_t(ibuf->x) * ibuf->channels;
+    compressed->half_pixels.reinitialize(row_size * ibuf->y);
+    threading::parallel_for(chunks, 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        const IndexRange rows = seq_cache_chunk_rows(ibuf, chunk);
+        math::float_to_half_array(ibuf->float_buffer.data + rows.start() * row_size,
+                                  compressed->half_pixels.data() + rows.start() * row_size,
+                                  rows.size() * row_size);
+      }
+    });
+  }
+  if (ibuf->byte_buffer.data) {
+    const int64_t row_size = int64_t(ibuf->x) * 4;
+    compressed->byte_chunks.resize(chunks.size());
+    threading::parallel_for(chunks, 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        const IndexRange rows = seq_cache_chunk_rows(ibuf, chunk);
+        const Span<uint8_t> src(ibuf->byte_buffer.data + rows.start() * row_size,
+                                rows.size() * row_size);
+        Array<uint8_t> buffer(ZSTD_compressBound(src.size()), NoInitialization());
+        const size_t compressed_size = ZSTD_compress(
+            buffer.data(), buffer.size(), src.data(), src.size(), SEQ_CACHE_COMPRESSION_LEVEL);
+        if (ZSTD_isError(compressed_size) || compressed_size >= src.size()) {
+          compressed->byte_chunks[chunk] = src;
+        }
+        else {
+          compressed->byte_chunks[chunk] = buffer.as_span().take_front(compressed_size);
+        }
+      }
+    });
+  }
+  return compressed;
+}
+
+static ImBuf *seq_cache_decompress(const SeqCacheCompressedImage &compressed)
+{
+  const ImBuf *header = compressed.header;
+  const bool has_byte = !compressed.byte_chunks.is_empty();
+  const bool has_float = !compressed.half_pixels.is_empty();
+  ImBuf *ibuf = IMB_allocImBuf(
+      header->x, header->y, header->planes, has_byte ? IB_rect | IB_uninitialized_pixels : 0);
+  if (ibuf == nullptr) {
+    return nullptr;
+  }
+  if (has_float && !imb_addrectfloatImBuf(ibuf, header->channels, false)) {
+    IMB_freeImBuf(ibuf);
+    return nullptr;
+  }
+  seq_cache_copy_image_properties(ibuf, header);
+
+  const IndexRange chunks(divide_ceil_ul(ibuf->y, SEQ_CACHE_COMPRESSION_CHUNK_ROWS));
+  threading::parallel_for(chunks, 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange rows = seq_cache_chunk_rows(ibuf, chunk);
+      if (has_float) {
+        const int64_t row_size = int64_t(ibuf->x) * ibuf->channels;
+        math::half_to_float_array(compressed.half_pixels.data() + rows.start() * row_size,
+                                  ibuf->float_buffer.data + rows.start() * row_size,
+                                  rows.size() * row_size);
+      }
+      if (has_byte) {
+        const int64_t row_size = int64_t(ibuf->x) * 4;
+        const Span<uint8_t> src = compressed.byte_chunks[chunk];
+        MutableSpan<uint8_t> dst(ibuf->byte_buffer.data + rows.start() * row_size,
+                                 rows.size() * row_size);
+        if (src.size() == dst.size()) {
+          dst.copy_from(src);
+        }
+        else {
+          const size_t size = ZSTD_decompress(dst.data(), dst.size(), src.data(), src.size());
+          BLI_assert(size == dst.size());
+          UNUSED_VARS_NDEBUG(size);
+        }
+      }
+    }
+  });
+  return ibuf;
+}
+
+/** \} */
+
 static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
@@ -191,15 +355,18 @@ static void seq_cache_valfree(void *val)
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
+  if (item->compressed) {
+    item->compressed->remove_user_and_delete_if_last();
+  }
 
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
-static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
+static int get_stored_types_flag(Scene *scene, const Sequence *seq)
 {
   int flag;
-  if (key->seq->cache_flag & SEQ_CACHE_OVERRIDE) {
-    flag = key->seq->cache_flag;
+  if (seq->cache_flag & SEQ_CACHE_OVERRIDE) {
+    flag = seq->cache_flag;
   }
   else {
     flag = scene->ed->cache_flag;
@@ -211,15 +378,30 @@ static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
   return flag;
 }
 
-static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_cache_use_compression(Scene *scene, const Sequence *seq, const int type)
+{
+  /* Only compress images that are kept in the cache, temporary images are used right away. */
+  return (U.video_flag & USER_VIDEO_CACHE_COMPRESSION) && type != SEQ_CACHE_STORE_THUMBNAIL &&
+         (get_stored_types_flag(scene, seq) & type);
+}
+
+/**
+ * Add the image to the cache. When \a compressed is given, the cache takes ownership of it and
+ * stores it instead of the image.
+ */
+static void seq_cache_put_ex(Scene *scene,
+                             SeqCacheKey *key,
+                             ImBuf *ibuf,
+                             SeqCacheCompressedImage *compressed = nullptr)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheItem *item;
   item = static_cast<SeqCacheItem *>(BLI_mempool_alloc(cache->items_pool));
   item->cache_owner = cache;
-  item->ibuf = ibuf;
+  item->ibuf = compressed ? nullptr : ibuf;
+  item->compressed = compressed;
 
-  const int stored_types_flag = get_stored_types_flag(scene, key);
+  const int stored_types_flag = get_stored_types_flag(scene, key->seq);
 
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
@@ -229,7 +411,9 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
 
   BLI_assert(!BLI_ghash_haskey(cache->hash, key));
   BLI_ghash_insert(cache->hash, key, item);
-  IMB_refImBuf(ibuf);
+  if (item->ibuf) {
+    IMB_refImBuf(item->ibuf);
+  }
 
   /* Store pointer to last cached key. */
   SeqCacheKey *temp_last_key = cache->last_key;
@@ -251,7 +435,13 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   }
 }
 
-static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
+/**
+ * Get the cached image. A compressed image is returned in \a r_compressed with a user added
+ * instead, so that it can be decompressed after unlocking the cache.
+ */
+static ImBuf *seq_cache_get_ex(SeqCache *cache,
+                               SeqCacheKey *key,
+                               const SeqCacheCompressedImage **r_compressed)
 {
   SeqCacheItem *item = static_cast<SeqCacheItem *>(BLI_ghash_lookup(cache->hash, key));
 
@@ -261,6 +451,11 @@ static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
     return item->ibuf;
   }
 
+  if (item && item->compressed) {
+    item->compressed->add_user();
+    *r_compressed = item->compressed;
+  }
+
   return nullptr;
 }
 
@@ -407,7 +602,7 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
     BLI_assert(key->cache_owner == cache);
 
     /* This shouldn't happen, but better be safe than sorry. */
-    if (!item->ibuf) {
+    if (!item->ibuf && !item->compressed) {
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
@@ -769,15 +964,21 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   ImBuf *ibuf = nullptr;
+  const SeqCacheCompressedImage *compressed = nullptr;
   SeqCacheKey key;
 
   /* Try RAM cache: */
   if (cache && seq) {
     seq_cache_populate_key(&key, context, seq, timeline_frame, type);
-    ibuf = seq_cache_get_ex(cache, &key);
+    ibuf = seq_cache_get_ex(cache, &key, &compressed);
   }
   seq_cache_unlock(scene);
 
+  if (compressed) {
+    ibuf = seq_cache_decompress(*compressed);
+    compressed->remove_user_and_delete_if_last();
+  }
+
   if (ibuf) {
     return ibuf;
   }
@@ -796,8 +997,11 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
 
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
+      SeqCacheCompressedImage *compressed = seq_cache_use_compression(scene, seq, type) ?
+                                                seq_cache_compress(ibuf) :
+                                                nullptr;
       SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-      seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_put_ex(scene, new_key, ibuf, compressed);
     }
   }
 
@@ -890,20 +1094,24 @@ void seq_cache_put(
     seq_cache_create(context->bmain, scene);
   }
 
+  /* Compress before locking the cache, the caller keeps using the uncompressed image. */
+  SeqCacheCompressedImage *compressed = seq_cache_use_compression(scene, seq, type) ?
+                                            seq_cache_compress(i) :
+                                            nullptr;
+
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-  seq_cache_put_ex(scene, key, i);
+  seq_cache_put_ex(scene, key, i, compressed);
   seq_cache_unlock(scene);
 
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == nullptr) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
       seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
     }
   }
 }
@@ -25,6 +25,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.hh"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -635,40 +636,36 @@ static void sequencer_preprocess_transform_crop(
 
 static void multibuf(ImBuf *ibuf, const float fmul, const bool multiply_alpha)
 {
-  uchar *rt;
-  float *rt_float;
-
-  int a;
-
-  rt = ibuf->byte_buffer.data;
-  rt_float = ibuf->float_buffer.data;
+  uchar *rt = ibuf->byte_buffer.data;
+  float *rt_float = ibuf->float_buffer.data;
+  const IndexRange pixels(IMB_get_rect_len(ibuf));
 
   if (rt) {
     const int imul = int(256.0f * fmul);
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt[0] = min_ii((imul * rt[0]) >> 8, 255);
-      rt[1] = min_ii((imul * rt[1]) >> 8, 255);
-      rt[2] = min_ii((imul * rt[2]) >> 8, 255);
-      if (multiply_alpha) {
-        rt[3] = min_ii((imul * rt[3]) >> 8, 255);
+    threading::parallel_for(pixels, 64 * 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        uchar *pixel = rt + i * 4;
+        pixel[0] = min_ii((imul * pixel[0]) >> 8, 255);
+        pixel[1] = min_ii((imul * pixel[1]) >> 8, 255);
+        pixel[2] = min_ii((imul * pixel[2]) >> 8, 255);
+        if (multiply_alpha) {
+          pixel[3] = min_ii((imul * pixel[3]) >> 8, 255);
+        }
       }
-
-      rt += 4;
-    }
+    });
   }
   if (rt_float) {
-    a = ibuf->x * ibuf->y;
-    while (a--) {
-      rt_float[0] *= fmul;
-      rt_float[1] *= fmul;
-      rt_float[2] *= fmul;
-      if (multiply_alpha) {
-        rt_float[3] *= fmul;
+    threading::parallel_for(pixels, 64 * 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        float *pixel = rt_float + i * 4;
+        pixel[0] *= fmul;
+        pixel[1] *= fmul;
+        pixel[2] *= fmul;
+        if (multiply_alpha) {
+          pixel[3] *= fmul;
+        }
       }
-
-      rt_float += 4;
-    }
+    });
   }
 }
 
@@ -17,9 +17,12 @@
 #  include "DNA_scene_types.h"
 #  include "DNA_texture_types.h"
 
+#  include "BLI_array.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_offset_indices.hh"
+#  include "BLI_task.hh"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.hh"
@@ -36,6 +39,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Number of vertices handled by each task of the parallel vector and matrix operations. */
+#  define CLOTH_PARALLEL_GRAIN_SIZE 1024
+
 // #define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -69,6 +75,17 @@ struct fmatrix3x3 {
   uint scount;      /* spring count */
 };
 
+/* Run the function for every vertex index in parallel. */
+template<typename Fn> static void parallel_for_verts(const uint verts, const Fn &fn)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(verts), CLOTH_PARALLEL_GRAIN_SIZE, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          fn(uint(i));
+        }
+      });
+}
+
 ///////////////////////////
 /* float[3] vector */
 ///////////////////////////
@@ -155,11 +172,7 @@ DO_INLINE void zero_lfvector(float (*to)[3], uint verts)
 /* Multiply long vector with scalar. */
 DO_INLINE void mul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    mul_fvector_S(to[i], fLongVector[i], scalar);
-  }
+  parallel_for_verts(verts, [&](const uint i) { mul_fvector_S(to[i], fLongVector[i], scalar); });
 }
 /* Multiply long vector with scalar.
  * `A -= B * float` */
@@ -173,15 +186,27 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Floating point addition is not associative, so summing in parallel would give different
+   * results each time the simulation runs. Instead, chunks of a fixed size are summed in parallel
+   * and combined in order, which does not depend on the number of threads. */
+  const uint chunks_num = (verts + CLOTH_PARALLEL_GRAIN_SIZE - 1) / CLOTH_PARALLEL_GRAIN_SIZE;
+  blender::Array<float, 64> chunk_sums(chunks_num);
+  blender::threading::parallel_for(
+      chunk_sums.index_range(), 1, [&](const blender::IndexRange range) {
+        for (const int64_t chunk : range) {
+          const uint start = uint(chunk) * CLOTH_PARALLEL_GRAIN_SIZE;
+          const uint end = std::min<uint>(start + CLOTH_PARALLEL_GRAIN_SIZE, verts);
+          float sum = 0.0f;
+          for (uint i = start; i < end; i++) {
+            sum += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+          }
+          chunk_sums[chunk] = sum;
+        }
+      });
+
+  float temp = 0.0f;
+  for (const float sum : chunk_sums) {
+    temp += sum;
   }
   return temp;
 }
@@ -191,21 +216,15 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  parallel_for_verts(
+      verts, [&](const uint i) { add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]); });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  parallel_for_verts(
+      verts, [&](const uint i) { VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS); });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -215,11 +234,8 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  parallel_for_verts(
+      verts, [&](const uint i) { VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS); });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
@@ -236,11 +252,8 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  parallel_for_verts(
+      verts, [&](const uint i) { sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]); });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -582,35 +595,67 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/**
+ * The off-diagonal blocks of a big matrix that are in the row or column of each vertex, in the
+ * order of the blocks. This allows multiplying the matrix in parallel over the vertices, without
+ * multiple threads adding to the same vertex.
+ */
+struct fmatrix3x3_adjacency {
+  blender::Array<int> offsets;
+  blender::Array<int> blocks;
+};
+
+static void build_bfmatrix_adjacency(const fmatrix3x3 *matrix,
+                                     const int blocks_num,
+                                     fmatrix3x3_adjacency &r_adjacency)
 {
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  const uint vcount = matrix[0].vcount;
+  const blender::IndexRange blocks(vcount, blocks_num);
 
-  zero_lfvector(to, vcount);
+  r_adjacency.offsets.reinitialize(vcount + 1);
+  r_adjacency.offsets.fill(0);
+  for (const int64_t b : blocks) {
+    r_adjacency.offsets[matrix[b].r]++;
+    if (matrix[b].c != matrix[b].r) {
+      r_adjacency.offsets[matrix[b].c]++;
+    }
+  }
+  const blender::OffsetIndices<int> offsets =
+      blender::offset_indices::accumulate_counts_to_offsets(r_adjacency.offsets);
+
+  r_adjacency.blocks.reinitialize(offsets.total_size());
+  blender::Array<int> counts(vcount, 0);
+  for (const int64_t b : blocks) {
+    const uint r = matrix[b].r;
+    const uint c = matrix[b].c;
+    r_adjacency.blocks[offsets[r].start() + counts[r]++] = int(b);
+    if (c != r) {
+      r_adjacency.blocks[offsets[c].start() + counts[c]++] = int(b);
+    }
+  }
+}
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     fmatrix3x3 *from,
+                                     const fmatrix3x3_adjacency &adjacency,
+                                     lfVector *fLongVector)
+{
+  const blender::OffsetIndices<int> offsets(adjacency.offsets);
+  parallel_for_verts(from[0].vcount, [&](const uint i) {
+    mul_fmatrix_fvector(to[i], from[i].m, fLongVector[i]);
+    for (const int b : adjacency.blocks.as_span().slice(offsets[i])) {
+      if (from[b].r == i) {
+        muladd_fmatrix_fvector(to[i], from[b].m, fLongVector[from[b].c]);
+      }
+      if (from[b].c == i) {
         /* This is the lower triangle of the sparse matrix,
          * therefore multiplication occurs with transposed sub-matrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
+        muladd_fmatrixT_fvector(to[i], from[b].m, fLongVector[from[b].r]);
       }
     }
-  }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
-
-  del_lfvector(temp);
+  });
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -619,12 +664,10 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
 DO_INLINE void subadd_bfmatrixS_bfmatrixS(
     fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
 {
-  uint i = 0;
-
   /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
+  parallel_for_verts(matrix[0].vcount + matrix[0].scount, [&](const uint i) {
     subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+  });
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -742,11 +785,7 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
-
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  parallel_for_verts(S[0].vcount, [&](const uint i) { mul_m3_v3(S[i].m, V[S[i].r]); });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -821,6 +860,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrix3x3_adjacency &adjacency,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -848,7 +888,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, adjacency, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -871,7 +911,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, adjacency, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1131,7 +1171,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All matrices share the layout of the blocks added for the springs. */
+  fmatrix3x3_adjacency adjacency;
+  build_bfmatrix_adjacency(data->A, data->num_blocks, adjacency);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, adjacency, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1140,7 +1184,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, adjacency, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
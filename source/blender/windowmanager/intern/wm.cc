@@ -13,7 +13,10 @@
 /* Allow using deprecated functionality for .blend file I/O. */
 #define DNA_DEPRECATED_ALLOW
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdio>
 #include <cstring>
 
 #include "BLI_ghash.h"
@@ -24,7 +27,9 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -621,8 +626,64 @@ void wm_close_and_free(bContext *C, wmWindowManager *wm)
   MEM_delete(wm->runtime);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Main Loop Timing
+ *
+ * With `--debug-wm-time`, the time spent in each stage of the main loop is measured for the
+ * iterations that handle events, and percentiles of the last samples are printed regularly.
+ * \{ */
+
+enum {
+  WM_MAIN_TIME_HANDLERS = 0,
+  WM_MAIN_TIME_NOTIFIERS,
+  WM_MAIN_TIME_DRAW,
+  WM_MAIN_TIME_TOTAL,
+  WM_MAIN_TIME_STAGES_NUM,
+};
+
+/** Number of handled events after which the statistics are printed and reset. */
+#define WM_MAIN_TIME_SAMPLES_NUM 100
+
+struct WMMainLoopTimes {
+  std::array<blender::Vector<double>, WM_MAIN_TIME_STAGES_NUM> samples;
+};
+
+static bool wm_main_has_pending_events(const wmWindowManager *wm)
+{
+  LISTBASE_FOREACH (const wmWindow *, win, &wm->windows) {
+    if (!BLI_listbase_is_empty(&win->event_queue)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void wm_main_times_print(WMMainLoopTimes &times)
+{
+  const char *stage_names[WM_MAIN_TIME_STAGES_NUM] = {
+      "handlers", "notifiers & depsgraph", "draw", "total"};
+  printf("Main loop times of the last %d handled events (ms):\n", WM_MAIN_TIME_SAMPLES_NUM);
+  for (const int stage : blender::IndexRange(WM_MAIN_TIME_STAGES_NUM)) {
+    blender::Vector<double> &samples = times.samples[stage];
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](const double fraction) {
+      return samples[std::min(int64_t(fraction * samples.size()), samples.size() - 1)] * 1000.0;
+    };
+    printf("  %-22s p50: %8.3f  p95: %8.3f  max: %8.3f\n",
+           stage_names[stage],
+           percentile(0.5),
+           percentile(0.95),
+           samples.last() * 1000.0);
+    samples.clear();
+  }
+}
+
+/** \} */
+
 void WM_main(bContext *C)
 {
+  WMMainLoopTimes times;
+
   /* Single refresh before handling events.
    * This ensures we don't run operators before the depsgraph has been evaluated. */
   wm_event_do_refresh_wm_and_depsgraph(C);
@@ -632,13 +693,40 @@ void WM_main(bContext *C)
     /* Get events from ghost, handle window events, add to window queues. */
     wm_window_events_process(C);
 
+    const bool use_timing = (G.debug & G_DEBUG_WM_TIME) &&
+                            wm_main_has_pending_events(CTX_wm_manager(C));
+    double stage_times[WM_MAIN_TIME_STAGES_NUM];
+    if (use_timing) {
+      stage_times[WM_MAIN_TIME_HANDLERS] = BLI_time_now_seconds();
+    }
+
     /* Per window, all events to the window, screen, area and region handlers. */
     wm_event_do_handlers(C);
 
+    if (use_timing) {
+      stage_times[WM_MAIN_TIME_NOTIFIERS] = BLI_time_now_seconds();
+    }
+
     /* Events have left notes about changes, we handle and cache it. */
     wm_event_do_notifiers(C);
 
+    if (use_timing) {
+      stage_times[WM_MAIN_TIME_DRAW] = BLI_time_now_seconds();
+    }
+
     /* Execute cached changes draw. */
     wm_draw_update(C);
+
+    if (use_timing) {
+      stage_times[WM_MAIN_TIME_TOTAL] = BLI_time_now_seconds();
+      for (const int stage : blender::IndexRange(WM_MAIN_TIME_TOTAL)) {
+        times.samples[stage].append(stage_times[stage + 1] - stage_times[stage]);
+      }
+      times.samples[WM_MAIN_TIME_TOTAL].append(stage_times[WM_MAIN_TIME_TOTAL] -
+                                               stage_times[WM_MAIN_TIME_HANDLERS]);
+      if (times.samples[WM_MAIN_TIME_TOTAL].size() == WM_MAIN_TIME_SAMPLES_NUM) {
+        wm_main_times_print(times);
+      }
+    }
   }
 }
@@ -23,6 +23,7 @@
 
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -558,6 +559,44 @@ bool WM_region_use_viewport(ScrArea *area, ARegion *region)
   return wm_region_use_viewport_by_type(area->spacetype, region->regiontype);
 }
 
+/** Interval at which regions that don't show the animation are redrawn during playback. */
+#define WM_DRAW_PLAYBACK_REGION_INTERVAL 0.1
+
+/**
+ * During playback most regions other than viewports (properties, outliner, headers, side-bars)
+ * are tagged for redraw on every frame change, which takes time away from drawing the viewports.
+ * Those regions are redrawn at a lower rate instead: they keep their redraw tag and show the
+ * previous contents of their draw buffer until the interval passed or playback stops.
+ */
+static bool wm_draw_region_is_throttled(const bScreen *screen,
+                                        ScrArea *area,
+                                        ARegion *region,
+                                        const double time)
+{
+  if (WM_region_use_viewport(area, region)) {
+    return false;
+  }
+  /* Keep the region the user interacts with responsive. */
+  if (region == screen->active_region) {
+    return false;
+  }
+  /* Animation editors show the current frame in their main region. */
+  if (region->regiontype == RGN_TYPE_WINDOW &&
+      ELEM(area->spacetype, SPACE_ACTION, SPACE_GRAPH, SPACE_NLA, SPACE_CLIP))
+  {
+    return false;
+  }
+  /* The previous contents can only be shown when they still match the region. */
+  const wmDrawBuffer *draw_buffer = region->draw_buffer;
+  if (draw_buffer == nullptr || draw_buffer->offscreen == nullptr || draw_buffer->stereo ||
+      GPU_offscreen_width(draw_buffer->offscreen) != region->winx ||
+      GPU_offscreen_height(draw_buffer->offscreen) != region->winy)
+  {
+    return false;
+  }
+  return time - draw_buffer->draw_time < WM_DRAW_PLAYBACK_REGION_INTERVAL;
+}
+
 static const char *wm_area_name(ScrArea *area)
 {
 #define SPACE_NAME(space) \
@@ -927,6 +966,8 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
   Main *bmain = CTX_data_main(C);
   wmWindowManager *wm = CTX_wm_manager(C);
   bScreen *screen = WM_window_get_active_screen(win);
+  const bool is_playing = ED_screen_animation_playing(wm) != nullptr;
+  const double time = BLI_time_now_seconds();
 
   /* Draw screen areas into their own frame buffer. */
   ED_screen_areas_iter (win, screen, area) {
@@ -946,7 +987,8 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
                                      !(region->flag & RGN_FLAG_HIDDEN);
 
       if ((region->visible || ignore_visibility) && region->do_draw && region->type &&
-          region->type->layout)
+          region->type->layout &&
+          !(is_playing && wm_draw_region_is_throttled(screen, area, region, time)))
       {
         CTX_wm_region_set(C, region);
         ED_region_do_layout(C, region);
@@ -969,6 +1011,9 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
       if (!region->visible || !region->do_draw) {
         continue;
       }
+      if (is_playing && wm_draw_region_is_throttled(screen, area, region, time)) {
+        continue;
+      }
 
       CTX_wm_region_set(C, region);
       bool use_viewport = WM_region_use_viewport(area, region);
@@ -1009,6 +1054,9 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 
       GPU_debug_group_end();
 
+      if (region->draw_buffer) {
+        region->draw_buffer->draw_time = time;
+      }
       region->do_draw = 0;
       CTX_wm_region_set(C, nullptr);
     }
@@ -1437,6 +1485,8 @@ static bool wm_draw_update_test_window(Main *bmain, bContext *C, wmWindow *win)
   ViewLayer *view_layer = WM_window_get_active_view_layer(win);
   Depsgraph *depsgraph = BKE_scene_ensure_depsgraph(bmain, scene, view_layer);
   bScreen *screen = WM_window_get_active_screen(win);
+  const bool is_playing = ED_screen_animation_playing(wm) != nullptr;
+  const double time = BLI_time_now_seconds();
   bool do_draw = false;
 
   LISTBASE_FOREACH (ARegion *, region, &screen->regionbase) {
@@ -1457,7 +1507,10 @@ static bool wm_draw_update_test_window(Main *bmain, bContext *C, wmWindow *win)
       wm_region_test_xr_do_draw(wm, area, region);
 #endif
 
-      if (region->visible && region->do_draw) {
+      /* Throttled regions are drawn along with the next frame of the viewports. */
+      if (region->visible && region->do_draw &&
+          !(is_playing && wm_draw_region_is_throttled(screen, area, region, time)))
+      {
         do_draw = true;
       }
     }
@@ -1499,10 +1552,6 @@ static bool wm_draw_update_test_window(Main *bmain, bContext *C, wmWindow *win)
     }
   }
 
-#ifndef WITH_XR_OPENXR
-  UNUSED_VARS(wm);
-#endif
-
   return false;
 }
 
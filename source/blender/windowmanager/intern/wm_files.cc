@@ -38,6 +38,7 @@
 #include "BLI_filereader.h"
 #include "BLI_linklist.h"
 #include "BLI_math_time.h"
+#include "BLI_serialize.hh"
 #include "BLI_system.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
@@ -71,6 +72,7 @@
 #include "BKE_context.hh"
 #include "BKE_global.hh"
 #include "BKE_idprop.hh"
+#include "BKE_idtype.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_override.hh"
 #include "BKE_lib_remap.hh"
@@ -993,6 +995,52 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
   bf_reports->resynced_lib_overrides_libraries = nullptr;
 }
 
+/**
+ * Write the timings gathered while reading `filepath` as JSON to #Global.profile_load_filepath,
+ * see the `--profile-load` command line argument.
+ */
+static void file_read_reports_profile_write(const char *filepath,
+                                            const BlendFileReadReport *bf_reports)
+{
+  using namespace blender::io::serialize;
+
+  DictionaryValue root;
+  root.append_str("filepath", filepath);
+
+  std::shared_ptr<DictionaryValue> duration = root.append_dict("duration");
+  duration->append_double("whole", bf_reports->duration.whole);
+  duration->append_double("read_data", bf_reports->duration.read_data);
+  duration->append_double("versioning", bf_reports->duration.versioning);
+  duration->append_double("libraries", bf_reports->duration.libraries);
+  duration->append_double("lib_link", bf_reports->duration.lib_link);
+  duration->append_double("versioning_after_linking",
+                          bf_reports->duration.versioning_after_linking);
+  duration->append_double("lib_overrides", bf_reports->duration.lib_overrides);
+  duration->append_double("lib_overrides_resync", bf_reports->duration.lib_overrides_resync);
+  duration->append_double("post_read", bf_reports->duration.post_read);
+
+  std::shared_ptr<DictionaryValue> id_types = root.append_dict("id_types");
+  if (bf_reports->id_type_stats) {
+    int index = 0;
+    short idcode;
+    while ((idcode = BKE_idtype_idcode_iter_step(&index))) {
+      const BlendFileReadIDTypeStats &stats =
+          bf_reports->id_type_stats[BKE_idtype_idcode_to_index(idcode)];
+      if (stats.count == 0) {
+        continue;
+      }
+      std::shared_ptr<DictionaryValue> id_type = id_types->append_dict(
+          BKE_idtype_idcode_to_name(idcode));
+      id_type->append_int("count", stats.count);
+      id_type->append_int("size", int64_t(stats.size));
+      id_type->append_double("duration", stats.duration);
+    }
+  }
+
+  write_json_file(G.profile_load_filepath, root);
+  CLOG_INFO(&LOG, 0, "Blender file read profile written to '%s'", G.profile_load_filepath);
+}
+
 bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
 {
   /* Assume automated tasks with background, don't write recent file list. */
@@ -1027,11 +1075,17 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
      * if a user loads a file and various preferences change. */
     params.skip_flags = BLO_READ_SKIP_USERDEF;
 
+    const bool use_profile = G.profile_load_filepath[0] != '\0';
     BlendFileReadReport bf_reports{};
     bf_reports.reports = reports;
+    if (use_profile) {
+      bf_reports.id_type_stats = MEM_cnew_array<BlendFileReadIDTypeStats>(INDEX_ID_MAX,
+                                                                          __func__);
+    }
     bf_reports.duration.whole = BLI_time_now_seconds();
     BlendFileData *bfd = BKE_blendfile_read(filepath, &params, &bf_reports);
     if (bfd != nullptr) {
+      bf_reports.duration.post_read = BLI_time_now_seconds();
       wm_file_read_pre(use_data, use_userdef);
 
       /* Close any user-loaded fonts. */
@@ -1076,11 +1130,16 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
       read_file_post_params.is_alloc = false;
       wm_file_read_post(C, filepath, &read_file_post_params);
 
+      bf_reports.duration.post_read = BLI_time_now_seconds() - bf_reports.duration.post_read;
       bf_reports.duration.whole = BLI_time_now_seconds() - bf_reports.duration.whole;
+      if (use_profile) {
+        file_read_reports_profile_write(filepath, &bf_reports);
+      }
       file_read_reports_finalize(&bf_reports);
 
       success = true;
     }
+    MEM_SAFE_FREE(bf_reports.id_type_stats);
   }
 #if 0
   else if (retval == BKE_READ_EXOTIC_OK_OTHER) {
@@ -2097,6 +2156,12 @@ static bool wm_file_write(bContext *C,
 /** \name Auto-Save API
  * \{ */
 
+/**
+ * Auto-save re-writes mostly the same file each time,
+ * so only write the parts of it that changed.
+ */
+static BlendFileWriteDiffState *wm_autosave_diff_state = nullptr;
+
 static void wm_autosave_location(char filepath[FILE_MAX])
 {
   const int pid = abs(getpid());
@@ -2120,6 +2185,66 @@ static void wm_autosave_location(char filepath[FILE_MAX])
   BLI_path_join(filepath, FILE_MAX, tempdir_base, filename);
 }
 
+static void wm_autosave_job_startjob(void *customdata, wmJobWorkerStatus * /*worker_status*/)
+{
+  const BlendFileWriteSnapshot *snapshot = static_cast<const BlendFileWriteSnapshot *>(
+      customdata);
+  /* Error reporting into console. */
+  BLO_write_file_snapshot_write(snapshot, nullptr);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  BLO_write_file_snapshot_free(static_cast<BlendFileWriteSnapshot *>(customdata));
+}
+
+/**
+ * \param use_job: Only serialize the file into memory here,
+ * writing it to disk is done by a job so the UI isn't blocked by file IO.
+ */
+static void wm_autosave_write_ex(wmWindowManager *wm, Main *bmain, const bool use_job)
+{
+  /* Wait for the previous auto-save, it uses the same file. */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    if (use_job) {
+      /* Still writing, try again on the next time-step. */
+      return;
+    }
+    WM_jobs_kill_type(wm, wm, WM_JOB_TYPE_AUTOSAVE);
+  }
+
+  ED_editors_flush_edits(bmain);
+
+  char filepath[FILE_MAX];
+  wm_autosave_location(filepath);
+  /* Save as regular blend file with recovery information. */
+  const int fileflags = (G.fileflags & ~G_FILE_COMPRESS) | G_FILE_RECOVER_WRITE;
+
+  if (wm_autosave_diff_state == nullptr) {
+    wm_autosave_diff_state = BLO_write_diff_state_new();
+  }
+
+  /* Error reporting into console. */
+  BlendFileWriteParams params{};
+  params.diff_state = wm_autosave_diff_state;
+
+  if (use_job) {
+    BlendFileWriteSnapshot *snapshot = BLO_write_file_snapshot(
+        bmain, filepath, fileflags, &params, nullptr);
+    if (snapshot) {
+      wmJob *wm_job = WM_jobs_get(
+          wm, wm->winactive, wm, "Auto-Save", eWM_JobFlag(0), WM_JOB_TYPE_AUTOSAVE);
+      WM_jobs_customdata_set(wm_job, snapshot, wm_autosave_job_free);
+      WM_jobs_timer(wm_job, 0.1, 0, 0);
+      WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, nullptr, nullptr, nullptr);
+      WM_jobs_start(wm, wm_job);
+    }
+  }
+  else {
+    BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  }
+}
+
 static bool wm_autosave_write_try(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -2131,11 +2256,11 @@ static bool wm_autosave_write_try(Main *bmain, wmWindowManager *wm)
    * auto-save when we are in a mode where auto-save wouldn't have worked previously anyway. This
    * check can be removed once the performance regressions have been solved. */
   if (ED_undosys_stack_memfile_get_if_active(wm->undo_stack) != nullptr) {
-    WM_autosave_write(wm, bmain);
+    wm_autosave_write_ex(wm, bmain, !G.background);
     return true;
   }
   if ((U.uiflag & USER_GLOBALUNDO) == 0) {
-    WM_autosave_write(wm, bmain);
+    wm_autosave_write_ex(wm, bmain, !G.background);
     return true;
   }
   /* Can't auto-save with MemFile right now, try again later. */
@@ -2149,16 +2274,7 @@ bool WM_autosave_is_scheduled(wmWindowManager *wm)
 
 void WM_autosave_write(wmWindowManager *wm, Main *bmain)
 {
-  ED_editors_flush_edits(bmain);
-
-  char filepath[FILE_MAX];
-  wm_autosave_location(filepath);
-  /* Save as regular blend file with recovery information. */
-  const int fileflags = (G.fileflags & ~G_FILE_COMPRESS) | G_FILE_RECOVER_WRITE;
-
-  /* Error reporting into console. */
-  BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  wm_autosave_write_ex(wm, bmain, false);
 
   /* Restart auto-save timer. */
   wm_autosave_timer_end(wm);
@@ -2222,6 +2338,11 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer * /*wt*/)
 
 void wm_autosave_delete()
 {
+  if (wm_autosave_diff_state) {
+    BLO_write_diff_state_free(wm_autosave_diff_state);
+    wm_autosave_diff_state = nullptr;
+  }
+
   char filepath[FILE_MAX];
 
   wm_autosave_location(filepath);
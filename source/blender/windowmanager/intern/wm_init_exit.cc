@@ -27,6 +27,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_time.h"
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
@@ -121,6 +122,9 @@ CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_TOOLS, "wm.tool");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_PUB, "wm.msgbus.pub");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_SUB, "wm.msgbus.sub");
 
+/** Reports the time spent in the phases of #WM_init, enabled with `--log "wm.init"`. */
+static CLG_LogRef LOG_INIT = {"wm.init"};
+
 static void wm_init_scripts_extensions_once(bContext *C);
 
 static bool wm_start_with_console = false;
@@ -195,6 +199,13 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
 
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  const double time_init_start = BLI_time_now_seconds();
+  double time_phase_start = time_init_start;
+  auto report_phase_time = [&](const char *phase) {
+    const double time = BLI_time_now_seconds();
+    CLOG_INFO(&LOG_INIT, 1, "%s: %.3f s", phase, time - time_phase_start);
+    time_phase_start = time;
+  };
 
   if (!G.background) {
     wm_ghost_init(C); /* NOTE: it assigns C to ghost! */
@@ -245,6 +256,8 @@ void WM_init(bContext *C, int argc, const char **argv)
    * otherwise the versioning cannot find the default studio-light. */
   BKE_studiolight_init();
 
+  report_phase_time("types and sub-systems");
+
   BLI_assert((G.fileflags & G_FILE_NO_UI) == 0);
 
   /**
@@ -277,6 +290,8 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   wm_homefile_read_ex(C, &read_homefile_params, nullptr, &params_file_read_post);
 
+  report_phase_time("startup file and preferences");
+
   /* NOTE: leave `G_MAIN->filepath` set to an empty string since this
    * matches behavior after loading a new file. */
   BLI_assert(G_MAIN->filepath[0] == '\0');
@@ -304,6 +319,8 @@ void WM_init(bContext *C, int argc, const char **argv)
     UI_init();
     GPU_context_end_frame(GPU_context_active_get());
     GPU_render_end();
+
+    report_phase_time("GPU and interface");
   }
 
   blender::bke::subdiv::init();
@@ -317,6 +334,8 @@ void WM_init(bContext *C, int argc, const char **argv)
   UNUSED_VARS(argc, argv);
 #endif
 
+  report_phase_time("Python");
+
   if (!G.background) {
     if (wm_start_with_console) {
       GHOST_setConsoleWindowState(GHOST_kConsoleWindowStateShow);
@@ -328,9 +347,9 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_render_clear_mtex_copybuf();
 
-  wm_history_file_read();
-
+  /* The recent files are only shown in the interface and not updated in background mode. */
   if (!G.background) {
+    wm_history_file_read();
     blender::ui::string_search::read_recent_searches_file();
   }
 
@@ -351,7 +370,12 @@ void WM_init(bContext *C, int argc, const char **argv)
   WM_keyconfig_update_postpone_end();
   WM_keyconfig_update(static_cast<wmWindowManager *>(G_MAIN->wm.first));
 
+  report_phase_time("key-maps and add-ons");
+
   wm_homefile_read_post(C, params_file_read_post);
+
+  report_phase_time("startup file post-read");
+  CLOG_INFO(&LOG_INIT, 0, "initialized in %.3f s", BLI_time_now_seconds() - time_init_start);
 }
 
 static bool wm_init_splash_show_on_startup_check()
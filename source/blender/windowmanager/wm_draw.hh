@@ -21,6 +21,8 @@ struct wmDrawBuffer {
   GPUViewport *viewport;
   bool stereo;
   int bound_view;
+  /** Time of the last draw into this buffer, to throttle redraws during playback. */
+  double draw_time;
 };
 
 /* `wm_draw.cc` */
@@ -748,6 +748,7 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-trace");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
@@ -757,12 +758,14 @@ static void print_help(bArgs *ba, bool all)
     BLI_args_print_arg_doc(ba, "--debug-gpu-renderdoc");
   }
   BLI_args_print_arg_doc(ba, "--debug-wm");
+  BLI_args_print_arg_doc(ba, "--debug-wm-time");
   if (defs.with_xr_openxr) {
     BLI_args_print_arg_doc(ba, "--debug-xr");
     BLI_args_print_arg_doc(ba, "--debug-xr-time");
   }
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+  BLI_args_print_arg_doc(ba, "--profile-load");
 
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -1257,6 +1260,10 @@ static const char arg_handle_debug_mode_generic_set_doc_wm[] =
     "\n\t"
     "Enable debug messages for the window manager, shows all operators in search, shows "
     "keymap errors.";
+static const char arg_handle_debug_mode_generic_set_doc_wm_time[] =
+    "\n\t"
+    "Enable timing statistics for the window manager, prints percentiles of the time spent "
+    "handling events, notifiers & depsgraph evaluation and drawing.";
 static const char arg_handle_debug_mode_generic_set_doc_ghost[] =
     "\n\t"
     "Enable debug messages for Ghost (Linux only).";
@@ -1317,6 +1324,39 @@ static int arg_handle_debug_mode_io(int /*argc*/, const char ** /*argv*/, void *
   return 0;
 }
 
+static const char arg_handle_profile_load_set_doc[] =
+    "<filepath>\n"
+    "\tWrite a JSON report with the time spent in each stage of loading blend-files,\n"
+    "\tincluding per data-block type timings and sizes, to the given file.";
+static int arg_handle_profile_load_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--profile-load";
+  if (argc > 1) {
+    STRNCPY(G.profile_load_filepath, argv[1]);
+    BLI_path_canonicalize_native(G.profile_load_filepath, sizeof(G.profile_load_filepath));
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
+static const char arg_handle_debug_depsgraph_trace_set_doc[] =
+    "<filepath>\n"
+    "\tWrite the timeline of dependency graph evaluations to the given file, in the Chrome trace\n"
+    "\tevent format (viewable in 'chrome://tracing' or 'https://ui.perfetto.dev').";
+static int arg_handle_debug_depsgraph_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-depsgraph-trace";
+  if (argc > 1) {
+    STRNCPY(G.debug_depsgraph_trace_filepath, argv[1]);
+    BLI_path_canonicalize_native(G.debug_depsgraph_trace_filepath,
+                                 sizeof(G.debug_depsgraph_trace_filepath));
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_mode_all_doc[] =
     "\n\t"
     "Enable all debug messages.";
@@ -2677,6 +2717,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                (void *)G_DEBUG_HANDLERS);
   BLI_args_add(
       ba, nullptr, "--debug-wm", CB_EX(arg_handle_debug_mode_generic_set, wm), (void *)G_DEBUG_WM);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-wm-time",
+               CB_EX(arg_handle_debug_mode_generic_set, wm_time),
+               (void *)G_DEBUG_WM_TIME);
   if (defs.with_xr_openxr) {
     BLI_args_add(ba,
                  nullptr,
@@ -2702,6 +2747,7 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--debug-all", CB(arg_handle_debug_mode_all), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
+  BLI_args_add(ba, nullptr, "--profile-load", CB(arg_handle_profile_load_set), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-fpe", CB(arg_handle_debug_fpe_set), nullptr);
 
@@ -2771,6 +2817,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uid),
                (void *)G_DEBUG_DEPSGRAPH_UID);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-trace",
+               CB(arg_handle_debug_depsgraph_trace_set),
+               nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",
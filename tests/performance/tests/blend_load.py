@@ -3,12 +3,17 @@
 # SPDX-License-Identifier: Apache-2.0
 
 import api
+import os
+import tempfile
 
 
-def _run(filepath):
+def _run(args):
     import bpy
+    import json
     import time
 
+    filepath = args['filepath']
+
     # Load once to ensure it's cached by OS
     bpy.ops.wm.open_mainfile(filepath=filepath)
     bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
@@ -19,6 +24,13 @@ def _run(filepath):
     elapsed_time = time.time() - start_time
 
     result = {'time': elapsed_time}
+
+    # Add the time of each file reading stage, as written by `--profile-load`.
+    with open(args['profile_filepath']) as profile_file:
+        profile = json.load(profile_file)
+    for stage, duration in profile['duration'].items():
+        result['time_' + stage] = duration
+
     return result
 
 
@@ -33,7 +45,10 @@ class BlendLoadTest(api.Test):
         return "blend_load"
 
     def run(self, env, device_id):
-        result, _ = env.run_in_blender(_run, str(self.filepath))
+        with tempfile.TemporaryDirectory() as tempdir:
+            profile_filepath = os.path.join(tempdir, 'profile_load.json')
+            args = {'filepath': str(self.filepath), 'profile_filepath': profile_filepath}
+            result, _ = env.run_in_blender(_run, args, ['--profile-load', profile_filepath])
         return result
 
 
@@ -0,0 +1,130 @@
+# SPDX-FileCopyrightText: 2024 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+import tempfile
+
+# File extension and operator arguments of each format.
+FORMATS = {
+    'obj': ('.obj', {}, {}),
+    'ply': ('.ply', {}, {}),
+    'stl': ('.stl', {}, {}),
+    'usd': ('.usdc', {}, {}),
+    'alembic': ('.abc', {'start': 1, 'end': 1}, {}),
+}
+
+# Number of grid subdivisions of the exported mesh, the number of triangles is about twice the
+# square of it.
+SIZES = {
+    'small': 128,
+    'medium': 512,
+    'large': 1536,
+}
+
+
+def _peak_memory():
+    # Peak memory of the Blender process in bytes, which only runs a single import or export.
+    import resource
+    import sys
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    return peak if sys.platform == 'darwin' else peak * 1024
+
+
+def _run_export(args):
+    import bpy
+    import bmesh
+    import time
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    mesh = bpy.data.meshes.new("grid")
+    bm = bmesh.new()
+    bmesh.ops.create_grid(bm, x_segments=args['size'], y_segments=args['size'], size=1.0, calc_uvs=True)
+    bm.to_mesh(mesh)
+    bm.free()
+    ob = bpy.data.objects.new("grid", mesh)
+    bpy.context.scene.collection.objects.link(ob)
+    bpy.context.view_layer.update()
+
+    operator = getattr(bpy.ops.wm, args['format'] + '_export')
+
+    start_time = time.time()
+    operator(filepath=args['filepath'], **args['export_args'])
+    elapsed_time = time.time() - start_time
+
+    file_size = os.path.getsize(args['filepath'])
+    return {
+        'time_export': elapsed_time,
+        'export_mb_per_second': file_size / (1024 * 1024) / elapsed_time,
+        'peak_memory_export': _peak_memory(),
+    }
+
+
+def _run_import(args):
+    import bpy
+    import time
+
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+    # Read once to ensure it's cached by OS.
+    with open(args['filepath'], 'rb') as f:
+        while f.read(1024 * 1024):
+            pass
+
+    operator = getattr(bpy.ops.wm, args['format'] + '_import')
+
+    start_time = time.time()
+    operator(filepath=args['filepath'], **args['import_args'])
+    elapsed_time = time.time() - start_time
+
+    num_triangles = 0
+    for mesh in bpy.data.meshes:
+        num_triangles += len(mesh.loops) - 2 * len(mesh.polygons)
+
+    file_size = os.path.getsize(args['filepath'])
+    return {
+        'time_import': elapsed_time,
+        'import_mb_per_second': file_size / (1024 * 1024) / elapsed_time,
+        'import_triangles_per_second': num_triangles / elapsed_time,
+        'peak_memory_import': _peak_memory(),
+    }
+
+
+class FileIOTest(api.Test):
+    def __init__(self, file_format, size_name):
+        self.file_format = file_format
+        self.size_name = size_name
+
+    def name(self):
+        return f"{self.file_format}_{self.size_name}"
+
+    def category(self):
+        return "file_io"
+
+    def run(self, env, device_id):
+        extension, export_args, import_args = FORMATS[self.file_format]
+
+        with tempfile.TemporaryDirectory() as tempdir:
+            args = {
+                'format': self.file_format,
+                'size': SIZES[self.size_name],
+                'filepath': os.path.join(tempdir, 'grid' + extension),
+                'export_args': export_args,
+                'import_args': import_args,
+            }
+            result, _ = env.run_in_blender(_run_export, args)
+            if not result:
+                return result
+            import_result, _ = env.run_in_blender(_run_import, args)
+            if not import_result:
+                return import_result
+            result.update(import_result)
+
+        return result
+
+
+def generate(env):
+    return [FileIOTest(file_format, size_name) for file_format in FORMATS for size_name in SIZES]
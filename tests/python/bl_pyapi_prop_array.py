@@ -317,6 +317,46 @@ class TestPropArrayDynamicArg(unittest.TestCase):
         self.assertEqual(tuple([1.0] * self.dims), tuple([vg.weight(i) for i in range(self.dims)]))
 
 
+
+class TestPropCollectionForeachConvert(unittest.TestCase):
+    """
+    Collection ``foreach_get``/``foreach_set`` with buffers of a different type than the property.
+    """
+
+    def setUp(self):
+        self.me = bpy.data.meshes.new("")
+        self.me.vertices.add(4)
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.me)
+        self.me = None
+
+    def test_foreach_set_float_from_double(self):
+        co = np.arange(12, dtype=np.float64) * 0.5
+        self.me.vertices.foreach_set("co", co)
+        self.assertEqual(tuple(self.me.vertices[1].co), (1.5, 2.0, 2.5))
+
+    def test_foreach_set_float_from_int(self):
+        self.me.vertices.foreach_set("co", np.arange(12, dtype=np.int64))
+        self.assertEqual(tuple(self.me.vertices[3].co), (9.0, 10.0, 11.0))
+
+    def test_foreach_get_float_as_double(self):
+        self.me.vertices.foreach_set("co", np.arange(12, dtype=np.float32))
+        co = np.zeros(12, dtype=np.float64)
+        self.me.vertices.foreach_get("co", co)
+        self.assertEqual(tuple(co), tuple(float(i) for i in range(12)))
+
+    def test_foreach_get_length_mismatch(self):
+        with self.assertRaises(RuntimeError):
+            self.me.vertices.foreach_get("co", np.zeros(11, dtype=np.float64))
+
+    def test_foreach_set_int_from_double(self):
+        # Converting to integers isn't done implicitly.
+        with self.assertRaises(TypeError):
+            self.me.attributes.new("test", 'INT', 'POINT').data.foreach_set(
+                "value", np.arange(4, dtype=np.float64))
+
+
 if __name__ == '__main__':
     import sys
     sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])